@@ -0,0 +1,146 @@
+/*
+ * This file is part of ProGearSDK.
+ * Copyright (c) 2024-2025 ProGearSDK contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+/**
+ * @file ng_mock.h
+ * @brief Host-side mock of the NeoGeo video hardware for benchmarking.
+ *
+ * Included by ng_hardware.h and ng_palette.h when NG_MOCK_HAL is defined.
+ * Replaces the hardware registers with host variables and the NG_VRAM_*
+ * macros with calls that write a fake VRAM and count every port access,
+ * so the unmodified Core, HAL sprite/fix/palette code and ProGear can run
+ * on the build machine.
+ */
+
+#ifndef NG_MOCK_H
+#define NG_MOCK_H
+
+#include <ng_types.h>
+
+/** @name Fake Hardware State */
+/** @{ */
+
+#define NG_MOCK_VRAM_WORDS   0x10000 /**< Full 16-bit VRAM address space */
+#define NG_MOCK_PALRAM_WORDS 4096    /**< One palette bank (256 x 16 colors) */
+
+/** Fake VRAM and its port counters */
+typedef struct {
+    u16 mem[NG_MOCK_VRAM_WORDS]; /**< VRAM contents */
+    u16 addr;                    /**< Current VRAMADDR */
+    u16 mod;                     /**< Current VRAMMOD */
+    u32 writes;                  /**< Words written to VRAMDATA */
+    u32 reads;                   /**< Words read from VRAMDATA */
+    u32 addr_setups;             /**< Writes to VRAMADDR */
+    u32 mod_setups;              /**< Writes to VRAMMOD */
+} NGMockVram;
+
+/** Memory-mapped registers that are not part of the VRAM port */
+typedef struct {
+    vu16 lspcmode;
+    vu16 irqack;
+    vu8 watchdog;
+    vu8 p1cnt;
+    vu8 p2cnt;
+    vu8 status_a;
+    vu8 status_b;
+    vu8 sound;
+    vu8 sound_reply;
+    vu16 bank;
+    vu8 vblank_flag;
+} NGMockRegs;
+
+extern NGMockVram ng_mock_vram;                    /**< Fake VRAM */
+extern NGMockRegs ng_mock_regs;                    /**< Fake registers */
+extern u16 ng_mock_palram[NG_MOCK_PALRAM_WORDS];   /**< Fake palette RAM */
+
+/**
+ * Clear VRAM, palette RAM and all counters.
+ */
+void NGMockReset(void);
+
+/**
+ * Clear the port counters only.
+ */
+void NGMockResetCounters(void);
+/** @} */
+
+/** @name VRAM Port */
+/** @{ */
+
+static inline void NGMockVramSetAddr(u16 addr) {
+    ng_mock_vram.addr = addr;
+    ng_mock_vram.addr_setups++;
+}
+
+static inline void NGMockVramSetMod(u16 mod) {
+    ng_mock_vram.mod = mod;
+    ng_mock_vram.mod_setups++;
+}
+
+static inline void NGMockVramWrite(u16 data) {
+    ng_mock_vram.mem[ng_mock_vram.addr] = data;
+    ng_mock_vram.addr = (u16)(ng_mock_vram.addr + ng_mock_vram.mod);
+    ng_mock_vram.writes++;
+}
+
+static inline u16 NGMockVramRead(void) {
+    ng_mock_vram.reads++;
+    return ng_mock_vram.mem[ng_mock_vram.addr];
+}
+
+static inline void NGMockVramFill(u16 value, u16 count) {
+    for (u16 i = 0; i < count; i++)
+        NGMockVramWrite(value);
+}
+/** @} */
+
+/** @name Hardware Overrides */
+/** @{ */
+
+#define NG_REG_LSPCMODE    (ng_mock_regs.lspcmode)
+#define NG_REG_IRQACK      (ng_mock_regs.irqack)
+#define NG_REG_WATCHDOG    (ng_mock_regs.watchdog)
+#define NG_REG_P1CNT       (ng_mock_regs.p1cnt)
+#define NG_REG_P2CNT       (ng_mock_regs.p2cnt)
+#define NG_REG_STATUS_A    (ng_mock_regs.status_a)
+#define NG_REG_STATUS_B    (ng_mock_regs.status_b)
+#define NG_REG_SOUND       (ng_mock_regs.sound)
+#define NG_REG_SOUND_REPLY (ng_mock_regs.sound_reply)
+#define NG_REG_BANK        (ng_mock_regs.bank)
+
+#define NG_BIOS_VBLANK_FLAG (ng_mock_regs.vblank_flag)
+
+/* Line counter seen by the main loop after NGWaitVBlank(): where a frame's
+ * work would end, leaving the rest of the visible area for idle jobs */
+#define NG_MOCK_FRAME_END_LINE 0x180
+
+/* The backdrop is the last color of palette 255 */
+#define NG_REG_BACKDROP (ng_mock_palram[NG_MOCK_PALRAM_WORDS - 1])
+
+#define NG_MOCK_PAL_RAM_BASE ((uintptr_t)ng_mock_palram)
+
+#define NG_VRAM_DECLARE_BASE()          ((void)0)
+/* The VBlank replay calls the NGMockVram functions directly, so only the
+ * SDK's own writes reach the NG_VRAM_STATS counters, as on hardware */
+#define NG_VRAM_SET_ADDR_FAST(addr) NGMockVramSetAddr(NG_VRAM_COUNT_SETUP(addr))
+#define NG_VRAM_WRITE_FAST(data)    (NG_VRAM_COUNT_WORDS(1), NGMockVramWrite((u16)(data)))
+#define NG_VRAM_READ_FAST()         NGMockVramRead()
+#define NG_VRAM_SET_MOD_FAST(mod)   NGMockVramSetMod((u16)(mod))
+#define NG_VRAM_CLEAR_FAST(count)   NG_VRAM_FILL_FAST(0, count)
+#define NG_VRAM_FILL_FAST(value, count)                    \
+    do {                                                   \
+        u16 _count = (u16)(count);                         \
+        NG_VRAM_COUNT_WORDS(_count);                       \
+        NGMockVramFill((u16)(value), _count);              \
+    } while (0)
+#define NG_VRAM_SETUP_FAST(addr, mod)                   \
+    do {                                                \
+        NGMockVramSetAddr(NG_VRAM_COUNT_SETUP(addr));   \
+        NGMockVramSetMod((u16)(mod));                   \
+    } while (0)
+/** @} */
+
+#endif /* NG_MOCK_H */
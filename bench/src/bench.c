@@ -0,0 +1,1353 @@
+/*
+ * This file is part of ProGearSDK.
+ * Copyright (c) 2024-2025 ProGearSDK contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+/**
+ * @file bench.c
+ * @brief Host benchmark suite for ProGear hot paths.
+ *
+ * Each scenario drives the real SDK code against the mock HAL and reports
+ * VRAM words written, VRAM address setups, palette words changed and host
+ * time per iteration. Port counts are deterministic, so they are compared
+ * against a baseline file to catch write-count regressions.
+ *
+ * Usage: bench [-b baseline.txt] [-w baseline.txt]
+ *   -b FILE  Fail if any scenario writes more words or sets up more
+ *            addresses than recorded in FILE
+ *   -w FILE  Record the current counts as the new baseline
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <ng_mock.h>
+#include <engine.h>
+#include <scene.h>
+#include <camera.h>
+#include <actor.h>
+#include <backdrop.h>
+#include <terrain.h>
+#include <physics.h>
+#include <particles.h>
+#include <widget.h>
+#include <spritetext.h>
+#include <lighting.h>
+#include <ng_arena.h>
+#include <ng_display_list.h>
+#include <ng_palette.h>
+#include <ng_fix.h>
+#include <ng_decomp.h>
+#include <ng_vblank.h>
+#include <ng_idle.h>
+
+#include "sdk_internal.h"
+
+/* ============================================================
+ * Test Assets
+ * ============================================================ */
+
+#define SPRITE_TILES_W 4
+#define SPRITE_TILES_H 4
+
+static const u16 sprite_tilemap[SPRITE_TILES_W * SPRITE_TILES_H] = {
+    1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16,
+};
+
+static const NGVisualAsset sprite_asset = {
+    .name = "bench_sprite",
+    .base_tile = 256,
+    .width_pixels = SPRITE_TILES_W * 16,
+    .height_pixels = SPRITE_TILES_H * 16,
+    .width_tiles = SPRITE_TILES_W,
+    .height_tiles = SPRITE_TILES_H,
+    .tilemap = sprite_tilemap,
+    .palette = 1,
+    .palette_data = NULL,
+    .anims = NULL,
+    .anim_count = 0,
+    .frame_count = 1,
+    .tiles_per_frame = SPRITE_TILES_W * SPRITE_TILES_H,
+};
+
+/* Four frames that differ in the bottom row only, like a walk cycle */
+#define WALK_FRAMES 4
+#define WALK_TILES  (SPRITE_TILES_W * SPRITE_TILES_H)
+
+static const u16 walk_tilemap[WALK_FRAMES * WALK_TILES] = {
+    1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16,
+    1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 17, 18, 19, 20,
+    1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 21, 22, 23, 24,
+    1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 25, 26, 27, 28,
+};
+
+/* Offsets per frame, then the changed (column << 5) | row entries */
+static const u16 walk_deltas[] = {
+    5, 5, 9, 13, 17, 3, 35, 67, 99, 3, 35, 67, 99, 3, 35, 67, 99,
+};
+
+static const NGAnimDef walk_anims[] = {
+    {"walk", 0, WALK_FRAMES, 2, 1, NULL},
+};
+
+static const NGVisualAsset walk_asset = {
+    .name = "bench_walk",
+    .base_tile = 256,
+    .width_pixels = SPRITE_TILES_W * 16,
+    .height_pixels = SPRITE_TILES_H * 16,
+    .width_tiles = SPRITE_TILES_W,
+    .height_tiles = SPRITE_TILES_H,
+    .tilemap = walk_tilemap,
+    .palette = 1,
+    .palette_data = NULL,
+    .anims = walk_anims,
+    .anim_count = 1,
+    .frame_count = WALK_FRAMES,
+    .tiles_per_frame = WALK_TILES,
+    .frame_deltas = walk_deltas,
+};
+
+/* Metasprite frames with 2 to 4 irregular column parts */
+#define META_FRAMES 4
+
+static const u16 meta_runs[] = {
+    1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+};
+
+static const NGMetaPart meta_parts[] = {
+    {0, 16, 0, 3}, {16, 0, 3, 4}, {32, 0, 3, 4},
+    {0, 16, 0, 3}, {16, 0, 3, 4}, {32, 16, 9, 3},
+    {0, 16, 0, 3}, {16, 0, 3, 4}, {32, 0, 3, 4}, {48, 32, 7, 2},
+    {16, 0, 3, 4}, {32, 32, 12, 2},
+};
+
+static const u16 meta_frame_parts[META_FRAMES + 1] = {0, 3, 6, 10, 12};
+
+static const NGAnimDef meta_anims[] = {
+    {"swing", 0, META_FRAMES, 2, 1, NULL},
+};
+
+static const NGVisualAsset meta_asset = {
+    .name = "bench_meta",
+    .base_tile = 256,
+    .width_pixels = SPRITE_TILES_W * 16,
+    .height_pixels = SPRITE_TILES_H * 16,
+    .width_tiles = SPRITE_TILES_W,
+    .height_tiles = SPRITE_TILES_H,
+    .tilemap = meta_runs,
+    .palette = 1,
+    .palette_data = NULL,
+    .anims = meta_anims,
+    .anim_count = 1,
+    .frame_count = META_FRAMES,
+    .tiles_per_frame = 0,
+    .parts = meta_parts,
+    .frame_parts = meta_frame_parts,
+    .max_parts = 4,
+};
+
+#define MAP_W 256
+#define MAP_H 32
+
+static u8 map_tiles[MAP_W * MAP_H];
+static u8 map_collision[MAP_W * MAP_H];
+static u8 map_palettes[256];
+
+static const NGTerrainAsset map_asset = {
+    .name = "bench_map",
+    .width_tiles = MAP_W,
+    .height_tiles = MAP_H,
+    .base_tile = 512,
+    .tile_data = map_tiles,
+    .collision_data = map_collision,
+    .tile_to_palette = map_palettes,
+    .default_palette = 2,
+};
+
+/* Ground with a hazard strip every 64 columns, floating platforms every 16
+ * columns and a pillar every 32 */
+static void build_map(void) {
+    for (u16 ty = 0; ty < MAP_H; ty++) {
+        for (u16 tx = 0; tx < MAP_W; tx++) {
+            u8 tile = 0;
+            u8 coll = 0;
+            if (ty >= MAP_H - 4) {
+                tile = (u8)(1 + (tx & 7));
+                coll = NG_TILE_SOLID;
+                if (ty == MAP_H - 4 && (tx & 63) >= 40 && (tx & 63) < 48)
+                    coll |= NG_TILE_HAZARD;
+            } else if (ty == MAP_H - 12 && (tx & 15) < 6) {
+                tile = 9;
+                coll = NG_TILE_PLATFORM;
+            } else if ((tx & 31) == 20 && ty >= MAP_H - 8) {
+                tile = 10;
+                coll = NG_TILE_SOLID;
+            }
+            map_tiles[ty * MAP_W + tx] = tile;
+            map_collision[ty * MAP_W + tx] = coll;
+        }
+    }
+    for (u16 i = 0; i < 256; i++)
+        map_palettes[i] = (u8)(2 + (i & 7));
+}
+
+/* Same map as RLE-packed chunks, packed at startup like progear_assets.py does */
+#define CHUNK_BYTES (NG_TERRAIN_CHUNK_SIZE * NG_TERRAIN_CHUNK_SIZE * 2)
+#define MAP_CHUNKS  ((MAP_W / NG_TERRAIN_CHUNK_SIZE) * (MAP_H / NG_TERRAIN_CHUNK_SIZE))
+
+static u8 map_chunk_data[MAP_CHUNKS * (CHUNK_BYTES + CHUNK_BYTES / 128)];
+static u32 map_chunk_offsets[MAP_CHUNKS];
+
+static const NGTerrainAsset map_chunked_asset = {
+    .name = "bench_map_chunked",
+    .width_tiles = MAP_W,
+    .height_tiles = MAP_H,
+    .base_tile = 512,
+    .tile_to_palette = map_palettes,
+    .default_palette = 2,
+    .chunk_data = map_chunk_data,
+    .chunk_offsets = map_chunk_offsets,
+    .chunk_collision = 1,
+};
+
+static u32 rle_pack(const u8 *src, u16 len, u8 *out) {
+    u32 n = 0;
+    u16 i = 0;
+    while (i < len) {
+        u16 run = 1;
+        while (i + run < len && run < 129 && src[i + run] == src[i])
+            run++;
+        if (run >= 2) {
+            out[n++] = (u8)(0x7E + run);
+            out[n++] = src[i];
+        } else {
+            /* Literals up to the next run of two */
+            u16 lit = 1;
+            while (i + lit < len && lit < 128 &&
+                   !(i + lit + 1 < len && src[i + lit] == src[i + lit + 1]))
+                lit++;
+            out[n++] = (u8)(lit - 1);
+            memcpy(out + n, src + i, lit);
+            n += lit;
+            run = lit;
+        }
+        i = (u16)(i + run);
+    }
+    return n;
+}
+
+static void build_chunks(void) {
+    u8 raw[CHUNK_BYTES];
+    u32 size = 0;
+    for (u16 c = 0; c < MAP_CHUNKS; c++) {
+        u16 cx = (u16)(c % (MAP_W / NG_TERRAIN_CHUNK_SIZE));
+        u16 cy = (u16)(c / (MAP_W / NG_TERRAIN_CHUNK_SIZE));
+        for (u16 y = 0; y < NG_TERRAIN_CHUNK_SIZE; y++) {
+            u32 src = (u32)(cy * NG_TERRAIN_CHUNK_SIZE + y) * MAP_W + cx * NG_TERRAIN_CHUNK_SIZE;
+            memcpy(raw + y * NG_TERRAIN_CHUNK_SIZE, map_tiles + src, NG_TERRAIN_CHUNK_SIZE);
+            memcpy(raw + CHUNK_BYTES / 2 + y * NG_TERRAIN_CHUNK_SIZE, map_collision + src,
+                   NG_TERRAIN_CHUNK_SIZE);
+        }
+        map_chunk_offsets[c] = size;
+        size += rle_pack(raw, CHUNK_BYTES, map_chunk_data + size);
+    }
+}
+
+/* Same map as one LZ4 block, packed at startup like progear_assets.py does:
+ * greedy matching against the last place each 4 bytes were seen */
+#define MAP_BYTES (MAP_W * MAP_H * 2)
+
+static u8 map_packed[NG_DECOMP_HEADER + MAP_BYTES + MAP_BYTES / 255 + 16];
+
+static u32 lz4_length(u8 *out, u32 n, u32 length) {
+    for (; length >= 255; length -= 255)
+        out[n++] = 255;
+    out[n++] = (u8)length;
+    return n;
+}
+
+static u32 lz4_sequence(u8 *out, u32 n, const u8 *literals, u32 count, u32 offset, u32 match) {
+    u32 code = match ? match - 4 : 0;
+    out[n++] = (u8)((count < 15 ? count : 15) << 4 | (code < 15 ? code : 15));
+    if (count >= 15)
+        n = lz4_length(out, n, count - 15);
+    memcpy(out + n, literals, count);
+    n += count;
+    if (!match)
+        return n;
+    out[n++] = (u8)offset;
+    out[n++] = (u8)(offset >> 8);
+    if (code >= 15)
+        n = lz4_length(out, n, code - 15);
+    return n;
+}
+
+static void build_packed_map(void) {
+    static u8 raw[MAP_BYTES];
+    static u32 last_seen[4096];
+    memcpy(raw, map_tiles, MAP_BYTES / 2);
+    memcpy(raw + MAP_BYTES / 2, map_collision, MAP_BYTES / 2);
+    memset(last_seen, 0xFF, sizeof(last_seen));
+
+    u8 *out = map_packed;
+    out[0] = (u8)(MAP_BYTES >> 24);
+    out[1] = (u8)(MAP_BYTES >> 16);
+    out[2] = (u8)(MAP_BYTES >> 8);
+    out[3] = (u8)MAP_BYTES;
+    u32 n = NG_DECOMP_HEADER, anchor = 0, i = 0;
+    while (i + 12 <= MAP_BYTES) {
+        u32 key = (u32)(raw[i] | raw[i + 1] << 8 | raw[i + 2] << 16 | (u32)raw[i + 3] << 24);
+        u16 hash = (u16)((key * 2654435761u) >> 20);
+        u32 candidate = last_seen[hash];
+        last_seen[hash] = i;
+        if (candidate == 0xFFFFFFFF || i - candidate > 0xFFFF ||
+            memcmp(raw + candidate, raw + i, 4)) {
+            i++;
+            continue;
+        }
+        u32 length = 4;
+        while (i + length < MAP_BYTES - 5 && raw[candidate + length] == raw[i + length])
+            length++;
+        n = lz4_sequence(out, n, raw + anchor, i - anchor, i - candidate, length);
+        i += length;
+        anchor = i;
+    }
+    lz4_sequence(out, n, raw + anchor, MAP_BYTES - anchor, 0, 0);
+}
+
+/* Fill the sprite palettes with a gradient so lighting has work to do */
+static void fill_palettes(void) {
+    for (u16 pal = 1; pal < 16; pal++) {
+        for (u16 c = 1; c < 16; c++) {
+            u8 v = (u8)(c * 2);
+            NGPalSetColor((u8)pal, (u8)c, (NGColor)NG_RGB(v, 31 - v, pal * 2));
+        }
+    }
+}
+
+/* ============================================================
+ * Scenarios
+ * ============================================================ */
+
+#define ACTOR_COUNT 24
+
+static NGActorHandle actors[ACTOR_COUNT];
+static NGPhysWorldHandle world;
+static u32 frame;
+
+static void spawn_actors(void) {
+    for (u8 i = 0; i < ACTOR_COUNT; i++) {
+        actors[i] = NGActorCreate(&sprite_asset, 0, 0);
+        NGActorAddToScene(actors[i], FIX((i % 6) * 52), FIX((i / 6) * 56), (u8)(i + 1));
+    }
+}
+
+static void move_actors(void) {
+    for (u8 i = 0; i < ACTOR_COUNT; i++) {
+        s16 dx = (s16)(((frame + i) & 16) ? -1 : 1);
+        NGActorMove(actors[i], FIX(dx), 0);
+    }
+}
+
+static void setup_graphic(void) {
+    spawn_actors();
+    NGSceneDraw();
+}
+
+static void run_graphic_static(void) {
+    NGSceneDraw();
+}
+
+static void run_graphic_move(void) {
+    move_actors();
+    NGSceneDraw();
+}
+
+static void setup_graphic_deferred(void) {
+    NGEngineSetDeferredDraw(1);
+    setup_graphic();
+}
+
+static void run_graphic_deferred(void) {
+    NGEngineFrameStart();
+    move_actors();
+    NGEngineFrameEnd();
+}
+
+/* Deferred moves where every third frame's logic runs past a VBlank, like
+ * a boss fight spike; the frame after it skips its draw to keep speed */
+static void setup_graphic_frame_skip(void) {
+    NGEngineSetFrameSkip(1);
+    setup_graphic_deferred();
+}
+
+static void run_graphic_frame_skip(void) {
+    NGEngineFrameStart();
+    u8 late = frame % 3 == 0;
+    move_actors();
+    if (late)
+        ng_vblank_count++; /* Came and went while the frame ran */
+    NGEngineFrameEnd();
+    if (NGEngineIsSkippingDraw() != late || NGEngineFrameVBlanks() != late + 1)
+        printf("graphic_frame_skip: wrong skip\n");
+}
+
+/* Every actor plays a walk cycle in place */
+static void setup_graphic_animate(void) {
+    for (u8 i = 0; i < ACTOR_COUNT; i++) {
+        actors[i] = NGActorCreate(&walk_asset, 0, 0);
+        NGActorAddToScene(actors[i], FIX((i % 6) * 52), FIX((i / 6) * 56), (u8)(i + 1));
+    }
+    NGSceneDraw();
+}
+
+static void run_graphic_animate(void) {
+    NGSceneUpdate();
+    NGSceneDraw();
+}
+
+/* Every actor plays a metasprite swing whose part count changes */
+static void setup_graphic_metasprite(void) {
+    for (u8 i = 0; i < ACTOR_COUNT; i++) {
+        actors[i] = NGActorCreate(&meta_asset, 0, 0);
+        NGActorAddToScene(actors[i], FIX((i % 6) * 52), FIX((i / 6) * 56), (u8)(i + 1));
+    }
+    NGSceneDraw();
+}
+
+/* Camera zooming in and out over idle actors, one level every 4 frames */
+static void run_graphic_zoom(void) {
+    u16 step = (u16)((frame >> 2) & 15);
+    NGCameraSetZoom((u8)(step < 8 ? 16 - step : 8 + (step - 8)));
+    NGSceneDraw();
+}
+
+/* Bullets cycle in and out on top of a static scene */
+#define BULLET_COUNT 8
+
+static NGActorHandle bullets[BULLET_COUNT];
+
+static void setup_graphic_spawn(void) {
+    for (u8 i = 0; i < BULLET_COUNT; i++)
+        bullets[i] = NG_ACTOR_INVALID;
+    setup_graphic();
+}
+
+static void run_graphic_spawn(void) {
+    if ((frame & 3) == 0) {
+        u8 slot = (u8)((frame >> 2) % BULLET_COUNT);
+        if (bullets[slot] != NG_ACTOR_INVALID)
+            NGActorDestroy(bullets[slot]);
+        bullets[slot] = NGActorCreate(&sprite_asset, 0, 0);
+        NGActorAddToScene(bullets[slot], FIX(slot * 36), FIX(200), 200);
+    }
+    NGSceneDraw();
+}
+
+/* A wave of one enemy type replaces the last every 16 frames */
+static void run_graphic_wave(void) {
+    if ((frame & 15) == 0) {
+        for (u8 i = 0; i < ACTOR_COUNT; i++)
+            NGActorDestroy(actors[i]);
+        spawn_actors();
+    }
+    NGSceneDraw();
+}
+
+/* A ring of bullets every fourth frame, more than the sprite block holds,
+ * flying off-screen or into a player box */
+static void setup_particles(void) {
+    NGEngineConfig cfg = {.particles = 256, .particle_sprites = 96};
+    NGEngineInitWithConfig(&cfg);
+    NGParticlesSetBounds(0, 0, FIX(320), FIX(224));
+}
+
+static void run_particles(void) {
+    if ((frame & 3) == 0) {
+        for (u8 i = 0; i < 16; i++) {
+            u8 angle = (u8)(i * 16 + frame);
+            NGParticleSpawn(FIX(160), FIX(112), NGCos(angle) * 3, NGSin(angle) * 3, 90,
+                            (u16)(256 + (i & 1)), 1);
+        }
+    }
+    NGSceneUpdate();
+    NGParticlesHit(FIX(220), FIX(112), FIX(8), FIX(8), 1);
+    NGSceneDraw();
+}
+
+/* Rain of one bullet type down the screen: twice the sprite block, with
+ * sprites reused lower down through the raster table */
+static void setup_particles_multiplex(void) {
+    NGEngineConfig cfg = {.particles = 256, .particle_sprites = 48};
+    NGEngineInitWithConfig(&cfg);
+    NGEngineSetDeferredDraw(1);
+    NGParticlesSetBounds(0, 0, FIX(320), FIX(224));
+    NGParticlesSetMultiplex(1);
+}
+
+static void run_particles_multiplex(void) {
+    NGEngineFrameStart();
+    if ((frame & 7) == 0) {
+        for (u8 i = 0; i < 12; i++)
+            NGParticleSpawn(FIX(i * 26 + 12), FIX(8), 0, FIX(2), NG_PARTICLE_FOREVER, 256, 1);
+    }
+    NGEngineFrameEnd();
+}
+
+/* Actors spread over a wide level, most of them off-screen at any time */
+static void setup_graphic_offscreen(void) {
+    for (u8 i = 0; i < ACTOR_COUNT; i++) {
+        actors[i] = NGActorCreate(&sprite_asset, 0, 0);
+        NGActorAddToScene(actors[i], FIX(i * 160), FIX((i & 3) * 48), (u8)(i + 1));
+    }
+    NGSceneDraw();
+}
+
+static void run_graphic_offscreen(void) {
+    move_actors();
+    NGCameraSetPos(FIX((frame * 4) % 3200), 0);
+    NGSceneDraw();
+}
+
+/* Menu panel opening and closing: a 9-slice growing and shrinking a few
+ * pixels a frame in both directions */
+static NGGraphic *panel;
+
+static void setup_panel_resize(void) {
+    NGGraphicConfig cfg = {.width = 64,
+                           .height = 64,
+                           .tile_mode = NG_GRAPHIC_TILE_9SLICE,
+                           .layer = NG_GRAPHIC_LAYER_UI};
+    panel = NGGraphicCreate(&cfg);
+    NGGraphicSetSource(panel, &sprite_asset, 1);
+    NGGraphicSetPosition(panel, 32, 32);
+    NGSceneDraw();
+}
+
+static void run_panel_resize(void) {
+    u16 step = (u16)(frame % 64);
+    u16 grow = (u16)(step < 32 ? step : 63 - step);
+    NGGraphicSetSize(panel, (u16)(64 + grow * 6), (u16)(64 + grow * 3));
+    NGSceneDraw();
+}
+
+static void setup_tilemap(void) {
+    NGSceneSetTerrain(&map_asset);
+    NGSceneDraw();
+}
+
+static void setup_tilemap_chunked(void) {
+    NGSceneSetTerrain(&map_chunked_asset);
+    NGSceneDraw();
+}
+
+static void run_tilemap_scroll_x(void) {
+    NGCameraSetPos(FIX((s32)(frame * 3)), 0);
+    NGSceneUpdate();
+    NGSceneDraw();
+}
+
+static void run_tilemap_scroll_xy(void) {
+    s32 y = (s32)((frame & 63) < 32 ? (frame & 31) * 4 : (31 - (frame & 31)) * 4);
+    NGCameraSetPos(FIX((s32)(frame * 2)), FIX(y));
+    NGSceneUpdate();
+    NGSceneDraw();
+}
+
+/* Cut between two views 2048 px apart every 64 frames, warming up 16 ahead */
+static void run_tilemap_cut(void) {
+    u32 x = (frame & 64) ? 2048 : 0;
+    if ((frame & 63) == 48)
+        NGSceneWarmUpTerrain(FIX((s32)(2048 - x)), 0);
+    NGCameraSetPos(FIX((s32)(x + (frame & 63))), 0);
+    NGSceneUpdate();
+    NGSceneDraw();
+}
+
+/* Scroll a pixel a frame, breaking one ground block in view each frame
+ * and clearing its collision */
+static void run_tilemap_break(void) {
+    NGCameraSetPos(FIX((s32)frame), 0);
+    u16 tx = (u16)(frame / 16 + 2 + (frame * 7) % 16);
+    u16 ty = (u16)(MAP_H - 4 + (frame & 3));
+    NGSceneSetTileAt(tx, ty, 0);
+    NGSceneSetCollisionAt(tx, ty, 0);
+    NGSceneUpdate();
+    NGSceneDraw();
+}
+
+/* Break every other block along two ground rows before scrolling, so
+ * every column drawn reads through a grown edit overlay */
+static void setup_tilemap_edited(void) {
+    NGSceneSetTerrain(&map_asset);
+    for (u16 tx = 0; tx < MAP_W; tx += 2) {
+        NGSceneSetTileAt(tx, MAP_H - 4, 0);
+        NGSceneSetCollisionAt(tx, MAP_H - 3, 0);
+    }
+    NGSceneDraw();
+}
+
+static NGBackdropHandle backdrop;
+
+static void setup_backdrop(void) {
+    backdrop = NGBackdropCreate(&sprite_asset, NG_BACKDROP_WIDTH_INFINITE, 0, FIX_ONE / 2, 0);
+    NGBackdropAddToScene(backdrop, 0, 160, 0);
+    NGSceneDraw();
+}
+
+/* Four floor bands from half speed to full speed */
+static void setup_backdrop_bands(void) {
+    static const u16 rows[] = {0, 16, 32, 48};
+    static const fixed rates[] = {FIX_ONE / 2, FIX_ONE * 5 / 8, FIX_ONE * 3 / 4, FIX_ONE};
+    NGEngineSetDeferredDraw(1);
+    backdrop = NGBackdropCreate(&sprite_asset, NG_BACKDROP_WIDTH_INFINITE, 0, FIX_ONE / 2, 0);
+    NGBackdropSetBands(backdrop, rows, rates, 4);
+    NGBackdropAddToScene(backdrop, 0, 160, 0);
+    NGEngineFrameStart();
+    NGEngineFrameEnd();
+    NGWaitVBlank(); /* Upload the first frame before counting */
+}
+
+static void run_backdrop_bands(void) {
+    NGEngineFrameStart();
+    NGCameraSetPos(FIX((s32)(frame * 3)), 0);
+    NGEngineFrameEnd();
+}
+
+static void run_backdrop_scroll(void) {
+    NGCameraSetPos(FIX((s32)(frame * 3)), 0);
+    NGSceneUpdate();
+    NGSceneDraw();
+}
+
+/* Zoom sweeping 100% -> 50% -> 100% while scrolling */
+static void run_backdrop_zoom(void) {
+    u16 step = (u16)((frame >> 2) & 15);
+    NGCameraSetZoom((u8)(step < 8 ? 16 - step : 8 + (step - 8)));
+    run_backdrop_scroll();
+}
+
+/* A level: terrain, backdrop and 8 actors; the two levels use the flat and
+ * the chunked map */
+static void build_level(u8 level) {
+    NGSceneSetTerrain(level ? &map_chunked_asset : &map_asset);
+    backdrop = NGBackdropCreate(&sprite_asset, NG_BACKDROP_WIDTH_INFINITE, 0, FIX_ONE / 2, 0);
+    NGBackdropAddToScene(backdrop, 0, 160, 0);
+    for (u8 i = 0; i < 8; i++) {
+        actors[i] = NGActorCreate(&sprite_asset, 0, 0);
+        NGActorAddToScene(actors[i], FIX(i * 40), FIX(48 + level * 32), (u8)(i + 1));
+    }
+}
+
+static void setup_level(void) {
+    build_level(0);
+    NGSceneDraw();
+}
+
+/* Scroll each level for 64 frames, then reset and build the other one */
+static void run_scene_reset(void) {
+    if ((frame & 63) == 63) {
+        NGSceneReset();
+        build_level((u8)(~frame >> 6) & 1);
+    }
+    NGCameraSetPos(FIX((s32)(frame & 63)), 0);
+    NGSceneUpdate();
+    NGSceneDraw();
+}
+
+/* Same levels, the next one staged from frame 16 and swapped in at 63 */
+static void run_scene_stage(void) {
+    if ((frame & 63) == 16) {
+        NGSceneStageBegin();
+        build_level((u8)(~frame >> 6) & 1);
+    }
+    if ((frame & 63) == 63)
+        NGSceneStageSwap();
+    NGCameraSetPos(FIX((s32)(frame & 63)), 0);
+    NGSceneUpdate();
+    NGSceneDraw();
+}
+
+static void setup_physics(void) {
+    world = NGPhysWorldCreate();
+    NGPhysWorldSetGravity(world, 0, FIX_ONE / 4);
+    for (u8 i = 0; i < NG_PHYS_MAX_BODIES; i++) {
+        NGBodyHandle b =
+            NGPhysBodyCreateCircle(world, FIX(16 + (i % 8) * 36), FIX(16 + (i / 8) * 36), FIX(8));
+        NGPhysBodySetVel(b, FIX((s16)((i * 7) % 5) - 2), FIX((s16)((i * 3) % 4) - 2));
+        NGPhysBodySetRestitution(b, FIX_ONE * 3 / 4);
+    }
+}
+
+static void run_physics(void) {
+    NGPhysWorldUpdate(world, NULL, NULL);
+}
+
+/* Actors bound to the pool in bounds, every other body pinned in place */
+static void setup_physics_actors(void) {
+    setup_physics();
+    NGPhysWorldSetBounds(world, 0, FIX(320), 0, FIX(224));
+    for (u8 i = 0; i < ACTOR_COUNT; i++) {
+        NGBodyHandle b = &world->bodies[world->live[i]];
+        if (i & 1)
+            NGPhysBodySetStatic(b, 1);
+        actors[i] = NGActorCreate(&sprite_asset, 0, 0);
+        NGActorAddToScene(actors[i], 0, 0, (u8)(i + 1));
+        NGActorBindBody(actors[i], b, -FIX(8), -FIX(8));
+    }
+    NGSceneDraw();
+}
+
+static void run_physics_actors(void) {
+    NGPhysWorldUpdate(world, NULL, NULL);
+    NGSceneDraw();
+}
+
+/* Same pool in bounds, a quarter of it static pickup triggers on layer 1
+ * with their own pair handler */
+static u16 pickups;
+
+static void count_pickup(NGCollision *col, void *data) {
+    (void)col;
+    (*(u16 *)data)++;
+}
+
+static void setup_physics_pairs(void) {
+    setup_physics();
+    NGPhysWorldSetBounds(world, 0, FIX(320), 0, FIX(224));
+    for (u8 i = 0; i < world->live_count; i++) {
+        NGBodyHandle b = &world->bodies[world->live[i]];
+        if ((i & 3) == 0) {
+            NGPhysBodySetFlags(b, NG_BODY_STATIC | NG_BODY_TRIGGER);
+            NGPhysBodySetLayer(b, 0x02, 0x01);
+        }
+    }
+    NGPhysWorldSetPairCallback(world, 0, 1, count_pickup, &pickups);
+    NGPhysWorldIgnorePair(world, 1, 1, 1);
+    pickups = 0;
+}
+
+/* Boxes dropped onto the terrain, moving through one batch per update */
+static void setup_physics_terrain(void) {
+    NGSceneSetTerrain(&map_asset);
+    world = NGPhysWorldCreate();
+    NGPhysWorldSetGravity(world, 0, FIX_ONE / 4);
+    NGPhysWorldSetTerrain(world, NGSceneGetTerrain());
+    NGPhysWorldSetBounds(world, 0, FIX(MAP_W * 16), 0, FIX(MAP_H * 16));
+    for (u8 i = 0; i < NG_PHYS_MAX_BODIES; i++) {
+        NGBodyHandle b = NGPhysBodyCreateAABB(world, FIX(24 + i * 40), FIX(32 + (i & 7) * 24),
+                                              FIX(6), FIX(12));
+        NGPhysBodySetVel(b, (i & 1) ? FIX(2) : FIX(-2), 0);
+        NGPhysBodySetLayer(b, 0x01, 0);
+    }
+}
+
+/* Same boxes stepping at 30 Hz */
+static void setup_physics_half_rate(void) {
+    setup_physics_terrain();
+    NGPhysWorldSetStepRate(world, 30);
+}
+
+/* Same boxes watching for the hazard strips, events drained every frame */
+static u16 hazard_hits;
+
+static void setup_physics_tile_events(void) {
+    setup_physics_terrain();
+    for (u8 i = 0; i < world->live_count; i++)
+        NGPhysBodyWatchTiles(&world->bodies[world->live[i]], NG_TILE_HAZARD);
+    hazard_hits = 0;
+}
+
+static void run_physics_tile_events(void) {
+    NGArenaReset(&ng_arena_frame);
+    NGPhysWorldUpdate(world, NULL, NULL);
+    u8 count;
+    const NGTileEvent *ev = NGPhysWorldGetTileEvents(world, &count);
+    for (u8 i = 0; i < count; i++) {
+        if (ev[i].entered & NG_TILE_HAZARD)
+            hazard_hits++;
+    }
+}
+
+static void teardown_physics(void) {
+    NGPhysWorldDestroy(world);
+}
+
+/* Probes walking over the terrain, bouncing off walls */
+#define PROBE_COUNT 64
+
+typedef struct {
+    fixed x, y, vx, vy;
+} Probe;
+
+static Probe probes[PROBE_COUNT];
+
+static void place_probes(void) {
+    for (u8 i = 0; i < PROBE_COUNT; i++) {
+        probes[i].x = FIX(24 + i * 62);
+        probes[i].y = FIX(32 + (i & 7) * 24);
+        probes[i].vx = (i & 1) ? FIX(2) : FIX(-2);
+        probes[i].vy = 0;
+    }
+}
+
+static void setup_terrain(void) {
+    NGSceneSetTerrain(&map_asset);
+    place_probes();
+}
+
+static void setup_terrain_chunked(void) {
+    NGSceneSetTerrain(&map_chunked_asset);
+    place_probes();
+}
+
+static void run_terrain(void) {
+    NGTerrainHandle t = NGSceneGetTerrain();
+    for (u8 i = 0; i < PROBE_COUNT; i++) {
+        Probe *p = &probes[i];
+        fixed dir = p->vx;
+        p->vy += FIX_ONE / 2;
+        if (p->vy > FIX(8))
+            p->vy = FIX(8);
+        u8 hit = NGTerrainResolveAABB(t, &p->x, &p->y, FIX(6), FIX(12), &p->vx, &p->vy);
+        p->vx = (hit & (NG_COLL_LEFT | NG_COLL_RIGHT)) ? -dir : dir;
+        /* Jump now and then so platforms get tested from both sides */
+        if ((hit & NG_COLL_BOTTOM) && ((frame + i) & 31) == 0)
+            p->vy = FIX(-10);
+    }
+}
+
+/* Same probes as one structure-of-arrays batch */
+static fixed batch_x[PROBE_COUNT], batch_y[PROBE_COUNT];
+static fixed batch_vx[PROBE_COUNT], batch_vy[PROBE_COUNT];
+static fixed batch_hw[PROBE_COUNT], batch_hh[PROBE_COUNT];
+static fixed batch_dir[PROBE_COUNT];
+static u8 batch_hit[PROBE_COUNT];
+
+static void setup_terrain_batch(void) {
+    setup_terrain();
+    for (u8 i = 0; i < PROBE_COUNT; i++) {
+        batch_x[i] = probes[i].x;
+        batch_y[i] = probes[i].y;
+        batch_vx[i] = probes[i].vx;
+        batch_vy[i] = probes[i].vy;
+        batch_hw[i] = FIX(6);
+        batch_hh[i] = FIX(12);
+    }
+}
+
+static void run_terrain_batch(void) {
+    for (u8 i = 0; i < PROBE_COUNT; i++) {
+        batch_dir[i] = batch_vx[i];
+        batch_vy[i] += FIX_ONE / 2;
+        if (batch_vy[i] > FIX(8))
+            batch_vy[i] = FIX(8);
+    }
+    NGTerrainBatch batch = {batch_x,  batch_y,  batch_hw,  batch_hh,
+                            batch_vx, batch_vy, batch_hit, PROBE_COUNT};
+    NGTerrainResolveBatch(NGSceneGetTerrain(), &batch);
+    for (u8 i = 0; i < PROBE_COUNT; i++) {
+        u8 hit = batch_hit[i];
+        batch_vx[i] = (hit & (NG_COLL_LEFT | NG_COLL_RIGHT)) ? -batch_dir[i] : batch_dir[i];
+        if ((hit & NG_COLL_BOTTOM) && ((frame + i) & 31) == 0)
+            batch_vy[i] = FIX(-10);
+    }
+}
+
+/* Probes as bullets at pillar height: 24 px per frame, swept so the
+ * one-tile pillars stop them */
+static void setup_terrain_sweep(void) {
+    setup_terrain();
+    for (u8 i = 0; i < PROBE_COUNT; i++) {
+        probes[i].y = FIX(392 + (i & 3) * 16);
+        probes[i].vx *= 12;
+    }
+}
+
+static void run_terrain_sweep(void) {
+    NGTerrainHandle t = NGSceneGetTerrain();
+    for (u8 i = 0; i < PROBE_COUNT; i++) {
+        Probe *p = &probes[i];
+        NGTerrainSweep hit;
+        if (NGTerrainSweepAABB(t, p->x, p->y, FIX(2), FIX(2), p->vx, 0, &hit))
+            p->vx = -p->vx;
+        p->x = hit.x;
+        if (p->x < 0 || p->x > FIX(MAP_W * 16))
+            p->vx = -p->vx;
+    }
+}
+
+static NGLightingLayerHandle light;
+
+static void setup_lighting(void) {
+    setup_tilemap();
+    spawn_actors();
+    fill_palettes();
+    light = NGLightingPush(NG_LIGHTING_PRIORITY_AMBIENT);
+    NGLightingSetTint(light, 4, 0, -4);
+    NGLightingFadeBrightness(light, FIX_ONE / 4, 120);
+}
+
+static void run_lighting(void) {
+    NGLightingUpdate();
+}
+
+static void setup_lighting_sliced(void) {
+    setup_lighting();
+    NGLightingSetPaletteBudget(8);
+}
+
+/* Terrain palettes stay backed up but nothing on screen uses them */
+static void setup_lighting_hidden(void) {
+    setup_lighting();
+    NGSceneSetTerrainVisible(0);
+    NGSceneDraw();
+}
+
+/* Same fade while actors flash when hit: each flash tints a borrowed
+ * palette slot instead of the palette the other actors share */
+#define FLASH_FRAMES 8
+
+static u8 flash_left[ACTOR_COUNT];
+
+static void setup_lighting_flash(void) {
+    setup_lighting();
+    for (u8 i = 0; i < ACTOR_COUNT; i++)
+        flash_left[i] = 0;
+    NGSceneDraw();
+}
+
+static void run_lighting_flash(void) {
+    if (frame % 4 == 0) {
+        u8 i = (u8)(frame / 4 * 7 % ACTOR_COUNT);
+        u8 slot = NGPalSlotBorrow(1);
+        if (slot != NG_PAL_NO_SLOT) {
+            NGPalFadeToColor(slot, NG_COLOR_WHITE, 24);
+            NGActorSetPalette(actors[i], slot);
+            NGPalSlotRelease(slot);
+            flash_left[i] = FLASH_FRAMES;
+        }
+    }
+    for (u8 i = 0; i < ACTOR_COUNT; i++) {
+        if (flash_left[i] && !--flash_left[i])
+            NGActorSetPalette(actors[i], 1);
+    }
+    NGLightingUpdate();
+    NGSceneDraw();
+}
+
+/* Day to night transition: 32 palettes crossfaded from two backups, then
+ * dimmed, every frame */
+#define FADE_PALETTES 32
+#define FADE_DAY      16
+#define FADE_NIGHT    (FADE_DAY + FADE_PALETTES)
+#define FADE_SHOWN    (FADE_NIGHT + FADE_PALETTES)
+
+static void setup_palette_crossfade(void) {
+    for (u16 p = 0; p < FADE_PALETTES; p++) {
+        for (u16 c = 1; c < 16; c++) {
+            u8 v = (u8)(c * 2);
+            NGPalSetColor((u8)(FADE_DAY + p), (u8)c, (NGColor)NG_RGB(v, 31 - p, 31 - v));
+            NGPalSetColor((u8)(FADE_NIGHT + p), (u8)c, (NGColor)NG_RGB(v / 4, p % 8, v));
+        }
+    }
+}
+
+static void run_palette_crossfade(void) {
+    u8 step = (u8)(frame % 64);
+    u8 ratio = (u8)((step < 32 ? step : 63 - step) * 8);
+    for (u8 p = 0; p < FADE_PALETTES; p++) {
+        NGPalCrossfade(FADE_SHOWN + p, FADE_DAY + p, FADE_NIGHT + p, ratio);
+        NGPalAdjustBrightness(FADE_SHOWN + p, (s8)(-(ratio >> 5)));
+    }
+}
+
+/* A HUD that a game would reprint in full every frame */
+static void run_fix_hud(void) {
+    NGTextPrintf(NGFixLayoutXY(1, 3), 0, "SCORE %08u", frame * 10);
+    NGTextPrintf(NGFixLayoutXY(28, 3), 0, "TIME %02u", 99 - (frame / 60) % 100);
+    NGTextPrint(NGFixLayoutXY(1, 27), 0, "PLAYER 1             CREDITS 03");
+    NGFixFlush();
+}
+
+/* Same score and timer as counters */
+static NGFixCounter score, timer;
+
+static void setup_fix_counter(void) {
+    NGFixCounterInit(&score, 7, 3, 8, 0, 1);
+    NGFixCounterInit(&timer, 33, 3, 2, 0, 1);
+    NGFixCounterSetBCD(&timer, NG_BCD(99));
+    NGFixFlush();
+}
+
+static void run_fix_counter(void) {
+    NGFixCounterAdd(&score, NG_BCD(10));
+    if (frame % 60 == 59)
+        NGFixCounterSub(&timer, NG_BCD(1));
+    NGFixFlush();
+}
+
+/* Score, timer and health HUD, with a pause menu over it shown every other
+ * two seconds and its cursor moving, the fix layer capped at 48 cells a
+ * frame */
+static NGWidgetHandle hud_score, hud_timer, hud_health, pause_menu, pause_list;
+
+static const char *const pause_items[] = {"RESUME", "OPTIONS", "SOUND TEST", "RESTART",
+                                          "QUIT"};
+
+static void setup_widgets(void) {
+    NGEngineConfig cfg = {.widgets = 16};
+    NGEngineInitWithConfig(&cfg);
+    u16 font = NGTextGetFont();
+
+    NGWidgetHandle hud = NGWidgetCreateGroup(NULL, 1, 3);
+    NGWidgetCreateLabel(hud, 0, 0, 0, 0, "SCORE");
+    hud_score = NGWidgetCreateCounter(hud, 6, 0, 8, 0, 1);
+    hud_timer = NGWidgetCreateCounter(hud, 32, 0, 2, 0, 1);
+    hud_health = NGWidgetCreateBar(hud, 0, 24, 10, 100, (u16)(font + '='), (u16)(font + '-'), 0);
+    NGWidgetSetValue(hud_timer, 99);
+    NGWidgetSetValue(hud_health, 100);
+
+    pause_menu = NGWidgetCreateGroup(NULL, 10, 8);
+    NGWidgetCreatePanel(pause_menu, 0, 0, 20, 12, &sprite_asset);
+    NGWidgetCreateLabel(pause_menu, 7, 1, 0, 1, "PAUSED");
+    pause_list = NGWidgetCreateList(pause_menu, 4, 4, 12, pause_items, 5, 0, 1);
+    NGWidgetSetVisible(pause_menu, 0);
+    NGWidgetsSetBudget(48);
+}
+
+static void run_widgets(void) {
+    NGEngineFrameStart();
+    NGWidgetSetValue(hud_score, NGWidgetGetValue(hud_score) + 10);
+    if (frame % 60 == 59)
+        NGWidgetSetValue(hud_timer, NGWidgetGetValue(hud_timer) - 1);
+    if (frame % 16 == 0)
+        NGWidgetSetValue(hud_health, 100 - (frame / 16) % 100);
+    NGWidgetSetVisible(pause_menu, (frame / 120) & 1);
+    NGWidgetSetSelection(pause_list, (u8)((frame / 8) % 5));
+    NGEngineFrameEnd();
+}
+
+/* A 10-segment sprite gauge draining a pixel a frame, then refilling in
+ * steps of 6 */
+static NGWidgetHandle gauge;
+
+static void setup_gauge(void) {
+    NGEngineConfig cfg = {.widgets = 4, .gauge_sprites = 16};
+    NGEngineInitWithConfig(&cfg);
+    gauge = NGWidgetCreateGauge(NULL, 2, 24, 10, 160, 0x100, 1);
+    NGWidgetSetValue(gauge, 160);
+}
+
+static void run_gauge(void) {
+    NGEngineFrameStart();
+    u16 t = (u16)(frame % 200);
+    NGWidgetSetValue(gauge, t < 160 ? 160u - t : (u32)(t - 160) * 6);
+    NGEngineFrameEnd();
+}
+
+/* Score popups rising for 48 frames, a new one every 6 frames from four
+ * strings, over a combo counter changed every 40 */
+#define POPUP_COUNT 8
+#define POPUP_LIFE  48
+
+static const char *const popup_texts[] = {"+100", "+500", "+1000", "BONUS"};
+static NGSpriteTextHandle popups[POPUP_COUNT];
+static NGSpriteTextHandle combo;
+
+static void setup_text_popups(void) {
+    NGEngineConfig cfg = {.text_sprites = 64};
+    NGEngineInitWithConfig(&cfg);
+    NGSpriteTextSetFont(512);
+    combo = NGSpriteTextCreate("COMBO 0", 8, 200, 1);
+    for (u8 i = 0; i < POPUP_COUNT; i++)
+        popups[i] = NULL;
+}
+
+static void run_text_popups(void) {
+    NGEngineFrameStart();
+    if (frame % 6 == 0) {
+        u8 slot = (u8)((frame / 6) % POPUP_COUNT);
+        NGSpriteTextDestroy(popups[slot]);
+        popups[slot] = NGSpriteTextCreate(popup_texts[(frame / 6) % 4], (s16)(slot * 36 + 8),
+                                          160, 2);
+    }
+    for (u8 i = 0; i < POPUP_COUNT; i++) {
+        u16 age = (u16)((frame - i * 6) % POPUP_LIFE);
+        NGSpriteTextSetPosition(popups[i], (s16)(i * 36 + 8), (s16)(160 - age));
+    }
+    if (frame % 40 == 39) {
+        char text[12] = "COMBO ";
+        text[6] = (char)('0' + (frame / 40) % 10);
+        text[7] = 0;
+        NGSpriteTextSet(combo, text);
+    }
+    NGEngineFrameEnd();
+}
+
+/* The packed map unpacked again and again by the engine's idle job, one
+ * NG_DECOMP_BUDGET run per slice that fits before VBlank */
+static u8 map_unpacked[MAP_BYTES];
+
+static void map_unpacked_done(void *dst, u32 size, void *user) {
+    (void)user;
+    const u8 *map = dst;
+    if (size != MAP_BYTES || memcmp(map, map_tiles, MAP_BYTES / 2) ||
+        memcmp(map + MAP_BYTES / 2, map_collision, MAP_BYTES / 2))
+        printf("decomp_map: unpacked map differs\n");
+    NGDecompQueue(map_packed, map_unpacked, map_unpacked_done, NULL);
+}
+
+static void setup_decomp(void) {
+    NGDecompQueue(map_packed, map_unpacked, map_unpacked_done, NULL);
+}
+
+static void run_decomp(void) {
+    NGEngineFrameStart();
+    NGEngineFrameEnd();
+}
+
+/* Three always-busy idle jobs sharing the lines from NG_MOCK_FRAME_END_LINE
+ * to VBlank: the first runs while it fits, the next is too long for what
+ * is left, the last fills the gap. Every eighth frame runs late and gets
+ * no idle time. Each job dirties fix rows, like a HUD rebuilt off-frame. */
+#define IDLE_SLICES_ON_TIME 5
+static u8 idle_slices[3];
+
+static u8 idle_slice(u8 job) {
+    idle_slices[job]++;
+    NGTextPrintf(NGFixLayoutXY(2, (u8)(4 + job)), 0, "JOB %u %03u", job, idle_slices[job]);
+    return 1;
+}
+
+static u8 idle_first(void) {
+    return idle_slice(0);
+}
+
+static u8 idle_long(void) {
+    return idle_slice(1);
+}
+
+static u8 idle_short(void) {
+    return idle_slice(2);
+}
+
+static void setup_idle(void) {
+    NGIdleJobAdd(idle_short, 2, 8);
+    NGIdleJobAdd(idle_long, 1, 50);
+    NGIdleJobAdd(idle_first, 0, 30);
+}
+
+static void run_idle(void) {
+    u8 late = ++frame % 8 == 0;
+    u8 before = (u8)(idle_slices[0] + idle_slices[1] + idle_slices[2]);
+    ng_mock_regs.lspcmode = (late ? NG_VBLANK_LINE_FIRST + 4 : NG_MOCK_FRAME_END_LINE) << 7;
+    NGEngineFrameStart();
+    u8 ran = (u8)(idle_slices[0] + idle_slices[1] + idle_slices[2] - before);
+    if (ran != (late ? 0 : IDLE_SLICES_ON_TIME) || idle_slices[1])
+        printf("idle_jobs: wrong slices run\n");
+    NGEngineFrameEnd();
+}
+
+typedef struct {
+    const char *name;
+    void (*setup)(void);
+    void (*run)(void);
+    void (*teardown)(void);
+    u16 iterations;
+} Scenario;
+
+static const Scenario scenarios[] = {
+    {"graphic_static", setup_graphic, run_graphic_static, NULL, 240},
+    {"graphic_move", setup_graphic, run_graphic_move, NULL, 240},
+    {"graphic_move_deferred", setup_graphic_deferred, run_graphic_deferred, NULL, 240},
+    {"graphic_frame_skip", setup_graphic_frame_skip, run_graphic_frame_skip, NULL, 240},
+    {"graphic_animate", setup_graphic_animate, run_graphic_animate, NULL, 240},
+    {"graphic_metasprite", setup_graphic_metasprite, run_graphic_animate, NULL, 240},
+    {"graphic_zoom", setup_graphic, run_graphic_zoom, NULL, 240},
+    {"graphic_spawn", setup_graphic_spawn, run_graphic_spawn, NULL, 240},
+    {"graphic_wave", setup_graphic, run_graphic_wave, NULL, 240},
+    {"graphic_offscreen", setup_graphic_offscreen, run_graphic_offscreen, NULL, 240},
+    {"graphic_9slice_resize", setup_panel_resize, run_panel_resize, NULL, 240},
+    {"particles_bullets", setup_particles, run_particles, NULL, 240},
+    {"particles_multiplex", setup_particles_multiplex, run_particles_multiplex, NULL, 240},
+    {"tilemap_scroll_x", setup_tilemap, run_tilemap_scroll_x, NULL, 600},
+    {"tilemap_scroll_xy", setup_tilemap, run_tilemap_scroll_xy, NULL, 600},
+    {"tilemap_chunked", setup_tilemap_chunked, run_tilemap_scroll_xy, NULL, 600},
+    {"tilemap_cut", setup_tilemap_chunked, run_tilemap_cut, NULL, 600},
+    {"tilemap_break", setup_tilemap, run_tilemap_break, NULL, 240},
+    {"tilemap_break_chunked", setup_tilemap_chunked, run_tilemap_break, NULL, 240},
+    {"tilemap_edited", setup_tilemap_edited, run_tilemap_scroll_x, NULL, 600},
+    {"backdrop_scroll", setup_backdrop, run_backdrop_scroll, NULL, 600},
+    {"backdrop_bands", setup_backdrop_bands, run_backdrop_bands, NULL, 600},
+    {"backdrop_zoom", setup_backdrop, run_backdrop_zoom, NULL, 600},
+    {"scene_reset", setup_level, run_scene_reset, NULL, 256},
+    {"scene_stage", setup_level, run_scene_stage, NULL, 256},
+    {"physics_bodies", setup_physics, run_physics, teardown_physics, 600},
+    {"physics_actors", setup_physics_actors, run_physics_actors, teardown_physics, 600},
+    {"physics_pairs", setup_physics_pairs, run_physics, teardown_physics, 600},
+    {"physics_terrain", setup_physics_terrain, run_physics, teardown_physics, 600},
+    {"physics_half_rate", setup_physics_half_rate, run_physics, teardown_physics, 600},
+    {"physics_tile_events", setup_physics_tile_events, run_physics_tile_events, teardown_physics,
+     600},
+    {"terrain_resolve", setup_terrain, run_terrain, NULL, 600},
+    {"terrain_resolve_chunked", setup_terrain_chunked, run_terrain, NULL, 600},
+    {"terrain_resolve_batch", setup_terrain_batch, run_terrain_batch, NULL, 600},
+    {"terrain_sweep", setup_terrain_sweep, run_terrain_sweep, NULL, 600},
+    {"lighting_fade", setup_lighting, run_lighting, NULL, 120},
+    {"lighting_fade_sliced", setup_lighting_sliced, run_lighting, NULL, 120},
+    {"lighting_fade_hidden", setup_lighting_hidden, run_lighting, NULL, 120},
+    {"lighting_hit_flash", setup_lighting_flash, run_lighting_flash, NULL, 120},
+    {"palette_crossfade", setup_palette_crossfade, run_palette_crossfade, NULL, 600},
+    {"fix_hud", NULL, run_fix_hud, NULL, 600},
+    {"fix_counter", setup_fix_counter, run_fix_counter, NULL, 600},
+    {"widget_hud_pause", setup_widgets, run_widgets, NULL, 600},
+    {"widget_gauge", setup_gauge, run_gauge, NULL, 600},
+    {"sprite_text_popups", setup_text_popups, run_text_popups, NULL, 600},
+    {"decomp_map", setup_decomp, run_decomp, NULL, 600},
+    {"idle_jobs", setup_idle, run_idle, NULL, 600},
+};
+
+#define SCENARIO_COUNT (sizeof(scenarios) / sizeof(scenarios[0]))
+
+/* ============================================================
+ * Runner
+ * ============================================================ */
+
+typedef struct {
+    u32 writes;
+    u32 addr_setups;
+    u32 pal_writes;
+    double ns;
+} Result;
+
+static Result results[SCENARIO_COUNT];
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void run_scenario(const Scenario *s, Result *r) {
+    static u16 pal_prev[NG_MOCK_PALRAM_WORDS];
+
+    NGMockReset();
+    NGEngineInit();
+    NGEngineSetDeferredDraw(0);
+    frame = 0;
+    if (s->setup)
+        s->setup();
+    NGPalFlush();
+
+    NGMockResetCounters();
+    memcpy(pal_prev, ng_mock_palram, sizeof(pal_prev));
+    r->pal_writes = 0;
+    r->ns = 0;
+
+    for (u16 i = 0; i < s->iterations; i++, frame++) {
+        double start = now_ns();
+        s->run();
+        r->ns += now_ns() - start;
+
+        /* Palette RAM is plain memory, so upload as VBlank would and count
+         * changed words instead */
+        NGPalFlush();
+        for (u16 w = 0; w < NG_MOCK_PALRAM_WORDS; w++) {
+            if (ng_mock_palram[w] != pal_prev[w]) {
+                pal_prev[w] = ng_mock_palram[w];
+                r->pal_writes++;
+            }
+        }
+    }
+    /* Flush a list submitted by the last iteration */
+    NGWaitVBlank();
+
+    r->writes = ng_mock_vram.writes;
+    r->addr_setups = ng_mock_vram.addr_setups;
+
+    if (s->teardown)
+        s->teardown();
+    NGSceneReset();
+}
+
+/* Baseline format: one "name writes addr_setups" line per scenario */
+static int check_baseline(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        printf("No baseline at %s, skipping check\n", path);
+        return 0;
+    }
+
+    int failed = 0;
+    char name[64];
+    unsigned long writes, setups;
+    while (fscanf(f, "%63s %lu %lu", name, &writes, &setups) == 3) {
+        for (u8 i = 0; i < SCENARIO_COUNT; i++) {
+            if (strcmp(name, scenarios[i].name) != 0)
+                continue;
+            const Result *r = &results[i];
+            if (r->writes > writes || r->addr_setups > setups) {
+                printf("REGRESSION %s: writes %lu -> %lu, addr setups %lu -> %lu\n", name, writes,
+                       (unsigned long)r->writes, setups, (unsigned long)r->addr_setups);
+                failed = 1;
+            } else if (r->writes < writes || r->addr_setups < setups) {
+                printf("improved   %s: writes %lu -> %lu, addr setups %lu -> %lu\n", name, writes,
+                       (unsigned long)r->writes, setups, (unsigned long)r->addr_setups);
+            }
+        }
+    }
+    fclose(f);
+    return failed;
+}
+
+static int write_baseline(const char *path) {
+    FILE *f = fopen(path, "w");
+    if (!f) {
+        printf("Cannot write %s\n", path);
+        return 1;
+    }
+    for (u8 i = 0; i < SCENARIO_COUNT; i++) {
+        fprintf(f, "%s %lu %lu\n", scenarios[i].name, (unsigned long)results[i].writes,
+                (unsigned long)results[i].addr_setups);
+    }
+    fclose(f);
+    printf("Baseline written to %s\n", path);
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    const char *check_path = NULL;
+    const char *write_path = NULL;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "-b") == 0)
+            check_path = argv[i + 1];
+        else if (strcmp(argv[i], "-w") == 0)
+            write_path = argv[i + 1];
+    }
+
+    build_map();
+    build_chunks();
+    build_packed_map();
+
+    printf("%-24s %6s %10s %10s %10s %10s\n", "scenario", "iters", "vram/it", "addr/it",
+           "pal/it", "ns/it");
+    for (u8 i = 0; i < SCENARIO_COUNT; i++) {
+        const Scenario *s = &scenarios[i];
+        Result *r = &results[i];
+        run_scenario(s, r);
+        printf("%-24s %6u %10.1f %10.1f %10.1f %10.0f\n", s->name, s->iterations,
+               (double)r->writes / s->iterations, (double)r->addr_setups / s->iterations,
+               (double)r->pal_writes / s->iterations, r->ns / s->iterations);
+    }
+
+    if (write_path)
+        return write_baseline(write_path);
+    if (check_path)
+        return check_baseline(check_path);
+    return 0;
+}
@@ -0,0 +1,162 @@
+/*
+ * This file is part of ProGearSDK.
+ * Copyright (c) 2024-2025 ProGearSDK contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+/**
+ * @file ng_mock.c
+ * @brief Fake VRAM state and stubs for the HAL modules not built on the host.
+ *
+ * Only the hardware-facing parts of the HAL are replaced here. Color,
+ * palette, sprite, fix, display list and raster table code is compiled
+ * unmodified.
+ */
+
+#include <ng_mock.h>
+#include <ng_hardware.h>
+#include <ng_display_list.h>
+#include <ng_palette.h>
+#include <ng_input.h>
+#include <ng_audio.h>
+#include <ng_interrupt.h>
+#include <ng_vblank.h>
+#include <ng_sram.h>
+#include <ng_memcard.h>
+#include <ng_string.h>
+
+NGMockVram ng_mock_vram;
+NGMockRegs ng_mock_regs;
+u16 ng_mock_palram[NG_MOCK_PALRAM_WORDS];
+
+void NGMockResetCounters(void) {
+    ng_mock_vram.writes = 0;
+    ng_mock_vram.reads = 0;
+    ng_mock_vram.addr_setups = 0;
+    ng_mock_vram.mod_setups = 0;
+}
+
+void NGMockReset(void) {
+    for (u32 i = 0; i < NG_MOCK_VRAM_WORDS; i++)
+        ng_mock_vram.mem[i] = 0;
+    for (u16 i = 0; i < NG_MOCK_PALRAM_WORDS; i++)
+        ng_mock_palram[i] = 0;
+    for (u16 i = 0; i < NG_PAL_COUNT / 8; i++) {
+        ng_pal_group[i] = NULL;
+        ng_pal_dirty[i] = 0;
+    }
+    ng_pal_groups_used = 0;
+    ng_pal_dirty_any = 0;
+    ng_mock_vram.addr = 0;
+    ng_mock_vram.mod = 1;
+    NGMockResetCounters();
+}
+
+/* Jobs see the beam at the first VBlank line, with the whole window left;
+ * the main loop then sees it at NG_MOCK_FRAME_END_LINE */
+static void run_vblank_jobs(void) {
+    ng_vblank_count++;
+    if (ng_vblank_scheduled) {
+        ng_mock_regs.lspcmode = NG_VBLANK_LINE_FIRST << 7;
+        NGVBlankRunJobs();
+    }
+    ng_mock_regs.lspcmode = NG_MOCK_FRAME_END_LINE << 7;
+}
+
+/* Replays the pending display list, uploads dirty palettes and runs the
+ * scheduled VBlank jobs, exactly like the _vblank handler in crt0.s */
+void NGWaitVBlank(void) {
+    u16 *dl = ng_display_list_pending;
+    if (!dl) {
+        NGPalFlush();
+        run_vblank_jobs();
+        return;
+    }
+    ng_display_list_pending = 0;
+
+    u16 count;
+    while ((count = *dl++) != 0) {
+        NGMockVramSetAddr(*dl++);
+        NGMockVramSetMod(*dl++);
+        if (count & NG_DISPLAY_LIST_FILL) {
+            NGMockVramFill(*dl++, (u16)(count & ~NG_DISPLAY_LIST_FILL));
+        } else {
+            while (count--)
+                NGMockVramWrite(*dl++);
+        }
+    }
+    NGPalFlush();
+    run_vblank_jobs();
+}
+
+/* Input: no controller connected */
+void NGInputInit(void) {}
+
+void NGInputUpdate(void) {}
+
+u8 NGInputPressed(u8 player, u16 buttons) {
+    (void)player;
+    (void)buttons;
+    return 0;
+}
+
+/* Audio: no Z80 */
+void NGAudioInit(void) {}
+void NGAudioUpdate(void) {}
+
+void NGSfxPlay(u8 sfx_index) {
+    (void)sfx_index;
+}
+
+void NGSfxPlayPan(u8 sfx_index, NGPan pan) {
+    (void)sfx_index;
+    (void)pan;
+}
+
+/* Timer: raster tables are built and compiled but never played */
+void NGTimerSetReload(u32 value) {
+    (void)value;
+}
+
+void NGTimerEnable(void) {}
+
+u8 NGTimerIsEnabled(void) {
+    return 1;
+}
+
+/* Backup RAM and memory card: nothing is kept, and no card is inserted */
+void NGSramUnlock(void) {}
+void NGSramLock(void) {}
+
+void NGSramReadBlock(u16 offset, void *buffer, u16 length) {
+    (void)offset;
+    memset(buffer, 0, length);
+}
+
+void NGSramWriteBlock(u16 offset, const void *buffer, u16 length) {
+    (void)offset;
+    (void)buffer;
+    (void)length;
+}
+
+u8 NGMemcardIsPresent(void) {
+    return 0;
+}
+
+u8 NGMemcardIsWriteProtected(void) {
+    return 1;
+}
+
+u16 NGMemcardRead(u16 offset, void *buffer, u16 length) {
+    (void)offset;
+    (void)buffer;
+    (void)length;
+    return 0;
+}
+
+u16 NGMemcardWrite(u16 offset, const void *buffer, u16 length) {
+    (void)offset;
+    (void)buffer;
+    (void)length;
+    return 0;
+}
@@ -12,6 +12,9 @@
  * - Fixed-width integer types
  * - Fixed-point math and trigonometry
  * - Arena memory allocator
+ * - Pool allocator
+ * - Generated lookup tables
+ * - LZ4 decompression
  *
  * This library contains foundational utilities with no hardware dependencies.
  * It can be used by both the HAL and SDK layers.
@@ -28,6 +31,9 @@
  * - @ref types - Fixed-width integer types (u8, u16, u32, etc.)
  * - @ref math - Fixed-point math, vectors, and trigonometry
  * - @ref arena - Bump-pointer arena memory allocator
+ * - @ref pool - Fixed-size block pools carved from arenas
+ * - @ref tables - ROM lookup tables generated at build time
+ * - @ref decomp - LZ4 unpacking, at once or within a per-frame budget
  */
 
 #ifndef NG_NEOGEO_CORE_H
@@ -38,9 +44,14 @@
 
 /* Fixed-point math */
 #include <ng_math.h>
+#include <ng_tables.h>
 
 /* Memory management */
 #include <ng_arena.h>
+#include <ng_pool.h>
+
+/* Decompression */
+#include <ng_decomp.h>
 
 /* String/memory functions (for compiler-generated calls) */
 #include <ng_string.h>
@@ -15,6 +15,11 @@
  *   ng_arena_persistent - Lives entire game (player data, global state)
  *   ng_arena_state      - Cleared on level/screen changes
  *   ng_arena_frame      - Cleared every frame (temp strings, scratch)
+ *
+ * Builds with NG_ARENA_STATS (on by default in NG_PROFILE builds) track the
+ * peak usage and allocation counts of each arena, and where the first
+ * failed allocation came from, so arena sizes can be trimmed to what the
+ * game really uses. NGProfileDrawArenas() shows them on the fix layer.
  */
 
 #ifndef NG_ARENA_H
@@ -22,6 +27,14 @@
 
 #include <ng_types.h>
 
+#ifndef NG_ARENA_STATS
+#ifdef NG_PROFILE
+#define NG_ARENA_STATS 1
+#else
+#define NG_ARENA_STATS 0
+#endif
+#endif
+
 /**
  * @defgroup arena Arena Memory Allocator
  * @ingroup hal
@@ -37,6 +50,14 @@ typedef struct NGArena {
     u8 *base;    /**< Start of memory region */
     u8 *current; /**< Current allocation pointer (bump pointer) */
     u8 *end;     /**< End of memory region */
+#if NG_ARENA_STATS
+    u8 *peak;        /**< Highest current seen (NG_ARENA_STATS) */
+    u16 allocs;      /**< Allocations since the last reset (NG_ARENA_STATS) */
+    u16 peak_allocs; /**< Most allocations between two resets (NG_ARENA_STATS) */
+    u16 failures;    /**< Allocations that returned NULL (NG_ARENA_STATS) */
+    u32 fail_size;   /**< Size asked for by the first failure (NG_ARENA_STATS) */
+    void *fail_site; /**< Return address of the first failed NGArenaAlloc() call (NG_ARENA_STATS) */
+#endif
 } NGArena;
 
 /** Mark for save/restore (temporary allocations) */
@@ -103,7 +124,41 @@ u32 NGArenaUsed(NGArena *arena);
  * @return Bytes available
  */
 u32 NGArenaRemaining(NGArena *arena);
+
+/**
+ * Get the total size of the arena.
+ * @param arena Arena to query
+ * @return Bytes between base and end
+ */
+u32 NGArenaSize(NGArena *arena);
+/** @} */
+
+#if NG_ARENA_STATS
+/** @name Statistics (NG_ARENA_STATS builds only) */
+/** @{ */
+
+/**
+ * Get the most bytes ever in use at once.
+ * @param arena Arena to query
+ * @return Peak bytes used since init or NGArenaResetStats()
+ */
+u32 NGArenaPeak(NGArena *arena);
+
+/**
+ * Get the most allocations made between two resets. For ng_arena_frame,
+ * which is reset every frame, this is the peak allocations per frame.
+ * @param arena Arena to query
+ * @return Peak allocation count, including the current period
+ */
+u16 NGArenaPeakAllocs(NGArena *arena);
+
+/**
+ * Forget peaks and failures; the peak restarts from current usage.
+ * @param arena Arena to reset statistics for
+ */
+void NGArenaResetStats(NGArena *arena);
 /** @} */
+#endif
 
 /** @name Convenience Macros */
 /** @{ */
@@ -130,14 +185,20 @@ u32 NGArenaRemaining(NGArena *arena);
 /** @name Standard Arenas */
 /** @{ */
 
-/** Default size for persistent arena (can be overridden before including ng_arena.h) */
+/**
+ * Default size for persistent arena (can be overridden before including ng_arena.h).
+ * ProGear's object tables (NGEngineConfig) take about 16 KB of it at the
+ * default sizes, plus about 3 KB once a physics world is created.
+ * The three arenas take 40 KB of the 60 KB of work RAM the linker script
+ * gives the game (hal/rom/link.ld); grow one by shrinking another.
+ */
 #ifndef NG_ARENA_PERSISTENT_SIZE
-#define NG_ARENA_PERSISTENT_SIZE 8192 /**< 8 KB */
+#define NG_ARENA_PERSISTENT_SIZE 20480 /**< 20 KB */
 #endif
 
 /** Default size for state arena (can be overridden before including ng_arena.h) */
 #ifndef NG_ARENA_STATE_SIZE
-#define NG_ARENA_STATE_SIZE 24576 /**< 24 KB */
+#define NG_ARENA_STATE_SIZE 16384 /**< 16 KB */
 #endif
 
 /** Default size for frame arena (can be overridden before including ng_arena.h) */
@@ -0,0 +1,125 @@
+/*
+ * This file is part of ProGearSDK.
+ * Copyright (c) 2024-2025 ProGearSDK contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+/**
+ * @file ng_decomp.h
+ * @brief LZ4 decompression, at once or spread over frames.
+ *
+ * Compressed data is an LZ4 block (the raw block format, without the
+ * frame header) after a 4-byte big-endian count of the bytes it unpacks
+ * to. tools/progear_assets.py writes it for the `data` section of
+ * assets.yaml: NGData_<name> is the packed array, NGDATA_<NAME>_SIZE the
+ * unpacked size.
+ *
+ * NGDecompress() unpacks everything before it returns. Large data does
+ * better through the job queue: NGDecompQueue() adds a job, and each
+ * NGDecompRun() writes at most the budget's worth of output bytes, picking
+ * up the job where the last call stopped, even in the middle of a literal
+ * run or match. Jobs finish in the order they were queued, and a job's
+ * callback runs from the NGDecompRun() that writes its last byte.
+ * The engine calls NGDecompRun() from an idle job (ng_idle.h), as many
+ * times as fit in the lines the frame has left before VBlank.
+ *
+ * The source and destination must stay valid, and banked sources mapped,
+ * until the job is done. The destination may not overlap the source.
+ *
+ * @code
+ * static u8 dialog[NGDATA_CHAPTER2_SIZE];
+ *
+ * static void dialog_ready(void *dst, u32 size, void *user) {
+ *     chapter_loaded = 1;
+ * }
+ *
+ * NGDecompQueue(NGData_chapter2, dialog, dialog_ready, NULL);
+ * @endcode
+ */
+
+#ifndef NG_DECOMP_H
+#define NG_DECOMP_H
+
+#include <ng_types.h>
+
+/**
+ * @defgroup decomp Decompression
+ * @ingroup core
+ * @brief LZ4 unpacking with a per-frame byte budget.
+ * @{
+ */
+
+#ifndef NG_DECOMP_JOBS
+#define NG_DECOMP_JOBS 8 /**< Jobs that can be queued at once */
+#endif
+
+#ifndef NG_DECOMP_BUDGET
+#define NG_DECOMP_BUDGET 1024 /**< Default output bytes per NGDecompRun() */
+#endif
+
+#define NG_DECOMP_HEADER 4    /**< Size header before the LZ4 block */
+#define NG_DECOMP_NO_JOB 0xFF /**< NGDecompQueue() result when the queue is full */
+
+/** Job handle, valid until the job is done or cancelled */
+typedef u8 NGDecompJob;
+
+/**
+ * Called when a job has written its last byte.
+ * @param dst Destination given to NGDecompQueue()
+ * @param size Bytes unpacked
+ * @param user Pointer given to NGDecompQueue()
+ */
+typedef void (*NGDecompCallback)(void *dst, u32 size, void *user);
+
+/**
+ * @param src Compressed data
+ * @return Bytes it unpacks to
+ */
+u32 NGDecompSize(const u8 *src);
+
+/**
+ * Unpack all of src now.
+ * @param src Compressed data
+ * @param dst Destination, NGDecompSize(src) bytes
+ * @return Bytes unpacked
+ */
+u32 NGDecompress(const u8 *src, void *dst);
+
+/**
+ * Queue src to be unpacked by NGDecompRun().
+ * @param src Compressed data
+ * @param dst Destination, NGDecompSize(src) bytes
+ * @param done Called when the job is done, or NULL
+ * @param user Passed to done
+ * @return Job handle, or NG_DECOMP_NO_JOB if NG_DECOMP_JOBS are queued
+ */
+NGDecompJob NGDecompQueue(const u8 *src, void *dst, NGDecompCallback done, void *user);
+
+/**
+ * Drop a job; its destination keeps what was written. Its callback is not
+ * called.
+ * @param job Job handle
+ */
+void NGDecompCancel(NGDecompJob job);
+
+/** Drop every job. */
+void NGDecompClear(void);
+
+/**
+ * Set the output bytes each NGDecompRun() may write.
+ * @param bytes Budget (default NG_DECOMP_BUDGET, 0 stops the queue)
+ */
+void NGDecompSetBudget(u16 bytes);
+
+/**
+ * Unpack queued jobs, oldest first, up to the budget.
+ * @return Bytes written
+ */
+u16 NGDecompRun(void);
+
+/** @return Jobs queued and not done */
+u8 NGDecompPending(void);
+
+/** @} */ /* end of decomp group */
+
+#endif /* NG_DECOMP_H */
@@ -71,9 +71,30 @@ static inline fixed FIX_MUL(fixed a, fixed b) {
     return result;
 }
 
-/** Divide two fixed values (slow - prefer multiply by reciprocal) */
+/** Divide two fixed values (slow: 64-bit division, prefer FIX_DIV_FAST) */
 #define FIX_DIV(a, b) ((fixed)((((long long)(a)) << FIX_SHIFT) / (b)))
 
+/**
+ * Divide two fixed values without a 64-bit division.
+ * Looks up the divisor's reciprocal in an interpolated table and applies it
+ * with two 16x16 multiplies. The divisor is cut to 16 significant bits,
+ * so the result is within about 1/8192 of its value (plus 1 LSB).
+ * @param a Dividend
+ * @param b Divisor; 0 saturates to the largest value of a's sign
+ * @return a / b in fixed format
+ */
+fixed NGFixDivFast(fixed a, fixed b);
+
+/** Fast fixed division, see NGFixDivFast() */
+#define FIX_DIV_FAST(a, b) NGFixDivFast((a), (b))
+
+/**
+ * Reciprocal from the same table as FIX_DIV_FAST.
+ * @param x Value to invert (fixed)
+ * @return FIX_ONE / x
+ */
+fixed NGRecip(fixed x);
+
 /** Absolute value of fixed */
 #define FIX_ABS(x) ((x) < 0 ? -(x) : (x))
 
@@ -131,7 +152,7 @@ typedef u8 angle_t;
 /** @{ */
 
 /**
- * Get sine of angle.
+ * Get sine of angle. A single table load, exact to 1/65536.
  * @param angle Angle (0-255)
  * @return Sine value as fixed (-FIX_ONE to +FIX_ONE)
  */
@@ -144,8 +165,25 @@ fixed NGSin(angle_t angle);
  */
 fixed NGCos(angle_t angle);
 
+/**
+ * Get sine of a fine angle.
+ * The table has NG_SIN_STEPS entries per circle (see ng_tables.h); the low
+ * bits of the angle below that resolution are ignored.
+ * @param angle Angle, 65536 units per circle (0x4000 = 90 degrees)
+ * @return Sine value as fixed (-FIX_ONE to +FIX_ONE)
+ */
+fixed NGSinFine(u16 angle);
+
+/**
+ * Get cosine of a fine angle.
+ * @param angle Angle, 65536 units per circle
+ * @return Cosine value as fixed (-FIX_ONE to +FIX_ONE)
+ */
+fixed NGCosFine(u16 angle);
+
 /**
  * Compute angle from vector.
+ * Reduced to one octant, then one 32/16 divide and a table lookup.
  * @param y Y component (fixed)
  * @param x X component (fixed)
  * @return Angle from positive X axis (0-255)
@@ -242,6 +280,17 @@ fixed NGVec2Length(NGVec2 v);
  * @return Unit vector in same direction
  */
 NGVec2 NGVec2Normalize(NGVec2 v);
+
+/**
+ * Normalize vector to unit length without square root or division.
+ * Uses an interpolated inverse square root table; components are within
+ * about 1/8192 of the exact unit vector, and axis-aligned input gives
+ * exactly FIX_ONE. Works for any length, including vectors whose squared
+ * length would overflow fixed.
+ * @param v Input vector
+ * @return Unit vector in same direction, or (0, 0) for a zero vector
+ */
+NGVec2 NGVec2NormalizeFast(NGVec2 v);
 /** @} */
 
 /** @} */ /* end of math group */
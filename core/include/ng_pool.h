@@ -0,0 +1,172 @@
+/*
+ * This file is part of ProGearSDK.
+ * Copyright (c) 2024-2025 ProGearSDK contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+/**
+ * @file ng_pool.h
+ * @brief Fixed-size block pools carved from an arena
+ *
+ * A pool hands out blocks of one size and takes them back one at a time,
+ * which an arena cannot do. Free blocks are chained through their own
+ * first word, so alloc and free are O(1) and a pool costs no memory
+ * beyond its blocks. The blocks come from an arena, so they are released
+ * in bulk with it: a pool in ng_arena_state lives until the next level.
+ *
+ * A pool set groups pools of increasing block size (buckets) for objects
+ * whose size varies, such as menu items or effect userdata. Each request
+ * goes to the smallest bucket that fits.
+ *
+ * @code
+ * static NGPool sparks;
+ * NGPoolInit(&sparks, &ng_arena_state, sizeof(Spark), 48);
+ *
+ * Spark *s = NGPoolAlloc(&sparks);   // NULL when all 48 are in use
+ * ...
+ * NGPoolFree(&sparks, s);
+ * @endcode
+ */
+
+#ifndef NG_POOL_H
+#define NG_POOL_H
+
+#include <ng_types.h>
+#include <ng_arena.h>
+
+/**
+ * @defgroup pool Pool Allocator
+ * @ingroup core
+ * @brief O(1) fixed-size block allocation and free.
+ * @{
+ */
+
+/** @name Configuration */
+/** @{ */
+
+#ifndef NG_POOL_DEBUG
+/**
+ * 1 to poison blocks and check frees: freed blocks are filled with
+ * NG_POOL_POISON_FREE and checked on the next alloc (catches writes after
+ * free), allocated ones with NG_POOL_POISON_ALLOC (catches reads of
+ * uninitialized fields), and frees of foreign or already free blocks are
+ * ignored. Problems are counted in NGPool::errors.
+ */
+#define NG_POOL_DEBUG 0
+#endif
+
+#define NG_POOL_POISON_FREE  0xDD /**< Fill byte of free blocks (debug) */
+#define NG_POOL_POISON_ALLOC 0xCD /**< Fill byte of allocated blocks (debug) */
+
+#ifndef NG_POOL_MAX_BUCKETS
+#define NG_POOL_MAX_BUCKETS 6 /**< Pools in an NGPoolSet */
+#endif
+/** @} */
+
+/** @name Types */
+/** @{ */
+
+/** Pool of equal-size blocks. All fields are read-only for callers. */
+typedef struct NGPool {
+    u8 *blocks;      /**< First block */
+    void *free_list; /**< First free block; each holds the next in its first word */
+    u16 block_size;  /**< Bytes per block, rounded up for alignment */
+    u16 capacity;    /**< Number of blocks */
+    u16 used;        /**< Blocks allocated now */
+    u16 high_water;  /**< Most blocks allocated at once */
+    u16 errors;      /**< Bad frees and corrupted free blocks seen (NG_POOL_DEBUG) */
+} NGPool;
+
+/** Pools of increasing block size, searched smallest first */
+typedef struct NGPoolSet {
+    NGPool pools[NG_POOL_MAX_BUCKETS]; /**< Buckets, smallest block size first */
+    u8 count;                          /**< Buckets in use */
+} NGPoolSet;
+/** @} */
+
+/** @name Pools */
+/** @{ */
+
+/**
+ * Carve a pool out of an arena.
+ * @param pool Pool to initialize
+ * @param arena Arena that provides the blocks
+ * @param block_size Bytes per block (raised to a pointer and 4-byte aligned)
+ * @param count Number of blocks
+ * @return 1 on success, 0 if the arena is too small (nothing is allocated)
+ */
+u8 NGPoolInit(NGPool *pool, NGArena *arena, u16 block_size, u16 count);
+
+/**
+ * Allocate a block.
+ * @param pool Pool to allocate from
+ * @return Block (contents undefined), or NULL if the pool is empty
+ */
+void *NGPoolAlloc(NGPool *pool);
+
+/**
+ * Return a block to its pool.
+ * @param pool Pool the block came from
+ * @param block Block from NGPoolAlloc(), or NULL (ignored)
+ */
+void NGPoolFree(NGPool *pool, void *block);
+
+/**
+ * Free every block at once. The high-water mark is kept.
+ * @param pool Pool to reset
+ */
+void NGPoolReset(NGPool *pool);
+
+/**
+ * Check whether a pointer is one of a pool's blocks.
+ * @param pool Pool to check
+ * @param ptr Pointer to test
+ * @return 1 if ptr is the start of a block of this pool
+ */
+u8 NGPoolOwns(const NGPool *pool, const void *ptr);
+
+/**
+ * Get the number of free blocks.
+ * @param pool Pool to query
+ * @return capacity - used
+ */
+static inline u16 NGPoolAvailable(const NGPool *pool) {
+    return (u16)(pool->capacity - pool->used);
+}
+/** @} */
+
+/** @name Pool Sets */
+/** @{ */
+
+/**
+ * Carve a pool per bucket out of an arena.
+ * @param set Set to initialize
+ * @param arena Arena that provides the blocks
+ * @param sizes Block size of each bucket, ascending
+ * @param counts Block count of each bucket
+ * @param bucket_count Number of buckets (up to NG_POOL_MAX_BUCKETS)
+ * @return 1 on success, 0 if the arena is too small or the sizes are not
+ *         ascending (the arena is left as it was)
+ */
+u8 NGPoolSetInit(NGPoolSet *set, NGArena *arena, const u16 *sizes, const u16 *counts,
+                 u8 bucket_count);
+
+/**
+ * Allocate from the smallest bucket that fits and has a free block.
+ * @param set Pool set
+ * @param size Bytes needed
+ * @return Block, or NULL if no bucket large enough has one free
+ */
+void *NGPoolSetAlloc(NGPoolSet *set, u16 size);
+
+/**
+ * Return a block to the bucket it came from.
+ * @param set Pool set
+ * @param block Block from NGPoolSetAlloc(), or NULL (ignored)
+ */
+void NGPoolSetFree(NGPoolSet *set, void *block);
+/** @} */
+
+/** @} */ /* end of pool group */
+
+#endif /* NG_POOL_H */
@@ -0,0 +1,105 @@
+/*
+ * This file is part of ProGearSDK.
+ * Copyright (c) 2024-2025 ProGearSDK contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+/**
+ * @file ng_tables.h
+ * @brief Generated constant lookup tables.
+ *
+ * The tables are computed on the host by tools/gen_tables.py, which the
+ * core Makefile runs into build/ng_tables.c, and are linked into ROM with
+ * libneogeo_core.a. Functions that used to do per-call arithmetic (a
+ * divide by 255 for sprite heights, range checks for shrink values) read
+ * them with a single indexed load.
+ *
+ * Most code should call the wrappers (NGSin(), NGSpriteAdjustedHeight(),
+ * ...) rather than index the tables directly.
+ */
+
+#ifndef NG_TABLES_H
+#define NG_TABLES_H
+
+#include <ng_types.h>
+#include <ng_math.h>
+
+/**
+ * @defgroup tables Lookup Tables
+ * @ingroup core
+ * @brief ROM tables generated at build time.
+ * @{
+ */
+
+/** @name Configuration */
+/** @{ */
+
+#ifndef NG_SIN_BITS
+/**
+ * log2 of the sine table size (8-12). Sets the resolution of NGSinFine():
+ * 10 gives 1024 steps per circle in 4 KB of ROM. Set NG_SIN_BITS on the
+ * core make command line, which passes it to both the generator and the
+ * compiler.
+ */
+#define NG_SIN_BITS 10
+#endif
+
+#define NG_SIN_STEPS (1 << NG_SIN_BITS) /**< Sine table entries per circle */
+/** @} */
+
+/** @name Math */
+/** @{ */
+
+/** sin(i * 2pi / NG_SIN_STEPS) as 16.16 fixed */
+extern const fixed ng_sin_table[NG_SIN_STEPS];
+
+/** 2^30 / (32768 + 128 * i): reciprocal of a normalized 16-bit mantissa */
+extern const u16 ng_recip_table[257];
+
+/** 32768 / sqrt(1 + i / 64): inverse square root over [1, 4] */
+extern const u16 ng_rsqrt_table[193];
+
+/** atan(i / 64) in angle_t units: one octant */
+extern const u8 ng_atan_table[65];
+/** @} */
+
+/** @name Sprites */
+/** @{ */
+
+/** Graphic scale (0-256, 256 = 1.0x) to 8-bit hardware shrink (255 = full size) */
+extern const u8 ng_shrink_table[257];
+
+/** Graphic scale (0-256) to SCB2 word with equal horizontal and vertical shrink */
+extern const u16 ng_shrink_val_table[257];
+
+/** Height in tiles (1-32) of a sprite of [rows] tiles at vertical shrink [v_shrink] */
+extern const u8 ng_sprite_height_table[33][256];
+
+#define NG_ZOOM_SHRINK_LEVELS 9  /**< Scales 128-256 in steps of 16 (camera zoom levels) */
+#define NG_ZOOM_SHRINK_COLS   16 /**< Widest sprite group with a precomputed pattern */
+
+/** Index of the pattern for a group of `cols` sprites in a ng_zoom_shrink_table row */
+#define NG_ZOOM_SHRINK_INDEX(cols) (((cols) - 1) * (cols) / 2)
+
+/**
+ * SCB2 words that NGSpriteShrinkSet() writes for a group of 1 to
+ * NG_ZOOM_SHRINK_COLS sprites at scale 128 + 16 * level, the horizontal
+ * shrink spread over the columns. Group patterns are packed one after
+ * another, starting at NG_ZOOM_SHRINK_INDEX(cols).
+ */
+extern const u16 ng_zoom_shrink_table[NG_ZOOM_SHRINK_LEVELS][NG_ZOOM_SHRINK_INDEX(17)];
+/** @} */
+
+/** @name Checksums */
+/** @{ */
+
+/**
+ * CRC-16/CCITT (polynomial 0x1021) of each byte value, for a byte-at-a-time
+ * CRC: crc = (crc << 8) ^ ng_crc16_table[(crc >> 8) ^ byte]
+ */
+extern const u16 ng_crc16_table[256];
+/** @} */
+
+/** @} */ /* end of tables group */
+
+#endif /* NG_TABLES_H */
@@ -18,22 +18,42 @@ void NGArenaInit(NGArena *arena, void *buffer, u32 size) {
     arena->base = (u8 *)buffer;
     arena->current = arena->base;
     arena->end = arena->base + size;
+#if NG_ARENA_STATS
+    NGArenaResetStats(arena);
+#endif
 }
 
 void *NGArenaAlloc(NGArena *arena, u32 size) {
-    u8 *aligned = (u8 *)(((u32)arena->current + 3) & ~3); // 4-byte alignment for m68k
+    u8 *aligned = (u8 *)(((uintptr_t)arena->current + 3) & ~(uintptr_t)3); // 4-byte alignment for m68k
     u8 *next = aligned + size;
 
     if (next > arena->end) {
+#if NG_ARENA_STATS
+        if (!arena->failures++) {
+            arena->fail_size = size;
+            arena->fail_site = __builtin_return_address(0);
+        }
+#endif
         return 0;
     }
 
     arena->current = next;
+#if NG_ARENA_STATS
+    if (next > arena->peak)
+        arena->peak = next;
+    if (arena->allocs < 0xFFFF)
+        arena->allocs++;
+#endif
     return aligned;
 }
 
 void NGArenaReset(NGArena *arena) {
     arena->current = arena->base;
+#if NG_ARENA_STATS
+    if (arena->allocs > arena->peak_allocs)
+        arena->peak_allocs = arena->allocs;
+    arena->allocs = 0;
+#endif
 }
 
 NGArenaMark NGArenaSave(NGArena *arena) {
@@ -52,6 +72,29 @@ u32 NGArenaRemaining(NGArena *arena) {
     return (u32)(arena->end - arena->current);
 }
 
+u32 NGArenaSize(NGArena *arena) {
+    return (u32)(arena->end - arena->base);
+}
+
+#if NG_ARENA_STATS
+u32 NGArenaPeak(NGArena *arena) {
+    return (u32)(arena->peak - arena->base);
+}
+
+u16 NGArenaPeakAllocs(NGArena *arena) {
+    return arena->allocs > arena->peak_allocs ? arena->allocs : arena->peak_allocs;
+}
+
+void NGArenaResetStats(NGArena *arena) {
+    arena->peak = arena->current;
+    arena->allocs = 0;
+    arena->peak_allocs = 0;
+    arena->failures = 0;
+    arena->fail_size = 0;
+    arena->fail_site = 0;
+}
+#endif
+
 void NGArenaSystemInit(void) {
     NGArenaInit(&ng_arena_persistent, persistent_buffer, NG_ARENA_PERSISTENT_SIZE);
     NGArenaInit(&ng_arena_state, state_buffer, NG_ARENA_STATE_SIZE);
@@ -0,0 +1,233 @@
+/*
+ * This file is part of ProGearSDK.
+ * Copyright (c) 2024-2025 ProGearSDK contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+/**
+ * @file ng_decomp.c
+ * @brief LZ4 block decoder and job queue
+ *
+ * An LZ4 sequence is a token byte (literal count in the high nibble,
+ * match length - 4 in the low one; 15 continues in 255-summed extension
+ * bytes), the literals, and a little-endian match offset. The last
+ * sequence has literals only. A job stops when it runs out of budget and
+ * keeps where it was in the sequence, so a long run costs no more in one
+ * frame than the budget allows.
+ */
+
+#include <ng_decomp.h>
+#include <ng_string.h>
+
+#define MATCH_MIN 4
+
+/* Where a job is in the current sequence */
+#define PHASE_TOKEN    0
+#define PHASE_LITERALS 1
+#define PHASE_MATCH    2
+
+typedef struct {
+    const u8 *src; /* Next byte of the LZ4 block */
+    u8 *dst;
+    u8 *out; /* Next byte to write */
+    u8 *end; /* dst + unpacked size */
+    u32 count; /* Literal or match bytes left in the phase */
+    u16 offset;
+    u8 phase;
+    u8 match_code; /* Low nibble of the token, for after the literals */
+    NGDecompCallback done;
+    void *user;
+} Job;
+
+static Job jobs[NG_DECOMP_JOBS];
+static u8 job_used[NG_DECOMP_JOBS];
+
+/* Handles in queue order */
+static u8 order[NG_DECOMP_JOBS];
+static u8 order_count;
+
+static u16 budget = NG_DECOMP_BUDGET;
+
+/* ============================================================================
+ * Decoder
+ * ========================================================================== */
+
+/* Copies n bytes forward one at a time (1 <= n <= 65535), so a match may
+ * read bytes it has just written: offset 1 repeats one byte */
+#if defined(__m68k__) && !defined(__CPPCHECK__)
+
+static inline u8 *copy_bytes(u8 *d, const u8 *s, u16 n) {
+    __asm__ volatile("    subq.w  #1, %[n]\n\t"
+                     "1:  move.b  (%[s])+, (%[d])+\n\t"
+                     "    dbra    %[n], 1b\n\t"
+                     : [d] "+a"(d), [s] "+a"(s), [n] "+d"(n)
+                     :
+                     : "cc", "memory");
+    return d;
+}
+
+#else
+
+static inline u8 *copy_bytes(u8 *d, const u8 *s, u16 n) {
+    do {
+        *d++ = *s++;
+    } while (--n);
+    return d;
+}
+
+#endif
+
+static u32 read_length(const u8 **src, u32 length) {
+    const u8 *s = *src;
+    u8 b;
+    do {
+        b = *s++;
+        length += b;
+    } while (b == 255);
+    *src = s;
+    return length;
+}
+
+/* Unpack up to limit bytes; returns the bytes written */
+static u16 step(Job *job, u16 limit) {
+    const u8 *src = job->src;
+    u8 *out = job->out;
+    u16 left = limit;
+
+    while (left) {
+        if (job->phase == PHASE_TOKEN) {
+            if (out == job->end)
+                break;
+            u8 token = *src++;
+            job->count = token >> 4;
+            if (job->count == 15)
+                job->count = read_length(&src, 15);
+            job->match_code = token & 0x0F;
+            job->phase = PHASE_LITERALS;
+        }
+
+        if (job->phase == PHASE_LITERALS) {
+            u16 n = job->count < left ? (u16)job->count : left;
+            if (n) {
+                memcpy(out, src, n);
+                out += n;
+                src += n;
+                left = (u16)(left - n);
+                job->count -= n;
+                if (job->count)
+                    break;
+            }
+            if (out == job->end)
+                break; /* Last sequence: literals only */
+            job->offset = (u16)(src[0] | (src[1] << 8));
+            src += 2;
+            job->count = job->match_code + MATCH_MIN;
+            if (job->match_code == 15)
+                job->count = read_length(&src, job->count);
+            job->phase = PHASE_MATCH;
+            if (!left)
+                break;
+        }
+
+        u16 n = job->count < left ? (u16)job->count : left;
+        const u8 *from = out - job->offset;
+        if (job->offset >= n)
+            memcpy(out, from, n);
+        else
+            copy_bytes(out, from, n);
+        out += n;
+        left = (u16)(left - n);
+        job->count -= n;
+        if (!job->count)
+            job->phase = PHASE_TOKEN;
+    }
+
+    job->src = src;
+    job->out = out;
+    return (u16)(limit - left);
+}
+
+static void start(Job *job, const u8 *src, void *dst) {
+    job->src = src + NG_DECOMP_HEADER;
+    job->dst = (u8 *)dst;
+    job->out = job->dst;
+    job->end = job->dst + NGDecompSize(src);
+    job->phase = PHASE_TOKEN;
+}
+
+u32 NGDecompSize(const u8 *src) {
+    return ((u32)src[0] << 24) | ((u32)src[1] << 16) | ((u32)src[2] << 8) | src[3];
+}
+
+u32 NGDecompress(const u8 *src, void *dst) {
+    Job job;
+    start(&job, src, dst);
+    while (step(&job, 0xFFFF))
+        ;
+    return (u32)(job.out - job.dst);
+}
+
+/* ============================================================================
+ * Job queue
+ * ========================================================================== */
+
+NGDecompJob NGDecompQueue(const u8 *src, void *dst, NGDecompCallback done, void *user) {
+    for (u8 i = 0; i < NG_DECOMP_JOBS; i++) {
+        if (job_used[i])
+            continue;
+        start(&jobs[i], src, dst);
+        jobs[i].done = done;
+        jobs[i].user = user;
+        job_used[i] = 1;
+        order[order_count++] = i;
+        return i;
+    }
+    return NG_DECOMP_NO_JOB;
+}
+
+static void dequeue(u8 handle) {
+    u8 i = 0;
+    while (i < order_count && order[i] != handle)
+        i++;
+    if (i == order_count)
+        return;
+    order_count--;
+    for (; i < order_count; i++)
+        order[i] = order[i + 1];
+    job_used[handle] = 0;
+}
+
+void NGDecompCancel(NGDecompJob job) {
+    if (job < NG_DECOMP_JOBS && job_used[job])
+        dequeue(job);
+}
+
+void NGDecompClear(void) {
+    for (u8 i = 0; i < NG_DECOMP_JOBS; i++)
+        job_used[i] = 0;
+    order_count = 0;
+}
+
+void NGDecompSetBudget(u16 bytes) {
+    budget = bytes;
+}
+
+u16 NGDecompRun(void) {
+    u16 left = budget;
+    while (order_count && left) {
+        u8 handle = order[0];
+        Job *job = &jobs[handle];
+        left = (u16)(left - step(job, left));
+        if (job->out != job->end)
+            continue; /* Out of budget */
+        /* Done: free the slot first, so the callback can queue the next */
+        dequeue(handle);
+        if (job->done)
+            job->done(job->dst, (u32)(job->out - job->dst), job->user);
+    }
+    return (u16)(budget - left);
+}
+
+u8 NGDecompPending(void) {
+    return order_count;
+}
@@ -5,62 +5,99 @@
  */
 
 #include <ng_math.h>
+#include <ng_tables.h>
+
+// 32/16 unsigned divide; the quotient must fit in 16 bits
+static inline u16 divu16(u32 n, u16 d) {
+#if defined(__m68k__) && !defined(__CPPCHECK__)
+    __asm__("divu.w %1, %0" : "+d"(n) : "dm"(d) : "cc");
+    return (u16)n;
+#else
+    return (u16)(n / d);
+#endif
+}
 
-// sin(i * 2 * PI / 256) * 32767, 256 entries covering 0-360 degrees
-static const fixed sin_table[256] = {
-    0,      804,    1607,   2410,   3211,   4011,   4807,   5601,   6392,   7179,   7961,   8739,
-    9511,   10278,  11038,  11792,  12539,  13278,  14009,  14732,  15446,  16150,  16845,  17530,
-    18204,  18867,  19519,  20159,  20787,  21402,  22004,  22594,  23169,  23731,  24278,  24811,
-    25329,  25831,  26318,  26789,  27244,  27683,  28105,  28510,  28897,  29268,  29621,  29955,
-    30272,  30571,  30851,  31113,  31356,  31580,  31785,  31970,  32137,  32284,  32412,  32520,
-    32609,  32678,  32727,  32757,  32767,  32757,  32727,  32678,  32609,  32520,  32412,  32284,
-    32137,  31970,  31785,  31580,  31356,  31113,  30851,  30571,  30272,  29955,  29621,  29268,
-    28897,  28510,  28105,  27683,  27244,  26789,  26318,  25831,  25329,  24811,  24278,  23731,
-    23169,  22594,  22004,  21402,  20787,  20159,  19519,  18867,  18204,  17530,  16845,  16150,
-    15446,  14732,  14009,  13278,  12539,  11792,  11038,  10278,  9511,   8739,   7961,   7179,
-    6392,   5601,   4807,   4011,   3211,   2410,   1607,   804,    0,      -804,   -1607,  -2410,
-    -3211,  -4011,  -4807,  -5601,  -6392,  -7179,  -7961,  -8739,  -9511,  -10278, -11038, -11792,
-    -12539, -13278, -14009, -14732, -15446, -16150, -16845, -17530, -18204, -18867, -19519, -20159,
-    -20787, -21402, -22004, -22594, -23169, -23731, -24278, -24811, -25329, -25831, -26318, -26789,
-    -27244, -27683, -28105, -28510, -28897, -29268, -29621, -29955, -30272, -30571, -30851, -31113,
-    -31356, -31580, -31785, -31970, -32137, -32284, -32412, -32520, -32609, -32678, -32727, -32757,
-    -32767, -32757, -32727, -32678, -32609, -32520, -32412, -32284, -32137, -31970, -31785, -31580,
-    -31356, -31113, -30851, -30571, -30272, -29955, -29621, -29268, -28897, -28510, -28105, -27683,
-    -27244, -26789, -26318, -25831, -25329, -24811, -24278, -23731, -23169, -22594, -22004, -21402,
-    -20787, -20159, -19519, -18867, -18204, -17530, -16845, -16150, -15446, -14732, -14009, -13278,
-    -12539, -11792, -11038, -10278, -9511,  -8739,  -7961,  -7179,  -6392,  -5601,  -4807,  -4011,
-    -3211,  -2410,  -1607,  -804,
-};
+// Reciprocal of a mantissa with its top bit set, as 2^30 / m (16384-32768)
+static inline u16 recip_mantissa(u16 m) {
+    u8 i = (u8)(m >> 7);
+    u16 r = ng_recip_table[i];
+    u16 step = (u16)(r - ng_recip_table[i + 1]);
+    return (u16)(r - (((u32)step * (u16)(m & 0x7F)) >> 7));
+}
 
 fixed NGSin(angle_t angle) {
-    return ((fixed)sin_table[angle]) << 1;
+    return ng_sin_table[(u16)angle << (NG_SIN_BITS - 8)];
 }
 
 fixed NGCos(angle_t angle) {
-    return ((fixed)sin_table[(u8)(angle + 64)]) << 1;
+    return ng_sin_table[(u16)(u8)(angle + 64) << (NG_SIN_BITS - 8)];
 }
 
-angle_t NGAtan2(fixed y, fixed x) {
-    if (x == 0 && y == 0)
-        return 0;
+fixed NGSinFine(u16 angle) {
+    return ng_sin_table[angle >> (16 - NG_SIN_BITS)];
+}
 
-    fixed abs_x = FIX_ABS(x);
-    fixed abs_y = FIX_ABS(y);
+fixed NGCosFine(u16 angle) {
+    return ng_sin_table[(u16)(angle + 0x4000) >> (16 - NG_SIN_BITS)];
+}
 
-    u8 octant = 0;
-    fixed ratio;
+fixed NGFixDivFast(fixed a, fixed b) {
+    u32 ua = (u32)a;
+    u32 ub = (u32)b;
+    u8 neg = 0;
 
-    if (abs_x >= abs_y) {
-        ratio = FIX_DIV(abs_y, abs_x);
-    } else {
-        ratio = FIX_DIV(abs_x, abs_y);
-        octant = 1;
+    if (a < 0) {
+        ua = -ua;
+        neg = 1;
+    }
+    if (b < 0) {
+        ub = -ub;
+        neg ^= 1;
+    }
+    if (ub <= 1) {
+        // Divisor 0 saturates, divisor 1/65536 is the only exact shift
+        u32 q = ub ? ua << 16 : 0x7FFFFFFF;
+        return neg ? -(fixed)q : (fixed)q;
     }
 
-    // Linear approximation: atan(x) ≈ x * 32 / PI
-    angle_t angle = (angle_t)((ratio * 32) >> FIX_SHIFT);
+    // b = m * 2^(16 - lz), so a / b in 16.16 is (a * 2^30 / m) >> (30 - lz)
+    u8 lz = (u8)__builtin_clz(ub);
+    u16 r = recip_mantissa((u16)((ub << lz) >> 16));
+    u8 shift = (u8)(30 - lz);
+    u32 hi = (u32)(u16)(ua >> 16) * r;
+    u32 lo = (u32)(u16)ua * r;
+    u32 q;
+    if (shift >= 16)
+        q = (hi + (lo >> 16)) >> (shift - 16);
+    else
+        q = (hi << (16 - shift)) + (lo >> shift);
+
+    return neg ? -(fixed)q : (fixed)q;
+}
+
+fixed NGRecip(fixed x) {
+    return NGFixDivFast(FIX_ONE, x);
+}
 
-    if (octant)
+angle_t NGAtan2(fixed y, fixed x) {
+    if (x == 0 && y == 0)
+        return 0;
+
+    u32 abs_x = (u32)FIX_ABS(x);
+    u32 abs_y = (u32)FIX_ABS(y);
+    u8 steep = abs_y > abs_x;
+    u32 hi = steep ? abs_y : abs_x;
+    u32 lo = steep ? abs_x : abs_y;
+
+    // Drop to 15 bits so lo * 64 / hi is a single DIVU
+    u8 lz = (u8)__builtin_clz(hi);
+    if (lz < 17) {
+        hi >>= 17 - lz;
+        lo >>= 17 - lz;
+    }
+    angle_t angle = ng_atan_table[divu16((lo << 6) + (hi >> 1), (u16)hi)];
+
+    if (steep)
         angle = 64 - angle;
     if (x < 0)
         angle = 128 - angle;
@@ -126,3 +163,38 @@ NGVec2 NGVec2Normalize(NGVec2 v) {
         return (NGVec2){0, 0};
     return (NGVec2){FIX_DIV(v.x, len), FIX_DIV(v.y, len)};
 }
+
+NGVec2 NGVec2NormalizeFast(NGVec2 v) {
+    u32 ax = (u32)FIX_ABS(v.x);
+    u32 ay = (u32)FIX_ABS(v.y);
+    if (ay == 0)
+        return (NGVec2){FIX_SIGN(v.x), 0};
+    if (ax == 0)
+        return (NGVec2){0, FIX_SIGN(v.y)};
+
+    // Scale so the larger component is 15 bits; the direction is unchanged
+    s8 shift = (s8)(17 - __builtin_clz(ax | ay));
+    if (shift > 0) {
+        ax >>= shift;
+        ay >>= shift;
+    } else {
+        ax <<= -shift;
+        ay <<= -shift;
+    }
+
+    // len^2 = m * 2^28 * 4^k with m in [1, 4)
+    u32 len_sq = (u32)(u16)ax * (u16)ax + (u32)(u16)ay * (u16)ay;
+    u8 out_shift = 13;
+    if (len_sq >= (1UL << 30)) {
+        len_sq >>= 2;
+        out_shift = 14;
+    }
+    u8 i = (u8)((len_sq - (1UL << 28)) >> 22);
+    u16 r = ng_rsqrt_table[i];
+    u16 step = (u16)(r - ng_rsqrt_table[i + 1]);
+    r = (u16)(r - (((u32)step * (u16)(len_sq >> 6)) >> 16));
+
+    fixed x = (fixed)(((u32)(u16)ax * r) >> out_shift);
+    fixed y = (fixed)(((u32)(u16)ay * r) >> out_shift);
+    return (NGVec2){v.x < 0 ? -x : x, v.y < 0 ? -y : y};
+}
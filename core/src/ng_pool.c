@@ -0,0 +1,150 @@
+/*
+ * This file is part of ProGearSDK.
+ * Copyright (c) 2024-2025 ProGearSDK contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+/**
+ * @file ng_pool.c
+ * @brief Fixed-size block pools
+ */
+
+#include <ng_pool.h>
+#include <ng_string.h>
+
+/* Free blocks hold the next free block in their first word */
+typedef struct FreeBlock {
+    struct FreeBlock *next;
+} FreeBlock;
+
+static void link_all(NGPool *pool) {
+    FreeBlock *next = 0;
+    u8 *block = pool->blocks + (u32)pool->block_size * pool->capacity;
+
+    /* Built back to front so blocks are handed out in address order */
+    for (u16 i = 0; i < pool->capacity; i++) {
+        block -= pool->block_size;
+#if NG_POOL_DEBUG
+        memset(block, NG_POOL_POISON_FREE, pool->block_size);
+#endif
+        ((FreeBlock *)block)->next = next;
+        next = (FreeBlock *)block;
+    }
+    pool->free_list = next;
+    pool->used = 0;
+}
+
+u8 NGPoolInit(NGPool *pool, NGArena *arena, u16 block_size, u16 count) {
+    if (block_size < sizeof(FreeBlock))
+        block_size = sizeof(FreeBlock);
+    block_size = (u16)((block_size + 3) & ~3);
+
+    u8 *blocks = (u8 *)NGArenaAlloc(arena, (u32)block_size * count);
+    if (!blocks)
+        return 0;
+
+    pool->blocks = blocks;
+    pool->block_size = block_size;
+    pool->capacity = count;
+    pool->high_water = 0;
+    pool->errors = 0;
+    link_all(pool);
+    return 1;
+}
+
+void *NGPoolAlloc(NGPool *pool) {
+    FreeBlock *block = (FreeBlock *)pool->free_list;
+    if (!block)
+        return 0;
+
+    pool->free_list = block->next;
+    pool->used++;
+    if (pool->used > pool->high_water)
+        pool->high_water = pool->used;
+
+#if NG_POOL_DEBUG
+    const u8 *bytes = (const u8 *)block;
+    for (u16 i = sizeof(FreeBlock); i < pool->block_size; i++) {
+        if (bytes[i] != NG_POOL_POISON_FREE) {
+            pool->errors++; /* Written after it was freed */
+            break;
+        }
+    }
+    memset(block, NG_POOL_POISON_ALLOC, pool->block_size);
+#endif
+    return block;
+}
+
+void NGPoolFree(NGPool *pool, void *block) {
+    if (!block)
+        return;
+
+#if NG_POOL_DEBUG
+    if (!NGPoolOwns(pool, block)) {
+        pool->errors++;
+        return;
+    }
+    for (const FreeBlock *f = (const FreeBlock *)pool->free_list; f; f = f->next) {
+        if (f == block) {
+            pool->errors++; /* Double free */
+            return;
+        }
+    }
+    memset(block, NG_POOL_POISON_FREE, pool->block_size);
+#endif
+
+    ((FreeBlock *)block)->next = (FreeBlock *)pool->free_list;
+    pool->free_list = block;
+    pool->used--;
+}
+
+void NGPoolReset(NGPool *pool) {
+    link_all(pool);
+}
+
+u8 NGPoolOwns(const NGPool *pool, const void *ptr) {
+    const u8 *p = (const u8 *)ptr;
+    if (p < pool->blocks || p >= pool->blocks + (u32)pool->block_size * pool->capacity)
+        return 0;
+    return (u32)(p - pool->blocks) % pool->block_size == 0;
+}
+
+u8 NGPoolSetInit(NGPoolSet *set, NGArena *arena, const u16 *sizes, const u16 *counts,
+                 u8 bucket_count) {
+    NGArenaMark mark = NGArenaSave(arena);
+
+    set->count = 0;
+    if (bucket_count > NG_POOL_MAX_BUCKETS)
+        return 0;
+    for (u8 i = 0; i < bucket_count; i++) {
+        if ((i > 0 && sizes[i] <= sizes[i - 1]) ||
+            !NGPoolInit(&set->pools[i], arena, sizes[i], counts[i])) {
+            NGArenaRestore(arena, mark);
+            return 0;
+        }
+    }
+    set->count = bucket_count;
+    return 1;
+}
+
+void *NGPoolSetAlloc(NGPoolSet *set, u16 size) {
+    for (u8 i = 0; i < set->count; i++) {
+        NGPool *pool = &set->pools[i];
+        if (pool->block_size >= size && pool->free_list)
+            return NGPoolAlloc(pool);
+    }
+    return 0;
+}
+
+void NGPoolSetFree(NGPoolSet *set, void *block) {
+    if (!block)
+        return;
+    for (u8 i = 0; i < set->count; i++) {
+        NGPool *pool = &set->pools[i];
+        const u8 *p = (const u8 *)block;
+        if (p >= pool->blocks && p < pool->blocks + (u32)pool->block_size * pool->capacity) {
+            NGPoolFree(pool, block);
+            return;
+        }
+    }
+}
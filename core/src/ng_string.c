@@ -10,9 +10,138 @@
  *
  * GCC may generate implicit calls to these functions for struct copies,
  * array initialization, etc. We provide minimal implementations.
+ *
+ * Large copies and fills move 48-byte blocks with a pair of movem.l
+ * instructions (12 registers each way), about four times the speed of a
+ * long loop and twenty times a byte loop. Smaller ones, and copies whose
+ * source and destination differ in alignment, use plain loops.
  */
 
-#include <ng_types.h>
+#include <ng_string.h>
+
+/* Sizes from which the movem path pays for its register save and restore */
+#define BURST_MIN   64
+#define BURST_BYTES 48
+
+/* Keep GCC from turning the loops below back into calls to themselves */
+#define NO_LIBCALL __attribute__((optimize("no-tree-loop-distribute-patterns")))
+
+typedef u32 __attribute__((may_alias)) word32;
+
+/* ============================================================================
+ * Block movers: whole 48-byte blocks, pointers even, n >= BURST_BYTES.
+ * Return the bytes left over (0-47) and advance the pointers past the blocks.
+ * ========================================================================== */
+
+#if defined(__m68k__) && !defined(__CPPCHECK__)
+
+static inline u32 copy_blocks_fwd(u8 **dest, const u8 **src, u32 n) {
+    register u8 *d __asm__("a1") = *dest;
+    register const u8 *s __asm__("a0") = *src;
+    register u32 cnt __asm__("d0") = n;
+    __asm__ volatile("    movem.l %%d2-%%d7/%%a2-%%a6, -(%%sp)\n\t"
+                     "    sub.l   #48, %[cnt]\n\t"
+                     "1:  movem.l (%[s])+, %%d1-%%d7/%%a2-%%a6\n\t"
+                     "    movem.l %%d1-%%d7/%%a2-%%a6, (%[d])\n\t"
+                     "    lea     48(%[d]), %[d]\n\t"
+                     "    sub.l   #48, %[cnt]\n\t"
+                     "    bcc.s   1b\n\t"
+                     "    add.l   #48, %[cnt]\n\t"
+                     "    movem.l (%%sp)+, %%d2-%%d7/%%a2-%%a6\n\t"
+                     : [d] "+a"(d), [s] "+a"(s), [cnt] "+d"(cnt)
+                     :
+                     : "d1", "cc", "memory");
+    *dest = d;
+    *src = s;
+    return cnt;
+}
+
+/* Copies downward: the pointers start at the block region's end */
+static inline u32 copy_blocks_back(u8 **dest_end, const u8 **src_end, u32 n) {
+    register u8 *d __asm__("a1") = *dest_end;
+    register const u8 *s __asm__("a0") = *src_end;
+    register u32 cnt __asm__("d0") = n;
+    __asm__ volatile("    movem.l %%d2-%%d7/%%a2-%%a6, -(%%sp)\n\t"
+                     "    sub.l   #48, %[cnt]\n\t"
+                     "1:  lea     -48(%[s]), %[s]\n\t"
+                     "    movem.l (%[s]), %%d1-%%d7/%%a2-%%a6\n\t"
+                     "    movem.l %%d1-%%d7/%%a2-%%a6, -(%[d])\n\t"
+                     "    sub.l   #48, %[cnt]\n\t"
+                     "    bcc.s   1b\n\t"
+                     "    add.l   #48, %[cnt]\n\t"
+                     "    movem.l (%%sp)+, %%d2-%%d7/%%a2-%%a6\n\t"
+                     : [d] "+a"(d), [s] "+a"(s), [cnt] "+d"(cnt)
+                     :
+                     : "d1", "cc", "memory");
+    *dest_end = d;
+    *src_end = s;
+    return cnt;
+}
+
+/* Fills downward from the end; predecrement movem needs no pointer update */
+static inline u32 fill_blocks_back(u8 **dest_end, u32 pattern, u32 n) {
+    register u8 *d __asm__("a1") = *dest_end;
+    register u32 cnt __asm__("d0") = n;
+    register u32 v __asm__("d1") = pattern;
+    __asm__ volatile("    movem.l %%d2-%%d7/%%a2-%%a6, -(%%sp)\n\t"
+                     "    move.l  %[v], %%d2\n\t"
+                     "    move.l  %[v], %%d3\n\t"
+                     "    move.l  %[v], %%d4\n\t"
+                     "    move.l  %[v], %%d5\n\t"
+                     "    move.l  %[v], %%d6\n\t"
+                     "    move.l  %[v], %%d7\n\t"
+                     "    move.l  %[v], %%a2\n\t"
+                     "    move.l  %[v], %%a3\n\t"
+                     "    move.l  %[v], %%a4\n\t"
+                     "    move.l  %[v], %%a5\n\t"
+                     "    move.l  %[v], %%a6\n\t"
+                     "    sub.l   #48, %[cnt]\n\t"
+                     "1:  movem.l %%d1-%%d7/%%a2-%%a6, -(%[d])\n\t"
+                     "    sub.l   #48, %[cnt]\n\t"
+                     "    bcc.s   1b\n\t"
+                     "    add.l   #48, %[cnt]\n\t"
+                     "    movem.l (%%sp)+, %%d2-%%d7/%%a2-%%a6\n\t"
+                     : [d] "+a"(d), [cnt] "+d"(cnt)
+                     : [v] "d"(v)
+                     : "cc", "memory");
+    *dest_end = d;
+    return cnt;
+}
+
+#else
+
+NO_LIBCALL static u32 copy_blocks_fwd(u8 **dest, const u8 **src, u32 n) {
+    word32 *d = (word32 *)*dest;
+    const word32 *s = (const word32 *)*src;
+    for (; n >= BURST_BYTES; n -= BURST_BYTES)
+        for (u8 i = 0; i < BURST_BYTES / 4; i++)
+            *d++ = *s++;
+    *dest = (u8 *)d;
+    *src = (const u8 *)s;
+    return n;
+}
+
+NO_LIBCALL static u32 copy_blocks_back(u8 **dest_end, const u8 **src_end, u32 n) {
+    word32 *d = (word32 *)*dest_end;
+    const word32 *s = (const word32 *)*src_end;
+    for (; n >= BURST_BYTES; n -= BURST_BYTES)
+        for (u8 i = 0; i < BURST_BYTES / 4; i++)
+            *--d = *--s;
+    *dest_end = (u8 *)d;
+    *src_end = (const u8 *)s;
+    return n;
+}
+
+NO_LIBCALL static u32 fill_blocks_back(u8 **dest_end, u32 pattern, u32 n) {
+    word32 *d = (word32 *)*dest_end;
+    for (; n >= BURST_BYTES; n -= BURST_BYTES)
+        for (u8 i = 0; i < BURST_BYTES / 4; i++)
+            *--d = pattern;
+    *dest_end = (u8 *)d;
+    return n;
+}
+
+#endif
 
 /**
  * Copy memory from source to destination
@@ -22,10 +151,24 @@
  * @param n Number of bytes to copy
  * @return dest
  */
-void *memcpy(void *dest, const void *src, u32 n) {
+NO_LIBCALL void *memcpy(void *dest, const void *src, u32 n) {
     u8 *d = (u8 *)dest;
     const u8 *s = (const u8 *)src;
 
+    /* Word and long moves need both pointers even at the same time */
+    if (n >= BURST_MIN && !(((uintptr_t)d ^ (uintptr_t)s) & 1)) {
+        if ((uintptr_t)d & 1) {
+            *d++ = *s++;
+            n--;
+        }
+        n = copy_blocks_fwd(&d, &s, n);
+        for (; n >= 4; n -= 4) {
+            *(word32 *)d = *(const word32 *)s;
+            d += 4;
+            s += 4;
+        }
+    }
+
     while (n--) {
         *d++ = *s++;
     }
@@ -41,11 +184,31 @@ void *memcpy(void *dest, const void *src, u32 n) {
  * @param n Number of bytes to fill
  * @return s
  */
-void *memset(void *s, int c, u32 n) {
+NO_LIBCALL void *memset(void *s, int c, u32 n) {
     u8 *p = (u8 *)s;
+    u8 b = (u8)c;
+
+    if (n >= BURST_MIN) {
+        /* Even both ends, fill the blocks from the top, then the rest below */
+        if ((uintptr_t)p & 1) {
+            *p++ = b;
+            n--;
+        }
+        u8 *end = p + n;
+        if ((uintptr_t)end & 1) {
+            *--end = b;
+            n--;
+        }
+        u32 pattern = b * 0x01010101u;
+        n = fill_blocks_back(&end, pattern, n);
+        for (; n >= 4; n -= 4) {
+            *(word32 *)p = pattern;
+            p += 4;
+        }
+    }
 
     while (n--) {
-        *p++ = (u8)c;
+        *p++ = b;
     }
 
     return s;
@@ -59,19 +222,29 @@ void *memset(void *s, int c, u32 n) {
  * @param n Number of bytes to copy
  * @return dest
  */
-void *memmove(void *dest, const void *src, u32 n) {
+NO_LIBCALL void *memmove(void *dest, const void *src, u32 n) {
     u8 *d = (u8 *)dest;
     const u8 *s = (const u8 *)src;
 
     if (d < s) {
-        /* Copy forward */
-        while (n--) {
-            *d++ = *s++;
-        }
+        /* Copy forward; each block is read before it can be overwritten */
+        return memcpy(dest, src, n);
     } else if (d > s) {
         /* Copy backward */
         d += n;
         s += n;
+        if (n >= BURST_MIN && !(((uintptr_t)d ^ (uintptr_t)s) & 1)) {
+            if ((uintptr_t)d & 1) {
+                *--d = *--s;
+                n--;
+            }
+            n = copy_blocks_back(&d, &s, n);
+            for (; n >= 4; n -= 4) {
+                d -= 4;
+                s -= 4;
+                *(word32 *)d = *(const word32 *)s;
+            }
+        }
         while (n--) {
             *--d = *--s;
         }
@@ -0,0 +1,80 @@
+-- This file is part of ProGearSDK.
+-- Copyright (c) 2024-2025 ProGearSDK contributors
+-- SPDX-License-Identifier: MIT
+
+-- MAME autoboot script for the benchmark ROM.
+--
+-- Taps writes to ng_profile_marker and timestamps them with the emulated
+-- 68000 clock. Each begin/end pair becomes one sample for its profiler
+-- slot. When the ROM writes NG_PROFILE_MARKER_DONE, per-slot statistics
+-- are written to NG_BENCH_OUT and MAME exits.
+--
+-- Environment:
+--   NG_PROFILE_MARKER  Address of ng_profile_marker (from the ELF symbols)
+--   NG_BENCH_OUT       Output file (default: bench-cycles.txt)
+
+local MARKER_END = 0x8000
+local MARKER_DONE = 0xFFFF
+
+-- Slot names: engine slots from NGEngineProfileSlot, then the ROM's scenarios
+local slot_names = {
+    [0] = "input", "lighting", "camera", "actors", "sync_backdrop", "sync_terrain",
+    "sync_actors", "graphic_draw", "scenario_graphics", "scenario_physics",
+    "scenario_tilemap", "scenario_lighting",
+}
+
+local marker = tonumber(os.getenv("NG_PROFILE_MARKER") or "")
+local out_path = os.getenv("NG_BENCH_OUT") or "bench-cycles.txt"
+if not marker then
+    error("NG_PROFILE_MARKER not set (address of ng_profile_marker)")
+end
+
+local cpu = manager.machine.devices[":maincpu"]
+local space = cpu.spaces["program"]
+local clock = cpu.clock
+
+local open = {}
+local samples = {}
+
+local function now_cycles()
+    return manager.machine.time:as_double() * clock
+end
+
+local function write_report()
+    local f = assert(io.open(out_path, "w"))
+    f:write(string.format("# %-22s %8s %10s %10s %10s\n", "slot", "samples", "min", "avg", "max"))
+    for slot = 0, #slot_names do
+        local s = samples[slot]
+        if s and s.count > 0 then
+            f:write(string.format("%-24s %8d %10d %10d %10d\n", slot_names[slot], s.count,
+                s.min, math.floor(s.sum / s.count + 0.5), s.max))
+        end
+    end
+    f:close()
+    print("Benchmark results written to " .. out_path)
+end
+
+local function on_marker(offset, data, mask)
+    if data == MARKER_DONE then
+        write_report()
+        manager.machine:exit()
+        return
+    end
+
+    local slot = data & 0x7FFF
+    if data & MARKER_END == 0 then
+        open[slot] = now_cycles()
+    elseif open[slot] then
+        local cycles = math.floor(now_cycles() - open[slot] + 0.5)
+        open[slot] = nil
+        local s = samples[slot] or { count = 0, sum = 0, min = math.huge, max = 0 }
+        s.count = s.count + 1
+        s.sum = s.sum + cycles
+        if cycles < s.min then s.min = cycles end
+        if cycles > s.max then s.max = cycles end
+        samples[slot] = s
+    end
+end
+
+-- Keep a reference: the tap is removed when the handler is garbage collected
+bench_tap = space:install_write_tap(marker, marker + 1, "ng_profile_marker", on_marker)
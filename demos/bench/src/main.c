@@ -0,0 +1,196 @@
+/*
+ * This file is part of ProGearSDK.
+ * Copyright (c) 2024-2025 ProGearSDK contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+/*
+ * ProGearSDK Benchmark ROM
+ *
+ * Runs fixed, input-free scenarios one after another. Each frame of a
+ * scenario is wrapped in a profiler slot; bench.lua timestamps the
+ * ng_profile_marker writes in CPU cycles and logs them. Must be built
+ * with NG_PROFILE=1 (the Makefile does this).
+ */
+
+#include <progear.h>
+
+/* Scenario slots follow the engine's own profiler slots */
+enum {
+    SLOT_GRAPHICS = NG_PROF_USER,
+    SLOT_PHYSICS,
+    SLOT_TILEMAP,
+    SLOT_LIGHTING,
+};
+
+#define SCENARIO_FRAMES 240
+
+/* ============================================================
+ * Test Data (tile numbers only; the C-ROM content is irrelevant)
+ * ============================================================ */
+
+#define GRAPHIC_COUNT 64
+#define BODY_COUNT    32
+#define MAP_W         64
+#define MAP_H         32
+#define LIT_PALETTES  32
+
+static u8 map_tiles[MAP_W * MAP_H];
+static u8 map_collision[MAP_W * MAP_H];
+static u8 map_palettes[256];
+
+static const NGTerrainAsset map_asset = {
+    .name = "bench_map",
+    .width_tiles = MAP_W,
+    .height_tiles = MAP_H,
+    .base_tile = 256,
+    .tile_data = map_tiles,
+    .collision_data = map_collision,
+    .tile_to_palette = map_palettes,
+    .default_palette = 1,
+};
+
+/* Every tile distinct enough to defeat run-length shortcuts, 32 palettes in use */
+static void build_map(void) {
+    for (u16 i = 0; i < MAP_W * MAP_H; i++) {
+        map_tiles[i] = (u8)(1 + (i * 7) % 250);
+        map_collision[i] = (i >= (MAP_H - 2) * MAP_W) ? NG_TILE_SOLID : 0;
+    }
+    for (u16 t = 0; t < 256; t++)
+        map_palettes[t] = (u8)(1 + t % LIT_PALETTES);
+}
+
+static void fill_palettes(void) {
+    for (u8 pal = 1; pal <= LIT_PALETTES; pal++) {
+        u16 *p = NGPalGetPtr(pal);
+        for (u8 c = 1; c < NG_PAL_SIZE; c++)
+            p[c] = (u16)NG_RGB(c * 2, 31 - c * 2, pal % 32);
+    }
+}
+
+/* ============================================================
+ * Scenarios
+ * ============================================================ */
+
+typedef struct {
+    u8 slot;
+    const char *name;
+    void (*setup)(void);
+    void (*update)(u16 frame);
+} Scenario;
+
+static NGGraphic *graphics[GRAPHIC_COUNT];
+static NGPhysWorldHandle world;
+
+static void setup_graphics(void) {
+    NGGraphicConfig cfg = {.width = 32,
+                           .height = 32,
+                           .tile_mode = NG_GRAPHIC_TILE_CLIP,
+                           .layer = NG_GRAPHIC_LAYER_ENTITY,
+                           .z_order = 0};
+    for (u8 i = 0; i < GRAPHIC_COUNT; i++) {
+        cfg.z_order = i;
+        graphics[i] = NGGraphicCreate(&cfg);
+        NGGraphicSetSourceRaw(graphics[i], (u16)(256 + i * 4), 32, 32, (u8)(1 + i % 16));
+        NGGraphicSetVisible(graphics[i], 1);
+    }
+}
+
+static void update_graphics(u16 frame) {
+    for (u8 i = 0; i < GRAPHIC_COUNT; i++) {
+        s16 x = (s16)((i & 7) * 40 + ((frame + i * 3) & 31));
+        s16 y = (s16)((i >> 3) * 28);
+        NGGraphicSetPosition(graphics[i], x, y);
+    }
+}
+
+static void setup_physics(void) {
+    world = NGPhysWorldCreate();
+    NGPhysWorldSetGravity(world, 0, FIX_ONE / 4);
+    for (u8 i = 0; i < BODY_COUNT; i++) {
+        NGBodyHandle b =
+            NGPhysBodyCreateCircle(world, FIX(16 + (i % 8) * 36), FIX(16 + (i / 8) * 36), FIX(8));
+        NGPhysBodySetVel(b, FIX((s16)((i * 7) % 5) - 2), FIX((s16)((i * 3) % 4) - 2));
+        NGPhysBodySetRestitution(b, FIX_ONE * 3 / 4);
+    }
+}
+
+static void update_physics(u16 frame) {
+    (void)frame;
+    NGPhysWorldUpdate(world, NULL, NULL);
+}
+
+static void setup_tilemap(void) {
+    NGSceneSetTerrain(&map_asset);
+    NGSceneSetTerrainVisible(1);
+}
+
+static void update_tilemap(u16 frame) {
+    /* Diagonal scroll touches both column and row loads */
+    NGCameraSetPos(FIX(frame * 2), FIX((frame & 63) < 32 ? (frame & 31) : 31 - (frame & 31)));
+}
+
+static void setup_lighting(void) {
+    setup_tilemap();
+    fill_palettes();
+    NGLightingLayerHandle light = NGLightingPush(NG_LIGHTING_PRIORITY_AMBIENT);
+    NGLightingSetTint(light, 4, 0, -4);
+    NGLightingFadeBrightness(light, FIX_ONE / 4, SCENARIO_FRAMES);
+}
+
+static void update_lighting(u16 frame) {
+    (void)frame;
+}
+
+static const Scenario scenarios[] = {
+    {SLOT_GRAPHICS, "GRAPHICS", setup_graphics, update_graphics},
+    {SLOT_PHYSICS, "PHYSICS", setup_physics, update_physics},
+    {SLOT_TILEMAP, "TILEMAP", setup_tilemap, update_tilemap},
+    {SLOT_LIGHTING, "LIGHTING", setup_lighting, update_lighting},
+};
+
+#define SCENARIO_COUNT (sizeof(scenarios) / sizeof(scenarios[0]))
+
+static void run_scenario(const Scenario *s) {
+    NGFixClearAll();
+    NGTextPrint(NGFixLayoutXY(1, 1), 0, s->name);
+
+    s->setup();
+    for (u16 frame = 0; frame < SCENARIO_FRAMES; frame++) {
+        NGEngineFrameStart();
+        NG_PROFILE_BEGIN(s->slot);
+        s->update(frame);
+        NGEngineFrameEnd();
+        NG_PROFILE_END(s->slot);
+    }
+
+    if (world) {
+        NGPhysWorldDestroy(world);
+        world = NULL;
+    }
+    NGLightingReset();
+    NGSceneReset();
+    NGCameraSetPos(0, 0);
+    NGArenaReset(&ng_arena_state);
+}
+
+int main(void) {
+    NGEngineInit();
+    for (u8 i = 0; i < SCENARIO_COUNT; i++)
+        NGProfileRegister(scenarios[i].slot, scenarios[i].name);
+
+    build_map();
+
+    for (u8 i = 0; i < SCENARIO_COUNT; i++)
+        run_scenario(&scenarios[i]);
+
+    /* Tells bench.lua to write its log and quit */
+    ng_profile_marker = NG_PROFILE_MARKER_DONE;
+
+    NGFixClearAll();
+    for (;;) {
+        NGEngineFrameStart();
+        NGEngineFrameEnd();
+        NG_PROFILE_DRAW(1, 2, 0);
+    }
+}
@@ -19,8 +19,9 @@ int main(void) {
     /* Palette 0 is the default fix layer palette from sfix.bin */
     NGTextPrint(NGFixLayoutXY(15, 14), 0, "Hello HAL!");
 
-    /* Main loop - just wait for vblank forever */
+    /* Main loop - upload fix layer changes at each vblank */
     for (;;) {
         NGWaitVBlank();
+        NGFixFlush();
     }
 }
@@ -110,19 +110,8 @@ void BallSystemUpdate(BallSystemHandle sys) {
     if (!sys)
         return;
 
+    // Actors follow their bodies when the scene syncs
     NGPhysWorldUpdate(sys->physics, on_ball_collision, 0);
-
-    // Physics uses center position, actor uses top-left
-    for (u8 i = 0; i < sys->max_balls; i++) {
-        Ball *ball = &sys->balls[i];
-        if (!ball->active)
-            continue;
-
-        NGVec2 pos = NGPhysBodyGetPos(ball->body);
-        fixed x = pos.x - BALL_HALF_SIZE;
-        fixed y = pos.y - BALL_HALF_SIZE;
-        NGActorSetPos(ball->actor, x, y);
-    }
 }
 
 u8 BallSpawn(BallSystemHandle sys) {
@@ -152,6 +141,8 @@ u8 BallSpawn(BallSystemHandle sys) {
             NGActorAddToScene(ball->actor, x - BALL_HALF_SIZE, y - BALL_HALF_SIZE, 100);
             NGActorSetPalette(ball->actor, ball_palettes[i % NUM_PALETTES]);
             NGActorSetAnimByName(ball->actor, "spin");
+            // Physics uses center position, actor uses top-left
+            NGActorBindBody(ball->actor, ball->body, -BALL_HALF_SIZE, -BALL_HALF_SIZE);
             ball->active = 1;
             sys->ball_count++;
 
@@ -8,10 +8,10 @@
  * @file raster_demo.c
  * @brief Raster effects showcase
  *
- * Demonstrates timer interrupts for mid-frame effects:
- * - Gradient sky effect (palette change per scanline band)
- * - Water reflection (palette swap on lower half)
- * - Scanline counter display
+ * Demonstrates raster tables (ng_raster.h) for mid-frame effects:
+ * - Gradient sky effect (backdrop change per scanline band)
+ * - Water reflection (backdrop swap below an animated line)
+ * - CRT-style scanline bands
  */
 
 #include "raster_demo.h"
@@ -22,7 +22,7 @@
 #include <ng_arena.h>
 #include <ng_palette.h>
 #include <ng_color.h>
-#include <ng_interrupt.h>
+#include <ng_raster.h>
 #include <engine.h>
 #include <ui.h>
 #include <progear_assets.h>
@@ -54,10 +54,11 @@ static RasterDemoState *state;
 /* Scanlines per band for gradient (224 / 8 = 28 scanlines per band) */
 #define SCANLINES_PER_BAND 28
 
-/* Raster interrupt state */
-static volatile u8 raster_band = 0;
-static volatile u8 water_line = 112; /* Current water line position */
-static volatile u8 anim_offset = 0;  /* Animation offset for gradient */
+/* Scanlines per band for the CRT effect (224 / 4 = 56 bands) */
+#define SCANLINES_PER_CRT_BAND 4
+
+static u8 water_line = 112; /* Current water line position */
+static u8 anim_offset = 0;  /* Animation offset for gradient */
 
 /* Sky gradient colors (8 bands from dark blue to light) */
 static const u16 sky_gradient[8] = {
@@ -72,86 +73,52 @@ static const u16 sky_gradient[8] = {
 };
 
 /**
- * Timer interrupt handler - called at configured scanline
+ * Build this frame's raster table. It starts playing at the next VBlank
+ * while the current one is still on screen.
  */
-static void raster_interrupt_handler(void) {
-    volatile u16 *backdrop = (volatile u16 *)0x401FFE;
+static void build_raster_table(void) {
+    NGRasterBegin();
 
     switch (state->current_effect) {
         case EFFECT_GRADIENT_SKY:
-            /* Change backdrop color for each band with animation offset */
-            if (raster_band < 8) {
-                u8 color_idx = (u8)((raster_band + anim_offset) & 7);
-                *backdrop = sky_gradient[color_idx];
-                raster_band++;
-                /* Set timer for next band (28 scanlines each) */
-                if (raster_band < 8) {
-                    NGTimerSetReload(NGTimerScanlineToReload(28));
-                }
+            /* One backdrop color per band, cycled by the animation offset */
+            for (u8 band = 0; band < 8; band++) {
+                NGRasterAddBackdrop((u16)(band * SCANLINES_PER_BAND),
+                                    sky_gradient[(band + anim_offset) & 7]);
             }
             break;
 
         case EFFECT_WATER_REFLECT:
-            /* Water effect - darker blue for "water" below the line */
-            *backdrop = 0x0023; /* Dark blue for water */
+            NGRasterAddBackdrop(0, 0x0478);          /* Light cyan sky */
+            NGRasterAddBackdrop(water_line, 0x0023); /* Dark blue for water */
             break;
 
         case EFFECT_SCANLINE_DARK:
-            /* CRT scanline effect - every other pair of lines is darker */
-            if ((raster_band + (anim_offset >> 2)) & 1) {
-                *backdrop = 0x0222; /* Dark */
-            } else {
-                *backdrop = 0x0666; /* Light */
-            }
-            raster_band++;
-            /* Set timer for next band (4 scanlines for tighter effect) */
-            if (raster_band < 56) { /* 224 / 4 = 56 bands */
-                NGTimerSetReload(NGTimerScanlineToReload(4));
+            /* CRT scanline effect - every other band is darker */
+            for (u8 band = 0; band < NG_RASTER_LINES / SCANLINES_PER_CRT_BAND; band++) {
+                u16 color = ((band + (anim_offset >> 2)) & 1) ? 0x0222 : 0x0666;
+                NGRasterAddBackdrop((u16)(band * SCANLINES_PER_CRT_BAND), color);
             }
             break;
 
         default:
             break;
     }
+
+    NGRasterSubmit();
 }
 
 static void enable_raster_effect(void) {
-    /* Reset raster state */
-    raster_band = 0;
-
-    /* Set up timer interrupt handler */
-    NGInterruptSetTimerHandler(raster_interrupt_handler);
-
-    /* Configure initial timer based on effect */
-    switch (state->current_effect) {
-        case EFFECT_GRADIENT_SKY:
-            /* First interrupt after 28 scanlines */
-            NGTimerSetReload(NGTimerScanlineToReload(28));
-            break;
-        case EFFECT_WATER_REFLECT:
-            /* Single interrupt at middle of screen (112 scanlines) */
-            NGTimerSetReload(NGTimerScanlineToReload(112));
-            break;
-        case EFFECT_SCANLINE_DARK:
-            /* First interrupt after 8 scanlines */
-            NGTimerSetReload(NGTimerScanlineToReload(8));
-            break;
-        default:
-            NGTimerSetReload(NGTimerScanlineToReload(112));
-            break;
-    }
-
-    NGTimerEnable();
+    build_raster_table();
     state->effect_enabled = 1;
 }
 
 static void disable_raster_effect(void) {
-    NGTimerDisable();
-    NGInterruptSetTimerHandler(0);
+    NGRasterClear();
     state->effect_enabled = 0;
 
     /* Reset backdrop to solid color */
-    NG_REG_BACKDROP = NG_COLOR_BLACK;
+    NGPalSetBackdrop(NG_COLOR_BLACK);
 }
 
 static const char *get_effect_name(RasterEffect effect) {
@@ -170,8 +137,8 @@ static const char *get_effect_name(RasterEffect effect) {
 static void draw_info(void) {
     NGTextPrint(NGFixLayoutAlign(NG_ALIGN_CENTER, NG_ALIGN_TOP), 0, "RASTER EFFECTS DEMO");
 
-    NGTextPrint(NGFixLayoutXY(2, 4), 0, "RASTER INTERRUPTS");
-    NGTextPrint(NGFixLayoutXY(2, 5), 0, "-----------------");
+    NGTextPrint(NGFixLayoutXY(2, 4), 0, "RASTER TABLES");
+    NGTextPrint(NGFixLayoutXY(2, 5), 0, "-------------");
     NGTextPrint(NGFixLayoutXY(2, 7), 0, "Effect:");
     NGTextPrint(NGFixLayoutXY(2, 8), 0, "Status:");
     NGTextPrint(NGFixLayoutXY(2, 10), 0, "Timer interrupts allow");
@@ -237,28 +204,7 @@ u8 RasterDemoUpdate(void) {
             water_line = (u8)(96 + wave); /* Oscillates 96-127 */
         }
 
-        /* Reset raster band counter */
-        raster_band = 0;
-
-        /* Set initial backdrop color based on effect */
-        switch (state->current_effect) {
-            case EFFECT_GRADIENT_SKY:
-                NG_REG_BACKDROP = sky_gradient[anim_offset & 7];
-                raster_band = 1; /* First interrupt will set band 1 */
-                NGTimerSetReload(NGTimerScanlineToReload(28));
-                break;
-            case EFFECT_WATER_REFLECT:
-                NG_REG_BACKDROP = 0x0478; /* Light cyan sky */
-                NGTimerSetReload(NGTimerScanlineToReload(water_line));
-                break;
-            case EFFECT_SCANLINE_DARK:
-                NG_REG_BACKDROP = 0x0666; /* Light gray */
-                NGTimerSetReload(NGTimerScanlineToReload(4));
-                break;
-            default:
-                NG_REG_BACKDROP = NG_COLOR_BLACK;
-                break;
-        }
+        build_raster_table();
     }
 
     /* Update info display only when menu is closed */
@@ -45,9 +45,26 @@ HAL_CFLAGS += -Wall -Wextra -Wshadow -Wdouble-promotion -Wformat=2 -Wundef
 HAL_CFLAGS += -fno-common -Wconversion -Wno-sign-conversion
 HAL_CFLAGS += -I$(CORE_INCLUDE) -I$(HAL_INCLUDE)
 
+# Scanline profiler: build with `make NG_PROFILE=1`
+ifdef NG_PROFILE
+HAL_CFLAGS += -DNG_PROFILE
+endif
+
 HAL_ASFLAGS = -m68000
 
-HAL_LDFLAGS = -T$(HAL_LINKER_SCRIPT) -nostdlib
+# The link writes a map next to the ELF, read by `make size-report`
+HAL_LDFLAGS = -T$(HAL_LINKER_SCRIPT) -nostdlib -Wl,-Map=$(@:.elf=.map)
+
+# Speed profile: the libraries' hot modules are LTO objects built at -O2
+# (see progear/Makefile); the link optimizes them together and drops
+# unreferenced sections. Game sources keep -Os.
+ifeq ($(PROFILE),speed)
+HAL_CFLAGS += -ffunction-sections -fdata-sections
+HAL_LDFLAGS += -flto -O2 -Wl,--gc-sections
+endif
+
+# ROM per module and function: $(SIZE_REPORT) build/game.elf
+SIZE_REPORT = python3 $(CORE_PATH)/../tools/size_report.py --nm $(PREFIX)nm
 
 # === Core Build Rule ===
 .PHONY: core
@@ -34,6 +34,11 @@
  * - @ref palette - Palette RAM management
  * - @ref hardware - Hardware registers and VRAM access
  * - @ref sprite - Sprite Control Block (SCB) operations
+ * - @ref displaylist - Deferred VRAM writes replayed in VBlank
+ * - @ref raster - Per-scanline register writes from the timer interrupt
+ * - @ref vblank - Jobs run inside the VBlank interrupt
+ * - @ref idle - Sliced background work before the VBlank wait
+ * - @ref bank - Bank-switched P-ROM past the first megabyte
  * - @ref fix - Fix layer text rendering
  * - @ref input - Controller input handling
  * - @ref audio - ADPCM audio playback
@@ -54,6 +59,7 @@
 
 /* Sprite hardware */
 #include <ng_sprite.h>
+#include <ng_display_list.h>
 
 /* Fix layer (text) */
 #include <ng_fix.h>
@@ -66,6 +72,13 @@
 
 /* Interrupt handling */
 #include <ng_interrupt.h>
+#include <ng_vblank.h>
+#include <ng_idle.h>
+#include <ng_bank.h>
+#include <ng_raster.h>
+
+/* Scanline profiler (active only with NG_PROFILE) */
+#include <ng_profile.h>
 
 /* System features (DIP switches, coins, RTC) */
 #include <ng_system.h>
@@ -16,6 +16,15 @@
  * - 0x10-0x1F: Play SFX 0-15 (center pan)
  * - 0x20-0x2F: Play music 0-15 (looping)
  * - 0x30: Stop music
+ * - 0x33: Voice packet (next 5 bytes: sfx id LSB, sfx id MSB, channel,
+ *         pan | volume, priority; parameter n is acknowledged with 0x40+n)
+ * - 0x34: Voice status (reply is the busy channel mask, 0x00-0x3F)
+ * - 0x35: Music queue packet (next byte: track, 0xFF cancels; acknowledged
+ *         with 0xB5, then 0x41)
+ * - 0x36: FM song packet (next byte: song; acknowledged with 0xB6, then 0x41)
+ * - 0x37: Stop FM song
+ * - 0x38: Pause FM song
+ * - 0x39: Resume FM song
  * - 0x40-0x4F: Play SFX 16-31 (center pan)
  * - 0x50-0x5F: Play music 16-31 (looping)
  * - 0x60-0x65: Stop SFX channel 0-5
@@ -27,6 +36,33 @@
  * - 0xD0-0xDF: Play SFX 0-15 (right pan)
  * - 0xE0-0xEF: Play SFX 16-31 (left pan)
  * - 0xF0-0xFF: Play SFX 16-31 (right pan)
+ *
+ * Command Queue:
+ * Play, stop and volume calls do not wait for the Z80. They queue their
+ * command, which is written as soon as the previous one has been
+ * acknowledged; NGAudioUpdate() (called by NGEngineFrameStart()) keeps
+ * the queue moving. A sound effect already queued, or just sent, is not
+ * queued again. On overflow new sound effects are dropped, and other
+ * commands evict the oldest queued sound effect.
+ *
+ * Voice Allocation:
+ * Sound effects without a fixed channel go to a free channel. With all six
+ * busy, the Z80 driver stops the lowest-priority voice (the oldest among
+ * equals) for the new one, or drops the new one if every playing voice
+ * has a higher priority. Default priorities come from assets.yaml.
+ *
+ * Music Segments:
+ * A track is an intro and a loop body (or one segment), each a separate
+ * V-ROM range. The Z80 driver has the YM2610 jump from one segment to the
+ * next, or back to the loop body, without a gap and without the 68k. At
+ * the end of its last segment a track loops, chains to the track set as
+ * `next` in assets.yaml, or plays the track given to NGMusicQueue().
+ *
+ * FM Songs:
+ * The Z80 driver also sequences the four FM and three SSG channels from
+ * songs compiled into M-ROM (fm_music in assets.yaml). They take no V-ROM
+ * and play alongside ADPCM music and sound effects. Timing comes from the
+ * YM2610's Timer B, so tempo does not depend on the 68k frame rate.
  */
 
 #ifndef NG_AUDIO_H
@@ -37,14 +73,29 @@
 /**
  * @defgroup audio Audio System
  * @ingroup hal
- * @brief ADPCM-A sound effects and ADPCM-B music playback.
+ * @brief ADPCM-A sound effects, ADPCM-B music and FM/SSG song playback.
  * @{
  */
 
 /* Maximum number of sound effects and music tracks */
-#define NG_AUDIO_MAX_SFX      32
+#define NG_AUDIO_MAX_SFX      128 /* SFX 32+ are sent as voice packets */
 #define NG_AUDIO_MAX_MUSIC    32
-#define NG_AUDIO_MAX_CHANNELS 6 /* ADPCM-A channels for SFX */
+#define NG_AUDIO_MAX_FM       32
+#define NG_AUDIO_MAX_CHANNELS 6    /* ADPCM-A channels for SFX */
+#define NG_AUDIO_CHANNEL_AUTO 0xFF /* Let the Z80 driver pick the channel */
+#define NG_AUDIO_MUSIC_NONE   0xFF /* No track (NGMusicQueue(), NGAudioGetCurrentMusic()) */
+
+#ifndef NG_AUDIO_QUEUE_SIZE
+#define NG_AUDIO_QUEUE_SIZE 32 /* Bytes waiting for the Z80 (a voice packet is 6) */
+#endif
+
+#ifndef NG_AUDIO_ACK_TIMEOUT
+#define NG_AUDIO_ACK_TIMEOUT 4 /* NGAudioUpdate() calls to wait for an acknowledgment */
+#endif
+
+#ifndef NG_AUDIO_STATUS_POLL
+#define NG_AUDIO_STATUS_POLL 1 /* Idle NGAudioUpdate() calls refresh the busy channel mask */
+#endif
 
 /* Audio types for scene/actor binding */
 typedef enum {
@@ -65,7 +116,7 @@ typedef enum {
  */
 typedef struct {
     const char *name; /* Sound name for debugging */
-    u8 index;         /* SFX index (0-31) */
+    u8 index;         /* SFX index (0-127) */
 } NGSfxAsset;
 
 /**
@@ -77,6 +128,15 @@ typedef struct {
     u8 index;         /* Music index (0-31) */
 } NGMusicAsset;
 
+/**
+ * FM song asset definition
+ * Generated by progear_assets.py from fm_music in assets.yaml
+ */
+typedef struct {
+    const char *name; /* Song name for debugging */
+    u8 index;         /* FM song index (0-31) */
+} NGFMAsset;
+
 /* ============================================================================
  * Initialization
  * ========================================================================== */
@@ -87,6 +147,17 @@ typedef struct {
  */
 void NGAudioInit(void);
 
+/**
+ * Send queued commands the Z80 is ready for
+ * Call once per frame (NGEngineFrameStart() does this)
+ */
+void NGAudioUpdate(void);
+
+/**
+ * Send every queued command, waiting for each acknowledgment
+ */
+void NGAudioFlush(void);
+
 /* ============================================================================
  * Sound Effects (ADPCM-A)
  * ========================================================================== */
@@ -95,18 +166,32 @@ void NGAudioInit(void);
  * Play a sound effect
  * Uses auto-channel assignment (first free channel)
  *
- * @param sfx_index Sound effect index (0-31)
+ * @param sfx_index Sound effect index (0-127)
  */
 void NGSfxPlay(u8 sfx_index);
 
 /**
  * Play a sound effect with specific pan
  *
- * @param sfx_index Sound effect index (0-31)
+ * @param sfx_index Sound effect index (0-127)
  * @param pan Pan position (NG_PAN_LEFT, NG_PAN_CENTER, NG_PAN_RIGHT)
  */
 void NGSfxPlayPan(u8 sfx_index, NGPan pan);
 
+/**
+ * Play a fully specified sound effect voice
+ * Sent as one voice packet, so the Z80 starts the sample with its channel,
+ * pan and volume already set.
+ *
+ * @param sfx_index Sound effect index (0-127)
+ * @param channel ADPCM-A channel (0-5), or NG_AUDIO_CHANNEL_AUTO
+ * @param pan Pan position (NG_PAN_LEFT, NG_PAN_CENTER, NG_PAN_RIGHT)
+ * @param volume Volume level (0-31)
+ * @param priority Voice priority (1-255, higher wins a channel), or 0 for
+ *                 the sound's default from assets.yaml
+ */
+void NGSfxPlayVoice(u16 sfx_index, u8 channel, NGPan pan, u8 volume, u8 priority);
+
 /**
  * Play a sound effect from an asset
  *
@@ -128,12 +213,31 @@ void NGSfxStopChannel(u8 channel);
  */
 void NGSfxStopAll(void);
 
+/**
+ * Get the ADPCM-A channels playing a sample
+ * Reported by the Z80 when the queue was last idle, at most a frame old
+ * with NG_AUDIO_STATUS_POLL. Useful to skip retriggering a sound that is
+ * still playing on a channel chosen with NGSfxPlayVoice().
+ *
+ * @return Bit n set if channel n is busy
+ */
+u8 NGSfxGetBusyChannels(void);
+
+/**
+ * Check whether an ADPCM-A channel is playing a sample
+ *
+ * @param channel Channel (0-5)
+ * @return 1 if busy (see NGSfxGetBusyChannels()), 0 otherwise
+ */
+u8 NGSfxIsChannelBusy(u8 channel);
+
 /* ============================================================================
  * Music (ADPCM-B)
  * ========================================================================== */
 
 /**
- * Play background music (looping)
+ * Play background music now, from the start of the track
+ * Loops or chains at its end as set in assets.yaml (see Music Segments).
  *
  * @param music_index Music index (0-31)
  */
@@ -148,6 +252,19 @@ static inline void NGMusicPlayAsset(const NGMusicAsset *music) {
     NGMusicPlay(music->index);
 }
 
+/**
+ * Play a track once the current one reaches the end of its last segment
+ * The Z80 driver switches on the sample, so a stage theme can run into its
+ * boss theme without a gap. Replaces its loop or `next` track for that
+ * one transition. Queuing again replaces the queued track; NGMusicPlay()
+ * and NGMusicStop() cancel it.
+ *
+ * Tracks at different sample rates switch a few samples late in pitch.
+ *
+ * @param music_index Music index (0-31), or NG_AUDIO_MUSIC_NONE to cancel
+ */
+void NGMusicQueue(u8 music_index);
+
 /**
  * Stop music playback
  */
@@ -159,7 +276,7 @@ void NGMusicStop(void);
 void NGMusicPause(void);
 
 /**
- * Resume paused music
+ * Resume paused music from the start of the segment it was paused in
  */
 void NGMusicResume(void);
 
@@ -177,6 +294,66 @@ u8 NGMusicIsPlaying(void);
  */
 u8 NGMusicIsPaused(void);
 
+/* ============================================================================
+ * FM Songs (FM + SSG)
+ * ========================================================================== */
+
+/**
+ * Play an FM song from the start
+ * Replaces the FM song playing, if any. Loops if its MML source has an L.
+ *
+ * @param fm_index FM song index (0-31)
+ */
+void NGFMPlay(u8 fm_index);
+
+/**
+ * Play an FM song from an asset
+ *
+ * @param fm Pointer to FM song asset
+ */
+static inline void NGFMPlayAsset(const NGFMAsset *fm) {
+    NGFMPlay(fm->index);
+}
+
+/**
+ * Stop the FM song and silence its channels
+ */
+void NGFMStop(void);
+
+/**
+ * Pause the FM song (can be resumed)
+ */
+void NGFMPause(void);
+
+/**
+ * Resume a paused FM song where it stopped
+ * Notes cut off by the pause are not restarted.
+ */
+void NGFMResume(void);
+
+/**
+ * Check if an FM song is playing
+ * Tracks 68k calls only: a song without a loop point that has ended still
+ * counts as playing until NGFMStop().
+ *
+ * @return 1 if playing, 0 if stopped or paused
+ */
+u8 NGFMIsPlaying(void);
+
+/**
+ * Check if the FM song is paused
+ *
+ * @return 1 if paused, 0 if not
+ */
+u8 NGFMIsPaused(void);
+
+/**
+ * Get the FM song last started with NGFMPlay()
+ *
+ * @return FM song index, or 0xFF if none
+ */
+u8 NGFMGetCurrent(void);
+
 /* ============================================================================
  * Volume Control
  * ========================================================================== */
@@ -205,7 +382,7 @@ void NGSfxSetChannelVolume(u8 channel, u8 volume);
 void NGMusicSetVolume(u8 volume);
 
 /**
- * Stop all audio (SFX and music)
+ * Stop all audio (SFX, music and FM songs)
  */
 void NGAudioStopAll(void);
 
@@ -215,7 +392,7 @@ void NGAudioStopAll(void);
 
 /**
  * Send a raw command to the Z80 audio driver
- * Waits for acknowledgment before returning
+ * Flushes the queue first, then waits for acknowledgment before returning
  *
  * @param cmd Command byte to send
  */
@@ -236,7 +413,9 @@ void NGAudioSendCommandAsync(u8 cmd);
 /**
  * Get current music track index
  *
- * @return Current music index (0-31) or 0xFF if none playing
+ * @return Current music index (0-31) or 0xFF if none playing. Tracks the
+ *         68k calls only: after a chain or NGMusicQueue() switch this is
+ *         still the track last started with NGMusicPlay()
  */
 u8 NGAudioGetCurrentMusic(void);
 
@@ -247,6 +426,21 @@ u8 NGAudioGetCurrentMusic(void);
  */
 u8 NGAudioGetVolume(void);
 
+/**
+ * Get the number of bytes not yet acknowledged by the Z80
+ *
+ * @return Queued bytes, plus one if a byte is in flight (including the
+ *         idle status query, see NG_AUDIO_STATUS_POLL)
+ */
+u8 NGAudioGetQueuedCount(void);
+
+/**
+ * Get the number of commands lost to queue overflow since NGAudioInit()
+ *
+ * @return Dropped command count
+ */
+u16 NGAudioGetDroppedCount(void);
+
 /** @} */ /* end of audio group */
 
 #endif /* NG_AUDIO_H */
@@ -0,0 +1,76 @@
+/*
+ * This file is part of ProGearSDK.
+ * Copyright (c) 2024-2025 ProGearSDK contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+/**
+ * @file ng_bank.h
+ * @brief P-ROM bank switching for programs larger than 1 MB.
+ *
+ * The first megabyte of P-ROM is always mapped at 0x000000. Past it, the
+ * P2 ROM is seen one megabyte at a time through the window at 0x200000,
+ * and writing a bank number to 0x2FFFF0 picks which. Code, and any data
+ * read without switching, stays in the first megabyte.
+ *
+ * Data is put in a bank with NG_BANK(), which places it in the .bankN
+ * section; hal/rom/link.ld links every bank at 0x200000 and stores them
+ * one after another past the first megabyte, and tools/neo_rom.py pads
+ * the P-ROM to whole banks. Fill banks in order: the linker stops on an
+ * empty bank followed by a used one, or a bank over 1 MB.
+ *
+ * NGBankSelect() remembers the mapped bank and skips the register write
+ * when it is already mapped, so loaders can call it before every access.
+ * Pointers into a bank are only valid while it is mapped, and the main
+ * loop owns the window: interrupt handlers must not read banked data.
+ *
+ * Terrain assets given a bank in assets.yaml are switched in by the
+ * terrain and graphic systems themselves (see NGTerrainAsset.bank).
+ *
+ * @code
+ * NG_BANK(1) static const char intro_text[] = "...";
+ *
+ * NGBankSelect(1);
+ * NGTextPrint(NGFixLayoutXY(1, 1), 0, intro_text);
+ * @endcode
+ */
+
+#ifndef NG_BANK_H
+#define NG_BANK_H
+
+#include <ng_types.h>
+#include <ng_hardware.h>
+
+/**
+ * @defgroup bank P-ROM Banks
+ * @ingroup hal
+ * @brief Bank-switched P2 ROM window.
+ * @{
+ */
+
+#define NG_BANK_FIXED  0        /**< Not banked: the first megabyte, always mapped */
+#define NG_BANK_COUNT  8        /**< Banks the linker script provides, 1 to 8 */
+#define NG_BANK_WINDOW 0x200000 /**< Where the selected bank is mapped */
+#define NG_BANK_SIZE   0x100000 /**< Bytes per bank */
+
+/** Place a variable in bank n (1 to NG_BANK_COUNT, a literal) */
+#define NG_BANK(n) __attribute__((section(".bank" #n)))
+
+/** Bank mapped by the last NGBankSelect(), NG_BANK_FIXED if none yet */
+extern u8 ng_bank_current;
+
+/**
+ * Map a bank at NG_BANK_WINDOW. Does nothing for NG_BANK_FIXED or when the
+ * bank is already mapped.
+ * @param bank Bank number (1 to NG_BANK_COUNT), or NG_BANK_FIXED
+ */
+static inline void NGBankSelect(u8 bank) {
+    if (bank != NG_BANK_FIXED && bank != ng_bank_current) {
+        ng_bank_current = bank;
+        NG_REG_BANK = (u16)(bank - 1);
+    }
+}
+
+/** @} */ /* end of bank group */
+
+#endif /* NG_BANK_H */
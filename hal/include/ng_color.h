@@ -171,6 +171,45 @@ NGColor NGColorGrayscale(NGColor c);
 NGColor NGColorAdjustBrightness(NGColor c, s8 amount);
 /** @} */
 
+/**
+ * @name Array Operations
+ * Whole-palette versions of the manipulation functions. Each turns the
+ * per-channel arithmetic into a 32-entry table once per call, so the
+ * per-color work is unpacking, lookups and ORs. Results match the
+ * single-color functions. The dark bit is cleared, as by NG_RGB().
+ * A count may span several palettes of the shadow (NGPalGetShadow()).
+ */
+/** @{ */
+
+/**
+ * Blend colors toward a target, in place.
+ * @param colors Colors to blend
+ * @param count Number of colors
+ * @param target Target color
+ * @param ratio Blend ratio (0=unchanged, 255=all target)
+ */
+void NGColorBlendArray(NGColor *colors, u16 count, NGColor target, u8 ratio);
+
+/**
+ * Crossfade between two color arrays: dst[i] = NGColorBlend(a[i], b[i], ratio).
+ * dst may be a or b.
+ * @param dst Output colors
+ * @param a Colors at ratio 0
+ * @param b Colors at ratio 255
+ * @param count Number of colors
+ * @param ratio Blend ratio (0=all a, 255=all b)
+ */
+void NGColorCrossfadeArray(NGColor *dst, const NGColor *a, const NGColor *b, u16 count, u8 ratio);
+
+/**
+ * Adjust the brightness of colors, in place.
+ * @param colors Colors to adjust
+ * @param count Number of colors
+ * @param amount Adjustment (-31 to +31), as for NGColorAdjustBrightness()
+ */
+void NGColorAdjustBrightnessArray(NGColor *colors, u16 count, s8 amount);
+/** @} */
+
 /** @name Color Generation */
 /** @{ */
 
@@ -0,0 +1,161 @@
+/*
+ * This file is part of ProGearSDK.
+ * Copyright (c) 2024-2025 ProGearSDK contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+/**
+ * @file ng_display_list.h
+ * @brief Deferred VRAM command buffer replayed during VBlank.
+ *
+ * Writing SCB data during active display tears sprites and competes with
+ * the LSPC for VRAM. The display list records VRAM writes as compact runs
+ * while game logic executes, and crt0.s replays them at the start of the
+ * next VBlank interrupt with one address setup per run.
+ *
+ * Buffer format (16-bit words):
+ * @code
+ * [count][addr][mod][data...]   copy run: count data words follow
+ * [count|0x8000][addr][mod][v]  fill run: v is written count times
+ * [0]                           terminator
+ * @endcode
+ *
+ * The NGSprite* helpers and the graphics system record automatically
+ * while a list is open, so most code never calls this module directly.
+ *
+ * @code
+ * NGDisplayListBegin(&ng_arena_frame, NG_DISPLAY_LIST_WORDS);
+ * // ... NGSprite* / NGGraphicSystemDraw() calls are recorded ...
+ * NGDisplayListSubmit();   // replayed by the next VBlank
+ * @endcode
+ */
+
+#ifndef NG_DISPLAY_LIST_H
+#define NG_DISPLAY_LIST_H
+
+#include <ng_types.h>
+#include <ng_arena.h>
+#include <ng_hardware.h>
+
+/**
+ * @defgroup displaylist Display List
+ * @ingroup hal
+ * @brief Deferred VRAM writes replayed in VBlank.
+ * @{
+ */
+
+/** @name Configuration */
+/** @{ */
+
+#ifndef NG_DISPLAY_LIST_WORDS
+/** Default display list capacity in words (allocated from the frame arena) */
+#define NG_DISPLAY_LIST_WORDS 1536
+#endif
+
+/** Run header flag: run repeats a single data word */
+#define NG_DISPLAY_LIST_FILL 0x8000
+/** @} */
+
+/** @name Recording State */
+/** @{ */
+
+/** Recording state (internal, exposed for the inline helpers) */
+typedef struct {
+    u16 *cursor;   /**< Next free word, NULL when not recording */
+    u16 *limit;    /**< End of usable space (terminator slot excluded) */
+    u16 *run;      /**< Header of the open copy run, NULL if none */
+    u16 run_addr;  /**< VRAM address of the open run */
+    u16 run_mod;   /**< VRAMMOD of the open run */
+    u16 overflows; /**< Words dropped since the list was opened */
+} NGDisplayList;
+
+/** Active recording state */
+extern NGDisplayList ng_display_list;
+
+/** Completed list awaiting replay (consumed and cleared by crt0.s) */
+extern u16 *volatile ng_display_list_pending;
+/** @} */
+
+/** @name Lifecycle */
+/** @{ */
+
+/**
+ * Open a new display list.
+ * VRAM writes made through the HAL sprite helpers are recorded from now
+ * until NGDisplayListSubmit().
+ *
+ * @param arena Arena to allocate the buffer from (normally ng_arena_frame)
+ * @param capacity Buffer size in words
+ * @return 1 on success, 0 if the allocation failed (writes stay immediate)
+ */
+u8 NGDisplayListBegin(NGArena *arena, u16 capacity);
+
+/**
+ * Close the list and hand it to the VBlank interrupt.
+ * The list is replayed once, at the start of the next VBlank.
+ */
+void NGDisplayListSubmit(void);
+
+/**
+ * Check whether a list is currently recording.
+ * @return 1 if VRAM writes are being deferred, 0 if they go straight to VRAM
+ */
+static inline u8 NGDisplayListIsRecording(void) {
+    return ng_display_list.cursor != 0;
+}
+
+/**
+ * Get the number of words dropped because the buffer was full.
+ * Reset by NGDisplayListBegin(). Non-zero means NG_DISPLAY_LIST_WORDS is
+ * too small for the scene.
+ * @return Dropped word count for the current or last list
+ */
+u16 NGDisplayListGetOverflows(void);
+/** @} */
+
+/** @name Recording */
+/** @{ */
+
+/**
+ * Open a copy run at a VRAM address.
+ * Closes any open run. Follow with NGDisplayListPut() calls.
+ * @param addr VRAM address
+ * @param mod VRAMMOD auto-increment for this run
+ */
+void NGDisplayListRun(u16 addr, u16 mod);
+
+/**
+ * Append one data word to the open copy run.
+ * @param data Word written to VRAMDATA during replay
+ */
+static inline void NGDisplayListPut(u16 data) {
+    if (ng_display_list.cursor < ng_display_list.limit) {
+        NG_VRAM_COUNT_WORDS(1);
+        *ng_display_list.cursor++ = data;
+    } else {
+        ng_display_list.overflows++;
+    }
+}
+
+/**
+ * Record a fill run (one value repeated).
+ * Closes any open run.
+ * @param addr VRAM address
+ * @param mod VRAMMOD auto-increment
+ * @param value Word to repeat
+ * @param count Number of writes (1-32767)
+ */
+void NGDisplayListFill(u16 addr, u16 mod, u16 value, u16 count);
+
+/**
+ * Record a fill run continuing where the open copy run ends.
+ * Equivalent to NG_VRAM_FILL_FAST() after a sequence of writes.
+ * @param value Word to repeat
+ * @param count Number of writes (1-32767)
+ */
+void NGDisplayListFillNext(u16 value, u16 count);
+/** @} */
+
+/** @} */ /* end of displaylist group */
+
+#endif /* NG_DISPLAY_LIST_H */
@@ -15,6 +15,14 @@
  * - Total: 40x32 tiles (640x512 virtual)
  * - Visible: 40x28 tiles (320x224 pixels)
  * - Safe area: 38x25 tiles (accounts for CRT overscan)
+ *
+ * @section fixshadow Shadow Buffer
+ * Drawing functions write a RAM copy of the layer and note which cells
+ * changed; NGFixFlush() then uploads only those, one span per row.
+ * Printing the same HUD string every frame costs nothing, and a score
+ * that changes costs its changed digits. NGEngineFrameEnd() schedules the
+ * flush as a VBlank job (ng_vblank.h); HAL-only programs do the same or
+ * call NGFixFlush() after NGWaitVBlank() themselves.
  */
 
 #ifndef NG_FIX_H
@@ -111,6 +119,8 @@ static inline NGFixLayout NGFixLayoutXY(u8 x, u8 y) {
 
 /**
  * Put a single tile on the fix layer.
+ * Like all drawing functions below, this writes the shadow; the tile
+ * reaches VRAM at the next NGFixFlush().
  * @param x X position (0-39)
  * @param y Y position (0-31)
  * @param tile Tile index
@@ -129,8 +139,30 @@ void NGFixClear(u8 x, u8 y, u8 w, u8 h);
 
 /**
  * Clear the entire fix layer.
+ * Clears VRAM immediately as well as the shadow, and drops unflushed
+ * changes. Use at startup and between screens.
  */
 void NGFixClearAll(void);
+
+/**
+ * Get a cell from the shadow.
+ * @param x X position (0-39)
+ * @param y Y position (0-31)
+ * @return Palette << 12 | tile, or 0 if out of range
+ */
+u16 NGFixGet(u8 x, u8 y);
+
+/**
+ * Upload changed cells to VRAM.
+ * Call during VBlank (NGEngineFrameEnd() schedules it as a VBlank job).
+ */
+void NGFixFlush(void);
+
+/**
+ * Check whether the shadow has changes not yet flushed.
+ * @return 1 if NGFixFlush() has work to do
+ */
+u8 NGFixIsDirty(void);
 /** @} */
 
 /** @name Text Rendering */
@@ -143,6 +175,12 @@ void NGFixClearAll(void);
  */
 void NGTextSetFont(u16 font_base_tile);
 
+/**
+ * Get the font base tile.
+ * @return First tile of font, as set by NGTextSetFont()
+ */
+u16 NGTextGetFont(void);
+
 /**
  * Print a string.
  * @param layout Layout descriptor
@@ -162,6 +200,93 @@ void NGTextPrint(NGFixLayout layout, u8 palette, const char *str);
 void NGTextPrintf(NGFixLayout layout, u8 palette, const char *fmt, ...);
 /** @} */
 
+/** @name Counters */
+/** @{ */
+
+/**
+ * Packed BCD of a constant (0-99999999), one decimal digit per nibble.
+ * Folds at compile time: NGFixCounterAdd(&score, NG_BCD(500)).
+ */
+#define NG_BCD(n)                                                                             \
+    ((u32)(((u32)(n) % 10) | ((u32)(n) / 10 % 10) << 4 | ((u32)(n) / 100 % 10) << 8 |        \
+           ((u32)(n) / 1000 % 10) << 12 | ((u32)(n) / 10000 % 10) << 16 |                     \
+           ((u32)(n) / 100000 % 10) << 20 | ((u32)(n) / 1000000 % 10) << 24 |                 \
+           ((u32)(n) / 10000000 % 10) << 28))
+
+#define NG_FIX_COUNTER_MAX_DIGITS 8 /**< Digits a counter can show */
+
+/**
+ * Fixed-width decimal number at a fix layer position, for scores and
+ * timers. The value is kept in packed BCD and changed with BCD add and
+ * subtract (ABCD/SBCD on the 68000), and only digits that changed are
+ * redrawn: no division and no format parsing per frame.
+ */
+typedef struct {
+    u32 value;   /**< Packed BCD */
+    u32 shown;   /**< Packed BCD last drawn */
+    u8 x;        /**< Column of the first (most significant) digit */
+    u8 y;        /**< Row */
+    u8 digits;   /**< Width, 1-8 */
+    u8 palette;  /**< Palette index */
+    u8 zero_pad; /**< 1 to draw leading zeros, 0 for blanks */
+} NGFixCounter;
+
+/**
+ * Set up a counter at 0 and draw it.
+ * @param c Counter
+ * @param x X position of the first digit (0-39)
+ * @param y Y position (0-31)
+ * @param digits Width in digits (1-8)
+ * @param palette Palette index
+ * @param zero_pad 1 to draw leading zeros, 0 for blanks
+ */
+void NGFixCounterInit(NGFixCounter *c, u8 x, u8 y, u8 digits, u8 palette, u8 zero_pad);
+
+/**
+ * Set the value from a binary number.
+ * Converts by shifting (no division); meant for resets, not every frame.
+ * Values past the counter's width show as all nines.
+ * @param c Counter
+ * @param value New value
+ */
+void NGFixCounterSet(NGFixCounter *c, u32 value);
+
+/**
+ * Set the value directly in packed BCD.
+ * @param c Counter
+ * @param bcd New value (see NG_BCD())
+ */
+void NGFixCounterSetBCD(NGFixCounter *c, u32 bcd);
+
+/**
+ * Add to the value, stopping at all nines.
+ * @param c Counter
+ * @param bcd Amount in packed BCD (see NG_BCD())
+ */
+void NGFixCounterAdd(NGFixCounter *c, u32 bcd);
+
+/**
+ * Subtract from the value, stopping at 0.
+ * @param c Counter
+ * @param bcd Amount in packed BCD (see NG_BCD())
+ * @return 1 if the counter is now 0 (a timer ran out)
+ */
+u8 NGFixCounterSub(NGFixCounter *c, u32 bcd);
+
+/**
+ * Get the value as a binary number.
+ * @param c Counter
+ * @return Value
+ */
+u32 NGFixCounterGet(const NGFixCounter *c);
+
+/**
+ * Draw every digit again, for example after NGFixClearAll().
+ * @param c Counter
+ */
+void NGFixCounterRedraw(NGFixCounter *c);
+/** @} */
+
 /** @} */ /* end of fix group */
 
 #endif /* NG_FIX_H */
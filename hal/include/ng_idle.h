@@ -0,0 +1,91 @@
+/*
+ * This file is part of ProGearSDK.
+ * Copyright (c) 2024-2025 ProGearSDK contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+/**
+ * @file ng_idle.h
+ * @brief Background work in the lines left before VBlank.
+ *
+ * A frame that finishes early would wait for VBlank doing nothing. Idle
+ * jobs use that time: NGIdleRun() runs them in slices, each a call that
+ * does a bounded piece of work and says whether more is left, until the
+ * LSPC line counter gets close to the VBlank interrupt. NGEngineFrameStart()
+ * calls it right before NGWaitVBlank(); the engine unpacks queued
+ * ng_decomp.h jobs this way.
+ *
+ * Jobs run in priority order, each for as many slices as fit. A job that
+ * does not fit in the lines left is passed over for shorter ones. A slice
+ * that leaves work is charged at least the lines it was registered with,
+ * even if the counter shows less, so an interrupt-heavy frame does not
+ * keep running slices; a job with nothing to do costs only its check.
+ * Nothing runs at all once VBlank has come: the frame is late already.
+ *
+ * Slices run in the main loop with interrupts enabled, and may do
+ * anything the main loop does except wait for VBlank.
+ *
+ * @code
+ * static u8 rebuild_step(void) {
+ *     rebuild_row(row++);
+ *     return row < ROWS;
+ * }
+ *
+ * NGIdleJobAdd(rebuild_step, 1, 6);
+ * @endcode
+ */
+
+#ifndef NG_IDLE_H
+#define NG_IDLE_H
+
+#include <ng_types.h>
+
+/**
+ * @defgroup idle Idle Jobs
+ * @ingroup hal
+ * @brief Sliced background work before the VBlank wait.
+ * @{
+ */
+
+#define NG_IDLE_JOBS    8    /**< Jobs that can be registered */
+#define NG_IDLE_MARGIN  4    /**< Default lines kept free before the VBlank interrupt */
+#define NG_IDLE_NO_JOB  0xFF /**< NGIdleJobAdd() result when the table is full */
+
+/** Job handle */
+typedef u8 NGIdleJob;
+
+/**
+ * One slice of a job.
+ * @return 1 if the job has more work, 0 when it has none left this frame
+ */
+typedef u8 (*NGIdleSlice)(void);
+
+/**
+ * Register a job.
+ * @param slice Function doing one slice of work
+ * @param priority Order among jobs, 0 first; equal priorities run in the
+ *                 order they were added
+ * @param lines Most lines one slice takes (at least 1)
+ * @return Job handle, or NG_IDLE_NO_JOB
+ */
+NGIdleJob NGIdleJobAdd(NGIdleSlice slice, u8 priority, u8 lines);
+
+/** Remove every job. */
+void NGIdleJobsClear(void);
+
+/**
+ * Set the lines kept free before the VBlank interrupt.
+ * @param lines Margin (default NG_IDLE_MARGIN)
+ */
+void NGIdleSetMargin(u8 lines);
+
+/**
+ * Run job slices until none fits before the VBlank interrupt or no job has
+ * work left.
+ * @return Slices run
+ */
+u8 NGIdleRun(void);
+
+/** @} */ /* end of idle group */
+
+#endif /* NG_IDLE_H */
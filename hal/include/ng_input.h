@@ -20,6 +20,51 @@
  * - NGInputPressed(): True only on first frame button is pressed
  * - NGInputReleased(): True only on frame button is released
  * - NGInputHeld(): True every frame button is down
+ *
+ * @section inputhistory History and Motions
+ * NGInputUpdate() also pushes each player's state into a ring of the last
+ * NG_INPUT_HISTORY_SIZE frames (NGInputGetHistory()), and steps every
+ * registered motion one frame. A motion is a list of steps, each an input
+ * that must follow the previous one within a frame window, so special
+ * moves cost one state machine step per motion per frame instead of a
+ * scan of the history.
+ *
+ * @code
+ * // Quarter circle forward + A, each step within 8 frames of the last
+ * static const NGInputStep qcf_a[] = {
+ *     {NG_BTN_DOWN, 8, 0},
+ *     {NG_BTN_DOWN | NG_BTN_RIGHT, 8, 0},
+ *     {NG_BTN_RIGHT, 8, 0},
+ *     {NG_BTN_A, 8, 0},
+ * };
+ * static const NGInputMotion fireball = {qcf_a, 4};
+ *
+ * NGInputMotionHandle m = NGInputMotionRegister(NG_PLAYER_1, &fireball);
+ * ...
+ * NGInputMotionSetMirror(m, facing_left);
+ * if (NGInputMotionMatched(m))
+ *     throw_fireball();
+ * @endcode
+ *
+ * @section inputrecord Record and Playback
+ * NGInputRecordStart() logs what NGInputUpdate() reads from the hardware
+ * (both players and the system buttons), and NGInputPlaybackStart() feeds
+ * a log back in its place. With the same build, seed and starting point a
+ * played back session runs the same frames, so profiler numbers from two
+ * builds compare like for like. Logs are run-length encoded, 4 bytes per
+ * change of input (up to 255 frames each), and can be kept in backup RAM
+ * with NGInputRecordSave().
+ *
+ * @code
+ * static u8 input_log[4096];
+ * NGInputRecordStart(input_log, sizeof(input_log));
+ * ...                                      // Play
+ * NGInputRecordStop();
+ * NGInputRecordSave(0x1000);               // Survives power off
+ *
+ * if (NGInputRecordLoad(0x1000, input_log, sizeof(input_log)))
+ *     NGInputPlaybackStart(input_log, sizeof(input_log));
+ * @endcode
  */
 
 #ifndef NG_INPUT_H
@@ -70,6 +115,47 @@
 #define NG_PLAYER_2 1 /**< Player 2 */
 /** @} */
 
+/** @name Configuration */
+/** @{ */
+
+#ifndef NG_INPUT_HISTORY_SIZE
+#define NG_INPUT_HISTORY_SIZE 32 /**< Frames of history per player (power of two, up to 128) */
+#endif
+
+#ifndef NG_INPUT_MAX_MOTIONS
+#define NG_INPUT_MAX_MOTIONS 16 /**< Motions registered at once, both players */
+#endif
+
+#define NG_INPUT_MOTION_NONE 0xFF /**< Returned when no motion slot is free */
+/** @} */
+
+/** @name Motion Types */
+/** @{ */
+
+/**
+ * One step of a motion.
+ *
+ * Direction bits of @c input must equal the stick direction exactly, so
+ * NG_BTN_DOWN does not match down-right. Button bits must be pressed on
+ * that frame. A step with buttons but no direction bits ignores the
+ * stick; a step of 0 matches neutral.
+ */
+typedef struct {
+    u16 input; /**< Direction and button mask */
+    u8 window; /**< Frames allowed after the previous step's input was last held */
+    u8 hold;   /**< Frames the direction must be held first (charge), 0 for a tap */
+} NGInputStep;
+
+/** Motion definition, usually const. Must outlive its registration. */
+typedef struct {
+    const NGInputStep *steps; /**< Steps in order */
+    u8 count;                 /**< Number of steps */
+} NGInputMotion;
+
+/** Registered motion, or NG_INPUT_MOTION_NONE */
+typedef u8 NGInputMotionHandle;
+/** @} */
+
 /** @name System Functions */
 /** @{ */
 
@@ -160,6 +246,132 @@ u16 NGInputHeldFrames(u8 player, u16 button);
 u16 NGInputReleasedFrames(u8 player, u16 button);
 /** @} */
 
+/** @name History */
+/** @{ */
+
+/**
+ * Get the number of NGInputUpdate() calls since NGInputInit().
+ * Timestamps history entries: the state from NGInputGetHistory(p, n) was
+ * read on frame NGInputGetFrame() - n.
+ * @return Frame count
+ */
+u32 NGInputGetFrame(void);
+
+/**
+ * Get a past button state.
+ * @param player Player index
+ * @param frames_ago 0 for the current frame, up to NG_INPUT_HISTORY_SIZE - 1
+ * @return Button bitmask, or 0 if out of range or before NGInputInit()
+ */
+u16 NGInputGetHistory(u8 player, u8 frames_ago);
+/** @} */
+
+/** @name Motion Matching */
+/** @{ */
+
+/**
+ * Start matching a motion against a player's input.
+ * Matching starts with the next NGInputUpdate().
+ * @param player Player index
+ * @param motion Motion definition (not copied)
+ * @return Handle, or NG_INPUT_MOTION_NONE if all slots are in use or the
+ *         motion has no steps
+ */
+NGInputMotionHandle NGInputMotionRegister(u8 player, const NGInputMotion *motion);
+
+/**
+ * Stop matching a motion and free its slot.
+ * @param handle Motion handle
+ */
+void NGInputMotionUnregister(NGInputMotionHandle handle);
+
+/**
+ * Swap left and right for a motion, for characters facing left.
+ * Progress so far is kept.
+ * @param handle Motion handle
+ * @param mirror 1 to swap, 0 for the motion as defined
+ */
+void NGInputMotionSetMirror(NGInputMotionHandle handle, u8 mirror);
+
+/**
+ * Check whether a motion was completed by this frame's input.
+ * True for one frame; the motion then starts over.
+ * @param handle Motion handle
+ * @return 1 if completed this frame
+ */
+u8 NGInputMotionMatched(NGInputMotionHandle handle);
+
+/**
+ * Discard a motion's progress, for example after a hit or a round start.
+ * @param handle Motion handle
+ */
+void NGInputMotionReset(NGInputMotionHandle handle);
+/** @} */
+
+/** @name Record and Playback */
+/** @{ */
+
+/**
+ * Start logging input.
+ * Each following NGInputUpdate() appends the state it reads. Replaces a
+ * recording in progress. Recording stops by itself when the buffer fills.
+ * @param buffer Log buffer, kept until NGInputRecordStop()
+ * @param size Buffer size in bytes (one byte is kept for the end marker)
+ */
+void NGInputRecordStart(u8 *buffer, u16 size);
+
+/**
+ * Stop logging input and terminate the log.
+ * @return Log length in bytes including the end marker (also once the
+ *         buffer has filled), 0 if nothing was recorded
+ */
+u16 NGInputRecordStop(void);
+
+/**
+ * Check if input is being recorded.
+ * @return 1 while recording, 0 once stopped or full
+ */
+u8 NGInputIsRecording(void);
+
+/**
+ * Write the last recorded log to backup RAM.
+ * Stored as a length word followed by the log. Unlocks SRAM for the
+ * write and restores its lock state afterwards.
+ * @param sram_offset SRAM offset (even)
+ * @return Bytes written, 0 if there is no log
+ */
+u16 NGInputRecordSave(u16 sram_offset);
+
+/**
+ * Read a log saved with NGInputRecordSave().
+ * @param sram_offset SRAM offset it was saved at
+ * @param buffer Destination buffer
+ * @param size Buffer size in bytes
+ * @return Log length, or 0 if none is stored there or it does not fit
+ */
+u16 NGInputRecordLoad(u16 sram_offset, u8 *buffer, u16 size);
+
+/**
+ * Replace hardware input with a recorded log.
+ * Starts with the next NGInputUpdate(). Live input returns at the end of
+ * the log. Stops a recording in progress.
+ * @param log Log from NGInputRecordStop() (RAM or ROM)
+ * @param length Log length in bytes
+ */
+void NGInputPlaybackStart(const u8 *log, u16 length);
+
+/**
+ * Return to hardware input.
+ */
+void NGInputPlaybackStop(void);
+
+/**
+ * Check if input comes from a log.
+ * @return 1 during playback, 0 once the log has ended or been stopped
+ */
+u8 NGInputIsPlayingBack(void);
+/** @} */
+
 /** @name System Input Queries */
 /** @{ */
 
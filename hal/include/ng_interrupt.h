@@ -13,6 +13,8 @@
  * - Level 2 (Timer): Fires when the LSPC timer reaches zero
  *
  * The timer interrupt is essential for raster effects (mid-frame changes).
+ * For scheduled palette, backdrop and SCB writes, ng_raster.h drives it
+ * from a per-frame table instead of a C handler.
  *
  * Usage for raster effects:
  * @code
@@ -12,7 +12,16 @@
  * - Palettes 0-15: Typically for fix layer (text)
  * - Palettes 16-255: Typically for sprites
  *
- * @note Update palettes during VBlank to avoid visual artifacts.
+ * All palette functions work on a shadow copy in work RAM. Writes mark
+ * the palette dirty, and the VBlank handler uploads only dirty palettes,
+ * so colors can be changed at any point in the frame without artifacts
+ * and reads never touch palette RAM.
+ *
+ * The shadow is kept per group of 8 palettes, taken from a pool of
+ * NG_PAL_SHADOW_GROUPS on the group's first use, so only the palettes a
+ * game touches cost work RAM. Once the pool is used up, further groups
+ * are read and written in palette RAM directly, and changes to them show
+ * at once instead of at the next VBlank.
  */
 
 #ifndef NG_PALETTE_H
@@ -21,6 +30,10 @@
 #include <ng_types.h>
 #include <ng_color.h>
 
+#ifdef NG_MOCK_HAL
+#include <ng_mock.h>
+#endif
+
 /**
  * @defgroup palette Palette Management
  * @ingroup hal
@@ -33,7 +46,11 @@
 
 #define NG_PAL_COUNT    256      /**< Total number of palettes */
 #define NG_PAL_SIZE     16       /**< Colors per palette */
+#ifdef NG_MOCK_HAL
+#define NG_PAL_RAM_BASE NG_MOCK_PAL_RAM_BASE /* Host benchmark build */
+#else
 #define NG_PAL_RAM_BASE 0x400000 /**< Palette RAM start address */
+#endif
 
 #define NG_PAL_BANK_FIX 0  /**< Fix layer palette bank (0-15) */
 #define NG_PAL_BANK_SPR 16 /**< Sprite palette bank (16-255) */
@@ -117,6 +134,23 @@ void NGPalGradient(u8 palette, u8 start_idx, u8 end_idx, NGColor start_color, NG
  * @param amount Fade amount (0=no change, 31=target)
  */
 void NGPalFadeToColor(u8 palette, NGColor target, u8 amount);
+
+/**
+ * Crossfade two palettes into a third, colors 1-15. For transitions run
+ * from backups, e.g. a day palette to a night palette over many frames.
+ * @param dst_palette Palette written (may be one of the others)
+ * @param from_palette Colors at ratio 0
+ * @param to_palette Colors at ratio 255
+ * @param ratio Blend ratio (0=all from, 255=all to)
+ */
+void NGPalCrossfade(u8 dst_palette, u8 from_palette, u8 to_palette, u8 ratio);
+
+/**
+ * Lighten or darken colors 1-15 of a palette.
+ * @param palette Palette index
+ * @param amount Adjustment (-31 to +31), as for NGColorAdjustBrightness()
+ */
+void NGPalAdjustBrightness(u8 palette, s8 amount);
 /** @} */
 
 /** @name Backup/Restore */
@@ -137,6 +171,70 @@ void NGPalBackup(u8 palette, NGColor buffer[NG_PAL_SIZE]);
 void NGPalRestore(u8 palette, const NGColor buffer[NG_PAL_SIZE]);
 /** @} */
 
+/** @name Palette Slots
+ * Palettes lent out at run time for per-instance effects. A hit flash
+ * borrows a slot holding a copy of the sprite's palette and tints that,
+ * so the shared palette every other sprite uses (and that lighting has
+ * backed up) is left alone:
+ * @code
+ * u8 flash = NGPalSlotBorrow(NGPAL_ENEMY);
+ * NGPalFadeToColor(flash, NG_COLOR_WHITE, 24);
+ * NGActorSetPalette(enemy, flash); // The actor holds a reference
+ * NGPalSlotRelease(flash);
+ * // ... a few frames later; the slot is free again
+ * NGActorSetPalette(enemy, NGPAL_ENEMY);
+ * @endcode
+ * Slots sit just below palette 255, whose last color is the backdrop.
+ * The asset tool assigns asset palettes below NG_PAL_SLOT_FIRST.
+ */
+/** @{ */
+
+#ifndef NG_PAL_SLOTS
+#define NG_PAL_SLOTS 32 /**< Palettes handed out by NGPalSlotAlloc() */
+#endif
+#define NG_PAL_SLOT_FIRST (NG_PAL_COUNT - 1 - NG_PAL_SLOTS) /**< First slot palette */
+#define NG_PAL_NO_SLOT    0 /**< NGPalSlotAlloc() result when every slot is taken */
+
+/** @return 1 if the palette is one of the slots */
+static inline u8 NGPalIsSlot(u8 palette) {
+    return (u8)(palette - NG_PAL_SLOT_FIRST) < NG_PAL_SLOTS;
+}
+
+/**
+ * Take a free slot, with one reference. Its colors are whatever the last
+ * user left.
+ * @return Slot palette, or NG_PAL_NO_SLOT
+ */
+u8 NGPalSlotAlloc(void);
+
+/**
+ * Take a free slot holding a copy of a palette.
+ * @param src_palette Palette to copy
+ * @return Slot palette, or NG_PAL_NO_SLOT
+ */
+u8 NGPalSlotBorrow(u8 src_palette);
+
+/**
+ * Add a reference to a slot. Does nothing for other palettes, so callers
+ * can pass any palette they are about to use.
+ * @param palette Palette index
+ */
+void NGPalSlotRetain(u8 palette);
+
+/**
+ * Drop a reference to a slot; it is free again at zero. Does nothing for
+ * other palettes.
+ * @param palette Palette index
+ */
+void NGPalSlotRelease(u8 palette);
+
+/** @return Slots with no reference */
+u8 NGPalSlotsFree(void);
+
+/** Free every slot. Called by NGEngineInit(). */
+void NGPalSlotsReset(void);
+/** @} */
+
 /** @name Utilities */
 /** @{ */
 
@@ -176,26 +274,91 @@ void NGPalSetBackdrop(NGColor color);
 NGColor NGPalGetBackdrop(void);
 /** @} */
 
+/** @name Shadow Palette RAM */
+/** @{ */
+
+#ifndef NG_PAL_SHADOW_GROUPS
+/**
+ * Groups of 8 palettes that get a shadow in work RAM, 256 bytes each.
+ * The default covers fix palette 0, asset palettes 2-55, and the
+ * run-time slots with the backdrop color (5 groups).
+ */
+#define NG_PAL_SHADOW_GROUPS 12
+#endif
+
+/**
+ * Shadow of each group of 8 palettes, uploaded to hardware during VBlank.
+ * NULL until the group is first used, or the group's own palette RAM once
+ * the shadow pool is used up.
+ */
+extern u16 *ng_pal_group[NG_PAL_COUNT / 8];
+
+/** Shadow groups handed out from the pool */
+extern u8 ng_pal_groups_used;
+
+/** Give a group its shadow (internal, called by NGPalGetShadow()) */
+u16 *_NGPalGroupAlloc(u8 group);
+
+/** Dirty bits, one per palette (bit n of byte k = palette k*8+n) */
+extern volatile u8 ng_pal_dirty[NG_PAL_COUNT / 8];
+
+/** Nonzero when any bit in ng_pal_dirty is set */
+extern volatile u8 ng_pal_dirty_any;
+
+/**
+ * Queue a palette for upload at the next VBlank.
+ * Call after writing through NGPalGetShadow().
+ * @param palette Palette index
+ */
+static inline void NGPalMarkDirty(u8 palette) {
+    ng_pal_dirty[palette >> 3] |= (u8)(1 << (palette & 7));
+    ng_pal_dirty_any = 1;
+}
+
+/**
+ * Upload all dirty palettes to palette RAM now.
+ * The VBlank handler does this automatically; call it only when the
+ * SDK's VBlank handler is not running.
+ */
+void NGPalFlush(void);
+/** @} */
+
 /** @name Direct Access */
 /** @{ */
 
 /**
- * Get pointer to palette RAM.
+ * Get pointer to a palette's shadow copy without marking it dirty.
+ * Use for reads, or write and then call NGPalMarkDirty().
+ * @param palette Palette index
+ * @return Pointer to first color in palette
+ */
+static inline u16 *NGPalGetShadow(u8 palette) {
+    u16 *group = ng_pal_group[palette >> 3];
+    if (!group)
+        group = _NGPalGroupAlloc((u8)(palette >> 3));
+    return group + (palette & 7) * NG_PAL_SIZE;
+}
+
+/**
+ * Get pointer to a palette for writing and mark it dirty.
+ * If the writes may straddle a VBlank, call NGPalMarkDirty() again
+ * afterwards so the tail is not lost.
  * @param palette Palette index
  * @return Pointer to first color in palette
  */
-static inline volatile u16 *NGPalGetPtr(u8 palette) {
-    return (volatile u16 *)(NG_PAL_RAM_BASE + (palette * NG_PAL_SIZE * 2));
+static inline u16 *NGPalGetPtr(u8 palette) {
+    NGPalMarkDirty(palette);
+    return NGPalGetShadow(palette);
 }
 
 /**
- * Get pointer to specific color in palette RAM.
+ * Get pointer to a specific color for writing and mark its palette dirty.
  * @param palette Palette index
  * @param index Color index
  * @return Pointer to color
  */
-static inline volatile u16 *NGPalGetColorPtr(u8 palette, u8 index) {
-    return (volatile u16 *)(NG_PAL_RAM_BASE + (palette * NG_PAL_SIZE * 2) + (index * 2));
+static inline u16 *NGPalGetColorPtr(u8 palette, u8 index) {
+    return NGPalGetPtr(palette) + index;
 }
 /** @} */
 
@@ -0,0 +1,176 @@
+/*
+ * This file is part of ProGearSDK.
+ * Copyright (c) 2024-2025 ProGearSDK contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+/**
+ * @file ng_profile.h
+ * @brief Per-frame scanline profiler with fix layer overlay.
+ *
+ * Measures how many raster lines each code section takes by sampling the
+ * LSPC line counter. Samples from the last NG_PROFILE_HISTORY frames are
+ * kept in a ring buffer and summarized as min/max/avg per slot.
+ *
+ * Everything here compiles out unless NG_PROFILE is defined, so the
+ * NG_PROFILE_* macros can stay in shipping code.
+ *
+ * Begin and end events are also written to ng_profile_marker, so an
+ * emulator script with a write tap on that word can time sections in CPU
+ * cycles (see demos/bench).
+ *
+ * @code
+ * NGProfileRegister(0, "AI");
+ * NG_PROFILE_BEGIN(0);
+ * update_enemies();
+ * NG_PROFILE_END(0);
+ * NG_PROFILE_FRAME_END();        // Once per frame
+ * NG_PROFILE_DRAW(1, 3, 0);      // Overlay at column 1, row 3
+ * NG_PROFILE_DRAW_ARENAS(1, 20, 0);  // Arena usage below it
+ * @endcode
+ */
+
+#ifndef NG_PROFILE_H
+#define NG_PROFILE_H
+
+#include <ng_types.h>
+#include <ng_hardware.h>
+#include <ng_arena.h>
+
+/**
+ * @defgroup profile Profiler
+ * @ingroup hal
+ * @brief Scanline-based frame profiling.
+ * @{
+ */
+
+/** @name Configuration */
+/** @{ */
+
+#ifndef NG_PROFILE_MAX_SLOTS
+#define NG_PROFILE_MAX_SLOTS 12 /**< Number of profiling slots */
+#endif
+
+#ifndef NG_PROFILE_HISTORY
+#define NG_PROFILE_HISTORY 60 /**< Frames kept for min/max/avg */
+#endif
+
+#define NG_PROFILE_FRAME_LINES 264  /**< Raster lines per frame */
+#define NG_PROFILE_LINE_FIRST  0xF8 /**< First value of the LSPC line counter */
+
+#define NG_PROFILE_MARKER_END  0x8000 /**< Marker flag: section ended */
+#define NG_PROFILE_MARKER_DONE 0xFFFF /**< Marker value: benchmark run complete */
+/** @} */
+
+/** @name Raster Line Counter */
+/** @{ */
+
+/**
+ * Read the current raster line.
+ * The LSPC counter runs 0xF8-0x1FF; this returns it rebased to 0-263.
+ * @return Current line (0 = first line after the counter wraps)
+ */
+static inline u16 NGProfileLine(void) {
+    return (u16)((NG_REG_LSPCMODE >> 7) - NG_PROFILE_LINE_FIRST);
+}
+/** @} */
+
+/** @name Statistics */
+/** @{ */
+
+/** Summary of one slot over the history window */
+typedef struct {
+    u16 last; /**< Lines used in the most recent frame */
+    u16 min;  /**< Minimum over the window */
+    u16 max;  /**< Maximum over the window */
+    u16 avg;  /**< Average over the window */
+} NGProfileStats;
+/** @} */
+
+#ifdef NG_PROFILE
+
+/** @name Profiling API (NG_PROFILE builds only) */
+/** @{ */
+
+/**
+ * Last profiler event: the slot index on begin, slot | NG_PROFILE_MARKER_END
+ * on end. Only written, never read, by the SDK.
+ */
+extern volatile u16 ng_profile_marker;
+
+/**
+ * Name a slot so it appears in the overlay.
+ * @param slot Slot index (0 to NG_PROFILE_MAX_SLOTS-1)
+ * @param name Label (up to 8 characters fit the overlay)
+ */
+void NGProfileRegister(u8 slot, const char *name);
+
+/**
+ * Mark the start of a section.
+ * @param slot Slot index
+ */
+void NGProfileBegin(u8 slot);
+
+/**
+ * Mark the end of a section. Lines are accumulated, so a slot may be
+ * entered several times per frame.
+ * @param slot Slot index
+ */
+void NGProfileEnd(u8 slot);
+
+/**
+ * Commit this frame's samples into the history ring buffer.
+ * Call once per frame.
+ */
+void NGProfileFrameEnd(void);
+
+/**
+ * Get statistics for a slot.
+ * @param slot Slot index
+ * @param[out] out Statistics over the history window
+ */
+void NGProfileGetStats(u8 slot, NGProfileStats *out);
+
+/**
+ * Print all registered slots to the fix layer.
+ * One row per slot: name, last, min, max, avg (in scanlines).
+ * @param x Fix layer column
+ * @param y Fix layer row of the header line
+ * @param palette Fix layer palette
+ */
+void NGProfileDraw(u8 x, u8 y, u8 palette);
+
+/**
+ * Print usage of the three standard arenas to the fix layer.
+ * One row per arena: bytes used now, peak and size, then allocations
+ * since the last reset and the peak between resets (per frame for FRAME).
+ * An arena that ran out gets a second row with the failure count, the
+ * size of the first failed request and the address it was called from
+ * (look it up in the linker map). Needs NG_ARENA_STATS, which NG_PROFILE
+ * turns on unless it was set to 0.
+ * @param x Fix layer column
+ * @param y Fix layer row of the header line
+ * @param palette Fix layer palette
+ */
+void NGProfileDrawArenas(u8 x, u8 y, u8 palette);
+/** @} */
+
+#define NG_PROFILE_BEGIN(slot)            NGProfileBegin(slot)
+#define NG_PROFILE_END(slot)              NGProfileEnd(slot)
+#define NG_PROFILE_FRAME_END()            NGProfileFrameEnd()
+#define NG_PROFILE_DRAW(x, y, pal)        NGProfileDraw((x), (y), (pal))
+#define NG_PROFILE_DRAW_ARENAS(x, y, pal) NGProfileDrawArenas((x), (y), (pal))
+
+#else
+
+#define NG_PROFILE_BEGIN(slot)            ((void)0)
+#define NG_PROFILE_END(slot)              ((void)0)
+#define NG_PROFILE_FRAME_END()            ((void)0)
+#define NG_PROFILE_DRAW(x, y, pal)        ((void)0)
+#define NG_PROFILE_DRAW_ARENAS(x, y, pal) ((void)0)
+
+#endif /* NG_PROFILE */
+
+/** @} */ /* end of profile group */
+
+#endif /* NG_PROFILE_H */
@@ -0,0 +1,205 @@
+/*
+ * This file is part of ProGearSDK.
+ * Copyright (c) 2024-2025 ProGearSDK contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+/**
+ * @file ng_raster.h
+ * @brief Scanline-scheduled register writes driven by the timer interrupt.
+ *
+ * A raster table is a list of (line, action) entries kept sorted by line.
+ * An action writes one palette color, the backdrop color, or one VRAM word
+ * (typically SCB3/SCB4 for per-band parallax). NGRasterSubmit() compiles
+ * the table into a buffer that the _timer handler in crt0.s walks without
+ * calling into C: one interrupt per distinct line, all of that line's
+ * writes applied back to back.
+ *
+ * Tables are double-buffered. The submitted table starts playing at the
+ * next VBlank and keeps playing every frame until another one is
+ * submitted, so game code can build the next frame's table while the
+ * current one is on screen.
+ *
+ * Buffer format (16-bit words):
+ * @code
+ * [reload hi][reload lo]                  first interrupt, armed in VBlank
+ * [reload hi][reload lo][count-1][target][value]...   one group per line
+ * [0xFFFF]                                terminator
+ * @endcode
+ * Each group starts with the reload for the interval to the next group,
+ * written before its actions so interrupt-to-reload latency is constant.
+ * A target below 0x8000 is a palette RAM word index, otherwise a VRAM
+ * address.
+ *
+ * @code
+ * NGRasterBegin();
+ * for (u8 band = 0; band < 8; band++)
+ *     NGRasterAddBackdrop(band * 28, sky[band]);
+ * NGRasterSubmit();   // Plays from the next frame on
+ * @endcode
+ *
+ * Palette writes go straight to palette RAM and bypass the shadow in
+ * ng_palette.h, so a color changed mid-frame stays changed at the top of
+ * the next frame. Add a line 0 entry to put it back.
+ *
+ * VRAM writes set VRAMADDR from inside the interrupt. Game code that
+ * writes VRAM during active display (immediate sprite updates,
+ * NGFixClearAll()) can have its address clobbered; use them with deferred
+ * drawing (NGEngineSetDeferredDraw()). The same holds for VBlank jobs
+ * that write VRAM, such as the engine's fix layer flush: one that fires
+ * while the main loop is writing VRAM moves its address. The engine only
+ * schedules the flush after NGSceneDraw() and NGDisplayListSubmit(), so
+ * game code that writes VRAM after NGEngineFrameEnd() should use deferred
+ * drawing as well.
+ *
+ * While a table is playing the timer belongs to this module. The handler
+ * set with NGInterruptSetTimerHandler() runs only when no table is active.
+ */
+
+#ifndef NG_RASTER_H
+#define NG_RASTER_H
+
+#include <ng_types.h>
+#include <ng_sprite.h>
+
+/**
+ * @defgroup raster Raster Effects
+ * @ingroup hal
+ * @brief Per-scanline palette, backdrop and SCB writes.
+ * @{
+ */
+
+/** @name Configuration */
+/** @{ */
+
+#ifndef NG_RASTER_MAX_ENTRIES
+#define NG_RASTER_MAX_ENTRIES 64 /**< Entries per table */
+#endif
+
+#ifndef NG_RASTER_IRQ_LATENCY
+/**
+ * Pixel clocks from the timer reaching zero to the reload write in the
+ * handler: interrupt entry plus the handler's first instructions, about
+ * 160 CPU cycles. Subtracted from every reload so bands do not drift.
+ */
+#define NG_RASTER_IRQ_LATENCY 80
+#endif
+
+#define NG_RASTER_LINES        224 /**< Visible lines (valid entry lines are 0-223) */
+#define NG_RASTER_VBLANK_LINES 40  /**< Lines from the VBlank interrupt to visible line 0 */
+#define NG_RASTER_LINE_CLOCKS  384 /**< Timer clocks (pixels) per line */
+
+/** Reload value that never fires: longer than a frame, and reloaded at VBlank */
+#define NG_RASTER_RELOAD_IDLE 0x20000
+
+/** Buffer words for a full table: first reload, one group per entry, terminator */
+#define NG_RASTER_BUFFER_WORDS (2 + NG_RASTER_MAX_ENTRIES * 5 + 1)
+/** @} */
+
+/** @name Playback State */
+/** @{ */
+
+/** Compiled table waiting for the next VBlank (consumed and cleared by crt0.s) */
+extern u16 *volatile ng_raster_pending;
+
+/** Table replayed every frame, NULL when raster effects are off */
+extern u16 *volatile ng_raster_current;
+
+/** Next group for the timer handler, NULL once the frame's table is done */
+extern u16 *volatile ng_raster_cursor;
+/** @} */
+
+/** @name Building Tables */
+/** @{ */
+
+/**
+ * Start a new table. Entries added since the last submit are discarded.
+ * The table currently on screen is unaffected. Only needed to throw away
+ * a partly built table: NGRasterSubmit() also starts a new one.
+ */
+void NGRasterBegin(void);
+
+/**
+ * Schedule a palette RAM write.
+ * @param line Visible line (0-223) at which the write happens
+ * @param palette Palette index (0-255)
+ * @param index Color index within the palette (0-15)
+ * @param color NeoGeo color value
+ * @return 1 on success, 0 if the table is full or the line is off screen
+ */
+u8 NGRasterAddPalette(u16 line, u8 palette, u8 index, u16 color);
+
+/**
+ * Schedule a backdrop color change.
+ * @param line Visible line (0-223)
+ * @param color NeoGeo color value
+ * @return 1 on success, 0 if the table is full or the line is off screen
+ */
+u8 NGRasterAddBackdrop(u16 line, u16 color);
+
+/**
+ * Schedule a write to one VRAM word.
+ * @param line Visible line (0-223)
+ * @param vram_addr VRAM address (0x8000 and up: SCB2-SCB4 and LSPC tables)
+ * @param value Word to write
+ * @return 1 on success, 0 if the table is full, the line is off screen or
+ *         the address is below 0x8000
+ */
+u8 NGRasterAddVRAM(u16 line, u16 vram_addr, u16 value);
+
+/**
+ * Schedule an SCB3 (Y position, sticky, height) write.
+ * @param line Visible line (0-223)
+ * @param sprite Hardware sprite index
+ * @param value SCB3 word (see NGSpriteSCB3())
+ * @return 1 on success, 0 on failure
+ */
+static inline u8 NGRasterAddSCB3(u16 line, u16 sprite, u16 value) {
+    return NGRasterAddVRAM(line, (u16)(NG_SCB3_BASE + sprite), value);
+}
+
+/**
+ * Schedule an SCB4 (X position) write.
+ * @param line Visible line (0-223)
+ * @param sprite Hardware sprite index
+ * @param value SCB4 word (X position in bits 15-7)
+ * @return 1 on success, 0 on failure
+ */
+static inline u8 NGRasterAddSCB4(u16 line, u16 sprite, u16 value) {
+    return NGRasterAddVRAM(line, (u16)(NG_SCB4_BASE + sprite), value);
+}
+
+/**
+ * Get the number of entries in the table being built.
+ * @return Entry count
+ */
+u8 NGRasterGetCount(void);
+/** @} */
+
+/** @name Playback */
+/** @{ */
+
+/**
+ * Compile the table and hand it to the VBlank interrupt.
+ * It plays from the next frame and repeats until replaced. The entries are
+ * consumed, so the next table starts empty. Submitting an empty table is
+ * the same as NGRasterClear(). Enables the timer if needed.
+ */
+void NGRasterSubmit(void);
+
+/**
+ * Stop raster effects immediately.
+ * Hands the timer back to the handler set with NGInterruptSetTimerHandler().
+ */
+void NGRasterClear(void);
+
+/**
+ * Check whether a table is playing or about to play.
+ * @return 1 if raster effects are active
+ */
+u8 NGRasterIsActive(void);
+/** @} */
+
+/** @} */ /* end of raster group */
+
+#endif /* NG_RASTER_H */
@@ -31,6 +31,8 @@
 
 #include <ng_types.h>
 #include <ng_hardware.h>
+#include <ng_display_list.h>
+#include <ng_tables.h>
 
 /**
  * @defgroup sprite Sprite Hardware
@@ -66,6 +68,12 @@
 
 /** Maximum sprite height in tiles */
 #define NG_SPRITE_MAX_HEIGHT 32
+
+/** SCB1 attribute: tile cycles through 4 frames (LSPC replaces tile bits 0-1) */
+#define NG_SPRITE_ATTR_AUTOANIM4 0x0004
+
+/** SCB1 attribute: tile cycles through 8 frames (LSPC replaces tile bits 0-2) */
+#define NG_SPRITE_ATTR_AUTOANIM8 0x0008
 /** @} */
 
 /** @name Inline Utility Functions */
@@ -99,13 +107,10 @@ static inline s16 NGSpriteScreenToHardwareY(s16 screen_y) {
  * @return Adjusted height in tiles (1-32)
  */
 static inline u8 NGSpriteAdjustedHeight(u8 rows, u8 v_shrink) {
-    /* Ceiling division: (rows * v_shrink + 254) / 255 */
-    u16 adjusted = (u16)(((u16)rows * v_shrink + 254) / 255);
-    if (adjusted < 1)
-        adjusted = 1;
-    if (adjusted > NG_SPRITE_MAX_HEIGHT)
-        adjusted = NG_SPRITE_MAX_HEIGHT;
-    return (u8)adjusted;
+    /* Ceiling of rows * v_shrink / 255, precomputed in ng_tables.h */
+    if (rows > NG_SPRITE_MAX_HEIGHT)
+        rows = NG_SPRITE_MAX_HEIGHT;
+    return ng_sprite_height_table[rows][v_shrink];
 }
 
 /**
@@ -158,6 +163,10 @@ static inline u16 NGSpriteSCB4(s16 screen_x) {
 static inline void NGSpriteHideRange(u16 first_sprite, u8 count) {
     if (count == 0)
         return;
+    if (NGDisplayListIsRecording()) {
+        NGDisplayListFill(NG_SCB3_BASE + first_sprite, 1, 0, count);
+        return;
+    }
     NG_VRAM_DECLARE_BASE();
     NG_VRAM_SETUP_FAST(NG_SCB3_BASE + first_sprite, 1);
     NG_VRAM_CLEAR_FAST(count);
@@ -232,6 +241,16 @@ void NGSpriteTilePadTo32(u8 rows_written);
  *       scaling steps. See: wiki.neogeodev.org/index.php?title=Scaling_sprite_groups
  */
 void NGSpriteShrinkSet(u16 first_sprite, u8 count, u16 shrink);
+
+/**
+ * Write a sprite group's shrink values at the current VRAM address.
+ * Same words as NGSpriteShrinkSet(), without the address setup, so
+ * adjacent groups can continue one SCB2 run.
+ *
+ * @param count  Number of sprites in the group
+ * @param shrink Packed shrink value, as for NGSpriteShrinkSet()
+ */
+void NGSpriteShrinkWrite(u8 count, u16 shrink);
 /** @} */
 
 /** @name SCB3: Y Position and Height */
@@ -312,6 +331,30 @@ void NGSpriteXBegin(u16 first_sprite);
 void NGSpriteXWriteNext(s16 screen_x);
 /** @} */
 
+/** @name Auto-Animation
+ *
+ *  Tiles whose SCB1 attribute has NG_SPRITE_ATTR_AUTOANIM4/8 set are
+ *  animated by the LSPC: it substitutes a global frame counter for the low
+ *  2 or 3 bits of the tile number, so a group of 4 or 8 consecutive tiles
+ *  starting at an aligned tile number plays with no VRAM writes at all.
+ *  One counter serves every sprite.
+ */
+/** @{ */
+
+/**
+ * Set the global auto-animation speed.
+ * @param speed Each frame lasts speed + 1 video frames (0-255)
+ */
+void NGSpriteAutoAnimSetSpeed(u8 speed);
+
+/**
+ * Start or stop the global auto-animation counter.
+ * Stopped tiles show the frame the counter was on.
+ * @param enable 1 = run (power-on state), 0 = freeze
+ */
+void NGSpriteAutoAnimEnable(u8 enable);
+/** @} */
+
 /** @name Combined High-Level Operations */
 /** @{ */
 
@@ -0,0 +1,120 @@
+/*
+ * This file is part of ProGearSDK.
+ * Copyright (c) 2024-2025 ProGearSDK contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+/**
+ * @file ng_vblank.h
+ * @brief Short jobs run inside the VBlank interrupt.
+ *
+ * Work that must write VRAM outside active display can be registered as a
+ * job and scheduled once per frame. The VBlank handler in crt0.s runs the
+ * scheduled jobs right after it has replayed the display list and
+ * uploaded palettes, before NGWaitVBlank() returns, so the main loop does
+ * not spend the start of VBlank waking up first.
+ *
+ * Jobs run in priority order. Before each one the handler reads the LSPC
+ * line counter, and a job that would not finish by the deadline stays
+ * scheduled for the next VBlank instead of spilling into the visible
+ * area; shorter jobs after it may still run. NGEngineFrameEnd() schedules
+ * the fix layer flush this way.
+ *
+ * Jobs run with the VBlank interrupt masked and must not wait for a
+ * VBlank themselves. Their data must not be changed by the main loop while
+ * they are scheduled: schedule a job after the frame's changes are made,
+ * or cancel it first.
+ *
+ * @code
+ * static NGVBlankJob scroll_job;
+ *
+ * scroll_job = NGVBlankJobAdd(upload_scroll, 1, 2);
+ *
+ * // Per frame, once the new scroll is ready
+ * NGVBlankJobSchedule(scroll_job);
+ * @endcode
+ */
+
+#ifndef NG_VBLANK_H
+#define NG_VBLANK_H
+
+#include <ng_types.h>
+#include <ng_interrupt.h>
+
+/**
+ * @defgroup vblank VBlank Jobs
+ * @ingroup hal
+ * @brief Priority-ordered callbacks in the VBlank interrupt.
+ * @{
+ */
+
+#define NG_VBLANK_JOBS       8     /**< Jobs that can be registered */
+#define NG_VBLANK_LINES      40    /**< Lines from the VBlank interrupt to the first visible line */
+#define NG_VBLANK_LINE_FIRST 0x1F0 /**< LSPC line counter when the VBlank interrupt fires */
+#define NG_VBLANK_NO_JOB     0xFF  /**< NGVBlankJobAdd() result when the table is full */
+
+/** Job handle */
+typedef u8 NGVBlankJob;
+
+/**
+ * Register a job.
+ * @param job Function to run
+ * @param priority Order among jobs, 0 first; equal priorities run in the
+ *                 order they were added
+ * @param lines Most lines the job takes, checked against the deadline
+ * @return Job handle, or NG_VBLANK_NO_JOB
+ */
+NGVBlankJob NGVBlankJobAdd(NGInterruptHandler job, u8 priority, u8 lines);
+
+/**
+ * Run a job at the next VBlank with time for it. Scheduling a job that is
+ * already scheduled does nothing.
+ * @param job Job handle
+ */
+void NGVBlankJobSchedule(NGVBlankJob job);
+
+/**
+ * Unschedule a job that has not run yet.
+ * @param job Job handle
+ */
+void NGVBlankJobCancel(NGVBlankJob job);
+
+/**
+ * @param job Job handle
+ * @return 1 if the job is scheduled and has not run yet
+ */
+u8 NGVBlankJobIsScheduled(NGVBlankJob job);
+
+/** Remove every job. */
+void NGVBlankJobsClear(void);
+
+/**
+ * Set the line, counted from the VBlank interrupt, by which jobs must have
+ * finished. Leave room for raster effects on the first visible lines.
+ * @param lines Lines after the interrupt (default NG_VBLANK_LINES)
+ */
+void NGVBlankSetDeadline(u8 lines);
+
+/**
+ * Run the scheduled jobs that fit before the deadline. Called by the
+ * VBlank interrupt.
+ */
+void NGVBlankRunJobs(void);
+
+/**
+ * VBlank interrupts so far, counted by the handler in crt0.s. Wraps at
+ * 65536; the difference between two reads is the VBlanks in between, so
+ * more than one per pass of the main loop means frames were dropped.
+ * @return Count
+ */
+u16 NGVBlankCount(void);
+
+/** Bit per job handle that is scheduled (read by crt0.s to skip the call) */
+extern volatile u8 ng_vblank_scheduled;
+
+/** VBlank interrupts so far (incremented by crt0.s) */
+extern volatile u16 ng_vblank_count;
+
+/** @} */ /* end of vblank group */
+
+#endif /* NG_VBLANK_H */
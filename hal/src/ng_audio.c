@@ -10,6 +10,11 @@
  *
  * Handles communication with Z80 audio driver for ADPCM playback.
  * Note: Spatial audio functions (NGActorPlaySfx) are in SDK, not HAL.
+ *
+ * Commands go through a ring buffer. One command is in flight at a time;
+ * the next is written as soon as a poll sees the Z80's acknowledgment.
+ * Polls happen on every queued command and once per NGAudioUpdate().
+ * When the queue is idle, NGAudioUpdate() asks for the busy channel mask.
  */
 
 #include <ng_audio.h>
@@ -40,10 +45,227 @@ static u8 master_volume = 15;
 static u8 channel_volumes[NG_AUDIO_MAX_CHANNELS] = {31, 31, 31, 31, 31, 31};
 static u8 music_volume = 255;
 
+/* Voice packet: CMD_VOICE then id_l, id_h, channel, pan | volume, priority */
+#define CMD_VOICE        0x33
+#define VOICE_PARAMS     5
+#define ACK_PARAM_BASE   0x40 /* Parameter n (1-5) is acknowledged with 0x40 + n */
+#define VOICE_BYTES      (1 + VOICE_PARAMS)
+#define MAX_VOLUME       31
+#define LEGACY_SFX_COUNT 32 /* Reachable with one-byte commands */
+
+/* Music queue packet: CMD_MUSIC_QUEUE then the track (0xFF cancels) */
+#define CMD_MUSIC_QUEUE   0x35
+#define MUSIC_QUEUE_BYTES 2
+
+/* FM sequencer: CMD_FM_PLAY packet then the song; stop/pause/resume are plain */
+#define CMD_FM_PLAY   0x36
+#define CMD_FM_STOP   0x37
+#define CMD_FM_PAUSE  0x38
+#define CMD_FM_RESUME 0x39
+#define FM_PLAY_BYTES 2
+
+static u8 current_fm_index = 0xFF;
+static u8 fm_paused = 0;
+
+/* Status query: answered with the busy channel mask (0x00-0x3F), not an echo */
+#define CMD_STATUS   0x34
+#define ACK_STATUS   0x00 /* Marks the entry; any reply below STATUS_LIMIT acknowledges it */
+#define STATUS_LIMIT 0x40
+
+static u8 busy_channels;
+
+/*
+ * Command queue, oldest first from queue_head. Each entry holds the byte
+ * to write (bits 0-7) and the reply that acknowledges it (bits 8-15).
+ * Commands expect cmd | 0x80, voice packet parameters a reply below 0x80,
+ * so a packet is one command entry followed by its parameter entries.
+ * A status query is a single entry below 0x80 as well.
+ */
+static u16 queue[NG_AUDIO_QUEUE_SIZE];
+static u8 queue_head;
+static u8 queue_count;
+static u16 dropped_count;
+
+/* Entry written to the Z80 and not yet acknowledged */
+static u8 in_flight;
+static u16 in_flight_entry;
+static u8 in_flight_frames;
+
+static u8 is_sfx_play(u8 cmd) {
+    u8 group = cmd & 0xF0;
+    return group == CMD_SFX_BASE || group == CMD_SFX_EXT_BASE || cmd >= CMD_SFX_LEFT_BASE;
+}
+
+static u16 command_entry(u8 cmd) {
+    return (u16)(((cmd | 0x80) << 8) | cmd);
+}
+
+static u16 queue_at(u8 i) {
+    return queue[(u8)((queue_head + i) % NG_AUDIO_QUEUE_SIZE)];
+}
+
+/* Entries from i to the next command (parameters of a packet already
+ * in flight are one entry each, and never start a command) */
+static u8 entry_len(u8 i) {
+    u16 e = queue_at(i);
+    if (e < 0x8000)
+        return 1;
+    if ((u8)e == CMD_VOICE)
+        return VOICE_BYTES;
+    if ((u8)e == CMD_FM_PLAY)
+        return FM_PLAY_BYTES;
+    return (u8)e == CMD_MUSIC_QUEUE ? MUSIC_QUEUE_BYTES : 1;
+}
+
+static u8 is_sfx_at(u8 i) {
+    u16 e = queue_at(i);
+    return e >= 0x8000 && (is_sfx_play((u8)e) || (u8)e == CMD_VOICE);
+}
+
+static void queue_remove(u8 i, u8 n) {
+    for (; i + n < queue_count; i++)
+        queue[(u8)((queue_head + i) % NG_AUDIO_QUEUE_SIZE)] = queue_at((u8)(i + n));
+    queue_count = (u8)(queue_count - n);
+}
+
+/* Queued SFX would only be cut off by a stop that is queued after them */
+static void drop_queued_sfx(void) {
+    u8 i = 0;
+    while (i < queue_count) {
+        if (is_sfx_at(i))
+            queue_remove(i, entry_len(i));
+        else
+            i = (u8)(i + entry_len(i));
+    }
+}
+
+static u8 acknowledged(void) {
+    u8 reply = NG_REG_SOUND;
+    if ((u8)(in_flight_entry >> 8) != ACK_STATUS)
+        return reply == (u8)(in_flight_entry >> 8);
+    /* Every other reply is 0x41 or above, so this one cannot be stale */
+    if (reply >= STATUS_LIMIT)
+        return 0;
+    busy_channels = reply;
+    return 1;
+}
+
+/* Retire the in-flight entry if acknowledged, then send the next one */
+static void pump(void) {
+    if (in_flight && acknowledged())
+        in_flight = 0;
+    if (in_flight || queue_count == 0)
+        return;
+
+    in_flight_entry = queue[queue_head];
+    queue_head = (u8)((queue_head + 1) % NG_AUDIO_QUEUE_SIZE);
+    queue_count--;
+    in_flight = 1;
+    in_flight_frames = 0;
+    NG_REG_SOUND = (u8)in_flight_entry;
+}
+
+static u8 same_as_queued(u8 i, const u16 *entries, u8 n) {
+    if (entry_len(i) != n)
+        return 0;
+    for (u8 k = 0; k < n; k++) {
+        if (queue_at((u8)(i + k)) != entries[k])
+            return 0;
+    }
+    return 1;
+}
+
+/* Queue one command: a single entry, or a whole voice packet */
+static void queue_entries(const u16 *entries, u8 n) {
+    u8 sfx = is_sfx_play((u8)entries[0]) || (u8)entries[0] == CMD_VOICE;
+    u8 i;
+
+    if (sfx) {
+        /* Coalesce: the same sound starting twice at once only sounds louder */
+        if (n == 1 && in_flight && in_flight_entry == entries[0])
+            return;
+        for (i = 0; i < queue_count; i = (u8)(i + entry_len(i))) {
+            if (same_as_queued(i, entries, n))
+                return;
+        }
+    }
+
+    while (queue_count + n > NG_AUDIO_QUEUE_SIZE) {
+        /* Overflow: SFX are dropped, anything else evicts the oldest SFX */
+        u8 victim = queue_count;
+        if (!sfx) {
+            for (i = 0; i < queue_count; i = (u8)(i + entry_len(i))) {
+                if (is_sfx_at(i)) {
+                    victim = i;
+                    break;
+                }
+            }
+        }
+        dropped_count++;
+        if (victim == queue_count)
+            return;
+        queue_remove(victim, entry_len(victim));
+    }
+
+    for (i = 0; i < n; i++)
+        queue[(u8)((queue_head + queue_count + i) % NG_AUDIO_QUEUE_SIZE)] = entries[i];
+    queue_count = (u8)(queue_count + n);
+    pump();
+}
+
+static void queue_command(u8 cmd) {
+    u16 entry = command_entry(cmd);
+    queue_entries(&entry, 1);
+}
+
+void NGAudioUpdate(void) {
+    /* A Z80 that never answers must not stall the queue */
+    if (in_flight && ++in_flight_frames >= NG_AUDIO_ACK_TIMEOUT)
+        in_flight = 0;
+    pump();
+#if NG_AUDIO_STATUS_POLL
+    if (!in_flight && queue_count == 0) {
+        u16 entry = (u16)((ACK_STATUS << 8) | CMD_STATUS);
+        queue_entries(&entry, 1);
+    }
+#endif
+}
+
+void NGAudioFlush(void) {
+    while (in_flight || queue_count) {
+        u16 timeout = 0xFFFF;
+        while (in_flight && !acknowledged() && --timeout)
+            ;
+        in_flight = 0;
+        pump();
+    }
+}
+
+u8 NGAudioGetQueuedCount(void) {
+    return (u8)(queue_count + in_flight);
+}
+
+u16 NGAudioGetDroppedCount(void) {
+    return dropped_count;
+}
+
+u8 NGSfxGetBusyChannels(void) {
+    return busy_channels;
+}
+
+u8 NGSfxIsChannelBusy(u8 channel) {
+    if (channel >= NG_AUDIO_MAX_CHANNELS)
+        return 0;
+    return (busy_channels >> channel) & 1;
+}
+
 void NGAudioSendCommand(u8 cmd) {
     u8 reply;
     u16 timeout;
 
+    /* Keep commands in order with anything queued before this one */
+    NGAudioFlush();
+
     NG_REG_SOUND = cmd;
 
     // Wait for Z80 acknowledgment (echoes command with bit 7 set)
@@ -59,10 +281,35 @@ void NGAudioSendCommandAsync(u8 cmd) {
 }
 
 void NGAudioInit(void) {
+    queue_head = 0;
+    queue_count = 0;
+    dropped_count = 0;
+    in_flight = 0;
+    busy_channels = 0;
     NGAudioSendCommand(CMD_RESET);
     master_volume = 15;
     NGAudioSetVolume(master_volume);
     current_music_index = 0xFF;
+    current_fm_index = 0xFF;
+    fm_paused = 0;
+}
+
+void NGSfxPlayVoice(u16 sfx_index, u8 channel, NGPan pan, u8 volume, u8 priority) {
+    if (sfx_index >= NG_AUDIO_MAX_SFX)
+        return;
+    if (channel >= NG_AUDIO_MAX_CHANNELS)
+        channel = NG_AUDIO_CHANNEL_AUTO;
+    if (volume > MAX_VOLUME)
+        volume = MAX_VOLUME;
+
+    u8 bytes[VOICE_BYTES] = {
+        CMD_VOICE, (u8)sfx_index, (u8)(sfx_index >> 8), channel, (u8)(pan | volume), priority,
+    };
+    u16 entries[VOICE_BYTES];
+    entries[0] = command_entry(CMD_VOICE);
+    for (u8 i = 1; i < VOICE_BYTES; i++)
+        entries[i] = (u16)(((ACK_PARAM_BASE + i) << 8) | bytes[i]);
+    queue_entries(entries, VOICE_BYTES);
 }
 
 void NGSfxPlay(u8 sfx_index) {
@@ -70,15 +317,21 @@ void NGSfxPlay(u8 sfx_index) {
         return;
 
     if (sfx_index < 16) {
-        NGAudioSendCommand(CMD_SFX_BASE + sfx_index);
+        queue_command(CMD_SFX_BASE + sfx_index);
+    } else if (sfx_index < LEGACY_SFX_COUNT) {
+        queue_command(CMD_SFX_EXT_BASE + (sfx_index - 16));
     } else {
-        NGAudioSendCommand(CMD_SFX_EXT_BASE + (sfx_index - 16));
+        NGSfxPlayVoice(sfx_index, NG_AUDIO_CHANNEL_AUTO, NG_PAN_CENTER, MAX_VOLUME, 0);
     }
 }
 
 void NGSfxPlayPan(u8 sfx_index, NGPan pan) {
     if (sfx_index >= NG_AUDIO_MAX_SFX)
         return;
+    if (sfx_index >= LEGACY_SFX_COUNT) {
+        NGSfxPlayVoice(sfx_index, NG_AUDIO_CHANNEL_AUTO, pan, MAX_VOLUME, 0);
+        return;
+    }
 
     u8 cmd;
     if (sfx_index < 16) {
@@ -107,19 +360,20 @@ void NGSfxPlayPan(u8 sfx_index, NGPan pan) {
                 break;
         }
     }
-    NGAudioSendCommand(cmd);
+    queue_command(cmd);
 }
 
 void NGSfxStopChannel(u8 channel) {
     if (channel >= NG_AUDIO_MAX_CHANNELS)
         return;
-    NGAudioSendCommand(CMD_SFX_STOP_CH + channel);
+    queue_command(CMD_SFX_STOP_CH + channel);
 }
 
 void NGSfxStopAll(void) {
     u8 i;
+    drop_queued_sfx();
     for (i = 0; i < NG_AUDIO_MAX_CHANNELS; i++) {
-        NGAudioSendCommand(CMD_SFX_STOP_CH + i);
+        queue_command(CMD_SFX_STOP_CH + i);
     }
 }
 
@@ -131,28 +385,39 @@ void NGMusicPlay(u8 music_index) {
     music_paused = 0;
 
     if (music_index < 16) {
-        NGAudioSendCommand(CMD_MUSIC_BASE + music_index);
+        queue_command(CMD_MUSIC_BASE + music_index);
     } else {
-        NGAudioSendCommand(CMD_MUSIC_EXT_BASE + (music_index - 16));
+        queue_command(CMD_MUSIC_EXT_BASE + (music_index - 16));
     }
 }
 
+void NGMusicQueue(u8 music_index) {
+    if (music_index >= NG_AUDIO_MAX_MUSIC)
+        music_index = NG_AUDIO_MUSIC_NONE;
+
+    u16 entries[MUSIC_QUEUE_BYTES] = {
+        command_entry(CMD_MUSIC_QUEUE),
+        (u16)(((ACK_PARAM_BASE + 1) << 8) | music_index),
+    };
+    queue_entries(entries, MUSIC_QUEUE_BYTES);
+}
+
 void NGMusicStop(void) {
-    NGAudioSendCommand(CMD_MUSIC_STOP);
+    queue_command(CMD_MUSIC_STOP);
     current_music_index = 0xFF;
     music_paused = 0;
 }
 
 void NGMusicPause(void) {
     if (current_music_index != 0xFF && !music_paused) {
-        NGAudioSendCommand(CMD_MUSIC_PAUSE);
+        queue_command(CMD_MUSIC_PAUSE);
         music_paused = 1;
     }
 }
 
 void NGMusicResume(void) {
     if (music_paused) {
-        NGAudioSendCommand(CMD_MUSIC_RESUME);
+        queue_command(CMD_MUSIC_RESUME);
         music_paused = 0;
     }
 }
@@ -165,16 +430,65 @@ u8 NGMusicIsPaused(void) {
     return music_paused;
 }
 
+void NGFMPlay(u8 fm_index) {
+    if (fm_index >= NG_AUDIO_MAX_FM)
+        return;
+
+    current_fm_index = fm_index;
+    fm_paused = 0;
+
+    u16 entries[FM_PLAY_BYTES] = {
+        command_entry(CMD_FM_PLAY),
+        (u16)(((ACK_PARAM_BASE + 1) << 8) | fm_index),
+    };
+    queue_entries(entries, FM_PLAY_BYTES);
+}
+
+void NGFMStop(void) {
+    queue_command(CMD_FM_STOP);
+    current_fm_index = 0xFF;
+    fm_paused = 0;
+}
+
+void NGFMPause(void) {
+    if (current_fm_index != 0xFF && !fm_paused) {
+        queue_command(CMD_FM_PAUSE);
+        fm_paused = 1;
+    }
+}
+
+void NGFMResume(void) {
+    if (fm_paused) {
+        queue_command(CMD_FM_RESUME);
+        fm_paused = 0;
+    }
+}
+
+u8 NGFMIsPlaying(void) {
+    return (current_fm_index != 0xFF && !fm_paused) ? 1 : 0;
+}
+
+u8 NGFMIsPaused(void) {
+    return fm_paused;
+}
+
+u8 NGFMGetCurrent(void) {
+    return current_fm_index;
+}
+
 void NGAudioSetVolume(u8 volume) {
     if (volume > 15)
         volume = 15;
     master_volume = volume;
-    NGAudioSendCommand(CMD_VOLUME_BASE + volume);
+    queue_command(CMD_VOLUME_BASE + volume);
 }
 
 void NGAudioStopAll(void) {
-    NGAudioSendCommand(CMD_STOP_ALL);
+    drop_queued_sfx();
+    queue_command(CMD_STOP_ALL);
     current_music_index = 0xFF;
+    current_fm_index = 0xFF;
+    fm_paused = 0;
 }
 
 u8 NGAudioGetCurrentMusic(void) {
@@ -198,7 +512,7 @@ void NGSfxSetChannelVolume(u8 channel, u8 volume) {
      * The volume is stored here for tracking. A future Z80 driver update
      * could add commands 0x66-0x6B for per-channel volume.
      *
-     * For now, this affects the next SFX played on this channel.
+     * To play a sound at a given volume, use NGSfxPlayVoice().
      */
 }
 
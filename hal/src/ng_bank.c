@@ -0,0 +1,18 @@
+/*
+ * This file is part of ProGearSDK.
+ * Copyright (c) 2024-2025 ProGearSDK contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+/**
+ * @file ng_bank.c
+ * @brief P-ROM bank cache
+ *
+ * NGBankSelect() is inline; this only holds the cached bank number. The
+ * register is write-only, so the cache starts unknown and the first
+ * select always writes it.
+ */
+
+#include <ng_bank.h>
+
+u8 ng_bank_current = NG_BANK_FIXED;
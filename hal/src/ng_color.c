@@ -72,6 +72,98 @@ NGColor NGColorAdjustBrightness(NGColor c, s8 amount) {
     return NG_RGB(r, g, b);
 }
 
+/* Array operations. A color's channels are unpacked once, mapped through
+ * a table built for the call and packed back through the tables below. */
+
+#define LEVELS 32
+
+#define LEVEL_LIST(F)                                                                       \
+    F(0), F(1), F(2), F(3), F(4), F(5), F(6), F(7), F(8), F(9), F(10), F(11), F(12), F(13), \
+        F(14), F(15), F(16), F(17), F(18), F(19), F(20), F(21), F(22), F(23), F(24), F(25), \
+        F(26), F(27), F(28), F(29), F(30), F(31)
+
+#define PACK_R(v) NG_RGB(v, 0, 0)
+#define PACK_G(v) NG_RGB(0, v, 0)
+#define PACK_B(v) NG_RGB(0, 0, v)
+
+static const u16 pack_r[LEVELS] = {LEVEL_LIST(PACK_R)};
+static const u16 pack_g[LEVELS] = {LEVEL_LIST(PACK_G)};
+static const u16 pack_b[LEVELS] = {LEVEL_LIST(PACK_B)};
+
+void NGColorBlendArray(NGColor *colors, u16 count, NGColor target, u8 ratio) {
+    if (ratio == 0)
+        return;
+    if (ratio == 255) {
+        while (count--)
+            *colors++ = target;
+        return;
+    }
+
+    /* level * (255 - ratio), built by adding so no multiply per entry */
+    u16 scaled[LEVELS];
+    u8 inv_ratio = 255 - ratio;
+    u16 acc = 0;
+    for (u8 v = 0; v < LEVELS; v++, acc += inv_ratio)
+        scaled[v] = acc;
+
+    u16 bias_r = (u16)(NGColorGetRed(target) * ratio + 128);
+    u16 bias_g = (u16)(NGColorGetGreen(target) * ratio + 128);
+    u16 bias_b = (u16)(NGColorGetBlue(target) * ratio + 128);
+
+    while (count--) {
+        NGColor c = *colors;
+        *colors++ = pack_r[(scaled[NGColorGetRed(c)] + bias_r) >> 8] |
+                    pack_g[(scaled[NGColorGetGreen(c)] + bias_g) >> 8] |
+                    pack_b[(scaled[NGColorGetBlue(c)] + bias_b) >> 8];
+    }
+}
+
+void NGColorCrossfadeArray(NGColor *dst, const NGColor *a, const NGColor *b, u16 count, u8 ratio) {
+    if (ratio == 0 || ratio == 255) {
+        const NGColor *src = ratio ? b : a;
+        if (dst != src) {
+            while (count--)
+                *dst++ = *src++;
+        }
+        return;
+    }
+
+    /* level * (255 - ratio) + 128 and level * ratio */
+    u16 scaled_a[LEVELS];
+    u16 scaled_b[LEVELS];
+    u8 inv_ratio = 255 - ratio;
+    u16 acc_a = 128;
+    u16 acc_b = 0;
+    for (u8 v = 0; v < LEVELS; v++, acc_a += inv_ratio, acc_b += ratio) {
+        scaled_a[v] = acc_a;
+        scaled_b[v] = acc_b;
+    }
+
+    while (count--) {
+        NGColor ca = *a++;
+        NGColor cb = *b++;
+        *dst++ = pack_r[(scaled_a[NGColorGetRed(ca)] + scaled_b[NGColorGetRed(cb)]) >> 8] |
+                 pack_g[(scaled_a[NGColorGetGreen(ca)] + scaled_b[NGColorGetGreen(cb)]) >> 8] |
+                 pack_b[(scaled_a[NGColorGetBlue(ca)] + scaled_b[NGColorGetBlue(cb)]) >> 8];
+    }
+}
+
+void NGColorAdjustBrightnessArray(NGColor *colors, u16 count, s8 amount) {
+    s8 step = amount > 31 ? 31 : (amount < -31 ? -31 : amount);
+
+    u8 level[LEVELS];
+    for (s8 v = 0; v < LEVELS; v++) {
+        s8 out = (s8)(v + step);
+        level[v] = (u8)(out < 0 ? 0 : (out > 31 ? 31 : out));
+    }
+
+    while (count--) {
+        NGColor c = *colors;
+        *colors++ = pack_r[level[NGColorGetRed(c)]] | pack_g[level[NGColorGetGreen(c)]] |
+                    pack_b[level[NGColorGetBlue(c)]];
+    }
+}
+
 NGColor NGColorFromHSV(u8 h, u8 s, u8 v) {
     if (s == 0) {
         u8 gray = v >> 3;
@@ -0,0 +1,135 @@
+/*
+ * This file is part of ProGearSDK.
+ * Copyright (c) 2024-2025 ProGearSDK contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+/**
+ * @file ng_display_list.c
+ * @brief Deferred VRAM command buffer.
+ *
+ * Recording side of the display list. Replay lives in the _vblank
+ * handler in crt0.s so it runs before any user VBlank callback.
+ */
+
+#include <ng_display_list.h>
+
+NGDisplayList ng_display_list;
+
+/* Read and cleared by the VBlank handler in crt0.s */
+u16 *volatile ng_display_list_pending = 0;
+
+static u16 *list_base;
+
+/* Words needed for a run header (count, addr, mod) */
+#define RUN_HEADER_WORDS 3
+
+/* Close the open copy run. Returns the VRAM address following it. */
+static u16 close_run(void) {
+    NGDisplayList *dl = &ng_display_list;
+    u16 next_addr = dl->run_addr;
+
+    if (dl->run) {
+        u16 count = (u16)(dl->cursor - dl->run - RUN_HEADER_WORDS);
+        if (count == 0) {
+            dl->cursor = dl->run; /* Drop empty run */
+        } else {
+            dl->run[0] = count;
+            next_addr = (u16)(dl->run_addr + count * dl->run_mod);
+        }
+        dl->run = 0;
+    }
+    return next_addr;
+}
+
+/* Reserve space for a header. On failure, the list is marked full. */
+static u8 reserve(u16 words) {
+    NGDisplayList *dl = &ng_display_list;
+    if (dl->cursor + words > dl->limit) {
+        dl->overflows += words;
+        dl->limit = dl->cursor;
+        return 0;
+    }
+    return 1;
+}
+
+u8 NGDisplayListBegin(NGArena *arena, u16 capacity) {
+    NGDisplayList *dl = &ng_display_list;
+
+    /* A list still pending here would be overwritten by the new buffer */
+    ng_display_list_pending = 0;
+
+    dl->cursor = 0;
+    dl->run = 0;
+    dl->overflows = 0;
+
+    if (capacity < RUN_HEADER_WORDS + 2)
+        return 0;
+
+    list_base = NG_ARENA_ALLOC_ARRAY(arena, u16, capacity);
+    if (!list_base)
+        return 0;
+
+    dl->cursor = list_base;
+    dl->limit = list_base + capacity - 1; /* Keep room for the terminator */
+    return 1;
+}
+
+void NGDisplayListSubmit(void) {
+    NGDisplayList *dl = &ng_display_list;
+    if (!dl->cursor)
+        return;
+
+    close_run();
+    *dl->cursor = 0;
+    dl->cursor = 0;
+
+    ng_display_list_pending = list_base;
+}
+
+u16 NGDisplayListGetOverflows(void) {
+    return ng_display_list.overflows;
+}
+
+void NGDisplayListRun(u16 addr, u16 mod) {
+    NGDisplayList *dl = &ng_display_list;
+
+    close_run();
+    if (!reserve(RUN_HEADER_WORDS))
+        return;
+
+    (void)NG_VRAM_COUNT_SETUP(addr);
+    dl->run = dl->cursor;
+    dl->run_addr = addr;
+    dl->run_mod = mod;
+    dl->cursor[1] = addr;
+    dl->cursor[2] = mod;
+    dl->cursor += RUN_HEADER_WORDS;
+}
+
+void NGDisplayListFill(u16 addr, u16 mod, u16 value, u16 count) {
+    NGDisplayList *dl = &ng_display_list;
+
+    close_run();
+    if (count == 0)
+        return;
+    if (!reserve(RUN_HEADER_WORDS + 1))
+        return;
+
+    (void)NG_VRAM_COUNT_SETUP(addr);
+    NG_VRAM_COUNT_WORDS(count);
+    dl->cursor[0] = (u16)(count | NG_DISPLAY_LIST_FILL);
+    dl->cursor[1] = addr;
+    dl->cursor[2] = mod;
+    dl->cursor[3] = value;
+    dl->cursor += RUN_HEADER_WORDS + 1;
+
+    /* Later FillNext calls continue after this run */
+    dl->run_addr = (u16)(addr + count * mod);
+    dl->run_mod = mod;
+}
+
+void NGDisplayListFillNext(u16 value, u16 count) {
+    u16 addr = close_run();
+    NGDisplayListFill(addr, ng_display_list.run_mod, value, count);
+}
@@ -4,39 +4,66 @@
  * SPDX-License-Identifier: MIT
  */
 
+/**
+ * @file ng_fix.c
+ * @brief Fix layer shadow and text rendering.
+ *
+ * The shadow is row-major so a row's dirty span is contiguous in RAM; in
+ * VRAM it is one column stride (VRAMMOD 32) apart, so each span is one
+ * address setup however long it is.
+ */
+
 #include <ng_fix.h>
 #include <ng_hardware.h>
 #include <stdarg.h>
 
 static u16 font_base = 0;
 
+static u16 shadow[NG_FIX_HEIGHT][NG_FIX_WIDTH];
+
+/* Changed cells of row y are dirty_lo[y]..dirty_hi[y], valid when bit y is set */
+static u32 dirty_rows;
+static u8 dirty_lo[NG_FIX_HEIGHT];
+static u8 dirty_hi[NG_FIX_HEIGHT];
+
+static void put_cell(u8 x, u8 y, u16 value) {
+    if (shadow[y][x] == value)
+        return;
+    shadow[y][x] = value;
+
+    u32 bit = (u32)1 << y;
+    if (!(dirty_rows & bit)) {
+        dirty_rows |= bit;
+        dirty_lo[y] = x;
+        dirty_hi[y] = x;
+    } else if (x < dirty_lo[y]) {
+        dirty_lo[y] = x;
+    } else if (x > dirty_hi[y]) {
+        dirty_hi[y] = x;
+    }
+}
+
 void NGFixPut(u8 x, u8 y, u16 tile, u8 palette) {
     if (x >= NG_FIX_WIDTH || y >= NG_FIX_HEIGHT)
         return;
+    put_cell(x, y, (u16)(((u16)palette << 12) | (tile & 0x0FFF)));
+}
 
-    /* Use optimized indexed addressing for VRAM access.
-     * "move.w X,d(An)" is faster than "move.w X,xxx.L" */
-    NG_VRAM_DECLARE_BASE();
-
-    /* Fix layer is column-major: address = base + (x * 32) + y */
-    NG_VRAM_SET_ADDR_FAST(NG_FIX_VRAM + (x << 5) + y);
-    NG_VRAM_WRITE_FAST(((u16)palette << 12) | (tile & 0x0FFF));
+u16 NGFixGet(u8 x, u8 y) {
+    if (x >= NG_FIX_WIDTH || y >= NG_FIX_HEIGHT)
+        return 0;
+    return shadow[y][x];
 }
 
 void NGFixClear(u8 x, u8 y, u8 w, u8 h) {
-    NG_VRAM_DECLARE_BASE();
+    if (x >= NG_FIX_WIDTH)
+        return;
+    u8 end = (x + w > NG_FIX_WIDTH) ? NG_FIX_WIDTH : (u8)(x + w);
 
     for (u8 row = 0; row < h && (y + row) < NG_FIX_HEIGHT; row++) {
-        NG_VRAM_SETUP_FAST(NG_FIX_VRAM + (x << 5) + (y + row), 32);
-        /* Use optimized DBF loop for clearing columns */
-        if (w > 0) {
-            u8 count = w;
-            if ((x + w) > NG_FIX_WIDTH)
-                count = NG_FIX_WIDTH - x;
-            NG_VRAM_CLEAR_FAST(count);
-        }
+        for (u8 col = x; col < end; col++)
+            put_cell(col, (u8)(y + row), 0);
     }
-    NG_VRAM_SET_MOD_FAST(1);
 }
 
 void NGFixClearAll(void) {
@@ -46,6 +73,40 @@ void NGFixClearAll(void) {
     NG_VRAM_DECLARE_BASE();
     NG_VRAM_SETUP_FAST(NG_FIX_VRAM, 1);
     NG_VRAM_CLEAR_FAST(NG_FIX_WIDTH * NG_FIX_HEIGHT);
+
+    /* VRAM now matches an empty shadow; unflushed writes are moot */
+    for (u8 y = 0; y < NG_FIX_HEIGHT; y++) {
+        for (u8 x = 0; x < NG_FIX_WIDTH; x++)
+            shadow[y][x] = 0;
+    }
+    dirty_rows = 0;
+}
+
+void NGFixFlush(void) {
+    if (!dirty_rows)
+        return;
+
+    NG_VRAM_DECLARE_BASE();
+    NG_VRAM_SET_MOD_FAST(32);
+
+    u32 rows = dirty_rows;
+    for (u8 y = 0; rows; y++, rows >>= 1) {
+        if (!(rows & 1))
+            continue;
+        u8 x = dirty_lo[y];
+        const u16 *src = &shadow[y][x];
+        /* Fix layer is column-major: address = base + (x * 32) + y */
+        NG_VRAM_SET_ADDR_FAST(NG_FIX_VRAM + (x << 5) + y);
+        for (; x <= dirty_hi[y]; x++)
+            NG_VRAM_WRITE_FAST(*src++);
+    }
+    dirty_rows = 0;
+
+    NG_VRAM_SET_MOD_FAST(1);
+}
+
+u8 NGFixIsDirty(void) {
+    return dirty_rows != 0;
 }
 
 NGFixLayout NGFixLayoutAlign(NGFixHAlign h, NGFixVAlign v) {
@@ -62,6 +123,10 @@ void NGTextSetFont(u16 font_base_tile) {
     font_base = font_base_tile;
 }
 
+u16 NGTextGetFont(void) {
+    return font_base;
+}
+
 static u8 str_len(const char *str) {
     u8 len = 0;
     while (*str++)
@@ -120,19 +185,12 @@ void NGTextPrint(NGFixLayout layout, u8 palette, const char *str) {
 
     u16 pal = (u16)palette << 12;
 
-    /* Use optimized indexed addressing for faster VRAM writes.
-     * Fix layer is column-major, VRAMMOD = 32 advances one column per write. */
-    NG_VRAM_DECLARE_BASE();
-    NG_VRAM_SETUP_FAST(NG_FIX_VRAM + (x << 5) + y, 32);
-
     while (*str && x < NG_FIX_WIDTH) {
         u8 c = (u8)*str++;
         u16 tile = font_base + c;
-        NG_VRAM_WRITE_FAST(pal | tile);
+        put_cell(x, y, pal | tile);
         x++;
     }
-
-    NG_VRAM_SET_MOD_FAST(1);
 }
 
 static u8 int_to_str(s32 value, char *buf, u8 base, u8 is_signed) {
@@ -252,3 +310,167 @@ void NGTextPrintf(NGFixLayout layout, u8 palette, const char *fmt, ...) {
 
     NGTextPrint(layout, palette, buf);
 }
+
+/* ============================================================================
+ * Counters
+ * ========================================================================== */
+
+#if defined(NG_MOCK_HAL) || defined(__CPPCHECK__)
+static u32 bcd_add(u32 a, u32 b, u8 *carry) {
+    u32 r = 0;
+    u8 cy = 0;
+    for (u8 i = 0; i < 32; i += 4) {
+        u8 d = (u8)(((a >> i) & 15) + ((b >> i) & 15) + cy);
+        cy = d > 9;
+        if (cy)
+            d = (u8)(d - 10);
+        r |= (u32)d << i;
+    }
+    *carry = cy;
+    return r;
+}
+
+static u32 bcd_sub(u32 a, u32 b, u8 *borrow) {
+    u32 r = 0;
+    u8 bw = 0;
+    for (u8 i = 0; i < 32; i += 4) {
+        s8 d = (s8)((s8)((a >> i) & 15) - (s8)((b >> i) & 15) - (s8)bw);
+        bw = d < 0;
+        if (bw)
+            d = (s8)(d + 10);
+        r |= (u32)d << i;
+    }
+    *borrow = bw;
+    return r;
+}
+#else
+/* One ABCD/SBCD per byte, lowest first; ROR and MOVEQ leave the X (carry) flag alone */
+static u32 bcd_add(u32 a, u32 b, u8 *carry) {
+    u8 x;
+    __asm__("sub.b   %2, %2\n\t" /* Clears X */
+            "abcd    %1, %0\n\t"
+            "ror.l   #8, %0\n\t"
+            "ror.l   #8, %1\n\t"
+            "abcd    %1, %0\n\t"
+            "ror.l   #8, %0\n\t"
+            "ror.l   #8, %1\n\t"
+            "abcd    %1, %0\n\t"
+            "ror.l   #8, %0\n\t"
+            "ror.l   #8, %1\n\t"
+            "abcd    %1, %0\n\t"
+            "ror.l   #8, %0\n\t"
+            "moveq   #0, %2\n\t"
+            "addx.b  %2, %2"
+            : "+d"(a), "+d"(b), "=&d"(x)
+            :
+            : "cc");
+    *carry = x;
+    return a;
+}
+
+static u32 bcd_sub(u32 a, u32 b, u8 *borrow) {
+    u8 x;
+    __asm__("sub.b   %2, %2\n\t" /* Clears X */
+            "sbcd    %1, %0\n\t"
+            "ror.l   #8, %0\n\t"
+            "ror.l   #8, %1\n\t"
+            "sbcd    %1, %0\n\t"
+            "ror.l   #8, %0\n\t"
+            "ror.l   #8, %1\n\t"
+            "sbcd    %1, %0\n\t"
+            "ror.l   #8, %0\n\t"
+            "ror.l   #8, %1\n\t"
+            "sbcd    %1, %0\n\t"
+            "ror.l   #8, %0\n\t"
+            "moveq   #0, %2\n\t"
+            "addx.b  %2, %2"
+            : "+d"(a), "+d"(b), "=&d"(x)
+            :
+            : "cc");
+    *borrow = x;
+    return a;
+}
+#endif
+
+/* Largest packed BCD value that fits in the counter */
+static u32 counter_max(const NGFixCounter *c) {
+    return 0x99999999u >> ((NG_FIX_COUNTER_MAX_DIGITS - c->digits) * 4);
+}
+
+/* Digit i (0 = least significant) of a value as drawn */
+static u16 counter_tile(const NGFixCounter *c, u32 bcd, u8 i) {
+    u32 upper = bcd >> (i * 4);
+    if (!c->zero_pad && i > 0 && upper == 0)
+        return (u16)(font_base + ' ');
+    return (u16)(font_base + '0' + (upper & 15));
+}
+
+static void counter_draw(NGFixCounter *c, u8 force) {
+    u8 x = (u8)(c->x + c->digits - 1);
+
+    for (u8 i = 0; i < c->digits; i++, x--) {
+        u16 tile = counter_tile(c, c->value, i);
+        if (force || tile != counter_tile(c, c->shown, i))
+            NGFixPut(x, c->y, tile, c->palette);
+    }
+    c->shown = c->value;
+}
+
+void NGFixCounterInit(NGFixCounter *c, u8 x, u8 y, u8 digits, u8 palette, u8 zero_pad) {
+    if (digits == 0)
+        digits = 1;
+    if (digits > NG_FIX_COUNTER_MAX_DIGITS)
+        digits = NG_FIX_COUNTER_MAX_DIGITS;
+    c->value = 0;
+    c->shown = 0;
+    c->x = x;
+    c->y = y;
+    c->digits = digits;
+    c->palette = palette;
+    c->zero_pad = zero_pad ? 1 : 0;
+    counter_draw(c, 1);
+}
+
+void NGFixCounterSetBCD(NGFixCounter *c, u32 bcd) {
+    c->value = bcd > counter_max(c) ? counter_max(c) : bcd;
+    counter_draw(c, 0);
+}
+
+void NGFixCounterSet(NGFixCounter *c, u32 value) {
+    if (value > 99999999u) {
+        NGFixCounterSetBCD(c, 0x99999999u);
+        return;
+    }
+    /* Double dabble: before each shift, add 3 to every digit of 5 or more */
+    u32 bcd = 0;
+    for (u8 bit = 32; bit-- > 0;) {
+        u32 adjust = ((bcd + 0x33333333u) & 0x88888888u) >> 3;
+        bcd += (adjust << 1) + adjust;
+        bcd = (bcd << 1) | ((value >> bit) & 1);
+    }
+    NGFixCounterSetBCD(c, bcd);
+}
+
+void NGFixCounterAdd(NGFixCounter *c, u32 bcd) {
+    u8 carry;
+    u32 sum = bcd_add(c->value, bcd, &carry);
+    NGFixCounterSetBCD(c, carry ? 0x99999999u : sum);
+}
+
+u8 NGFixCounterSub(NGFixCounter *c, u32 bcd) {
+    u8 borrow;
+    u32 diff = bcd_sub(c->value, bcd, &borrow);
+    NGFixCounterSetBCD(c, borrow ? 0 : diff);
+    return c->value == 0;
+}
+
+u32 NGFixCounterGet(const NGFixCounter *c) {
+    u32 value = 0;
+    for (s8 shift = 28; shift >= 0; shift = (s8)(shift - 4))
+        value = (value << 3) + (value << 1) + ((c->value >> shift) & 15);
+    return value;
+}
+
+void NGFixCounterRedraw(NGFixCounter *c) {
+    counter_draw(c, 1);
+}
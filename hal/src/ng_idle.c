@@ -0,0 +1,103 @@
+/*
+ * This file is part of ProGearSDK.
+ * Copyright (c) 2024-2025 ProGearSDK contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+/**
+ * @file ng_idle.c
+ * @brief Idle job scheduler implementation
+ */
+
+#include <ng_idle.h>
+#include <ng_hardware.h>
+#include <ng_vblank.h>
+
+static NGIdleSlice jobs[NG_IDLE_JOBS];
+static u8 job_priority[NG_IDLE_JOBS];
+static u8 job_lines[NG_IDLE_JOBS];
+static u8 job_count;
+
+/* Handles in the order they run */
+static u8 order[NG_IDLE_JOBS];
+
+static u8 margin = NG_IDLE_MARGIN;
+
+/* ============================================================================
+ * Registration
+ * ========================================================================== */
+
+NGIdleJob NGIdleJobAdd(NGIdleSlice slice, u8 priority, u8 lines) {
+    if (job_count >= NG_IDLE_JOBS)
+        return NG_IDLE_NO_JOB;
+
+    u8 handle = job_count++;
+    jobs[handle] = slice;
+    job_priority[handle] = priority;
+    job_lines[handle] = lines ? lines : 1; /* Every slice costs time */
+
+    /* Insert after the jobs of equal or lower priority value */
+    u8 i = handle;
+    while (i > 0 && job_priority[order[i - 1]] > priority) {
+        order[i] = order[i - 1];
+        i--;
+    }
+    order[i] = handle;
+    return handle;
+}
+
+void NGIdleJobsClear(void) {
+    job_count = 0;
+}
+
+void NGIdleSetMargin(u8 lines) {
+    margin = lines;
+}
+
+/* ============================================================================
+ * Running
+ * ========================================================================== */
+
+/* Lines before the VBlank interrupt, less the margin. The LSPC counter
+ * runs 0xF8-0x1FF; once the interrupt has set the BIOS flag, the counter
+ * is already in the next frame. */
+static u16 lines_left(void) {
+    if (NG_BIOS_VBLANK_FLAG)
+        return 0;
+    u16 line = (u16)(NG_REG_LSPCMODE >> 7);
+    if (line + margin >= NG_VBLANK_LINE_FIRST)
+        return 0;
+    return (u16)(NG_VBLANK_LINE_FIRST - margin - line);
+}
+
+u8 NGIdleRun(void) {
+    u8 pending = (u8)((1u << job_count) - 1);
+    u16 budget = lines_left();
+    u8 slices = 0;
+
+    while (pending) {
+        u16 left = lines_left();
+        if (left > budget)
+            left = budget; /* Slices so far took less than they may */
+
+        u8 handle = NG_IDLE_NO_JOB;
+        for (u8 i = 0; i < job_count; i++) {
+            u8 h = order[i];
+            if ((pending & (1 << h)) && job_lines[h] <= left) {
+                handle = h;
+                break;
+            }
+        }
+        if (handle == NG_IDLE_NO_JOB)
+            break;
+
+        /* A job's last slice may have found nothing to do; the counter
+         * still shows what it took */
+        if (jobs[handle]())
+            budget = (u16)(budget - job_lines[handle]);
+        else
+            pending &= (u8) ~(1 << handle);
+        slices++;
+    }
+    return slices;
+}
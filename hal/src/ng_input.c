@@ -6,6 +6,7 @@
 
 #include <ng_input.h>
 #include <ng_hardware.h>
+#include <ng_sram.h>
 
 typedef struct {
     u16 current;
@@ -30,6 +31,47 @@ typedef struct {
 
 static SystemState g_system;
 
+#if NG_INPUT_HISTORY_SIZE & (NG_INPUT_HISTORY_SIZE - 1) || NG_INPUT_HISTORY_SIZE > 128
+#error "NG_INPUT_HISTORY_SIZE must be a power of two, 128 or less"
+#endif
+
+/* One entry per frame; history_head holds the current frame */
+static u16 g_history[2][NG_INPUT_HISTORY_SIZE];
+static u8 g_history_head;
+static u32 g_frame;
+
+typedef struct {
+    const NGInputMotion *motion; /* NULL when the slot is free */
+    u8 player;
+    u8 mirror;
+    u8 step;    /* Next step to match */
+    u8 age;     /* Frames since the previous step's input was last held */
+    u8 held;    /* Frames the current step's direction has been held */
+    u8 matched; /* Completed on the latest frame */
+} MotionSlot;
+
+static MotionSlot g_motions[NG_INPUT_MAX_MOTIONS];
+
+/*
+ * Record/playback log: runs of [frames][p1 hi | p2 hi | system][p1 lo][p2 lo],
+ * with the high 2 bits of each player in bits 7-6 and 5-4, ended by a
+ * zero frame count.
+ */
+#define RUN_BYTES 4
+#define RUN_MAX   255
+
+typedef struct {
+    u8 *buffer;     /* Recording, NULL when not */
+    const u8 *log;  /* Playback, NULL when not */
+    u16 size;       /* Buffer or log size */
+    u16 pos;        /* Start of the current run */
+    u8 run_left;    /* Playback: frames left in the current run */
+    u16 length;     /* Length of the last finished recording */
+    u8 *last;       /* Buffer of the last finished recording */
+} RecordState;
+
+static RecordState g_record;
+
 static const u16 BUTTON_BITS[] = {NG_BTN_UP, NG_BTN_DOWN, NG_BTN_LEFT, NG_BTN_RIGHT, NG_BTN_A,
                                   NG_BTN_B,  NG_BTN_C,    NG_BTN_D,    NG_BTN_START, NG_BTN_SELECT};
 #define NUM_BUTTONS 10
@@ -55,6 +97,17 @@ void NGInputInit(void) {
         }
     }
 
+    for (int p = 0; p < 2; p++) {
+        for (int i = 0; i < NG_INPUT_HISTORY_SIZE; i++)
+            g_history[p][i] = 0;
+        g_history[p][0] = g_input[p].current;
+    }
+    g_history_head = 0;
+    g_frame = 0;
+
+    for (int i = 0; i < NG_INPUT_MAX_MOTIONS; i++)
+        g_motions[i].motion = 0;
+
     u16 sys_initial = read_system_input();
     g_system.current = sys_initial;
     g_system.previous = sys_initial;
@@ -121,12 +174,136 @@ static u16 read_system_input(void) {
     return result;
 }
 
+static u16 mirror_lr(u16 state) {
+    return (u16)((state & ~(NG_BTN_LEFT | NG_BTN_RIGHT)) | ((state & NG_BTN_LEFT) << 1) |
+                 ((state & NG_BTN_RIGHT) >> 1));
+}
+
+/* Button-only steps ignore the stick; anything else needs the exact direction */
+static u8 direction_matches(u16 input, u16 current) {
+    u16 dir = input & NG_BTN_DIR;
+    if (dir == 0 && input != 0)
+        return 1;
+    return (current & NG_BTN_DIR) == dir;
+}
+
+static void step_motion(MotionSlot *m, u16 current, u16 pressed) {
+    const NGInputStep *steps = m->motion->steps;
+
+    m->matched = 0;
+    if (m->mirror) {
+        current = mirror_lr(current);
+        pressed = mirror_lr(pressed);
+    }
+
+    if (m->step > 0) {
+        /* The window runs from the last frame the previous step was held */
+        if ((steps[m->step - 1].input & NG_BTN_DIR) &&
+            direction_matches(steps[m->step - 1].input, current)) {
+            m->age = 0;
+        } else if (++m->age > steps[m->step].window) {
+            m->step = 0;
+            m->held = 0;
+        }
+    }
+
+    for (;;) {
+        const NGInputStep *st = &steps[m->step];
+        if (!direction_matches(st->input, current)) {
+            m->held = 0;
+            return;
+        }
+        if (m->held < 0xFF)
+            m->held++;
+        u16 buttons = st->input & (u16)~NG_BTN_DIR;
+        if (m->held < st->hold || (pressed & buttons) != buttons)
+            return;
+
+        m->age = 0;
+        m->held = 0;
+        if (++m->step == m->motion->count) {
+            m->step = 0;
+            m->matched = 1;
+            return;
+        }
+        /* A button step can land on the same frame as the direction before it */
+        if (steps[m->step].input & NG_BTN_DIR)
+            return;
+    }
+}
+
+static void finish_recording(void) {
+    if (g_record.buffer[g_record.pos] != 0)
+        g_record.pos = (u16)(g_record.pos + RUN_BYTES); /* Keep the open run */
+    g_record.buffer[g_record.pos] = 0;
+    g_record.length = (u16)(g_record.pos + 1);
+    g_record.last = g_record.buffer;
+    g_record.buffer = 0;
+}
+
+static void record_frame(const u16 *frame) {
+    u8 *b = g_record.buffer;
+    u8 packed = (u8)(((frame[0] >> 2) & 0xC0) | ((frame[1] >> 4) & 0x30) | (frame[2] & 0x0F));
+
+    if (b[g_record.pos] != 0 && b[g_record.pos] < RUN_MAX && b[g_record.pos + 1] == packed &&
+        b[g_record.pos + 2] == (u8)frame[0] && b[g_record.pos + 3] == (u8)frame[1]) {
+        b[g_record.pos]++;
+        return;
+    }
+    if (b[g_record.pos] != 0)
+        g_record.pos = (u16)(g_record.pos + RUN_BYTES);
+    if (g_record.pos + RUN_BYTES >= g_record.size) {
+        b[g_record.pos] = 0;
+        finish_recording(); /* Full: keep what fits */
+        return;
+    }
+    b[g_record.pos] = 1;
+    b[g_record.pos + 1] = packed;
+    b[g_record.pos + 2] = (u8)frame[0];
+    b[g_record.pos + 3] = (u8)frame[1];
+}
+
+/* Next logged frame, or 0 at the end of the log */
+static u8 playback_frame(u16 *frame) {
+    const u8 *log = g_record.log;
+
+    if (g_record.run_left == 0) {
+        if (g_record.pos + RUN_BYTES > g_record.size || log[g_record.pos] == 0) {
+            g_record.log = 0;
+            return 0;
+        }
+        g_record.run_left = log[g_record.pos];
+        g_record.pos = (u16)(g_record.pos + RUN_BYTES);
+    }
+    g_record.run_left--;
+
+    const u8 *run = &log[g_record.pos - RUN_BYTES];
+    frame[0] = (u16)(((run[1] & 0xC0) << 2) | run[2]);
+    frame[1] = (u16)(((run[1] & 0x30) << 4) | run[3]);
+    frame[2] = run[1] & 0x0F;
+    return 1;
+}
+
+/* Player 1, player 2 and system state for this frame */
+static void read_frame(u16 *frame) {
+    if (g_record.log && playback_frame(frame))
+        return;
+    frame[0] = read_player_input(0);
+    frame[1] = read_player_input(1);
+    frame[2] = read_system_input();
+    if (g_record.buffer)
+        record_frame(frame);
+}
+
 void NGInputUpdate(void) {
+    u16 frame[3];
+    read_frame(frame);
+
     for (int p = 0; p < 2; p++) {
         InputState *state = &g_input[p];
 
         state->previous = state->current;
-        state->current = read_player_input((u8)p);
+        state->current = frame[p];
         state->pressed = state->current & ~state->previous;
         state->released = ~state->current & state->previous;
 
@@ -148,8 +325,19 @@ void NGInputUpdate(void) {
         }
     }
 
+    g_history_head = (u8)((g_history_head + 1) & (NG_INPUT_HISTORY_SIZE - 1));
+    g_frame++;
+    for (int p = 0; p < 2; p++)
+        g_history[p][g_history_head] = g_input[p].current;
+
+    for (int i = 0; i < NG_INPUT_MAX_MOTIONS; i++) {
+        MotionSlot *m = &g_motions[i];
+        if (m->motion)
+            step_motion(m, g_input[m->player].current, g_input[m->player].pressed);
+    }
+
     g_system.previous = g_system.current;
-    g_system.current = read_system_input();
+    g_system.current = frame[2];
     g_system.pressed = g_system.current & ~g_system.previous;
     g_system.released = ~g_system.current & g_system.previous;
 }
@@ -216,6 +404,118 @@ u16 NGInputReleasedFrames(u8 player, u16 button) {
     return g_input[player].release_frames[idx];
 }
 
+u32 NGInputGetFrame(void) {
+    return g_frame;
+}
+
+u16 NGInputGetHistory(u8 player, u8 frames_ago) {
+    if (player > 1 || frames_ago >= NG_INPUT_HISTORY_SIZE)
+        return 0;
+    return g_history[player][(u8)((g_history_head - frames_ago) & (NG_INPUT_HISTORY_SIZE - 1))];
+}
+
+NGInputMotionHandle NGInputMotionRegister(u8 player, const NGInputMotion *motion) {
+    if (player > 1 || !motion || motion->count == 0)
+        return NG_INPUT_MOTION_NONE;
+    for (u8 i = 0; i < NG_INPUT_MAX_MOTIONS; i++) {
+        MotionSlot *m = &g_motions[i];
+        if (m->motion)
+            continue;
+        m->motion = motion;
+        m->player = player;
+        m->mirror = 0;
+        m->step = 0;
+        m->age = 0;
+        m->held = 0;
+        m->matched = 0;
+        return i;
+    }
+    return NG_INPUT_MOTION_NONE;
+}
+
+void NGInputMotionUnregister(NGInputMotionHandle handle) {
+    if (handle < NG_INPUT_MAX_MOTIONS)
+        g_motions[handle].motion = 0;
+}
+
+void NGInputMotionSetMirror(NGInputMotionHandle handle, u8 mirror) {
+    if (handle < NG_INPUT_MAX_MOTIONS)
+        g_motions[handle].mirror = mirror ? 1 : 0;
+}
+
+u8 NGInputMotionMatched(NGInputMotionHandle handle) {
+    if (handle >= NG_INPUT_MAX_MOTIONS || !g_motions[handle].motion)
+        return 0;
+    return g_motions[handle].matched;
+}
+
+void NGInputMotionReset(NGInputMotionHandle handle) {
+    if (handle >= NG_INPUT_MAX_MOTIONS)
+        return;
+    g_motions[handle].step = 0;
+    g_motions[handle].age = 0;
+    g_motions[handle].held = 0;
+    g_motions[handle].matched = 0;
+}
+
+void NGInputRecordStart(u8 *buffer, u16 size) {
+    g_record.log = 0;
+    g_record.buffer = 0;
+    if (!buffer || size <= RUN_BYTES)
+        return;
+    g_record.size = size;
+    g_record.pos = 0;
+    buffer[0] = 0;
+    g_record.buffer = buffer;
+}
+
+u16 NGInputRecordStop(void) {
+    if (g_record.buffer)
+        finish_recording();
+    return g_record.last ? g_record.length : 0;
+}
+
+u8 NGInputIsRecording(void) {
+    return g_record.buffer != 0;
+}
+
+u16 NGInputRecordSave(u16 sram_offset) {
+    if (!g_record.last)
+        return 0;
+    u8 was_unlocked = NGSramIsUnlocked();
+    NGSramUnlock();
+    NGSramWriteWord(sram_offset, g_record.length);
+    NGSramWriteBlock((u16)(sram_offset + 2), g_record.last, g_record.length);
+    if (!was_unlocked)
+        NGSramLock();
+    return (u16)(g_record.length + 2);
+}
+
+u16 NGInputRecordLoad(u16 sram_offset, u8 *buffer, u16 size) {
+    u16 length = NGSramReadWord(sram_offset);
+    if (length == 0 || length > size || (u32)sram_offset + 2 + length > NG_SRAM_EFFECTIVE_SIZE)
+        return 0;
+    NGSramReadBlock((u16)(sram_offset + 2), buffer, length);
+    return length;
+}
+
+void NGInputPlaybackStart(const u8 *log, u16 length) {
+    if (g_record.buffer)
+        finish_recording();
+    g_record.log = log;
+    g_record.size = length;
+    g_record.pos = 0;
+    g_record.run_left = 0;
+}
+
+void NGInputPlaybackStop(void) {
+    g_record.log = 0;
+}
+
+u8 NGInputIsPlayingBack(void) {
+    return g_record.log != 0;
+}
+
 u8 NGSystemHeld(u16 buttons) {
     return (g_system.current & buttons) == buttons;
 }
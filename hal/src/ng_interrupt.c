@@ -80,13 +80,15 @@ void NGTimerEnable(void) {
     *irqack = 0x0002;
 
     /* Enable: interrupt (4), reload on write (5), reload at vblank (6) */
-    NG_REG_LSPCMODE |= 0x0070;
+    ng_lspc_mode |= 0x0070;
+    NG_REG_LSPCMODE = ng_lspc_mode;
     timer_enabled = 1;
 }
 
 void NGTimerDisable(void) {
     /* Clear timer bits 4-7 */
-    NG_REG_LSPCMODE &= ~0x00F0;
+    ng_lspc_mode &= (u16)~0x00F0;
+    NG_REG_LSPCMODE = ng_lspc_mode;
     timer_enabled = 0;
 }
 
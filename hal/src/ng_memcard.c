@@ -69,15 +69,20 @@ u8 NGMemcardWriteByte(u16 offset, u8 value) {
     return 1;
 }
 
+/* Blocks check the card once and then step a pointer over the even bytes,
+ * instead of reading the status register for every byte */
+
 u16 NGMemcardRead(u16 offset, void *buffer, u16 length) {
     u8 *dst = (u8 *)buffer;
+    vu8 *card = MEMCARD_BASE + offset * 2;
     u16 i;
 
     if (!NGMemcardIsPresent())
         return 0;
 
     for (i = 0; i < length; i++) {
-        dst[i] = NGMemcardReadByte((u16)(offset + i));
+        dst[i] = *card;
+        card += 2;
     }
 
     return length;
@@ -85,16 +90,15 @@ u16 NGMemcardRead(u16 offset, void *buffer, u16 length) {
 
 u16 NGMemcardWrite(u16 offset, const void *buffer, u16 length) {
     const u8 *src = (const u8 *)buffer;
+    vu8 *card = MEMCARD_BASE + offset * 2;
     u16 i;
 
-    if (!NGMemcardIsPresent())
-        return 0;
     if (NGMemcardIsWriteProtected())
-        return 0;
+        return 0; /* Also when no card is present */
 
     for (i = 0; i < length; i++) {
-        if (!NGMemcardWriteByte((u16)(offset + i), src[i]))
-            return i;
+        *card = src[i];
+        card += 2;
     }
 
     return length;
@@ -12,14 +12,75 @@
 #include <ng_hardware.h>
 #include <ng_palette.h>
 
+#define GROUP_WORDS (8 * NG_PAL_SIZE)
+
+u16 *ng_pal_group[NG_PAL_COUNT / 8];
+u8 ng_pal_groups_used;
+volatile u8 ng_pal_dirty[NG_PAL_COUNT / 8];
+volatile u8 ng_pal_dirty_any;
+
+static u16 shadow_pool[NG_PAL_SHADOW_GROUPS][GROUP_WORDS];
+
+u16 *_NGPalGroupAlloc(u8 group) {
+    u16 *shadow;
+    if (ng_pal_groups_used < NG_PAL_SHADOW_GROUPS) {
+        shadow = shadow_pool[ng_pal_groups_used++];
+        for (u8 i = 0; i < GROUP_WORDS; i++)
+            shadow[i] = 0;
+    } else {
+        /* Pool used up: work on palette RAM itself */
+        shadow = (u16 *)NG_PAL_RAM_BASE + group * GROUP_WORDS;
+    }
+    ng_pal_group[group] = shadow;
+    return shadow;
+}
+
+/**
+ * Upload dirty palettes. Same walk as the unrolled copy in crt0.s _vblank:
+ * one byte of dirty bits covers a group of 8 palettes, each palette is 8
+ * long writes. Groups without a shadow of their own are skipped.
+ */
+void NGPalFlush(void) {
+    if (!ng_pal_dirty_any)
+        return;
+    ng_pal_dirty_any = 0;
+
+    volatile u32 *dst = (volatile u32 *)NG_PAL_RAM_BASE;
+
+    for (u8 group = 0; group < NG_PAL_COUNT / 8; group++, dst += GROUP_WORDS / 2) {
+        u8 bits = ng_pal_dirty[group];
+        if (!bits)
+            continue;
+        ng_pal_dirty[group] = 0;
+
+        const u32 *src = (const u32 *)ng_pal_group[group];
+        if (!src || src == (const u32 *)dst)
+            continue;
+        volatile u32 *out = dst;
+        for (u8 i = 0; i < 8; i++, bits >>= 1) {
+            if (bits & 1) {
+                out[0] = src[0];
+                out[1] = src[1];
+                out[2] = src[2];
+                out[3] = src[3];
+                out[4] = src[4];
+                out[5] = src[5];
+                out[6] = src[6];
+                out[7] = src[7];
+            }
+            src += NG_PAL_SIZE / 2;
+            out += NG_PAL_SIZE / 2;
+        }
+    }
+}
+
 void NGPalSetColor(u8 palette, u8 index, NGColor color) {
-    volatile u16 *pal = NGPalGetColorPtr(palette, index);
-    *pal = color;
+    NGPalGetShadow(palette)[index] = color;
+    NGPalMarkDirty(palette);
 }
 
 NGColor NGPalGetColor(u8 palette, u8 index) {
-    volatile u16 *pal = NGPalGetColorPtr(palette, index);
-    return *pal;
+    return NGPalGetShadow(palette)[index];
 }
 
 /**
@@ -28,7 +89,7 @@ NGColor NGPalGetColor(u8 palette, u8 index) {
  * 16 colors = 4 iterations of 4 writes each.
  */
 void NGPalSet(u8 palette, const NGColor colors[NG_PAL_SIZE]) {
-    volatile u16 *pal = NGPalGetPtr(palette);
+    u16 *pal = NGPalGetShadow(palette);
     const NGColor *src = colors;
 
     /* Unrolled 4x: 16 colors / 4 = 4 iterations
@@ -49,6 +110,7 @@ void NGPalSet(u8 palette, const NGColor colors[NG_PAL_SIZE]) {
     pal[13] = src[13];
     pal[14] = src[14];
     pal[15] = src[15];
+    NGPalMarkDirty(palette);
 }
 
 /**
@@ -56,8 +118,8 @@ void NGPalSet(u8 palette, const NGColor colors[NG_PAL_SIZE]) {
  * Uses fully unrolled copy for 16 colors - eliminates loop overhead entirely.
  */
 void NGPalCopy(u8 dst_palette, u8 src_palette) {
-    volatile u16 *dst = NGPalGetPtr(dst_palette);
-    volatile u16 *src = NGPalGetPtr(src_palette);
+    u16 *dst = NGPalGetShadow(dst_palette);
+    const u16 *src = NGPalGetShadow(src_palette);
 
     /* Fully unrolled for maximum speed on fixed 16-color palette */
     dst[0] = src[0];
@@ -76,21 +138,24 @@ void NGPalCopy(u8 dst_palette, u8 src_palette) {
     dst[13] = src[13];
     dst[14] = src[14];
     dst[15] = src[15];
+    NGPalMarkDirty(dst_palette);
 }
 
 void NGPalFill(u8 palette, u8 start_idx, u8 count, NGColor color) {
-    volatile u16 *pal = NGPalGetPtr(palette);
+    u16 *pal = NGPalGetShadow(palette);
     for (u8 i = 0; i < count && (start_idx + i) < NG_PAL_SIZE; i++) {
         pal[start_idx + i] = color;
     }
+    NGPalMarkDirty(palette);
 }
 
 void NGPalClear(u8 palette) {
-    volatile u16 *pal = NGPalGetPtr(palette);
+    u16 *pal = NGPalGetShadow(palette);
     pal[0] = NG_COLOR_REFERENCE;
     for (u8 i = 1; i < NG_PAL_SIZE; i++) {
         pal[i] = NG_COLOR_BLACK;
     }
+    NGPalMarkDirty(palette);
 }
 
 void NGPalGradient(u8 palette, u8 start_idx, u8 end_idx, NGColor start_color, NGColor end_color) {
@@ -105,28 +170,46 @@ void NGPalGradient(u8 palette, u8 start_idx, u8 end_idx, NGColor start_color, NG
         end_color = tc;
     }
 
-    volatile u16 *pal = NGPalGetPtr(palette);
+    u16 *pal = NGPalGetShadow(palette) + start_idx;
     u8 steps = end_idx - start_idx;
 
     if (steps == 0) {
-        pal[start_idx] = start_color;
-        return;
-    }
-
-    for (u8 i = 0; i <= steps; i++) {
-        u8 ratio = (u8)((i * 255) / steps);
-        pal[start_idx + i] = NGColorBlend(start_color, end_color, ratio);
+        pal[0] = start_color;
+    } else {
+        /* Same rounding as NGColorBlend(), with both ends unpacked once */
+        u8 r0 = NGColorGetRed(start_color), r1 = NGColorGetRed(end_color);
+        u8 g0 = NGColorGetGreen(start_color), g1 = NGColorGetGreen(end_color);
+        u8 b0 = NGColorGetBlue(start_color), b1 = NGColorGetBlue(end_color);
+        pal[0] = start_color;
+        for (u8 i = 1; i < steps; i++) {
+            u8 ratio = (u8)((i * 255) / steps);
+            u8 inv_ratio = 255 - ratio;
+            u8 r = (u8)(((u16)r0 * inv_ratio + (u16)r1 * ratio + 128) >> 8);
+            u8 g = (u8)(((u16)g0 * inv_ratio + (u16)g1 * ratio + 128) >> 8);
+            u8 b = (u8)(((u16)b0 * inv_ratio + (u16)b1 * ratio + 128) >> 8);
+            pal[i] = NG_RGB(r, g, b);
+        }
+        pal[steps] = end_color;
     }
+    NGPalMarkDirty(palette);
 }
 
 void NGPalFadeToColor(u8 palette, NGColor target, u8 amount) {
     if (amount > 31)
         amount = 31;
-    volatile u16 *pal = NGPalGetPtr(palette);
-    u8 ratio = amount * 8;
-    for (u8 i = 1; i < NG_PAL_SIZE; i++) {
-        pal[i] = NGColorBlend(pal[i], target, ratio);
-    }
+    NGColorBlendArray(NGPalGetShadow(palette) + 1, NG_PAL_SIZE - 1, target, (u8)(amount * 8));
+    NGPalMarkDirty(palette);
+}
+
+void NGPalCrossfade(u8 dst_palette, u8 from_palette, u8 to_palette, u8 ratio) {
+    NGColorCrossfadeArray(NGPalGetShadow(dst_palette) + 1, NGPalGetShadow(from_palette) + 1,
+                          NGPalGetShadow(to_palette) + 1, NG_PAL_SIZE - 1, ratio);
+    NGPalMarkDirty(dst_palette);
+}
+
+void NGPalAdjustBrightness(u8 palette, s8 amount) {
+    NGColorAdjustBrightnessArray(NGPalGetShadow(palette) + 1, NG_PAL_SIZE - 1, amount);
+    NGPalMarkDirty(palette);
 }
 
 /**
@@ -134,7 +217,7 @@ void NGPalFadeToColor(u8 palette, NGColor target, u8 amount) {
  * Fully unrolled for 16 colors to eliminate loop overhead.
  */
 void NGPalBackup(u8 palette, NGColor buffer[NG_PAL_SIZE]) {
-    volatile u16 *pal = NGPalGetPtr(palette);
+    const u16 *pal = NGPalGetShadow(palette);
 
     buffer[0] = pal[0];
     buffer[1] = pal[1];
@@ -159,7 +242,7 @@ void NGPalBackup(u8 palette, NGColor buffer[NG_PAL_SIZE]) {
  * Fully unrolled for 16 colors to eliminate loop overhead.
  */
 void NGPalRestore(u8 palette, const NGColor buffer[NG_PAL_SIZE]) {
-    volatile u16 *pal = NGPalGetPtr(palette);
+    u16 *pal = NGPalGetShadow(palette);
 
     pal[0] = buffer[0];
     pal[1] = buffer[1];
@@ -177,10 +260,11 @@ void NGPalRestore(u8 palette, const NGColor buffer[NG_PAL_SIZE]) {
     pal[13] = buffer[13];
     pal[14] = buffer[14];
     pal[15] = buffer[15];
+    NGPalMarkDirty(palette);
 }
 
 void NGPalSetupShaded(u8 palette, NGColor base_color) {
-    volatile u16 *pal = NGPalGetPtr(palette);
+    u16 *pal = NGPalGetShadow(palette);
 
     pal[0] = NG_COLOR_REFERENCE;
     pal[1] = base_color;
@@ -189,10 +273,11 @@ void NGPalSetupShaded(u8 palette, NGColor base_color) {
         s8 darken_amount = (s8)(-((i - 1) * 2));
         pal[i] = NGColorAdjustBrightness(base_color, darken_amount);
     }
+    NGPalMarkDirty(palette);
 }
 
 void NGPalSetupGrayscale(u8 palette) {
-    volatile u16 *pal = NGPalGetPtr(palette);
+    u16 *pal = NGPalGetShadow(palette);
 
     pal[0] = NG_COLOR_REFERENCE;
 
@@ -200,18 +285,68 @@ void NGPalSetupGrayscale(u8 palette) {
         u8 level = (u8)(31 - ((i - 1) * 2));
         pal[i] = NGColorGray(level);
     }
+    NGPalMarkDirty(palette);
+}
+
+/* The backdrop is the last color of palette 255. Writing the register as
+ * well keeps it immediate, so no upload is queued. */
+/* References held on each palette slot, 0 = free */
+static u8 slot_refs[NG_PAL_SLOTS];
+static u8 slot_next; /* Where the next search starts, so freed slots rest a while */
+
+u8 NGPalSlotAlloc(void) {
+    for (u8 n = 0; n < NG_PAL_SLOTS; n++) {
+        u8 i = slot_next;
+        slot_next = (u8)(i + 1 < NG_PAL_SLOTS ? i + 1 : 0);
+        if (!slot_refs[i]) {
+            slot_refs[i] = 1;
+            return (u8)(NG_PAL_SLOT_FIRST + i);
+        }
+    }
+    return NG_PAL_NO_SLOT;
+}
+
+u8 NGPalSlotBorrow(u8 src_palette) {
+    u8 slot = NGPalSlotAlloc();
+    if (slot != NG_PAL_NO_SLOT)
+        NGPalCopy(slot, src_palette);
+    return slot;
+}
+
+void NGPalSlotRetain(u8 palette) {
+    if (NGPalIsSlot(palette))
+        slot_refs[palette - NG_PAL_SLOT_FIRST]++;
+}
+
+void NGPalSlotRelease(u8 palette) {
+    if (NGPalIsSlot(palette) && slot_refs[palette - NG_PAL_SLOT_FIRST])
+        slot_refs[palette - NG_PAL_SLOT_FIRST]--;
+}
+
+u8 NGPalSlotsFree(void) {
+    u8 count = 0;
+    for (u8 i = 0; i < NG_PAL_SLOTS; i++)
+        count = (u8)(count + !slot_refs[i]);
+    return count;
+}
+
+void NGPalSlotsReset(void) {
+    for (u8 i = 0; i < NG_PAL_SLOTS; i++)
+        slot_refs[i] = 0;
+    slot_next = 0;
 }
 
 void NGPalSetBackdrop(NGColor color) {
+    NGPalGetShadow(NG_PAL_COUNT - 1)[NG_PAL_SIZE - 1] = color;
     NG_REG_BACKDROP = color;
 }
 
 NGColor NGPalGetBackdrop(void) {
-    return NG_REG_BACKDROP;
+    return NGPalGetShadow(NG_PAL_COUNT - 1)[NG_PAL_SIZE - 1];
 }
 
 void NGPalInitDefault(void) {
-    volatile u16 *pal = NGPalGetPtr(0);
+    u16 *pal = NGPalGetShadow(0);
 
     pal[0] = NG_COLOR_REFERENCE;
     pal[1] = NG_COLOR_WHITE;
@@ -229,4 +364,5 @@ void NGPalInitDefault(void) {
     for (u8 i = 12; i < NG_PAL_SIZE; i++) {
         pal[i] = NG_COLOR_BLACK;
     }
+    NGPalMarkDirty(0);
 }
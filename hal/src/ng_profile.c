@@ -0,0 +1,132 @@
+/*
+ * This file is part of ProGearSDK.
+ * Copyright (c) 2024-2025 ProGearSDK contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+/**
+ * @file ng_profile.c
+ * @brief Scanline profiler implementation (NG_PROFILE builds only).
+ */
+
+#include <ng_profile.h>
+
+#ifdef NG_PROFILE
+
+#include <ng_fix.h>
+
+volatile u16 ng_profile_marker;
+
+static const char *slot_names[NG_PROFILE_MAX_SLOTS];
+static u16 slot_start[NG_PROFILE_MAX_SLOTS];
+static u16 slot_accum[NG_PROFILE_MAX_SLOTS];
+
+/* Ring buffer of committed frames */
+static u16 history[NG_PROFILE_HISTORY][NG_PROFILE_MAX_SLOTS];
+static u8 history_head;
+static u8 history_count;
+
+void NGProfileRegister(u8 slot, const char *name) {
+    if (slot >= NG_PROFILE_MAX_SLOTS)
+        return;
+    slot_names[slot] = name;
+}
+
+void NGProfileBegin(u8 slot) {
+    if (slot >= NG_PROFILE_MAX_SLOTS)
+        return;
+    ng_profile_marker = slot;
+    slot_start[slot] = NGProfileLine();
+}
+
+void NGProfileEnd(u8 slot) {
+    if (slot >= NG_PROFILE_MAX_SLOTS)
+        return;
+    u16 end = NGProfileLine();
+    ng_profile_marker = (u16)(slot | NG_PROFILE_MARKER_END);
+    /* Counter wrapped through VBlank */
+    if (end < slot_start[slot])
+        end += NG_PROFILE_FRAME_LINES;
+    slot_accum[slot] = (u16)(slot_accum[slot] + end - slot_start[slot]);
+}
+
+void NGProfileFrameEnd(void) {
+    u16 *row = history[history_head];
+    for (u8 i = 0; i < NG_PROFILE_MAX_SLOTS; i++) {
+        row[i] = slot_accum[i];
+        slot_accum[i] = 0;
+    }
+
+    if (++history_head >= NG_PROFILE_HISTORY)
+        history_head = 0;
+    if (history_count < NG_PROFILE_HISTORY)
+        history_count++;
+}
+
+void NGProfileGetStats(u8 slot, NGProfileStats *out) {
+    if (!out)
+        return;
+    out->last = out->min = out->max = out->avg = 0;
+    if (slot >= NG_PROFILE_MAX_SLOTS || history_count == 0)
+        return;
+
+    u8 last = history_head ? (u8)(history_head - 1) : (u8)(NG_PROFILE_HISTORY - 1);
+    u16 min = 0xFFFF;
+    u16 max = 0;
+    u32 sum = 0;
+
+    for (u8 i = 0; i < history_count; i++) {
+        u16 v = history[i][slot];
+        if (v < min)
+            min = v;
+        if (v > max)
+            max = v;
+        sum += v;
+    }
+
+    out->last = history[last][slot];
+    out->min = min;
+    out->max = max;
+    out->avg = (u16)(sum / history_count);
+}
+
+void NGProfileDraw(u8 x, u8 y, u8 palette) {
+    NGTextPrint(NGFixLayoutXY(x, y), palette, "SLOT     NOW MIN MAX AVG");
+
+    for (u8 i = 0; i < NG_PROFILE_MAX_SLOTS; i++) {
+        if (!slot_names[i])
+            continue;
+        NGProfileStats st;
+        NGProfileGetStats(i, &st);
+        y++;
+        NGTextPrint(NGFixLayoutXY(x, y), palette, slot_names[i]);
+        NGTextPrintf(NGFixLayoutXY((u8)(x + 8), y), palette, "%4u%4u%4u%4u", st.last, st.min,
+                     st.max, st.avg);
+    }
+}
+
+void NGProfileDrawArenas(u8 x, u8 y, u8 palette) {
+#if NG_ARENA_STATS
+    static const char *const names[3] = {"PERSIST", "STATE", "FRAME"};
+    NGArena *arenas[3] = {&ng_arena_persistent, &ng_arena_state, &ng_arena_frame};
+
+    NGTextPrint(NGFixLayoutXY(x, y), palette, "ARENA    USED  PEAK  SIZE  AL  PK");
+
+    for (u8 i = 0; i < 3; i++) {
+        NGArena *a = arenas[i];
+        y++;
+        NGTextPrint(NGFixLayoutXY(x, y), palette, names[i]);
+        NGTextPrintf(NGFixLayoutXY((u8)(x + 7), y), palette, "%6u%6u%6u%4u%4u", NGArenaUsed(a),
+                     NGArenaPeak(a), NGArenaSize(a), (u32)a->allocs, (u32)NGArenaPeakAllocs(a));
+        if (a->failures) {
+            y++;
+            NGTextPrintf(NGFixLayoutXY((u8)(x + 1), y), palette, "FAIL%4u%6u AT %06X",
+                         (u32)a->failures, a->fail_size, (u32)(uintptr_t)a->fail_site);
+        }
+    }
+#else
+    NGTextPrint(NGFixLayoutXY(x, y), palette, "ARENA STATS OFF");
+#endif
+}
+
+#endif /* NG_PROFILE */
@@ -0,0 +1,142 @@
+/*
+ * This file is part of ProGearSDK.
+ * Copyright (c) 2024-2025 ProGearSDK contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+/**
+ * @file ng_raster.c
+ * @brief Raster table builder.
+ *
+ * Building and compiling side of the raster scheduler. Playback lives in
+ * the _vblank and _timer handlers in crt0.s.
+ */
+
+#include <ng_raster.h>
+#include <ng_interrupt.h>
+#include <ng_hardware.h>
+
+/* Read by the interrupt handlers in crt0.s */
+u16 *volatile ng_raster_pending = 0;
+u16 *volatile ng_raster_current = 0;
+u16 *volatile ng_raster_cursor = 0;
+
+/* Palette RAM word index of the backdrop color */
+#define BACKDROP_TARGET 0x0FFF
+
+/* Group header: reload hi, reload lo, count-1 */
+#define GROUP_HEADER_WORDS 3
+#define TERMINATOR         0xFFFF
+
+typedef struct {
+    u16 line;
+    u16 target;
+    u16 value;
+} RasterEntry;
+
+/* Kept sorted by line; entries on the same line stay in insertion order */
+static RasterEntry entries[NG_RASTER_MAX_ENTRIES];
+static u8 entry_count;
+
+/* One buffer plays while the other is compiled */
+static u16 buffers[2][NG_RASTER_BUFFER_WORDS];
+
+static u8 add_entry(u16 line, u16 target, u16 value) {
+    if (line >= NG_RASTER_LINES || entry_count >= NG_RASTER_MAX_ENTRIES)
+        return 0;
+
+    u8 i = entry_count;
+    while (i > 0 && entries[i - 1].line > line) {
+        entries[i] = entries[i - 1];
+        i--;
+    }
+    entries[i].line = line;
+    entries[i].target = target;
+    entries[i].value = value;
+    entry_count++;
+    return 1;
+}
+
+static u16 *put_reload(u16 *out, u32 clocks) {
+    if (clocks < 5 + NG_RASTER_IRQ_LATENCY)
+        clocks = 5; /* Same flood guard as NGTimerSetReload() */
+    else
+        clocks -= NG_RASTER_IRQ_LATENCY;
+    *out++ = (u16)(clocks >> 16);
+    *out++ = (u16)(clocks & 0xFFFF);
+    return out;
+}
+
+void NGRasterBegin(void) {
+    entry_count = 0;
+}
+
+u8 NGRasterAddPalette(u16 line, u8 palette, u8 index, u16 color) {
+    return add_entry(line, (u16)(palette * 16 + (index & 15)), color);
+}
+
+u8 NGRasterAddBackdrop(u16 line, u16 color) {
+    return add_entry(line, BACKDROP_TARGET, color);
+}
+
+u8 NGRasterAddVRAM(u16 line, u16 vram_addr, u16 value) {
+    if (vram_addr < 0x8000)
+        return 0; /* Would be read as a palette target */
+    return add_entry(line, vram_addr, value);
+}
+
+u8 NGRasterGetCount(void) {
+    return entry_count;
+}
+
+void NGRasterSubmit(void) {
+    if (entry_count == 0) {
+        NGRasterClear();
+        return;
+    }
+
+    /* Withdraw any table not yet picked up; the buffer that is not playing
+     * is then free, whether or not it held that table */
+    ng_raster_pending = 0;
+    u16 *buf = (ng_raster_current == buffers[0]) ? buffers[1] : buffers[0];
+
+    u16 *out = put_reload(buf, (u32)(NG_RASTER_VBLANK_LINES + entries[0].line) *
+                                   NG_RASTER_LINE_CLOCKS);
+
+    u8 i = 0;
+    while (i < entry_count) {
+        u16 line = entries[i].line;
+        u8 end = i;
+        while (end < entry_count && entries[end].line == line)
+            end++;
+
+        if (end < entry_count) {
+            out = put_reload(out, (u32)(entries[end].line - line) * NG_RASTER_LINE_CLOCKS);
+        } else {
+            *out++ = (u16)(NG_RASTER_RELOAD_IDLE >> 16);
+            *out++ = (u16)(NG_RASTER_RELOAD_IDLE & 0xFFFF);
+        }
+        *out++ = (u16)(end - i - 1);
+        for (; i < end; i++) {
+            *out++ = entries[i].target;
+            *out++ = entries[i].value;
+        }
+    }
+    *out = TERMINATOR;
+    entry_count = 0;
+
+    if (!NGTimerIsEnabled())
+        NGTimerEnable();
+    ng_raster_pending = buf;
+}
+
+void NGRasterClear(void) {
+    ng_raster_pending = 0;
+    ng_raster_current = 0;
+    ng_raster_cursor = 0;
+    NGTimerSetReload(NG_RASTER_RELOAD_IDLE);
+}
+
+u8 NGRasterIsActive(void) {
+    return ng_raster_current != 0 || ng_raster_pending != 0;
+}
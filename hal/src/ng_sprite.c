@@ -10,48 +10,79 @@
  *
  * Implements VRAM/SCB write patterns used by actor, backdrop, terrain,
  * and UI modules. Uses optimized indexed addressing for performance.
+ *
+ * While a display list is recording, every helper appends to it instead
+ * of touching VRAM (see ng_display_list.h).
  */
 
 #include <ng_sprite.h>
 #include <ng_hardware.h>
+#include <ng_display_list.h>
+
+/* Shadow of the write-only mode bits of LSPCMODE (see ng_hardware.h) */
+u16 ng_lspc_mode = 0;
+
+#if NG_VRAM_STATS
+NGVramTraffic ng_vram_traffic;
+#endif
+
+/* Write one word to VRAM, or to the display list when deferred */
+#define SPRITE_WRITE(deferred, data)       \
+    do {                                   \
+        if (deferred)                      \
+            NGDisplayListPut((u16)(data)); \
+        else                               \
+            NG_VRAM_WRITE_FAST(data);      \
+    } while (0)
 
 /* ============================================================
  * SCB1: Tile Column Writing
  * ============================================================ */
 
 void NGSpriteTileBegin(u16 sprite_idx) {
+    if (NGDisplayListIsRecording()) {
+        NGDisplayListRun(NG_SCB1_BASE + (sprite_idx * 64), 1);
+        return;
+    }
     NG_VRAM_DECLARE_BASE();
     NG_VRAM_SETUP_FAST(NG_SCB1_BASE + (sprite_idx * 64), 1);
 }
 
 void NGSpriteTileWrite(u16 tile_idx, u8 palette, u8 h_flip, u8 v_flip) {
-    NG_VRAM_DECLARE_BASE();
-    NG_VRAM_WRITE_FAST(tile_idx);
     u16 attr = ((u16)palette << 8);
     if (h_flip)
         attr |= 0x01;
     if (v_flip)
         attr |= 0x02;
-    NG_VRAM_WRITE_FAST(attr);
+    u8 deferred = NGDisplayListIsRecording();
+    NG_VRAM_DECLARE_BASE();
+    SPRITE_WRITE(deferred, tile_idx);
+    SPRITE_WRITE(deferred, attr);
 }
 
 void NGSpriteTileWriteRaw(u16 tile_idx, u16 attr) {
+    u8 deferred = NGDisplayListIsRecording();
     NG_VRAM_DECLARE_BASE();
-    NG_VRAM_WRITE_FAST(tile_idx);
-    NG_VRAM_WRITE_FAST(attr);
+    SPRITE_WRITE(deferred, tile_idx);
+    SPRITE_WRITE(deferred, attr);
 }
 
 void NGSpriteTileWriteEmpty(void) {
+    u8 deferred = NGDisplayListIsRecording();
     NG_VRAM_DECLARE_BASE();
-    NG_VRAM_WRITE_FAST(0);
-    NG_VRAM_WRITE_FAST(0);
+    SPRITE_WRITE(deferred, 0);
+    SPRITE_WRITE(deferred, 0);
 }
 
 void NGSpriteTilePadTo32(u8 rows_written) {
     if (rows_written >= 32)
         return;
-    NG_VRAM_DECLARE_BASE();
     u8 remaining = 32 - rows_written;
+    if (NGDisplayListIsRecording()) {
+        NGDisplayListFillNext(0, (u16)(remaining * 2));
+        return;
+    }
+    NG_VRAM_DECLARE_BASE();
     NG_VRAM_CLEAR_FAST(remaining * 2);
 }
 
@@ -63,8 +94,21 @@ void NGSpriteShrinkSet(u16 first_sprite, u8 count, u16 shrink) {
     if (count == 0)
         return;
 
+    if (NGDisplayListIsRecording()) {
+        NGDisplayListRun(NG_SCB2_BASE + first_sprite, 1);
+    } else {
+        NG_VRAM_DECLARE_BASE();
+        NG_VRAM_SETUP_FAST(NG_SCB2_BASE + first_sprite, 1);
+    }
+    NGSpriteShrinkWrite(count, shrink);
+}
+
+void NGSpriteShrinkWrite(u8 count, u16 shrink) {
+    if (count == 0)
+        return;
+
+    u8 deferred = NGDisplayListIsRecording();
     NG_VRAM_DECLARE_BASE();
-    NG_VRAM_SETUP_FAST(NG_SCB2_BASE + first_sprite, 1);
 
     u8 h_shrink_8 = (u8)(shrink >> 8); /* Full 8-bit horizontal */
     u8 v_shrink = (u8)(shrink & 0xFF); /* 8-bit vertical */
@@ -72,7 +116,7 @@ void NGSpriteShrinkSet(u16 first_sprite, u8 count, u16 shrink) {
     /* Single sprite: no distribution needed */
     if (count == 1) {
         u16 scb2 = (u16)(((h_shrink_8 >> 4) << 8) | v_shrink);
-        NG_VRAM_WRITE_FAST(scb2);
+        SPRITE_WRITE(deferred, scb2);
         return;
     }
 
@@ -94,7 +138,7 @@ void NGSpriteShrinkSet(u16 first_sprite, u8 count, u16 shrink) {
                 h++;
         }
         u16 scb2 = (u16)((h << 8) | v_shrink);
-        NG_VRAM_WRITE_FAST(scb2);
+        SPRITE_WRITE(deferred, scb2);
     }
 }
 
@@ -103,6 +147,11 @@ void NGSpriteShrinkSet(u16 first_sprite, u8 count, u16 shrink) {
  * ============================================================ */
 
 void NGSpriteYSet(u16 sprite_idx, s16 screen_y, u8 height) {
+    if (NGDisplayListIsRecording()) {
+        NGDisplayListRun(NG_SCB3_BASE + sprite_idx, 1);
+        NGDisplayListPut(NGSpriteSCB3(screen_y, height));
+        return;
+    }
     NG_VRAM_DECLARE_BASE();
     NG_VRAM_SETUP_FAST(NG_SCB3_BASE + sprite_idx, 1);
     NG_VRAM_WRITE_FAST(NGSpriteSCB3(screen_y, height));
@@ -111,6 +160,13 @@ void NGSpriteYSet(u16 sprite_idx, s16 screen_y, u8 height) {
 void NGSpriteYSetChain(u16 first_sprite, u8 count, s16 screen_y, u8 height) {
     if (count == 0)
         return;
+    if (NGDisplayListIsRecording()) {
+        NGDisplayListRun(NG_SCB3_BASE + first_sprite, 1);
+        NGDisplayListPut(NGSpriteSCB3(screen_y, height));
+        if (count > 1)
+            NGDisplayListFillNext(NGSpriteSCB3Sticky(), count - 1);
+        return;
+    }
     NG_VRAM_DECLARE_BASE();
     NG_VRAM_SETUP_FAST(NG_SCB3_BASE + first_sprite, 1);
     NG_VRAM_WRITE_FAST(NGSpriteSCB3(screen_y, height));
@@ -122,6 +178,10 @@ void NGSpriteYSetChain(u16 first_sprite, u8 count, s16 screen_y, u8 height) {
 void NGSpriteYSetUniform(u16 first_sprite, u8 count, s16 screen_y, u8 height) {
     if (count == 0)
         return;
+    if (NGDisplayListIsRecording()) {
+        NGDisplayListFill(NG_SCB3_BASE + first_sprite, 1, NGSpriteSCB3(screen_y, height), count);
+        return;
+    }
     NG_VRAM_DECLARE_BASE();
     NG_VRAM_SETUP_FAST(NG_SCB3_BASE + first_sprite, 1);
     NG_VRAM_FILL_FAST(NGSpriteSCB3(screen_y, height), count);
@@ -132,6 +192,11 @@ void NGSpriteYSetUniform(u16 first_sprite, u8 count, s16 screen_y, u8 height) {
  * ============================================================ */
 
 void NGSpriteXSet(u16 sprite_idx, s16 screen_x) {
+    if (NGDisplayListIsRecording()) {
+        NGDisplayListRun(NG_SCB4_BASE + sprite_idx, 1);
+        NGDisplayListPut(NGSpriteSCB4(screen_x));
+        return;
+    }
     NG_VRAM_DECLARE_BASE();
     NG_VRAM_SETUP_FAST(NG_SCB4_BASE + sprite_idx, 1);
     NG_VRAM_WRITE_FAST(NGSpriteSCB4(screen_x));
@@ -140,23 +205,49 @@ void NGSpriteXSet(u16 sprite_idx, s16 screen_x) {
 void NGSpriteXSetSpaced(u16 first_sprite, u8 count, s16 base_x, s16 spacing) {
     if (count == 0)
         return;
+    u8 deferred = NGDisplayListIsRecording();
     NG_VRAM_DECLARE_BASE();
-    NG_VRAM_SETUP_FAST(NG_SCB4_BASE + first_sprite, 1);
+    if (deferred)
+        NGDisplayListRun(NG_SCB4_BASE + first_sprite, 1);
+    else
+        NG_VRAM_SETUP_FAST(NG_SCB4_BASE + first_sprite, 1);
     s16 x = base_x;
     for (u8 col = 0; col < count; col++) {
-        NG_VRAM_WRITE_FAST(NGSpriteSCB4(x));
+        SPRITE_WRITE(deferred, NGSpriteSCB4(x));
         x += spacing;
     }
 }
 
 void NGSpriteXBegin(u16 first_sprite) {
+    if (NGDisplayListIsRecording()) {
+        NGDisplayListRun(NG_SCB4_BASE + first_sprite, 1);
+        return;
+    }
     NG_VRAM_DECLARE_BASE();
     NG_VRAM_SETUP_FAST(NG_SCB4_BASE + first_sprite, 1);
 }
 
 void NGSpriteXWriteNext(s16 screen_x) {
+    u8 deferred = NGDisplayListIsRecording();
     NG_VRAM_DECLARE_BASE();
-    NG_VRAM_WRITE_FAST(NGSpriteSCB4(screen_x));
+    SPRITE_WRITE(deferred, NGSpriteSCB4(screen_x));
+}
+
+/* ============================================================
+ * Auto-Animation (LSPCMODE bits 8-15: speed, bit 3: disable)
+ * ============================================================ */
+
+void NGSpriteAutoAnimSetSpeed(u8 speed) {
+    ng_lspc_mode = (u16)((ng_lspc_mode & 0x00FF) | ((u16)speed << 8));
+    NG_REG_LSPCMODE = ng_lspc_mode;
+}
+
+void NGSpriteAutoAnimEnable(u8 enable) {
+    if (enable)
+        ng_lspc_mode &= (u16)~0x0008;
+    else
+        ng_lspc_mode |= 0x0008;
+    NG_REG_LSPCMODE = ng_lspc_mode;
 }
 
 /* ============================================================
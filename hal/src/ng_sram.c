@@ -94,24 +94,29 @@ void NGSramWriteLong(u16 offset, u32 value) {
  * Block Access
  * ========================================================================== */
 
+/* Blocks step a pointer over the odd bytes instead of going through the
+ * byte functions, which check the lock and scale the offset every byte */
+
 void NGSramReadBlock(u16 offset, void *buffer, u16 length) {
     u8 *dst = (u8 *)buffer;
-    u16 i;
+    vu8 *sram = SRAM_BASE + offset * 2;
 
-    for (i = 0; i < length; i++) {
-        dst[i] = NGSramReadByte((u16)(offset + i));
+    while (length--) {
+        *dst++ = *sram;
+        sram += 2;
     }
 }
 
 void NGSramWriteBlock(u16 offset, const void *buffer, u16 length) {
     const u8 *src = (const u8 *)buffer;
-    u16 i;
+    vu8 *sram = SRAM_BASE + offset * 2;
 
     if (!sram_unlocked)
         return;
 
-    for (i = 0; i < length; i++) {
-        NGSramWriteByte((u16)(offset + i), src[i]);
+    while (length--) {
+        *sram = *src++;
+        sram += 2;
     }
 }
 
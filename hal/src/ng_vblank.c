@@ -0,0 +1,117 @@
+/*
+ * This file is part of ProGearSDK.
+ * Copyright (c) 2024-2025 ProGearSDK contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+/**
+ * @file ng_vblank.c
+ * @brief VBlank job list implementation
+ */
+
+#include <ng_vblank.h>
+#include <ng_hardware.h>
+
+volatile u8 ng_vblank_scheduled;
+volatile u16 ng_vblank_count;
+
+static NGInterruptHandler jobs[NG_VBLANK_JOBS];
+static u8 job_priority[NG_VBLANK_JOBS];
+static u8 job_lines[NG_VBLANK_JOBS];
+static u8 job_count;
+
+/* Handles in the order they run */
+static u8 order[NG_VBLANK_JOBS];
+
+static u8 deadline = NG_VBLANK_LINES;
+
+/* ============================================================================
+ * Registration
+ * ========================================================================== */
+
+NGVBlankJob NGVBlankJobAdd(NGInterruptHandler job, u8 priority, u8 lines) {
+    if (job_count >= NG_VBLANK_JOBS)
+        return NG_VBLANK_NO_JOB;
+
+    u8 handle = job_count++;
+    jobs[handle] = job;
+    job_priority[handle] = priority;
+    job_lines[handle] = lines;
+
+    /* Insert after the jobs of equal or lower priority value */
+    u8 i = handle;
+    while (i > 0 && job_priority[order[i - 1]] > priority) {
+        order[i] = order[i - 1];
+        i--;
+    }
+    order[i] = handle;
+    return handle;
+}
+
+void NGVBlankJobsClear(void) {
+    ng_vblank_scheduled = 0;
+    job_count = 0;
+}
+
+/* ============================================================================
+ * Scheduling
+ * ========================================================================== */
+
+void NGVBlankJobSchedule(NGVBlankJob job) {
+    if (job < job_count)
+        ng_vblank_scheduled |= (u8)(1 << job);
+}
+
+void NGVBlankJobCancel(NGVBlankJob job) {
+    if (job < job_count)
+        ng_vblank_scheduled &= (u8) ~(1 << job);
+}
+
+u8 NGVBlankJobIsScheduled(NGVBlankJob job) {
+    return job < job_count && (ng_vblank_scheduled & (1 << job)) ? 1 : 0;
+}
+
+void NGVBlankSetDeadline(u8 lines) {
+    deadline = lines;
+}
+
+/* ============================================================================
+ * Running
+ * ========================================================================== */
+
+/* Lines since the VBlank interrupt. The LSPC counter runs 0xF8-0x1FF and
+ * the interrupt fires at NG_VBLANK_LINE_FIRST, 16 lines before it wraps. */
+static u16 vblank_line(void) {
+    u16 line = (u16)(NG_REG_LSPCMODE >> 7);
+    if (line >= NG_VBLANK_LINE_FIRST)
+        return (u16)(line - NG_VBLANK_LINE_FIRST);
+    return (u16)(line + (0x200 - NG_VBLANK_LINE_FIRST) - 0xF8);
+}
+
+void NGVBlankRunJobs(void) {
+#if NG_VRAM_STATS
+    /* Not charged to the graphic the main loop may be flushing */
+    NGVramTraffic traffic = ng_vram_traffic;
+#endif
+    for (u8 i = 0; i < job_count && ng_vblank_scheduled; i++) {
+        u8 handle = order[i];
+        u8 bit = (u8)(1 << handle);
+        if (!(ng_vblank_scheduled & bit))
+            continue;
+        if (vblank_line() + job_lines[handle] > deadline)
+            continue; /* Stays scheduled for the next VBlank */
+        ng_vblank_scheduled &= (u8)~bit;
+        jobs[handle]();
+    }
+#if NG_VRAM_STATS
+    ng_vram_traffic = traffic;
+#endif
+}
+
+/* ============================================================================
+ * Counting
+ * ========================================================================== */
+
+u16 NGVBlankCount(void) {
+    return ng_vblank_count;
+}
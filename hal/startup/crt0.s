@@ -13,6 +13,24 @@
     .extern ng_vblank_handler
     .extern ng_timer_handler
 
+| Deferred VRAM display list (defined in ng_display_list.c)
+    .extern ng_display_list_pending
+
+| Raster table playback state (defined in ng_raster.c)
+    .extern ng_raster_pending
+    .extern ng_raster_current
+    .extern ng_raster_cursor
+
+| Shadow palette RAM and dirty bits (defined in ng_palette.c)
+    .extern ng_pal_group
+    .extern ng_pal_dirty
+    .extern ng_pal_dirty_any
+
+| VBlank job list (defined in ng_vblank.c)
+    .extern ng_vblank_scheduled
+    .extern ng_vblank_count
+    .extern NGVBlankRunJobs
+
 | Data section bounds (defined in link.ld)
     .extern __data_start
     .extern __data_end
@@ -145,12 +163,94 @@ _vblank:
     jmp     0xC00438.l          | Let BIOS handle VBlank
 1:
     move.w  #4, 0x3C000C        | Acknowledge VBlank interrupt
+    | Arm the raster table first so the first interrupt lands on its line
+    | (see ng_raster.h for the format)
+    move.l  ng_raster_pending, %d0
+    beq.s   14f                 | No new table: replay the current one
+    clr.l   ng_raster_pending
+    move.l  %d0, ng_raster_current
+14: move.l  ng_raster_current, %d0
+    beq.s   15f                 | Raster effects off
+    move.l  %d0, %a0
+    move.w  (%a0)+, 0x3C0008    | TIMERHIGH
+    move.w  (%a0)+, 0x3C000A    | TIMERLOW (reloads the counter)
+    move.l  %a0, ng_raster_cursor
+15:
     move.b  %d0, 0x300001       | Kick watchdog
+    | Replay pending display list (see ng_display_list.h for the format)
+    move.l  ng_display_list_pending, %d0
+    beq.s   5f                  | Nothing submitted this frame
+    move.l  %d0, %a0
+    clr.l   ng_display_list_pending
+    lea     0x3C0000, %a1       | VRAMADDR (+2 VRAMDATA, +4 VRAMMOD)
+3:  move.w  (%a0)+, %d0         | Run header: count (bit 15 = fill)
+    beq.s   5f                  | Zero terminates the list
+    move.w  (%a0)+, (%a1)       | VRAMADDR
+    move.w  (%a0)+, 4(%a1)      | VRAMMOD
+    bclr    #15, %d0
+    bne.s   6f                  | Fill run
+    subq.w  #1, %d0
+4:  move.w  (%a0)+, 2(%a1)      | Copy run: one data word per write
+    dbf     %d0, 4b
+    bra.s   3b
+6:  move.w  (%a0)+, %d1         | Fill run: single value repeated
+    subq.w  #1, %d0
+7:  move.w  %d1, 2(%a1)
+    dbf     %d0, 7b
+    bra.s   3b
+5:
+    | Upload dirty shadow palettes (same walk as NGPalFlush in ng_palette.c)
+    tst.b   ng_pal_dirty_any
+    beq.s   13f                 | No palette changed this frame
+    clr.b   ng_pal_dirty_any
+    movem.l %d2/%a2-%a3, -(%sp)
+    lea     ng_pal_dirty, %a0
+    lea     ng_pal_group, %a3
+    lea     0x400000, %a2       | Palette RAM
+    moveq   #31, %d2            | 32 bytes of dirty bits
+8:  move.b  (%a0)+, %d0         | Dirty bits for the next 8 palettes
+    bne.s   9f
+    addq.l  #4, %a3             | All clean: skip 8 palettes
+    lea     256(%a2), %a2
+    bra.s   12f
+9:  clr.b   -1(%a0)
+    move.l  (%a3)+, %d1         | Group shadow
+    beq.s   17f
+    move.l  %d1, %a1
+    cmpa.l  %a1, %a2
+    bne.s   18f
+17: lea     256(%a2), %a2       | No shadow of its own: nothing to copy
+    bra.s   12f
+18: moveq   #7, %d1
+10: lsr.b   #1, %d0
+    bcc.s   11f
+    move.l  (%a1)+, (%a2)+      | 16 colors as 8 long writes
+    move.l  (%a1)+, (%a2)+
+    move.l  (%a1)+, (%a2)+
+    move.l  (%a1)+, (%a2)+
+    move.l  (%a1)+, (%a2)+
+    move.l  (%a1)+, (%a2)+
+    move.l  (%a1)+, (%a2)+
+    move.l  (%a1)+, (%a2)+
+    dbf     %d1, 10b
+    bra.s   12f
+11: lea     32(%a1), %a1        | Clean palette
+    lea     32(%a2), %a2
+    dbf     %d1, 10b
+12: dbf     %d2, 8b
+    movem.l (%sp)+, %d2/%a2-%a3
+13:
+    | Run scheduled jobs that fit before the deadline (see ng_vblank.h)
+    tst.b   ng_vblank_scheduled
+    beq.s   16f                 | No jobs this frame
+    jsr     NGVBlankRunJobs
+16:
+    addq.w  #1, ng_vblank_count | Frames dropped show as a gap (ng_vblank.h)
     move.b  #1, 0x10FD8E        | Set vblank flag for NG_waitVBlank
     | Check for custom VBlank handler
-    move.l  ng_vblank_handler, %a0
-    cmp.l   #0, %a0
+    move.l  ng_vblank_handler, %d0
     beq.s   2f                  | No custom handler
+    move.l  %d0, %a0
     jsr     (%a0)               | Call custom handler
 2:
     movem.l (%sp)+, %d0-%d1/%a0-%a1  | Restore registers
@@ -159,10 +259,40 @@ _vblank:
 | ============================================================================
 | Timer Interrupt Handler
 | Used for raster effects (mid-frame register changes)
+| Plays the raster table (ng_raster.h) when one is active, otherwise calls
+| the custom C handler. The reload is written before anything else so the
+| latency NG_RASTER_IRQ_LATENCY compensates for stays constant.
 | ============================================================================
 _timer:
-    movem.l %d0-%d1/%a0-%a1, -(%sp)  | Save registers
     move.w  #2, 0x3C000C        | Acknowledge timer interrupt
+    move.l  %a0, -(%sp)
+    move.l  ng_raster_cursor, %a0
+    cmpa.w  #0, %a0
+    beq.s   4f                  | No raster table: custom handler path
+    move.w  (%a0)+, 0x3C0008    | Reload for the next group
+    move.w  (%a0)+, 0x3C000A
+    movem.l %d0-%d1/%a1, -(%sp)
+    lea     0x400000, %a1       | Palette RAM
+    move.w  (%a0)+, %d0         | Writes in this group - 1
+1:  move.w  (%a0)+, %d1         | Target
+    bmi.s   2f                  | VRAM address
+    add.w   %d1, %d1            | Palette word index -> byte offset
+    move.w  (%a0)+, 0(%a1,%d1.w)
+    dbf     %d0, 1b
+    bra.s   3f
+2:  move.w  %d1, 0x3C0000       | VRAMADDR
+    move.w  (%a0)+, 0x3C0002    | VRAMDATA
+    dbf     %d0, 1b
+3:  cmpi.w  #-1, (%a0)          | Terminator: frame's table done
+    bne.s   5f
+    suba.l  %a0, %a0
+5:  move.l  %a0, ng_raster_cursor
+    move.b  %d0, 0x300001       | Kick watchdog (prevent reset)
+    movem.l (%sp)+, %d0-%d1/%a1
+    move.l  (%sp)+, %a0
+    rte
+4:
+    movem.l %d0-%d1/%a1, -(%sp)  | Save registers
     move.b  %d0, 0x300001       | Kick watchdog (prevent reset)
     | Check for custom Timer handler
     move.l  ng_timer_handler, %a0
@@ -170,7 +300,8 @@ _timer:
     beq.s   1f                  | No custom handler
     jsr     (%a0)               | Call custom handler
 1:
-    movem.l (%sp)+, %d0-%d1/%a0-%a1  | Restore registers
+    movem.l (%sp)+, %d0-%d1/%a1  | Restore registers
+    move.l  (%sp)+, %a0
     rte
 
 | ============================================================================
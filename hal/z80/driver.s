@@ -6,13 +6,49 @@
 
 ;;;
 ;;; NeoGeo ProGearSDK Audio Driver
-;;; Simple ADPCM-A (SFX) and ADPCM-B (Music) driver
+;;; ADPCM-A (SFX), ADPCM-B (Music) and FM/SSG (Songs) driver
 ;;;
 ;;; 68k/Z80 Communication Protocol:
 ;;; - 68k writes commands to REG_SOUND, which triggers Z80 NMI
 ;;; - Z80 reads commands from port $00, replies via port $0C
 ;;; - Standard commands acknowledged by echoing with bit 7 set (cmd | 0x80)
 ;;;
+;;; Voice Packets:
+;;; - $33 starts a voice packet; the next 5 commands are its parameters:
+;;;   sfx id LSB, sfx id MSB, channel (0-5, $FF = auto), pan | volume
+;;;   (ADPCM-A L/R bits 7-6, volume 0-31), priority
+;;; - The header is acknowledged with $B3, parameter n (1-5) with $40+n,
+;;;   so equal parameter bytes never look already acknowledged
+;;; - The bytes are buffered in work RAM; the voice starts on the last one
+;;;   (other packets work the same way, with their own parameter count)
+;;; - Priority 0 means the sample's default from sfx_priority
+;;;
+;;; Voice Allocation:
+;;; - Auto-assigned voices take a free channel (round-robin) if there is one
+;;; - Otherwise they steal the lowest-priority voice, the oldest among
+;;;   equals, unless that voice's priority is above their own (then the new
+;;;   voice is dropped)
+;;; - $34 replies with the busy channel mask ($00-$3F) instead of an echo
+;;;
+;;; Music:
+;;; - A track is a run of music_segments entries, optionally looping back to
+;;;   one of them or chaining to another track at its end
+;;; - While a segment plays, the start address registers already hold the
+;;;   next segment's, so the ADPCM-B repeat jumps there without a gap; the
+;;;   stop address follows once the end flag shows the jump happened
+;;; - $35 is a one-parameter packet queuing the track to play after the
+;;;   current track's last segment ($FF cancels); it is acknowledged with
+;;;   $B5, then $41
+;;;
+;;; FM/SSG Songs:
+;;; - $36 is a one-parameter packet starting FM song n (0-31), $37 stops,
+;;;   $38 pauses and $39 resumes it
+;;; - Each song drives the 4 FM and 3 SSG channels from byte sequences in
+;;;   fm_data, one step per Timer B overflow (polled, interrupts stay off)
+;;; - Sequence bytes: $00-$7F note (octave << 4 | semitone) then duration,
+;;;   $80 d rest, $81 d wait, $82 p patch, $83 v volume (SSG), $84 lo hi
+;;;   jump, $85 lo hi call, $86 return, $87 end (durations in ticks)
+;;;
 ;;; Mandatory BIOS Commands (must be implemented per SNK spec):
 ;;; - $01: Slot switch - stop sounds, enable NMI, reply $01, wait in RAM
 ;;;        Failure causes "Z80 ERROR" during BIOS self-test
@@ -36,6 +72,8 @@
     .equ    PORT_YM2610_A_VAL,  0x05    ; YM2610 Port A value
     .equ    PORT_YM2610_B_ADDR, 0x06    ; YM2610 Port B address
     .equ    PORT_YM2610_B_VAL,  0x07    ; YM2610 Port B value
+    .equ    PORT_YM2610_STATUS_0, 0x04  ; YM2610 timer flags (read)
+    .equ    PORT_YM2610_STATUS_1, 0x06  ; YM2610 ADPCM end flags (read)
     .equ    PORT_ENABLE_NMI,    0x08    ; Enable NMI from 68k
     .equ    PORT_TO_68K,        0x0C    ; Write reply to 68k
     .equ    PORT_DISABLE_NMI,   0x18    ; Disable NMI from 68k
@@ -62,7 +100,41 @@
     .equ    REG_ADPCM_FLAG,         0x1C    ; Playback finished flags
 
     ;; Timer registers (Port A)
+    .equ    REG_TIMER_B,            0x26    ; Timer B value
     .equ    REG_TIMER_FLAGS,        0x27    ; Timer control
+    .equ    TIMER_B_RUN,            0x2A    ; Load B, B flag on, reset B flag
+    .equ    TIMER_STOP,             0x30    ; Both timers off, flags reset
+
+    ;; YM2610 SSG Registers (Port A)
+    .equ    REG_SSG_FINE,           0x00    ; Ch A tone period LSB (ch B/C at +2/+4)
+    .equ    REG_SSG_MIXER,          0x07    ; Tone/noise enables (active low)
+    .equ    REG_SSG_VOL,            0x08    ; Ch A volume (ch B/C at +1/+2)
+
+    ;; YM2610 FM Registers (channel 1/2 at +1/+2, on port A for FM 0-1, B for FM 2-3)
+    .equ    REG_FM_KEY,             0x28    ; Key on/off (port A)
+    .equ    REG_FM_DT_MUL,          0x30    ; First operator register
+    .equ    REG_FM_FNUM_LO,         0xA0    ; F-number LSB
+    .equ    REG_FM_FNUM_HI,         0xA4    ; Block << 3 | F-number MSB
+
+    ;; Voice packets
+    .equ    CMD_VOICE,          0x33    ; Packet header
+    .equ    VOICE_PARAMS,       5       ; Parameter bytes after the header
+    .equ    ACK_PARAM_BASE,     0x40    ; Parameter n is acknowledged with 0x40 + n
+    .equ    CHANNEL_AUTO,       0xFF    ; Let the driver pick the channel
+    .equ    CMD_STATUS,         0x34    ; Reply with the busy channel mask
+    .equ    CMD_MUSIC_QUEUE,    0x35    ; Packet: track to play next
+    .equ    CMD_FM_PLAY,        0x36    ; Packet: FM song to start
+    .equ    CMD_FM_STOP,        0x37
+    .equ    CMD_FM_PAUSE,       0x38
+    .equ    CMD_FM_RESUME,      0x39
+    .equ    MAX_PACKET_PARAMS,  VOICE_PARAMS
+
+    ;; sfx_table entries
+    .equ    SFX_COUNT,          128
+
+    ;; music_segments entries; MUSIC_NONE marks no loop, no next track, stop
+    .equ    MUSIC_SEGMENTS,     64
+    .equ    MUSIC_NONE,         0xFF
 
     ;; Default Delta-N for ADPCM-B sample rates
     ;; Delta-N = (sample_rate / 55555) * 65536
@@ -106,6 +178,14 @@ nmi_handler:
 
     ;; Read command from 68k
     in      a, (PORT_FROM_68K)
+    ld      c, a
+
+    ;; Inside a voice packet every byte is a parameter
+    ld      a, (packet_left)
+    or      a
+    jp      nz, packet_param
+
+    ld      a, c
     ld      (current_cmd), a
 
     ;; Check for BIOS commands first (0x01, 0x02, 0x03)
@@ -115,6 +195,16 @@ nmi_handler:
     jp      z, cmd_eyecatcher
     cp      #0x03
     jp      z, cmd_reset
+    ld      b, #VOICE_PARAMS
+    cp      #CMD_VOICE
+    jp      z, packet_begin
+    ld      b, #1
+    cp      #CMD_MUSIC_QUEUE
+    jp      z, packet_begin
+    cp      #CMD_FM_PLAY
+    jp      z, packet_begin
+    cp      #CMD_STATUS
+    jp      z, cmd_status
 
     ;; Process regular commands
     call    process_command
@@ -146,6 +236,11 @@ init_driver:
     ;; Reset YM2610
     call    ym2610_reset
 
+    ;; Report ADPCM ends again (ym2610_reset masked them)
+    ld      b, #REG_ADPCM_FLAG
+    xor     a
+    call    ym_write_a
+
     ;; Initialize state
     xor     a
     ld      (adpcm_a_busy), a
@@ -153,6 +248,12 @@ init_driver:
     ld      (next_channel), a
     ld      (music_paused), a
     ld      (pending_pan), a
+    ld      (pending_priority), a
+    ld      (packet_left), a
+    ld      a, #CHANNEL_AUTO
+    ld      (pending_channel), a
+    ld      a, #MUSIC_NONE
+    ld      (music_queued), a
     ld      a, #0x3F
     ld      (master_volume), a
 
@@ -166,7 +267,8 @@ init_driver:
 
 main_loop:
     ;; Check if ADPCM-B has ended and needs restart (for looping)
-    call    check_music_loop
+    call    check_music_end
+    call    check_fm_tick
 
     ;; Small delay to avoid hammering the YM2610
     ld      b, #0x20
@@ -175,9 +277,8 @@ _delay_loop:
 
     jr      main_loop
 
-;;; Check if music needs to loop (ADPCM-B ended)
-check_music_loop:
-    ;; Only check if music is playing and not paused
+;;; Follow the hardware onto the staged segment once ADPCM-B reports a jump
+check_music_end:
     ld      a, (current_music)
     or      a
     ret     z                   ; No music playing
@@ -186,28 +287,101 @@ check_music_loop:
     or      a
     ret     nz                  ; Music is paused
 
-    ;; Read ADPCM flag register to check if ADPCM-B ended (bit 7)
-    ld      a, #REG_ADPCM_FLAG
-    out     (PORT_YM2610_A_ADDR), a
-    push    bc
-    pop     bc                  ; Small delay
-    in      a, (PORT_YM2610_A_VAL)
+    in      a, (PORT_YM2610_STATUS_1)
+    bit     7, a                ; ADPCM-B end flag
+    ret     z
 
-    bit     7, a                ; Check ADPCM-B end flag
-    ret     z                   ; Not ended yet
-
-    ;; Clear the end flag by writing 1 to bit 7
+    ;; Reset the end flag, then report it again
     push    bc
     ld      b, #REG_ADPCM_FLAG
     ld      a, #0x80
     call    ym_write_a
+    xor     a
+    call    ym_write_a
     pop     bc
 
-    ;; Restart music from beginning
-    ;; current_music stores index+1, so convert back to 0-31 for play_music
-    ld      a, (current_music)
+    ld      a, (music_staged)
+    cp      #MUSIC_NONE
+    jp      z, stop_music       ; Track over: nothing was staged
+    jp      music_advance
+
+;;; === Voice Packets ===
+
+;;; Packet header C with B parameters (jumped to from the NMI handler)
+packet_begin:
+    ld      a, c
+    ld      (packet_cmd), a
+    ld      a, b
+    ld      (packet_len), a
+    ld      (packet_left), a
+    ld      hl, #packet_buf
+    ld      (packet_ptr), hl
+    ld      a, c
+    or      #0x80               ; $B3 or $B5
+    out     (PORT_TO_68K), a
+    jp      nmi_exit
+
+;;; Packet parameter in C (jumped to from the NMI handler)
+packet_param:
+    ld      hl, (packet_ptr)
+    ld      (hl), c
+    inc     hl
+    ld      (packet_ptr), hl
+    ld      a, (packet_left)
     dec     a
-    jp      play_music
+    ld      (packet_left), a
+    ld      b, a                ; B = parameters still to come
+    jr      nz, _packet_ack
+
+    ld      a, (packet_cmd)
+    cp      #CMD_VOICE
+    call    z, play_voice
+    ld      a, (packet_cmd)
+    cp      #CMD_MUSIC_QUEUE
+    call    z, music_queue
+    ld      a, (packet_cmd)
+    cp      #CMD_FM_PLAY
+    call    z, fm_play_packet
+    ld      b, #0
+_packet_ack:
+    ;; $41 for the first parameter, up to $40 + packet_len for the last
+    ld      a, (packet_len)
+    sub     b
+    add     a, #ACK_PARAM_BASE
+    out     (PORT_TO_68K), a
+    jp      nmi_exit
+
+;;; Play the SFX voice described by packet_buf
+;;; packet_buf: id_l, id_h, channel, pan | volume, priority
+play_voice:
+    ld      hl, #packet_buf
+    ld      d, (hl)             ; D = id LSB
+    inc     hl
+    ld      a, (hl)             ; id MSB
+    inc     hl
+    or      a
+    ret     nz                  ; Beyond sfx_table
+    ld      a, d
+    cp      #SFX_COUNT
+    ret     nc
+
+    ld      a, (hl)
+    inc     hl
+    ld      (pending_channel), a
+    ld      a, (hl)
+    inc     hl
+    ld      (pending_pan), a
+    ld      a, (hl)
+    ld      (pending_priority), a
+    ld      a, d
+    jp      play_sfx
+
+;;; Voice status query (jumped to from the NMI handler)
+cmd_status:
+    call    refresh_busy
+    ld      a, (adpcm_a_busy)
+    out     (PORT_TO_68K), a
+    jp      nmi_exit
 
 ;;; === BIOS Commands ===
 
@@ -302,9 +476,18 @@ _check_pause:
 _check_resume:
     ;; 0x32: Resume music
     cp      #0x32
-    jr      nz, _check_sfx_ext
+    jr      nz, _check_fm
     jp      resume_music
 
+_check_fm:
+    ;; 0x37-0x39: Stop, pause, resume FM song
+    cp      #CMD_FM_STOP
+    jp      z, fm_stop
+    cp      #CMD_FM_PAUSE
+    jp      z, fm_pause
+    cp      #CMD_FM_RESUME
+    jp      z, fm_resume
+
 _check_sfx_ext:
     ;; 0x40-0x4F: Play SFX 16-31
     cp      #0x40
@@ -357,7 +540,7 @@ _check_sfx_left:
     cp      #0xD0
     jr      nc, _check_sfx_right
     push    af
-    ld      a, #0x80            ; Left pan
+    ld      a, #0x9F            ; Left pan, volume 31
     ld      (pending_pan), a
     pop     af
     and     #0x0F
@@ -370,7 +553,7 @@ _check_sfx_right:
     cp      #0xE0
     jr      nc, _check_sfx_ext_left
     push    af
-    ld      a, #0x40            ; Right pan
+    ld      a, #0x5F            ; Right pan, volume 31
     ld      (pending_pan), a
     pop     af
     and     #0x0F
@@ -383,7 +566,7 @@ _check_sfx_ext_left:
     cp      #0xF0
     jr      nc, _check_sfx_ext_right
     push    af
-    ld      a, #0x80            ; Left pan
+    ld      a, #0x9F            ; Left pan, volume 31
     ld      (pending_pan), a
     pop     af
     sub     #0xD0               ; A = 16-31
@@ -394,7 +577,7 @@ _check_sfx_ext_right:
     cp      #0xF0
     jr      c, _cmd_done
     push    af
-    ld      a, #0x40            ; Right pan
+    ld      a, #0x5F            ; Right pan, volume 31
     ld      (pending_pan), a
     pop     af
     sub     #0xE0               ; A = 16-31
@@ -406,16 +589,38 @@ _cmd_done:
 
 ;;; === ADPCM-A (Sound Effects) ===
 
-;;; Play SFX sample A (0-31) on auto-assigned channel
-;;; A = sample number (0-31)
+;;; Play SFX sample A (0-127) on pending_channel, or an auto-assigned one
+;;; A = sample number (0-127)
 play_sfx:
     push    bc
     push    de
     push    hl
 
-    ;; Get next channel (round-robin)
     ld      d, a                ; D = sample number
+    call    refresh_busy
+
+    ;; No priority given: use the sample's default
+    ld      a, (pending_priority)
+    or      a
+    jr      nz, _have_priority
+    ld      hl, #sfx_priority
+    ld      c, d
+    ld      b, #0
+    add     hl, bc
+    ld      a, (hl)
+    ld      (pending_priority), a
+_have_priority:
+
+    ;; Channel from a voice packet, else a free or stolen one
+    ld      a, (pending_channel)
+    cp      #6
+    jr      c, _have_channel
     call    find_free_channel
+    cp      #6
+    jr      c, _have_channel
+    call    clear_pending       ; Every voice outranks this one
+    jp      _play_sfx_done
+_have_channel:
 
     ;; A = channel (0-5), D = sample
     ld      e, a                ; E = channel
@@ -445,6 +650,14 @@ _got_channel_bit:
     ld      b, #REG_ADPCM_A_CTRL
     call    ym_write_b
 
+    ;; Forget an end flag left by the channel's previous sample
+    ld      a, c
+    call    channel_bit
+    ld      b, #REG_ADPCM_FLAG
+    call    ym_write_a
+    xor     a
+    call    ym_write_a
+
     ;; Set start address LSB
     ld      a, #REG_ADPCM_A1_START_L
     add     a, c                ; Add channel offset
@@ -482,15 +695,34 @@ _got_channel_bit:
     ld      b, a
     ld      a, (pending_pan)
     or      a
-    jr      nz, _use_pending_pan
+    jr      nz, _set_pan_vol
     ld      a, #0xDF            ; L+R, volume 31 (default center)
-    jr      _set_pan_vol
-_use_pending_pan:
-    or      #0x1F               ; Add max volume (0-31) to pan bits
 _set_pan_vol:
     call    ym_write_b
-    xor     a
-    ld      (pending_pan), a    ; Clear pending pan
+
+    ;; Record the voice's priority with its channel
+    ld      hl, #channel_priority
+    ld      e, c
+    ld      d, #0
+    add     hl, de
+    ld      a, (pending_priority)
+    ld      (hl), a
+
+    ;; Every other voice gets older (saturating), this one is the newest
+    ld      hl, #channel_age
+    ld      b, #6
+_age_loop:
+    inc     (hl)
+    jr      nz, _age_next
+    dec     (hl)
+_age_next:
+    inc     hl
+    djnz    _age_loop
+    ld      hl, #channel_age
+    add     hl, de
+    ld      (hl), #0
+
+    call    clear_pending
 
     ;; Start channel
     ld      a, c                ; Channel number
@@ -528,21 +760,128 @@ _play_sfx_done:
     pop     bc
     ret
 
-;;; Find next ADPCM-A channel using round-robin
-;;; Returns: A = channel (0-5)
+;;; Back to defaults for the next command
+clear_pending:
+    xor     a
+    ld      (pending_pan), a
+    ld      (pending_priority), a
+    ld      a, #CHANNEL_AUTO
+    ld      (pending_channel), a
+    ret
+
+;;; Pick an ADPCM-A channel for a voice of priority pending_priority
+;;; A free channel, searching round-robin from next_channel, else the
+;;; lowest-priority voice (the oldest among equals) if it does not outrank
+;;; the new one
+;;; Returns: A = channel (0-5), or CHANNEL_AUTO to drop the new voice
 find_free_channel:
+    push    bc
+    push    de
+    push    ix
+
+    ld      a, (adpcm_a_busy)
+    ld      e, a                ; E = busy mask
     ld      a, (next_channel)
-    ld      c, a                ; Save for return
+    ld      c, a                ; C = candidate channel
+    ld      b, #6
+_free_loop:
+    ld      a, c
+    call    channel_bit
+    and     e
+    jr      z, _free_found
+    inc     c
+    ld      a, c
+    cp      #6
+    jr      c, _free_next
+    ld      c, #0
+_free_next:
+    djnz    _free_loop
+
+    ;; All busy: C = victim, D = its priority, E = its age
+    ld      ix, #channel_priority
+    ld      c, #0
+    ld      d, 0(ix)
+    ld      e, 6(ix)            ; channel_age follows channel_priority
+    ld      b, #1
+_steal_loop:
+    inc     ix
+    ld      a, 0(ix)
+    cp      d
+    jr      c, _steal_take      ; Lower priority
+    jr      nz, _steal_next     ; Higher priority
+    ld      a, 6(ix)
+    cp      e
+    jr      c, _steal_next      ; Same priority, younger
+    jr      z, _steal_next
+_steal_take:
+    ld      c, b
+    ld      d, 0(ix)
+    ld      e, 6(ix)
+_steal_next:
+    inc     b
+    ld      a, b
+    cp      #6
+    jr      c, _steal_loop
+
+    ld      a, (pending_priority)
+    cp      d
+    ld      a, c
+    jr      nc, _pick_done
+    ld      a, #CHANNEL_AUTO    ; Victim outranks the new voice
+    jr      _pick_done
 
-    ;; Advance to next channel (0-5)
+_free_found:
+    ;; Next search starts after this channel
+    ld      a, c
     inc     a
     cp      #6
     jr      c, _save_next
     xor     a                   ; Wrap to 0
 _save_next:
     ld      (next_channel), a
+    ld      a, c
+
+_pick_done:
+    pop     ix
+    pop     de
+    pop     bc
+    ret
+
+;;; A = 1 << A (A = channel 0-5)
+channel_bit:
+    push    bc
+    ld      b, a
+    inc     b
+    ld      a, #1
+    jr      _bit_next
+_bit_shift:
+    add     a, a
+_bit_next:
+    djnz    _bit_shift
+    pop     bc
+    ret
+
+;;; Drop channels whose sample has ended from adpcm_a_busy
+refresh_busy:
+    in      a, (PORT_YM2610_STATUS_1)
+    and     #0x3F
+    ret     z
+    push    bc
+    ld      c, a
+
+    ;; Reset the flags seen, then report them again
+    ld      b, #REG_ADPCM_FLAG
+    call    ym_write_a
+    xor     a
+    call    ym_write_a
 
-    ld      a, c                ; Return current channel
+    ld      a, c
+    cpl
+    ld      c, a
+    ld      a, (adpcm_a_busy)
+    and     c
+    ld      (adpcm_a_busy), a
+    pop     bc
     ret
 
 ;;; Stop SFX on channel A (0-5)
@@ -589,85 +928,261 @@ _clear_got_bit:
 
 ;;; === ADPCM-B (Music) ===
 
-;;; Play music sample A (0-31) with looping
-;;; A = sample number
+;;; Play music track A (0-31) from its first segment
 play_music:
     push    bc
     push    de
     push    hl
 
+    ld      c, a                ; C = track
+    call    music_entry         ; HL = &music_table[track]
+    inc     hl
+    ld      a, (hl)             ; Segment count
+    dec     hl
+    or      a
+    jr      z, _play_music_done ; No such track
+
     ;; Store music index + 1 (so 0 = no music, 1-32 = music 0-31)
-    ld      c, a                ; Save music index
+    ld      a, c
+    ld      (music_track), a
     inc     a
     ld      (current_music), a
     xor     a
     ld      (music_paused), a   ; Clear paused state when starting new music
-    ld      a, c                ; Restore music index (0-31) for table lookup
-
-    ;; Get music info from table
-    ;; Each entry: start_l, start_h, stop_l, stop_h, delta_l, delta_h (6 bytes)
-    ld      h, #0
-    ld      l, a
-    add     hl, hl              ; * 2
-    ld      d, h
-    ld      e, l
-    add     hl, hl              ; * 4
-    add     hl, de              ; * 6
-    ld      de, #music_table
-    add     hl, de
+    ld      a, #MUSIC_NONE
+    ld      (music_queued), a
 
     ;; Stop current playback
     ld      b, #REG_ADPCM_B_CTRL
     ld      a, #0x01            ; Reset
     call    ym_write_a
 
-    ;; Set start address
-    ld      b, #REG_ADPCM_B_START_L
-    ld      a, (hl)
-    inc     hl
+    ld      a, (hl)             ; First segment
+    ld      (music_seg), a
+    call    write_delta
+
+    ;; Set pan (center)
+    ld      b, #REG_ADPCM_B_PAN
+    ld      a, #0xC0            ; L+R
     call    ym_write_a
 
-    ld      b, #REG_ADPCM_B_START_H
-    ld      a, (hl)
-    inc     hl
+    ;; Set volume
+    ld      b, #REG_ADPCM_B_VOL
+    ld      a, #0xFF            ; Max volume
     call    ym_write_a
 
-    ;; Set stop address
-    ld      b, #REG_ADPCM_B_STOP_L
-    ld      a, (hl)
-    inc     hl
+    call    music_key_on
+
+_play_music_done:
+    pop     hl
+    pop     de
+    pop     bc
+    ret
+
+;;; Start ADPCM-B at music_seg and stage the segment after it
+music_key_on:
+    push    bc
+    ld      a, (music_seg)
+    ld      c, #0
+    call    write_segment       ; Start address
+    ld      c, #2
+    call    write_segment       ; Stop address
+
+    ;; Forget an end flag from the previous track
+    ld      b, #REG_ADPCM_FLAG
+    ld      a, #0x80
+    call    ym_write_a
+    xor     a
+    call    ym_write_a
+
+    ;; Start with repeat: the repeat jumps to the staged start address
+    ld      b, #REG_ADPCM_B_CTRL
+    ld      a, #0x90            ; Start + Repeat
     call    ym_write_a
+    pop     bc
+    jp      stage_next
+
+;;; Queue track packet_buf[0] to follow the current one ($FF cancels)
+music_queue:
+    ld      a, (packet_buf)
+    cp      #MUSIC_NONE
+    jr      z, _queue_set
+    cp      #32
+    ret     nc
+    call    music_entry
+    inc     hl
+    ld      a, (hl)             ; Segment count
+    or      a
+    ret     z                   ; No such track
+    ld      a, (packet_buf)
+_queue_set:
+    ld      (music_queued), a
+    ld      a, (current_music)
+    or      a
+    ret     z
+    jp      stage_next          ; The queue may change what follows
+
+;;; Take over staged segment A, which the hardware has jumped to
+music_advance:
+    push    bc
+    push    de
+    push    hl
+    ld      (music_seg), a
+
+    ld      a, (music_staged_queue)
+    or      a
+    jr      z, _advance_track
+    ld      a, #MUSIC_NONE
+    ld      (music_queued), a   ; Queued track reached
+_advance_track:
+    ld      a, (music_staged_track)
+    ld      hl, #music_track
+    cp      (hl)
+    jr      z, _advance_stop
+
+    ;; Chained into another track, which may play at another rate
+    ld      (hl), a
+    inc     a
+    ld      (current_music), a
+    dec     a
+    call    music_entry
+    call    write_delta
 
-    ld      b, #REG_ADPCM_B_STOP_H
+_advance_stop:
+    ld      a, (music_seg)
+    ld      c, #2
+    call    write_segment       ; Stop address
+    call    stage_next
+
+    pop     hl
+    pop     de
+    pop     bc
+    ret
+
+;;; Load the start address of the segment after music_seg for the
+;;; hardware repeat to jump to
+stage_next:
+    push    bc
+    push    de
+    call    next_segment
+    ld      (music_staged), a
+    ld      c, a
+    ld      a, d
+    ld      (music_staged_track), a
+    ld      a, e
+    ld      (music_staged_queue), a
+    ld      a, c
+    cp      #MUSIC_NONE
+    jr      z, _stage_done      ; Last pass: check_music_end stops at the jump
+    ld      c, #0
+    call    write_segment
+_stage_done:
+    pop     de
+    pop     bc
+    ret
+
+;;; Segment to play after music_seg: the next one in the track, else the
+;;; queued track's first, else the loop segment, else the next track's first
+;;; Returns: A = segment (MUSIC_NONE to stop), D = its track,
+;;;          E = 1 if it comes from music_queued
+next_segment:
+    push    bc
+    push    hl
+    ld      e, #0
+    ld      a, (music_track)
+    ld      d, a
+    call    music_entry         ; HL = &music_table[track]
+    ld      a, (hl)             ; First segment
+    inc     hl
+    add     a, (hl)             ; + count
+    dec     a
+    ld      b, a                ; B = last segment
+    inc     hl                  ; HL = &loop segment
+    ld      a, (music_seg)
+    cp      b
+    jr      nc, _next_last
+    inc     a
+    jr      _next_done
+_next_last:
+    ld      a, (music_queued)
+    cp      #MUSIC_NONE
+    jr      z, _next_loop
+    inc     e
+    jr      _next_track
+_next_loop:
     ld      a, (hl)
+    cp      #MUSIC_NONE
+    jr      nz, _next_done
     inc     hl
-    call    ym_write_a
+    ld      a, (hl)             ; Next track
+    cp      #MUSIC_NONE
+    jr      z, _next_done
+_next_track:
+    ld      d, a
+    call    music_entry
+    ld      a, (hl)             ; Its first segment
+_next_done:
+    pop     hl
+    pop     bc
+    ret
 
-    ;; Set delta-N (sample rate)
+;;; HL = &music_table[A]
+;;; Each entry: first_seg, seg_count, loop_seg, next_track, delta_l, delta_h (6 bytes)
+music_entry:
+    push    de
+    ld      h, #0
+    ld      l, a
+    add     hl, hl              ; * 2
+    ld      d, h
+    ld      e, l
+    add     hl, hl              ; * 4
+    add     hl, de              ; * 6
+    ld      de, #music_table
+    add     hl, de
+    pop     de
+    ret
+
+;;; Set Delta-N (sample rate) from the music_table entry at HL
+write_delta:
+    push    bc
+    push    hl
+    ld      bc, #4
+    add     hl, bc
     ld      b, #REG_ADPCM_B_DELTA_L
     ld      a, (hl)
     inc     hl
     call    ym_write_a
-
     ld      b, #REG_ADPCM_B_DELTA_H
     ld      a, (hl)
     call    ym_write_a
+    pop     hl
+    pop     bc
+    ret
 
-    ;; Set pan (center)
-    ld      b, #REG_ADPCM_B_PAN
-    ld      a, #0xC0            ; L+R
-    call    ym_write_a
-
-    ;; Set volume
-    ld      b, #REG_ADPCM_B_VOL
-    ld      a, #0xFF            ; Max volume
+;;; Program segment A's start (C = 0) or stop (C = 2) address
+;;; Each music_segments entry: start_l, start_h, stop_l, stop_h (4 bytes),
+;;; in the same order as the START/STOP registers
+write_segment:
+    push    bc
+    push    de
+    push    hl
+    ld      h, #0
+    ld      l, a
+    add     hl, hl
+    add     hl, hl              ; * 4
+    ld      de, #music_segments
+    add     hl, de
+    ld      b, #0
+    add     hl, bc
+    ld      a, #REG_ADPCM_B_START_L
+    add     a, c
+    ld      b, a
+    ld      a, (hl)
+    inc     hl
     call    ym_write_a
-
-    ;; Start with repeat
-    ld      b, #REG_ADPCM_B_CTRL
-    ld      a, #0x90            ; Start + Repeat
+    inc     b                   ; START_H / STOP_H
+    ld      a, (hl)
     call    ym_write_a
-
     pop     hl
     pop     de
     pop     bc
@@ -685,6 +1200,8 @@ stop_music:
     xor     a
     ld      (current_music), a
     ld      (music_paused), a
+    ld      a, #MUSIC_NONE
+    ld      (music_queued), a
 
     pop     bc
     ret
@@ -704,26 +1221,16 @@ pause_music:
     pop     bc
     ret
 
-;;; Resume music playback
+;;; Resume music playback from the start of the current segment
 resume_music:
-    push    bc
-
     ;; Check if actually paused
     ld      a, (music_paused)
     or      a
-    jr      z, _resume_done
-
-    ;; Set start + repeat bits to resume
-    ld      b, #REG_ADPCM_B_CTRL
-    ld      a, #0x90            ; Start + Repeat
-    call    ym_write_a
+    ret     z
 
     xor     a
     ld      (music_paused), a
-
-_resume_done:
-    pop     bc
-    ret
+    jp      music_key_on
 
 ;;; Stop all audio
 stop_all:
@@ -744,7 +1251,7 @@ stop_all:
     ld      (current_music), a
 
     pop     bc
-    ret
+    jp      fm_stop
 
 ;;; Set master volume (A = volume 0-63)
 set_master_volume:
@@ -835,15 +1342,499 @@ ym_wait_data:
 
     .org    0x0800
 
-;;; SFX table: 32 entries, 4 bytes each (start_l, start_h, stop_l, stop_h)
-;;; Addresses are in 256-byte units
+;;; SFX table: 128 entries, 4 bytes each (start_l, start_h, stop_l, stop_h)
+;;; Addresses are in 256-byte units. Entries 32+ are reachable by voice packet only
 sfx_table::
-    .ds     128                 ; 32 * 4 bytes
+    .ds     SFX_COUNT * 4
 
-;;; Music table: 32 entries, 6 bytes each (start_l, start_h, stop_l, stop_h, delta_l, delta_h)
+;;; Music table: 32 entries, 6 bytes each
+;;; (first_seg, seg_count, loop_seg, next_track, delta_l, delta_h)
 music_table::
     .ds     192                 ; 32 * 6 bytes
 
+;;; SFX default priorities: 128 entries, 1 byte each (used when a play names none)
+sfx_priority::
+    .ds     SFX_COUNT
+
+;;; Music segments: 64 entries, 4 bytes each (start_l, start_h, stop_l, stop_h)
+;;; Addresses are in 256-byte units, shared by all tracks
+music_segments::
+    .ds     MUSIC_SEGMENTS * 4
+
+
+;;; === FM/SSG Sequencer (after the sample tables) ===
+
+    .equ    FM_SONGS,       32
+    .equ    FM_PATCHES,     32
+    .equ    FM_PATCH_SIZE,  32      ; 28 operator registers, $B0, $B4, padding
+    .equ    FM_CHANNELS,    7       ; FM 0-3, then SSG A-C
+
+    ;; Sequence commands
+    .equ    SEQ_REST,       0x80
+    .equ    SEQ_WAIT,       0x81
+    .equ    SEQ_PATCH,      0x82
+    .equ    SEQ_VOLUME,     0x83
+    .equ    SEQ_JUMP,       0x84
+    .equ    SEQ_CALL,       0x85
+    .equ    SEQ_RET,        0x86
+
+    ;; fm_channels entry, addressed through IX
+    .equ    CH_PTR,         0       ; Next sequence byte (MSB 0 = channel idle)
+    .equ    CH_WAIT,        2       ; Ticks until the next step
+    .equ    CH_RET,         3       ; Return address of a call
+    .equ    CH_ID,          5       ; 0-3 FM, 4-6 SSG
+    .equ    CH_VOL,         6       ; SSG volume (0-15)
+    .equ    CH_SIZE,        8
+
+;;; Start FM song packet_buf[0]
+fm_play_packet:
+    ld      a, (packet_buf)
+
+;;; Start FM song A (0-31)
+fm_play:
+    cp      #FM_SONGS
+    ret     nc
+    push    bc
+    push    de
+    push    hl
+    push    ix
+
+    ;; HL = &fm_song_table[A]: timer_b, flags, 7 sequence pointers
+    ld      c, a
+    ld      l, a
+    ld      h, #0
+    add     hl, hl
+    add     hl, hl
+    add     hl, hl
+    add     hl, hl              ; * 16
+    ld      de, #fm_song_table
+    add     hl, de
+    ld      a, (hl)
+    or      a
+    jr      z, _fm_play_done    ; No such song
+    ld      (fm_timer), a
+    inc     c
+    ld      a, c
+    ld      (current_fm), a
+    xor     a
+    ld      (fm_paused), a
+    call    fm_silence
+    inc     hl
+    inc     hl
+
+    ld      ix, #fm_channels
+    ld      de, #CH_SIZE
+    ld      c, #0
+    ld      b, #FM_CHANNELS
+_fm_play_loop:
+    ld      a, (hl)
+    ld      CH_PTR(ix), a
+    inc     hl
+    ld      a, (hl)
+    ld      CH_PTR+1(ix), a
+    inc     hl
+    ld      CH_WAIT(ix), #1     ; Step on the first tick
+    ld      CH_ID(ix), c
+    ld      CH_VOL(ix), #15
+    add     ix, de
+    inc     c
+    djnz    _fm_play_loop
+
+    ;; SSG tones on, noise off
+    ld      b, #REG_SSG_MIXER
+    ld      a, #0x38
+    call    ym_write_a
+    call    fm_timer_start
+
+_fm_play_done:
+    pop     ix
+    pop     hl
+    pop     de
+    pop     bc
+    ret
+
+;;; Stop the FM song
+fm_stop:
+    xor     a
+    ld      (current_fm), a
+    ld      (fm_paused), a
+    jr      _fm_halt
+
+;;; Pause the FM song; sounding notes are cut and come back with the next ones
+fm_pause:
+    ld      a, (current_fm)
+    or      a
+    ret     z
+    ld      a, #1
+    ld      (fm_paused), a
+_fm_halt:
+    push    bc
+    ld      b, #REG_TIMER_FLAGS
+    ld      a, #TIMER_STOP
+    call    ym_write_a
+    pop     bc
+    jp      fm_silence
+
+;;; Resume a paused FM song
+fm_resume:
+    ld      a, (fm_paused)
+    or      a
+    ret     z
+    xor     a
+    ld      (fm_paused), a
+
+;;; Run Timer B at the song's tick rate
+fm_timer_start:
+    push    bc
+    ld      b, #REG_TIMER_B
+    ld      a, (fm_timer)
+    call    ym_write_a
+    ld      b, #REG_TIMER_FLAGS
+    ld      a, #TIMER_B_RUN
+    call    ym_write_a
+    pop     bc
+    ret
+
+;;; Key off all FM channels and mute the SSG
+fm_silence:
+    push    bc
+    ld      b, #REG_FM_KEY
+    ld      a, #1
+    call    ym_write_a
+    inc     a
+    call    ym_write_a
+    ld      a, #5
+    call    ym_write_a
+    inc     a
+    call    ym_write_a
+    ld      b, #REG_SSG_VOL
+    xor     a
+    call    ym_write_a
+    inc     b
+    call    ym_write_a
+    inc     b
+    call    ym_write_a
+    pop     bc
+    ret
+
+;;; Step the song on each Timer B overflow
+check_fm_tick:
+    ld      a, (current_fm)
+    or      a
+    ret     z
+    ld      a, (fm_paused)
+    or      a
+    ret     nz
+    in      a, (PORT_YM2610_STATUS_0)
+    bit     1, a                ; Timer B flag
+    ret     z
+
+    ;; Reset the flag; Timer B keeps reloading
+    ld      b, #REG_TIMER_FLAGS
+    ld      a, #TIMER_B_RUN
+    call    ym_write_a
+
+    ld      ix, #fm_channels
+    ld      b, #FM_CHANNELS
+_tick_loop:
+    push    bc
+    ld      a, CH_PTR+1(ix)
+    or      a
+    jr      z, _tick_next       ; Idle or ended
+    dec     CH_WAIT(ix)
+    call    z, fm_step
+_tick_next:
+    ld      de, #CH_SIZE
+    add     ix, de
+    pop     bc
+    djnz    _tick_loop
+    ret
+
+;;; Run channel IX's sequence up to its next duration
+fm_step:
+    ld      l, CH_PTR(ix)
+    ld      h, CH_PTR+1(ix)
+_step_loop:
+    ld      a, (hl)
+    inc     hl
+    cp      #SEQ_REST
+    jr      c, _step_note
+    jr      z, _step_rest
+    cp      #SEQ_WAIT
+    jr      z, _step_wait
+    cp      #SEQ_PATCH
+    jr      z, _step_patch
+    cp      #SEQ_VOLUME
+    jr      z, _step_volume
+    cp      #SEQ_JUMP
+    jr      z, _step_jump
+    cp      #SEQ_CALL
+    jr      z, _step_call
+    cp      #SEQ_RET
+    jr      z, _step_ret
+
+    ;; End of the channel's sequence
+    call    fm_key_off
+    ld      CH_PTR+1(ix), #0
+    ret
+
+_step_note:
+    call    fm_note
+    jr      _step_wait
+_step_rest:
+    call    fm_key_off
+_step_wait:
+    ld      a, (hl)
+    inc     hl
+    ld      CH_WAIT(ix), a
+    ld      CH_PTR(ix), l
+    ld      CH_PTR+1(ix), h
+    ret
+
+_step_patch:
+    ld      a, (hl)
+    inc     hl
+    call    fm_patch
+    jr      _step_loop
+
+_step_volume:
+    ld      a, (hl)
+    inc     hl
+    ld      CH_VOL(ix), a
+    jr      _step_loop
+
+_step_jump:
+    ld      a, (hl)
+    inc     hl
+    ld      h, (hl)
+    ld      l, a
+    jr      _step_loop
+
+_step_call:
+    ld      e, (hl)
+    inc     hl
+    ld      d, (hl)
+    inc     hl
+    ld      CH_RET(ix), l
+    ld      CH_RET+1(ix), h
+    ex      de, hl
+    jr      _step_loop
+
+_step_ret:
+    ld      l, CH_RET(ix)
+    ld      h, CH_RET+1(ix)
+    jr      _step_loop
+
+;;; Play note A (octave << 4 | semitone) on channel IX
+fm_note:
+    push    bc
+    push    de
+    push    hl
+    ld      d, a                ; D = note
+    call    fm_key_off
+
+    ld      a, d
+    and     #0x0F
+    add     a, a
+    ld      c, a
+    ld      b, #0               ; BC = semitone * 2
+
+    ld      a, CH_ID(ix)
+    cp      #4
+    jr      nc, _note_ssg
+
+    ;; FM: one F-number per semitone, the octave is the block
+    ld      hl, #fm_fnum_table
+    add     hl, bc
+    ld      e, (hl)             ; E = F-number LSB
+    inc     hl
+    ld      a, d
+    and     #0x70
+    rrca                        ; Block << 3
+    or      (hl)
+    ld      c, a                ; C = block | F-number MSB
+    ld      a, CH_ID(ix)
+    and     #1
+    add     a, #REG_FM_FNUM_HI + 1
+    ld      b, a
+    ld      a, c
+    call    fm_write            ; MSB first, it is latched by the LSB write
+    ld      a, b
+    sub     #REG_FM_FNUM_HI - REG_FM_FNUM_LO
+    ld      b, a
+    ld      a, e
+    call    fm_write
+    ld      a, CH_ID(ix)
+    call    fm_key_code
+    or      #0xF0               ; All four operators
+    ld      b, #REG_FM_KEY
+    call    ym_write_a
+    jr      _note_done
+
+_note_ssg:
+    ;; SSG: octave 1 periods, halved per octave above (octave 0 plays as 1)
+    ld      hl, #ssg_period_table
+    add     hl, bc
+    ld      a, (hl)
+    inc     hl
+    ld      h, (hl)
+    ld      l, a
+    ld      a, d
+    rrca
+    rrca
+    rrca
+    rrca
+    and     #0x07
+    jr      z, _period_done
+    dec     a
+    jr      z, _period_done
+    ld      b, a
+_period_shift:
+    srl     h
+    rr      l
+    djnz    _period_shift
+_period_done:
+    ld      a, CH_ID(ix)
+    sub     #4
+    add     a, a
+    add     a, #REG_SSG_FINE
+    ld      b, a
+    ld      a, l
+    call    ym_write_a
+    inc     b
+    ld      a, h
+    call    ym_write_a
+    ld      a, CH_ID(ix)
+    add     a, #REG_SSG_VOL - 4
+    ld      b, a
+    ld      a, CH_VOL(ix)
+    call    ym_write_a
+
+_note_done:
+    pop     hl
+    pop     de
+    pop     bc
+    ret
+
+;;; Release the note on channel IX
+fm_key_off:
+    push    af
+    push    bc
+    ld      a, CH_ID(ix)
+    cp      #4
+    jr      nc, _off_ssg
+    call    fm_key_code
+    ld      b, #REG_FM_KEY
+    jr      _off_write
+_off_ssg:
+    add     a, #REG_SSG_VOL - 4
+    ld      b, a
+    xor     a
+_off_write:
+    call    ym_write_a
+    pop     bc
+    pop     af
+    ret
+
+;;; A = key on/off channel code (1, 2, 5, 6) of FM channel A (0-3)
+fm_key_code:
+    cp      #2
+    jr      c, _code_low
+    add     a, #2
+_code_low:
+    inc     a
+    ret
+
+;;; Load patch A into FM channel IX (SSG channels ignore it)
+fm_patch:
+    push    bc
+    push    de
+    push    hl
+    ld      e, a
+    ld      a, CH_ID(ix)
+    cp      #4
+    jr      nc, _patch_done
+    call    fm_key_off
+
+    ld      l, e
+    ld      h, #0
+    add     hl, hl
+    add     hl, hl
+    add     hl, hl
+    add     hl, hl
+    add     hl, hl              ; * FM_PATCH_SIZE
+    ld      de, #fm_patches
+    add     hl, de
+
+    ;; $30-$9C: 7 registers x 4 operators, 4 apart
+    ld      a, CH_ID(ix)
+    and     #1
+    add     a, #REG_FM_DT_MUL + 1
+    ld      b, a
+    ld      c, #28
+_patch_loop:
+    ld      a, (hl)
+    inc     hl
+    call    fm_write
+    ld      a, b
+    add     a, #4
+    ld      b, a
+    dec     c
+    jr      nz, _patch_loop
+
+    ;; Feedback/algorithm at $B0, pan/AMS/PMS at $B4
+    ld      a, b
+    add     a, #0x10
+    ld      b, a
+    ld      a, (hl)
+    inc     hl
+    call    fm_write
+    ld      a, b
+    add     a, #4
+    ld      b, a
+    ld      a, (hl)
+    call    fm_write
+
+_patch_done:
+    pop     hl
+    pop     de
+    pop     bc
+    ret
+
+;;; Write A to register B of FM channel IX's port
+fm_write:
+    bit     1, CH_ID(ix)
+    jp      z, ym_write_a
+    jp      ym_write_b
+
+;;; F-numbers for C-B (block = octave, fM = 8 MHz)
+fm_fnum_table:
+    .dw     617, 654, 693, 734, 778, 824, 873, 925, 980, 1038, 1100, 1165
+
+;;; SSG tone periods for C1-B1 (fM / 64 / frequency)
+ssg_period_table:
+    .dw     3822, 3608, 3405, 3214, 3034, 2863, 2703, 2551, 2408, 2273, 2145, 2025
+
+
+;;; === FM Song Data (fixed at 0x2000) ===
+;;; progear_assets.py generates this; the Makefile patches it in like the
+;;; sample tables. Sequence pointers are Z80 addresses into fm_data
+
+    .org    0x2000
+
+;;; Song table: 32 entries, 16 bytes each
+;;; (timer_b, flags, then 7 sequence pointers, FM 0-3 and SSG A-C, 0 = unused)
+fm_song_table::
+    .ds     FM_SONGS * 16
+
+;;; Patches: 32 entries, FM_PATCH_SIZE bytes each (DT/MUL, TL, KS/AR, AM/DR,
+;;; SR, SL/RR, SSG-EG for each operator in register order, then $B0, $B4)
+fm_patches::
+    .ds     FM_PATCHES * FM_PATCH_SIZE
+
+;;; Sequences, up to the end of the fixed M-ROM area (0x7FFF)
+fm_data::
+
 
 ;;; === Data Section ===
 ;;; Located in Z80 RAM (0xF800-0xFFFF)
@@ -874,4 +1865,61 @@ music_paused:
     .ds     1                   ; 1 if music is paused
 
 pending_pan:
-    .ds     1                   ; Pan value for next SFX (0x80=L, 0xC0=C, 0x40=R)
+    .ds     1                   ; Pan | volume for next SFX (0 = center, volume 31)
+
+pending_channel:
+    .ds     1                   ; Channel for next SFX (0-5, CHANNEL_AUTO)
+
+pending_priority:
+    .ds     1                   ; Priority for next SFX
+
+channel_priority:
+    .ds     6                   ; Priority of the voice last started on each channel
+
+channel_age:
+    .ds     6                   ; Voices started since each channel's (saturates at 255)
+
+music_track:
+    .ds     1                   ; Track of music_seg (0-31)
+
+music_seg:
+    .ds     1                   ; Segment playing
+
+music_staged:
+    .ds     1                   ; Segment in the start registers (MUSIC_NONE = stop)
+
+music_staged_track:
+    .ds     1                   ; Track of music_staged
+
+music_staged_queue:
+    .ds     1                   ; 1 if music_staged starts music_queued
+
+music_queued:
+    .ds     1                   ; Track to play after this one (MUSIC_NONE = none)
+
+current_fm:
+    .ds     1                   ; FM song playing + 1 (0 = none)
+
+fm_paused:
+    .ds     1                   ; 1 if the FM song is paused
+
+fm_timer:
+    .ds     1                   ; Timer B value of the FM song
+
+fm_channels:
+    .ds     FM_CHANNELS * CH_SIZE
+
+packet_cmd:
+    .ds     1                   ; Header of the packet being received
+
+packet_len:
+    .ds     1                   ; Its parameter count
+
+packet_left:
+    .ds     1                   ; Packet parameters still to come (0 = none)
+
+packet_ptr:
+    .ds     2                   ; Where the next parameter goes
+
+packet_buf:
+    .ds     MAX_PACKET_PARAMS
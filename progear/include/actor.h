@@ -31,6 +31,7 @@
 #include <ng_types.h>
 #include <ng_math.h>
 #include <visual.h>
+#include <physics.h>
 
 /**
  * @defgroup actor Actor System
@@ -42,15 +43,26 @@
 /** @name Constants */
 /** @{ */
 
-#define NG_ACTOR_MAX            64     /**< Maximum active actors */
+#ifndef NG_ACTOR_MAX
+#define NG_ACTOR_MAX 64 /**< Default actor table size (see NGEngineConfig) */
+#endif
 #define NG_ACTOR_WIDTH_INFINITE 0xFFFF /**< Infinite width value */
+
+#ifndef NG_ANIM_WHEEL_SIZE
+/**
+ * Buckets in the animation timer wheel (power of two). Frame durations
+ * up to this many ticks cost one visit per frame change; longer ones are
+ * also visited once per lap of the wheel.
+ */
+#define NG_ANIM_WHEEL_SIZE 32
+#endif
 /** @} */
 
 /** @name Handle Type */
 /** @{ */
 
 /** Actor handle type */
-typedef s8 NGActorHandle;
+typedef s16 NGActorHandle;
 
 /** Invalid actor handle */
 #define NG_ACTOR_INVALID (-1)
@@ -143,6 +155,20 @@ fixed NGActorGetY(NGActorHandle actor);
  * @return Z-index
  */
 u8 NGActorGetZ(NGActorHandle actor);
+
+/**
+ * Make an actor follow a physics body.
+ * The scene sync reads the body directly and places the actor at
+ * NGPhysBodyGetDrawPos() plus the offset, so it moves smoothly at step
+ * rates below 60 Hz. Actors whose body did not move (NGBody::moved) are
+ * left where they are. The binding ends at the next sync after the body
+ * is destroyed; unbind first if its slot may be reused before then.
+ * @param actor Actor handle
+ * @param body Body handle, or NULL to unbind
+ * @param offset_x Actor X relative to the body center (fixed-point)
+ * @param offset_y Actor Y relative to the body center (fixed-point)
+ */
+void NGActorBindBody(NGActorHandle actor, NGBodyHandle body, fixed offset_x, fixed offset_y);
 /** @} */
 
 /** @name Animation */
@@ -189,7 +215,8 @@ u8 NGActorAnimDone(NGActorHandle actor);
 void NGActorSetVisible(NGActorHandle actor, u8 visible);
 
 /**
- * Set actor palette.
+ * Set actor palette. The actor holds a reference on a slot palette
+ * (NGPalSlotBorrow()) until it changes palette again or is destroyed.
  * @param actor Actor handle
  * @param palette Palette index (0-255)
  */
@@ -217,6 +244,26 @@ void NGActorSetVFlip(NGActorHandle actor, u8 flip);
  * @param enabled 1 for screen-space, 0 for world-space (default)
  */
 void NGActorSetScreenSpace(NGActorHandle actor, u8 enabled);
+
+/**
+ * Exempt an actor from off-screen culling.
+ * World-space actors outside the camera view (plus NG_CAM_CULL_MARGIN)
+ * normally release their sprites and skip graphic sync until they return.
+ * Always-active actors are synced and drawn wherever they are.
+ * @param actor Actor handle
+ * @param enabled 1 to never cull, 0 for normal culling (default)
+ */
+void NGActorSetAlwaysActive(NGActorHandle actor, u8 enabled);
+
+/**
+ * Bind an actor to a camera (see camera.h).
+ * The actor is positioned, zoomed and culled by that camera's view.
+ * NG_CAMERA_AUTO draws it through the first camera whose view holds it,
+ * which lets split-screen views share one set of actors.
+ * @param actor Actor handle
+ * @param camera NGCameraHandle, NG_CAMERA_AUTO, or 0 for the default camera
+ */
+void NGActorSetCamera(NGActorHandle actor, u8 camera);
 /** @} */
 
 /** @name Audio */
@@ -34,6 +34,32 @@
  * - FIX(0.5): moves at half camera speed (mid-ground)
  * - FIX(0.25): moves at quarter speed (distant background)
  * - 0: doesn't move with camera (fixed on viewport)
+ *
+ * @section backdropbands Line-Scroll Bands
+ * An infinite-width backdrop can be split into horizontal bands, each
+ * with its own horizontal rate, for multi-speed floors and skies. The
+ * layer keeps its sprites: its columns are chained to the first one and
+ * the raster scheduler (ng_raster.h) moves that sprite at each band
+ * boundary, one SCB4 write per band.
+ *
+ * Those writes come from the timer interrupt during active display and
+ * move VRAMADDR, so the main loop must not be writing VRAM at the same
+ * time: bands need deferred drawing (NGEngineSetDeferredDraw()). In a
+ * frame drawn without a display list, a banded layer scrolls as one at
+ * the top band's rate.
+ *
+ * @code
+ * NGEngineSetDeferredDraw(1);
+ * static const u16 rows[] = {0, 96, 128, 160};
+ * static const fixed rates[] = {FIX(0.25), FIX(0.5), FIX(0.75), FIX_ONE};
+ * NGBackdropSetBands(floor, rows, rates, 4);
+ * @endcode
+ *
+ * Keep the asset at most 256 pixels wide so the 36 columns cover the
+ * screen at every offset. While banded backdrops or multiplexed particles
+ * (particles.h) are in the scene, the scene submits the raster table each
+ * frame: add other raster entries before NGEngineFrameEnd() instead of
+ * calling NGRasterSubmit().
  */
 
 #ifndef NG_BACKDROP_H
@@ -53,8 +79,11 @@
 /** @name Constants */
 /** @{ */
 
-#define NG_BACKDROP_MAX            4      /**< Maximum backdrop layers */
+#ifndef NG_BACKDROP_MAX
+#define NG_BACKDROP_MAX 4 /**< Default backdrop table size (see NGEngineConfig) */
+#endif
 #define NG_BACKDROP_WIDTH_INFINITE 0xFFFF /**< Infinite width value */
+#define NG_BACKDROP_MAX_BANDS      8      /**< Maximum line-scroll bands per backdrop */
 /** @} */
 
 /** @name Handle Type */
@@ -124,6 +153,16 @@ void NGBackdropSetViewportPos(NGBackdropHandle backdrop, s16 viewport_x, s16 vie
  * @param z Z-index for render order
  */
 void NGBackdropSetZ(NGBackdropHandle backdrop, u8 z);
+
+/**
+ * Bind a backdrop to a camera (see camera.h).
+ * Viewport positions become relative to that camera's screen band, and
+ * parallax restarts from its current position. Each split-screen view
+ * needs its own backdrop instance.
+ * @param backdrop Backdrop handle
+ * @param camera NGCameraHandle (0 = default camera)
+ */
+void NGBackdropSetCamera(NGBackdropHandle backdrop, u8 camera);
 /** @} */
 
 /** @name Appearance */
@@ -139,11 +178,33 @@ void NGBackdropSetVisible(NGBackdropHandle backdrop, u8 visible);
 /**
  * Set backdrop palette.
  * @param backdrop Backdrop handle
- * @param palette Palette index (0-255)
+ * @param palette Palette index (0-255); a slot palette is held until
+ *                the backdrop changes palette again or is destroyed
  */
 void NGBackdropSetPalette(NGBackdropHandle backdrop, u8 palette);
 /** @} */
 
+/** @name Line-Scroll Bands */
+/** @{ */
+
+/**
+ * Split an infinite-width backdrop into bands with their own horizontal
+ * parallax rates. Band i covers source rows rows[i] up to rows[i+1]; band
+ * 0 also covers everything above it. The parallax_x given at creation is
+ * replaced by the band rates; vertical parallax is unchanged.
+ * Requires deferred drawing (NGEngineSetDeferredDraw()); frames drawn
+ * without a display list scroll the layer as one at the band 0 rate.
+ * @param backdrop Backdrop handle
+ * @param rows First source pixel row of each band, increasing (copied)
+ * @param parallax_x Horizontal rate of each band (copied)
+ * @param count Number of bands (1-NG_BACKDROP_MAX_BANDS), 0 for whole-layer parallax
+ * @return 1 on success, 0 if the backdrop is not infinite-width, the bands
+ *         are invalid, or deferred drawing is off
+ */
+u8 NGBackdropSetBands(NGBackdropHandle backdrop, const u16 *rows, const fixed *parallax_x,
+                      u8 count);
+/** @} */
+
 /** @} */ /* end of backdrop group */
 
 #endif /* NG_BACKDROP_H */
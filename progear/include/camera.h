@@ -28,6 +28,37 @@
  * 2. Move camera with NGCameraMove(dx, dy)
  * 3. Set zoom for dramatic effects
  * 4. Call NGCameraUpdate() each frame
+ *
+ * @section camsplit Multiple Cameras
+ * Camera 0 always exists and is selected by default. NGCameraCreate() adds
+ * more, each with its own position, zoom, shake and tracking, and
+ * NGCameraSetViewport() gives each one a band of the screen. All NGCamera
+ * calls act on the camera chosen with NGCameraSelect(); NGCameraUpdate()
+ * steps every camera. Actors, terrain and backdrops are bound to a camera
+ * (camera 0 unless told otherwise) and are culled against that camera's
+ * band alone.
+ *
+ * An actor bound to NG_CAMERA_AUTO is drawn through the first camera that
+ * sees it, so a versus mode shares one actor set between both halves
+ * instead of creating every actor twice. Terrain and backdrops need one
+ * instance per view, since each graphic has one screen position.
+ *
+ * The hardware cannot clip sprites to a band, so a graphic near a split
+ * can reach up to a tile past it. Cover the split with a fix layer divider
+ * one or two rows tall, and use raster entries at the split line
+ * (NGRasterAddBackdrop(), NGRasterAddPalette()) to give each view its own
+ * colors. Only the 96 sprites per line limit applies per view; the sprite
+ * pools are shared.
+ *
+ * @code
+ * NGCameraHandle p2 = NGCameraCreate();
+ * NGCameraSetViewport(0, 112);          // Camera 0: top half
+ * NGCameraSelect(p2);
+ * NGCameraSetViewport(112, 112);        // Player 2: bottom half
+ * NGCameraTrackActor(player2);
+ * NGCameraSelect(0);
+ * NGActorSetCamera(enemy, NG_CAMERA_AUTO);
+ * @endcode
  */
 
 #ifndef NG_CAMERA_H
@@ -65,6 +96,46 @@
 #define NG_CAM_MAX_WORLD_HEIGHT 512
 /** @} */
 
+/** @name Culling */
+/** @{ */
+
+/**
+ * Extra pixels around the view that still count as visible.
+ * Off-screen actors, backdrops and terrain outside the widened view give
+ * up their hardware sprites until they come back into range.
+ */
+#ifndef NG_CAM_CULL_MARGIN
+#define NG_CAM_CULL_MARGIN 32
+#endif
+/** @} */
+
+/** @name Prediction */
+/** @{ */
+
+#ifndef NG_CAM_PREDICT_FRAMES
+/**
+ * Frames ahead that streaming systems look with NGCameraPredict().
+ * Chunked terrain widens its decode window toward the predicted view and
+ * stops keeping chunks behind a moving camera.
+ */
+#define NG_CAM_PREDICT_FRAMES 16
+#endif
+/** @} */
+
+/** @name Multiple Cameras */
+/** @{ */
+
+#ifndef NG_CAMERA_MAX
+#define NG_CAMERA_MAX 2 /**< Cameras including the default one */
+#endif
+
+/** Camera handle. Camera 0 is the default camera and always exists. */
+typedef u8 NGCameraHandle;
+
+#define NG_CAMERA_INVALID 0xFF /**< No camera / creation failed */
+#define NG_CAMERA_AUTO    0xFE /**< Actor binding: first camera whose view holds the actor */
+/** @} */
+
 /** @name Zoom Levels */
 /** @{ */
 
@@ -150,12 +221,90 @@ u8 NGCameraIsZooming(void);
 u8 NGCameraGetTargetZoom(void);
 
 /**
- * Update camera (call once per frame).
+ * Get how far the camera moved over the last update.
+ * Jumps of more than 64 pixels count as cuts and report 0.
+ * @param vel_x Output X movement per frame
+ * @param vel_y Output Y movement per frame
+ */
+void NGCameraGetVelocity(fixed *vel_x, fixed *vel_y);
+
+/**
+ * Predict the view's top-left corner a number of frames ahead.
+ * Extrapolates the last update's movement; the view size is
+ * NGCameraGetVisibleWidth() by NGCameraGetVisibleHeight(). Streaming code
+ * uses it to prepare data before it scrolls into view.
+ * @param frames Frames ahead (NG_CAM_PREDICT_FRAMES for streaming)
+ * @param x Output predicted world X
+ * @param y Output predicted world Y
+ */
+void NGCameraPredict(u8 frames, fixed *x, fixed *y);
+
+/**
+ * Update all cameras (call once per frame).
  * Handles smooth zoom transitions and effects.
  */
 void NGCameraUpdate(void);
 /** @} */
 
+/** @name Camera Selection */
+/** @{ */
+
+/**
+ * Create another camera at (0,0), 100% zoom, full screen.
+ * It is updated by NGCameraUpdate() but not selected.
+ * @return Camera handle, or NG_CAMERA_INVALID if all NG_CAMERA_MAX are in use
+ */
+NGCameraHandle NGCameraCreate(void);
+
+/**
+ * Destroy a camera created with NGCameraCreate().
+ * Objects still bound to it are drawn through camera 0. Camera 0 cannot
+ * be destroyed.
+ * @param cam Camera handle
+ */
+void NGCameraDestroy(NGCameraHandle cam);
+
+/**
+ * Check whether a handle refers to an existing camera.
+ * @param cam Camera handle
+ * @return 1 if the camera exists
+ */
+u8 NGCameraIsValid(NGCameraHandle cam);
+
+/**
+ * Make a camera the target of all other NGCamera calls.
+ * @param cam Camera handle (invalid handles select camera 0)
+ * @return Previously selected camera, for restoring it afterwards
+ */
+NGCameraHandle NGCameraSelect(NGCameraHandle cam);
+
+/**
+ * Get the selected camera.
+ * @return Camera handle
+ */
+NGCameraHandle NGCameraGetSelected(void);
+
+/**
+ * Set the screen band the selected camera draws into.
+ * Its visible height, culling and screen coordinates follow the band.
+ * @param top First screen line of the band
+ * @param height Lines in the band (0 = to the bottom of the screen)
+ */
+void NGCameraSetViewport(u8 top, u8 height);
+
+/**
+ * Get the first screen line of the selected camera's band.
+ * @return Screen Y (0 for a full-screen camera)
+ */
+u8 NGCameraGetViewportTop(void);
+
+/**
+ * Get the height of the selected camera's band.
+ * @return Lines (SCREEN_HEIGHT for a full-screen camera)
+ */
+u8 NGCameraGetViewportHeight(void);
+/** @} */
+
 /** @name Effects */
 /** @{ */
 
@@ -189,11 +338,23 @@ void NGCameraShakeStop(void);
 u16 NGCameraGetVisibleWidth(void);
 
 /**
- * Get visible world height at current zoom.
+ * Get visible world height of the camera's band at current zoom.
  * @return Height in world pixels
  */
 u16 NGCameraGetVisibleHeight(void);
 
+/**
+ * Check whether a world rectangle overlaps the view.
+ * The view is widened by NG_CAM_CULL_MARGIN on every side except where
+ * its band borders another camera's.
+ * @param x Left edge in world coordinates
+ * @param y Top edge in world coordinates
+ * @param width Width in world pixels
+ * @param height Height in world pixels
+ * @return 1 if any part may be on screen, 0 if culled
+ */
+u8 NGCameraIsRectVisible(fixed x, fixed y, u16 width, u16 height);
+
 /**
  * Clamp camera to world bounds.
  * Prevents showing areas outside the world extent.
@@ -205,7 +366,7 @@ void NGCameraClampToBounds(u16 world_width, u16 world_height);
 
 /**
  * Transform world coordinates to screen coordinates.
- * Applies camera position and zoom.
+ * Applies camera position, zoom and viewport band.
  * @param world_x World X coordinate
  * @param world_y World Y coordinate
  * @param screen_x Output screen X
@@ -267,6 +428,14 @@ void NGCameraSetFollowSpeed(fixed speed);
  */
 void NGCameraSetBounds(u16 world_width, u16 world_height);
 
+/**
+ * Lead the tracked actor by its velocity.
+ * The camera aims where the actor will be after this many frames at its
+ * current (smoothed) speed, so more of the view opens up ahead of it.
+ * @param frames Frames of look-ahead (0 = follow the actor itself, default)
+ */
+void NGCameraSetLookAhead(u8 frames);
+
 /**
  * Set tracking offset from actor center.
  * Use to position the actor ahead of center (e.g., for run-and-gun games).
@@ -43,8 +43,8 @@
 
 #define NG_TILE_SOLID    0x01 /**< Blocks movement (walls/floors) */
 #define NG_TILE_PLATFORM 0x02 /**< One-way platform (solid from above) */
-#define NG_TILE_SLOPE_L  0x04 /**< Left-to-right slope */
-#define NG_TILE_SLOPE_R  0x08 /**< Right-to-left slope */
+#define NG_TILE_SLOPE_L  0x04 /**< 45-degree slope rising left to right (/) */
+#define NG_TILE_SLOPE_R  0x08 /**< 45-degree slope rising right to left (\) */
 #define NG_TILE_HAZARD   0x10 /**< Damages player on contact */
 #define NG_TILE_TRIGGER  0x20 /**< Triggers callback on contact */
 #define NG_TILE_LADDER   0x40 /**< Climbable tile */
@@ -29,6 +29,25 @@
 /** @name Initialization */
 /** @{ */
 
+/**
+ * Object table sizes. The tables are taken from ng_arena_persistent at
+ * init, so a game pays only for the objects it can have at once. Fields
+ * left at 0 get the defaults.
+ */
+typedef struct {
+    u8 actors;           /**< Actors (default NG_ACTOR_MAX) */
+    u8 graphics;         /**< Graphics (default NG_GRAPHIC_MAX); every actor, terrain and backdrop uses one */
+    u8 terrains;         /**< Terrains, up to 127 (default NG_TERRAIN_MAX) */
+    u8 backdrops;        /**< Backdrops, up to 127 (default NG_BACKDROP_MAX) */
+    u8 bodies;           /**< Physics bodies (default NG_PHYS_MAX_BODIES), taken by NGPhysWorldCreate() */
+    u16 particles;       /**< Particle pool size (default 0: no particles) */
+    u8 particle_sprites; /**< Sprites reserved for particles (default NG_PARTICLE_SPRITES) */
+    u8 widgets;          /**< UI widgets (default 0: no widgets) */
+    u8 gauge_sprites;    /**< Sprites reserved for gauge widgets (default 0: no gauges) */
+    u8 text_sprites;     /**< Sprites reserved for sprite text (default 0: no sprite text) */
+    u16 save_size;       /**< Bytes of save data (default 0: no NGSaveOpen()) */
+} NGEngineConfig;
+
 /**
  * Initialize all engine subsystems.
  * Calls: NGArenaSystemInit, NGPalInitDefault, NGPalInitAssets,
@@ -40,6 +59,20 @@
  * no-op default is used.
  */
 void NGEngineInit(void);
+
+/**
+ * Initialize all engine subsystems with chosen table sizes.
+ * Same as NGEngineInit() otherwise.
+ * @code
+ * NGEngineConfig cfg = {.actors = 220, .graphics = 240};  // Bullet-heavy shmup
+ * NGEngineInitWithConfig(&cfg);
+ * @endcode
+ * @param config Table sizes, or NULL for the defaults
+ * @return 1 on success, 0 if ng_arena_persistent (NG_ARENA_PERSISTENT_SIZE)
+ *         cannot hold the tables; object creation then fails for the
+ *         tables that did not fit
+ */
+u8 NGEngineInitWithConfig(const NGEngineConfig *config);
 /** @} */
 
 /** @name Main Loop */
@@ -47,17 +80,106 @@ void NGEngineInit(void);
 
 /**
  * Call at the start of each frame (top of main loop).
- * Calls: NGWaitVBlank, NGWatchdogKick, NGArenaReset(&ng_arena_frame), NGInputUpdate
+ * Calls: NGIdleRun, NGWaitVBlank, NGWatchdogKick, NGAudioUpdate,
+ *        NGArenaReset(&ng_arena_frame), NGInputUpdate
+ * NGIdleRun() spends the lines left before VBlank on idle jobs (ng_idle.h);
+ * the engine registers one that unpacks queued data (ng_decomp.h).
+ * Opens a display list in the frame arena when deferred drawing is enabled.
+ * If the last frame overran VBlank, waits one more VBlank so the list it
+ * submitted is replayed before the frame arena is reset.
  */
 void NGEngineFrameStart(void);
 
 /**
  * Call at the end of each frame (bottom of main loop).
- * Calls: NGSceneUpdate, NGSceneDraw, and draws the active menu if set.
+ * Calls: NGSpringSystemUpdate, NGSceneUpdate, NGWidgetsDraw, NGSceneDraw, and draws the
+ *        active menu if set.
+ * Submits the frame's display list for VBlank replay if one is recording,
+ * then schedules the fix layer flush as a VBlank job (ng_vblank.h), so both
+ * reach VRAM inside the next VBlank interrupt. The flush is not pending
+ * while NGSceneDraw() runs. Skips NGSceneDraw() when
+ * frame skip drops this frame's draw (see NGEngineSetFrameSkip()).
  */
 void NGEngineFrameEnd(void);
 /** @} */
 
+/** @name Deferred Drawing */
+/** @{ */
+
+/**
+ * Enable or disable deferred sprite drawing.
+ * When enabled, SCB writes made between NGEngineFrameStart() and
+ * NGEngineFrameEnd() are recorded into a display list and replayed at the
+ * start of the next VBlank, so sprites never tear mid-frame.
+ * Takes effect at the next NGEngineFrameStart(). Disabled by default.
+ * @param enabled 1 to defer VRAM writes, 0 to write immediately
+ */
+void NGEngineSetDeferredDraw(u8 enabled);
+
+/**
+ * Check whether deferred sprite drawing is enabled.
+ * @return 1 if enabled, 0 otherwise
+ */
+u8 NGEngineGetDeferredDraw(void);
+/** @} */
+
+/** @name Frame Skip
+ * A frame whose logic runs past VBlank leaves the previous picture up for
+ * another VBlank, and the game slows down. The engine counts the VBlanks
+ * between the ends of consecutive frames to see this. With frame skip on,
+ * the frame after a late one still runs its logic but skips NGSceneDraw(),
+ * and with it the graphic sync and every VRAM write it would make, so the
+ * game catches up instead of slowing down. The screen then shows the last
+ * drawn frame; skipped changes go out with the next draw.
+ */
+/** @{ */
+
+/** Frame timing since NGEngineInit() or NGEngineResetFrameStats() */
+typedef struct {
+    u32 frames;        /**< Frames ended */
+    u16 late;          /**< Frames that took more than one VBlank */
+    u16 dropped;       /**< VBlanks that showed no new frame because one was late */
+    u16 skipped_draws; /**< Frames that skipped NGSceneDraw() */
+    u8 worst;          /**< Most VBlanks one frame took */
+} NGEngineFrameStats;
+
+/**
+ * Skip the scene draw after late frames.
+ * Off after NGEngineInit().
+ * @code
+ * NGEngineSetFrameSkip(2);  // Boss fight: draw at least every third frame
+ * @endcode
+ * @param max_skips Most frames in a row that may skip their draw, 0 for off
+ */
+void NGEngineSetFrameSkip(u8 max_skips);
+
+/** @return Most frames in a row that may skip their draw, 0 if off */
+u8 NGEngineGetFrameSkip(void);
+
+/**
+ * VBlanks the last frame took: 1 on time, more after a late frame. Logic
+ * that steps movement or timers by it keeps its speed even without frame
+ * skip.
+ * @return VBlanks (at least 1, at most 255)
+ */
+u8 NGEngineFrameVBlanks(void);
+
+/**
+ * Check whether this frame skips its scene draw.
+ * @return 1 if NGEngineFrameEnd() will not call NGSceneDraw()
+ */
+u8 NGEngineIsSkippingDraw(void);
+
+/**
+ * Get frame timing statistics.
+ * @param[out] out Counts so far
+ */
+void NGEngineGetFrameStats(NGEngineFrameStats *out);
+
+/** Zero the frame timing statistics. */
+void NGEngineResetFrameStats(void);
+/** @} */
+
 /** @name Active Menu */
 /** @{ */
 
@@ -75,6 +197,27 @@ void NGEngineSetActiveMenu(NGMenuHandle menu);
 NGMenuHandle NGEngineGetActiveMenu(void);
 /** @} */
 
+/** @name Profiling
+ * Profiler slots used by the engine when built with NG_PROFILE
+ * (see ng_profile.h). Game code can use slots from NG_PROF_USER upward.
+ */
+/** @{ */
+
+/** Engine profiler slots */
+typedef enum {
+    NG_PROF_INPUT = 0,     /**< NGInputUpdate */
+    NG_PROF_LIGHTING,      /**< NGLightingUpdate */
+    NG_PROF_CAMERA,        /**< NGCameraUpdate */
+    NG_PROF_ACTORS,        /**< Actor animation update */
+    NG_PROF_SYNC_BACKDROP, /**< Backdrop graphic sync */
+    NG_PROF_SYNC_TERRAIN,  /**< Terrain graphic sync */
+    NG_PROF_SYNC_ACTORS,   /**< Actor graphic sync */
+    NG_PROF_GRAPHIC_DRAW,  /**< NGGraphicSystemDraw */
+    NG_PROF_IDLE,          /**< NGIdleRun */
+    NG_PROF_USER           /**< First slot free for game code */
+} NGEngineProfileSlot;
+/** @} */
+
 /** @} */ /* end of engine group */
 
 #endif /* NG_ENGINE_H */
@@ -44,6 +44,7 @@
 #define NG_GRAPHIC_H
 
 #include <ng_types.h>
+#include <ng_hardware.h>
 #include <visual.h>
 
 /**
@@ -56,8 +57,48 @@
 /** @name Types and Enums */
 /** @{ */
 
-/** Maximum graphics that can be active simultaneously */
+/**
+ * Default graphic table size (up to 255, see NGEngineConfig). Every actor,
+ * terrain and backdrop takes one graphic.
+ */
+#ifndef NG_GRAPHIC_MAX
 #define NG_GRAPHIC_MAX 64
+#endif
+
+/**
+ * Hardware auto-animation speed set by NGGraphicSystemInit(): each frame
+ * of an auto-animated graphic lasts this + 1 video frames.
+ */
+#ifndef NG_GRAPHIC_AUTOANIM_SPEED
+#define NG_GRAPHIC_AUTOANIM_SPEED 7
+#endif
+
+/**
+ * Scrolling tilemaps (terrain) load at most this many new columns per
+ * frame; 0 = no limit. Columns waiting for their turn are moved
+ * off-screen, so a camera cut reveals the new view over a few frames
+ * instead of stalling one. See NGGraphicSetScrollBudget().
+ */
+#ifndef NG_GRAPHIC_SCROLL_COLS
+#define NG_GRAPHIC_SCROLL_COLS 4
+#endif
+
+/**
+ * Tile rows a scrolling tilemap updates per frame before it treats the
+ * jump as a cut and reloads column by column instead; 0 = no limit.
+ */
+#ifndef NG_GRAPHIC_SCROLL_ROWS
+#define NG_GRAPHIC_SCROLL_ROWS 4
+#endif
+
+/**
+ * Sprite columns whose tiles the next scene's graphics upload per frame
+ * while it is staged (see NGSceneStageBegin()). A graphic wider than this
+ * still uploads in one frame, alone.
+ */
+#ifndef NG_GRAPHIC_STAGE_COLS
+#define NG_GRAPHIC_STAGE_COLS 8
+#endif
 
 /** Scale value representing 1.0x (no scaling) */
 #define NG_GRAPHIC_SCALE_ONE 256
@@ -146,6 +187,11 @@ void NGGraphicDestroy(NGGraphic *g);
 /**
  * Set source from a visual asset.
  *
+ * A metasprite asset (NGVisualAsset.parts) takes as many hardware
+ * sprites as the current frame has parts, whatever the graphic's size,
+ * and places them in the asset's frame box. Frames with the same part
+ * count keep their sprites.
+ *
  * @param g Graphic
  * @param asset Visual asset (provides tile data and dimensions)
  * @param palette Palette index (0-255)
@@ -212,6 +258,19 @@ void NGGraphicSetSourceOffset(NGGraphic *g, s16 x, s16 y);
  */
 void NGGraphicSetFrame(NGGraphic *g, u16 frame);
 
+/**
+ * Let the hardware animate the source.
+ * Tiles are drawn with the LSPC auto-animation attribute, so each one
+ * cycles through the 4 or 8 consecutive tiles of its aligned group at
+ * the speed set by NGSpriteAutoAnimSetSpeed(), costing no VRAM writes per
+ * frame. NGGraphicSetSource() sets this from the asset's auto_anim; other
+ * sources start with it off.
+ *
+ * @param g Graphic
+ * @param frames 4 or 8 to enable, 0 to disable
+ */
+void NGGraphicSetAutoAnim(NGGraphic *g, u8 frames);
+
 /**
  * Mark source as changed, forcing reload on next commit.
  */
@@ -249,6 +308,15 @@ void NGGraphicSetSize(NGGraphic *g, u16 width, u16 height);
  */
 void NGGraphicSetScale(NGGraphic *g, u16 scale);
 
+/**
+ * Draw with another palette, keeping the source. Unlike
+ * NGGraphicSetSource(), the palette's colors are left as they are.
+ *
+ * @param g Graphic
+ * @param palette Palette index (0-255)
+ */
+void NGGraphicSetPalette(NGGraphic *g, u8 palette);
+
 /**
  * Set flip flags.
  *
@@ -281,6 +349,13 @@ void NGGraphicSetLayer(NGGraphic *g, NGGraphicLayer layer);
  * Configure 9-slice border sizes in pixels.
  * Only used when tile_mode is NG_GRAPHIC_TILE_9SLICE.
  *
+ * A panel larger than its source repeats the first column and row past the
+ * left and top borders; the rest of the source, right and bottom borders
+ * included, follows. Resizing with NGGraphicSetSize() keeps the panel's
+ * sprites and rewrites only the columns and rows that moved, and a height
+ * change within the same tile row count only rewrites sprite heights, so
+ * open and close animations can resize every frame.
+ *
  * @param g Graphic
  * @param top Top border height in pixels
  * @param bottom Bottom border height in pixels
@@ -364,6 +439,149 @@ s16 NGGraphicGetX(const NGGraphic *g);
 s16 NGGraphicGetY(const NGGraphic *g);
 /** @} */
 
+/** @name Sprite Budget */
+/** @{ */
+
+/** Hardware limit on sprites sharing one scanline */
+#define NG_GRAPHIC_LINE_LIMIT 96
+
+/** Visible scanlines checked by the line estimator */
+#define NG_GRAPHIC_SCREEN_LINES 224
+
+/**
+ * Hardware sprite usage, updated by every NGGraphicSystemDraw().
+ * When a sprite pool is full, the lowest-priority graphics are culled
+ * first (see NGGraphicSetPriority()).
+ */
+typedef struct {
+    u16 layer_sprites[NG_GRAPHIC_LAYER_UI + 1]; /**< Sprites in use per layer */
+    u16 entity_free;                            /**< Unused sprites in the main pool */
+    u16 ui_free;                                /**< Unused sprites in the UI pool */
+    u8 culled_graphics;                         /**< Visible graphics not drawn this frame */
+    u16 culled_sprites;                         /**< Sprites those graphics needed */
+    u16 overflow_frames; /**< Frames with culled graphics since last reset */
+    u8 line_peak;        /**< Most sprites on one line (0 unless line check is on) */
+    u8 line_peak_y;      /**< Screen line where line_peak occurs */
+    u8 lines_over;       /**< Lines exceeding NG_GRAPHIC_LINE_LIMIT */
+} NGGraphicBudget;
+
+/**
+ * Set culling priority.
+ * When sprites run out, lower priorities are dropped first; ties drop
+ * the graphic that renders last. Default is 0.
+ *
+ * @param g Graphic
+ * @param priority 0 = first to go, 255 = last to go
+ */
+void NGGraphicSetPriority(NGGraphic *g, u8 priority);
+
+/**
+ * Get sprite usage from the last draw.
+ *
+ * @param[out] out Budget statistics
+ */
+void NGGraphicGetBudget(NGGraphicBudget *out);
+
+/**
+ * Clear the overflow frame counter.
+ */
+void NGGraphicResetBudget(void);
+
+/**
+ * Enable the per-scanline sprite estimator.
+ * Each draw then counts, from position and scaled height, how many
+ * sprites cover each visible line and reports lines above
+ * NG_GRAPHIC_LINE_LIMIT (the hardware drops sprites past it). Costs a
+ * pass over NG_GRAPHIC_SCREEN_LINES per frame, so leave it off in
+ * release builds.
+ *
+ * @param enabled 1 = estimate every draw, 0 = off (default)
+ */
+void NGGraphicSetLineCheck(u8 enabled);
+
+/**
+ * Set how much work a scrolling tilemap may do in one frame.
+ * Column loads over the budget wait for later frames with their sprites
+ * off-screen; row jumps over the budget reload by columns. Graphics
+ * wider than 32 columns always load at once.
+ *
+ * @param columns Column loads per frame (0 = unlimited, default NG_GRAPHIC_SCROLL_COLS)
+ * @param rows Row updates per frame (0 = unlimited, default NG_GRAPHIC_SCROLL_ROWS)
+ */
+void NGGraphicSetScrollBudget(u8 columns, u8 rows);
+
+/**
+ * Check whether a scrolling tilemap still has columns waiting to load.
+ *
+ * @param g Graphic
+ * @return 1 while part of it is hidden for lack of budget
+ */
+u8 NGGraphicIsScrollPending(const NGGraphic *g);
+/** @} */
+
+#if NG_VRAM_STATS
+/** @name VRAM Traffic (NG_VRAM_STATS builds) */
+/** @{ */
+
+/**
+ * VRAM writes charged to a graphic: hiding sprites it left, its flush
+ * and its SCB2 run. A graphic that writes every frame while it looks
+ * still is defeating the dirty tracking. Writes from interrupt handlers
+ * other than VBlank jobs may be charged to the graphic being drawn.
+ */
+typedef struct {
+    u16 words[4];      /**< Words written last frame to SCB1-SCB4 (NG_VRAM_AREA_*) */
+    u16 setups;        /**< VRAM address setups last frame */
+    u32 total_words;   /**< Words written since creation or NGGraphicResetTraffic() */
+    u16 first_draws;   /**< Full redraws into newly allocated sprites */
+    u16 sprite_moves;  /**< Full redraws after moving to other sprites */
+    u16 count_changes; /**< Full redraws after the sprite count changed */
+} NGGraphicTraffic;
+
+/**
+ * Get the VRAM traffic charged to a graphic.
+ *
+ * @param g Graphic
+ * @param[out] out Traffic statistics (zeroed if g is NULL)
+ */
+void NGGraphicGetTraffic(const NGGraphic *g, NGGraphicTraffic *out);
+
+/**
+ * Get the summed VRAM traffic of a layer's graphics.
+ *
+ * @param layer Render layer
+ * @param[out] out Traffic statistics
+ */
+void NGGraphicGetLayerTraffic(NGGraphicLayer layer, NGGraphicTraffic *out);
+
+/**
+ * Clear every graphic's totals and redraw counts.
+ */
+void NGGraphicResetTraffic(void);
+
+/**
+ * List the graphics that wrote the most words since the last reset.
+ *
+ * @param[out] out Graphics, most words first
+ * @param count Size of out
+ * @return Number of graphics stored
+ */
+u8 NGGraphicGetHottest(NGGraphic **out, u8 count);
+
+/**
+ * Print the graphics that wrote the most words to the fix layer.
+ * One row per graphic: table index, layer, last frame's words per SCB,
+ * total words and full redraws since the last reset.
+ *
+ * @param x Fix layer column
+ * @param y Fix layer row of the header line
+ * @param palette Fix layer palette
+ * @param rows Graphics listed (up to 16)
+ */
+void NGGraphicDrawTraffic(u8 x, u8 y, u8 palette, u8 rows);
+/** @} */
+#endif
+
 /** @} */ /* end of graphic group */
 
 #endif /* NG_GRAPHIC_H */
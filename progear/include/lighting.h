@@ -301,6 +301,20 @@ void NGLightingUpdate(void);
  * Normally not needed, but useful after directly modifying palettes.
  */
 void NGLightingInvalidate(void);
+
+/**
+ * Limit how many palettes are recomputed per update.
+ *
+ * With a budget, a transform change is spread over several frames: each
+ * NGLightingUpdate() resolves up to max_palettes palettes, round-robin.
+ * Palettes no visible graphic uses are skipped, with or without a budget,
+ * and catch up on the frame something shows them again. The per-frame
+ * cost stays bounded. Pre-baked preset steps are plain copies and are not
+ * sliced.
+ *
+ * @param max_palettes Palettes per update (0 = all at once, the default)
+ */
+void NGLightingSetPaletteBudget(u8 max_palettes);
 /** @} */
 
 /** @name State Queries */
@@ -334,6 +348,12 @@ typedef void (*NGLightingApplyStepFn)(u8 preset_id, u8 step);
  */
 typedef const void *(*NGLightingGetInfoFn)(u8 preset_id);
 
+/**
+ * Function pointer type for moving a preset between adjacent steps.
+ * Writes only the colors that differ between from_step and to_step.
+ */
+typedef void (*NGLightingApplyDeltaFn)(u8 preset_id, u8 from_step, u8 to_step);
+
 /**
  * Register pre-baked preset functions.
  *
@@ -343,6 +363,14 @@ typedef const void *(*NGLightingGetInfoFn)(u8 preset_id);
  */
 void NGLightingRegisterPrebaked(NGLightingApplyStepFn apply_fn, NGLightingGetInfoFn info_fn);
 
+/**
+ * Register the step delta applier for pre-baked presets.
+ *
+ * Optional: without it every fade step is a full palette copy. Called by
+ * the generated NGLightingInitPresets().
+ */
+void NGLightingRegisterPrebakedDelta(NGLightingApplyDeltaFn delta_fn);
+
 /**
  * Initialize pre-baked lighting presets.
  *
@@ -0,0 +1,133 @@
+/*
+ * This file is part of ProGearSDK.
+ * Copyright (c) 2024-2025 ProGearSDK contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+/**
+ * @file particles.h
+ * @brief Compact pool for bullets and particles.
+ *
+ * Particles are single 16x16 tiles with a position, a velocity and a
+ * lifetime. They skip the actor and graphic layers: the pool keeps each
+ * field in its own array, moves every particle in one loop, and draws
+ * into a block of hardware sprites set aside for it at engine init.
+ * Drawing writes only the Y/height and X words of each sprite. Tile words
+ * are written when a sprite shows a different tile or palette than last
+ * frame, and the shrink words only once.
+ *
+ * The pool can hold more particles than it has sprites. Those past the
+ * sprite count keep moving and colliding but are not drawn until earlier
+ * ones die. Particles are drawn at full size at the camera position and
+ * on top of all graphics below the UI; camera zoom is not applied.
+ *
+ * @code
+ * NGEngineConfig cfg = {.particles = 256, .particle_sprites = 64};
+ * NGEngineInitWithConfig(&cfg);
+ *
+ * NGParticlesSetBounds(0, 0, FIX(320), FIX(224));  // Cull off-screen bullets
+ * NGParticleSpawn(x, y, FIX(4), 0, NG_PARTICLE_FOREVER, BULLET_TILE, BULLET_PAL);
+ *
+ * // Per frame, after NGSceneUpdate() has moved them:
+ * if (NGParticlesHit(player_x, player_y, FIX(4), FIX(4), 1))
+ *     player_hurt();
+ * @endcode
+ *
+ * @section partmux Multiplexing
+ * With NGParticlesSetMultiplex() and deferred drawing
+ * (NGEngineSetDeferredDraw()), a sprite can show several particles per
+ * frame. Particles are sorted into 28-line bands down the screen. Once
+ * every sprite is taken, a particle can reuse a sprite whose particle
+ * ended above its band and shows the same tile and palette: the raster
+ * scheduler (ng_raster.h) moves the sprite as the beam passes, at two
+ * table entries per reuse. Bullets sharing a few tiles and spread down
+ * the screen gain the most. Particles that find no sprite, or arrive once
+ * the raster table is full, are skipped for the frame, as without
+ * multiplexing. Immediate drawing always uses one sprite per particle.
+ * A frame that skips NGSceneDraw() shows only the last band's particles
+ * on reused sprites.
+ */
+
+#ifndef NG_PARTICLES_H
+#define NG_PARTICLES_H
+
+#include <ng_types.h>
+#include <ng_math.h>
+
+/**
+ * @defgroup particles Particles
+ * @ingroup sdk
+ * @brief Bullets and effects drawn from a reserved sprite block.
+ * @{
+ */
+
+/** Sprites reserved when NGEngineConfig.particle_sprites is 0 */
+#define NG_PARTICLE_SPRITES 32
+
+/** Lifetime for particles that live until they leave the bounds or are hit */
+#define NG_PARTICLE_FOREVER 0
+
+/**
+ * Add a particle. Its position is the center of its tile.
+ * @param x, y World position
+ * @param vx, vy Velocity in pixels per frame
+ * @param life Frames to live, or NG_PARTICLE_FOREVER
+ * @param tile C-ROM tile index
+ * @param palette Palette index
+ * @return 1 on success, 0 if the pool is full or was not configured
+ */
+u8 NGParticleSpawn(fixed x, fixed y, fixed vx, fixed vy, u8 life, u16 tile, u8 palette);
+
+/**
+ * Move all particles one frame and drop the ones whose life ran out or
+ * that left the bounds. Called by NGSceneUpdate().
+ */
+void NGParticlesUpdate(void);
+
+/**
+ * Set a velocity change applied to every particle each frame.
+ * @param gx, gy Pixels per frame squared (0 to disable)
+ */
+void NGParticlesSetGravity(fixed gx, fixed gy);
+
+/**
+ * Drop particles that leave a world rectangle. Disabled by default.
+ * @param left, top, right, bottom World bounds
+ */
+void NGParticlesSetBounds(fixed left, fixed top, fixed right, fixed bottom);
+
+/** Stop dropping particles outside the bounds. */
+void NGParticlesClearBounds(void);
+
+/**
+ * Count the particles whose center lies inside a box, e.g. bullets
+ * hitting the player.
+ * @param x, y Box center
+ * @param half_w, half_h Box half size
+ * @param kill Nonzero to remove the particles found
+ * @return Number of particles inside
+ */
+u16 NGParticlesHit(fixed x, fixed y, fixed half_w, fixed half_h, u8 kill);
+
+/** Remove every particle. */
+void NGParticlesClear(void);
+
+/** @return Number of live particles */
+u16 NGParticlesCount(void);
+
+/** @return Number of particles the pool can hold */
+u16 NGParticlesCapacity(void);
+
+/**
+ * Let sprites show more than one particle per frame (see @ref partmux).
+ * Off by default.
+ * @param enable Nonzero to multiplex
+ */
+void NGParticlesSetMultiplex(u8 enable);
+
+/** @return Number of particles drawn by the last NGSceneDraw() */
+u16 NGParticlesGetDrawn(void);
+
+/** @} */
+
+#endif /* NG_PARTICLES_H */
@@ -12,13 +12,45 @@
  * - Rigid bodies with position, velocity, acceleration
  * - Circle and AABB collision shapes
  * - Collision detection and response
+ * - Uniform-grid broadphase (only nearby bodies reach the narrowphase)
+ * - Automatic sleeping for bodies at rest
  * - Automatic screen bounds handling
+ * - Enter/exit events for hazard, trigger and ladder tiles
  *
  * @section physusage Usage
  * 1. Create a world with NGPhysWorldCreate()
  * 2. Set bounds with NGPhysWorldSetBounds()
  * 3. Create bodies with NGPhysBodyCreateCircle() or NGPhysBodyCreateAABB()
  * 4. Call NGPhysWorldUpdate() each frame
+ *
+ * @section physstep Fixed Timestep
+ * Velocities, gravity and acceleration are per 60 Hz frame. By default
+ * every update runs one step. NGPhysWorldSetStepRate() lowers the step
+ * rate to save CPU, e.g. to 30 Hz in heavy scenes. Each step then covers
+ * several frames and updates only run a step once enough frames have built
+ * up. NGPhysWorldAdvance() also takes the number of frames that really
+ * passed, so slowdown frames do not slow the game. Draw bodies at
+ * NGPhysBodyGetDrawPos(), or bind an actor with NGActorBindBody(), to move
+ * smoothly between steps. Drawing then trails the simulation by up to one
+ * step less one frame.
+ *
+ * @section phystileevents Tile Events
+ * Bodies moving against a terrain can watch tile flags such as
+ * NG_TILE_HAZARD or NG_TILE_TRIGGER with NGPhysBodyWatchTiles(). After the
+ * terrain pass, each watching body whose set of touched flags changed gets
+ * one NGTileEvent in a list taken from ng_arena_frame. Drain it with
+ * NGPhysWorldGetTileEvents() after NGPhysWorldUpdate(), in the same frame.
+ * Bodies that touch the same flags as last update cost one tile scan and
+ * emit nothing.
+ *
+ * @section physpairs Layer Pairs
+ * A body's layer for dispatch is the lowest set bit of its collision_layer.
+ * NGPhysWorldSetPairCallback() gives a pair of layers its own handler, called
+ * instead of the one passed to NGPhysWorldUpdate(), so game code need not
+ * sort out what hit what. NGPhysWorldIgnorePair() drops a pair before the
+ * narrowphase. Pairs with an NG_BODY_TRIGGER body only test for overlap:
+ * they are never pushed apart and their NGCollision has a zero normal and
+ * penetration.
  */
 
 #ifndef NG_PHYSICS_H
@@ -26,6 +58,7 @@
 
 #include <ng_types.h>
 #include <ng_math.h>
+#include <terrain.h>
 
 /**
  * @defgroup physics Physics Engine
@@ -37,7 +70,31 @@
 /** @name Configuration */
 /** @{ */
 
-#define NG_PHYS_MAX_BODIES 32 /**< Maximum bodies per world */
+/**
+ * Default number of bodies in the world (up to 255). Games pick their own
+ * count with NGEngineConfig::bodies; the body table is taken from
+ * ng_arena_persistent by the first NGPhysWorldCreate().
+ */
+#ifndef NG_PHYS_MAX_BODIES
+#define NG_PHYS_MAX_BODIES 32
+#endif
+
+/** Default broadphase cell size in pixels */
+#define NG_PHYS_DEFAULT_CELL_SIZE 64
+
+/** Default sleep velocity threshold (per axis, pixels per frame) */
+#define NG_PHYS_DEFAULT_SLEEP_VELOCITY (FIX_ONE / 32)
+
+/** Default number of slow frames before a body falls asleep */
+#define NG_PHYS_DEFAULT_SLEEP_FRAMES 60
+
+/** Most steps NGPhysWorldAdvance() runs per call; further slowdown is dropped */
+#ifndef NG_PHYS_MAX_STEPS
+#define NG_PHYS_MAX_STEPS 4
+#endif
+
+/** Collision layers, one per bit of NGBody::collision_layer */
+#define NG_PHYS_LAYERS 8
 /** @} */
 
 /** @name Collision Shapes */
@@ -73,6 +130,8 @@ typedef struct NGBody {
     u8 flags;  /**< Body flags */
 
     NGVec2 pos;   /**< Center position */
+    NGVec2 prev_pos; /**< Center position before the last step */
+    u8 moved;        /**< pos changed in the last step or was set since */
     NGVec2 vel;   /**< Velocity */
     NGVec2 accel; /**< Acceleration */
 
@@ -83,6 +142,12 @@ typedef struct NGBody {
     NGShape shape;      /**< Collision shape */
     u8 collision_mask;  /**< Layers this body collides with */
     u8 collision_layer; /**< Layer this body is on */
+    u8 layer_index;     /**< Lowest set bit of collision_layer (internal) */
+    u8 rest_frames;     /**< Consecutive frames below the sleep threshold */
+    u8 live_index;      /**< Position in the world's live list (internal) */
+    u8 terrain_hit;     /**< NG_COLL_* flags from the last terrain pass */
+    u8 tile_watch;      /**< NG_TILE_* flags reported as tile events */
+    u8 tile_touch;      /**< Watched NG_TILE_* flags touched after the last terrain pass */
 
     void *user_data; /**< User-defined data */
 } NGBody;
@@ -93,32 +158,21 @@ typedef struct NGBody {
 /** Body ignores world gravity */
 #define NG_BODY_NO_GRAVITY 0x02
 
-/** Body detects collision but doesn't respond */
+/** Body detects overlap only: no response, normal or penetration */
 #define NG_BODY_TRIGGER 0x04
 
+/** Body is asleep (set and cleared automatically) */
+#define NG_BODY_SLEEPING 0x08
+
 /** Body handle */
 typedef NGBody *NGBodyHandle;
-/** @} */
 
-/** @name Physics World */
-/** @{ */
-
-/** Physics world */
-typedef struct NGPhysWorld {
-    u8 active;      /**< World is active */
-    NGVec2 gravity; /**< World gravity */
-
-    fixed bounds_left;   /**< Left boundary */
-    fixed bounds_right;  /**< Right boundary */
-    fixed bounds_top;    /**< Top boundary */
-    fixed bounds_bottom; /**< Bottom boundary */
-    u8 bounds_enabled;   /**< Bounds checking enabled */
-
-    NGBody bodies[NG_PHYS_MAX_BODIES]; /**< Body pool */
-} NGPhysWorld;
-
-/** World handle */
-typedef NGPhysWorld *NGPhysWorldHandle;
+/** Change in the watched tile flags a body touches */
+typedef struct {
+    NGBodyHandle body; /**< Body (check active: a callback may have destroyed it) */
+    u8 entered;        /**< NG_TILE_* flags touched now but not last update */
+    u8 exited;         /**< NG_TILE_* flags touched last update but not now */
+} NGTileEvent;
 /** @} */
 
 /** @name Collision Info */
@@ -141,12 +195,56 @@ typedef struct {
 typedef void (*NGCollisionCallback)(NGCollision *collision, void *user_data);
 /** @} */
 
+/** @name Physics World */
+/** @{ */
+
+/** Physics world */
+typedef struct NGPhysWorld {
+    u8 active;      /**< World is active */
+    NGVec2 gravity; /**< World gravity */
+
+    fixed bounds_left;    /**< Left boundary */
+    fixed bounds_right;   /**< Right boundary */
+    fixed bounds_top;     /**< Top boundary */
+    fixed bounds_bottom;  /**< Bottom boundary */
+    u8 bounds_enabled;    /**< Bounds checking enabled */
+    u8 cell_shift;        /**< Broadphase cell size as log2(pixels) */
+    u8 sleep_frames;      /**< Slow frames before sleeping */
+    fixed sleep_velocity; /**< Sleep threshold per axis (0 = never sleep) */
+    NGTerrainHandle terrain; /**< Terrain bodies move against, or NG_TERRAIN_INVALID */
+    fixed step;        /**< Frames per step (FIX_ONE at 60 Hz) */
+    fixed inv_step;    /**< 1 / step */
+    fixed accumulator; /**< Frames not yet simulated */
+    fixed alpha;       /**< Draw position between prev_pos (0) and pos (FIX_ONE) */
+
+    NGBody *bodies;    /**< Body table (capacity entries) */
+    u8 *live;          /**< Indices of active bodies, live_count of them */
+    u8 capacity;       /**< Size of the body table */
+    u8 live_count;     /**< Active bodies */
+    u8 updating;       /**< Inside NGPhysWorldUpdate() (internal) */
+    u8 removed;        /**< Bodies destroyed during the update (internal) */
+    NGTileEvent *tile_events; /**< This update's tile events (ng_arena_frame) */
+    u8 tile_event_count;      /**< Entries in tile_events */
+    NGCollisionCallback pair_callback[NG_PHYS_LAYERS][NG_PHYS_LAYERS]; /**< Per-pair handlers */
+    void *pair_data[NG_PHYS_LAYERS][NG_PHYS_LAYERS];                   /**< Their user data */
+    u8 pair_swap[NG_PHYS_LAYERS];   /**< Bit b of [a]: handler was set for (b, a) (internal) */
+    u8 pair_ignore[NG_PHYS_LAYERS]; /**< Bit b of [a]: layers a and b never collide */
+} NGPhysWorld;
+
+/** World handle */
+typedef NGPhysWorld *NGPhysWorldHandle;
+/** @} */
+
+
 /** @name World Management */
 /** @{ */
 
 /**
  * Create a physics world.
- * @return World handle, or NULL if failed
+ * The first call takes the body table from ng_arena_persistent, sized by
+ * NGEngineConfig::bodies; later worlds reuse it.
+ * @return World handle, or NULL if a world already exists or the arena is
+ *         too small
  */
 NGPhysWorldHandle NGPhysWorldCreate(void);
 
@@ -175,12 +273,69 @@ void NGPhysWorldSetGravity(NGPhysWorldHandle world, fixed gx, fixed gy);
 void NGPhysWorldSetBounds(NGPhysWorldHandle world, fixed left, fixed right, fixed top,
                           fixed bottom);
 
+/**
+ * Set the broadphase grid cell size.
+ * Bodies are only tested against bodies sharing a grid cell. A good size
+ * is about twice the typical body diameter. Rounded up to a power of two
+ * and clamped to 8-256 pixels. Default is NG_PHYS_DEFAULT_CELL_SIZE.
+ * @param world World handle
+ * @param size Cell size in pixels
+ */
+void NGPhysWorldSetCellSize(NGPhysWorldHandle world, u16 size);
+
 /**
  * Disable bounds checking.
  * @param world World handle
  */
 void NGPhysWorldDisableBounds(NGPhysWorldHandle world);
 
+/**
+ * Set the handler for contacts between two layers.
+ * The handler gets NGCollision::body_a on layer_a, whichever order the
+ * bodies were tested in (the normal is flipped to match). Pairs without a
+ * handler go to the callback passed to NGPhysWorldUpdate().
+ * @param world World handle
+ * @param layer_a First layer (0 to NG_PHYS_LAYERS - 1)
+ * @param layer_b Second layer (can equal layer_a)
+ * @param callback Handler, or NULL to use the update callback again
+ * @param user_data Passed to the handler
+ */
+void NGPhysWorldSetPairCallback(NGPhysWorldHandle world, u8 layer_a, u8 layer_b,
+                                NGCollisionCallback callback, void *user_data);
+
+/**
+ * Stop two layers from colliding, whatever the bodies' masks say.
+ * Ignored pairs are skipped before the narrowphase: no response, no
+ * callback.
+ * @param world World handle
+ * @param layer_a First layer (0 to NG_PHYS_LAYERS - 1)
+ * @param layer_b Second layer (can equal layer_a)
+ * @param ignore 1 to skip the pair, 0 to test it again
+ */
+void NGPhysWorldIgnorePair(NGPhysWorldHandle world, u8 layer_a, u8 layer_b, u8 ignore);
+
+/**
+ * Move bodies against a terrain.
+ * Each update, dynamic non-trigger bodies step by their velocity through
+ * NGTerrainResolveBatch() instead of moving freely. Circles use their
+ * bounding box. Results are left in NGBody::terrain_hit.
+ * @param world World handle
+ * @param terrain Terrain handle (NG_TERRAIN_INVALID = none, the default)
+ */
+void NGPhysWorldSetTerrain(NGPhysWorldHandle world, NGTerrainHandle terrain);
+
+/**
+ * Configure automatic sleeping.
+ * A dynamic body whose velocity stays within +/-velocity on both axes for
+ * the given number of frames goes to sleep: it is no longer integrated
+ * and is only tested against awake bodies. It wakes when moved, pushed,
+ * or hit by an awake body.
+ * @param world World handle
+ * @param velocity Per-axis speed threshold (fixed, 0 disables sleeping)
+ * @param frames Frames below the threshold before sleeping (1-255)
+ */
+void NGPhysWorldSetSleepThreshold(NGPhysWorldHandle world, fixed velocity, u8 frames);
+
 /**
  * Reset world to empty state.
  * Destroys all bodies but keeps world settings (gravity, bounds).
@@ -197,6 +352,37 @@ void NGPhysWorldReset(NGPhysWorldHandle world);
  * @param callback_data User data for callback
  */
 void NGPhysWorldUpdate(NGPhysWorldHandle world, NGCollisionCallback callback, void *callback_data);
+
+/**
+ * Advance the simulation by a number of frames.
+ * Runs as many steps as the frames (plus any left over) cover, at most
+ * NG_PHYS_MAX_STEPS. NGPhysWorldUpdate() is this with frames = 1.
+ * @param world World handle
+ * @param frames Frames elapsed since the last call (more than 1 after slowdown)
+ * @param callback Collision callback (can be NULL)
+ * @param callback_data User data for callback
+ */
+void NGPhysWorldAdvance(NGPhysWorldHandle world, u8 frames, NGCollisionCallback callback,
+                        void *callback_data);
+
+/**
+ * Set how often the simulation steps.
+ * Clears any frames left over from the old rate.
+ * @param world World handle
+ * @param hz Steps per second: 60 (the default) steps every frame, 30 every
+ *           other frame (1-60)
+ */
+void NGPhysWorldSetStepRate(NGPhysWorldHandle world, u8 hz);
+
+/**
+ * Get the tile events from the last NGPhysWorldUpdate().
+ * The list lives in ng_arena_frame: read it in the same frame, after the
+ * update. Bodies only emit events while the world has a terrain.
+ * @param world World handle
+ * @param count_out Output: number of events
+ * @return Event array, or NULL if none
+ */
+const NGTileEvent *NGPhysWorldGetTileEvents(NGPhysWorldHandle world, u8 *count_out);
 /** @} */
 
 /** @name Body Management */
@@ -225,7 +411,7 @@ NGBodyHandle NGPhysBodyCreateAABB(NGPhysWorldHandle world, fixed x, fixed y, fix
                                   fixed half_height);
 
 /**
- * Destroy a body.
+ * Destroy a body. Safe to call from a collision callback.
  * @param body Body handle
  */
 void NGPhysBodyDestroy(NGBodyHandle body);
@@ -257,6 +443,15 @@ NGVec2 NGPhysBodyGetPos(NGBodyHandle body);
  */
 void NGPhysBodySetVel(NGBodyHandle body, fixed vx, fixed vy);
 
+/**
+ * Get the position to draw a body at this frame.
+ * Between steps this interpolates from prev_pos to pos; at a 60 Hz step
+ * rate it is pos.
+ * @param body Body handle
+ * @return Draw position
+ */
+NGVec2 NGPhysBodyGetDrawPos(NGBodyHandle body);
+
 /**
  * Get body velocity.
  * @param body Body handle
@@ -303,11 +498,21 @@ void NGPhysBodySetStatic(NGBodyHandle body, u8 is_static);
 /**
  * Set collision layer and mask.
  * @param body Body handle
- * @param layer Layer this body is on
+ * @param layer Layer bits this body is on (the lowest picks its pair handler)
  * @param mask Layers this body collides with
  */
 void NGPhysBodySetLayer(NGBodyHandle body, u8 layer, u8 mask);
 
+/**
+ * Report changes in the tile flags a body touches.
+ * The body's next terrain pass compares the watched flags under its box
+ * with the previous pass and emits an NGTileEvent when they differ. A body
+ * already inside a watched tile gets an entered event on its first pass.
+ * @param body Body handle
+ * @param flags NG_TILE_* flags to watch (0 = stop watching)
+ */
+void NGPhysBodyWatchTiles(NGBodyHandle body, u8 flags);
+
 /**
  * Set user data pointer.
  * @param body Body handle
@@ -342,6 +547,35 @@ void NGPhysBodyApplyImpulse(NGBodyHandle body, fixed ix, fixed iy);
  * @return 1 if colliding, 0 otherwise
  */
 u8 NGPhysTestCollision(NGBodyHandle a, NGBodyHandle b, NGCollision *out);
+
+/**
+ * Test if two bodies touched during their last step.
+ * Sweeps their bounding boxes from prev_pos to pos, so fast bodies that
+ * passed through each other within one step are still caught. Circles
+ * use their bounding box.
+ * @param a First body handle
+ * @param b Second body handle
+ * @param[out] out Collision info at first contact (can be NULL); penetration
+ *             is how far the bodies moved past it along the normal
+ * @param[out] time Fraction of the step at first contact, 0 if they
+ *             already overlapped (can be NULL)
+ * @return 1 if they touched, 0 otherwise
+ */
+u8 NGPhysSweepCollision(NGBodyHandle a, NGBodyHandle b, NGCollision *out, fixed *time);
+
+/**
+ * Check if a body is asleep.
+ * @param body Body handle
+ * @return 1 if sleeping, 0 if awake (or NULL)
+ */
+u8 NGPhysBodyIsSleeping(NGBodyHandle body);
+
+/**
+ * Wake a sleeping body.
+ * Setters that move a body call this automatically.
+ * @param body Body handle
+ */
+void NGPhysBodyWake(NGBodyHandle body);
 /** @} */
 
 /** @} */ /* end of physics group */
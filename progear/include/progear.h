@@ -30,6 +30,9 @@
  * - @ref physics - 2D physics simulation
  * - @ref lighting - Palette-based lighting effects
  * - @ref ui - Menu system
+ * - @ref widget - Retained HUD and menu widgets
+ * - @ref spritetext - Scalable text from glyph sprites
+ * - @ref save - Checksummed save slots
  * - @ref spring - Spring physics animations
  */
 
@@ -56,12 +59,20 @@
 /* Physics */
 #include <physics.h>
 
+/* Bullets and particles */
+#include <particles.h>
+
 /* Lighting effects */
 #include <lighting.h>
 
 /* UI and animation */
 #include <spring.h>
 #include <ui.h>
+#include <widget.h>
+#include <spritetext.h>
+
+/* Save data */
+#include <save.h>
 
 /* Engine lifecycle */
 #include <engine.h>
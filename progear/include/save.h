@@ -0,0 +1,101 @@
+/*
+ * This file is part of ProGearSDK.
+ * Copyright (c) 2024-2025 ProGearSDK contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+/**
+ * @file save.h
+ * @brief Save data in backup RAM or on a memory card.
+ *
+ * The game keeps its save data in one struct in RAM and calls
+ * NGSaveCommit() when it wants it kept. The save area on the device holds
+ * two slots, each a header (magic, sequence number, version, size and a
+ * CRC-16) followed by a copy of the struct. A commit writes the slot that
+ * is not the newest, so the last good save stays whole until the new one
+ * is complete, and NGSaveOpen() loads the newest slot whose CRC checks.
+ *
+ * A commit writes only the 16-byte pages that differ from what the slot
+ * holds: pages changed since the last commit, plus those the last commit
+ * changed in the other slot. Bumping a high score rewrites one or two
+ * pages instead of the whole struct, which matters most on a memory card,
+ * where every byte is a separate bus access.
+ *
+ * Power can go at any point of a commit. The slot's magic is cleared
+ * before its pages are touched and written back last, after the header,
+ * so a cut-off slot is never loaded.
+ *
+ * @code
+ * typedef struct { u32 high_scores[10]; u8 options[8]; } SaveData;
+ * static SaveData save;
+ *
+ * NGEngineConfig cfg = {.save_size = sizeof(SaveData)};
+ * NGEngineInitWithConfig(&cfg);
+ * if (NGSaveOpen(NG_SAVE_SRAM, 0, &save, SAVE_VERSION) != NG_SAVE_LOADED)
+ *     reset_save(&save);
+ *
+ * // After a new high score
+ * save.high_scores[0] = score;
+ * NGSaveCommit();
+ * @endcode
+ */
+
+#ifndef NG_SAVE_H
+#define NG_SAVE_H
+
+#include <ng_types.h>
+
+/**
+ * @defgroup save Save Data
+ * @ingroup sdk
+ * @brief Checksummed, double-buffered save slots written by page.
+ * @{
+ */
+
+#define NG_SAVE_HEADER 10 /**< Bytes of a slot's header */
+#define NG_SAVE_PAGE   16 /**< Bytes compared and written together */
+
+/** Device bytes taken by a save area for save data of `size` bytes */
+#define NG_SAVE_AREA(size) (2 * (NG_SAVE_HEADER + (size)))
+
+/** Where the save area lives */
+typedef enum {
+    NG_SAVE_SRAM,    /**< Backup RAM (ng_sram.h) */
+    NG_SAVE_MEMCARD, /**< Memory card (ng_memcard.h) */
+} NGSaveDevice;
+
+/** Result of NGSaveOpen() */
+typedef enum {
+    NG_SAVE_EMPTY,         /**< No valid slot; the data was left as it was */
+    NG_SAVE_LOADED,        /**< The newest valid slot was loaded */
+    NG_SAVE_OTHER_VERSION, /**< Loaded as far as it fits, but saved by another version */
+    NG_SAVE_FAILED,        /**< No memory card, or NGEngineConfig.save_size is 0 */
+} NGSaveResult;
+
+/**
+ * Bind the save data and load the newest valid slot into it.
+ * @param device Backup RAM or memory card
+ * @param offset Device offset of the save area, NG_SAVE_AREA() bytes long
+ * @param data Save data, NGEngineConfig.save_size bytes, kept by pointer
+ * @param version Layout version of the data, stored with each commit
+ * @return Whether anything was loaded
+ */
+NGSaveResult NGSaveOpen(NGSaveDevice device, u16 offset, void *data, u16 version);
+
+/**
+ * Write the pages that changed since the last commit to the older slot,
+ * then make it the newest.
+ * @return 1 on success or when nothing changed, 0 if the device could not
+ *         be written (the newest slot is still the last good save)
+ */
+u8 NGSaveCommit(void);
+
+/** @return 1 if the data differs from the newest slot */
+u8 NGSaveChanged(void);
+
+/** @return Version the loaded slot was saved with, 0 if none was loaded */
+u16 NGSaveGetLoadedVersion(void);
+
+/** @} */
+
+#endif /* NG_SAVE_H */
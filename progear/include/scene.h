@@ -23,6 +23,37 @@
  * 2. Set terrain with NGSceneSetTerrain()
  * 3. Create actors and backdrops, add them to scene
  * 4. Call NGSceneUpdate() and NGSceneDraw() each frame
+ *
+ * @section scenestage Staged Transitions
+ * NGSceneReset() followed by building the next scene uploads all its tiles
+ * on one frame, which shows as a blank frame or a stall. Instead, the next
+ * scene can be built while the current one still runs: after
+ * NGSceneStageBegin(), new actors, backdrops, the terrain set with
+ * NGSceneSetTerrain() and any graphics belong to the next scene. They take
+ * the sprites the current scene leaves free, stay hidden, and upload their
+ * tiles NG_GRAPHIC_STAGE_COLS columns per frame. NGSceneStageSwap() then
+ * destroys the current scene's actors, backdrops, terrain and particles
+ * and shows the next scene, which only costs SCB3 writes.
+ *
+ * Both scenes must fit at once: in sprites, and in the actor, backdrop and
+ * terrain tables (NGEngineConfig). Staged objects are positioned through
+ * the cameras like live ones, so put the camera where the next scene
+ * starts right after the swap; a tilemap that jumps reloads its columns.
+ * Graphics created directly with NGGraphicCreate() are not destroyed by
+ * the swap.
+ *
+ * @code
+ * NGSceneStageBegin();
+ * NGSceneSetTerrain(&NGTerrainAsset_level2);
+ * NGBackdropHandle sky = NGBackdropCreate(&NGVisualAsset_sky2, 0xFFFF, 0, FIX_ONE / 4, 0);
+ * NGBackdropAddToScene(sky, 0, 0, 0);
+ *
+ * // Keep playing the current scene, then
+ * if (NGSceneStageIsReady()) {
+ *     NGSceneStageSwap();
+ *     NGCameraSetPos(0, 0);
+ * }
+ * @endcode
  */
 
 #ifndef NG_SCENE_H
@@ -33,8 +64,9 @@
 #include <collision.h>
 #include <terrain.h>
 
-/* Forward declaration */
+/* Forward declarations */
 struct NGTerrainAsset;
+struct NGTerrainBatch;
 
 /**
  * @defgroup scene Scene System
@@ -62,7 +94,8 @@ void NGSceneInit(void);
 
 /**
  * Update all scene objects.
- * Call once per frame. Updates animations and processes scene logic.
+ * Call once per frame. Updates animations, moves particles and processes
+ * scene logic.
  */
 void NGSceneUpdate(void);
 
@@ -74,12 +107,49 @@ void NGSceneDraw(void);
 
 /**
  * Reset scene to empty state.
- * Destroys all actors and backdrops, clears hardware sprites.
+ * Destroys all actors and backdrops, removes particles, clears hardware sprites.
  * Call when transitioning between levels/screens.
  */
 void NGSceneReset(void);
 /** @} */
 
+/** @name Staged Loading */
+/** @{ */
+
+/**
+ * Start building the next scene (see @ref scenestage). Until
+ * NGSceneStageSwap(), new scene objects and graphics belong to it and stay
+ * hidden. Does nothing while a scene is already staged.
+ */
+void NGSceneStageBegin(void);
+
+/** @return 1 between NGSceneStageBegin() and NGSceneStageSwap() */
+u8 NGSceneIsStaging(void);
+
+/**
+ * Check whether the next scene is fully in VRAM: every visible staged
+ * graphic has uploaded its tiles, and its terrain is warm if
+ * NGTerrainWarmUp() was called on it.
+ * @return 1 when ready, 0 while uploading or when nothing is staged
+ */
+u8 NGSceneStageIsReady(void);
+
+/**
+ * Destroy the current scene's actors, backdrops, terrain and particles and
+ * show the next scene. Tiles a staged graphic has not uploaded yet load at
+ * the next draw, as after NGSceneReset().
+ */
+void NGSceneStageSwap(void);
+
+/**
+ * Get the next scene's terrain, set with NGSceneSetTerrain() while
+ * staging. Use it with NGTerrain*() to place or warm up the terrain before
+ * the swap; the NGScene terrain functions act on the current one until then.
+ * @return Terrain handle, or NG_TERRAIN_INVALID
+ */
+NGTerrainHandle NGSceneGetStagedTerrain(void);
+/** @} */
+
 /** @name Terrain */
 /** @{ */
 
@@ -115,6 +185,20 @@ void NGSceneSetTerrainZ(u8 z);
  */
 void NGSceneSetTerrainVisible(u8 visible);
 
+/**
+ * Start decoding the terrain under a view the camera will cut to.
+ * See NGTerrainWarmUp().
+ * @param cam_x Camera X after the cut (fixed-point)
+ * @param cam_y Camera Y after the cut (fixed-point)
+ */
+void NGSceneWarmUpTerrain(fixed cam_x, fixed cam_y);
+
+/**
+ * Check whether the view passed to NGSceneWarmUpTerrain() is ready.
+ * @return 1 when ready or there is nothing to warm up, 0 while decoding
+ */
+u8 NGSceneIsTerrainWarm(void);
+
 /**
  * Get terrain dimensions in pixels.
  * @param width Output: terrain width (can be NULL)
@@ -155,6 +239,14 @@ u8 NGSceneTestCollision(fixed x, fixed y, fixed half_w, fixed half_h, u8 *flags_
 u8 NGSceneResolveCollision(fixed *x, fixed *y, fixed half_w, fixed half_h, fixed *vel_x,
                            fixed *vel_y);
 
+/**
+ * Resolve many AABBs against terrain in one pass.
+ * See NGTerrainResolveBatch().
+ * @param batch Bodies to move
+ * @return Number of bodies that hit something (0 if no terrain)
+ */
+u8 NGSceneResolveBatch(const struct NGTerrainBatch *batch);
+
 /**
  * Get tile index at grid position.
  * @param tile_x Tile X coordinate
@@ -164,20 +256,22 @@ u8 NGSceneResolveCollision(fixed *x, fixed *y, fixed half_w, fixed half_h, fixed
 u8 NGSceneGetTileAt(u16 tile_x, u16 tile_y);
 
 /**
- * Set tile at grid position (runtime modification).
+ * Set tile at grid position (runtime modification); see NGTerrainSetTile().
  * @param tile_x Tile X coordinate
  * @param tile_y Tile Y coordinate
  * @param tile_index New tile index
+ * @return 1 if the tile is set, 0 otherwise
  */
-void NGSceneSetTileAt(u16 tile_x, u16 tile_y, u8 tile_index);
+u8 NGSceneSetTileAt(u16 tile_x, u16 tile_y, u8 tile_index);
 
 /**
- * Set collision at grid position (runtime modification).
+ * Set collision at grid position (runtime modification); see NGTerrainSetCollision().
  * @param tile_x Tile X coordinate
  * @param tile_y Tile Y coordinate
  * @param collision New collision flags
+ * @return 1 if the collision is set, 0 otherwise
  */
-void NGSceneSetCollisionAt(u16 tile_x, u16 tile_y, u8 collision);
+u8 NGSceneSetCollisionAt(u16 tile_x, u16 tile_y, u8 collision);
 
 /**
  * Get the terrain handle for direct terrain API access.
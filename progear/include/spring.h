@@ -19,6 +19,17 @@
  *
  * - Higher stiffness = faster response
  * - Higher damping = less overshoot (critical damping = no overshoot)
+ *
+ * Springs can live anywhere and be stepped with NGSpringUpdate(), or be
+ * taken from the spring system, which keeps them in one array and steps
+ * them all in NGEngineFrameEnd(). The system skips springs that have
+ * settled until their target or velocity changes, so idle UI animations
+ * cost nothing:
+ * @code
+ * NGSpring *cursor = NGSpringSystemAdd(FIX(0), NG_SPRING_SNAPPY_STIFFNESS,
+ *                                      NG_SPRING_SNAPPY_DAMPING);
+ * NGSpringSetTarget(cursor, FIX(48));   // Wakes it; no NGSpringUpdate() call
+ * @endcode
  */
 
 #ifndef NG_SPRING_H
@@ -131,6 +142,108 @@ static inline void NGSpring2DGetInt(NGSpring2D *spring, s16 *out_x, s16 *out_y)
 u8 NGSpring2DSettled(NGSpring2D *spring);
 /** @} */
 
+/** @name 16-bit Spring
+ * 8.8 fixed-point spring for small values: UI offsets, alpha, scale.
+ * Each step is two single-instruction 16x16 multiplies instead of the
+ * four per FIX_MUL of the 32-bit version. Values must stay within
+ * +/-127 (including overshoot); use NGSpring for screen positions.
+ */
+/** @{ */
+
+/** 16-bit spring state */
+typedef struct NGSpring16 {
+    fixed16 value;     /**< Current animated value */
+    fixed16 velocity;  /**< Current velocity */
+    fixed16 target;    /**< Target value to animate toward */
+    fixed16 stiffness; /**< Spring constant */
+    fixed16 damping;   /**< Damping ratio */
+} NGSpring16;
+
+/** Initialize 16-bit spring. Takes the same 16.16 presets as NGSpringInit(). */
+void NGSpring16Init(NGSpring16 *spring, fixed16 initial, fixed stiffness, fixed damping);
+
+/** Set target value */
+void NGSpring16SetTarget(NGSpring16 *spring, fixed16 target);
+
+/** Snap immediately to value */
+void NGSpring16Snap(NGSpring16 *spring, fixed16 value);
+
+/** Add impulse to velocity */
+void NGSpring16Impulse(NGSpring16 *spring, fixed16 impulse);
+
+/** Update spring physics (call once per frame) */
+void NGSpring16Update(NGSpring16 *spring);
+
+/** Get current value as integer */
+static inline s8 NGSpring16GetInt(NGSpring16 *spring) {
+    return FIX16_INT(spring->value);
+}
+
+/** Check if spring has settled */
+u8 NGSpring16Settled(NGSpring16 *spring);
+/** @} */
+
+/** @name Spring System
+ * Springs stored in contiguous arrays and stepped once per frame by
+ * NGEngineFrameEnd(). Use the normal NGSpring and NGSpring16 functions on
+ * the returned pointers, but never NGSpringUpdate(): the system does it.
+ * Change targets through NGSpringSetTarget() and friends rather than by
+ * writing fields, so a settled spring is woken.
+ *
+ * A spring that settles is snapped exactly onto its target and skipped
+ * until it is woken. System springs are not released by scene changes;
+ * remove them, or call NGSpringSystemReset().
+ */
+/** @{ */
+
+#ifndef NG_SPRING_SYSTEM_MAX
+#define NG_SPRING_SYSTEM_MAX 32 /**< 32-bit springs in the system */
+#endif
+
+#ifndef NG_SPRING16_SYSTEM_MAX
+#define NG_SPRING16_SYSTEM_MAX 32 /**< 16-bit springs in the system */
+#endif
+
+/**
+ * Take a spring from the system.
+ * @return Initialized spring, or NULL if all are in use
+ */
+NGSpring *NGSpringSystemAdd(fixed initial, fixed stiffness, fixed damping);
+
+/**
+ * Take a 2D spring (two adjacent system springs).
+ * @return Initialized spring, or NULL if no adjacent pair is free
+ */
+NGSpring2D *NGSpringSystemAdd2D(fixed x, fixed y, fixed stiffness, fixed damping);
+
+/**
+ * Take a 16-bit spring from the system.
+ * @return Initialized spring, or NULL if all are in use
+ */
+NGSpring16 *NGSpringSystemAdd16(fixed16 initial, fixed stiffness, fixed damping);
+
+/** Return a spring to the system (NULL is ignored) */
+void NGSpringSystemRemove(NGSpring *spring);
+
+/** Return a 2D spring to the system (NULL is ignored) */
+void NGSpringSystemRemove2D(NGSpring2D *spring);
+
+/** Return a 16-bit spring to the system (NULL is ignored) */
+void NGSpringSystemRemove16(NGSpring16 *spring);
+
+/** Step every moving system spring. Called by NGEngineFrameEnd(). */
+void NGSpringSystemUpdate(void);
+
+/**
+ * Check whether any system spring is still moving.
+ * @return 1 if at least one spring has not settled
+ */
+u8 NGSpringSystemBusy(void);
+
+/** Release every system spring */
+void NGSpringSystemReset(void);
+/** @} */
+
 /** @} */ /* end of spring group */
 
 #endif /* NG_SPRING_H */
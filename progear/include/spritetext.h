@@ -0,0 +1,146 @@
+/*
+ * This file is part of ProGearSDK.
+ * Copyright (c) 2024-2025 ProGearSDK contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+/**
+ * @file spritetext.h
+ * @brief Text drawn with sprites, for score popups and dialog lines.
+ *
+ * The fix layer (ng_fix.h) prints on a fixed 8x8 grid and cannot scale.
+ * Sprite text draws each character as a 16x16 glyph tile, one hardware
+ * sprite per character, from a block reserved with
+ * NGEngineConfig.text_sprites. A string's sprites are chained with the
+ * sticky bit, so the hardware lays the glyphs out side by side and
+ * moving or hiding the string writes only its first sprite. Scaling
+ * shrinks the glyphs and the spacing with them.
+ *
+ * The glyph tiles come from tools/genfont.py through the `fonts` section
+ * of assets.yaml, which defines NGFONT_<NAME> in progear_assets.h as the
+ * tile of the space character; characters 32-127 follow in order.
+ *
+ * A string's tiles are written once, as one SCB1 run of tile words and
+ * one of attribute words across its sprites. When a text is destroyed or
+ * changed, its sprites stay in the block with their tiles, and a later
+ * text with the same characters takes them over without writing SCB1:
+ * strings are looked up by a CRC of their characters, then compared.
+ * Cached strings are evicted least recently used first when a new one
+ * needs room.
+ *
+ * Positions are screen pixels; camera and zoom are not applied. Texts
+ * are drawn by NGSceneDraw(), above the graphics below the UI, and stay
+ * through NGSceneReset(). The text is copied, so a formatted buffer can
+ * be reused at once.
+ *
+ * @code
+ * NGEngineConfig cfg = {.text_sprites = 48};
+ * NGEngineInitWithConfig(&cfg);
+ * NGSpriteTextSetFont(NGFONT_BIG);
+ *
+ * NGSpriteTextHandle popup = NGSpriteTextCreate("+100", x, y, NGPAL_SCORE);
+ * // Rise for a second, then go; the next "+100" reuses its sprites
+ * NGSpriteTextSetPosition(popup, x, --y);
+ * NGSpriteTextDestroy(popup);
+ * @endcode
+ */
+
+#ifndef NG_SPRITETEXT_H
+#define NG_SPRITETEXT_H
+
+#include <ng_types.h>
+
+/**
+ * @defgroup spritetext Sprite Text
+ * @ingroup sdk
+ * @brief Scalable text from 16x16 glyph sprites with cached strings.
+ * @{
+ */
+
+#ifndef NG_SPRITE_TEXT_MAX
+#define NG_SPRITE_TEXT_MAX 16 /**< Texts that can exist at once */
+#endif
+
+#ifndef NG_SPRITE_TEXT_CACHE
+#define NG_SPRITE_TEXT_CACHE 32 /**< Strings kept in the sprite block, shown or cached */
+#endif
+
+#define NG_SPRITE_TEXT_FIRST_CHAR 32  /**< Character of the font's first tile */
+#define NG_SPRITE_TEXT_LAST_CHAR  127 /**< Last character with a tile; others draw as spaces */
+
+/** Sprite text handle type */
+typedef struct NGSpriteText *NGSpriteTextHandle;
+
+/**
+ * Set the font of texts created or changed from now on. Cached strings
+ * drawn with another font are not reused.
+ * @param first_tile C-ROM tile of the space character (NGFONT_<NAME>)
+ */
+void NGSpriteTextSetFont(u16 first_tile);
+
+/**
+ * Create a text at full size.
+ * @param text Characters to show, copied
+ * @param x, y Screen position of the top left corner
+ * @param palette Palette index
+ * @return Text handle, or NULL if the table is full, the string is empty
+ *         or the sprite block has no room even after evicting cached strings
+ */
+NGSpriteTextHandle NGSpriteTextCreate(const char *text, s16 x, s16 y, u8 palette);
+
+/**
+ * Change the characters of a text. A string still cached is shown again
+ * without writing its tiles.
+ * @param t Text handle
+ * @param text New characters, copied
+ * @return 1 on success, 0 if the block has no room (the text then shows nothing)
+ */
+u8 NGSpriteTextSet(NGSpriteTextHandle t, const char *text);
+
+/**
+ * Move a text: two VRAM words at the next draw.
+ * @param t Text handle
+ * @param x, y Screen position of the top left corner
+ */
+void NGSpriteTextSetPosition(NGSpriteTextHandle t, s16 x, s16 y);
+
+/**
+ * Scale a text's glyphs and spacing.
+ * @param t Text handle
+ * @param scale Scale factor (256 = 1.0x, 128 = 0.5x); larger values draw at 1.0x
+ */
+void NGSpriteTextSetScale(NGSpriteTextHandle t, u16 scale);
+
+/**
+ * Change a text's palette: one attribute word per character.
+ * @param t Text handle
+ * @param palette Palette index
+ */
+void NGSpriteTextSetPalette(NGSpriteTextHandle t, u8 palette);
+
+/**
+ * Show or hide a text, keeping its sprites.
+ * @param t Text handle
+ * @param visible 1 to show, 0 to hide
+ */
+void NGSpriteTextSetVisible(NGSpriteTextHandle t, u8 visible);
+
+/**
+ * @param t Text handle
+ * @return Width in pixels at the text's scale
+ */
+u16 NGSpriteTextGetWidth(NGSpriteTextHandle t);
+
+/**
+ * Destroy a text. Its string stays cached for the next text with the
+ * same characters.
+ * @param t Text handle (NULL is ignored)
+ */
+void NGSpriteTextDestroy(NGSpriteTextHandle t);
+
+/** Destroy every text and drop every cached string. */
+void NGSpriteTextClearAll(void);
+
+/** @} */ /* end of spritetext group */
+
+#endif /* NG_SPRITETEXT_H */
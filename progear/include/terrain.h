@@ -30,6 +30,44 @@
  * 2. Add to scene with NGTerrainAddToScene()
  * 3. Use NGTerrainTestAABB() for collision detection
  * 4. Use NGTerrainResolveAABB() for collision response
+ *
+ * @section terraincollindex Collision Index
+ * NGTerrainCreate() packs the SOLID and PLATFORM flags into one bit per tile,
+ * row-major and word-aligned, allocated from ng_arena_state. The AABB queries
+ * then test 16 tiles per word load instead of one byte per tile. The index
+ * lives until ng_arena_state is reset, so create terrains after the reset on
+ * scene change. If the arena is full the queries fall back to scanning
+ * collision_data directly.
+ *
+ * @section terrainchunks Chunked Terrain
+ * Large stages can be stored as NG_TERRAIN_CHUNK_SIZE square chunks, each
+ * RLE-packed on its own (`chunked: true` under `tilemaps:` in assets.yaml).
+ * The terrain then keeps NG_TERRAIN_CHUNK_SLOTS decompressed chunks in
+ * ng_arena_state: the ones under the camera plus one chunk of lookahead on
+ * each side, decoded at most one per frame as the camera moves. A moving
+ * camera trades the trailing side for the view NG_CAM_PREDICT_FRAMES ahead
+ * (see NGCameraPredict()), so chunks decode before they scroll in. Rendering
+ * and the collision queries read through the same cache; a query outside it
+ * decodes the chunk it needs on the spot. Chunked terrains skip the
+ * collision index, which would hold the whole map in RAM.
+ *
+ * Chunk format: NG_TERRAIN_CHUNK_SIZE * NG_TERRAIN_CHUNK_SIZE tile bytes,
+ * row-major, then as many collision bytes when chunk_collision is set,
+ * packed as one run stream. A control byte n below 0x80 is followed by
+ * n + 1 literal bytes; n of 0x80 and up repeats the next byte n - 0x7E
+ * times. Chunks past the map edge are padded with zeros.
+ *
+ * @section terrainedits Tile Edits
+ * NGTerrainSetTile() and NGTerrainSetCollision() leave the asset in ROM and
+ * keep edited tiles in a small hash over it, allocated from ng_arena_state
+ * on the first edit, plus one bit per map column that holds any. Reads of
+ * a flat terrain look the hash up only in columns with the bit set, so
+ * unedited columns cost what they did before. A chunked terrain writes
+ * edits into its decoded chunks and applies them again when one is
+ * decoded anew. The hash doubles into a new arena block when three
+ * quarters full; the old block is only reclaimed when the arena is reset.
+ * If ng_arena_state runs out, the edit is not made and the setter
+ * returns 0.
  */
 
 #ifndef NG_TERRAIN_H
@@ -49,7 +87,9 @@
 /** @name Constants */
 /** @{ */
 
-#define NG_TERRAIN_MAX     4    /**< Maximum active terrains */
+#ifndef NG_TERRAIN_MAX
+#define NG_TERRAIN_MAX 4 /**< Default terrain table size (see NGEngineConfig) */
+#endif
 #define NG_TERRAIN_INVALID (-1) /**< Invalid handle sentinel */
 #define NG_TILE_SIZE       16   /**< Tile size in pixels */
 
@@ -58,6 +98,35 @@
 
 /** Maximum rows renderable (limited by 512px hardware constraint) */
 #define NG_TERRAIN_MAX_ROWS 32
+
+#ifndef NG_TERRAIN_COLLISION_INDEX
+/**
+ * Build packed collision bitsets in NGTerrainCreate() (1 = enabled).
+ * Costs (width_tiles + 15) / 16 * 4 + 4 bytes of ng_arena_state per row.
+ */
+#define NG_TERRAIN_COLLISION_INDEX 1
+#endif
+
+/** Chunk width and height in tiles (chunked assets, fixed by progear_assets.py) */
+#define NG_TERRAIN_CHUNK_SIZE 16
+
+#ifndef NG_TERRAIN_CHUNK_SLOTS
+/**
+ * Decompressed chunks cached per chunked terrain. Each costs 256 bytes of
+ * ng_arena_state, 512 with collision. The camera window plus lookahead
+ * needs 10 on a map up to 32 tiles tall.
+ */
+#define NG_TERRAIN_CHUNK_SLOTS 12
+#endif
+
+#ifndef NG_TERRAIN_EDITS
+/**
+ * Initial hash slots for edited tiles per terrain (see @ref terrainedits),
+ * a power of two. The hash doubles once three quarters hold edits; each
+ * slot costs 8 bytes of ng_arena_state.
+ */
+#define NG_TERRAIN_EDITS 64
+#endif
 /** @} */
 
 /** @name Handle Type */
@@ -73,6 +142,13 @@ typedef s8 NGTerrainHandle;
 /**
  * Terrain asset definition.
  * Generated by progear_assets.py from TMX files in assets.yaml (tilemaps section).
+ * Flat assets set tile_data; chunked assets set chunk_data and chunk_offsets
+ * instead and leave tile_data and collision_data NULL.
+ *
+ * An asset given a bank keeps its arrays in that P-ROM bank and the struct
+ * itself in the first megabyte. The terrain and its graphic map the bank
+ * with NGBankSelect() before they read the arrays, so the main loop may
+ * find another bank mapped after any terrain call.
  */
 typedef struct NGTerrainAsset {
     const char *name;          /**< Asset name */
@@ -83,7 +159,37 @@ typedef struct NGTerrainAsset {
     const u8 *collision_data;  /**< Collision flags (row-major, NULL = no collision) */
     const u8 *tile_to_palette; /**< Palette lookup table (256 entries) */
     u8 default_palette;        /**< Fallback palette for unmapped tiles */
+    const u8 *chunk_data;      /**< RLE-packed chunks, NULL for a flat asset */
+    const u32 *chunk_offsets;  /**< Start of each chunk in chunk_data, chunk rows in order */
+    u8 chunk_collision;        /**< Chunks carry a collision layer after their tiles */
+    u8 chunk_slopes;           /**< Chunk collision layers hold slope tiles */
+    u8 bank;                   /**< P-ROM bank of the arrays (ng_bank.h), 0 = first megabyte */
 } NGTerrainAsset;
+
+/**
+ * Bodies for NGTerrainResolveBatch(), one array per field, count entries each.
+ */
+typedef struct NGTerrainBatch {
+    fixed *x;            /**< Center X (fixed-point, modified on collision) */
+    fixed *y;            /**< Center Y (fixed-point, modified on collision) */
+    const fixed *half_w; /**< Half-widths (fixed-point) */
+    const fixed *half_h; /**< Half-heights (fixed-point) */
+    fixed *vel_x;        /**< Velocity X (zeroed on horizontal collision) */
+    fixed *vel_y;        /**< Velocity Y (zeroed on vertical collision) */
+    u8 *result;          /**< Output: NG_COLL_* bitmask per body (can be NULL) */
+    u8 count;            /**< Number of bodies */
+} NGTerrainBatch;
+
+/** Contact found by NGTerrainSweepAABB() */
+typedef struct NGTerrainSweep {
+    fixed time;  /**< Fraction of the move before contact (FIX_ONE = none) */
+    s8 normal_x; /**< Surface normal X at contact (-1, 0 or 1) */
+    s8 normal_y; /**< Surface normal Y at contact (-1, 0 or 1) */
+    u16 tile_x;  /**< Tile hit */
+    u16 tile_y;  /**< Tile hit */
+    fixed x;     /**< Center X where the box stops, just clear of the tile */
+    fixed y;     /**< Center Y where the box stops */
+} NGTerrainSweep;
 /** @} */
 
 /** @name Lifecycle */
@@ -92,7 +198,8 @@ typedef struct NGTerrainAsset {
 /**
  * Create a terrain from an asset.
  * @param asset Terrain asset (generated by progear_assets.py)
- * @return Handle or NG_TERRAIN_INVALID if no slots available
+ * @return Handle or NG_TERRAIN_INVALID if no slots are available, or if a
+ *         chunked asset's cache does not fit in ng_arena_state
  */
 NGTerrainHandle NGTerrainCreate(const NGTerrainAsset *asset);
 
@@ -137,6 +244,14 @@ void NGTerrainSetPos(NGTerrainHandle terrain, fixed world_x, fixed world_y);
  */
 void NGTerrainSetZ(NGTerrainHandle terrain, u8 z);
 
+/**
+ * Bind terrain to a camera (see camera.h).
+ * Each split-screen view needs its own terrain instance of the same asset.
+ * @param terrain Terrain handle
+ * @param camera NGCameraHandle (0 = default camera)
+ */
+void NGTerrainSetCamera(NGTerrainHandle terrain, u8 camera);
+
 /**
  * Set terrain visibility.
  * @param terrain Terrain handle
@@ -151,6 +266,26 @@ void NGTerrainSetVisible(NGTerrainHandle terrain, u8 visible);
  * @param height_out Output: height in pixels (can be NULL)
  */
 void NGTerrainGetDimensions(NGTerrainHandle terrain, u16 *width_out, u16 *height_out);
+
+/**
+ * Start decoding the chunks under a view the camera is about to cut to.
+ * One chunk decodes per frame once the current view's chunks are cached,
+ * so the cut itself does not stall on decompression. Pair with
+ * NGGraphicSetScrollBudget() to spread the tile upload after the cut.
+ * No effect on flat (unchunked) terrain.
+ * @param terrain Terrain handle
+ * @param cam_x Camera X the cut will land on (fixed-point, world space)
+ * @param cam_y Camera Y the cut will land on (fixed-point)
+ */
+void NGTerrainWarmUp(NGTerrainHandle terrain, fixed cam_x, fixed cam_y);
+
+/**
+ * Check whether the view passed to NGTerrainWarmUp() is fully decoded.
+ * @param terrain Terrain handle
+ * @return 1 when ready (or nothing to warm up), 0 while chunks are pending;
+ *         stays 0 if the cache is too small to hold it next to the current view
+ */
+u8 NGTerrainIsWarm(NGTerrainHandle terrain);
 /** @} */
 
 /** @name Collision */
@@ -177,7 +312,8 @@ u8 NGTerrainGetTileAt(NGTerrainHandle terrain, u16 tile_x, u16 tile_y);
 
 /**
  * Test AABB collision against terrain.
- * Checks all tiles overlapping the AABB.
+ * Checks all tiles overlapping the AABB. Passing NULL for flags_out lets the
+ * test use the collision index.
  * @param terrain Terrain handle
  * @param x Center X (fixed-point)
  * @param y Center Y (fixed-point)
@@ -193,6 +329,8 @@ u8 NGTerrainTestAABB(NGTerrainHandle terrain, fixed x, fixed y, fixed half_w, fi
  * Resolve AABB collision against terrain.
  * Pushes the AABB out of solid tiles using minimum displacement.
  * Handles one-way platforms (solid only when falling onto them).
+ * Slope tiles (NG_TILE_SLOPE_L/R) hold up the AABB's bottom-center point at
+ * the slope's height there, and a body walking downhill stays on them.
  * @param terrain Terrain handle
  * @param x Center X (fixed-point, modified on collision)
  * @param y Center Y (fixed-point, modified on collision)
@@ -204,30 +342,66 @@ u8 NGTerrainTestAABB(NGTerrainHandle terrain, fixed x, fixed y, fixed half_w, fi
  */
 u8 NGTerrainResolveAABB(NGTerrainHandle terrain, fixed *x, fixed *y, fixed half_w, fixed half_h,
                         fixed *vel_x, fixed *vel_y);
+
+/**
+ * Resolve many AABBs against terrain in one pass.
+ * Same result per body as NGTerrainResolveAABB(), but the handle is checked
+ * and the terrain fields are read once for the whole batch.
+ * @param terrain Terrain handle
+ * @param batch Bodies to move
+ * @return Number of bodies that hit something
+ */
+u8 NGTerrainResolveBatch(NGTerrainHandle terrain, const NGTerrainBatch *batch);
+
+/**
+ * Sweep an AABB along a move and find the first tile it would hit.
+ * Walks the tile boundaries the box's leading edges cross, in order, so a
+ * fast body cannot skip a thin wall and costs one pass instead of several
+ * sub-steps. Platforms stop downward moves only. Tiles the box already
+ * overlaps at the start are ignored.
+ * @param terrain Terrain handle
+ * @param x Center X (fixed-point)
+ * @param y Center Y (fixed-point)
+ * @param half_w Half-width (fixed-point)
+ * @param half_h Half-height (fixed-point)
+ * @param dx Move X (fixed-point)
+ * @param dy Move Y (fixed-point)
+ * @param out Output: contact, or time FIX_ONE and the end of the move (can be NULL)
+ * @return Side of the box that hit (NG_COLL_LEFT|RIGHT|TOP|BOTTOM), or NG_COLL_NONE
+ */
+u8 NGTerrainSweepAABB(NGTerrainHandle terrain, fixed x, fixed y, fixed half_w, fixed half_h,
+                      fixed dx, fixed dy, NGTerrainSweep *out);
 /** @} */
 
 /** @name Tile Modification */
 /** @{ */
 
 /**
- * Set tile at grid position (runtime modification).
- * Note: Requires RAM copy to be enabled for this terrain.
+ * Set tile at grid position (runtime modification), e.g. a block breaking.
+ * If the tile is on screen, its next draw rewrites that one tile in the
+ * terrain's sprites: two VRAM words, and nothing for tiles off screen,
+ * which load the new tile when they scroll in. Collision is not changed.
+ * See @ref terrainedits.
  * @param terrain Terrain handle
  * @param tile_x Tile X coordinate
  * @param tile_y Tile Y coordinate
  * @param tile_index New tile index
+ * @return 1 if the tile is set, 0 if the position is invalid or
+ *         ng_arena_state has no room for the edit
  */
-void NGTerrainSetTile(NGTerrainHandle terrain, u16 tile_x, u16 tile_y, u8 tile_index);
+u8 NGTerrainSetTile(NGTerrainHandle terrain, u16 tile_x, u16 tile_y, u8 tile_index);
 
 /**
- * Set collision at grid position (runtime modification).
- * Note: Requires RAM copy to be enabled for this terrain.
+ * Set collision at grid position (runtime modification), seen by every
+ * collision query from then on. See @ref terrainedits.
  * @param terrain Terrain handle
  * @param tile_x Tile X coordinate
  * @param tile_y Tile Y coordinate
  * @param collision New collision flags
+ * @return 1 if the collision is set, 0 if the position is invalid, the
+ *         terrain has no collision, or ng_arena_state has no room for the edit
  */
-void NGTerrainSetCollision(NGTerrainHandle terrain, u16 tile_x, u16 tile_y, u8 collision);
+u8 NGTerrainSetCollision(NGTerrainHandle terrain, u16 tile_x, u16 tile_y, u8 collision);
 /** @} */
 
 /** @} */ /* end of terrain group */
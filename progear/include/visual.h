@@ -31,24 +31,62 @@
 
 /**
  * Animation descriptor.
- * Defines a named animation sequence within a visual asset.
+ * Defines a named animation sequence within a visual asset. Frames last
+ * `speed` ticks each, or durations[i] ticks for frame i when the asset
+ * gives per-frame timing.
  */
 typedef struct {
-    const char *name; /**< Animation name (e.g., "idle", "walk") */
-    u16 first_frame;  /**< First frame index */
-    u16 frame_count;  /**< Number of frames */
-    u8 speed;         /**< Ticks per frame (higher = slower) */
-    u8 loop;          /**< 1 = loop, 0 = play once */
+    const char *name;    /**< Animation name (e.g., "idle", "walk") */
+    u16 first_frame;     /**< First frame index */
+    u16 frame_count;         /**< Number of frames */
+    u8 speed;            /**< Ticks per frame (higher = slower) */
+    u8 loop;             /**< 1 = loop, 0 = play once */
+    const u8 *durations; /**< Ticks for each frame, or NULL to use speed */
 } NGAnimDef;
 /** @} */
 
 /** @name Visual Asset Structure */
 /** @{ */
 
+/**
+ * One sprite column of a metasprite frame: height tiles read from the
+ * asset tilemap at tile, drawn with its top-left corner at (x, y) in the
+ * frame box.
+ */
+typedef struct {
+    s16 x;     /**< Left edge in pixels from the frame's left */
+    s16 y;     /**< Top edge in pixels from the frame's top */
+    u16 tile;  /**< First of height tilemap entries, top to bottom */
+    u8 height; /**< Tiles in the column (1-32) */
+} NGMetaPart;
+
 /**
  * Visual asset definition.
  * Generated by progear_assets.py from source images in assets.yaml.
  * Max height is 512 pixels due to NeoGeo hardware limitations.
+ *
+ * The tilemap holds tiles_per_frame entries for each frame, frame after
+ * frame. Entries are offsets from base_tile plus NG_TILE_HFLIP/VFLIP. The
+ * asset compiler stores each distinct tile once across all assets, so
+ * frames can share tiles and use flipped copies of each other's. An asset
+ * without a tilemap uses consecutive column-major tiles per frame.
+ *
+ * frame_deltas lists the tilemap entries that differ from the previous
+ * frame, so stepping an animation rewrites only those. frame_deltas[f] to
+ * frame_deltas[f + 1] index the entries for frame f (none for frame 0),
+ * each (column << 5) | row. Other frame changes, such as a loop wrapping
+ * around, compare the two frames' tilemaps instead.
+ *
+ * A metasprite asset (parts non-NULL) drops the grid: frame f is the parts
+ * frame_parts[f] to frame_parts[f + 1], one hardware sprite each. Blank
+ * columns get no part and blank rows above and below a column are
+ * trimmed. The tilemap then holds the parts' tile runs, shared between
+ * parts that show the same tiles.
+ *
+ * An auto_anim asset is animated by the LSPC instead (see ng_sprite.h):
+ * its single tilemap frame points at aligned groups of 4 or 8 tiles, one
+ * per frame, and the hardware cycles them at the global auto-animation
+ * speed with no VRAM writes.
  */
 typedef struct {
     const char *name;        /**< Asset name */
@@ -57,15 +95,22 @@ typedef struct {
     u16 height_pixels;       /**< Natural height in pixels */
     u8 width_tiles;          /**< Width in 16x16 tiles */
     u8 height_tiles;         /**< Height in 16x16 tiles */
-    const u16 *tilemap;      /**< Tile indices (row-major) */
+    const u16 *tilemap;      /**< Tile indices (row-major, every frame), or NULL */
     u8 palette;              /**< Default palette index */
     const u16 *palette_data; /**< Palette colors (16 entries), or NULL */
 
     /* Animation support (optional) */
-    const NGAnimDef *anims; /**< Animation array (NULL if static) */
-    u8 anim_count;          /**< Number of animations (0 if static) */
-    u16 frame_count;        /**< Total frames (1 if static) */
-    u16 tiles_per_frame;    /**< Tiles per animation frame */
+    const NGAnimDef *anims;  /**< Animation array (NULL if static) */
+    u8 anim_count;           /**< Number of animations (0 if static) */
+    u16 frame_count;         /**< Total frames (1 if static) */
+    u16 tiles_per_frame;     /**< Tiles per animation frame */
+    u8 auto_anim;            /**< Hardware-animated frames (4 or 8), or 0 */
+    const u16 *frame_deltas; /**< Tiles changed by each frame, or NULL (see above) */
+
+    /* Metasprite frames (optional, see above) */
+    const NGMetaPart *parts; /**< Column parts of every frame, or NULL */
+    const u16 *frame_parts;  /**< frame_count + 1 offsets into parts */
+    u8 max_parts;            /**< Most parts in one frame */
 } NGVisualAsset;
 /** @} */
 
@@ -0,0 +1,252 @@
+/*
+ * This file is part of ProGearSDK.
+ * Copyright (c) 2024-2025 ProGearSDK contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+/**
+ * @file widget.h
+ * @brief Retained HUD and menu widgets.
+ *
+ * Widgets are created once and changed through setters; each remembers
+ * whether it changed since it was last drawn. Labels, counters, bars and
+ * lists are drawn on the fix layer, sprites and panels are UI graphics,
+ * and gauges use their own sprites.
+ * Widgets sit in a tree: positions are in fix cells (8 pixels) from the
+ * parent, and hiding or moving a group does the same to everything in it.
+ *
+ * NGEngineFrameEnd() draws the widgets that changed into the fix shadow
+ * (see ng_fix.h), which the next VBlank interrupt flushes, so unchanged
+ * widgets cost nothing and a changed one costs the cells that differ.
+ * Sprites go through the graphic system, which writes only what moved.
+ *
+ * A gauge is a bar with one sprite per 16-pixel segment, taken from a
+ * block reserved with NGEngineConfig.gauge_sprites. Its fill is shown to
+ * the pixel by shrinking the last segment and moving empty ones off
+ * screen, so a change writes the SCB2 shrink word of the segment that
+ * narrowed or widened, plus an SCB4 X word for each segment that emptied
+ * or filled: one word within a segment, two or three across a boundary,
+ * whatever the bar's length.
+ *
+ * NGWidgetsSetBudget() caps the VRAM words widgets can cost per frame,
+ * counting each fix cell as one word and a sprite appearing as its whole
+ * columns. Widgets that would go past it stay pending and are drawn first
+ * next frame, so opening a full pause menu over a running HUD spreads
+ * over a few frames instead of one long VBlank.
+ *
+ * Text and list items are kept by pointer, not copied.
+ *
+ * @code
+ * NGEngineConfig cfg = {.widgets = 16};
+ * NGEngineInitWithConfig(&cfg);
+ *
+ * NGWidgetHandle hud = NGWidgetCreateGroup(NULL, 1, 3);
+ * NGWidgetHandle score = NGWidgetCreateCounter(hud, 0, 0, 8, 0, 1);
+ * NGWidgetHandle life = NGWidgetCreateBar(hud, 10, 0, 8, 100, FULL_TILE, EMPTY_TILE, 0);
+ * NGWidgetsSetBudget(64);
+ *
+ * // Per frame; only widgets whose value changed are redrawn
+ * NGWidgetSetValue(score, player_score);
+ * NGWidgetSetValue(life, player_health);
+ * @endcode
+ */
+
+#ifndef NG_WIDGET_H
+#define NG_WIDGET_H
+
+#include <ng_types.h>
+#include <visual.h>
+
+/**
+ * @defgroup widget Widgets
+ * @ingroup sdk
+ * @brief Retained HUD and menu widgets with per-widget dirty tracking.
+ * @{
+ */
+
+#define NG_WIDGET_Z_INDEX 240 /**< Sprite widgets render below menus */
+
+/** Widget handle type */
+typedef struct NGWidget *NGWidgetHandle;
+
+/** @name Creation
+ * Each returns NULL when the table (NGEngineConfig.widgets) is full.
+ * A NULL parent places the widget in fix cell coordinates. */
+/** @{ */
+
+/**
+ * Create an empty group to move and hide other widgets together.
+ * @param parent Parent widget, or NULL
+ * @param x, y Position in cells from the parent
+ * @return Widget handle, or NULL
+ */
+NGWidgetHandle NGWidgetCreateGroup(NGWidgetHandle parent, s8 x, s8 y);
+
+/**
+ * Create a line of text.
+ * @param parent Parent widget, or NULL
+ * @param x, y Position in cells from the parent
+ * @param width Cells to cover, padding with blanks (0 = the text's length)
+ * @param palette Fix palette index
+ * @param text Text, kept by pointer
+ * @return Widget handle, or NULL
+ */
+NGWidgetHandle NGWidgetCreateLabel(NGWidgetHandle parent, s8 x, s8 y, u8 width, u8 palette,
+                                   const char *text);
+
+/**
+ * Create a fixed-width decimal number at 0. Values past the width show as
+ * all nines.
+ * @param parent Parent widget, or NULL
+ * @param x, y Position in cells from the parent
+ * @param digits Width, 1-10
+ * @param palette Fix palette index
+ * @param zero_pad 1 to draw leading zeros, 0 for blanks
+ * @return Widget handle, or NULL
+ */
+NGWidgetHandle NGWidgetCreateCounter(NGWidgetHandle parent, s8 x, s8 y, u8 digits, u8 palette,
+                                     u8 zero_pad);
+
+/**
+ * Create a horizontal gauge at 0, filled from the left in whole cells.
+ * @param parent Parent widget, or NULL
+ * @param x, y Position in cells from the parent
+ * @param width Cells
+ * @param max Value of a full bar
+ * @param full_tile, empty_tile Fix tiles for filled and empty cells
+ * @param palette Fix palette index
+ * @return Widget handle, or NULL
+ */
+NGWidgetHandle NGWidgetCreateBar(NGWidgetHandle parent, s8 x, s8 y, u8 width, u16 max,
+                                 u16 full_tile, u16 empty_tile, u8 palette);
+
+/**
+ * Create a horizontal gauge at 0, filled from the left to the pixel, from
+ * sprites of the NGEngineConfig.gauge_sprites block.
+ * @param parent Parent widget, or NULL
+ * @param x, y Position in cells from the parent
+ * @param segments 16-pixel segments, one sprite each
+ * @param max Value of a full gauge
+ * @param tile C-ROM tile of a segment
+ * @param palette Palette index
+ * @return Widget handle, or NULL (also when the block has no room)
+ */
+NGWidgetHandle NGWidgetCreateGauge(NGWidgetHandle parent, s8 x, s8 y, u8 segments, u16 max,
+                                   u16 tile, u8 palette);
+
+/**
+ * Create a column of items, one per row, with the first selected.
+ * @param parent Parent widget, or NULL
+ * @param x, y Position in cells from the parent
+ * @param width Cells per row, padding with blanks
+ * @param items Item texts, kept by pointer
+ * @param count Number of items
+ * @param palette Fix palette index of items
+ * @param selected_palette Fix palette index of the selected item
+ * @return Widget handle, or NULL
+ */
+NGWidgetHandle NGWidgetCreateList(NGWidgetHandle parent, s8 x, s8 y, u8 width,
+                                  const char *const *items, u8 count, u8 palette,
+                                  u8 selected_palette);
+
+/**
+ * Create a sprite showing a visual asset, such as an icon.
+ * @param parent Parent widget, or NULL
+ * @param x, y Position in cells from the parent
+ * @param asset Visual asset
+ * @param palette Palette index
+ * @return Widget handle, or NULL (also when no graphic is free)
+ */
+NGWidgetHandle NGWidgetCreateSprite(NGWidgetHandle parent, s8 x, s8 y,
+                                    const NGVisualAsset *asset, u8 palette);
+
+/**
+ * Create a 9-slice panel (see NGGraphicSet9SliceBorders()) behind other
+ * widgets, e.g. a pause menu background.
+ * @param parent Parent widget, or NULL
+ * @param x, y Position in cells from the parent
+ * @param width, height Size in cells
+ * @param asset Visual asset of the panel's borders and middle
+ * @return Widget handle, or NULL (also when no graphic is free)
+ */
+NGWidgetHandle NGWidgetCreatePanel(NGWidgetHandle parent, s8 x, s8 y, u8 width, u8 height,
+                                   const NGVisualAsset *asset);
+
+/**
+ * Destroy a widget and everything in it, clearing their cells.
+ * @param w Widget (NULL safe)
+ */
+void NGWidgetDestroy(NGWidgetHandle w);
+/** @} */
+
+/** @name Changes
+ * Setting a position or value a widget already has does nothing. */
+/** @{ */
+
+/**
+ * Move a widget and everything in it.
+ * @param w Widget
+ * @param x, y Position in cells from the parent
+ */
+void NGWidgetSetPosition(NGWidgetHandle w, s8 x, s8 y);
+
+/**
+ * Show or hide a widget and everything in it. Widgets start visible.
+ * @param w Widget
+ * @param visible 1 to show, 0 to hide
+ */
+void NGWidgetSetVisible(NGWidgetHandle w, u8 visible);
+
+/**
+ * Change a label's text. Passing the same buffer again redraws it, for
+ * text edited in place; only cells that differ reach VRAM.
+ * @param w Label
+ * @param text Text, kept by pointer
+ */
+void NGWidgetSetText(NGWidgetHandle w, const char *text);
+
+/**
+ * Change a counter's number or a bar's or gauge's fill.
+ * @param w Counter, bar or gauge
+ * @param value New value (bars and gauges stop at their max)
+ */
+void NGWidgetSetValue(NGWidgetHandle w, u32 value);
+
+/**
+ * Change a list's selected item.
+ * @param w List
+ * @param index Item index
+ */
+void NGWidgetSetSelection(NGWidgetHandle w, u8 index);
+
+/**
+ * @param w Counter, bar, gauge or list
+ * @return Value, or selected item of a list
+ */
+u32 NGWidgetGetValue(NGWidgetHandle w);
+/** @} */
+
+/** @name Drawing */
+/** @{ */
+
+/**
+ * Draw changed widgets into the fix shadow and move changed sprites.
+ * Called by NGEngineFrameEnd() before the scene is drawn.
+ */
+void NGWidgetsDraw(void);
+
+/**
+ * Cap the VRAM words NGWidgetsDraw() can cause per frame. Each widget is
+ * counted at the most it could cost and drawn whole, so one larger than
+ * the cap still goes out, alone in its frame.
+ * @param words Words per frame, or 0 for no cap (the default)
+ */
+void NGWidgetsSetBudget(u16 words);
+
+/** @return 1 if changed widgets are waiting for a later frame */
+u8 NGWidgetsPending(void);
+/** @} */
+
+/** @} */
+
+#endif /* NG_WIDGET_H */
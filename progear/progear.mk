@@ -53,9 +53,26 @@ SDK_CFLAGS += -Wall -Wextra -Wshadow -Wdouble-promotion -Wformat=2 -Wundef
 SDK_CFLAGS += -fno-common -Wconversion -Wno-sign-conversion
 SDK_CFLAGS += -I$(SDK_INCLUDE) -I$(CORE_INCLUDE) -I$(HAL_INCLUDE)
 
+# Scanline profiler: build with `make NG_PROFILE=1`
+ifdef NG_PROFILE
+SDK_CFLAGS += -DNG_PROFILE
+endif
+
 SDK_ASFLAGS = -m68000
 
-SDK_LDFLAGS = -T$(SDK_LINKER_SCRIPT) -nostdlib
+# The link writes a map next to the ELF, read by `make size-report`
+SDK_LDFLAGS = -T$(SDK_LINKER_SCRIPT) -nostdlib -Wl,-Map=$(@:.elf=.map)
+
+# Speed profile: the libraries' hot modules are LTO objects built at -O2
+# (see progear/Makefile); the link optimizes them together and drops
+# unreferenced sections. Game sources keep -Os.
+ifeq ($(PROFILE),speed)
+SDK_CFLAGS += -ffunction-sections -fdata-sections
+SDK_LDFLAGS += -flto -O2 -Wl,--gc-sections
+endif
+
+# ROM per module and function: $(SIZE_REPORT) build/game.elf
+SIZE_REPORT = python3 $(CORE_PATH)/../tools/size_report.py --nm $(PREFIX)nm
 
 # === Libraries for linking (order matters: SDK first, then HAL, then Core) ===
 SDK_LIBS = $(SDK_LIB) $(HAL_LIB) $(CORE_LIB)
@@ -8,6 +8,7 @@
 #include <camera.h>
 #include <graphic.h>
 #include <ng_audio.h>
+#include <ng_palette.h>
 #include <ng_string.h>
 
 #include "sdk_internal.h"
@@ -23,54 +24,198 @@ typedef struct {
     u8 in_scene;     // Added to scene?
     u8 active;       // Slot in use?
     u8 screen_space; // If set, ignore camera (UI elements)
+    u8 always_active; // If set, never culled when off-screen
+    u8 camera;        // Camera it is bound to, or NG_CAMERA_AUTO
+    u8 view;          // Camera it was last drawn through
+
+    NGBodyHandle body;      // Body it follows, or NULL
+    fixed body_dx, body_dy; // Offset from the body center
 
     u8 anim_index;
     u16 anim_frame;
-    u8 anim_counter;
+    u16 anim_due;   // Tick of the next frame change, while queued
+    u8 anim_queued; // On the animation wheel?
+    u8 anim_prev;   // Neighbours in the wheel bucket (ANIM_NONE at the ends)
+    u8 anim_next;
+
+    u8 scene_index;          // Position in scene_list while in the scene
+    NGActorHandle next_free; // Next free slot while inactive
 
     NGGraphic *graphic; // Graphics abstraction handles rendering
 } Actor;
 
-static Actor actors[NG_ACTOR_MAX];
+/* Actor table from ng_arena_persistent, sized at engine init */
+static Actor *actors;
+static u8 actor_capacity;
+static NGActorHandle first_free;
+
+/* Handles of in-scene actors, so per-frame loops skip everything else.
+ * Removal swaps the last entry into the gap. */
+static u8 *scene_list;
+static u8 scene_count;
+
+/* Animation timer wheel. An in-scene actor whose animation will change
+ * frame sits in the bucket of the tick when it does, so an update only
+ * visits the actors that are due. Static and finished actors cost nothing. */
+#define ANIM_NONE       0xFF
+#define ANIM_WHEEL_MASK (NG_ANIM_WHEEL_SIZE - 1)
+
+static u8 anim_wheel[NG_ANIM_WHEEL_SIZE];
+static u16 anim_tick;
+
+static inline u8 valid_handle(NGActorHandle handle) {
+    return handle >= 0 && handle < actor_capacity;
+}
+
+static const NGAnimDef *current_anim(const Actor *actor) {
+    if (!actor->asset || !actor->asset->anims || actor->anim_index >= actor->asset->anim_count)
+        return NULL;
+    return &actor->asset->anims[actor->anim_index];
+}
+
+/* Frame after `frame`: wraps when looping, holds on the last frame otherwise */
+static u16 anim_next_frame(const NGAnimDef *anim, u16 frame) {
+    if (frame + 1 < anim->frame_count)
+        return (u16)(frame + 1);
+    return anim->loop ? 0 : (u16)(anim->frame_count - 1);
+}
+
+static u8 anim_duration(const NGAnimDef *anim, u16 frame) {
+    u8 ticks = anim->speed;
+    if (anim->durations && frame < anim->frame_count)
+        ticks = anim->durations[frame];
+    return ticks ? ticks : 1;
+}
+
+static void anim_link(u8 handle, u16 due) {
+    Actor *actor = &actors[handle];
+    u8 *bucket = &anim_wheel[due & ANIM_WHEEL_MASK];
+    actor->anim_due = due;
+    actor->anim_prev = ANIM_NONE;
+    actor->anim_next = *bucket;
+    if (*bucket != ANIM_NONE)
+        actors[*bucket].anim_prev = handle;
+    *bucket = handle;
+    actor->anim_queued = 1;
+}
+
+static void anim_unlink(u8 handle) {
+    Actor *actor = &actors[handle];
+    if (!actor->anim_queued)
+        return;
+    if (actor->anim_prev != ANIM_NONE)
+        actors[actor->anim_prev].anim_next = actor->anim_next;
+    else
+        anim_wheel[actor->anim_due & ANIM_WHEEL_MASK] = actor->anim_next;
+    if (actor->anim_next != ANIM_NONE)
+        actors[actor->anim_next].anim_prev = actor->anim_prev;
+    actor->anim_queued = 0;
+}
+
+/* Start timing the current frame from now; off the wheel if it can't change */
+static void anim_restart(u8 handle) {
+    Actor *actor = &actors[handle];
+    anim_unlink(handle);
+    const NGAnimDef *anim = current_anim(actor);
+    if (!actor->in_scene || !anim || anim_next_frame(anim, actor->anim_frame) == actor->anim_frame)
+        return;
+    anim_link(handle, (u16)(anim_tick + anim_duration(anim, actor->anim_frame)));
+}
+
+u8 _NGActorSystemAlloc(NGArena *arena, u8 capacity) {
+    NGArenaMark mark = NGArenaSave(arena);
+    actors = NG_ARENA_ALLOC_ARRAY(arena, Actor, capacity);
+    scene_list = NG_ARENA_ALLOC_ARRAY(arena, u8, capacity);
+    if (!actors || !scene_list) {
+        NGArenaRestore(arena, mark);
+        actor_capacity = 0;
+        return 0;
+    }
+    actor_capacity = capacity;
+    return 1;
+}
 
 void _NGActorSystemInit(void) {
-    for (u8 i = 0; i < NG_ACTOR_MAX; i++) {
+    first_free = NG_ACTOR_INVALID;
+    for (u8 i = actor_capacity; i-- > 0;) {
         actors[i].active = 0;
         actors[i].in_scene = 0;
+        actors[i].anim_queued = 0;
         actors[i].graphic = NULL;
+        actors[i].next_free = first_free;
+        first_free = i;
+    }
+    scene_count = 0;
+    for (u8 i = 0; i < NG_ANIM_WHEEL_SIZE; i++)
+        anim_wheel[i] = ANIM_NONE;
+    anim_tick = 0;
+}
+
+void _NGActorDestroyAll(u8 keep_staged) {
+    for (u8 i = 0; i < actor_capacity; i++) {
+        if (actors[i].active && !(keep_staged && _NGGraphicIsStaged(actors[i].graphic)))
+            NGActorDestroy(i);
     }
 }
 
 void _NGActorSystemUpdate(void) {
-    for (u8 i = 0; i < NG_ACTOR_MAX; i++) {
-        Actor *actor = &actors[i];
-        if (!actor->active || !actor->in_scene || !actor->asset)
-            continue;
-        if (!actor->asset->anims || actor->anim_index >= actor->asset->anim_count)
+    u16 tick = ++anim_tick;
+    u8 *bucket = &anim_wheel[tick & ANIM_WHEEL_MASK];
+    u8 handle = *bucket;
+
+    // Take the whole bucket; entries relinked below start a fresh list
+    *bucket = ANIM_NONE;
+    while (handle != ANIM_NONE) {
+        Actor *actor = &actors[handle];
+        u8 next = actor->anim_next;
+        actor->anim_queued = 0;
+
+        if (actor->anim_due != tick) {
+            anim_link(handle, actor->anim_due); // Due on a later lap
+        } else {
+            const NGAnimDef *anim = current_anim(actor);
+            actor->anim_frame = anim_next_frame(anim, actor->anim_frame);
+            if (actor->graphic)
+                NGGraphicSetFrame(actor->graphic, (u16)(anim->first_frame + actor->anim_frame));
+            anim_restart(handle);
+        }
+        handle = next;
+    }
+}
+
+/**
+ * Select the camera an actor is drawn through and cull it against that
+ * camera's view. Auto-bound actors take the first camera that sees them.
+ * @return 0 if the actor is off-screen and should give up its sprites
+ */
+static u8 select_view(Actor *actor) {
+    u8 cull = !actor->always_active && actor->visible;
+    u16 w = actor->width ? actor->width : actor->asset->width_pixels;
+    u16 h = actor->height ? actor->height : actor->asset->height_pixels;
+
+    if (actor->camera != NG_CAMERA_AUTO) {
+        NGCameraSelect(actor->camera);
+        actor->view = NGCameraGetSelected();
+        return !cull || NGCameraIsRectVisible(actor->x, actor->y, w, h);
+    }
+
+    for (NGCameraHandle cam = 0; cam < NG_CAMERA_MAX; cam++) {
+        if (!NGCameraIsValid(cam))
             continue;
-        const NGAnimDef *anim = &actor->asset->anims[actor->anim_index];
-
-        actor->anim_counter++;
-        if (actor->anim_counter >= anim->speed) {
-            actor->anim_counter = 0;
-
-            u16 old_frame = actor->anim_frame;
-            actor->anim_frame++;
-            if (actor->anim_frame >= anim->frame_count) {
-                if (anim->loop) {
-                    actor->anim_frame = 0;
-                } else {
-                    actor->anim_frame = anim->frame_count - 1;
-                }
-            }
-
-            // Update graphic with new animation frame
-            if (actor->anim_frame != old_frame && actor->graphic) {
-                u16 actual_frame = anim->first_frame + actor->anim_frame;
-                NGGraphicSetFrame(actor->graphic, actual_frame);
-            }
+        NGCameraSelect(cam);
+        if (NGCameraIsRectVisible(actor->x, actor->y, w, h)) {
+            actor->view = cam;
+            return 1;
         }
     }
+    NGCameraSelect(actor->view);
+    return !cull;
+}
+
+static void follow_body(Actor *actor) {
+    NGVec2 pos = NGPhysBodyGetDrawPos(actor->body);
+    actor->x = pos.x + actor->body_dx;
+    actor->y = pos.y + actor->body_dy;
 }
 
 /**
@@ -81,6 +226,20 @@ static void sync_actor_graphic(Actor *actor) {
     if (!actor->graphic || !actor->asset)
         return;
 
+    // Follow the bound body; a body that stayed put leaves x and y as they are
+    if (actor->body) {
+        if (!actor->body->active)
+            actor->body = NULL;
+        else if (actor->body->moved)
+            follow_body(actor);
+    }
+
+    // Off-screen: give up hardware sprites, skip the rest of the sync
+    if (!actor->screen_space && !select_view(actor)) {
+        NGGraphicSetVisible(actor->graphic, 0);
+        return;
+    }
+
     // Calculate screen position
     s16 screen_x, screen_y;
     u16 scale;
@@ -110,19 +269,19 @@ static void sync_actor_graphic(Actor *actor) {
 }
 
 u8 _NGActorIsInScene(NGActorHandle handle) {
-    if (handle < 0 || handle >= NG_ACTOR_MAX)
+    if (!valid_handle(handle))
         return 0;
     return actors[handle].active && actors[handle].in_scene;
 }
 
 u8 _NGActorGetZ(NGActorHandle handle) {
-    if (handle < 0 || handle >= NG_ACTOR_MAX)
+    if (!valid_handle(handle))
         return 0;
     return actors[handle].z;
 }
 
 u8 _NGActorIsScreenSpace(NGActorHandle handle) {
-    if (handle < 0 || handle >= NG_ACTOR_MAX)
+    if (!valid_handle(handle))
         return 0;
     return actors[handle].active && actors[handle].screen_space;
 }
@@ -131,13 +290,7 @@ NGActorHandle NGActorCreate(const NGVisualAsset *asset, u16 width, u16 height) {
     if (!asset)
         return NG_ACTOR_INVALID;
 
-    NGActorHandle handle = NG_ACTOR_INVALID;
-    for (u8 i = 0; i < NG_ACTOR_MAX; i++) {
-        if (!actors[i].active) {
-            handle = i;
-            break;
-        }
-    }
+    NGActorHandle handle = first_free;
     if (handle == NG_ACTOR_INVALID)
         return NG_ACTOR_INVALID;
 
@@ -157,6 +310,7 @@ NGActorHandle NGActorCreate(const NGVisualAsset *asset, u16 width, u16 height) {
     if (!actor->graphic) {
         return NG_ACTOR_INVALID;
     }
+    first_free = actor->next_free;
 
     // Configure graphic source
     NGGraphicSetSource(actor->graphic, asset, asset->palette);
@@ -177,15 +331,19 @@ NGActorHandle NGActorCreate(const NGVisualAsset *asset, u16 width, u16 height) {
     actor->in_scene = 0;
     actor->active = 1;
     actor->screen_space = 0;
+    actor->always_active = 0;
+    actor->camera = 0;
+    actor->view = 0;
+    actor->body = NULL;
     actor->anim_index = 0;
     actor->anim_frame = 0;
-    actor->anim_counter = 0;
+    actor->anim_queued = 0;
 
     return handle;
 }
 
 void NGActorAddToScene(NGActorHandle handle, fixed x, fixed y, u8 z) {
-    if (handle < 0 || handle >= NG_ACTOR_MAX)
+    if (!valid_handle(handle))
         return;
     Actor *actor = &actors[handle];
     if (!actor->active)
@@ -194,7 +352,12 @@ void NGActorAddToScene(NGActorHandle handle, fixed x, fixed y, u8 z) {
     actor->x = x;
     actor->y = y;
     actor->z = z;
-    actor->in_scene = 1;
+    if (!actor->in_scene) {
+        actor->in_scene = 1;
+        actor->scene_index = scene_count;
+        scene_list[scene_count++] = (u8)handle;
+        anim_restart((u8)handle);
+    }
 
     // Update graphic z-order and make visible
     if (actor->graphic) {
@@ -207,14 +370,19 @@ void NGActorAddToScene(NGActorHandle handle, fixed x, fixed y, u8 z) {
 }
 
 void NGActorRemoveFromScene(NGActorHandle handle) {
-    if (handle < 0 || handle >= NG_ACTOR_MAX)
+    if (!valid_handle(handle))
         return;
     Actor *actor = &actors[handle];
     if (!actor->active)
         return;
 
-    u8 was_in_scene = actor->in_scene;
-    actor->in_scene = 0;
+    if (actor->in_scene) {
+        u8 last = scene_list[--scene_count];
+        scene_list[actor->scene_index] = last;
+        actors[last].scene_index = actor->scene_index;
+        actor->in_scene = 0;
+        anim_unlink((u8)handle);
+    }
 
     // Hide graphic
     if (actor->graphic) {
@@ -223,10 +391,14 @@ void NGActorRemoveFromScene(NGActorHandle handle) {
 }
 
 void NGActorDestroy(NGActorHandle handle) {
-    if (handle < 0 || handle >= NG_ACTOR_MAX)
+    if (!valid_handle(handle))
         return;
 
     Actor *actor = &actors[handle];
+    if (!actor->active)
+        return;
+
+    NGActorRemoveFromScene(handle);
 
     // Destroy graphic
     if (actor->graphic) {
@@ -234,12 +406,14 @@ void NGActorDestroy(NGActorHandle handle) {
         actor->graphic = NULL;
     }
 
-    NGActorRemoveFromScene(handle);
+    NGPalSlotRelease(actor->palette);
     actor->active = 0;
+    actor->next_free = first_free;
+    first_free = handle;
 }
 
 void NGActorSetPos(NGActorHandle handle, fixed x, fixed y) {
-    if (handle < 0 || handle >= NG_ACTOR_MAX)
+    if (!valid_handle(handle))
         return;
     Actor *actor = &actors[handle];
     if (!actor->active)
@@ -249,7 +423,7 @@ void NGActorSetPos(NGActorHandle handle, fixed x, fixed y) {
 }
 
 void NGActorMove(NGActorHandle handle, fixed dx, fixed dy) {
-    if (handle < 0 || handle >= NG_ACTOR_MAX)
+    if (!valid_handle(handle))
         return;
     Actor *actor = &actors[handle];
     if (!actor->active)
@@ -259,7 +433,7 @@ void NGActorMove(NGActorHandle handle, fixed dx, fixed dy) {
 }
 
 void NGActorSetZ(NGActorHandle handle, u8 z) {
-    if (handle < 0 || handle >= NG_ACTOR_MAX)
+    if (!valid_handle(handle))
         return;
     Actor *actor = &actors[handle];
     if (!actor->active)
@@ -274,7 +448,7 @@ void NGActorSetZ(NGActorHandle handle, u8 z) {
 
 NGVec2 NGActorGetPos(NGActorHandle handle) {
     NGVec2 pos = {0, 0};
-    if (handle < 0 || handle >= NG_ACTOR_MAX)
+    if (!valid_handle(handle))
         return pos;
     pos.x = actors[handle].x;
     pos.y = actors[handle].y;
@@ -282,25 +456,25 @@ NGVec2 NGActorGetPos(NGActorHandle handle) {
 }
 
 fixed NGActorGetX(NGActorHandle handle) {
-    if (handle < 0 || handle >= NG_ACTOR_MAX)
+    if (!valid_handle(handle))
         return 0;
     return actors[handle].x;
 }
 
 fixed NGActorGetY(NGActorHandle handle) {
-    if (handle < 0 || handle >= NG_ACTOR_MAX)
+    if (!valid_handle(handle))
         return 0;
     return actors[handle].y;
 }
 
 u8 NGActorGetZ(NGActorHandle handle) {
-    if (handle < 0 || handle >= NG_ACTOR_MAX)
+    if (!valid_handle(handle))
         return 0;
     return actors[handle].z;
 }
 
 void NGActorSetAnim(NGActorHandle handle, u8 anim_index) {
-    if (handle < 0 || handle >= NG_ACTOR_MAX)
+    if (!valid_handle(handle))
         return;
     Actor *actor = &actors[handle];
     if (!actor->active || !actor->asset)
@@ -311,7 +485,7 @@ void NGActorSetAnim(NGActorHandle handle, u8 anim_index) {
     if (actor->anim_index != anim_index) {
         actor->anim_index = anim_index;
         actor->anim_frame = 0;
-        actor->anim_counter = 0;
+        anim_restart((u8)handle);
 
         // Update graphic frame
         if (actor->graphic && actor->asset->anims) {
@@ -322,7 +496,7 @@ void NGActorSetAnim(NGActorHandle handle, u8 anim_index) {
 }
 
 u8 NGActorSetAnimByName(NGActorHandle handle, const char *name) {
-    if (handle < 0 || handle >= NG_ACTOR_MAX)
+    if (!valid_handle(handle))
         return 0;
     Actor *actor = &actors[handle];
     if (!actor->active || !actor->asset || !actor->asset->anims)
@@ -338,7 +512,7 @@ u8 NGActorSetAnimByName(NGActorHandle handle, const char *name) {
 }
 
 void NGActorSetFrame(NGActorHandle handle, u16 frame) {
-    if (handle < 0 || handle >= NG_ACTOR_MAX)
+    if (!valid_handle(handle))
         return;
     Actor *actor = &actors[handle];
     if (!actor->active || !actor->asset)
@@ -348,7 +522,7 @@ void NGActorSetFrame(NGActorHandle handle, u16 frame) {
 
     if (actor->anim_frame != frame) {
         actor->anim_frame = frame;
-        actor->anim_counter = 0;
+        anim_restart((u8)handle);
 
         if (actor->graphic) {
             NGGraphicSetFrame(actor->graphic, frame);
@@ -357,7 +531,7 @@ void NGActorSetFrame(NGActorHandle handle, u16 frame) {
 }
 
 u8 NGActorAnimDone(NGActorHandle handle) {
-    if (handle < 0 || handle >= NG_ACTOR_MAX)
+    if (!valid_handle(handle))
         return 1;
     Actor *actor = &actors[handle];
     if (!actor->active || !actor->asset || !actor->asset->anims)
@@ -372,7 +546,7 @@ u8 NGActorAnimDone(NGActorHandle handle) {
 }
 
 void NGActorSetVisible(NGActorHandle handle, u8 visible) {
-    if (handle < 0 || handle >= NG_ACTOR_MAX)
+    if (!valid_handle(handle))
         return;
     Actor *actor = &actors[handle];
     if (!actor->active)
@@ -386,23 +560,23 @@ void NGActorSetVisible(NGActorHandle handle, u8 visible) {
 }
 
 void NGActorSetPalette(NGActorHandle handle, u8 palette) {
-    if (handle < 0 || handle >= NG_ACTOR_MAX)
+    if (!valid_handle(handle))
         return;
     Actor *actor = &actors[handle];
     if (!actor->active)
         return;
     if (actor->palette != palette) {
+        NGPalSlotRetain(palette);
+        NGPalSlotRelease(actor->palette);
         actor->palette = palette;
 
-        // Update graphic source with new palette
-        if (actor->graphic && actor->asset) {
-            NGGraphicSetSource(actor->graphic, actor->asset, palette);
-        }
+        if (actor->graphic)
+            NGGraphicSetPalette(actor->graphic, palette);
     }
 }
 
 void NGActorSetHFlip(NGActorHandle handle, u8 flip) {
-    if (handle < 0 || handle >= NG_ACTOR_MAX)
+    if (!valid_handle(handle))
         return;
     Actor *actor = &actors[handle];
     if (!actor->active)
@@ -411,7 +585,7 @@ void NGActorSetHFlip(NGActorHandle handle, u8 flip) {
 }
 
 void NGActorSetVFlip(NGActorHandle handle, u8 flip) {
-    if (handle < 0 || handle >= NG_ACTOR_MAX)
+    if (!valid_handle(handle))
         return;
     Actor *actor = &actors[handle];
     if (!actor->active)
@@ -420,7 +594,7 @@ void NGActorSetVFlip(NGActorHandle handle, u8 flip) {
 }
 
 void NGActorSetScreenSpace(NGActorHandle handle, u8 enabled) {
-    if (handle < 0 || handle >= NG_ACTOR_MAX)
+    if (!valid_handle(handle))
         return;
     Actor *actor = &actors[handle];
     if (!actor->active)
@@ -437,31 +611,63 @@ void NGActorSetScreenSpace(NGActorHandle handle, u8 enabled) {
     }
 }
 
+void NGActorSetAlwaysActive(NGActorHandle handle, u8 enabled) {
+    if (!valid_handle(handle))
+        return;
+    Actor *actor = &actors[handle];
+    if (!actor->active)
+        return;
+    actor->always_active = enabled ? 1 : 0;
+}
+
+void NGActorSetCamera(NGActorHandle handle, u8 camera) {
+    if (!valid_handle(handle))
+        return;
+    Actor *actor = &actors[handle];
+    if (!actor->active)
+        return;
+    actor->camera = camera;
+    if (camera != NG_CAMERA_AUTO)
+        actor->view = camera;
+}
+
+void NGActorBindBody(NGActorHandle handle, NGBodyHandle body, fixed offset_x, fixed offset_y) {
+    if (!valid_handle(handle))
+        return;
+    Actor *actor = &actors[handle];
+    if (!actor->active)
+        return;
+    actor->body = body;
+    actor->body_dx = offset_x;
+    actor->body_dy = offset_y;
+    if (body)
+        follow_body(actor);
+}
+
 /**
  * Sync all in-scene actors to their graphics.
  * Called by scene before graphic system draw.
  */
 void _NGActorSyncGraphics(void) {
-    for (u8 i = 0; i < NG_ACTOR_MAX; i++) {
-        Actor *actor = &actors[i];
-        if (actor->active && actor->in_scene) {
-            sync_actor_graphic(actor);
-        }
+    NGCameraHandle prev = NGCameraGetSelected();
+    for (u8 i = 0; i < scene_count; i++) {
+        sync_actor_graphic(&actors[scene_list[i]]);
     }
+    NGCameraSelect(prev);
 }
 
 /* Internal: collect palettes from all actors in scene into bitmask */
 void _NGActorCollectPalettes(u8 *palette_mask) {
-    for (u8 i = 0; i < NG_ACTOR_MAX; i++) {
-        Actor *actor = &actors[i];
-        if (actor->active && actor->in_scene && actor->visible) {
+    for (u8 i = 0; i < scene_count; i++) {
+        Actor *actor = &actors[scene_list[i]];
+        if (actor->visible) {
             _NGPaletteMaskSet(palette_mask, actor->palette);
         }
     }
 }
 
 void NGActorPlaySfx(NGActorHandle handle, u8 sfx_index) {
-    if (handle < 0 || handle >= NG_ACTOR_MAX)
+    if (!valid_handle(handle))
         return;
     Actor *actor = &actors[handle];
     if (!actor->active)
@@ -472,7 +678,9 @@ void NGActorPlaySfx(NGActorHandle handle, u8 sfx_index) {
     if (actor->screen_space) {
         screen_x = FIX_INT(actor->x);
     } else {
+        NGCameraHandle prev = NGCameraSelect(actor->view);
         NGCameraWorldToScreen(actor->x, actor->y, &screen_x, &screen_y);
+        NGCameraSelect(prev);
     }
 
     // Map screen position to pan: left/center/right
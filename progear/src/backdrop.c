@@ -7,6 +7,10 @@
 #include <backdrop.h>
 #include <camera.h>
 #include <graphic.h>
+#include <engine.h>
+#include <ng_palette.h>
+#include <ng_display_list.h>
+#include <ng_raster.h>
 
 #include "sdk_internal.h"
 
@@ -27,32 +31,56 @@ typedef struct {
     u8 visible;
     u8 in_scene;
     u8 active;
+    u8 camera; // Camera it is drawn through
+
+    /* Line-scroll bands (0 = whole-layer parallax) */
+    u8 band_count;
+    u16 band_row[NG_BACKDROP_MAX_BANDS];        // First source row of each band
+    fixed band_parallax[NG_BACKDROP_MAX_BANDS]; // Horizontal rate of each band
 
     NGGraphic *graphic;
 } Backdrop;
 
-static Backdrop backdrop_layers[NG_BACKDROP_MAX];
+/* Backdrop table from ng_arena_persistent, sized at engine init */
+static Backdrop *backdrop_layers;
+static u8 backdrop_capacity;
+
+u8 _NGBackdropSystemAlloc(NGArena *arena, u8 capacity) {
+    if (capacity > 127)
+        capacity = 127; /* Handles are s8 */
+    backdrop_layers = NG_ARENA_ALLOC_ARRAY(arena, Backdrop, capacity);
+    backdrop_capacity = backdrop_layers ? capacity : 0;
+    return backdrop_capacity == capacity;
+}
+
+void _NGBackdropDestroyAll(u8 keep_staged) {
+    for (u8 i = 0; i < backdrop_capacity; i++) {
+        Backdrop *bd = &backdrop_layers[i];
+        if (bd->active && !(keep_staged && _NGGraphicIsStaged(bd->graphic)))
+            NGBackdropDestroy((NGBackdropHandle)i);
+    }
+}
 
 void _NGBackdropSystemInit(void) {
-    for (u8 i = 0; i < NG_BACKDROP_MAX; i++) {
+    for (u8 i = 0; i < backdrop_capacity; i++) {
         backdrop_layers[i].active = 0;
         backdrop_layers[i].in_scene = 0;
         backdrop_layers[i].graphic = NULL;
+        backdrop_layers[i].band_count = 0;
     }
 }
 
 /**
- * Sync backdrop graphic with camera/parallax state.
+ * Sync backdrop graphic with the selected camera's parallax state.
  */
-static void sync_backdrop_graphic(Backdrop *bd) {
-    if (!bd->graphic || !bd->asset || !bd->visible)
-        return;
-
+static void sync_backdrop_view(Backdrop *bd) {
     fixed cam_x = NGCameraGetX();
     fixed cam_y = NGCameraGetY();
     fixed delta_x = cam_x - bd->anchor_cam_x;
     fixed delta_y = cam_y - bd->anchor_cam_y;
-    fixed parallax_offset_x = FIX_MUL(delta_x, bd->parallax_x);
+    /* Banded backdrops scroll the graphic itself at the top band's rate */
+    fixed rate_x = bd->band_count ? bd->band_parallax[0] : bd->parallax_x;
+    fixed parallax_offset_x = FIX_MUL(delta_x, rate_x);
     fixed parallax_offset_y = FIX_MUL(delta_y, bd->parallax_y);
 
     s16 screen_x, screen_y;
@@ -71,10 +99,50 @@ static void sync_backdrop_graphic(Backdrop *bd) {
         NGGraphicSetSourceOffset(bd->graphic, 0, 0);
     }
 
+    /* Cull when entirely outside the band (infinite backdrops always span X) */
+    u8 zoom = NGCameraGetZoom();
+    s16 band_top = NGCameraGetViewportTop();
+    s16 band_bottom = (s16)(band_top + NGCameraGetViewportHeight());
+    s16 margin_top = band_top == 0 ? NG_CAM_CULL_MARGIN : 0;
+    s16 margin_bottom = band_bottom >= SCREEN_HEIGHT ? NG_CAM_CULL_MARGIN : 0;
+    screen_y = (s16)(screen_y + band_top);
+    s16 w = (s16)((NGGraphicGetWidth(bd->graphic) * zoom) >> 4);
+    s16 h = (s16)((NGGraphicGetHeight(bd->graphic) * zoom) >> 4);
+    u8 off_x = !infinite_width && (screen_x + w <= -NG_CAM_CULL_MARGIN ||
+                                   screen_x >= SCREEN_WIDTH + NG_CAM_CULL_MARGIN);
+    u8 off_y =
+        (screen_y + h <= band_top - margin_top || screen_y >= band_bottom + margin_bottom);
+    NGGraphicSetVisible(bd->graphic, !(off_x || off_y));
+    if (off_x || off_y)
+        return;
+
     NGGraphicSetPosition(bd->graphic, screen_x, screen_y);
 
     /* Apply camera zoom to backdrop scale */
-    NGGraphicSetScale(bd->graphic, NGCameraZoomToScale(NGCameraGetZoom()));
+    NGGraphicSetScale(bd->graphic, NGCameraZoomToScale(zoom));
+}
+
+static void sync_backdrop_graphic(Backdrop *bd) {
+    if (!bd->graphic || !bd->asset || !bd->visible)
+        return;
+
+    /* Band pokes from the timer interrupt would land in the middle of
+     * immediate VRAM writes; without a display list the layer scrolls as
+     * one at the top band's rate. A change rebuilds the layer's SCBs. */
+    if (bd->band_count)
+        _NGGraphicSetScrollChain(bd->graphic, NGDisplayListIsRecording());
+
+    NGCameraHandle prev = NGCameraSelect(bd->camera);
+    sync_backdrop_view(bd);
+    NGCameraSelect(prev);
+}
+
+/* Anchor parallax to the bound camera's current position */
+static void anchor_backdrop(Backdrop *bd) {
+    NGCameraHandle prev = NGCameraSelect(bd->camera);
+    bd->anchor_cam_x = NGCameraGetX();
+    bd->anchor_cam_y = NGCameraGetY();
+    NGCameraSelect(prev);
 }
 
 NGBackdropHandle NGBackdropCreate(const NGVisualAsset *asset, u16 width, u16 height,
@@ -83,9 +151,9 @@ NGBackdropHandle NGBackdropCreate(const NGVisualAsset *asset, u16 width, u16 hei
         return NG_BACKDROP_INVALID;
 
     NGBackdropHandle handle = NG_BACKDROP_INVALID;
-    for (u8 i = 0; i < NG_BACKDROP_MAX; i++) {
+    for (u8 i = 0; i < backdrop_capacity; i++) {
         if (!backdrop_layers[i].active) {
-            handle = i;
+            handle = (NGBackdropHandle)i;
             break;
         }
     }
@@ -157,12 +225,14 @@ NGBackdropHandle NGBackdropCreate(const NGVisualAsset *asset, u16 width, u16 hei
     bd->visible = 1;
     bd->in_scene = 0;
     bd->active = 1;
+    bd->camera = 0;
+    bd->band_count = 0;
 
     return handle;
 }
 
 void NGBackdropAddToScene(NGBackdropHandle handle, s16 viewport_x, s16 viewport_y, u8 z) {
-    if (handle < 0 || handle >= NG_BACKDROP_MAX)
+    if (handle < 0 || handle >= backdrop_capacity)
         return;
     Backdrop *bd = &backdrop_layers[handle];
     if (!bd->active)
@@ -172,8 +242,7 @@ void NGBackdropAddToScene(NGBackdropHandle handle, s16 viewport_x, s16 viewport_
     bd->viewport_y = viewport_y;
     bd->z = z;
 
-    bd->anchor_cam_x = NGCameraGetX();
-    bd->anchor_cam_y = NGCameraGetY();
+    anchor_backdrop(bd);
 
     bd->in_scene = 1;
 
@@ -186,7 +255,7 @@ void NGBackdropAddToScene(NGBackdropHandle handle, s16 viewport_x, s16 viewport_
 }
 
 void NGBackdropRemoveFromScene(NGBackdropHandle handle) {
-    if (handle < 0 || handle >= NG_BACKDROP_MAX)
+    if (handle < 0 || handle >= backdrop_capacity)
         return;
     Backdrop *bd = &backdrop_layers[handle];
     if (!bd->active)
@@ -201,7 +270,7 @@ void NGBackdropRemoveFromScene(NGBackdropHandle handle) {
 }
 
 void NGBackdropDestroy(NGBackdropHandle handle) {
-    if (handle < 0 || handle >= NG_BACKDROP_MAX)
+    if (handle < 0 || handle >= backdrop_capacity)
         return;
 
     Backdrop *bd = &backdrop_layers[handle];
@@ -213,11 +282,13 @@ void NGBackdropDestroy(NGBackdropHandle handle) {
     }
 
     NGBackdropRemoveFromScene(handle);
+    if (bd->active)
+        NGPalSlotRelease(bd->palette);
     bd->active = 0;
 }
 
 void NGBackdropSetViewportPos(NGBackdropHandle handle, s16 viewport_x, s16 viewport_y) {
-    if (handle < 0 || handle >= NG_BACKDROP_MAX)
+    if (handle < 0 || handle >= backdrop_capacity)
         return;
     Backdrop *bd = &backdrop_layers[handle];
     if (!bd->active)
@@ -226,12 +297,21 @@ void NGBackdropSetViewportPos(NGBackdropHandle handle, s16 viewport_x, s16 viewp
     bd->viewport_x = viewport_x;
     bd->viewport_y = viewport_y;
 
-    bd->anchor_cam_x = NGCameraGetX();
-    bd->anchor_cam_y = NGCameraGetY();
+    anchor_backdrop(bd);
+}
+
+void NGBackdropSetCamera(NGBackdropHandle handle, u8 camera) {
+    if (handle < 0 || handle >= backdrop_capacity)
+        return;
+    Backdrop *bd = &backdrop_layers[handle];
+    if (!bd->active)
+        return;
+    bd->camera = camera;
+    anchor_backdrop(bd);
 }
 
 void NGBackdropSetZ(NGBackdropHandle handle, u8 z) {
-    if (handle < 0 || handle >= NG_BACKDROP_MAX)
+    if (handle < 0 || handle >= backdrop_capacity)
         return;
     Backdrop *bd = &backdrop_layers[handle];
     if (!bd->active)
@@ -245,7 +325,7 @@ void NGBackdropSetZ(NGBackdropHandle handle, u8 z) {
 }
 
 void NGBackdropSetVisible(NGBackdropHandle handle, u8 visible) {
-    if (handle < 0 || handle >= NG_BACKDROP_MAX)
+    if (handle < 0 || handle >= backdrop_capacity)
         return;
     Backdrop *bd = &backdrop_layers[handle];
     if (!bd->active)
@@ -259,18 +339,44 @@ void NGBackdropSetVisible(NGBackdropHandle handle, u8 visible) {
 }
 
 void NGBackdropSetPalette(NGBackdropHandle handle, u8 palette) {
-    if (handle < 0 || handle >= NG_BACKDROP_MAX)
+    if (handle < 0 || handle >= backdrop_capacity)
         return;
     Backdrop *bd = &backdrop_layers[handle];
     if (!bd->active)
         return;
     if (bd->palette != palette) {
+        NGPalSlotRetain(palette);
+        NGPalSlotRelease(bd->palette);
         bd->palette = palette;
-        /* Update graphic source with new palette */
-        if (bd->graphic && bd->asset) {
-            NGGraphicSetSource(bd->graphic, bd->asset, palette);
-        }
+        if (bd->graphic)
+            NGGraphicSetPalette(bd->graphic, palette);
+    }
+}
+
+u8 NGBackdropSetBands(NGBackdropHandle handle, const u16 *rows, const fixed *parallax_x,
+                      u8 count) {
+    if (handle < 0 || handle >= backdrop_capacity)
+        return 0;
+    Backdrop *bd = &backdrop_layers[handle];
+    if (!bd->active || !bd->graphic)
+        return 0;
+    if (count > NG_BACKDROP_MAX_BANDS)
+        return 0;
+    if (count > 0 && (bd->width != NG_BACKDROP_WIDTH_INFINITE || !rows || !parallax_x))
+        return 0;
+    if (count > 0 && !NGEngineGetDeferredDraw())
+        return 0; /* Raster pokes need VRAM to be idle in active display */
+
+    for (u8 i = 0; i < count; i++) {
+        if (i > 0 && rows[i] <= rows[i - 1])
+            return 0; /* Bands must go down the layer */
+        bd->band_row[i] = rows[i];
+        bd->band_parallax[i] = parallax_x[i];
     }
+    bd->band_count = count;
+    if (!count)
+        _NGGraphicSetScrollChain(bd->graphic, 0);
+    return 1;
 }
 
 /**
@@ -278,7 +384,7 @@ void NGBackdropSetPalette(NGBackdropHandle handle, u8 palette) {
  * Called by scene before graphic system draw.
  */
 void _NGBackdropSyncGraphics(void) {
-    for (u8 i = 0; i < NG_BACKDROP_MAX; i++) {
+    for (u8 i = 0; i < backdrop_capacity; i++) {
         Backdrop *bd = &backdrop_layers[i];
         if (bd->active && bd->in_scene) {
             sync_backdrop_graphic(bd);
@@ -286,9 +392,47 @@ void _NGBackdropSyncGraphics(void) {
     }
 }
 
+/**
+ * Add raster entries for banded backdrops: one SCB4 write per band,
+ * moving the layer's sticky chain to that band's parallax offset.
+ * Called by scene after graphic system draw, once sprites are allocated;
+ * the scene submits the table.
+ */
+u8 _NGBackdropAddRaster(void) {
+    u8 any = 0;
+
+    for (u8 i = 0; i < backdrop_capacity; i++) {
+        Backdrop *bd = &backdrop_layers[i];
+        if (!bd->active || !bd->in_scene || !bd->visible || !bd->band_count)
+            continue;
+
+        NGCameraHandle prev = NGCameraSelect(bd->camera);
+        fixed delta_x = NGCameraGetX() - bd->anchor_cam_x;
+        NGCameraSelect(prev);
+        for (u8 b = 0; b < bd->band_count; b++) {
+            s16 offset_x = FIX_INT(FIX_MUL(delta_x, bd->band_parallax[b]));
+            s16 line;
+            u16 sprite, scb4;
+            if (!_NGGraphicScrollChainBand(bd->graphic, offset_x, bd->band_row[b], &line,
+                                           &sprite, &scb4))
+                break;
+            if (line >= NG_RASTER_LINES)
+                break;
+            /* Bands above the screen collapse onto line 0; the last one wins.
+             * Band 0 always lands there to undo last frame's final band. */
+            if (b == 0 || line < 0)
+                line = 0;
+            if (NGRasterAddSCB4((u16)line, sprite, scb4))
+                any = 1;
+        }
+    }
+
+    return any;
+}
+
 /* Internal: collect palettes from all backdrop layers in scene into bitmask */
 void _NGBackdropCollectPalettes(u8 *palette_mask) {
-    for (u8 i = 0; i < NG_BACKDROP_MAX; i++) {
+    for (u8 i = 0; i < backdrop_capacity; i++) {
         Backdrop *bd = &backdrop_layers[i];
         if (bd->active && bd->in_scene && bd->visible) {
             _NGPaletteMaskSet(palette_mask, bd->palette);
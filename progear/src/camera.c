@@ -27,9 +27,13 @@ static const u16 zoom_shrink_table[129] = {
     0x0EEF, 0x0EF0, 0x0EF1, 0x0EF2, 0x0EF3, 0x0EF4, 0x0EF5, 0x0EF6, 0x0EF7, 0x0EF8, 0x0EF9, 0x0EFA,
     0x0EFB, 0x0EFC, 0x0EFD, 0x0EFE, 0x0FFF};
 
-static struct {
+typedef struct {
     fixed x;
     fixed y;
+    fixed last_x; /* Position at the previous update */
+    fixed last_y;
+    fixed vel_x; /* Movement over the last update, 0 after a cut */
+    fixed vel_y;
     struct {
         u8 index;
         u8 target;
@@ -52,14 +56,40 @@ static struct {
         u16 bounds_h;
         s16 offset_x;
         s16 offset_y;
+        u8 look_ahead; /* Frames of actor velocity to lead by */
+        u8 primed;     /* last_x/last_y hold a sample */
+        fixed last_x;
+        fixed last_y;
+        fixed vel_x; /* Smoothed actor velocity per frame */
+        fixed vel_y;
     } track;
-} camera = {
-    .shake.rand_state = 0x1234,
-    .track.actor = NG_ACTOR_INVALID,
-    .track.deadzone_w = 64,
-    .track.deadzone_h = 32,
-    .track.follow_speed = FIX(0.15),
-};
+    u8 view_top;    /* Screen band the camera draws into */
+    u8 view_height;
+    u8 active;
+} Camera;
+
+/* A jump this large in one update is a cut, not movement */
+#define CUT_DISTANCE FIX(64)
+
+/* Fresh camera: origin, 100% zoom, full screen */
+#define CAMERA_DEFAULTS                                                                            \
+    {                                                                                              \
+        .zoom = {ZOOM_INDEX_MAX, ZOOM_INDEX_MAX, 16},                                              \
+        .shake.rand_state = 0x1234,                                                                \
+        .track.actor = NG_ACTOR_INVALID,                                                           \
+        .track.deadzone_w = 64,                                                                    \
+        .track.deadzone_h = 32,                                                                    \
+        .track.follow_speed = FIX(0.15),                                                           \
+        .view_height = SCREEN_HEIGHT,                                                              \
+        .active = 1,                                                                               \
+    }
+
+static const Camera camera_defaults = CAMERA_DEFAULTS;
+
+/* Camera 0 always exists; every NGCamera call works on the selected one */
+static Camera cameras[NG_CAMERA_MAX] = {CAMERA_DEFAULTS};
+static Camera *camera = &cameras[0];
+static NGCameraHandle selected;
 
 static inline u8 zoom_to_index(u8 zoom) {
     if (zoom < 8)
@@ -78,29 +108,92 @@ fixed NGCameraGetRenderX(void);
 fixed NGCameraGetRenderY(void);
 
 void NGCameraInit(void) {
-    camera.x = 0;
-    camera.y = 0;
-    camera.zoom.index = ZOOM_INDEX_MAX;
-    camera.zoom.target = ZOOM_INDEX_MAX;
-    camera.zoom.step = 16;
+    for (u8 i = 1; i < NG_CAMERA_MAX; i++)
+        cameras[i].active = 0;
+    selected = 0;
+    camera = &cameras[0];
+
+    camera->x = 0;
+    camera->y = 0;
+    camera->last_x = 0;
+    camera->last_y = 0;
+    camera->vel_x = 0;
+    camera->vel_y = 0;
+    camera->zoom.index = ZOOM_INDEX_MAX;
+    camera->zoom.target = ZOOM_INDEX_MAX;
+    camera->zoom.step = 16;
+    camera->view_top = 0;
+    camera->view_height = SCREEN_HEIGHT;
+}
+
+NGCameraHandle NGCameraCreate(void) {
+    for (u8 i = 1; i < NG_CAMERA_MAX; i++) {
+        if (!cameras[i].active) {
+            cameras[i] = camera_defaults;
+            return i;
+        }
+    }
+    return NG_CAMERA_INVALID;
+}
+
+void NGCameraDestroy(NGCameraHandle cam) {
+    if (cam == 0 || cam >= NG_CAMERA_MAX)
+        return;
+    cameras[cam].active = 0;
+    if (selected == cam)
+        NGCameraSelect(0);
+}
+
+u8 NGCameraIsValid(NGCameraHandle cam) {
+    return cam < NG_CAMERA_MAX && cameras[cam].active;
+}
+
+NGCameraHandle NGCameraSelect(NGCameraHandle cam) {
+    NGCameraHandle prev = selected;
+    if (!NGCameraIsValid(cam))
+        cam = 0;
+    selected = cam;
+    camera = &cameras[cam];
+    return prev;
+}
+
+NGCameraHandle NGCameraGetSelected(void) {
+    return selected;
+}
+
+void NGCameraSetViewport(u8 top, u8 height) {
+    if (top >= SCREEN_HEIGHT)
+        top = SCREEN_HEIGHT - 1;
+    if (height == 0 || height > SCREEN_HEIGHT - top)
+        height = (u8)(SCREEN_HEIGHT - top);
+    camera->view_top = top;
+    camera->view_height = height;
+}
+
+u8 NGCameraGetViewportTop(void) {
+    return camera->view_top;
+}
+
+u8 NGCameraGetViewportHeight(void) {
+    return camera->view_height;
 }
 
 void NGCameraSetPos(fixed x, fixed y) {
-    camera.x = x;
-    camera.y = y;
+    camera->x = x;
+    camera->y = y;
 }
 
 void NGCameraMove(fixed dx, fixed dy) {
-    camera.x += dx;
-    camera.y += dy;
+    camera->x += dx;
+    camera->y += dy;
 }
 
 fixed NGCameraGetX(void) {
-    return camera.x;
+    return camera->x;
 }
 
 fixed NGCameraGetY(void) {
-    return camera.y;
+    return camera->y;
 }
 
 void NGCameraSetZoom(u8 zoom) {
@@ -109,8 +202,8 @@ void NGCameraSetZoom(u8 zoom) {
     if (zoom < NG_CAM_ZOOM_75)
         zoom = NG_CAM_ZOOM_75;
     u8 idx = zoom_to_index(zoom);
-    camera.zoom.index = idx;
-    camera.zoom.target = idx;
+    camera->zoom.index = idx;
+    camera->zoom.target = idx;
 }
 
 void NGCameraSetTargetZoom(u8 zoom) {
@@ -118,7 +211,7 @@ void NGCameraSetTargetZoom(u8 zoom) {
         zoom = NG_CAM_ZOOM_100;
     if (zoom < NG_CAM_ZOOM_75)
         zoom = NG_CAM_ZOOM_75;
-    camera.zoom.target = zoom_to_index(zoom);
+    camera->zoom.target = zoom_to_index(zoom);
 }
 
 void NGCameraSetZoomSpeed(fixed speed) {
@@ -127,59 +220,107 @@ void NGCameraSetZoomSpeed(fixed speed) {
         step = 1;
     if (step > 32)
         step = 32;
-    camera.zoom.step = step;
+    camera->zoom.step = step;
 }
 
 u8 NGCameraGetZoom(void) {
-    return index_to_zoom(camera.zoom.index);
+    return index_to_zoom(camera->zoom.index);
 }
 
 u8 NGCameraIsZooming(void) {
-    return camera.zoom.index != camera.zoom.target ? 1 : 0;
+    return camera->zoom.index != camera->zoom.target ? 1 : 0;
 }
 
 u8 NGCameraGetTargetZoom(void) {
-    return index_to_zoom(camera.zoom.target);
+    return index_to_zoom(camera->zoom.target);
 }
 
 u16 NGCameraGetShrink(void) {
-    return zoom_shrink_table[camera.zoom.index];
+    return zoom_shrink_table[camera->zoom.index];
 }
 
 static void update_shake(void);
 static void update_tracking(void);
 
+static void update_camera(void);
+
 void NGCameraUpdate(void) {
-    if (camera.zoom.index != camera.zoom.target) {
-        if (camera.zoom.index < camera.zoom.target) {
-            camera.zoom.index += camera.zoom.step;
-            if (camera.zoom.index > camera.zoom.target) {
-                camera.zoom.index = camera.zoom.target;
+    NGCameraHandle prev = selected;
+    for (u8 i = 0; i < NG_CAMERA_MAX; i++) {
+        if (cameras[i].active) {
+            NGCameraSelect(i);
+            update_camera();
+        }
+    }
+    NGCameraSelect(prev);
+}
+
+static void update_camera(void) {
+    if (camera->zoom.index != camera->zoom.target) {
+        if (camera->zoom.index < camera->zoom.target) {
+            camera->zoom.index += camera->zoom.step;
+            if (camera->zoom.index > camera->zoom.target) {
+                camera->zoom.index = camera->zoom.target;
             }
         } else {
-            if (camera.zoom.index >= camera.zoom.step) {
-                camera.zoom.index -= camera.zoom.step;
+            if (camera->zoom.index >= camera->zoom.step) {
+                camera->zoom.index -= camera->zoom.step;
             } else {
-                camera.zoom.index = 0;
+                camera->zoom.index = 0;
             }
-            if (camera.zoom.index < camera.zoom.target) {
-                camera.zoom.index = camera.zoom.target;
+            if (camera->zoom.index < camera->zoom.target) {
+                camera->zoom.index = camera->zoom.target;
             }
         }
     }
 
     update_tracking();
     update_shake();
+
+    camera->vel_x = camera->x - camera->last_x;
+    camera->vel_y = camera->y - camera->last_y;
+    if (camera->vel_x > CUT_DISTANCE || camera->vel_x < -CUT_DISTANCE ||
+        camera->vel_y > CUT_DISTANCE || camera->vel_y < -CUT_DISTANCE) {
+        camera->vel_x = 0;
+        camera->vel_y = 0;
+    }
+    camera->last_x = camera->x;
+    camera->last_y = camera->y;
+}
+
+void NGCameraGetVelocity(fixed *vel_x, fixed *vel_y) {
+    *vel_x = camera->vel_x;
+    *vel_y = camera->vel_y;
+}
+
+void NGCameraPredict(u8 frames, fixed *x, fixed *y) {
+    *x = camera->x + camera->vel_x * frames;
+    *y = camera->y + camera->vel_y * frames;
 }
 
 u16 NGCameraGetVisibleWidth(void) {
-    u8 zoom = index_to_zoom(camera.zoom.index);
+    u8 zoom = index_to_zoom(camera->zoom.index);
     return (SCREEN_WIDTH * 16) / zoom;
 }
 
 u16 NGCameraGetVisibleHeight(void) {
-    u8 zoom = index_to_zoom(camera.zoom.index);
-    return (SCREEN_HEIGHT * 16) / zoom;
+    u8 zoom = index_to_zoom(camera->zoom.index);
+    return (u16)((camera->view_height * 16) / zoom);
+}
+
+u8 NGCameraIsRectVisible(fixed x, fixed y, u16 width, u16 height) {
+    /* No margin across a split: what lies past it belongs to the other view */
+    s32 margin_top = camera->view_top == 0 ? NG_CAM_CULL_MARGIN : 0;
+    s32 margin_bottom =
+        camera->view_top + camera->view_height >= SCREEN_HEIGHT ? NG_CAM_CULL_MARGIN : 0;
+
+    /* Rectangle relative to the widened view's top-left corner */
+    s32 left = ((x - NGCameraGetRenderX()) >> FIX_SHIFT) + NG_CAM_CULL_MARGIN;
+    s32 top = ((y - NGCameraGetRenderY()) >> FIX_SHIFT) + margin_top;
+    s32 view_w = NGCameraGetVisibleWidth() + 2 * NG_CAM_CULL_MARGIN;
+    s32 view_h = NGCameraGetVisibleHeight() + margin_top + margin_bottom;
+
+    return (left + width > 0 && left < view_w && top + height > 0 && top < view_h);
 }
 
 void NGCameraClampToBounds(u16 world_width, u16 world_height) {
@@ -190,28 +331,28 @@ void NGCameraClampToBounds(u16 world_width, u16 world_height) {
         world_height = 512;
     }
 
-    if (camera.x < 0) {
-        camera.x = 0;
+    if (camera->x < 0) {
+        camera->x = 0;
     }
 
     s32 max_x = (s32)world_width - (s32)vis_w;
     if (max_x < 0)
         max_x = 0;
 
-    if (camera.x > FIX(max_x)) {
-        camera.x = FIX(max_x);
+    if (camera->x > FIX(max_x)) {
+        camera->x = FIX(max_x);
     }
 
-    if (camera.y < 0) {
-        camera.y = 0;
+    if (camera->y < 0) {
+        camera->y = 0;
     }
 
     s32 max_y = (s32)world_height - (s32)vis_h;
     if (max_y < 0)
         max_y = 0;
 
-    if (camera.y > FIX(max_y)) {
-        camera.y = FIX(max_y);
+    if (camera->y > FIX(max_y)) {
+        camera->y = FIX(max_y);
     }
 }
 
@@ -219,89 +360,100 @@ void NGCameraWorldToScreen(fixed world_x, fixed world_y, s16 *screen_x, s16 *scr
     fixed rel_x = world_x - NGCameraGetRenderX();
     fixed rel_y = world_y - NGCameraGetRenderY();
 
-    s32 zoom = index_to_zoom(camera.zoom.index);
+    s32 zoom = index_to_zoom(camera->zoom.index);
     s32 scaled_x = (FIX_INT(rel_x) * zoom) >> 4;
     s32 scaled_y = (FIX_INT(rel_y) * zoom) >> 4;
 
     *screen_x = (s16)scaled_x;
-    *screen_y = (s16)scaled_y;
+    *screen_y = (s16)(scaled_y + camera->view_top);
 }
 
 void NGCameraScreenToWorld(s16 screen_x, s16 screen_y, fixed *world_x, fixed *world_y) {
-    s32 zoom = index_to_zoom(camera.zoom.index);
+    s32 zoom = index_to_zoom(camera->zoom.index);
     s32 unscaled_x = ((s32)screen_x << 4) / zoom;
-    s32 unscaled_y = ((s32)screen_y << 4) / zoom;
+    s32 unscaled_y = ((s32)(screen_y - camera->view_top) << 4) / zoom;
 
-    *world_x = FIX(unscaled_x) + camera.x;
-    *world_y = FIX(unscaled_y) + camera.y;
+    *world_x = FIX(unscaled_x) + camera->x;
+    *world_y = FIX(unscaled_y) + camera->y;
 }
 
 static s8 shake_random(void) {
-    camera.shake.rand_state = (u16)(camera.shake.rand_state * 1103515245 + 12345);
-    return (s8)((camera.shake.rand_state >> 8) & 0xFF);
+    camera->shake.rand_state = (u16)(camera->shake.rand_state * 1103515245 + 12345);
+    return (s8)((camera->shake.rand_state >> 8) & 0xFF);
 }
 
 void NGCameraShake(u8 intensity, u8 duration) {
-    camera.shake.intensity = intensity;
-    camera.shake.duration = duration;
-    camera.shake.timer = duration;
+    camera->shake.intensity = intensity;
+    camera->shake.duration = duration;
+    camera->shake.timer = duration;
 }
 
 u8 NGCameraIsShaking(void) {
-    return camera.shake.timer > 0 ? 1 : 0;
+    return camera->shake.timer > 0 ? 1 : 0;
 }
 
 void NGCameraShakeStop(void) {
-    camera.shake.timer = 0;
-    camera.shake.offset_x = 0;
-    camera.shake.offset_y = 0;
+    camera->shake.timer = 0;
+    camera->shake.offset_x = 0;
+    camera->shake.offset_y = 0;
 }
 
 static void update_shake(void) {
-    if (camera.shake.timer > 0) {
-        camera.shake.timer--;
+    if (camera->shake.timer > 0) {
+        camera->shake.timer--;
 
         s32 current_intensity =
-            (camera.shake.intensity * camera.shake.timer) / camera.shake.duration;
-        if (current_intensity < 1 && camera.shake.timer > 0)
+            (camera->shake.intensity * camera->shake.timer) / camera->shake.duration;
+        if (current_intensity < 1 && camera->shake.timer > 0)
             current_intensity = 1;
 
-        camera.shake.offset_x =
+        camera->shake.offset_x =
             (s8)((shake_random() % (current_intensity * 2 + 1)) - current_intensity);
-        camera.shake.offset_y =
+        camera->shake.offset_y =
             (s8)((shake_random() % (current_intensity * 2 + 1)) - current_intensity);
     } else {
-        camera.shake.offset_x = 0;
-        camera.shake.offset_y = 0;
+        camera->shake.offset_x = 0;
+        camera->shake.offset_y = 0;
     }
 }
 
 fixed NGCameraGetRenderX(void) {
-    return camera.x + FIX(camera.shake.offset_x);
+    return camera->x + FIX(camera->shake.offset_x);
 }
 
 fixed NGCameraGetRenderY(void) {
-    return camera.y + FIX(camera.shake.offset_y);
+    return camera->y + FIX(camera->shake.offset_y);
 }
 
 static void update_tracking(void) {
-    if (camera.track.actor == NG_ACTOR_INVALID)
+    if (camera->track.actor == NG_ACTOR_INVALID)
         return;
 
-    fixed actor_x = NGActorGetX(camera.track.actor);
-    fixed actor_y = NGActorGetY(camera.track.actor);
+    fixed actor_x = NGActorGetX(camera->track.actor);
+    fixed actor_y = NGActorGetY(camera->track.actor);
+
+    /* Lead the target by the actor's smoothed velocity */
+    if (camera->track.primed) {
+        camera->track.vel_x += (actor_x - camera->track.last_x - camera->track.vel_x) >> 2;
+        camera->track.vel_y += (actor_y - camera->track.last_y - camera->track.vel_y) >> 2;
+    }
+    camera->track.last_x = actor_x;
+    camera->track.last_y = actor_y;
+    camera->track.primed = 1;
+    actor_x += camera->track.vel_x * camera->track.look_ahead;
+    actor_y += camera->track.vel_y * camera->track.look_ahead;
 
     u16 vis_w = NGCameraGetVisibleWidth();
     u16 vis_h = NGCameraGetVisibleHeight();
 
-    fixed cam_center_x = camera.x + FIX(vis_w / 2);
-    fixed cam_center_y = camera.y + FIX(vis_h / 2);
+    fixed cam_center_x = camera->x + FIX(vis_w / 2);
+    fixed cam_center_y = camera->y + FIX(vis_h / 2);
 
-    fixed dist_x = actor_x + FIX(camera.track.offset_x) - cam_center_x;
-    fixed dist_y = actor_y + FIX(camera.track.offset_y) - cam_center_y;
+    fixed dist_x = actor_x + FIX(camera->track.offset_x) - cam_center_x;
+    fixed dist_y = actor_y + FIX(camera->track.offset_y) - cam_center_y;
 
-    fixed deadzone_half_w = FIX(camera.track.deadzone_w / 2);
-    fixed deadzone_half_h = FIX(camera.track.deadzone_h / 2);
+    fixed deadzone_half_w = FIX(camera->track.deadzone_w / 2);
+    fixed deadzone_half_h = FIX(camera->track.deadzone_h / 2);
 
     fixed move_x = 0;
     fixed move_y = 0;
@@ -318,37 +470,44 @@ static void update_tracking(void) {
         move_y = dist_y + deadzone_half_h;
     }
 
-    camera.x += FIX_MUL(move_x, camera.track.follow_speed);
-    camera.y += FIX_MUL(move_y, camera.track.follow_speed);
+    camera->x += FIX_MUL(move_x, camera->track.follow_speed);
+    camera->y += FIX_MUL(move_y, camera->track.follow_speed);
 
-    if (camera.track.bounds_w > 0 || camera.track.bounds_h > 0) {
-        NGCameraClampToBounds(camera.track.bounds_w, camera.track.bounds_h);
+    if (camera->track.bounds_w > 0 || camera->track.bounds_h > 0) {
+        NGCameraClampToBounds(camera->track.bounds_w, camera->track.bounds_h);
     }
 }
 
 void NGCameraTrackActor(NGActorHandle actor) {
-    camera.track.actor = actor;
+    camera->track.actor = actor;
+    camera->track.primed = 0;
+    camera->track.vel_x = 0;
+    camera->track.vel_y = 0;
 }
 
 void NGCameraStopTracking(void) {
-    camera.track.actor = NG_ACTOR_INVALID;
+    camera->track.actor = NG_ACTOR_INVALID;
 }
 
 void NGCameraSetDeadzone(u16 width, u16 height) {
-    camera.track.deadzone_w = width;
-    camera.track.deadzone_h = height;
+    camera->track.deadzone_w = width;
+    camera->track.deadzone_h = height;
 }
 
 void NGCameraSetFollowSpeed(fixed speed) {
-    camera.track.follow_speed = speed;
+    camera->track.follow_speed = speed;
 }
 
 void NGCameraSetBounds(u16 world_width, u16 world_height) {
-    camera.track.bounds_w = world_width;
-    camera.track.bounds_h = world_height;
+    camera->track.bounds_w = world_width;
+    camera->track.bounds_h = world_height;
+}
+
+void NGCameraSetLookAhead(u8 frames) {
+    camera->track.look_ahead = frames;
 }
 
 void NGCameraSetTrackOffset(s16 offset_x, s16 offset_y) {
-    camera.track.offset_x = offset_x;
-    camera.track.offset_y = offset_y;
+    camera->track.offset_x = offset_x;
+    camera->track.offset_y = offset_y;
 }
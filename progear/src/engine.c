@@ -9,51 +9,208 @@
 #include <ng_arena.h>
 #include <ng_palette.h>
 #include <ng_fix.h>
+#include <ng_display_list.h>
+#include <ng_vblank.h>
+#include <ng_idle.h>
+#include <ng_decomp.h>
+#include <ng_profile.h>
 #include <scene.h>
 #include <camera.h>
 #include <ng_input.h>
 #include <ng_audio.h>
 #include <ui.h>
 #include <lighting.h>
+#include <physics.h>
+#include <particles.h>
+#include <widget.h>
+#include <spring.h>
+
+#include "sdk_internal.h"
 
 static NGMenuHandle g_active_menu = 0;
+static u8 g_deferred_draw = 0;
+
+// Frame skip: most draws skipped in a row (0 = off), whether this frame
+// skips, and how many in a row have so far
+static u8 g_frame_skip = 0;
+static u8 g_skip_draw = 0;
+static u8 g_skip_run = 0;
+static u8 g_frame_vblanks = 1;
+static u16 g_last_frame_end; // NGVBlankCount() when the last frame ended
+static NGEngineFrameStats g_frame_stats;
+
+// Fix layer upload, run inside the VBlank interrupt. Budgeted for a few
+// hundred changed cells; a larger flush still finishes once started.
+#define FIX_FLUSH_LINES 8
+static NGVBlankJob fix_job;
+
+// Queued LZ4 data unpacks before the VBlank wait, one NGDecompRun() per
+// slice. The default 1024-byte budget at roughly 28 cycles a byte is under
+// 40 lines; a game raising the budget should expect longer slices.
+#define DECOMP_SLICE_LINES 40
 
 // Weak default - games using progear_assets.py provide a strong definition that loads palette data
 __attribute__((weak)) void NGPalInitAssets(void) {}
 
+static u8 decomp_slice(void) {
+    NGDecompRun();
+    return NGDecompPending() ? 1 : 0;
+}
+
+// One VBlank between frame ends is on time; each more showed the last
+// frame again. A late frame has the next one skip its draw to catch up.
+static void frame_timing(void) {
+    u16 now = NGVBlankCount();
+    u16 vblanks = (u16)(now - g_last_frame_end);
+    g_last_frame_end = now;
+    if (!vblanks)
+        vblanks = 1;
+    else if (vblanks > 255)
+        vblanks = 255;
+    g_frame_vblanks = (u8)vblanks;
+
+    g_frame_stats.frames++;
+    if (g_skip_draw)
+        g_frame_stats.skipped_draws++;
+    if (vblanks > 1) {
+        g_frame_stats.late++;
+        g_frame_stats.dropped = (u16)(g_frame_stats.dropped + vblanks - 1);
+        if (vblanks > g_frame_stats.worst)
+            g_frame_stats.worst = (u8)vblanks;
+    }
+
+    if (vblanks > 1 && g_skip_run < g_frame_skip) {
+        g_skip_draw = 1;
+        g_skip_run++;
+    } else {
+        g_skip_draw = 0;
+        g_skip_run = 0;
+    }
+}
+
+static u8 capacity_or(u8 value, u8 fallback) {
+    return value ? value : fallback;
+}
+
 void NGEngineInit(void) {
+    NGEngineInitWithConfig(NULL);
+}
+
+u8 NGEngineInitWithConfig(const NGEngineConfig *config) {
+    static const NGEngineConfig defaults = {0};
+    if (!config)
+        config = &defaults;
+
     NGArenaSystemInit();
+
+    // Object tables live for the whole game at the bottom of the persistent arena
+    NGArena *arena = &ng_arena_persistent;
+    u8 ok = _NGGraphicSystemAlloc(arena, capacity_or(config->graphics, NG_GRAPHIC_MAX));
+    ok &= _NGActorSystemAlloc(arena, capacity_or(config->actors, NG_ACTOR_MAX));
+    ok &= _NGTerrainSystemAlloc(arena, capacity_or(config->terrains, NG_TERRAIN_MAX));
+    ok &= _NGBackdropSystemAlloc(arena, capacity_or(config->backdrops, NG_BACKDROP_MAX));
+    _NGPhysSystemInit(capacity_or(config->bodies, NG_PHYS_MAX_BODIES));
+    ok &= _NGParticlesSystemAlloc(arena, config->particles,
+                                  capacity_or(config->particle_sprites, NG_PARTICLE_SPRITES));
+    ok &= _NGWidgetSystemAlloc(arena, config->widgets, config->gauge_sprites);
+    ok &= _NGSpriteTextSystemAlloc(arena, config->text_sprites);
+    ok &= _NGSaveSystemAlloc(arena, config->save_size);
+
     NGPalInitDefault();
+    NGPalSlotsReset();
     NGTextSetFont(768); // Use game font at tile 768+ (BIOS uses 0-767)
     NGFixClearAll();
+    NGVBlankJobsClear();
+    NGDecompClear();
+    fix_job = NGVBlankJobAdd(NGFixFlush, 0, FIX_FLUSH_LINES);
+    NGIdleJobsClear();
+    NGIdleSetMargin(NG_IDLE_MARGIN);
+    NGIdleJobAdd(decomp_slice, 0, DECOMP_SLICE_LINES);
+    _NGWidgetSystemInit();
     NGSceneInit();
     NGCameraInit();
     NGInputInit();
     NGAudioInit();
     NGLightingInit();
+    NGSpringSystemReset();
     NGPalInitAssets();
     NGPalSetBackdrop(NG_COLOR_BLACK);
     g_active_menu = 0;
+    g_frame_skip = 0;
+    g_skip_draw = 0;
+    g_skip_run = 0;
+    g_frame_vblanks = 1;
+    g_last_frame_end = NGVBlankCount();
+    NGEngineResetFrameStats();
+
+#ifdef NG_PROFILE
+    NGProfileRegister(NG_PROF_INPUT, "INPUT");
+    NGProfileRegister(NG_PROF_LIGHTING, "LIGHTING");
+    NGProfileRegister(NG_PROF_CAMERA, "CAMERA");
+    NGProfileRegister(NG_PROF_ACTORS, "ACTORS");
+    NGProfileRegister(NG_PROF_SYNC_BACKDROP, "SYNC BD");
+    NGProfileRegister(NG_PROF_SYNC_TERRAIN, "SYNC TER");
+    NGProfileRegister(NG_PROF_SYNC_ACTORS, "SYNC ACT");
+    NGProfileRegister(NG_PROF_GRAPHIC_DRAW, "GFX DRAW");
+    NGProfileRegister(NG_PROF_IDLE, "IDLE");
+#endif
+    return ok;
 }
 
 void NGEngineFrameStart(void) {
+    // Background work fills the lines the frame has left. Its time counts
+    // toward the next profiler frame.
+    NG_PROFILE_BEGIN(NG_PROF_IDLE);
+    NGIdleRun();
+    NG_PROFILE_END(NG_PROF_IDLE);
     NGWaitVBlank();
+    // A frame that ran past VBlank submits its list after the flag is
+    // already set, so the wait returns at once with the list unplayed.
+    // It lives in ng_arena_frame: let the next VBlank replay it first.
+    while (ng_display_list_pending)
+        NGWaitVBlank();
     NGWatchdogKick();
-
-    // Draw menu text immediately after vblank while VRAM is safe to write.
-    // Fix layer tiles persist in VRAM, so we only write when content changes.
-    if (g_active_menu && NGMenuNeedsDraw(g_active_menu)) {
-        NGMenuDraw(g_active_menu);
-    }
+    // A fix flush that missed the VBlank deadline keeps its rows dirty and
+    // goes out with the next one; unschedule it while the game prints
+    NGVBlankJobCancel(fix_job);
+    NGAudioUpdate();
 
     NGArenaReset(&ng_arena_frame);
+    if (g_deferred_draw) {
+        NGDisplayListBegin(&ng_arena_frame, NG_DISPLAY_LIST_WORDS);
+    }
+    NG_PROFILE_BEGIN(NG_PROF_INPUT);
     NGInputUpdate();
+    NG_PROFILE_END(NG_PROF_INPUT);
 }
 
 void NGEngineFrameEnd(void) {
-    NGLightingUpdate();
+    NGSpringSystemUpdate();
     NGSceneUpdate();
-    NGSceneDraw();
+    // Menu and widget text goes into the fix shadow, which the VBlank
+    // interrupt uploads. Only cells that changed since the last flush are
+    // written, including text the game printed this frame. Widget sprites
+    // move with the scene draw below.
+    if (g_active_menu && NGMenuNeedsDraw(g_active_menu)) {
+        NGMenuDraw(g_active_menu);
+    }
+    NGWidgetsDraw();
+    // The flush sets VRAMADDR, so it must not be pending while an
+    // immediate-mode draw writes VRAM from the main loop and may run into
+    // VBlank; a flush left over from a missed deadline is held back too.
+    NGVBlankJobCancel(fix_job);
+    if (!g_skip_draw)
+        NGSceneDraw();
+    // Lighting runs after the scene sync so it sees which palettes are on
+    // screen this frame; palette uploads still land at the next VBlank.
+    NG_PROFILE_BEGIN(NG_PROF_LIGHTING);
+    NGLightingUpdate();
+    NG_PROFILE_END(NG_PROF_LIGHTING);
+    NGDisplayListSubmit();
+    if (NGFixIsDirty())
+        NGVBlankJobSchedule(fix_job);
+    frame_timing();
+    NG_PROFILE_FRAME_END();
 }
 
 void NGEngineSetActiveMenu(NGMenuHandle menu) {
@@ -63,3 +220,38 @@ void NGEngineSetActiveMenu(NGMenuHandle menu) {
 NGMenuHandle NGEngineGetActiveMenu(void) {
     return g_active_menu;
 }
+
+void NGEngineSetDeferredDraw(u8 enabled) {
+    g_deferred_draw = enabled ? 1 : 0;
+}
+
+u8 NGEngineGetDeferredDraw(void) {
+    return g_deferred_draw;
+}
+
+void NGEngineSetFrameSkip(u8 max_skips) {
+    g_frame_skip = max_skips;
+    if (!max_skips)
+        g_skip_draw = 0;
+}
+
+u8 NGEngineGetFrameSkip(void) {
+    return g_frame_skip;
+}
+
+u8 NGEngineFrameVBlanks(void) {
+    return g_frame_vblanks;
+}
+
+u8 NGEngineIsSkippingDraw(void) {
+    return g_skip_draw;
+}
+
+void NGEngineGetFrameStats(NGEngineFrameStats *out) {
+    *out = g_frame_stats;
+}
+
+void NGEngineResetFrameStats(void) {
+    static const NGEngineFrameStats zero = {0};
+    g_frame_stats = zero;
+}
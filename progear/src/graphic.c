@@ -13,8 +13,10 @@
  * encapsulated here.
  *
  * Key implementation details:
- * - Graphics are stored in a static array and sorted for rendering
- * - Sprite indices are allocated sequentially during draw
+ * - Graphics are stored in a static array; render order is kept sorted
+ *   incrementally, one bucket per layer
+ * - Sprite ranges persist across frames and only move when ordering or
+ *   pool space requires it
  * - Layer determines chained vs independent column mode
  * - Dirty tracking minimizes VRAM writes
  */
@@ -24,6 +26,16 @@
 #include <ng_sprite.h>
 #include <ng_palette.h>
 #include <ng_hardware.h>
+#include <ng_bank.h>
+#include <ng_display_list.h>
+#include <ng_string.h>
+#include <ng_tables.h>
+
+#if NG_VRAM_STATS
+#include <ng_fix.h>
+#endif
+
+#include "sdk_internal.h"
 
 /* ============================================================
  * Constants
@@ -47,6 +59,12 @@
 #define DIRTY_SHRINK 0x08
 #define DIRTY_ALL    0xFF
 
+/* Staged graphic states (see NGSceneStageBegin) */
+#define STAGE_WAITING 1 /* Tiles not uploaded to its current range yet */
+#define STAGE_LOADED  2
+
+#define LAYER_COUNT (NG_GRAPHIC_LAYER_UI + 1)
+
 /* ============================================================
  * Internal Structure
  * ============================================================ */
@@ -75,15 +93,37 @@ struct NGGraphic {
     const u8 *tilemap8; /* Row-major tilemap (u8 indices), or NULL */
     const u8 *tile_to_palette;
     u8 palette;
+    u8 auto_anim_attr; /* NG_SPRITE_ATTR_AUTOANIM4/8 on every tile, or 0 */
     u16 anim_frame;
     u16 tiles_per_frame;
     s16 src_offset_x; /* Viewport offset into source */
     s16 src_offset_y;
 
+    u8 source_bank; /* P-ROM bank holding the source arrays, NG_BANK_FIXED if none */
+
+    /* Chunked tilemap8 source (streamed terrain), used instead of tilemap8 */
+    NGTileFetch tile_fetch;
+    void *tile_fetch_ctx;
+
+    /* Edited tiles over a flat tilemap8, looked up only in columns whose
+     * bit is set in overlay_cols */
+    NGTileOverlay tile_overlay;
+    void *tile_overlay_ctx;
+    const u8 *overlay_cols;
+
+    /* Asset tilemap holding every frame, or NULL; tilemap points at the current frame */
+    const u16 *tilemap_frames;
+    const u16 *frame_deltas; /* Entries each frame changes (NGVisualAsset), or NULL */
+
+    /* Metasprite asset parts, or NULL; tilemap then holds the parts' tile
+     * runs and num_cols is the current frame's part count */
+    const NGMetaPart *meta_parts;
+    const u16 *meta_frame_parts;
+
     /* Precomputed values for fast tile lookup (avoids division in inner loop) */
-    u8 src_tiles_w;     /* Source width in tiles */
-    u8 src_tiles_h;     /* Source height in tiles */
-    u16 effective_base; /* base_tile + (anim_frame * tiles_per_frame) */
+    u16 src_tiles_w;    /* Source width in tiles */
+    u16 src_tiles_h;    /* Source height in tiles */
+    u16 effective_base; /* base_tile + (anim_frame * tiles_per_frame), or base_tile */
 
     /* Tile mode and 9-slice */
     NGGraphicTileMode tile_mode;
@@ -98,6 +138,7 @@ struct NGGraphic {
     u16 hw_sprite_first;
     u8 hw_sprite_count;
     u8 hw_allocated;
+    u8 meta_span; /* Sprites held for a metasprite's largest frame so far */
 
     /* Infinite scroll state (circular buffer) */
     u8 scroll_leftmost;   /* Index of leftmost column (0 to num_cols-1) */
@@ -107,6 +148,16 @@ struct NGGraphic {
     s16 scroll_last_px;   /* Last scroll position for delta calc (X tile column) */
     s16 scroll_last_row;  /* Last Y tile row for delta calc */
     u16 scroll_last_scb3; /* Cached SCB3 value for Y optimization */
+    s16 scroll_base_col;  /* Source column held by the first sprite column */
+    /* Columns with SCB1 written since the last full load */
+    u8 scroll_loaded_cols;
+    /* Tilemap sprite columns waiting for tiles, bit = sprite offset */
+    u32 scroll_stale;
+
+    /* Sticky-chain scroll (infinite mode, one SCB4 write moves the layer) */
+    u8 scroll_chain;   /* Columns chained to the first sprite */
+    s16 chain_base_px; /* Source X of the first column when tiles were loaded */
+    s16 chain_last_x;  /* Last SCB4 X written to the first sprite */
 
     /* Computed values (derived from display size and scale) */
     u8 num_cols; /* Sprite columns needed */
@@ -116,6 +167,26 @@ struct NGGraphic {
     u8 dirty;
     u8 active; /* Slot in use? */
 
+    /* Sprite budget */
+    u8 priority; /* Cull order when a pool is full (lowest first) */
+    u8 culled;   /* Dropped for lack of sprites this frame */
+
+    /* STAGE_* while it belongs to the next scene, 0 once live. Staged
+     * graphics write SCB3 with height 0, so they stay hidden. */
+    u8 staged;
+
+#if NG_VRAM_STATS
+    NGGraphicTraffic traffic;
+#endif
+
+    /* SCB2 words staged by the last flush (see write_shrinks) */
+    u8 shrink_cols;
+    u16 shrink_val;
+
+    /* Palette usage */
+    const u8 *palette_mask; /* Palettes reachable through tile_to_palette, or NULL */
+    u8 palette_counted;     /* Included in palette_refs */
+
     /* Cache for change detection */
     struct {
         u16 last_base_tile;
@@ -138,13 +209,40 @@ struct NGGraphic {
  * Static State
  * ============================================================ */
 
-static NGGraphic graphics[NG_GRAPHIC_MAX];
+/* Graphic table from ng_arena_persistent, sized at engine init */
+static NGGraphic *graphics;
+static u8 graphic_capacity;
 static u8 graphics_initialized;
 
-/* Sorted list of active graphic indices for rendering */
-static u8 render_order[NG_GRAPHIC_MAX];
+/* Inactive slots, popped by create and pushed back by destroy */
+static u8 *free_slots;
+static u8 free_count;
+
+/* Active graphic indices sorted by layer, then z_order. Each layer is a
+ * contiguous bucket ending at layer_end[layer]; render_count is the end of
+ * the last one. Kept sorted on every change, so drawing never re-sorts. */
+static u8 *render_order;
 static u8 render_count;
-static u8 render_order_dirty;
+static u8 layer_end[LAYER_COUNT];
+
+/* First hardware sprite planned for each graphic this frame (0 = none) */
+static u16 *plan_first;
+
+static NGGraphicBudget budget;
+static u8 line_check;
+
+/* New graphics belong to the next scene; staged_count of them exist */
+static u8 staging;
+static u8 staged_count;
+
+/* Tilemap scroll work per graphic per frame, 0 = unlimited */
+static u8 scroll_budget_cols = NG_GRAPHIC_SCROLL_COLS;
+static u8 scroll_budget_rows = NG_GRAPHIC_SCROLL_ROWS;
+
+/* Visible graphics using each palette. A graphic with per-tile palettes
+ * and no usage mask may use any of them and is counted in palette_refs_any. */
+static u8 palette_refs[NG_PAL_COUNT];
+static u8 palette_refs_any;
 
 /* ============================================================
  * Internal Helpers
@@ -154,21 +252,17 @@ static u8 pixels_to_tiles(u16 pixels) {
     return (u8)((pixels + TILE_SIZE - 1) >> TILE_SHIFT);
 }
 
-static u16 tiles_to_pixels(u8 tiles) {
+static u16 tiles_to_pixels(u16 tiles) {
     return (u16)(tiles * TILE_SIZE);
 }
 
 /**
  * Calculate hardware shrink value from scale.
  * NeoGeo shrink: 255 = full size, 0 = invisible
- * Our scale: 256 = 1.0x, so shrink = scale - 1 (clamped)
+ * Our scale: 256 = 1.0x, so shrink = scale - 1 (clamped, see ng_tables.h)
  */
 static u8 scale_to_shrink(u16 scale) {
-    if (scale >= 256)
-        return 255;
-    if (scale == 0)
-        return 0;
-    return (u8)(scale - 1);
+    return ng_shrink_table[scale > 256 ? 256 : scale];
 }
 
 /**
@@ -178,50 +272,557 @@ static u8 scale_to_shrink(u16 scale) {
  * for smooth scaling (see Scaling_sprite_groups on NeoGeo dev wiki).
  */
 static u16 scale_to_shrink_val(u16 scale) {
-    u8 shrink = scale_to_shrink(scale);
-    return (u16)(((u16)shrink << 8) | shrink);
+    return ng_shrink_val_table[scale > 256 ? 256 : scale];
+}
+
+/* SCB3 height for rows at a shrink, 0 to keep a staged graphic hidden */
+static u8 shown_height(const NGGraphic *g, u8 rows, u8 shrink) {
+    return g->staged ? 0 : NGSpriteAdjustedHeight(rows, shrink);
+}
+
+static u8 layer_start(u8 layer) {
+    return layer ? layer_end[layer - 1] : 0;
 }
 
 /**
- * Compare function for sorting graphics by layer and z_order.
- * Returns <0 if a should render before b.
+ * First position in [lo, hi) whose graphic has z_order > z.
+ * The range must lie within one layer bucket.
  */
-static s8 compare_graphics(NGGraphic *a, NGGraphic *b) {
-    if (a->layer != b->layer) {
-        return (s8)(a->layer - b->layer);
+static u8 order_upper_bound(u8 lo, u8 hi, u8 z) {
+    while (lo < hi) {
+        u8 mid = (u8)((lo + hi) >> 1);
+        if (graphics[render_order[mid]].z_order > z)
+            hi = mid;
+        else
+            lo = (u8)(mid + 1);
     }
-    return (s8)(a->z_order - b->z_order);
+    return lo;
+}
+
+/** Position of g in render_order. Uses g's current layer and z_order. */
+static u8 order_find(const NGGraphic *g) {
+    u8 idx = (u8)(g - graphics);
+    u8 lo = layer_start(g->layer);
+    u8 hi = layer_end[g->layer];
+
+    /* Lower bound on z, then step over graphics sharing the same z */
+    while (lo < hi) {
+        u8 mid = (u8)((lo + hi) >> 1);
+        if (graphics[render_order[mid]].z_order < g->z_order)
+            lo = (u8)(mid + 1);
+        else
+            hi = mid;
+    }
+    while (render_order[lo] != idx)
+        lo++;
+    return lo;
 }
 
 /**
- * Insertion sort render_order by layer and z.
+ * Move the entry at position from so it lands just before the entry
+ * currently at position to. Only the entries in between shift.
  */
-static void sort_render_order(void) {
-    for (u8 i = 1; i < render_count; i++) {
-        u8 key = render_order[i];
-        NGGraphic *key_g = &graphics[key];
-
-        s8 j = (s8)(i - 1);
-        while (j >= 0 && compare_graphics(&graphics[render_order[j]], key_g) > 0) {
-            render_order[j + 1] = render_order[j];
-            j--;
+static void order_move(u8 from, u8 to) {
+    u8 idx = render_order[from];
+    if (to > from) {
+        to--;
+        memmove(&render_order[from], &render_order[from + 1], (u32)(to - from));
+    } else {
+        memmove(&render_order[to + 1], &render_order[to], (u32)(from - to));
+    }
+    render_order[to] = idx;
+}
+
+/** Add a newly activated graphic to its layer bucket (after equal z). */
+static void order_insert(NGGraphic *g) {
+    u8 layer = g->layer;
+    u8 pos = render_count++;
+    render_order[pos] = (u8)(g - graphics);
+    order_move(pos, order_upper_bound(layer_start(layer), layer_end[layer], g->z_order));
+    for (u8 l = layer; l < LAYER_COUNT; l++)
+        layer_end[l]++;
+}
+
+static void order_remove(NGGraphic *g) {
+    order_move(order_find(g), render_count);
+    render_count--;
+    for (u8 l = g->layer; l < LAYER_COUNT; l++)
+        layer_end[l]--;
+}
+
+/** Reposition g after its z_order changed from old_z. */
+static void order_update_z(NGGraphic *g, u8 old_z) {
+    u8 new_z = g->z_order;
+    g->z_order = old_z;
+    u8 pos = order_find(g);
+    g->z_order = new_z;
+
+    /* The rest of the bucket is still sorted; search only the side g moves to */
+    u8 layer = g->layer;
+    u8 to = (new_z > old_z) ? order_upper_bound((u8)(pos + 1), layer_end[layer], new_z)
+                            : order_upper_bound(layer_start(layer), pos, new_z);
+    order_move(pos, to);
+}
+
+/** Move g into the bucket for new_layer (g->layer is still the old layer). */
+static void order_update_layer(NGGraphic *g, NGGraphicLayer new_layer) {
+    u8 old_layer = g->layer;
+    u8 pos = order_find(g);
+    u8 to = order_upper_bound(layer_start(new_layer), layer_end[new_layer], g->z_order);
+    order_move(pos, to);
+
+    /* Buckets between the two layers shift by one entry */
+    if (new_layer > old_layer) {
+        for (u8 l = old_layer; l < new_layer; l++)
+            layer_end[l]--;
+    } else {
+        for (u8 l = new_layer; l < old_layer; l++)
+            layer_end[l]++;
+    }
+    g->layer = new_layer;
+}
+
+static void order_reset(void) {
+    render_count = 0;
+    for (u8 l = 0; l < LAYER_COUNT; l++)
+        layer_end[l] = 0;
+}
+
+/* ============================================================
+ * Hardware Sprite Allocation
+ * ============================================================
+ *
+ * Each graphic owns a contiguous sprite range (chained columns must be
+ * adjacent). Sprite index is draw priority, so ranges must increase along
+ * render_order. A graphic keeps its range while that still holds; only
+ * graphics that no longer fit in order are moved, at the lowest free index
+ * after the previous one. If a pool runs out because of gaps, the pool is
+ * compacted. Sprites not owned by any graphic are always hidden, so no
+ * per-frame sweep of the unused area is needed. */
+
+static void hide_sprites(u16 first, u16 count) {
+    while (count > 0) {
+        u8 batch = (count > 255) ? 255 : (u8)count;
+        NGSpriteHideRange(first, batch);
+        first += batch;
+        count -= batch;
+    }
+}
+
+/** Hide g's sprites and give its range back. */
+static void release_sprites(NGGraphic *g) {
+    if (g->hw_allocated && g->hw_sprite_count > 0) {
+        NGSpriteHideRange(g->hw_sprite_first, g->hw_sprite_count);
+    }
+    g->hw_allocated = 0;
+}
+
+/** Hide the part of g's current range that [first, first+count) doesn't cover. */
+static void hide_vacated(const NGGraphic *g, u16 first, u8 count) {
+    u16 old_first = g->hw_sprite_first;
+    u16 old_end = (u16)(old_first + g->hw_sprite_count);
+    u16 new_end = (u16)(first + count);
+
+    if (old_first < first)
+        hide_sprites(old_first, (u16)((old_end < first ? old_end : first) - old_first));
+    if (old_end > new_end)
+        hide_sprites(old_first > new_end ? old_first : new_end,
+                     (u16)(old_end - (old_first > new_end ? old_first : new_end)));
+}
+
+/**
+ * Plan ranges for the live (or, with staged, the staged) graphics of
+ * render_order[from, to) within sprites [pool_first, pool_end).
+ * Without compact, allocated graphics keep their range when it still fits in
+ * order, and metasprites keep room for their largest frame so far so the
+ * graphics after them stay put. Graphics that don't fit get no range.
+ * @param end Output: first sprite after the planned ranges
+ * @return 0 if any visible graphic didn't fit
+ */
+static u8 plan_pool(u8 from, u8 to, u16 pool_first, u16 pool_end, u8 compact, u8 staged,
+                    u16 *end) {
+    u16 cursor = pool_first;
+    u8 fits = 1;
+
+    for (u8 i = from; i < to; i++) {
+        u8 idx = render_order[i];
+        NGGraphic *g = &graphics[idx];
+        if ((g->staged != 0) != staged)
+            continue;
+        plan_first[idx] = 0;
+
+        if (!compact)
+            g->culled = 0;
+        if (!g->visible || g->culled)
+            continue;
+
+        u8 needed = g->num_cols;
+        if (g->meta_parts) {
+            if (!compact && g->hw_allocated && g->meta_span > needed)
+                needed = g->meta_span;
+            g->meta_span = needed;
         }
-        render_order[j + 1] = key;
+        u16 first = cursor;
+        if (!compact && g->hw_allocated && g->hw_sprite_first >= cursor &&
+            g->hw_sprite_first + needed <= pool_end) {
+            first = g->hw_sprite_first;
+        }
+        if (first + needed > pool_end) {
+            fits = 0;
+            continue;
+        }
+
+        plan_first[idx] = first;
+        cursor = (u16)(first + needed);
     }
+    *end = cursor;
+    return fits;
 }
 
 /**
- * Rebuild render order from active graphics.
+ * Cull live graphics in render_order[from, to) until the rest fit in
+ * capacity sprites: lowest priority first, and of equals the one rendering
+ * last.
  */
-static void rebuild_render_order(void) {
-    render_count = 0;
-    for (u8 i = 0; i < NG_GRAPHIC_MAX; i++) {
-        if (graphics[i].active) {
-            render_order[render_count++] = i;
+static void cull_pool(u8 from, u8 to, u16 capacity) {
+    u16 total = 0;
+    for (u8 i = from; i < to; i++) {
+        NGGraphic *g = &graphics[render_order[i]];
+        if (g->visible && !g->staged)
+            total += g->num_cols;
+    }
+
+    while (total > capacity) {
+        NGGraphic *victim = NULL;
+        for (u8 i = from; i < to; i++) {
+            NGGraphic *g = &graphics[render_order[i]];
+            if (g->visible && !g->staged && !g->culled &&
+                (!victim || g->priority <= victim->priority))
+                victim = g;
         }
+        victim->culled = 1;
+        total -= victim->num_cols;
+        budget.culled_graphics++;
+        budget.culled_sprites += victim->num_cols;
+    }
+}
+
+/**
+ * Plan one pool, compacting and culling only if ranges don't fit as-is.
+ * Staged graphics share what the live ones leave at the end of the pool;
+ * those that don't fit wait without culling anything.
+ */
+static void allocate_pool(u8 from, u8 to, u16 pool_first, u16 pool_end) {
+    u16 live_end;
+    if (!plan_pool(from, to, pool_first, pool_end, 0, 0, &live_end)) {
+        cull_pool(from, to, (u16)(pool_end - pool_first));
+        plan_pool(from, to, pool_first, pool_end, 1, 0, &live_end);
+    }
+    if (staged_count) {
+        u16 staged_end;
+        plan_pool(from, to, live_end, pool_end, 0, 1, &staged_end);
     }
-    sort_render_order();
-    render_order_dirty = 0;
+}
+
+/** Estimate sprites per scanline from each drawn graphic's vertical extent. */
+static void check_lines(void) {
+    s16 delta[NG_GRAPHIC_SCREEN_LINES + 1];
+    for (u16 y = 0; y <= NG_GRAPHIC_SCREEN_LINES; y++)
+        delta[y] = 0;
+
+    for (u8 i = 0; i < render_count; i++) {
+        NGGraphic *g = &graphics[render_order[i]];
+        if (!g->hw_allocated)
+            continue;
+
+        u16 scale = (g->scale > NG_GRAPHIC_SCALE_ONE) ? NG_GRAPHIC_SCALE_ONE : g->scale;
+        s16 top = g->screen_y;
+        s16 bottom = (s16)(top + (s16)(((u32)tiles_to_pixels(g->num_rows) * scale) >> 8));
+        if (top < 0)
+            top = 0;
+        if (bottom > NG_GRAPHIC_SCREEN_LINES)
+            bottom = NG_GRAPHIC_SCREEN_LINES;
+        if (top >= bottom)
+            continue;
+
+        delta[top] += g->hw_sprite_count;
+        delta[bottom] -= g->hw_sprite_count;
+    }
+
+    s16 count = 0;
+    for (u16 y = 0; y < NG_GRAPHIC_SCREEN_LINES; y++) {
+        count += delta[y];
+        if (count > budget.line_peak) {
+            budget.line_peak = (u8)(count > 255 ? 255 : count);
+            budget.line_peak_y = (u8)y;
+        }
+        if (count > NG_GRAPHIC_LINE_LIMIT)
+            budget.lines_over++;
+    }
+}
+
+static void hide_all_sprites(void) {
+    hide_sprites(0, HW_SPRITE_MAX);
+}
+
+/* ============================================================
+ * Palette Usage
+ * ============================================================ */
+
+static void palette_refs_apply(const NGGraphic *g, s8 delta) {
+    if (!g->tile_to_palette) {
+        palette_refs[g->palette] = (u8)(palette_refs[g->palette] + delta);
+        return;
+    }
+    if (!g->palette_mask) {
+        palette_refs_any = (u8)(palette_refs_any + delta);
+        return;
+    }
+    for (u8 b = 0; b < NG_PAL_COUNT / 8; b++) {
+        u8 bits = g->palette_mask[b];
+        for (u8 pal = (u8)(b * 8); bits; bits >>= 1, pal++) {
+            if (bits & 1)
+                palette_refs[pal] = (u8)(palette_refs[pal] + delta);
+        }
+    }
+}
+
+/* Count a graphic's palettes while it is active and visible */
+static void palette_refs_acquire(NGGraphic *g) {
+    if (g->palette_counted || !g->active || !g->visible)
+        return;
+    palette_refs_apply(g, 1);
+    g->palette_counted = 1;
+}
+
+static void palette_refs_release(NGGraphic *g) {
+    if (!g->palette_counted)
+        return;
+    palette_refs_apply(g, -1);
+    g->palette_counted = 0;
+}
+
+static void palette_refs_reset(void) {
+    memset(palette_refs, 0, sizeof(palette_refs));
+    palette_refs_any = 0;
+}
+
+/* Back to a grid of columns after a metasprite source */
+static void clear_meta(NGGraphic *g) {
+    if (!g->meta_parts)
+        return;
+    g->meta_parts = NULL;
+    g->meta_frame_parts = NULL;
+    g->num_cols = pixels_to_tiles(g->display_width);
+    g->num_rows = pixels_to_tiles(g->display_height);
+    if (g->num_rows > MAX_SPRITE_HEIGHT)
+        g->num_rows = MAX_SPRITE_HEIGHT;
+    g->dirty |= DIRTY_SIZE;
+}
+
+void _NGGraphicSetTileFetch(NGGraphic *g, NGTileFetch fetch, void *ctx) {
+    if (!g)
+        return;
+
+    clear_meta(g);
+    g->tilemap8 = NULL;
+    g->tile_fetch = fetch;
+    g->tile_fetch_ctx = ctx;
+    g->dirty |= DIRTY_SOURCE;
+}
+
+void _NGGraphicSetSourceBank(NGGraphic *g, u8 bank) {
+    if (g)
+        g->source_bank = bank;
+}
+
+void _NGGraphicSetPaletteMask(NGGraphic *g, const u8 *palette_mask) {
+    if (!g)
+        return;
+    palette_refs_release(g);
+    g->palette_mask = palette_mask;
+    palette_refs_acquire(g);
+}
+
+u8 _NGGraphicPaletteInUse(u8 palette) {
+    return palette_refs[palette] || palette_refs_any;
+}
+
+/* ============================================================
+ * Reserved Sprites
+ * ============================================================ */
+
+/* Sprites just below the UI pool that entities never get */
+static u16 reserved_sprites;
+
+/* Each block goes below the ones reserved before it */
+u16 _NGGraphicReserveSprites(u16 count) {
+    if (!count || reserved_sprites + count >= UI_SPRITE_FIRST - HW_SPRITE_FIRST)
+        return 0;
+    reserved_sprites = (u16)(reserved_sprites + count);
+    return (u16)(UI_SPRITE_FIRST - reserved_sprites);
+}
+
+/* ============================================================
+ * VRAM Traffic (NG_VRAM_STATS builds)
+ *
+ * Each graphic is charged what the HAL counters advanced by while the
+ * draw worked on it: hiding the sprites it left, its flush, and its SCB2
+ * run. Full redraws are counted by what forced them.
+ * ============================================================ */
+
+#if NG_VRAM_STATS
+#define TRAFFIC_MARK(mark) NGVramTraffic mark = ng_vram_traffic
+
+static void traffic_charge(NGGraphic *g, const NGVramTraffic *mark) {
+    NGGraphicTraffic *t = &g->traffic;
+    for (u8 a = NG_VRAM_AREA_SCB1; a <= NG_VRAM_AREA_SCB4; a++) {
+        u16 words = (u16)(ng_vram_traffic.words[a] - mark->words[a]);
+        t->words[a] = (u16)(t->words[a] + words);
+        t->total_words += words;
+    }
+    t->setups = (u16)(t->setups + (u16)(ng_vram_traffic.setups - mark->setups));
+}
+
+#define TRAFFIC_CHARGE(g, mark) traffic_charge((g), &(mark))
+
+/* Count the full redraw of a graphic about to move to sprite first */
+static void traffic_redraw(NGGraphic *g, u16 first) {
+    if (!g->hw_allocated)
+        g->traffic.first_draws++;
+    else if (g->hw_sprite_first != first)
+        g->traffic.sprite_moves++;
+    else
+        g->traffic.count_changes++;
+}
+
+static void traffic_new_frame(void) {
+    for (u8 i = 0; i < render_count; i++) {
+        NGGraphicTraffic *t = &graphics[render_order[i]].traffic;
+        memset(t->words, 0, sizeof(t->words));
+        t->setups = 0;
+    }
+}
+
+static void traffic_add(NGGraphicTraffic *sum, const NGGraphicTraffic *t) {
+    for (u8 a = 0; a < 4; a++)
+        sum->words[a] = (u16)(sum->words[a] + t->words[a]);
+    sum->setups = (u16)(sum->setups + t->setups);
+    sum->total_words += t->total_words;
+    sum->first_draws = (u16)(sum->first_draws + t->first_draws);
+    sum->sprite_moves = (u16)(sum->sprite_moves + t->sprite_moves);
+    sum->count_changes = (u16)(sum->count_changes + t->count_changes);
+}
+
+void NGGraphicGetTraffic(const NGGraphic *g, NGGraphicTraffic *out) {
+    if (!out)
+        return;
+    if (g)
+        *out = g->traffic;
+    else
+        memset(out, 0, sizeof(*out));
+}
+
+void NGGraphicGetLayerTraffic(NGGraphicLayer layer, NGGraphicTraffic *out) {
+    if (!out)
+        return;
+    memset(out, 0, sizeof(*out));
+    for (u8 i = 0; i < render_count; i++) {
+        const NGGraphic *g = &graphics[render_order[i]];
+        if (g->layer == layer)
+            traffic_add(out, &g->traffic);
+    }
+}
+
+void NGGraphicResetTraffic(void) {
+    for (u8 i = 0; i < render_count; i++) {
+        NGGraphicTraffic *t = &graphics[render_order[i]].traffic;
+        t->total_words = 0;
+        t->first_draws = 0;
+        t->sprite_moves = 0;
+        t->count_changes = 0;
+    }
+}
+
+u8 NGGraphicGetHottest(NGGraphic **out, u8 count) {
+    u8 found = 0;
+    for (u8 i = 0; i < render_count; i++) {
+        NGGraphic *g = &graphics[render_order[i]];
+        if (!g->traffic.total_words)
+            continue;
+        /* Insertion into the sorted list, dropping what falls off the end */
+        u8 at = found < count ? found++ : count;
+        while (at > 0 && out[at - 1]->traffic.total_words < g->traffic.total_words) {
+            if (at < count)
+                out[at] = out[at - 1];
+            at--;
+        }
+        if (at < count)
+            out[at] = g;
+    }
+    return found;
+}
+
+void NGGraphicDrawTraffic(u8 x, u8 y, u8 palette, u8 rows) {
+    NGGraphic *hot[16];
+    if (rows > 16)
+        rows = 16;
+    u8 count = NGGraphicGetHottest(hot, rows);
+
+    NGTextPrint(NGFixLayoutXY(x, y), palette, "GFX L SCB1 SCB2 SCB3 SCB4 TOTAL REDRAW");
+    for (u8 i = 0; i < rows; i++) {
+        y++;
+        if (i >= count) {
+            NGTextPrint(NGFixLayoutXY(x, y), palette, "                                      ");
+            continue;
+        }
+        const NGGraphicTraffic *t = &hot[i]->traffic;
+        NGTextPrintf(NGFixLayoutXY(x, y), palette, "%3u %u%5u%5u%5u%5u%6u%7u",
+                     (u32)(hot[i] - graphics), (u32)hot[i]->layer, (u32)t->words[0],
+                     (u32)t->words[1], (u32)t->words[2], (u32)t->words[3],
+                     t->total_words > 99999 ? 99999u : t->total_words,
+                     (u32)(t->first_draws + t->sprite_moves + t->count_changes));
+    }
+}
+#else
+#define TRAFFIC_MARK(mark)      ((void)0)
+#define TRAFFIC_CHARGE(g, mark) ((void)0)
+#endif
+
+/* ============================================================
+ * Scene Staging
+ * ============================================================ */
+
+void _NGGraphicStageBegin(void) {
+    staging = 1;
+}
+
+u8 _NGGraphicIsStaged(const NGGraphic *g) {
+    return g && g->staged;
+}
+
+u8 _NGGraphicStagePending(void) {
+    u8 pending = 0;
+    for (u8 i = 0; i < render_count; i++) {
+        const NGGraphic *g = &graphics[render_order[i]];
+        if (g->staged == STAGE_WAITING && g->visible)
+            pending++;
+    }
+    return pending;
+}
+
+void _NGGraphicStageCommit(void) {
+    for (u8 i = 0; i < render_count; i++) {
+        NGGraphic *g = &graphics[render_order[i]];
+        if (!g->staged)
+            continue;
+        /* Only SCB3 is written at the next flush, now with its height */
+        g->staged = 0;
+        g->cache.last_screen_y = 0x7FFF;
+        g->scroll_last_scb3 = 0xFFFF;
+    }
+    staging = 0;
+    staged_count = 0;
 }
 
 /* ============================================================
@@ -233,8 +834,8 @@ static void rebuild_render_order(void) {
  * Uses precomputed src_tiles_w/h and effective_base to avoid division/multiply in inner loop.
  */
 static void get_tile_column_major(NGGraphic *g, u8 col, u8 row, u16 *out_tile, u16 *out_attr) {
-    u8 src_tiles_w = g->src_tiles_w;
-    u8 src_tiles_h = g->src_tiles_h;
+    u8 src_tiles_w = (u8)g->src_tiles_w;
+    u8 src_tiles_h = (u8)g->src_tiles_h;
 
     /* Apply source offset (in tiles) with proper negative handling */
     s16 offset_col = g->src_offset_x >> TILE_SHIFT;
@@ -268,24 +869,29 @@ static void get_tile_column_major(NGGraphic *g, u8 col, u8 row, u16 *out_tile, u
     u8 hw_v_flip = (g->flip & NG_GRAPHIC_FLIP_V) ? 1 : 0;
 
     u8 pal = g->tile_to_palette ? g->tile_to_palette[tile & 0xFFF] : g->palette;
-    u16 attr = (u16)(((u16)pal << 8) | (hw_v_flip << 1) | hw_h_flip);
+    u16 attr = (u16)(((u16)pal << 8) | g->auto_anim_attr | (hw_v_flip << 1) | hw_h_flip);
 
     *out_tile = tile;
     *out_attr = attr;
 }
 
+/* Whether the overlay may hold edits in source column col (inside the map) */
+static inline u8 column_edited(const NGGraphic *g, s16 col) {
+    return g->tile_overlay && (g->overlay_cols[col >> 3] & (1 << (col & 7)));
+}
+
 /**
  * Get tile and attributes for row-major tilemap (terrain, UI).
  * Uses precomputed src_tiles_w/h and effective_base to avoid division/multiply in inner loop.
  */
 static void get_tile_row_major(NGGraphic *g, u8 col, u8 row, u16 *out_tile, u16 *out_attr) {
-    if (!g->tilemap && !g->tilemap8) {
+    if (!g->tilemap && !g->tilemap8 && !g->tile_fetch) {
         get_tile_column_major(g, col, row, out_tile, out_attr);
         return;
     }
 
-    u8 src_tiles_w = g->src_tiles_w;
-    u8 src_tiles_h = g->src_tiles_h;
+    u16 src_tiles_w = g->src_tiles_w;
+    u16 src_tiles_h = g->src_tiles_h;
 
     /* Apply source offset (in tiles) with proper negative handling */
     s16 offset_col = g->src_offset_x >> TILE_SHIFT;
@@ -307,20 +913,24 @@ static void get_tile_row_major(NGGraphic *g, u8 col, u8 row, u16 *out_tile, u16
         temp_col = temp_col % (s16)src_tiles_w;
         temp_row = temp_row % (s16)src_tiles_h;
         if (temp_col < 0)
-            temp_col += src_tiles_w;
+            temp_col = (s16)(temp_col + src_tiles_w);
         if (temp_row < 0)
-            temp_row += src_tiles_h;
+            temp_row = (s16)(temp_row + src_tiles_h);
     }
 
     /* Row-major: index = row * width + col */
-    u16 idx = (u16)((u16)temp_row * src_tiles_w + (u16)temp_col);
+    u32 idx = (u32)temp_row * src_tiles_w + (u16)temp_col;
 
     u16 tile;
     u8 pal;
 
-    if (g->tilemap8) {
+    if (g->tilemap8 || g->tile_fetch) {
         /* 8-bit tilemap (terrain): simple index lookup, no flip flags */
-        u8 tile_idx = g->tilemap8[idx];
+        u8 tile_idx = g->tile_fetch
+                          ? *g->tile_fetch(g->tile_fetch_ctx, (u16)temp_col, (u16)temp_row)
+                          : g->tilemap8[idx];
+        if (column_edited(g, temp_col))
+            tile_idx = g->tile_overlay(g->tile_overlay_ctx, (u16)temp_col, (u16)temp_row, tile_idx);
         tile = g->effective_base + tile_idx;
         pal = g->tile_to_palette ? g->tile_to_palette[tile_idx] : g->palette;
 
@@ -339,7 +949,7 @@ static void get_tile_row_major(NGGraphic *g, u8 col, u8 row, u16 *out_tile, u16
 
     /* Build attributes from tilemap flip flags */
     pal = g->tile_to_palette ? g->tile_to_palette[tile_offset] : g->palette;
-    u16 attr = (u16)((u16)pal << 8);
+    u16 attr = (u16)(((u16)pal << 8) | g->auto_anim_attr);
 
     /* Apply tilemap flip flags */
     if (entry & 0x8000)
@@ -351,20 +961,47 @@ static void get_tile_row_major(NGGraphic *g, u8 col, u8 row, u16 *out_tile, u16
     *out_attr = attr;
 }
 
+/* SCB1 writers below go straight to VRAM, or into the display list while
+ * one is recording. `deferred` is sampled once per function. */
+#define GFX_SETUP(deferred, addr)             \
+    do {                                      \
+        if (deferred)                         \
+            NGDisplayListRun((u16)(addr), 1); \
+        else                                  \
+            NG_VRAM_SETUP_FAST(addr, 1);      \
+    } while (0)
+
+#define GFX_WRITE(deferred, data)          \
+    do {                                   \
+        if (deferred)                      \
+            NGDisplayListPut((u16)(data)); \
+        else                               \
+            NG_VRAM_WRITE_FAST(data);      \
+    } while (0)
+
+#define GFX_CLEAR(deferred, count)                  \
+    do {                                            \
+        if (deferred)                               \
+            NGDisplayListFillNext(0, (u16)(count)); \
+        else                                        \
+            NG_VRAM_CLEAR_FAST(count);              \
+    } while (0)
+
 /**
  * Fast path for simple animated sprites with 16-bit tilemaps.
  * Conditions: has tilemap, no source offset, no flip, no tile_to_palette.
  * This covers the common case of animated sprites like the ball.
  */
-static void flush_tiles_tilemap_fast(NGGraphic *g) {
+static void flush_tiles_tilemap_fast(NGGraphic *g, u16 *keep) {
+    u8 deferred = NGDisplayListIsRecording();
     NG_VRAM_DECLARE_BASE();
 
     u16 first_sprite = g->hw_sprite_first;
-    u8 src_tiles_w = g->src_tiles_w;
-    u8 src_tiles_h = g->src_tiles_h;
+    u8 src_tiles_w = (u8)g->src_tiles_w;
+    u8 src_tiles_h = (u8)g->src_tiles_h;
     u16 effective_base = g->effective_base;
     const u16 *tilemap = g->tilemap;
-    u16 base_attr = (u16)((u16)g->palette << 8);
+    u16 base_attr = (u16)(((u16)g->palette << 8) | g->auto_anim_attr);
 
     /* Check if wrapping is needed (avoids expensive modulo on 68000) */
     u8 needs_wrap = (g->num_cols > src_tiles_w) || (g->num_rows > src_tiles_h);
@@ -373,7 +1010,7 @@ static void flush_tiles_tilemap_fast(NGGraphic *g) {
         u8 src_col = needs_wrap ? (col % src_tiles_w) : col;
 
         /* Set VRAM address for this sprite column (SCB1 base + sprite * 64) */
-        NG_VRAM_SETUP_FAST(NG_SCB1_BASE + ((first_sprite + col) * 64), 1);
+        GFX_SETUP(deferred, NG_SCB1_BASE + ((first_sprite + col) * 64));
 
         for (u8 row = 0; row < g->num_rows; row++) {
             u8 src_row = needs_wrap ? (row % src_tiles_h) : row;
@@ -393,128 +1030,327 @@ static void flush_tiles_tilemap_fast(NGGraphic *g) {
                 attr |= 0x02; /* v_flip */
 
             /* Write tile and attr (auto-increment handles addressing) */
-            NG_VRAM_WRITE_FAST(tile);
-            NG_VRAM_WRITE_FAST(attr);
+            GFX_WRITE(deferred, tile);
+            GFX_WRITE(deferred, attr);
+            if (keep) {
+                *keep++ = tile;
+                *keep++ = attr;
+            }
         }
 
         /* Pad remaining tiles to 32 */
         if (g->num_rows < 32) {
-            NG_VRAM_CLEAR_FAST((32 - g->num_rows) * 2);
+            GFX_CLEAR(deferred, (32 - g->num_rows) * 2);
+        }
+    }
+}
+
+/* ============================================================
+ * Shared Tile Words
+ *
+ * Graphics showing the same source the same way write the same SCB1
+ * words, as when a wave of one enemy type spawns on one frame. The first
+ * full write of a frame keeps its words under a signature of everything
+ * the standard path reads, and the others replay them column by column.
+ * 8-bit tilemaps and fetched tiles read terrain data and edits, so they
+ * are never shared. The signatures are dropped every frame.
+ * ============================================================ */
+
+#define TILE_SHARE_MAX   4  /* Signatures kept per frame */
+#define TILE_SHARE_TILES 64 /* Tiles a shared graphic may have */
+
+typedef struct {
+    const u16 *tilemap; /* NULL for column-major tiles */
+    const u8 *tile_to_palette;
+    u16 base; /* effective_base: base tile plus frame */
+    u16 attr; /* Palette and auto-animation bits */
+    u16 src_w, src_h;
+    s16 offset_x, offset_y; /* Source offset in tiles */
+    u8 cols, rows;
+    u8 flip;
+    u8 tile_mode;
+} TileShare;
+
+static TileShare tile_shares[TILE_SHARE_MAX];
+static u16 tile_share_words[TILE_SHARE_MAX][TILE_SHARE_TILES * 2];
+static u8 tile_share_count;
+
+static void tile_share_make(const NGGraphic *g, TileShare *sig) {
+    sig->tilemap = g->tilemap;
+    sig->tile_to_palette = g->tile_to_palette;
+    sig->base = g->effective_base;
+    sig->attr = (u16)(((u16)g->palette << 8) | g->auto_anim_attr);
+    sig->src_w = g->src_tiles_w;
+    sig->src_h = g->src_tiles_h;
+    sig->offset_x = (s16)(g->src_offset_x >> TILE_SHIFT);
+    sig->offset_y = (s16)(g->src_offset_y >> TILE_SHIFT);
+    sig->cols = g->num_cols;
+    sig->rows = g->num_rows;
+    sig->flip = (u8)g->flip;
+    sig->tile_mode = (u8)g->tile_mode;
+}
+
+static u8 tile_share_equal(const TileShare *a, const TileShare *b) {
+    return a->tilemap == b->tilemap && a->tile_to_palette == b->tile_to_palette &&
+           a->base == b->base && a->attr == b->attr && a->src_w == b->src_w &&
+           a->src_h == b->src_h && a->offset_x == b->offset_x && a->offset_y == b->offset_y &&
+           a->cols == b->cols && a->rows == b->rows && a->flip == b->flip &&
+           a->tile_mode == b->tile_mode;
+}
+
+/* Write kept words to a graphic's columns */
+static void tile_share_replay(const NGGraphic *g, const u16 *words) {
+    u8 deferred = NGDisplayListIsRecording();
+    NG_VRAM_DECLARE_BASE();
+    u16 first_sprite = g->hw_sprite_first;
+    u8 col_words = (u8)(g->num_rows * 2);
+
+    for (u8 col = 0; col < g->num_cols; col++) {
+        GFX_SETUP(deferred, NG_SCB1_BASE + ((first_sprite + col) * 64));
+        if (deferred) {
+            for (u8 i = 0; i < col_words; i++)
+                NGDisplayListPut(*words++);
+        } else {
+            for (u8 i = 0; i < col_words; i++)
+                NG_VRAM_WRITE_FAST(*words++);
+        }
+        if (g->num_rows < 32) {
+            GFX_CLEAR(deferred, 64 - col_words);
         }
     }
 }
 
 /**
  * Write tiles for standard/repeat mode.
- * Uses fast path when possible, falls back to generic path otherwise.
+ * Replays another graphic's words from this frame when they match, else
+ * uses the fast path when possible and the generic path otherwise.
  */
 static void flush_tiles_standard(NGGraphic *g) {
+    u16 *keep = NULL;
+    if (!g->tilemap8 && !g->tile_fetch && (u16)g->num_cols * g->num_rows <= TILE_SHARE_TILES) {
+        TileShare sig;
+        tile_share_make(g, &sig);
+        for (u8 i = 0; i < tile_share_count; i++) {
+            if (tile_share_equal(&tile_shares[i], &sig)) {
+                tile_share_replay(g, tile_share_words[i]);
+                return;
+            }
+        }
+        if (tile_share_count < TILE_SHARE_MAX) {
+            tile_shares[tile_share_count] = sig;
+            keep = tile_share_words[tile_share_count++];
+        }
+    }
+
     /* Fast path: simple animated sprites with 16-bit tilemaps */
     if (g->tilemap && !g->tilemap8 && !g->tile_to_palette && g->src_offset_x == 0 &&
         g->src_offset_y == 0 && g->flip == NG_GRAPHIC_FLIP_NONE) {
-        flush_tiles_tilemap_fast(g);
+        flush_tiles_tilemap_fast(g, keep);
         return;
     }
 
     /* Generic path for complex cases */
+    u8 deferred = NGDisplayListIsRecording();
     NG_VRAM_DECLARE_BASE();
     u16 first_sprite = g->hw_sprite_first;
 
     for (u8 col = 0; col < g->num_cols; col++) {
         /* Set VRAM address for this sprite column */
-        NG_VRAM_SETUP_FAST(NG_SCB1_BASE + ((first_sprite + col) * 64), 1);
+        GFX_SETUP(deferred, NG_SCB1_BASE + ((first_sprite + col) * 64));
 
         for (u8 row = 0; row < g->num_rows; row++) {
             u16 tile, attr;
 
-            if (g->tilemap || g->tilemap8) {
+            if (g->tilemap || g->tilemap8 || g->tile_fetch) {
                 get_tile_row_major(g, col, row, &tile, &attr);
             } else {
                 get_tile_column_major(g, col, row, &tile, &attr);
             }
 
             /* Write tile and attr (auto-increment handles addressing) */
-            NG_VRAM_WRITE_FAST(tile);
-            NG_VRAM_WRITE_FAST(attr);
+            GFX_WRITE(deferred, tile);
+            GFX_WRITE(deferred, attr);
+            if (keep) {
+                *keep++ = tile;
+                *keep++ = attr;
+            }
         }
 
         /* Pad remaining tiles to 32 */
         if (g->num_rows < 32) {
-            NG_VRAM_CLEAR_FAST((32 - g->num_rows) * 2);
+            GFX_CLEAR(deferred, (32 - g->num_rows) * 2);
         }
     }
 }
 
+/* SCB1 words for a 16-bit tilemap entry, as get_tile_row_major() builds them */
+static inline void tilemap_entry_words(const NGGraphic *g, u16 entry, u16 *out_tile,
+                                       u16 *out_attr) {
+    u16 offset = entry & 0x0FFF;
+    u8 pal = g->tile_to_palette ? g->tile_to_palette[offset] : g->palette;
+    u16 attr = (u16)(((u16)pal << 8) | g->auto_anim_attr);
+    if (entry & 0x8000)
+        attr |= 0x01;
+    if (entry & 0x4000)
+        attr |= 0x02;
+    *out_tile = (u16)(g->effective_base + offset);
+    *out_attr = attr;
+}
+
+/* Can a frame change be written as a delta? Sprite slot (col, row) must
+ * hold tilemap entry (col, row): no source offset, repeat or 9-slice. */
+static u8 frame_delta_ok(const NGGraphic *g) {
+    return g->tilemap_frames && g->tile_mode != NG_GRAPHIC_TILE_9SLICE &&
+           g->src_offset_x == 0 && g->src_offset_y == 0 && g->num_cols <= g->src_tiles_w &&
+           g->num_rows <= g->src_tiles_h;
+}
+
 /**
- * Write tiles for 9-slice mode.
- * Optimized to use direct VRAM writes instead of function calls.
+ * Rewrite the SCB1 slots whose tilemap entry differs from old_frame.
+ * Padding rows and unchanged tiles are left alone; contiguous changed
+ * slots share one address setup. The asset's frame_deltas lists the
+ * changes for a step to the next frame; other jumps compare the tilemaps.
  */
-static void flush_tiles_9slice(NGGraphic *g) {
+static void flush_tiles_frame(NGGraphic *g, u16 old_frame) {
+    u8 deferred = NGDisplayListIsRecording();
     NG_VRAM_DECLARE_BASE();
 
-    u16 first_sprite = g->hw_sprite_first;
-    u8 src_tiles_h = g->src_tiles_h;
-
-    /* Convert pixel borders to tile borders */
-    u8 top_rows = pixels_to_tiles(g->slice_top);
-    u8 bottom_rows = pixels_to_tiles(g->slice_bottom);
+    u16 sprite_base = (u16)(NG_SCB1_BASE + g->hw_sprite_first * 64);
+    u16 src_w = g->src_tiles_w;
+    const u16 *tilemap = g->tilemap;
+    u16 next_slot = 0xFFFF; /* Slot the VRAM address points at */
+
+    if (g->frame_deltas && g->anim_frame == old_frame + 1) {
+        const u16 *delta = g->frame_deltas + g->frame_deltas[g->anim_frame];
+        const u16 *end = g->frame_deltas + g->frame_deltas[g->anim_frame + 1];
+        for (; delta < end; delta++) {
+            u16 slot = *delta;
+            u8 col = (u8)(slot >> 5);
+            u8 row = (u8)(slot & 31);
+            if (col >= g->num_cols || row >= g->num_rows)
+                continue;
+            u16 tile, attr;
+            tilemap_entry_words(g, tilemap[(u16)row * src_w + col], &tile, &attr);
+            if (slot != next_slot)
+                GFX_SETUP(deferred, sprite_base + slot * 2);
+            GFX_WRITE(deferred, tile);
+            GFX_WRITE(deferred, attr);
+            next_slot = (u16)(slot + 1);
+        }
+        return;
+    }
 
-    /* Calculate stretching */
-    u8 extra_rows = 0;
-    if (g->num_rows > src_tiles_h) {
-        extra_rows = g->num_rows - src_tiles_h;
+    const u16 *old_map = g->tilemap_frames + old_frame * g->tiles_per_frame;
+    for (u8 col = 0; col < g->num_cols; col++) {
+        for (u8 row = 0; row < g->num_rows; row++) {
+            u16 idx = (u16)((u16)row * src_w + col);
+            if (tilemap[idx] == old_map[idx])
+                continue;
+            u16 slot = (u16)(((u16)col << 5) | row);
+            u16 tile, attr;
+            tilemap_entry_words(g, tilemap[idx], &tile, &attr);
+            if (slot != next_slot)
+                GFX_SETUP(deferred, sprite_base + slot * 2);
+            GFX_WRITE(deferred, tile);
+            GFX_WRITE(deferred, attr);
+            next_slot = (u16)(slot + 1);
+        }
     }
+}
 
-    /* Middle row to repeat (default to center of middle section) */
-    u8 stretch_row = top_rows;
-    u8 middle_end = src_tiles_h - bottom_rows;
+/**
+ * Source row or column at index i of a 9-slice layout size tiles long: the
+ * source up to stretch, stretch repeated to fill, then the rest. Layouts no
+ * longer than the source show it unstretched.
+ */
+static u8 slice_src(u8 i, u8 size, u8 src_size, u8 stretch) {
+    if (size <= src_size || i <= stretch)
+        return i;
+    u8 extra = (u8)(size - src_size);
+    return (i <= stretch + extra) ? stretch : (u8)(i - extra);
+}
 
-    for (u8 col = 0; col < g->num_cols; col++) {
-        /* Set VRAM address for this sprite column (SCB1 base + sprite * 64) */
-        NG_VRAM_SETUP_FAST(NG_SCB1_BASE + ((first_sprite + col) * 64), 1);
+/* First index where two 9-slice layouts differ, or 0xFF if they match */
+static u8 slice_diverge(u8 size, u8 old_size, u8 src_size, u8 stretch) {
+    u8 extra = (size > src_size) ? (u8)(size - src_size) : 0;
+    u8 old_extra = (old_size > src_size) ? (u8)(old_size - src_size) : 0;
+    if (extra == old_extra)
+        return 0xFF;
+    return (u8)(stretch + 1 + (extra < old_extra ? extra : old_extra));
+}
 
-        u8 rows_written = 0;
+/* Tile rows a 9-slice column writes: the whole source at least */
+static u8 slice_rows(u8 num_rows, u8 src_tiles_h) {
+    u8 rows = (num_rows > src_tiles_h) ? num_rows : src_tiles_h;
+    return (rows > MAX_SPRITE_HEIGHT) ? MAX_SPRITE_HEIGHT : rows;
+}
 
-        /* Top rows */
-        for (u8 r = 0; r < top_rows && r < src_tiles_h; r++) {
-            u16 tile, attr;
-            get_tile_row_major(g, col, r, &tile, &attr);
-            NG_VRAM_WRITE_FAST(tile);
-            NG_VRAM_WRITE_FAST(attr);
-            rows_written++;
-        }
+/* Stretched row or column: the first past the top or left border */
+static u8 slice_stretch(u8 border, u16 src_tiles) {
+    u8 stretch = pixels_to_tiles(border);
+    return (stretch >= src_tiles) ? (u8)(src_tiles - 1) : stretch;
+}
 
-        /* Middle rows with stretching */
-        for (u8 r = top_rows; r < middle_end; r++) {
-            u16 tile, attr;
-            get_tile_row_major(g, col, r, &tile, &attr);
-            NG_VRAM_WRITE_FAST(tile);
-            NG_VRAM_WRITE_FAST(attr);
-            rows_written++;
-
-            /* Repeat stretch row - reuse tile/attr already fetched above */
-            if (r == stretch_row) {
-                for (u8 e = 0; e < extra_rows; e++) {
-                    NG_VRAM_WRITE_FAST(tile);
-                    NG_VRAM_WRITE_FAST(attr);
-                    rows_written++;
-                }
-            }
-        }
+/**
+ * Write rows [from, end) of one 9-slice sprite column, then clear up to
+ * clear_to rows; rows past clear_to are clear already.
+ */
+static void write_9slice_column(NGGraphic *g, u8 col, u8 src_col, u8 from, u8 clear_to) {
+    u8 deferred = NGDisplayListIsRecording();
+    NG_VRAM_DECLARE_BASE();
 
-        /* Bottom rows */
-        for (u8 r = middle_end; r < src_tiles_h; r++) {
-            u16 tile, attr;
-            get_tile_row_major(g, col, r, &tile, &attr);
-            NG_VRAM_WRITE_FAST(tile);
-            NG_VRAM_WRITE_FAST(attr);
-            rows_written++;
-        }
+    u8 src_tiles_h = (u8)g->src_tiles_h;
+    u8 rows = slice_rows(g->num_rows, src_tiles_h);
+    u8 stretch = slice_stretch(g->slice_top, src_tiles_h);
 
-        /* Pad remaining tiles to 32 */
-        if (rows_written < 32) {
-            NG_VRAM_CLEAR_FAST((32 - rows_written) * 2);
+    GFX_SETUP(deferred, NG_SCB1_BASE + ((g->hw_sprite_first + col) * 64) + from * 2);
+
+    /* Repeated stretch rows reuse the tile fetched last */
+    u8 last_src = 0xFF;
+    u16 tile = 0, attr = 0;
+    for (u8 r = from; r < rows; r++) {
+        u8 src_row = slice_src(r, g->num_rows, src_tiles_h, stretch);
+        if (src_row != last_src) {
+            get_tile_row_major(g, src_col, src_row, &tile, &attr);
+            last_src = src_row;
         }
+        GFX_WRITE(deferred, tile);
+        GFX_WRITE(deferred, attr);
+    }
+    if (rows < clear_to)
+        GFX_CLEAR(deferred, (clear_to - rows) * 2);
+}
+
+/**
+ * Write tiles for 9-slice mode. The left and top borders are followed by
+ * one repeated column and row that fill the size; right and bottom borders
+ * follow. After a resize from old_cols x old_rows (0 x 0 for a full
+ * write), only columns past the stretched ones that moved are rewritten
+ * whole, and the others only from the first row that moved.
+ */
+static void flush_tiles_9slice(NGGraphic *g, u8 old_cols, u8 old_rows) {
+    u8 src_tiles_w = (u8)g->src_tiles_w;
+    u8 src_tiles_h = (u8)g->src_tiles_h;
+    u8 stretch = slice_stretch(g->slice_left, src_tiles_w);
+
+    u8 from_col = 0;
+    u8 from_row = 0;
+    u8 clear_to = 32;
+    if (old_cols) {
+        from_col = slice_diverge(g->num_cols, old_cols, src_tiles_w, stretch);
+        if (from_col > old_cols)
+            from_col = old_cols;
+        from_row = slice_diverge(g->num_rows, old_rows, src_tiles_h,
+                                 slice_stretch(g->slice_top, src_tiles_h));
+        clear_to = slice_rows(old_rows, src_tiles_h);
+    }
+
+    for (u8 col = 0; col < g->num_cols; col++) {
+        u8 src_col = slice_src(col, g->num_cols, src_tiles_w, stretch);
+        if (col >= from_col)
+            write_9slice_column(g, col, src_col, 0, 32);
+        else if (from_row != 0xFF)
+            write_9slice_column(g, col, src_col, from_row, clear_to);
     }
 }
 
@@ -526,22 +1362,144 @@ static void flush_tiles_9slice(NGGraphic *g) {
 #define SCROLL_FIX(x)    ((s16)((x) << SCROLL_FRAC_BITS))
 #define SCROLL_INT(x)    ((s16)((x) >> SCROLL_FRAC_BITS))
 
+/*
+ * Infinite-mode columns are zoomed with a uniform hardware h-shrink, so
+ * every column is exactly (h + 1) pixels wide and the X spacing matches
+ * what the LSPC draws. Screen columns needed per width come from a table.
+ */
+#define SCROLL_SCREEN_COLS(w) ((SCREEN_WIDTH + (w) - 1) / (w) + 2)
+
+/* Columns needed to fill the screen (+2 buffer), indexed by h-shrink 0-15 */
+static const u16 scroll_screen_cols[16] = {
+    SCROLL_SCREEN_COLS(1),  SCROLL_SCREEN_COLS(2),  SCROLL_SCREEN_COLS(3),
+    SCROLL_SCREEN_COLS(4),  SCROLL_SCREEN_COLS(5),  SCROLL_SCREEN_COLS(6),
+    SCROLL_SCREEN_COLS(7),  SCROLL_SCREEN_COLS(8),  SCROLL_SCREEN_COLS(9),
+    SCROLL_SCREEN_COLS(10), SCROLL_SCREEN_COLS(11), SCROLL_SCREEN_COLS(12),
+    SCROLL_SCREEN_COLS(13), SCROLL_SCREEN_COLS(14), SCROLL_SCREEN_COLS(15),
+    SCROLL_SCREEN_COLS(16),
+};
+
+/* ============================================================
+ * SCB2 Staging
+ *
+ * Shrink values are staged during the flush and written after every
+ * graphic is flushed. Graphics sit in consecutive sprites in render
+ * order, so during a camera zoom the whole SCB2 update is one run, and
+ * groups at a zoom level copy their words from ng_zoom_shrink_table
+ * instead of spreading the shrink column by column.
+ * ============================================================ */
+
+static void stage_shrink(NGGraphic *g, u8 count, u16 shrink) {
+    g->shrink_cols = count;
+    g->shrink_val = shrink;
+}
+
+/* Precomputed SCB2 words for a zoom-level scale, or NULL */
+static const u16 *zoom_shrink_pattern(u16 shrink, u8 count) {
+    u8 v = (u8)shrink;
+    if (count > NG_ZOOM_SHRINK_COLS || (shrink >> 8) != v || v < 127 || (v & 15) != 15)
+        return NULL;
+    return &ng_zoom_shrink_table[(v - 127) >> 4][NG_ZOOM_SHRINK_INDEX(count)];
+}
+
+/* Write a graphic's staged shrink, continuing the run if it starts at *next */
+static void write_shrink(NGGraphic *g, u8 deferred, u16 *next) {
+    u8 count = g->shrink_cols;
+    if (!count)
+        return;
+    g->shrink_cols = 0;
+
+    NG_VRAM_DECLARE_BASE();
+    if (g->hw_sprite_first != *next)
+        GFX_SETUP(deferred, NG_SCB2_BASE + g->hw_sprite_first);
+    *next = (u16)(g->hw_sprite_first + count);
+
+    const u16 *pattern = zoom_shrink_pattern(g->shrink_val, count);
+    if (pattern) {
+        for (u8 i = 0; i < count; i++)
+            GFX_WRITE(deferred, pattern[i]);
+    } else {
+        NGSpriteShrinkWrite(count, g->shrink_val);
+    }
+}
+
+/* Hardware h-shrink (0-15) used for infinite-mode columns at a scale */
+static u8 scroll_h_shrink(u16 scale) {
+    return (u8)(scale_to_shrink(scale) >> 4);
+}
+
+/* Uniform SCB2 shrink word: same h for every column, full 8-bit v */
+static u16 scroll_shrink_val(u16 scale) {
+    return (u16)(((u16)(scroll_h_shrink(scale) << 4) << 8) | scale_to_shrink(scale));
+}
+
+/* Off-screen columns preloaded per idle frame, so a later zoom out finds
+ * its tiles already in VRAM instead of loading them all at once */
+#define SCROLL_PREFETCH_COLS 1
+
+/**
+ * Load SCB1 tiles for sprite columns [first, end).
+ * Column i always holds source column (scroll_base_col + i), whatever the
+ * current offset, so columns can be loaded at different times.
+ */
+static void load_scroll_columns(NGGraphic *g, u8 first, u8 end) {
+    u8 deferred = NGDisplayListIsRecording();
+    NG_VRAM_DECLARE_BASE();
+    s16 src_w = g->src_tiles_w;
+
+    /* get_tile_* add the current offset column; cancel it out */
+    s16 shift = (s16)((g->scroll_base_col - (g->src_offset_x >> TILE_SHIFT)) % src_w);
+    if (shift < 0)
+        shift = (s16)(shift + src_w);
+
+    for (u8 col = first; col < end; col++) {
+        GFX_SETUP(deferred, NG_SCB1_BASE + ((g->hw_sprite_first + col) * 64));
+        u8 src_col = (u8)((col + shift) % src_w);
+
+        for (u8 row = 0; row < g->num_rows; row++) {
+            u16 tile, attr;
+            if (g->tilemap || g->tilemap8 || g->tile_fetch) {
+                get_tile_row_major(g, src_col, row, &tile, &attr);
+            } else {
+                get_tile_column_major(g, src_col, row, &tile, &attr);
+            }
+            GFX_WRITE(deferred, tile);
+            GFX_WRITE(deferred, attr);
+        }
+
+        if (g->num_rows < 32) {
+            GFX_CLEAR(deferred, (32 - g->num_rows) * 2);
+        }
+    }
+
+    if (end > g->scroll_loaded_cols)
+        g->scroll_loaded_cols = end;
+}
+
+/* Load the next few off-screen columns, up to the sprites allocated. At
+ * full size nothing is off screen yet; the first zoom step loads the few
+ * columns it exposes, and only a zoomed-out layer prefetches for the next. */
+static void prefetch_scroll_columns(NGGraphic *g) {
+    u8 first = g->scroll_loaded_cols;
+    if (first >= g->num_cols || g->scale >= NG_GRAPHIC_SCALE_ONE)
+        return;
+    u8 end = (u8)(first + SCROLL_PREFETCH_COLS);
+    if (end > g->num_cols)
+        end = g->num_cols;
+    load_scroll_columns(g, first, end);
+}
+
 /**
- * Update X positions for infinite scroll using circular buffer.
+ * Normalize the circular buffer and write X positions.
  * Only writes SCB4 for visible_cols sprites - saves bandwidth at higher zoom.
  *
  * @param g            The graphic
- * @param pixel_diff   Pixels scrolled since last update
- * @param tile_width   Current tile width based on scale
+ * @param tile_width   Current column width in pixels
  * @param visible_cols Number of columns to actually render (may be less than num_cols)
  */
-static void update_scroll_positions_limited(NGGraphic *g, s16 pixel_diff, s16 tile_width,
-                                            u8 visible_cols) {
+static void write_scroll_positions(NGGraphic *g, s16 tile_width, u8 visible_cols) {
     s16 tile_width_fixed = SCROLL_FIX(tile_width);
 
-    /* Update scroll offset by pixel delta */
-    g->scroll_offset = (s16)(g->scroll_offset - SCROLL_FIX(pixel_diff));
-
     /* Wrap leftmost pointer when crossing tile boundaries */
     while (g->scroll_offset <= 0) {
         g->scroll_leftmost++;
@@ -571,23 +1529,26 @@ static void update_scroll_positions_limited(NGGraphic *g, s16 pixel_diff, s16 ti
 }
 
 /**
- * Calculate number of visible columns needed at current scale.
+ * Calculate number of visible columns needed at a column width.
  * Always renders complete copies of the asset (no partial repetitions).
  * This ensures seamless tiling without cut-off text/graphics.
  */
-static u8 calc_visible_cols(u8 max_cols, u8 src_tiles_w, s16 tile_width) {
-    /* Columns needed to fill screen = ceil(screen_width / tile_width) + 2 buffer */
-    u8 screen_cols = (u8)(((SCREEN_WIDTH + tile_width - 1) / tile_width) + 2);
+static u8 calc_visible_cols(u8 max_cols, u8 src_tiles_w, u8 h_shrink) {
+    u16 screen_cols = scroll_screen_cols[h_shrink];
+    if (screen_cols >= max_cols)
+        return max_cols;
     /* Round up to multiple of asset width for complete repetitions */
-    u8 repetitions = (u8)((screen_cols + src_tiles_w - 1) / src_tiles_w);
-    u8 needed = repetitions * src_tiles_w;
+    u8 needed = src_tiles_w;
+    while (needed < screen_cols)
+        needed = (u8)(needed + src_tiles_w);
     return (needed > max_cols) ? max_cols : needed;
 }
 
 /**
  * Flush infinite scroll graphic - optimized for scrolling backdrops.
- * Tiles are written once, scrolling only updates X positions.
- * Only renders columns needed at current zoom level to save sprites.
+ * Scrolling only updates X positions. Tiles are written once per column,
+ * when it is first needed, so zooming out loads only the newly exposed
+ * columns and zooming in only hides the ones that dropped out.
  */
 static void flush_infinite_scroll(NGGraphic *g) {
     u8 first_draw = (g->hw_sprite_first != g->cache.last_hw_sprite);
@@ -597,95 +1558,226 @@ static void flush_infinite_scroll(NGGraphic *g) {
         g->tiles_loaded = 0;
     }
 
-    s16 tile_width = (s16)((TILE_SIZE * g->scale) >> 8);
-    if (tile_width < 1)
-        tile_width = 1;
+    u8 h_shrink = scroll_h_shrink(g->scale);
+    s16 tile_width = (s16)(h_shrink + 1);
+    u8 visible_cols = calc_visible_cols(g->num_cols, (u8)g->src_tiles_w, h_shrink);
 
-    /* Calculate how many columns are actually visible at current scale */
-    u8 visible_cols = calc_visible_cols(g->num_cols, g->src_tiles_w, tile_width);
+    u8 shrink = scale_to_shrink(g->scale);
+    u8 hw_height = shown_height(g, g->num_rows, shrink);
+    u16 scb3_val = NGSpriteSCB3(g->screen_y, hw_height);
 
-    /* First draw or tiles invalidated - write tiles once */
+    /* First draw or tiles invalidated - set up the visible columns only */
     if (!g->tiles_loaded) {
-        /* SCB1: Write tile data for all columns (needed for zoom out) */
-        flush_tiles_standard(g);
-
-        /* SCB2: Shrink values for visible columns only */
-        NGSpriteShrinkSet(g->hw_sprite_first, visible_cols, scale_to_shrink_val(g->scale));
+        g->scroll_base_col = (s16)(g->src_offset_x >> TILE_SHIFT);
+        g->scroll_loaded_cols = 0;
+        load_scroll_columns(g, 0, visible_cols);
 
-        /* SCB3: Set Y/height for visible columns, hide extras */
-        u8 shrink = scale_to_shrink(g->scale);
-        u8 hw_height = NGSpriteAdjustedHeight(g->num_rows, shrink);
+        stage_shrink(g, visible_cols, scroll_shrink_val(g->scale));
         NGSpriteYSetUniform(g->hw_sprite_first, visible_cols, g->screen_y, hw_height);
         if (visible_cols < g->num_cols) {
             NGSpriteHideRange(g->hw_sprite_first + visible_cols, g->num_cols - visible_cols);
         }
 
-        /* SCB4: Initial X positions - start one tile left for buffer */
-        NGSpriteXSetSpaced(g->hw_sprite_first, visible_cols, -tile_width, tile_width);
-
-        /* Initialize scroll state */
+        /* Initialize scroll state: start one tile left for buffer */
         g->scroll_leftmost = 0;
         g->scroll_offset = SCROLL_FIX(tile_width); /* Start mid-range */
+        write_scroll_positions(g, tile_width, visible_cols);
+
         g->scroll_last_px = g->src_offset_x;
-        g->scroll_last_scb3 = 0xFFFF;
+        g->scroll_last_scb3 = scb3_val;
         g->tiles_loaded = 1;
         g->cache.last_visible_cols = visible_cols;
-
         g->cache.last_scale = g->scale;
         g->cache.last_hw_sprite = g->hw_sprite_first;
+        g->dirty = 0;
+        return;
     }
 
-    /* Handle scale changes */
-    if (g->scale != g->cache.last_scale) {
-        tile_width = (s16)((TILE_SIZE * g->scale) >> 8);
-        if (tile_width < 1)
-            tile_width = 1;
-        visible_cols = calc_visible_cols(g->num_cols, g->src_tiles_w, tile_width);
+    u8 old_cols = g->cache.last_visible_cols;
+    u8 positions_stale = 0;
+    u8 zoomed = (g->scale != g->cache.last_scale);
 
-        /* SCB2: Update shrink for visible columns */
-        NGSpriteShrinkSet(g->hw_sprite_first, visible_cols, scale_to_shrink_val(g->scale));
+    /* Zoom: touch only what the new scale changes */
+    if (zoomed) {
+        s16 old_width = (s16)(scroll_h_shrink(g->cache.last_scale) + 1);
 
-        /* SCB3: Update Y/height for visible columns, hide/show as needed */
-        u8 shrink = scale_to_shrink(g->scale);
-        u8 hw_height = NGSpriteAdjustedHeight(g->num_rows, shrink);
-        NGSpriteYSetUniform(g->hw_sprite_first, visible_cols, g->screen_y, hw_height);
-        if (visible_cols < g->num_cols) {
-            NGSpriteHideRange(g->hw_sprite_first + visible_cols, g->num_cols - visible_cols);
+        /* SCB1: Columns exposed before the prefetch reached them */
+        if (visible_cols > g->scroll_loaded_cols) {
+            load_scroll_columns(g, g->scroll_loaded_cols, visible_cols);
         }
 
-        /* SCB4: Reset X positions for new tile width */
-        NGSpriteXSetSpaced(g->hw_sprite_first, visible_cols, -tile_width, tile_width);
-        g->scroll_leftmost = 0;
-        g->scroll_offset = SCROLL_FIX(tile_width);
-        g->scroll_last_px = g->src_offset_x;
-        g->scroll_last_scb3 = NGSpriteSCB3(g->screen_y, hw_height);
-        g->cache.last_visible_cols = visible_cols;
+        /* SCB2: Shrink is uniform, one fill over the visible columns */
+        stage_shrink(g, visible_cols, scroll_shrink_val(g->scale));
+
+        if (visible_cols != old_cols) {
+            /* Keep the leftmost column's content, now modulo the new count */
+            g->scroll_leftmost = (u8)(g->scroll_leftmost % g->src_tiles_w);
+            positions_stale = 1;
+        }
+        if (tile_width != old_width) {
+            /* Same fraction of a column stays off the left edge */
+            g->scroll_offset = (s16)((g->scroll_offset * tile_width) / old_width);
+            positions_stale = 1;
+        }
 
         g->cache.last_scale = g->scale;
     }
 
-    /* SCB3: Y position - only write if changed */
-    u8 shrink = scale_to_shrink(g->scale);
-    u8 hw_height = NGSpriteAdjustedHeight(g->num_rows, shrink);
-    u16 scb3_val = NGSpriteSCB3(g->screen_y, hw_height);
-
+    /* SCB3: Whole range if Y/height changed, else just columns shown again */
     if (scb3_val != g->scroll_last_scb3) {
         NGSpriteYSetUniform(g->hw_sprite_first, visible_cols, g->screen_y, hw_height);
         g->scroll_last_scb3 = scb3_val;
+    } else if (visible_cols > old_cols) {
+        NGSpriteYSetUniform((u16)(g->hw_sprite_first + old_cols), (u8)(visible_cols - old_cols),
+                            g->screen_y, hw_height);
+    }
+    if (visible_cols < old_cols) {
+        NGSpriteHideRange(g->hw_sprite_first + visible_cols, old_cols - visible_cols);
     }
+    g->cache.last_visible_cols = visible_cols;
 
     /* Handle scrolling - only updates X positions, no tile rewrites! */
     s16 scroll_px = g->src_offset_x;
     s16 pixel_diff = (s16)(scroll_px - g->scroll_last_px);
 
-    if (pixel_diff != 0) {
-        update_scroll_positions_limited(g, pixel_diff, tile_width, visible_cols);
+    if (pixel_diff != 0 || positions_stale) {
+        g->scroll_offset = (s16)(g->scroll_offset - SCROLL_FIX(pixel_diff));
+        write_scroll_positions(g, tile_width, visible_cols);
         g->scroll_last_px = scroll_px;
     }
 
+    /* Spread the remaining tile loads over frames that are not zooming */
+    if (!zoomed)
+        prefetch_scroll_columns(g);
+    g->dirty = 0;
+}
+
+/* ============================================================
+ * Chained Infinite Scroll (Sticky Sprites)
+ * ============================================================ */
+
+/*
+ * Columns hold the source in order, starting one tile-aligned offset, and
+ * every column after the first is sticky: the LSPC places it right of the
+ * previous one. Scrolling moves only the first sprite's X, wrapped to one
+ * source period, so the whole layer can be re-positioned mid-frame with a
+ * single SCB4 write (see the backdrop band mode).
+ */
+
+/* Columns covering the screen at any X within one source period */
+static u8 calc_chain_cols(const NGGraphic *g, s16 tile_width) {
+    s16 period = (s16)((g->src_width * g->scale) >> 8);
+    u8 cols = (u8)((SCREEN_WIDTH + period + tile_width - 1) / tile_width);
+    u8 repetitions = (u8)((cols + g->src_tiles_w - 1) / g->src_tiles_w);
+    u8 needed = (u8)(repetitions * g->src_tiles_w);
+    return (needed > g->num_cols) ? g->num_cols : needed;
+}
+
+/* First sprite X showing source X offset_x at the left screen edge */
+static s16 chain_x(const NGGraphic *g, s16 offset_x) {
+    s16 period = (s16)g->src_width;
+    s16 rel = (s16)((offset_x - g->chain_base_px) % period);
+    if (rel < 0)
+        rel = (s16)(rel + period);
+    return (s16)(-((rel * g->scale) >> 8));
+}
+
+static void flush_scroll_chain(NGGraphic *g) {
+    u8 first_draw = (g->hw_sprite_first != g->cache.last_hw_sprite);
+
+    /* Reallocation: rebuild the chain */
+    if (g->tiles_loaded && first_draw) {
+        g->tiles_loaded = 0;
+    }
+
+    s16 tile_width = (s16)((TILE_SIZE * g->scale) >> 8);
+    if (tile_width < 1)
+        tile_width = 1;
+
+    u8 shrink = scale_to_shrink(g->scale);
+    u8 hw_height = shown_height(g, g->num_rows, shrink);
+    u16 scb3_val = NGSpriteSCB3(g->screen_y, hw_height);
+    u8 cols = calc_chain_cols(g, tile_width);
+
+    if (!g->tiles_loaded) {
+        /* SCB1: Tiles start at the tile containing the current offset */
+        g->scroll_base_col = (s16)(g->src_offset_x >> TILE_SHIFT);
+        g->scroll_loaded_cols = 0;
+        load_scroll_columns(g, 0, cols);
+        g->chain_base_px = (s16)(g->scroll_base_col << TILE_SHIFT);
+
+        /* SCB2/SCB3: One positioned sprite, the rest sticky */
+        stage_shrink(g, cols, scale_to_shrink_val(g->scale));
+        NGSpriteYSetChain(g->hw_sprite_first, cols, g->screen_y, hw_height);
+        if (cols < g->num_cols) {
+            NGSpriteHideRange(g->hw_sprite_first + cols, g->num_cols - cols);
+        }
+
+        g->chain_last_x = 0x7FFF; /* Force the SCB4 write below */
+        g->scroll_last_scb3 = scb3_val;
+        g->tiles_loaded = 1;
+        g->cache.last_visible_cols = cols;
+        g->cache.last_scale = g->scale;
+        g->cache.last_hw_sprite = g->hw_sprite_first;
+    }
+
+    /* Zoom: extend or trim the chain instead of rebuilding it */
+    u8 zoomed = (g->scale != g->cache.last_scale);
+    if (zoomed) {
+        u8 old_cols = g->cache.last_visible_cols;
+        if (cols > g->scroll_loaded_cols) {
+            load_scroll_columns(g, g->scroll_loaded_cols, cols);
+        }
+        stage_shrink(g, cols, scale_to_shrink_val(g->scale));
+        if (cols > old_cols) {
+            /* One header word plus a sticky fill over the longer chain */
+            NGSpriteYSetChain(g->hw_sprite_first, cols, g->screen_y, hw_height);
+            g->scroll_last_scb3 = scb3_val;
+        } else if (cols < old_cols) {
+            NGSpriteHideRange(g->hw_sprite_first + cols, old_cols - cols);
+        }
+        g->cache.last_visible_cols = cols;
+        g->cache.last_scale = g->scale;
+    }
+
+    /* SCB3: Sticky columns follow the first sprite's Y */
+    if (scb3_val != g->scroll_last_scb3) {
+        NGSpriteYSet(g->hw_sprite_first, g->screen_y, hw_height);
+        g->scroll_last_scb3 = scb3_val;
+    }
+
+    /* SCB4: One write scrolls the whole layer */
+    s16 x = chain_x(g, g->src_offset_x);
+    if (x != g->chain_last_x) {
+        NGSpriteXSet(g->hw_sprite_first, x);
+        g->chain_last_x = x;
+    }
+
+    if (!zoomed)
+        prefetch_scroll_columns(g);
     g->dirty = 0;
 }
 
+void _NGGraphicSetScrollChain(NGGraphic *g, u8 enabled) {
+    if (!g || g->tile_mode != NG_GRAPHIC_TILE_INFINITE)
+        return;
+    enabled = enabled ? 1 : 0;
+    if (g->scroll_chain == enabled)
+        return;
+    g->scroll_chain = enabled;
+    g->tiles_loaded = 0; /* Both paths rebuild every SCB from scratch */
+}
+
+u8 _NGGraphicScrollChainBand(const NGGraphic *g, s16 offset_x, u16 row, s16 *out_line,
+                             u16 *out_sprite, u16 *out_scb4) {
+    if (!g || !g->scroll_chain || !g->hw_allocated || !g->tiles_loaded || !g->visible)
+        return 0;
+    *out_line = (s16)(g->screen_y + (s16)((row * g->scale) >> 8));
+    *out_sprite = g->hw_sprite_first;
+    *out_scb4 = NGSpriteSCB4(chain_x(g, offset_x));
+    return 1;
+}
+
 /* ============================================================
  * Tilemap Scroll (Cycling Buffer for Terrain)
  * ============================================================ */
@@ -696,16 +1788,23 @@ static void flush_infinite_scroll(NGGraphic *g) {
  * Used by cycling buffer to update only changed columns.
  */
 static void load_tilemap8_column(NGGraphic *g, u16 sprite_idx, s16 src_col) {
-    u8 src_tiles_w = g->src_tiles_w;
-    u8 src_tiles_h = g->src_tiles_h;
+    u16 src_tiles_w = g->src_tiles_w;
+    u16 src_tiles_h = g->src_tiles_h;
     u16 effective_base = g->effective_base;
     const u8 *tilemap8 = g->tilemap8;
+    NGTileFetch fetch = g->tile_fetch;
     const u8 *tile_to_palette = g->tile_to_palette;
     u8 default_pal = g->palette;
     s16 src_row_offset = g->src_offset_y >> TILE_SHIFT;
     u8 topmost = g->scroll_topmost;
     u8 num_rows = g->num_rows;
 
+    /* Chunked source: walk down the fetched chunk, fetch again at chunk rows */
+    const u8 *chunk = NULL;
+    s16 chunk_next_row = -1;
+
+    u8 edited = src_col >= 0 && src_col < src_tiles_w && column_edited(g, src_col);
+
     NGSpriteTileBegin(sprite_idx);
 
     /* Write tiles in Y cycling order.
@@ -722,8 +1821,19 @@ static void load_tilemap8_column(NGGraphic *g, u16 sprite_idx, s16 src_col) {
             continue;
         }
 
-        u16 idx = (u16)((u16)src_row * src_tiles_w + (u16)src_col);
-        u8 tile_idx = tilemap8[idx];
+        u8 tile_idx;
+        if (fetch) {
+            if (src_row != chunk_next_row || !(src_row & (NG_TERRAIN_CHUNK_SIZE - 1)))
+                chunk = fetch(g->tile_fetch_ctx, (u16)src_col, (u16)src_row);
+            else
+                chunk += NG_TERRAIN_CHUNK_SIZE;
+            chunk_next_row = (s16)(src_row + 1);
+            tile_idx = *chunk;
+        } else {
+            tile_idx = tilemap8[(u32)src_row * src_tiles_w + (u16)src_col];
+        }
+        if (edited)
+            tile_idx = g->tile_overlay(g->tile_overlay_ctx, (u16)src_col, (u16)src_row, tile_idx);
         u16 tile = effective_base + tile_idx;
         u8 pal = tile_to_palette ? tile_to_palette[tile_idx] : default_pal;
 
@@ -744,17 +1854,23 @@ static void load_tilemap8_column(NGGraphic *g, u16 sprite_idx, s16 src_col) {
  * @param slot       Tile slot within sprite columns to write to (0 to num_rows-1)
  */
 static void update_tilemap8_row(NGGraphic *g, s16 src_row, u8 slot) {
+    u8 deferred = NGDisplayListIsRecording();
     NG_VRAM_DECLARE_BASE();
 
-    u8 src_tiles_w = g->src_tiles_w;
-    u8 src_tiles_h = g->src_tiles_h;
+    u16 src_tiles_w = g->src_tiles_w;
+    u16 src_tiles_h = g->src_tiles_h;
     u16 effective_base = g->effective_base;
     const u8 *tilemap8 = g->tilemap8;
+    NGTileFetch fetch = g->tile_fetch;
     const u8 *tile_to_palette = g->tile_to_palette;
     u8 default_pal = g->palette;
 
     s16 cur_tile_col = g->src_offset_x >> TILE_SHIFT;
 
+    /* Chunked source: walk along the fetched chunk row, fetch again at chunk columns */
+    const u8 *chunk = NULL;
+    s16 chunk_next_col = -1;
+
     /* For each screen column, update the tile at the specified slot */
     for (u8 col = 0; col < g->num_cols; col++) {
         /* Map screen column to sprite index (account for X cycling) */
@@ -766,31 +1882,123 @@ static void update_tilemap8_row(NGGraphic *g, s16 src_row, u8 slot) {
 
         /* Set VRAM address for this specific tile slot */
         /* SCB1: sprite * 64 words + slot * 2 words */
-        NG_VRAM_SETUP_FAST(NG_SCB1_BASE + (sprite_idx * 64) + (slot * 2), 1);
+        GFX_SETUP(deferred, NG_SCB1_BASE + (sprite_idx * 64) + (slot * 2));
 
         /* Clip mode: check bounds */
         if (src_col < 0 || src_col >= src_tiles_w || src_row < 0 || src_row >= src_tiles_h) {
             /* Write empty tile */
-            NG_VRAM_WRITE_FAST(0);
-            NG_VRAM_WRITE_FAST(0);
+            GFX_WRITE(deferred, 0);
+            GFX_WRITE(deferred, 0);
         } else {
-            u16 idx = (u16)((u16)src_row * src_tiles_w + (u16)src_col);
-            u8 tile_idx = tilemap8[idx];
+            u8 tile_idx;
+            if (fetch) {
+                if (src_col != chunk_next_col || !(src_col & (NG_TERRAIN_CHUNK_SIZE - 1)))
+                    chunk = fetch(g->tile_fetch_ctx, (u16)src_col, (u16)src_row);
+                else
+                    chunk++;
+                chunk_next_col = (s16)(src_col + 1);
+                tile_idx = *chunk;
+            } else {
+                tile_idx = tilemap8[(u32)src_row * src_tiles_w + (u16)src_col];
+            }
+            if (column_edited(g, src_col))
+                tile_idx = g->tile_overlay(g->tile_overlay_ctx, (u16)src_col, (u16)src_row,
+                                           tile_idx);
             u16 tile = effective_base + tile_idx;
             u8 pal = tile_to_palette ? tile_to_palette[tile_idx] : default_pal;
             u16 attr = (u16)(((u16)pal << 8) | 0x01); /* Default h_flip */
 
-            NG_VRAM_WRITE_FAST(tile);
-            NG_VRAM_WRITE_FAST(attr);
+            GFX_WRITE(deferred, tile);
+            GFX_WRITE(deferred, attr);
         }
     }
 }
 
+/* SCB4 X that keeps a 16 pixel column off both screen edges */
+#define SCROLL_HIDDEN_X (SCREEN_WIDTH + 64)
+
+/* Bits for sprite offsets 0 to cols-1 (cols up to 32) */
+static inline u32 column_mask(u8 cols) {
+    return cols >= 32 ? 0xFFFFFFFFu : ((u32)1 << cols) - 1;
+}
+
+/* Map tiles changed since the last draw, patched in place by the flush */
+#define TILE_PATCH_MAX 16
+
+typedef struct {
+    NGGraphic *g;
+    u16 col, row;
+} TilePatch;
+
+static TilePatch tile_patches[TILE_PATCH_MAX];
+static u8 tile_patch_count;
+
+void _NGGraphicPatchTile(NGGraphic *g, u16 col, u16 row) {
+    if (!g || !g->tiles_loaded)
+        return;
+    for (u8 i = 0; i < tile_patch_count; i++) {
+        if (tile_patches[i].g == g && tile_patches[i].col == col && tile_patches[i].row == row)
+            return;
+    }
+    if (tile_patch_count == TILE_PATCH_MAX) {
+        g->tiles_loaded = 0; /* Too many this frame: reload everything */
+        return;
+    }
+    TilePatch *p = &tile_patches[tile_patch_count++];
+    p->g = g;
+    p->col = col;
+    p->row = row;
+}
+
+void _NGGraphicSetTileOverlay(NGGraphic *g, NGTileOverlay overlay, void *ctx,
+                              const u8 *columns) {
+    if (!g)
+        return;
+    g->tile_overlay = overlay;
+    g->tile_overlay_ctx = ctx;
+    g->overlay_cols = columns;
+}
+
+/**
+ * Rewrite the patched tiles of g that are in the cycling buffer: one
+ * tile/attr pair each, at the tile's sprite and row slot. Tiles off screen
+ * load from the map when they scroll in, and so do stale columns.
+ */
+static void apply_tile_patches(NGGraphic *g, s16 first_col, s16 first_row) {
+    u8 deferred = NGDisplayListIsRecording();
+    NG_VRAM_DECLARE_BASE();
+    u8 kept = 0;
+    for (u8 i = 0; i < tile_patch_count; i++) {
+        TilePatch *p = &tile_patches[i];
+        if (p->g != g) {
+            tile_patches[kept++] = *p;
+            continue;
+        }
+        s16 col = (s16)(p->col - first_col);
+        s16 row = (s16)(p->row - first_row);
+        if (col < 0 || col >= g->num_cols || row < 0 || row >= g->num_rows)
+            continue;
+        u8 sprite_offset = (u8)((g->scroll_leftmost + col) % g->num_cols);
+        if (g->scroll_stale & ((u32)1 << sprite_offset))
+            continue;
+        u8 slot = (u8)((g->scroll_topmost + row) % g->num_rows);
+        u16 tile, attr;
+        get_tile_row_major(g, (u8)col, (u8)row, &tile, &attr);
+        GFX_SETUP(deferred, NG_SCB1_BASE + ((g->hw_sprite_first + sprite_offset) * 64) + slot * 2);
+        GFX_WRITE(deferred, tile);
+        GFX_WRITE(deferred, attr);
+    }
+    tile_patch_count = kept;
+}
+
 /**
  * Flush tilemap with cycling buffer - optimized for scrolling terrain.
  * Uses cycling buffers for both X and Y to minimize tile updates:
  * - X scroll: only updates the column(s) that enter view
  * - Y scroll: only updates the row(s) that enter view
+ * Column loads are spread over frames by the scroll budget: entering
+ * columns are marked stale and parked off-screen until loaded.
+ * Map tiles changed through _NGGraphicPatchTile() are rewritten last.
  */
 static void flush_tilemap_scroll(NGGraphic *g) {
     u8 first_draw = (g->hw_sprite_first != g->cache.last_hw_sprite);
@@ -799,6 +2007,7 @@ static void flush_tilemap_scroll(NGGraphic *g) {
     if (g->tiles_loaded && first_draw) {
         g->tiles_loaded = 0;
     }
+    u8 budgeted = scroll_budget_cols && g->num_cols <= 32;
 
     s16 tile_width = (s16)((TILE_SIZE * g->scale) >> 8);
     if (tile_width < 1)
@@ -813,6 +2022,7 @@ static void flush_tilemap_scroll(NGGraphic *g) {
         /* Initialize Y cycling state before loading columns */
         g->scroll_topmost = 0;
         g->scroll_leftmost = 0;
+        g->scroll_stale = 0;
 
         /* Load tiles for all columns */
         for (u8 col = 0; col < g->num_cols; col++) {
@@ -821,7 +2031,7 @@ static void flush_tilemap_scroll(NGGraphic *g) {
         }
 
         /* SCB2: Shrink values */
-        NGSpriteShrinkSet(g->hw_sprite_first, g->num_cols, scale_to_shrink_val(g->scale));
+        stage_shrink(g, g->num_cols, scale_to_shrink_val(g->scale));
 
         /* Initialize cycling state */
         g->scroll_last_px = cur_tile_col;
@@ -837,7 +2047,7 @@ static void flush_tilemap_scroll(NGGraphic *g) {
 
     /* Handle scale changes - reload all tiles */
     if (g->scale != g->cache.last_scale) {
-        NGSpriteShrinkSet(g->hw_sprite_first, g->num_cols, scale_to_shrink_val(g->scale));
+        stage_shrink(g, g->num_cols, scale_to_shrink_val(g->scale));
 
         /* Recalculate tile width */
         tile_width = (s16)((TILE_SIZE * g->scale) >> 8);
@@ -847,6 +2057,7 @@ static void flush_tilemap_scroll(NGGraphic *g) {
         /* Reset cycling state and reload all tiles */
         g->scroll_topmost = 0;
         g->scroll_leftmost = 0;
+        g->scroll_stale = 0;
         for (u8 col = 0; col < g->num_cols; col++) {
             s16 src_col = cur_tile_col + col;
             load_tilemap8_column(g, g->hw_sprite_first + col, src_col);
@@ -863,7 +2074,15 @@ static void flush_tilemap_scroll(NGGraphic *g) {
     s16 last_tile_row = g->scroll_last_row;
     s16 row_delta = cur_tile_row - last_tile_row;
 
-    if (row_delta != 0) {
+    if (budgeted && scroll_budget_rows &&
+        (row_delta > (s16)scroll_budget_rows || row_delta < -(s16)scroll_budget_rows)) {
+        /* Too far to patch row by row: restart the buffer at the new row
+         * and let the column budget reload it */
+        g->scroll_topmost = 0;
+        g->scroll_last_row = cur_tile_row;
+        g->cache.last_src_offset_y = g->src_offset_y;
+        g->scroll_stale = column_mask(g->num_cols);
+    } else if (row_delta != 0) {
         u8 num_rows = g->num_rows;
 
         if (row_delta > 0) {
@@ -914,7 +2133,10 @@ static void flush_tilemap_scroll(NGGraphic *g) {
                 u16 spr = g->hw_sprite_first + sprite_offset;
                 s16 new_col = (s16)(last_tile_col + (s16)g->num_cols + i);
 
-                load_tilemap8_column(g, spr, new_col);
+                if (budgeted)
+                    g->scroll_stale |= (u32)1 << sprite_offset;
+                else
+                    load_tilemap8_column(g, spr, new_col);
 
                 g->scroll_leftmost = (u8)((g->scroll_leftmost + 1) % g->num_cols);
             }
@@ -931,12 +2153,31 @@ static void flush_tilemap_scroll(NGGraphic *g) {
                 u16 spr = g->hw_sprite_first + sprite_offset;
                 s16 new_col = cur_tile_col - i;
 
-                load_tilemap8_column(g, spr, new_col);
+                if (budgeted)
+                    g->scroll_stale |= (u32)1 << sprite_offset;
+                else
+                    load_tilemap8_column(g, spr, new_col);
             }
         }
         g->scroll_last_px = cur_tile_col;
     }
 
+    /* Load waiting columns, left to right, as far as the budget goes */
+    if (g->scroll_stale) {
+        u8 loads = scroll_budget_cols;
+        for (u8 col = 0; col < g->num_cols && loads; col++) {
+            u8 sprite_offset = (u8)((g->scroll_leftmost + col) % g->num_cols);
+            if (!(g->scroll_stale & ((u32)1 << sprite_offset)))
+                continue;
+            load_tilemap8_column(g, g->hw_sprite_first + sprite_offset, (s16)(cur_tile_col + col));
+            g->scroll_stale &= ~((u32)1 << sprite_offset);
+            loads--;
+        }
+    }
+
+    if (tile_patch_count)
+        apply_tile_patches(g, cur_tile_col, cur_tile_row);
+
     /* SCB3: Y position adjusted for Y cycling buffer and sub-tile scrolling.
      * The cycling buffer rotates tile slots, so we adjust Y position to compensate:
      * - scroll_topmost slots are "above" the visible area
@@ -946,7 +2187,7 @@ static void flush_tilemap_scroll(NGGraphic *g) {
     s16 adjusted_screen_y = (s16)(g->screen_y - (s16)g->scroll_topmost * tile_height - sub_tile_y);
 
     u8 shrink = scale_to_shrink(g->scale);
-    u8 hw_height = NGSpriteAdjustedHeight(g->num_rows, shrink);
+    u8 hw_height = shown_height(g, g->num_rows, shrink);
     u16 scb3_val = NGSpriteSCB3(adjusted_screen_y, hw_height);
 
     if (scb3_val != g->scroll_last_scb3) {
@@ -961,6 +2202,8 @@ static void flush_tilemap_scroll(NGGraphic *g) {
         /* screen_col: which visual column (0=leftmost) this sprite index represents */
         u8 screen_col = (u8)((spr_idx + g->num_cols - g->scroll_leftmost) % g->num_cols);
         s16 x = (s16)(g->screen_x + screen_col * tile_width);
+        if (g->scroll_stale & ((u32)1 << spr_idx))
+            x = SCROLL_HIDDEN_X; /* Still holds another column's tiles */
         NGSpriteXWriteNext(x);
     }
 
@@ -968,6 +2211,97 @@ static void flush_tilemap_scroll(NGGraphic *g) {
     g->dirty = 0;
 }
 
+/**
+ * Metasprite frame: each part is a sprite of its own, placed and sized
+ * alone. After a frame change, SCB1 is rewritten only for sprites whose
+ * part shows a different tile run than before.
+ */
+static void flush_meta(NGGraphic *g) {
+    u8 deferred = NGDisplayListIsRecording();
+    NG_VRAM_DECLARE_BASE();
+    const NGMetaPart *parts = g->meta_parts + g->meta_frame_parts[g->anim_frame];
+    u16 first = g->hw_sprite_first;
+    u8 count = g->num_cols;
+    u8 hflip = (g->flip & NG_GRAPHIC_FLIP_H) != 0;
+    u8 vflip = (g->flip & NG_GRAPHIC_FLIP_V) != 0;
+
+    u8 redraw = first != g->cache.last_hw_sprite || (g->dirty & (DIRTY_SOURCE | DIRTY_SIZE)) ||
+                g->base_tile != g->cache.last_base_tile ||
+                g->palette != g->cache.last_palette || (u8)g->flip != g->cache.last_flip;
+    /* Sprites past the old frame's part count are new to this graphic */
+    const NGMetaPart *old = NULL;
+    u8 old_count = 0;
+    if (!redraw && g->anim_frame != g->cache.last_anim_frame) {
+        const u16 *fp = g->meta_frame_parts + g->cache.last_anim_frame;
+        old = g->meta_parts + fp[0];
+        old_count = (u8)(fp[1] - fp[0]);
+    }
+    u8 scale_changed = redraw || (g->dirty & DIRTY_SHRINK) || g->scale != g->cache.last_scale ||
+                       (old && count > old_count);
+    u8 moved = scale_changed || old || g->screen_x != g->cache.last_screen_x ||
+               g->screen_y != g->cache.last_screen_y;
+
+    /* SCB1 */
+    if (redraw || old) {
+        u16 base_attr = (u16)(((u16)g->palette << 8) | g->auto_anim_attr | hflip | (vflip << 1));
+        for (u8 k = 0; k < count; k++) {
+            const NGMetaPart *part = &parts[k];
+            if (k < old_count && old[k].tile == part->tile && old[k].height == part->height)
+                continue;
+            GFX_SETUP(deferred, NG_SCB1_BASE + ((first + k) * 64));
+            for (u8 r = 0; r < part->height; r++) {
+                u16 entry = g->tilemap[part->tile + (vflip ? part->height - 1 - r : r)];
+                u16 attr = base_attr;
+                if (entry & 0x8000)
+                    attr ^= 0x01; /* h_flip */
+                if (entry & 0x4000)
+                    attr ^= 0x02; /* v_flip */
+                GFX_WRITE(deferred, g->effective_base + (entry & 0x0FFF));
+                GFX_WRITE(deferred, attr);
+            }
+            /* Rows past the old part's height are still clear */
+            u8 clear_to = (k < old_count) ? old[k].height : 32;
+            if (part->height < clear_to)
+                GFX_CLEAR(deferred, (clear_to - part->height) * 2);
+        }
+        g->cache.last_base_tile = g->base_tile;
+        g->cache.last_anim_frame = g->anim_frame;
+        g->cache.last_palette = g->palette;
+        g->cache.last_flip = (u8)g->flip;
+    }
+
+    /* SCB2 */
+    if (scale_changed) {
+        stage_shrink(g, count, scale_to_shrink_val(g->scale));
+        g->cache.last_scale = g->scale;
+    }
+
+    /* SCB3 and SCB4: one run each, parts mirrored inside the frame box */
+    if (moved) {
+        u8 shrink = scale_to_shrink(g->scale);
+        GFX_SETUP(deferred, NG_SCB3_BASE + first);
+        for (u8 k = 0; k < count; k++) {
+            s16 y = parts[k].y;
+            if (vflip)
+                y = (s16)(g->src_height - y - tiles_to_pixels(parts[k].height));
+            s16 sy = (s16)(g->screen_y + (((s32)y * g->scale) >> 8));
+            GFX_WRITE(deferred, NGSpriteSCB3(sy, shown_height(g, parts[k].height, shrink)));
+        }
+        GFX_SETUP(deferred, NG_SCB4_BASE + first);
+        for (u8 k = 0; k < count; k++) {
+            s16 x = parts[k].x;
+            if (hflip)
+                x = (s16)(g->src_width - x - TILE_SIZE);
+            GFX_WRITE(deferred, NGSpriteSCB4((s16)(g->screen_x + (((s32)x * g->scale) >> 8))));
+        }
+        g->cache.last_screen_x = g->screen_x;
+        g->cache.last_screen_y = g->screen_y;
+    }
+
+    g->cache.last_hw_sprite = first;
+    g->dirty = 0;
+}
+
 /**
  * Flush a single graphic to hardware.
  */
@@ -976,14 +2310,25 @@ static void flush_graphic(NGGraphic *g) {
         return;
     }
 
+    if (g->meta_parts) {
+        flush_meta(g);
+        return;
+    }
+
+    NGBankSelect(g->source_bank);
+
     /* Infinite scroll mode has its own optimized path */
     if (g->tile_mode == NG_GRAPHIC_TILE_INFINITE) {
-        flush_infinite_scroll(g);
+        if (g->scroll_chain) {
+            flush_scroll_chain(g);
+        } else {
+            flush_infinite_scroll(g);
+        }
         return;
     }
 
     /* Tilemap8 with CLIP mode uses cycling buffer for efficient scrolling */
-    if (g->tilemap8 && g->tile_mode == NG_GRAPHIC_TILE_CLIP) {
+    if ((g->tilemap8 || g->tile_fetch) && g->tile_mode == NG_GRAPHIC_TILE_CLIP) {
         flush_tilemap_scroll(g);
         return;
     }
@@ -994,7 +2339,7 @@ static void flush_graphic(NGGraphic *g) {
     if (first_draw) {
         /* SCB1: Write tile data */
         if (g->tile_mode == NG_GRAPHIC_TILE_9SLICE) {
-            flush_tiles_9slice(g);
+            flush_tiles_9slice(g, 0, 0);
         } else {
             flush_tiles_standard(g);
         }
@@ -1006,12 +2351,12 @@ static void flush_graphic(NGGraphic *g) {
         g->cache.last_src_offset_y = g->src_offset_y;
 
         /* SCB2: Shrink values */
-        NGSpriteShrinkSet(g->hw_sprite_first, g->num_cols, scale_to_shrink_val(g->scale));
+        stage_shrink(g, g->num_cols, scale_to_shrink_val(g->scale));
         g->cache.last_scale = g->scale;
 
         /* SCB3: Y Position */
         u8 shrink = scale_to_shrink(g->scale);
-        u8 hw_height = NGSpriteAdjustedHeight(g->num_rows, shrink);
+        u8 hw_height = shown_height(g, g->num_rows, shrink);
         u8 use_chain = (g->layer == NG_GRAPHIC_LAYER_ENTITY);
         if (use_chain) {
             NGSpriteYSetChain(g->hw_sprite_first, g->num_cols, g->screen_y, hw_height);
@@ -1049,23 +2394,43 @@ static void flush_graphic(NGGraphic *g) {
     s16 last_tile_off_y = g->cache.last_src_offset_y >> TILE_SHIFT;
 
     u8 source_changed = (g->dirty & DIRTY_SOURCE) || g->base_tile != g->cache.last_base_tile ||
-                        g->anim_frame != g->cache.last_anim_frame ||
                         g->palette != g->cache.last_palette || (u8)g->flip != g->cache.last_flip ||
                         cur_tile_off_x != last_tile_off_x || cur_tile_off_y != last_tile_off_y;
 
     u8 size_changed = (g->dirty & DIRTY_SIZE) || g->display_width != g->cache.last_display_width ||
                       g->display_height != g->cache.last_display_height;
 
+    /* A new frame of the same tilemap only rewrites the entries that differ */
+    u8 frame_changed = g->anim_frame != g->cache.last_anim_frame;
+    if (frame_changed && !source_changed && !size_changed) {
+        if (frame_delta_ok(g)) {
+            flush_tiles_frame(g, g->cache.last_anim_frame);
+            g->cache.last_anim_frame = g->anim_frame;
+            frame_changed = 0;
+        }
+    }
+    source_changed |= frame_changed;
+
     u8 scale_changed = (g->dirty & DIRTY_SHRINK) || g->scale != g->cache.last_scale;
 
     /* Track X and Y changes separately to minimize VRAM writes */
     u8 x_changed = g->screen_x != g->cache.last_screen_x;
     u8 y_changed = g->screen_y != g->cache.last_screen_y;
 
+    /* A resized 9-slice keeps its sprites; columns it gained need shrink */
+    u8 old_cols = pixels_to_tiles(g->cache.last_display_width);
+    if (size_changed && g->num_cols > old_cols)
+        scale_changed = 1;
+
     /* SCB1: Write tile data */
     if (source_changed || size_changed) {
         if (g->tile_mode == NG_GRAPHIC_TILE_9SLICE) {
-            flush_tiles_9slice(g);
+            u8 old_rows = pixels_to_tiles(g->cache.last_display_height);
+            if (old_rows > MAX_SPRITE_HEIGHT)
+                old_rows = MAX_SPRITE_HEIGHT;
+            if (source_changed)
+                old_cols = old_rows = 0;
+            flush_tiles_9slice(g, old_cols, old_rows);
         } else {
             flush_tiles_standard(g);
         }
@@ -1080,14 +2445,14 @@ static void flush_graphic(NGGraphic *g) {
 
     /* SCB2: Shrink values */
     if (scale_changed) {
-        NGSpriteShrinkSet(g->hw_sprite_first, g->num_cols, scale_to_shrink_val(g->scale));
+        stage_shrink(g, g->num_cols, scale_to_shrink_val(g->scale));
         g->cache.last_scale = g->scale;
     }
 
     /* SCB3: Y Position - only write if Y changed */
     if (y_changed || scale_changed || size_changed) {
         u8 shrink = scale_to_shrink(g->scale);
-        u8 hw_height = NGSpriteAdjustedHeight(g->num_rows, shrink);
+        u8 hw_height = shown_height(g, g->num_rows, shrink);
 
         /* Determine column mode based on layer */
         u8 use_chain = (g->layer == NG_GRAPHIC_LAYER_ENTITY);
@@ -1134,18 +2499,10 @@ NGGraphic *NGGraphicCreate(const NGGraphicConfig *config) {
         return NULL;
     }
 
-    /* Find free slot */
-    NGGraphic *g = NULL;
-    for (u8 i = 0; i < NG_GRAPHIC_MAX; i++) {
-        if (!graphics[i].active) {
-            g = &graphics[i];
-            break;
-        }
-    }
-
-    if (!g) {
+    if (!free_count) {
         return NULL; /* No free slots */
     }
+    NGGraphic *g = &graphics[free_slots[--free_count]];
 
     /* Initialize to defaults */
     g->screen_x = 0;
@@ -1155,7 +2512,12 @@ NGGraphic *NGGraphicCreate(const NGGraphicConfig *config) {
     g->scale = NG_GRAPHIC_SCALE_ONE;
     g->flip = NG_GRAPHIC_FLIP_NONE;
 
-    g->layer = config->layer;
+    g->layer = (config->layer < LAYER_COUNT) ? config->layer : NG_GRAPHIC_LAYER_UI;
+    g->staged = staging ? STAGE_WAITING : 0;
+    staged_count = (u8)(staged_count + staging);
+#if NG_VRAM_STATS
+    memset(&g->traffic, 0, sizeof(g->traffic));
+#endif
     g->z_order = config->z_order;
     g->visible = 1;
 
@@ -1164,8 +2526,17 @@ NGGraphic *NGGraphicCreate(const NGGraphicConfig *config) {
     g->src_height = config->height;
     g->tilemap = NULL;
     g->tilemap8 = NULL;
+    g->tile_fetch = NULL;
+    g->source_bank = NG_BANK_FIXED;
+    g->tile_overlay = NULL;
+    g->tilemap_frames = NULL;
+    g->frame_deltas = NULL;
+    g->meta_parts = NULL;
+    g->meta_frame_parts = NULL;
     g->tile_to_palette = NULL;
     g->palette = 0;
+    g->shrink_cols = 0;
+    g->auto_anim_attr = 0;
     g->anim_frame = 0;
     g->tiles_per_frame = 0;
     g->src_offset_x = 0;
@@ -1185,6 +2556,7 @@ NGGraphic *NGGraphicCreate(const NGGraphicConfig *config) {
     g->hw_sprite_first = 0;
     g->hw_sprite_count = 0;
     g->hw_allocated = 0;
+    g->meta_span = 0;
 
     /* Infinite scroll state */
     g->scroll_leftmost = 0;
@@ -1194,6 +2566,12 @@ NGGraphic *NGGraphicCreate(const NGGraphicConfig *config) {
     g->scroll_last_px = 0;
     g->scroll_last_row = 0;
     g->scroll_last_scb3 = 0xFFFF;
+    g->scroll_base_col = 0;
+    g->scroll_loaded_cols = 0;
+    g->scroll_stale = 0;
+    g->scroll_chain = 0;
+    g->chain_base_px = 0;
+    g->chain_last_x = 0;
 
     /* Calculate sprite requirements */
     g->num_cols = pixels_to_tiles(config->width);
@@ -1204,6 +2582,10 @@ NGGraphic *NGGraphicCreate(const NGGraphicConfig *config) {
 
     g->dirty = DIRTY_ALL;
     g->active = 1;
+    g->priority = 0;
+    g->culled = 0;
+    g->palette_mask = NULL;
+    g->palette_counted = 0;
 
     /* Invalidate cache */
     g->cache.last_base_tile = 0xFFFF;
@@ -1219,7 +2601,8 @@ NGGraphic *NGGraphicCreate(const NGGraphicConfig *config) {
     g->cache.last_scale = 0xFFFF;
     g->cache.last_hw_sprite = 0xFFFF;
 
-    render_order_dirty = 1;
+    order_insert(g);
+    palette_refs_acquire(g);
 
     return g;
 }
@@ -1229,38 +2612,79 @@ void NGGraphicDestroy(NGGraphic *g) {
         return;
     }
 
-    /* Hide sprites if allocated */
-    if (g->hw_allocated && g->hw_sprite_count > 0) {
-        NGSpriteHideRange(g->hw_sprite_first, g->hw_sprite_count);
-    }
-
+    release_sprites(g);
+    palette_refs_release(g);
+    order_remove(g);
+    if (g->staged)
+        staged_count--;
     g->active = 0;
-    g->hw_allocated = 0;
-    render_order_dirty = 1;
+    free_slots[free_count++] = (u8)(g - graphics);
 }
 
 /* ============================================================
  * Source Configuration
  * ============================================================ */
 
+/* SCB1 attribute bits for a hardware auto-animation length */
+static u8 auto_anim_attr(u8 frames) {
+    if (frames == 8)
+        return NG_SPRITE_ATTR_AUTOANIM8;
+    return frames == 4 ? NG_SPRITE_ATTR_AUTOANIM4 : 0;
+}
+
+/* Current metasprite frame's part count, as sprite columns */
+static void meta_resize(NGGraphic *g) {
+    const u16 *fp = g->meta_frame_parts + g->anim_frame;
+    g->num_cols = (u8)(fp[1] - fp[0]);
+}
+
 void NGGraphicSetSource(NGGraphic *g, const NGVisualAsset *asset, u8 palette) {
     if (!g || !asset)
         return;
 
+    palette_refs_release(g);
+    clear_meta(g);
+
     g->base_tile = asset->base_tile;
     g->src_width = asset->width_pixels;
     g->src_height = asset->height_pixels;
-    g->tilemap = asset->tilemap;
     g->tilemap8 = NULL;
+    g->tile_fetch = NULL;
+    g->source_bank = NG_BANK_FIXED;
+    g->tile_overlay = NULL;
+    g->tilemap_frames = asset->tilemap;
+    g->frame_deltas = asset->tilemap ? asset->frame_deltas : NULL;
     g->palette = palette;
+    g->auto_anim_attr = auto_anim_attr(asset->auto_anim);
     g->tiles_per_frame = asset->tiles_per_frame;
 
     /* Precompute tile dimensions and effective base (avoids division/multiply in inner loop) */
     g->src_tiles_w = pixels_to_tiles(asset->width_pixels);
     g->src_tiles_h = pixels_to_tiles(asset->height_pixels);
-    g->effective_base = (u16)(asset->base_tile + g->anim_frame * asset->tiles_per_frame);
+    if (asset->parts) {
+        /* One sprite per part; tilemap holds the parts' tile runs */
+        g->tilemap = asset->tilemap;
+        g->tilemap_frames = NULL;
+        g->frame_deltas = NULL;
+        g->effective_base = asset->base_tile;
+        g->meta_parts = asset->parts;
+        g->meta_frame_parts = asset->frame_parts;
+        if (g->anim_frame >= asset->frame_count)
+            g->anim_frame = 0;
+        meta_resize(g);
+        g->num_rows = (u8)((g->src_tiles_h > MAX_SPRITE_HEIGHT) ? MAX_SPRITE_HEIGHT
+                                                                 : g->src_tiles_h);
+    } else if (asset->tilemap) {
+        /* Frames are whole tilemaps: tiles may be shared and out of order */
+        g->tilemap = asset->tilemap + g->anim_frame * asset->tiles_per_frame;
+        g->effective_base = asset->base_tile;
+    } else {
+        g->tilemap = NULL;
+        g->effective_base = (u16)(asset->base_tile + g->anim_frame * asset->tiles_per_frame);
+    }
 
     g->dirty |= DIRTY_SOURCE;
+    palette_refs_acquire(g);
 
     /* Load palette data to ensure fresh colors (e.g., after lighting effects) */
     if (asset->palette_data && palette == asset->palette) {
@@ -1272,12 +2696,21 @@ void NGGraphicSetSourceRaw(NGGraphic *g, u16 base_tile, u16 src_width, u16 src_h
     if (!g)
         return;
 
+    palette_refs_release(g);
+    clear_meta(g);
+
     g->base_tile = base_tile;
     g->src_width = src_width;
     g->src_height = src_height;
     g->tilemap = NULL;
     g->tilemap8 = NULL;
+    g->tile_fetch = NULL;
+    g->source_bank = NG_BANK_FIXED;
+    g->tile_overlay = NULL;
+    g->tilemap_frames = NULL;
+    g->frame_deltas = NULL;
     g->palette = palette;
+    g->auto_anim_attr = 0;
 
     /* Precompute tile dimensions and effective base */
     g->src_tiles_w = pixels_to_tiles(src_width);
@@ -1286,6 +2719,7 @@ void NGGraphicSetSourceRaw(NGGraphic *g, u16 base_tile, u16 src_width, u16 src_h
     g->effective_base = (u16)(base_tile + g->anim_frame * g->tiles_per_frame);
 
     g->dirty |= DIRTY_SOURCE;
+    palette_refs_acquire(g);
 }
 
 void NGGraphicSetSourceTilemap(NGGraphic *g, u16 base_tile, const u16 *tilemap, u16 map_width,
@@ -1293,21 +2727,31 @@ void NGGraphicSetSourceTilemap(NGGraphic *g, u16 base_tile, const u16 *tilemap,
     if (!g)
         return;
 
+    palette_refs_release(g);
+    clear_meta(g);
+
     g->base_tile = base_tile;
     g->tilemap = tilemap;
     g->tilemap8 = NULL;
-    g->src_width = tiles_to_pixels((u8)map_width);
-    g->src_height = tiles_to_pixels((u8)map_height);
+    g->tile_fetch = NULL;
+    g->source_bank = NG_BANK_FIXED;
+    g->tile_overlay = NULL;
+    g->tilemap_frames = NULL;
+    g->frame_deltas = NULL;
+    g->src_width = tiles_to_pixels(map_width);
+    g->src_height = tiles_to_pixels(map_height);
     g->tile_to_palette = tile_to_palette;
     g->palette = palette;
+    g->auto_anim_attr = 0;
     g->tiles_per_frame = 0;
 
     /* Precompute tile dimensions */
-    g->src_tiles_w = (u8)map_width;
-    g->src_tiles_h = (u8)map_height;
+    g->src_tiles_w = map_width;
+    g->src_tiles_h = map_height;
     g->effective_base = base_tile; /* No animation for tilemaps */
 
     g->dirty |= DIRTY_SOURCE;
+    palette_refs_acquire(g);
 }
 
 void NGGraphicSetSourceTilemap8(NGGraphic *g, u16 base_tile, const u8 *tilemap, u16 map_width,
@@ -1315,21 +2759,31 @@ void NGGraphicSetSourceTilemap8(NGGraphic *g, u16 base_tile, const u8 *tilemap,
     if (!g)
         return;
 
+    palette_refs_release(g);
+    clear_meta(g);
+
     g->base_tile = base_tile;
     g->tilemap = NULL;
     g->tilemap8 = tilemap;
-    g->src_width = tiles_to_pixels((u8)map_width);
-    g->src_height = tiles_to_pixels((u8)map_height);
+    g->tile_fetch = NULL;
+    g->source_bank = NG_BANK_FIXED;
+    g->tile_overlay = NULL;
+    g->tilemap_frames = NULL;
+    g->frame_deltas = NULL;
+    g->src_width = tiles_to_pixels(map_width);
+    g->src_height = tiles_to_pixels(map_height);
     g->tile_to_palette = tile_to_palette;
     g->palette = palette;
+    g->auto_anim_attr = 0;
     g->tiles_per_frame = 0;
 
     /* Precompute tile dimensions */
-    g->src_tiles_w = (u8)map_width;
-    g->src_tiles_h = (u8)map_height;
+    g->src_tiles_w = map_width;
+    g->src_tiles_h = map_height;
     g->effective_base = base_tile; /* No animation for tilemaps */
 
     g->dirty |= DIRTY_SOURCE;
+    palette_refs_acquire(g);
 }
 
 void NGGraphicSetSourceOffset(NGGraphic *g, s16 x, s16 y) {
@@ -1359,8 +2813,27 @@ void NGGraphicSetFrame(NGGraphic *g, u16 frame) {
 
     if (g->anim_frame != frame) {
         g->anim_frame = frame;
-        /* Precompute effective base tile (avoids multiply in inner loop) */
-        g->effective_base = (u16)(g->base_tile + frame * g->tiles_per_frame);
+        /* Precompute the frame's tilemap or base tile (avoids multiply in inner loop) */
+        if (g->meta_parts) {
+            /* Same part count keeps the sprites; flush rewrites what differs */
+            meta_resize(g);
+        } else if (g->tilemap_frames) {
+            /* Commit sees the frame change and rewrites only what differs */
+            g->tilemap = g->tilemap_frames + frame * g->tiles_per_frame;
+        } else {
+            g->effective_base = (u16)(g->base_tile + frame * g->tiles_per_frame);
+            g->dirty |= DIRTY_SOURCE;
+        }
+    }
+}
+
+void NGGraphicSetAutoAnim(NGGraphic *g, u8 frames) {
+    if (!g)
+        return;
+
+    u8 attr = auto_anim_attr(frames);
+    if (g->auto_anim_attr != attr) {
+        g->auto_anim_attr = attr;
         g->dirty |= DIRTY_SOURCE;
     }
 }
@@ -1393,11 +2866,13 @@ void NGGraphicSetSize(NGGraphic *g, u16 width, u16 height) {
         g->display_width = width;
         g->display_height = height;
 
-        /* Recalculate sprite requirements */
-        g->num_cols = pixels_to_tiles(width);
-        g->num_rows = pixels_to_tiles(height);
-        if (g->num_rows > MAX_SPRITE_HEIGHT) {
-            g->num_rows = MAX_SPRITE_HEIGHT;
+        /* Recalculate sprite requirements; metasprite frames set their own */
+        if (!g->meta_parts) {
+            g->num_cols = pixels_to_tiles(width);
+            g->num_rows = pixels_to_tiles(height);
+            if (g->num_rows > MAX_SPRITE_HEIGHT) {
+                g->num_rows = MAX_SPRITE_HEIGHT;
+            }
         }
 
         g->dirty |= DIRTY_SIZE;
@@ -1414,6 +2889,16 @@ void NGGraphicSetScale(NGGraphic *g, u16 scale) {
     }
 }
 
+void NGGraphicSetPalette(NGGraphic *g, u8 palette) {
+    if (!g || g->palette == palette)
+        return;
+
+    palette_refs_release(g);
+    g->palette = palette;
+    palette_refs_acquire(g);
+    NGGraphicInvalidateSource(g); /* Scrolling paths do not compare the palette */
+}
+
 void NGGraphicSetFlip(NGGraphic *g, NGGraphicFlip flip) {
     if (!g)
         return;
@@ -1429,8 +2914,10 @@ void NGGraphicSetZOrder(NGGraphic *g, u8 z) {
         return;
 
     if (g->z_order != z) {
+        u8 old_z = g->z_order;
         g->z_order = z;
-        render_order_dirty = 1;
+        if (g->active)
+            order_update_z(g, old_z);
     }
 }
 
@@ -1438,9 +2925,13 @@ void NGGraphicSetLayer(NGGraphic *g, NGGraphicLayer layer) {
     if (!g)
         return;
 
+    if (layer >= LAYER_COUNT)
+        layer = NG_GRAPHIC_LAYER_UI;
     if (g->layer != layer) {
-        g->layer = layer;
-        render_order_dirty = 1;
+        if (g->active)
+            order_update_layer(g, layer);
+        else
+            g->layer = layer;
     }
 }
 
@@ -1470,13 +2961,15 @@ void NGGraphicSetVisible(NGGraphic *g, u8 visible) {
     u8 was_visible = g->visible;
     g->visible = visible ? 1 : 0;
 
-    /* Hide sprites when becoming invisible */
-    if (was_visible && !g->visible && g->hw_allocated) {
-        NGSpriteHideRange(g->hw_sprite_first, g->hw_sprite_count);
+    /* Hide sprites and free the range when becoming invisible */
+    if (was_visible && !g->visible) {
+        release_sprites(g);
+        palette_refs_release(g);
     }
 
     if (!was_visible && g->visible) {
         g->dirty = DIRTY_ALL;
+        palette_refs_acquire(g);
     }
 }
 
@@ -1498,6 +2991,8 @@ void NGGraphicCommit(NGGraphic *g) {
     }
 
     flush_graphic(g);
+    u16 next = 0xFFFF;
+    write_shrink(g, NGDisplayListIsRecording(), &next);
 }
 
 void NGGraphicInvalidate(NGGraphic *g) {
@@ -1526,17 +3021,82 @@ s16 NGGraphicGetY(const NGGraphic *g) {
     return g ? g->screen_y : 0;
 }
 
+/* ============================================================
+ * Sprite Budget
+ * ============================================================ */
+
+void NGGraphicSetPriority(NGGraphic *g, u8 priority) {
+    if (!g)
+        return;
+    g->priority = priority;
+}
+
+void NGGraphicGetBudget(NGGraphicBudget *out) {
+    if (!out)
+        return;
+    *out = budget;
+}
+
+void NGGraphicResetBudget(void) {
+    budget.overflow_frames = 0;
+}
+
+void NGGraphicSetLineCheck(u8 enabled) {
+    line_check = enabled ? 1 : 0;
+}
+
+void NGGraphicSetScrollBudget(u8 columns, u8 rows) {
+    scroll_budget_cols = columns;
+    scroll_budget_rows = rows;
+}
+
+u8 NGGraphicIsScrollPending(const NGGraphic *g) {
+    return g && g->scroll_stale ? 1 : 0;
+}
+
 /* ============================================================
  * System Functions
  * ============================================================ */
 
-void NGGraphicSystemInit(void) {
-    for (u8 i = 0; i < NG_GRAPHIC_MAX; i++) {
+u8 _NGGraphicSystemAlloc(NGArena *arena, u8 capacity) {
+    NGArenaMark mark = NGArenaSave(arena);
+    graphics = NG_ARENA_ALLOC_ARRAY(arena, NGGraphic, capacity);
+    render_order = NG_ARENA_ALLOC_ARRAY(arena, u8, capacity);
+    free_slots = NG_ARENA_ALLOC_ARRAY(arena, u8, capacity);
+    plan_first = NG_ARENA_ALLOC_ARRAY(arena, u16, capacity);
+    free_count = 0;
+    if (!graphics || !render_order || !free_slots || !plan_first) {
+        NGArenaRestore(arena, mark);
+        graphic_capacity = 0;
+        return 0;
+    }
+    graphic_capacity = capacity;
+    return 1;
+}
+
+/* Mark every slot inactive; lowest slots are handed out first */
+static void slots_reset(void) {
+    for (u8 i = 0; i < graphic_capacity; i++) {
         graphics[i].active = 0;
         graphics[i].hw_allocated = 0;
+        free_slots[i] = (u8)(graphic_capacity - 1 - i);
     }
-    render_count = 0;
-    render_order_dirty = 1;
+    free_count = graphic_capacity;
+}
+
+void NGGraphicSystemInit(void) {
+    slots_reset();
+    order_reset();
+    palette_refs_reset();
+
+    /* Unowned sprites must be hidden; draw no longer sweeps them */
+    hide_all_sprites();
+    NGSpriteAutoAnimSetSpeed(NG_GRAPHIC_AUTOANIM_SPEED);
+    NGSpriteAutoAnimEnable(1);
+    reserved_sprites = 0;
+    tile_patch_count = 0;
+    staging = 0;
+    staged_count = 0;
     graphics_initialized = 1;
 }
 
@@ -1545,95 +3105,125 @@ void NGGraphicSystemDraw(void) {
         return;
     }
 
-    /* Rebuild render order if needed */
-    if (render_order_dirty) {
-        rebuild_render_order();
-    }
-
     /* Two-pool allocation: UI sprites from back, others from front.
      * This prevents UI graphics from being redrawn when entities change. */
-    u16 entity_idx = HW_SPRITE_FIRST;
-    u16 ui_idx = UI_SPRITE_FIRST;
-
+#if NG_VRAM_STATS
+    traffic_new_frame();
+#endif
+    u8 ui_start = layer_start(NG_GRAPHIC_LAYER_UI);
+    budget.culled_graphics = 0;
+    budget.culled_sprites = 0;
+    allocate_pool(0, ui_start, HW_SPRITE_FIRST, UI_SPRITE_FIRST - reserved_sprites);
+    allocate_pool(ui_start, render_count, UI_SPRITE_FIRST, HW_SPRITE_MAX);
+    if (budget.culled_graphics && budget.overflow_frames < 0xFFFF)
+        budget.overflow_frames++;
+
+    /* Apply the plan. All vacated sprites are hidden before anything is
+     * flushed, since another graphic may have moved onto them. */
     for (u8 i = 0; i < render_count; i++) {
-        NGGraphic *g = &graphics[render_order[i]];
-
-        if (!g->visible) {
-            /* Hide previously allocated sprites */
-            if (g->hw_allocated && g->hw_sprite_count > 0) {
-                NGSpriteHideRange(g->hw_sprite_first, g->hw_sprite_count);
-                g->hw_allocated = 0;
-            }
+        u8 idx = render_order[i];
+        NGGraphic *g = &graphics[idx];
+        u16 first = plan_first[idx];
+
+        TRAFFIC_MARK(mark);
+        if (!first) {
+            release_sprites(g); /* Hidden, or culled from a full pool */
+            TRAFFIC_CHARGE(g, mark);
+            if (g->staged)
+                g->staged = STAGE_WAITING;
             continue;
         }
 
         u8 needed = g->num_cols;
-        u16 sprite_idx;
-
-        /* UI layer uses reserved pool at end, others use main pool */
-        if (g->layer == NG_GRAPHIC_LAYER_UI) {
-            if (ui_idx + needed > HW_SPRITE_MAX) {
-                continue; /* Out of UI sprites */
-            }
-            sprite_idx = ui_idx;
-            ui_idx += needed;
-        } else {
-            if (entity_idx + needed > UI_SPRITE_FIRST) {
-                continue; /* Out of entity sprites */
+        if ((g->meta_parts || g->tile_mode == NG_GRAPHIC_TILE_9SLICE) && g->hw_allocated &&
+            g->hw_sprite_first == first) {
+            /* Metasprite frame with another part count, or a resized
+             * 9-slice: the sprites kept are rewritten only where they
+             * changed */
+            if (g->hw_sprite_count != needed) {
+                hide_vacated(g, first, needed);
+                g->hw_sprite_count = needed;
             }
-            sprite_idx = entity_idx;
-            entity_idx += needed;
-        }
-
-        /* Allocate sprites */
-        u8 sprite_moved = (g->hw_sprite_first != sprite_idx);
-        u8 count_changed = (g->hw_sprite_count != needed);
-
-        if (sprite_moved || count_changed || !g->hw_allocated) {
-            g->hw_sprite_first = sprite_idx;
+        } else if (!g->hw_allocated || g->hw_sprite_first != first ||
+                   g->hw_sprite_count != needed) {
+#if NG_VRAM_STATS
+            traffic_redraw(g, first);
+#endif
+            if (g->hw_allocated)
+                hide_vacated(g, first, needed);
+            g->hw_sprite_first = first;
             g->hw_sprite_count = needed;
             g->hw_allocated = 1;
             g->dirty = DIRTY_ALL; /* Force full redraw */
+            if (g->staged)
+                g->staged = STAGE_WAITING;
         }
-
-        /* Flush to hardware */
-        flush_graphic(g);
+        TRAFFIC_CHARGE(g, mark);
     }
 
-    /* Hide unused entity sprites (between entity_idx and UI_SPRITE_FIRST) */
-    if (entity_idx < UI_SPRITE_FIRST) {
-        u16 remaining = (u16)(UI_SPRITE_FIRST - entity_idx);
-        while (remaining > 0) {
-            u8 batch = (remaining > 255) ? 255 : (u8)remaining;
-            NGSpriteHideRange(entity_idx, batch);
-            entity_idx += batch;
-            remaining -= batch;
+    /* Flush to hardware. Staged graphics upload their tiles in render
+     * order, NG_GRAPHIC_STAGE_COLS columns a frame (at least one graphic),
+     * then wait for the swap: what changes meanwhile is written after it. */
+    for (u8 l = 0; l < LAYER_COUNT; l++)
+        budget.layer_sprites[l] = 0;
+    u8 stage_cols = NG_GRAPHIC_STAGE_COLS;
+    tile_share_count = 0;
+    for (u8 i = 0; i < render_count; i++) {
+        NGGraphic *g = &graphics[render_order[i]];
+        if (!g->hw_allocated)
+            continue;
+        budget.layer_sprites[g->layer] += g->hw_sprite_count;
+        if (g->staged) {
+            if (g->staged == STAGE_LOADED || !stage_cols)
+                continue;
+            stage_cols = (g->hw_sprite_count < stage_cols)
+                             ? (u8)(stage_cols - g->hw_sprite_count)
+                             : 0;
+            g->staged = STAGE_LOADED;
         }
+        TRAFFIC_MARK(mark);
+        flush_graphic(g);
+        TRAFFIC_CHARGE(g, mark);
     }
 
-    /* Hide unused UI sprites (between ui_idx and HW_SPRITE_MAX) */
-    if (ui_idx < HW_SPRITE_MAX) {
-        u16 remaining = (u16)(HW_SPRITE_MAX - ui_idx);
-        while (remaining > 0) {
-            u8 batch = (remaining > 255) ? 255 : (u8)remaining;
-            NGSpriteHideRange(ui_idx, batch);
-            ui_idx += batch;
-            remaining -= batch;
-        }
+    /* Patches left belong to graphics not drawn: they reload when drawn */
+    for (u8 i = 0; i < tile_patch_count; i++)
+        tile_patches[i].g->tiles_loaded = 0;
+    tile_patch_count = 0;
+
+    /* SCB2: Everything staged above, adjacent graphics in one run */
+    u8 deferred = NGDisplayListIsRecording();
+    u16 next = 0xFFFF;
+    for (u8 i = 0; i < render_count; i++) {
+        NGGraphic *g = &graphics[render_order[i]];
+        TRAFFIC_MARK(mark);
+        write_shrink(g, deferred, &next);
+        TRAFFIC_CHARGE(g, mark);
     }
+
+    u16 ui_used = budget.layer_sprites[NG_GRAPHIC_LAYER_UI];
+    budget.ui_free = (u16)(UI_SPRITE_POOL_SIZE - ui_used);
+    budget.entity_free = (u16)(UI_SPRITE_FIRST - HW_SPRITE_FIRST - reserved_sprites);
+    for (u8 l = 0; l < NG_GRAPHIC_LAYER_UI; l++)
+        budget.entity_free -= budget.layer_sprites[l];
+
+    budget.line_peak = 0;
+    budget.line_peak_y = 0;
+    budget.lines_over = 0;
+    if (line_check)
+        check_lines();
 }
 
 void NGGraphicSystemReset(void) {
-    /* Hide all sprites */
-    NGSpriteHideRange(0, 255);
-    NGSpriteHideRange(255, (u8)(HW_SPRITE_MAX - 255));
+    hide_all_sprites();
 
     /* Reset all graphics */
-    for (u8 i = 0; i < NG_GRAPHIC_MAX; i++) {
-        graphics[i].active = 0;
-        graphics[i].hw_allocated = 0;
-    }
-
-    render_count = 0;
-    render_order_dirty = 1;
+    slots_reset();
+    tile_patch_count = 0;
+    staging = 0;
+    staged_count = 0;
+
+    order_reset();
+    palette_refs_reset();
+    memset(&budget, 0, sizeof(budget));
 }
@@ -22,6 +22,35 @@ typedef struct {
     NGColor colors[NG_PAL_SIZE];
 } PaletteBackup;
 
+/** Number of levels in a 5-bit color channel */
+#define LIGHTING_LEVELS 32
+
+/**
+ * Per-channel lookup tables for resolve_palettes(), indexed by 5-bit level.
+ * Rebuilt only when the combined transform changes, so the per-color work
+ * is table lookups and ORs instead of multiplies.
+ */
+typedef struct {
+    /* Brightness, tint and clamp, already packed into NG_RGB bit positions */
+    u16 out_r[LIGHTING_LEVELS];
+    u16 out_g[LIGHTING_LEVELS];
+    u16 out_b[LIGHTING_LEVELS];
+
+    /* Saturation: level' = lum + sat_delta[level - lum + 31] */
+    u16 lum_r[LIGHTING_LEVELS]; /* level * 77, 150, 29 (sum >> 8 = luminance) */
+    u16 lum_g[LIGHTING_LEVELS];
+    u16 lum_b[LIGHTING_LEVELS];
+    s8 sat_delta[LIGHTING_LEVELS * 2 - 1]; /* (level - lum) * saturation */
+
+    /* Parameters the tables were built for */
+    u16 bright_scale;
+    u16 sat_scale;
+    s16 tint_r;
+    s16 tint_g;
+    s16 tint_b;
+    u8 valid;
+} TransformLut;
+
 /** Internal layer state */
 typedef struct {
     u8 active;
@@ -75,12 +104,23 @@ static struct {
     s16 additive_tint_g;
     s16 additive_tint_b;
 
+    TransformLut lut;
+
+    /* Time-sliced resolve: backup entries still showing an older transform */
+    u8 palette_budget;      /* Max palettes resolved per update (0 = all) */
+    u8 resolve_restore;     /* Pending entries restore originals instead */
+    u8 resolve_saturation;  /* Pending transform includes saturation */
+    u8 resolve_cursor;      /* Round-robin start for the next slice */
+    u8 resolve_pending_count;
+    u8 resolve_pending[LIGHTING_MAX_BACKUP_PALETTES];
+
     /* Pre-baked preset state */
     u8 prebaked_handle;       /* Handle for active preset (0xFF = none) */
     u8 prebaked_preset_id;    /* Current preset ID */
     u8 prebaked_fading;       /* Is a fade animation in progress? */
     u8 prebaked_fade_out;     /* Fading out (pop) vs fading in (push)? */
     u8 prebaked_current_step; /* Current fade step */
+    u8 prebaked_applied_step; /* Step palette RAM shows exactly (0xFF = unknown) */
     u8 prebaked_max_steps;    /* Total steps in preset */
     u16 prebaked_frames_remaining;
     u16 prebaked_frames_per_step;
@@ -91,7 +131,9 @@ static struct {
 static void backup_palettes(void);
 static void restore_palettes(void);
 static void resolve_palettes(void);
+static void resolve_pending_slice(void);
 static void apply_prebaked_step(u8 preset_id, u8 step);
+static void step_prebaked(u8 preset_id, u8 step);
 static void recalc_combined_transform(void);
 static s16 clamp_tint(s16 val);
 
@@ -115,10 +157,13 @@ void NGLightingInit(void) {
     g_lighting.initialized = 1;
     g_lighting.backup_valid = 0;
     g_lighting.backup_count = 0;
+    g_lighting.palette_budget = 0;
+    g_lighting.resolve_pending_count = 0;
 
     /* Initialize pre-baked preset state */
     g_lighting.prebaked_handle = NG_LIGHTING_INVALID;
     g_lighting.prebaked_fading = 0;
+    g_lighting.prebaked_applied_step = 0xFF;
 
     /* Register pre-baked presets if available (provided by progear_assets.h) */
     NGLightingInitPresets();
@@ -138,6 +183,7 @@ void NGLightingReset(void) {
 
     g_lighting.dirty = 0;
     g_lighting.backup_count = 0;
+    g_lighting.resolve_pending_count = 0;
 }
 
 NGLightingLayerHandle NGLightingPush(u8 priority) {
@@ -457,11 +503,13 @@ void NGLightingUpdate(void) {
         }
     }
 
-    /* Only resolve if something changed */
+    /* Only resolve if something changed; otherwise finish a sliced resolve */
     if (g_lighting.dirty) {
         recalc_combined_transform();
         resolve_palettes();
         g_lighting.dirty = 0;
+    } else if (g_lighting.resolve_pending_count) {
+        resolve_pending_slice();
     }
 
     /* Drive pre-baked preset fade animation automatically */
@@ -476,6 +524,10 @@ u8 NGLightingIsActive(void) {
     return any_layer_active();
 }
 
+void NGLightingSetPaletteBudget(u8 max_palettes) {
+    g_lighting.palette_budget = max_palettes;
+}
+
 u8 NGLightingIsAnimating(void) {
     for (u8 i = 0; i < NG_LIGHTING_MAX_LAYERS; i++) {
         LightingLayer *layer = &g_lighting.layers[i];
@@ -495,13 +547,20 @@ static void backup_palettes(void) {
         palette_mask[i] = 0;
     }
 
-    /* Query actors, backdrops, and terrain for their palettes */
+    /* Query actors, backdrops, terrain and particles for their palettes */
     _NGActorCollectPalettes(palette_mask);
     _NGBackdropCollectPalettes(palette_mask);
     _NGTerrainCollectPalettes(palette_mask);
+    _NGParticlesCollectPalettes(palette_mask);
 
-    /* Convert bitmask to sparse list and backup each palette */
+    /* Convert bitmask to sparse list and backup each palette. A sliced
+     * resolve of the previous set does not carry over. */
     g_lighting.backup_count = 0;
+    g_lighting.resolve_pending_count = 0;
+    g_lighting.resolve_cursor = 0;
+    for (u8 i = 0; i < LIGHTING_MAX_BACKUP_PALETTES; i++) {
+        g_lighting.resolve_pending[i] = 0;
+    }
     for (u16 pal = 1; pal < NG_PAL_COUNT; pal++) { /* Skip palette 0 (fix layer) */
         if (palette_mask[pal >> 3] & (1 << (pal & 7))) {
             if (g_lighting.backup_count < LIGHTING_MAX_BACKUP_PALETTES) {
@@ -515,6 +574,8 @@ static void backup_palettes(void) {
 }
 
 static void restore_palettes(void) {
+    g_lighting.resolve_pending_count = 0;
+    g_lighting.prebaked_applied_step = 0xFF;
     for (u8 i = 0; i < g_lighting.backup_count; i++) {
         PaletteBackup *entry = &g_lighting.backup[i];
         NGPalRestore(entry->palette_index, entry->colors);
@@ -595,7 +656,10 @@ static void recalc_combined_transform(void) {
 static void apply_additive_to_current_palettes(s16 add_r, s16 add_g, s16 add_b, u16 bright_scale) {
     for (u8 i = 0; i < g_lighting.backup_count; i++) {
         PaletteBackup *entry = &g_lighting.backup[i];
-        volatile u16 *pal = NGPalGetPtr(entry->palette_index);
+        if (!_NGGraphicPaletteInUse(entry->palette_index) &&
+            !_NGParticlesPaletteInUse(entry->palette_index))
+            continue; /* Not shown this frame */
+        u16 *pal = NGPalGetShadow(entry->palette_index);
 
         for (u8 c = 1; c < NG_PAL_SIZE; c++) {
             u16 original = pal[c];
@@ -649,18 +713,86 @@ static void apply_additive_to_current_palettes(s16 add_r, s16 add_g, s16 add_b,
 
             pal[c] = (u16)((d << 15) | (r << 8) | (g << 4) | b);
         }
+        NGPalMarkDirty(entry->palette_index);
+    }
+    g_lighting.prebaked_applied_step = 0xFF; /* Flash colors are not a preset step */
+}
+
+static u8 clamp_level(s16 level) {
+    if (level < 0)
+        return 0;
+    if (level > LIGHTING_LEVELS - 1)
+        return LIGHTING_LEVELS - 1;
+    return (u8)level;
+}
+
+/** Packed NG_RGB contribution of one channel: 4-bit value plus its LSB bit. */
+static u16 pack_level(u8 level, u8 shift, u8 lsb_bit) {
+    return (u16)(((level >> 1) << shift) | ((level & 1) << lsb_bit));
+}
+
+/**
+ * Rebuild the transform tables if the parameters changed.
+ * Products are accumulated by addition, so this needs no multiplies.
+ */
+static void build_transform_lut(u16 bright_scale, u16 sat_scale, s16 tint_r, s16 tint_g,
+                                s16 tint_b) {
+    TransformLut *lut = &g_lighting.lut;
+    if (lut->valid && lut->bright_scale == bright_scale && lut->sat_scale == sat_scale &&
+        lut->tint_r == tint_r && lut->tint_g == tint_g && lut->tint_b == tint_b)
+        return;
+
+    lut->bright_scale = bright_scale;
+    lut->sat_scale = sat_scale;
+    lut->tint_r = tint_r;
+    lut->tint_g = tint_g;
+    lut->tint_b = tint_b;
+    lut->valid = 1;
+
+    /* Keep level * scale within 16 bits and sat_delta within s8 */
+    if (bright_scale > 2048)
+        bright_scale = 2048;
+    if (sat_scale > 1024)
+        sat_scale = 1024;
+
+    u16 bright_acc = 0;
+    u16 lum_acc_r = 0, lum_acc_g = 0, lum_acc_b = 0;
+
+    for (u8 v = 0; v < LIGHTING_LEVELS; v++) {
+        s16 lit = (s16)(bright_acc >> 8);
+        lut->out_r[v] = pack_level(clamp_level(lit + tint_r), 8, 14);
+        lut->out_g[v] = pack_level(clamp_level(lit + tint_g), 4, 13);
+        lut->out_b[v] = pack_level(clamp_level(lit + tint_b), 0, 12);
+
+        /* Luminance coefficients: R*0.299 + G*0.587 + B*0.114, scaled to 256 */
+        lut->lum_r[v] = lum_acc_r;
+        lut->lum_g[v] = lum_acc_g;
+        lut->lum_b[v] = lum_acc_b;
+
+        bright_acc += bright_scale;
+        lum_acc_r += 77;
+        lum_acc_g += 150;
+        lum_acc_b += 29;
+    }
+
+    /* Arithmetic shift floors, matching the per-color formula */
+    s16 sat_acc = (s16)(-(LIGHTING_LEVELS - 1) * (s16)sat_scale);
+    for (u8 i = 0; i < LIGHTING_LEVELS * 2 - 1; i++) {
+        lut->sat_delta[i] = (s8)(sat_acc >> 8);
+        sat_acc += (s16)sat_scale;
     }
 }
 
 /**
  * Apply combined lighting transform to all backed-up palettes.
+ * Every palette is marked pending, then resolve_pending_slice() writes as
+ * many as the palette budget allows; the rest follow on later updates.
  *
- * Optimizations applied per NeoGeo dev wiki:
- * - Uses 16-bit MULU for brightness/saturation (68000 native instruction)
- * - Pre-computes all transform parameters outside inner loop
- * - Uses shift-based fixed point instead of division in loop
+ * The transform runs through per-channel tables from build_transform_lut():
+ * - Saturation: one table read and an add per channel, after luminance
+ *   from three table reads
+ * - Brightness, tint, clamp and repack: one table read per channel, ORed
  * - Skips neutral transforms entirely
- * - Uses ADD for multiply-by-2 (4 cycles faster than LSL #1)
  */
 static void resolve_palettes(void) {
     if (g_lighting.backup_count == 0)
@@ -680,8 +812,8 @@ static void resolve_palettes(void) {
      * But additive effects can be applied on top of the pre-baked colors.
      *
      * IMPORTANT: Re-apply the prebaked step first to restore correct colors.
-     * Without this, apply_additive_to_current_palettes() reads from VRAM which
-     * already has the previous frame's modified values, causing exponential
+     * Without this, apply_additive_to_current_palettes() reads the palette
+     * shadow, which already has the previous frame's modified values, causing exponential
      * decay to black over multiple frames. */
     if (g_lighting.prebaked_handle != NG_LIGHTING_INVALID) {
         if (has_additive) {
@@ -696,93 +828,88 @@ static void resolve_palettes(void) {
     const s16 total_tint_g = g_lighting.combined_tint_g + add_g;
     const s16 total_tint_b = g_lighting.combined_tint_b + add_b;
 
-    /* Convert fixed-point to 8-bit integer scale for FAST 16-bit multiply.
-     * Scale of 256 = 1.0, so brightness 0.5 -> 128, brightness 1.3 -> 333.
-     * This uses the 68000's native MULU instruction instead of 64-bit emulation. */
+    /* Convert fixed-point to 8-bit integer scale for the tables.
+     * Scale of 256 = 1.0, so brightness 0.5 -> 128, brightness 1.3 -> 333. */
     const u16 bright_scale = (u16)(g_lighting.combined_brightness >> 8);
     const u16 sat_scale = (u16)(g_lighting.combined_saturation >> 8);
 
     /* Check if transform is neutral (no-op) - just restore if so */
-    if (bright_scale == 256 && sat_scale == 256 && total_tint_r == 0 && total_tint_g == 0 &&
-        total_tint_b == 0) {
-        restore_palettes();
-        return;
+    g_lighting.resolve_restore = (bright_scale == 256 && sat_scale == 256 && total_tint_r == 0 &&
+                                  total_tint_g == 0 && total_tint_b == 0);
+    if (!g_lighting.resolve_restore) {
+        build_transform_lut(bright_scale, sat_scale, total_tint_r, total_tint_g, total_tint_b);
     }
+    g_lighting.resolve_saturation = (sat_scale != 256);
 
-    /* Determine which operations we need - checked once, not per-color */
-    const u8 need_saturation = (sat_scale != 256);
-    const u8 need_brightness = (bright_scale != 256);
-
-    /* Process only the palettes that are actually in use (sparse iteration) */
+    /* Every palette now needs the new transform */
     for (u8 i = 0; i < g_lighting.backup_count; i++) {
-        PaletteBackup *entry = &g_lighting.backup[i];
-        volatile u16 *dest = NGPalGetPtr(entry->palette_index);
-        const NGColor *src = entry->colors;
-
-        /* Process colors 1-15 (skip color 0 which is reference/transparent).
-         * Each color is processed with minimal branching in the inner loop. */
-        for (u8 c = 1; c < NG_PAL_SIZE; c++) {
-            NGColor original = src[c];
-
-            /* Extract RGB components using bit operations.
-             * NeoGeo color format: D15=dark, D14-D12=unused, D11-D8=R, D7-D4=G, D3-D0=B */
-            u16 r = (original >> 8) & 0x0F;  /* D11-D8 */
-            u16 g = (original >> 4) & 0x0F;  /* D7-D4 */
-            u16 b = original & 0x0F;         /* D3-D0 */
-            u16 d = (original >> 12) & 0x01; /* Dark bit D15 */
-
-            /* Expand to 5-bit (0-31 range).
-             * Uses ADD for multiply-by-2: faster than LSL #1 per wiki.
-             * r = (r << 1) | d  ->  r = r + r, then OR with dark bit */
-            r = (r + r) | d;
-            g = (g + g) | d;
-            b = (b + b) | d;
+        g_lighting.resolve_pending[i] = 1;
+    }
+    g_lighting.resolve_pending_count = g_lighting.backup_count;
 
-            /* Apply saturation (desaturate toward gray) - integer math only.
-             * Luminance coefficients: R*0.299 + G*0.587 + B*0.114
-             * Scaled to integers: R*77 + G*150 + B*29 (sum = 256 for >> 8) */
-            if (need_saturation) {
-                u16 lum = (u16)((r * 77 + g * 150 + b * 29) >> 8);
-
-                /* Interpolate: result = lum + ((orig - lum) * sat_scale) >> 8
-                 * Uses 68000 MULS for signed multiply */
-                r = (u16)(lum + ((((s16)r - (s16)lum) * (s16)sat_scale) >> 8));
-                g = (u16)(lum + ((((s16)g - (s16)lum) * (s16)sat_scale) >> 8));
-                b = (u16)(lum + ((((s16)b - (s16)lum) * (s16)sat_scale) >> 8));
-            }
+    resolve_pending_slice();
+}
 
-            /* Apply brightness - fast 16-bit MULU.
-             * The 68000 MULU takes 38-70 cycles but is faster than
-             * software multiplication or repeated shifts for larger values. */
-            if (need_brightness) {
-                r = (u16)((r * bright_scale) >> 8);
-                g = (u16)((g * bright_scale) >> 8);
-                b = (u16)((b * bright_scale) >> 8);
-            }
+/** Write one backed-up palette through the current transform tables. */
+static void resolve_entry(const PaletteBackup *entry) {
+    if (g_lighting.resolve_restore) {
+        NGPalRestore(entry->palette_index, entry->colors);
+        return;
+    }
 
-            /* Apply tint - simple addition */
-            s16 tr = (s16)r + total_tint_r;
-            s16 tg = (s16)g + total_tint_g;
-            s16 tb = (s16)b + total_tint_b;
-
-            /* Clamp to valid range (0-31) using branchless-friendly comparisons.
-             * The 68000 branch penalty is low, so explicit branches are fine here. */
-            if (tr < 0)
-                tr = 0;
-            else if (tr > 31)
-                tr = 31;
-            if (tg < 0)
-                tg = 0;
-            else if (tg > 31)
-                tg = 31;
-            if (tb < 0)
-                tb = 0;
-            else if (tb > 31)
-                tb = 31;
-
-            /* Write directly to palette RAM */
-            dest[c] = NG_RGB((u8)tr, (u8)tg, (u8)tb);
+    const TransformLut *lut = &g_lighting.lut;
+    const u8 need_saturation = g_lighting.resolve_saturation;
+    u16 *dest = NGPalGetShadow(entry->palette_index);
+    const NGColor *src = entry->colors;
+
+    /* Process colors 1-15 (skip color 0 which is reference/transparent).
+     * NeoGeo color format: D15=dark, D14-D12=unused, D11-D8=R, D7-D4=G, D3-D0=B.
+     * Each channel expands to a 5-bit level (nibble * 2 | dark bit). */
+    for (u8 c = 1; c < NG_PAL_SIZE; c++) {
+        NGColor original = src[c];
+        u16 d = (original >> 12) & 0x01;
+        u8 r = (u8)(((original >> 7) & 0x1E) | d);
+        u8 g = (u8)(((original >> 3) & 0x1E) | d);
+        u8 b = (u8)(((original << 1) & 0x1E) | d);
+
+        /* Saturation (desaturate toward gray) before brightness and tint */
+        if (need_saturation) {
+            u8 lum = (u8)((lut->lum_r[r] + lut->lum_g[g] + lut->lum_b[b]) >> 8);
+            const s8 *delta = &lut->sat_delta[LIGHTING_LEVELS - 1 - lum];
+            r = clamp_level((s16)(lum + delta[r]));
+            g = clamp_level((s16)(lum + delta[g]));
+            b = clamp_level((s16)(lum + delta[b]));
         }
+
+        dest[c] = (u16)(lut->out_r[r] | lut->out_g[g] | lut->out_b[b]);
+    }
+    NGPalMarkDirty(entry->palette_index);
+}
+
+/**
+ * Resolve pending palettes, at most palette_budget of them, round-robin
+ * from where the previous slice stopped. Palettes no visible graphic uses
+ * stay pending and cost nothing until something shows them again.
+ */
+static void resolve_pending_slice(void) {
+    u8 count = g_lighting.backup_count;
+    u8 budget = g_lighting.palette_budget;
+    if (budget == 0 || budget > g_lighting.resolve_pending_count)
+        budget = g_lighting.resolve_pending_count;
+
+    u8 i = g_lighting.resolve_cursor;
+    for (u8 n = 0; n < count && budget > 0; n++, i = (u8)((i + 1 < count) ? i + 1 : 0)) {
+        if (!g_lighting.resolve_pending[i])
+            continue;
+        if (!_NGGraphicPaletteInUse(g_lighting.backup[i].palette_index) &&
+            !_NGParticlesPaletteInUse(g_lighting.backup[i].palette_index))
+            continue;
+
+        resolve_entry(&g_lighting.backup[i]);
+        g_lighting.resolve_pending[i] = 0;
+        g_lighting.resolve_pending_count--;
+        budget--;
+        g_lighting.resolve_cursor = (u8)((i + 1 < count) ? i + 1 : 0);
     }
 }
 
@@ -793,15 +920,37 @@ static void resolve_palettes(void) {
  * automatically by generated code in progear_assets.h. */
 static NGLightingApplyStepFn g_prebaked_apply_fn = 0;
 static NGLightingGetInfoFn g_prebaked_info_fn = 0;
+static NGLightingApplyDeltaFn g_prebaked_delta_fn = 0;
 
 void NGLightingRegisterPrebaked(NGLightingApplyStepFn apply_fn, NGLightingGetInfoFn info_fn) {
     g_prebaked_apply_fn = apply_fn;
     g_prebaked_info_fn = info_fn;
 }
 
+void NGLightingRegisterPrebakedDelta(NGLightingApplyDeltaFn delta_fn) {
+    g_prebaked_delta_fn = delta_fn;
+}
+
 static void apply_prebaked_step(u8 preset_id, u8 step) {
+    g_lighting.resolve_pending_count = 0; /* Preset colors supersede a sliced resolve */
     if (g_prebaked_apply_fn) {
         g_prebaked_apply_fn(preset_id, step);
+        g_lighting.prebaked_applied_step = step;
+    }
+}
+
+/**
+ * Move a fade to an adjacent step. When palette RAM is known to show the
+ * neighbouring step, only the colors that differ are written.
+ */
+static void step_prebaked(u8 preset_id, u8 step) {
+    u8 from = g_lighting.prebaked_applied_step;
+    if (g_prebaked_delta_fn && from != 0xFF && (step == from + 1 || from == step + 1)) {
+        g_lighting.resolve_pending_count = 0;
+        g_prebaked_delta_fn(preset_id, from, step);
+        g_lighting.prebaked_applied_step = step;
+    } else {
+        apply_prebaked_step(preset_id, step);
     }
 }
 
@@ -909,15 +1058,13 @@ u8 NGLightingUpdatePrebakedFade(void) {
             /* Fading out - decrement step */
             if (g_lighting.prebaked_current_step > 0) {
                 g_lighting.prebaked_current_step--;
-                apply_prebaked_step(g_lighting.prebaked_preset_id,
-                                    g_lighting.prebaked_current_step);
+                step_prebaked(g_lighting.prebaked_preset_id, g_lighting.prebaked_current_step);
             }
         } else {
             /* Fading in - increment step */
             if (g_lighting.prebaked_current_step < g_lighting.prebaked_max_steps) {
                 g_lighting.prebaked_current_step++;
-                apply_prebaked_step(g_lighting.prebaked_preset_id,
-                                    g_lighting.prebaked_current_step);
+                step_prebaked(g_lighting.prebaked_preset_id, g_lighting.prebaked_current_step);
             }
         }
     }
@@ -0,0 +1,420 @@
+/*
+ * This file is part of ProGearSDK.
+ * Copyright (c) 2024-2025 ProGearSDK contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <particles.h>
+#include <ng_arena.h>
+#include <ng_hardware.h>
+#include <ng_sprite.h>
+#include <ng_display_list.h>
+#include <ng_raster.h>
+
+#include "sdk_internal.h"
+
+#define TILE_SIZE      16
+#define TILE_HALF      8
+#define SCREEN_WIDTH   320
+#define SCREEN_HEIGHT  224
+#define ATTR_UNCACHED  0xFFFF /* Never a real attr: flags are in the low byte */
+#define MUX_BAND_LINES 28
+#define MUX_BANDS      (SCREEN_HEIGHT / MUX_BAND_LINES)
+
+/* One array per field keeps the update loop on sequential memory */
+static fixed *pos_x;
+static fixed *pos_y;
+static fixed *vel_x;
+static fixed *vel_y;
+static u8 *life;
+static u16 *tile;
+static u8 *palette;
+static u16 capacity;
+static u16 count;
+
+/* Reserved sprite block and what each sprite showed last frame */
+static u16 *shown_tile;
+static u16 *shown_attr;
+static u16 sprite_first;
+static u8 sprite_count;
+static u8 sprites_drawn;
+static u8 needs_setup;
+
+/* Sprite reuse below earlier particles (deferred drawing only) */
+static u8 multiplex;
+static u16 multiplexed;
+static u16 drawn;
+
+static fixed gravity_x;
+static fixed gravity_y;
+static u8 bounds_enabled;
+static fixed bound_left, bound_top, bound_right, bound_bottom;
+
+static u8 palette_mask[32];
+
+#define PART_SETUP(deferred, addr, mod)         \
+    do {                                        \
+        if (deferred)                           \
+            NGDisplayListRun((u16)(addr), mod); \
+        else                                    \
+            NG_VRAM_SETUP_FAST(addr, mod);      \
+    } while (0)
+
+#define PART_WRITE(deferred, data)         \
+    do {                                   \
+        if (deferred)                      \
+            NGDisplayListPut((u16)(data)); \
+        else                               \
+            NG_VRAM_WRITE_FAST(data);      \
+    } while (0)
+
+#define PART_CLEAR(deferred, n)                 \
+    do {                                        \
+        if (deferred)                           \
+            NGDisplayListFillNext(0, (u16)(n)); \
+        else                                    \
+            NG_VRAM_CLEAR_FAST(n);              \
+    } while (0)
+
+u8 _NGParticlesSystemAlloc(NGArena *arena, u16 cap, u8 sprites) {
+    capacity = 0;
+    count = 0;
+    sprite_count = 0;
+    if (!cap)
+        return 1;
+
+    NGArenaMark mark = NGArenaSave(arena);
+    pos_x = NG_ARENA_ALLOC_ARRAY(arena, fixed, cap);
+    pos_y = NG_ARENA_ALLOC_ARRAY(arena, fixed, cap);
+    vel_x = NG_ARENA_ALLOC_ARRAY(arena, fixed, cap);
+    vel_y = NG_ARENA_ALLOC_ARRAY(arena, fixed, cap);
+    life = NG_ARENA_ALLOC_ARRAY(arena, u8, cap);
+    tile = NG_ARENA_ALLOC_ARRAY(arena, u16, cap);
+    palette = NG_ARENA_ALLOC_ARRAY(arena, u8, cap);
+    shown_tile = NG_ARENA_ALLOC_ARRAY(arena, u16, sprites);
+    shown_attr = NG_ARENA_ALLOC_ARRAY(arena, u16, sprites);
+
+    if (!pos_x || !pos_y || !vel_x || !vel_y || !life || !tile || !palette || !shown_tile ||
+        !shown_attr) {
+        NGArenaRestore(arena, mark);
+        return 0;
+    }
+    capacity = cap;
+    sprite_count = sprites;
+    return 1;
+}
+
+void _NGParticlesSystemInit(void) {
+    sprite_first = _NGGraphicReserveSprites(sprite_count);
+    if (!sprite_first)
+        sprite_count = 0;
+    gravity_x = 0;
+    gravity_y = 0;
+    bounds_enabled = 0;
+    multiplex = 0;
+    _NGParticlesReset();
+}
+
+void _NGParticlesReset(void) {
+    NGParticlesClear();
+    /* The graphic system hid the whole sprite range */
+    sprites_drawn = 0;
+    drawn = 0;
+    needs_setup = 1;
+}
+
+u8 NGParticleSpawn(fixed x, fixed y, fixed vx, fixed vy, u8 frames, u16 tile_index, u8 pal) {
+    if (count >= capacity)
+        return 0;
+    u16 i = count++;
+    pos_x[i] = x;
+    pos_y[i] = y;
+    vel_x[i] = vx;
+    vel_y[i] = vy;
+    life[i] = frames;
+    tile[i] = tile_index;
+    palette[i] = pal;
+    palette_mask[pal >> 3] |= (u8)(1 << (pal & 7));
+    return 1;
+}
+
+/* Swap-remove: the last particle takes slot i, so order is not kept */
+static void kill(u16 i) {
+    u16 last = --count;
+    pos_x[i] = pos_x[last];
+    pos_y[i] = pos_y[last];
+    vel_x[i] = vel_x[last];
+    vel_y[i] = vel_y[last];
+    life[i] = life[last];
+    tile[i] = tile[last];
+    palette[i] = palette[last];
+}
+
+static u8 out_of_bounds(u16 i) {
+    return pos_x[i] < bound_left || pos_x[i] >= bound_right || pos_y[i] < bound_top ||
+           pos_y[i] >= bound_bottom;
+}
+
+void NGParticlesUpdate(void) {
+    if (gravity_x || gravity_y) {
+        for (u16 i = 0; i < count; i++) {
+            vel_x[i] += gravity_x;
+            vel_y[i] += gravity_y;
+        }
+    }
+
+    u16 i = 0;
+    while (i < count) {
+        pos_x[i] += vel_x[i];
+        pos_y[i] += vel_y[i];
+        if (life[i] && --life[i] == 0) {
+            kill(i); /* Slot i now holds an unmoved particle */
+            continue;
+        }
+        if (bounds_enabled && out_of_bounds(i)) {
+            kill(i);
+            continue;
+        }
+        i++;
+    }
+}
+
+void NGParticlesSetGravity(fixed gx, fixed gy) {
+    gravity_x = gx;
+    gravity_y = gy;
+}
+
+void NGParticlesSetBounds(fixed left, fixed top, fixed right, fixed bottom) {
+    bound_left = left;
+    bound_top = top;
+    bound_right = right;
+    bound_bottom = bottom;
+    bounds_enabled = 1;
+}
+
+void NGParticlesClearBounds(void) {
+    bounds_enabled = 0;
+}
+
+u16 NGParticlesHit(fixed x, fixed y, fixed half_w, fixed half_h, u8 remove) {
+    fixed left = x - half_w, right = x + half_w;
+    fixed top = y - half_h, bottom = y + half_h;
+    u16 hits = 0;
+    u16 i = 0;
+
+    while (i < count) {
+        if (pos_x[i] >= left && pos_x[i] <= right && pos_y[i] >= top && pos_y[i] <= bottom) {
+            hits++;
+            if (remove) {
+                kill(i);
+                continue;
+            }
+        }
+        i++;
+    }
+    return hits;
+}
+
+void NGParticlesClear(void) {
+    count = 0;
+    for (u8 i = 0; i < 32; i++)
+        palette_mask[i] = 0;
+}
+
+u16 NGParticlesCount(void) {
+    return count;
+}
+
+u16 NGParticlesCapacity(void) {
+    return capacity;
+}
+
+void NGParticlesSetMultiplex(u8 enable) {
+    multiplex = enable;
+}
+
+u16 NGParticlesGetDrawn(void) {
+    return drawn;
+}
+
+/* Screen position of particle i's tile; 0 if it is off-screen */
+static u8 screen_pos(u16 i, s16 cam_x, s16 cam_y, s16 *sx, s16 *sy) {
+    *sx = (s16)(FIX_INT(pos_x[i]) - cam_x - TILE_HALF);
+    *sy = (s16)(FIX_INT(pos_y[i]) - cam_y - TILE_HALF);
+    return *sx > -TILE_SIZE && *sx < SCREEN_WIDTH && *sy > -TILE_SIZE && *sy < SCREEN_HEIGHT;
+}
+
+/* A slot's SCB1 stays put all frame, so only SCB3/SCB4 can change */
+static u8 same_look(u16 a, u16 b) {
+    return tile[a] == tile[b] && palette[a] == palette[b];
+}
+
+/**
+ * Give slots to visible particles band by band, top to bottom. The first
+ * sprite_count particles get fresh slots, written in VBlank. Later ones
+ * take a slot whose last particle ended above their band and showed the
+ * same tile and palette; two raster writes move it as the beam passes.
+ * @param slot_of Receives the particle of each fresh slot
+ * @param fresh_out Receives the number of fresh slots
+ * @return 0 if ng_arena_frame is too small
+ */
+static u8 plan_multiplex(s16 cam_x, s16 cam_y, u16 *slot_of, u8 *fresh_out) {
+    NGArena *arena = &ng_arena_frame;
+    u16 *order = NG_ARENA_ALLOC_ARRAY(arena, u16, count);
+    u8 *band_of = NG_ARENA_ALLOC_ARRAY(arena, u8, count);
+    s16 *slot_bottom = NG_ARENA_ALLOC_ARRAY(arena, s16, sprite_count);
+    u16 fifo_size = (u16)(sprite_count + NG_RASTER_MAX_ENTRIES / 2);
+    u8 *fifo = NG_ARENA_ALLOC_ARRAY(arena, u8, fifo_size);
+    if (!order || !band_of || !slot_bottom || !fifo)
+        return 0;
+
+    /* Counting sort by the band holding each tile's top line */
+    u16 band_start[MUX_BANDS + 1];
+    for (u8 b = 0; b <= MUX_BANDS; b++)
+        band_start[b] = 0;
+    for (u16 i = 0; i < count; i++) {
+        s16 sx, sy;
+        if (!screen_pos(i, cam_x, cam_y, &sx, &sy)) {
+            band_of[i] = 0xFF;
+            continue;
+        }
+        u8 b = (sy <= 0) ? 0 : (u8)(sy / MUX_BAND_LINES);
+        band_of[i] = b;
+        band_start[b + 1]++;
+    }
+    for (u8 b = 0; b < MUX_BANDS; b++)
+        band_start[b + 1] += band_start[b];
+    u16 fill[MUX_BANDS];
+    for (u8 b = 0; b < MUX_BANDS; b++)
+        fill[b] = band_start[b];
+    for (u16 i = 0; i < count; i++) {
+        if (band_of[i] != 0xFF)
+            order[fill[band_of[i]]++] = i;
+    }
+
+    u8 fresh = 0;
+    u16 head = 0, tail = 0;
+    u8 raster_full = 0;
+    for (u8 b = 0; b < MUX_BANDS; b++) {
+        /* A write on this line lands before the LSPC parses the band */
+        s16 line = (s16)(b * MUX_BAND_LINES - 2);
+        for (u16 n = band_start[b]; n < band_start[b + 1]; n++) {
+            u16 p = order[n];
+            s16 sx, sy;
+            screen_pos(p, cam_x, cam_y, &sx, &sy);
+
+            if (fresh < sprite_count) {
+                slot_of[fresh] = p;
+                slot_bottom[fresh] = (s16)(sy + TILE_SIZE);
+                fifo[tail++] = fresh++;
+                continue;
+            }
+            if (line < 0 || raster_full || tail >= fifo_size)
+                continue;
+
+            /* Oldest slots first; stop at the first one still on screen */
+            u16 f = head;
+            while (f < tail && slot_bottom[fifo[f]] <= line && !same_look(slot_of[fifo[f]], p))
+                f++;
+            if (f >= tail || slot_bottom[fifo[f]] > line)
+                continue;
+            if (NGRasterGetCount() + 2 > NG_RASTER_MAX_ENTRIES) {
+                raster_full = 1;
+                continue;
+            }
+
+            u8 slot = fifo[f];
+            fifo[f] = fifo[head];
+            head++;
+            NGRasterAddSCB3((u16)line, (u16)(sprite_first + slot), NGSpriteSCB3(sy, 1));
+            NGRasterAddSCB4((u16)line, (u16)(sprite_first + slot), NGSpriteSCB4(sx));
+            slot_bottom[slot] = (s16)(sy + TILE_SIZE);
+            fifo[tail++] = slot;
+            multiplexed++;
+        }
+    }
+    *fresh_out = fresh;
+    return 1;
+}
+
+u8 _NGParticlesDraw(void) {
+    if (!sprite_count)
+        return 0;
+
+    u8 deferred = NGDisplayListIsRecording();
+    NG_VRAM_DECLARE_BASE();
+
+    if (needs_setup) {
+        /* Full size never changes; tiles are rewritten on first use */
+        NGSpriteShrinkSet(sprite_first, sprite_count, NG_SPRITE_SHRINK_NONE);
+        for (u8 k = 0; k < sprite_count; k++)
+            shown_attr[k] = ATTR_UNCACHED;
+        needs_setup = 0;
+    }
+
+    s16 cam_x = FIX_INT(NGCameraGetRenderX());
+    s16 cam_y = FIX_INT(NGCameraGetRenderY());
+
+    /* Raster writes would clobber the VRAM address of immediate writes
+     * during active display, so multiplexing needs the display list */
+    u16 *slot_of = 0;
+    u8 shown = 0;
+    multiplexed = 0;
+    if (multiplex && deferred && count > sprite_count) {
+        NGArenaMark mark = NGArenaSave(&ng_arena_frame);
+        slot_of = NG_ARENA_ALLOC_ARRAY(&ng_arena_frame, u16, sprite_count);
+        if (!slot_of || !plan_multiplex(cam_x, cam_y, slot_of, &shown)) {
+            NGArenaRestore(&ng_arena_frame, mark);
+            slot_of = 0;
+        }
+    }
+    if (!slot_of)
+        shown = (count < sprite_count) ? (u8)count : sprite_count;
+    drawn = (u16)(shown + multiplexed);
+    if (!shown && !sprites_drawn)
+        return 0;
+
+    /* SCB1: only sprites whose tile or palette changed */
+    for (u8 k = 0; k < shown; k++) {
+        u16 i = slot_of ? slot_of[k] : k;
+        u16 attr = (u16)((u16)palette[i] << 8);
+        if (tile[i] != shown_tile[k] || attr != shown_attr[k]) {
+            PART_SETUP(deferred, NG_SCB1_BASE + (sprite_first + k) * 64, 1);
+            PART_WRITE(deferred, tile[i]);
+            PART_WRITE(deferred, attr);
+            shown_tile[k] = tile[i];
+            shown_attr[k] = attr;
+        }
+    }
+
+    /* SCB3: one run, hiding off-screen particles and sprites freed since
+     * last frame */
+    PART_SETUP(deferred, NG_SCB3_BASE + sprite_first, 1);
+    for (u8 k = 0; k < shown; k++) {
+        s16 sx, sy;
+        u8 visible = screen_pos(slot_of ? slot_of[k] : k, cam_x, cam_y, &sx, &sy);
+        PART_WRITE(deferred, visible ? NGSpriteSCB3(sy, 1) : 0);
+    }
+    if (sprites_drawn > shown)
+        PART_CLEAR(deferred, sprites_drawn - shown);
+    sprites_drawn = shown;
+
+    /* SCB4 */
+    if (shown) {
+        PART_SETUP(deferred, NG_SCB4_BASE + sprite_first, 1);
+        for (u8 k = 0; k < shown; k++) {
+            u16 i = slot_of ? slot_of[k] : k;
+            PART_WRITE(deferred, NGSpriteSCB4((s16)(FIX_INT(pos_x[i]) - cam_x - TILE_HALF)));
+        }
+    }
+    return multiplexed != 0;
+}
+
+void _NGParticlesCollectPalettes(u8 *mask) {
+    for (u8 i = 0; i < 32; i++)
+        mask[i] |= palette_mask[i];
+}
+
+u8 _NGParticlesPaletteInUse(u8 pal) {
+    return (palette_mask[pal >> 3] >> (pal & 7)) & 1;
+}
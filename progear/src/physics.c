@@ -5,6 +5,9 @@
  */
 
 #include <physics.h>
+#include <ng_arena.h>
+
+#include "sdk_internal.h"
 
 // Fast path for axis-aligned normals (AABB collisions produce ±1,0 or 0,±1)
 static inline fixed mul_by_normal_component(fixed value, fixed normal_comp) {
@@ -28,18 +31,89 @@ static inline fixed dot_with_normal(fixed vx, fixed vy, NGVec2 *normal) {
 
 static NGPhysWorld g_world;
 
+/* Broadphase grid: cells map onto GRID_DIM x GRID_DIM buckets by wrapping
+ * their coordinates, so lookups need no multiply or hash. */
+#define GRID_DIM       8
+#define GRID_MASK      (GRID_DIM - 1)
+#define GRID_BUCKETS   (GRID_DIM * GRID_DIM)
+#define GRID_PER_BODY  4
+#define GRID_NONE      0xFFFF
+#define CELL_SHIFT_MIN 3
+#define CELL_SHIFT_MAX 8
+
+#if NG_PHYS_MAX_BODIES > 255
+#error "NG_PHYS_MAX_BODIES must be 255 or less"
+#endif
+
+/* Body table size for the next arena allocation, set by engine init */
+static u8 body_capacity = NG_PHYS_MAX_BODIES;
+
+static u16 grid_head[GRID_BUCKETS];
+static u16 *grid_next; /* capacity * GRID_PER_BODY entries */
+static u8 *grid_body;
+
+/* Per-body cell range by live list position, valid after grid_build() */
+static s16 *cell_x0, *cell_y0;
+static u8 *cell_w, *cell_h;
+
+/* Pair dedup: tested_with[j] == i + 1 once (i, j) has been considered */
+static u8 *tested_with;
+
+void _NGPhysSystemInit(u8 capacity) {
+    body_capacity = capacity;
+    g_world.active = 0;
+    g_world.bodies = 0; /* The arena was reset; allocate again on create */
+}
+
+static u8 alloc_tables(void) {
+    NGArena *arena = &ng_arena_persistent;
+    NGArenaMark mark = NGArenaSave(arena);
+    u16 n = body_capacity;
+    u16 entries = (u16)(n * GRID_PER_BODY);
+
+    g_world.bodies = NG_ARENA_ALLOC_ARRAY(arena, NGBody, n);
+    g_world.live = NG_ARENA_ALLOC_ARRAY(arena, u8, n);
+    grid_next = NG_ARENA_ALLOC_ARRAY(arena, u16, entries);
+    grid_body = NG_ARENA_ALLOC_ARRAY(arena, u8, entries);
+    cell_x0 = NG_ARENA_ALLOC_ARRAY(arena, s16, n);
+    cell_y0 = NG_ARENA_ALLOC_ARRAY(arena, s16, n);
+    cell_w = NG_ARENA_ALLOC_ARRAY(arena, u8, n);
+    cell_h = NG_ARENA_ALLOC_ARRAY(arena, u8, n);
+    tested_with = NG_ARENA_ALLOC_ARRAY(arena, u8, n);
+
+    if (!g_world.bodies || !g_world.live || !grid_next || !grid_body || !cell_x0 || !cell_y0 ||
+        !cell_w || !cell_h || !tested_with) {
+        NGArenaRestore(arena, mark);
+        g_world.bodies = 0;
+        return 0;
+    }
+    g_world.capacity = (u8)n;
+    return 1;
+}
+
 NGPhysWorldHandle NGPhysWorldCreate(void) {
     if (g_world.active)
         return 0;
+    if (!g_world.bodies && !alloc_tables())
+        return 0;
 
     g_world.active = 1;
     g_world.gravity.x = 0;
     g_world.gravity.y = 0;
     g_world.bounds_enabled = 0;
-
-    for (int j = 0; j < NG_PHYS_MAX_BODIES; j++) {
-        g_world.bodies[j].active = 0;
+    NGPhysWorldSetCellSize(&g_world, NG_PHYS_DEFAULT_CELL_SIZE);
+    g_world.sleep_velocity = NG_PHYS_DEFAULT_SLEEP_VELOCITY;
+    g_world.sleep_frames = NG_PHYS_DEFAULT_SLEEP_FRAMES;
+    g_world.terrain = NG_TERRAIN_INVALID;
+    g_world.updating = 0;
+    NGPhysWorldSetStepRate(&g_world, 60);
+    for (u8 a = 0; a < NG_PHYS_LAYERS; a++) {
+        for (u8 b = 0; b < NG_PHYS_LAYERS; b++)
+            g_world.pair_callback[a][b] = 0;
+        g_world.pair_swap[a] = 0;
+        g_world.pair_ignore[a] = 0;
     }
+    NGPhysWorldReset(&g_world);
 
     return &g_world;
 }
@@ -53,6 +127,12 @@ void NGPhysWorldDestroy(NGPhysWorldHandle world) {
 void NGPhysWorldSetGravity(NGPhysWorldHandle world, fixed gx, fixed gy) {
     if (!world)
         return;
+    if (world->gravity.x != gx || world->gravity.y != gy) {
+        /* Resting bodies were balanced against the old gravity */
+        for (u8 i = 0; i < world->live_count; i++) {
+            NGPhysBodyWake(&world->bodies[world->live[i]]);
+        }
+    }
     world->gravity.x = gx;
     world->gravity.y = gy;
 }
@@ -68,19 +148,76 @@ void NGPhysWorldSetBounds(NGPhysWorldHandle world, fixed left, fixed right, fixe
     world->bounds_enabled = 1;
 }
 
+void NGPhysWorldSetCellSize(NGPhysWorldHandle world, u16 size) {
+    if (!world)
+        return;
+    u8 shift = CELL_SHIFT_MIN;
+    while (shift < CELL_SHIFT_MAX && (1u << shift) < size)
+        shift++;
+    world->cell_shift = shift;
+}
+
+void NGPhysWorldSetSleepThreshold(NGPhysWorldHandle world, fixed velocity, u8 frames) {
+    if (!world)
+        return;
+    world->sleep_velocity = velocity;
+    world->sleep_frames = frames ? frames : 1;
+    if (velocity == 0) {
+        for (u8 i = 0; i < world->live_count; i++) {
+            NGPhysBodyWake(&world->bodies[world->live[i]]);
+        }
+    }
+}
+
 void NGPhysWorldDisableBounds(NGPhysWorldHandle world) {
     if (!world)
         return;
     world->bounds_enabled = 0;
 }
 
+void NGPhysWorldSetPairCallback(NGPhysWorldHandle world, u8 layer_a, u8 layer_b,
+                                NGCollisionCallback callback, void *user_data) {
+    if (!world || layer_a >= NG_PHYS_LAYERS || layer_b >= NG_PHYS_LAYERS)
+        return;
+    world->pair_callback[layer_a][layer_b] = callback;
+    world->pair_callback[layer_b][layer_a] = callback;
+    world->pair_data[layer_a][layer_b] = user_data;
+    world->pair_data[layer_b][layer_a] = user_data;
+    world->pair_swap[layer_a] &= (u8)~(1u << layer_b);
+    if (layer_a != layer_b)
+        world->pair_swap[layer_b] |= (u8)(1u << layer_a);
+}
+
+void NGPhysWorldIgnorePair(NGPhysWorldHandle world, u8 layer_a, u8 layer_b, u8 ignore) {
+    if (!world || layer_a >= NG_PHYS_LAYERS || layer_b >= NG_PHYS_LAYERS)
+        return;
+    if (ignore) {
+        world->pair_ignore[layer_a] |= (u8)(1u << layer_b);
+        world->pair_ignore[layer_b] |= (u8)(1u << layer_a);
+    } else {
+        world->pair_ignore[layer_a] &= (u8)~(1u << layer_b);
+        world->pair_ignore[layer_b] &= (u8)~(1u << layer_a);
+    }
+}
+
+void NGPhysWorldSetTerrain(NGPhysWorldHandle world, NGTerrainHandle terrain) {
+    if (!world)
+        return;
+    world->terrain = terrain;
+}
+
 void NGPhysWorldReset(NGPhysWorldHandle world) {
     if (!world)
         return;
 
-    for (int i = 0; i < NG_PHYS_MAX_BODIES; i++) {
+    for (u8 i = 0; i < world->capacity; i++) {
         world->bodies[i].active = 0;
+        world->bodies[i].flags = 0;
     }
+    world->live_count = 0;
+    world->removed = 0;
+    world->tile_events = 0;
+    world->tile_event_count = 0;
 }
 
 static u8 test_circle_circle(NGBody *a, NGBody *b, NGCollision *out) {
@@ -97,7 +234,7 @@ static u8 test_circle_circle(NGBody *a, NGBody *b, NGCollision *out) {
         out->normal = (NGVec2){FIX_ONE, 0};
         out->penetration = radii;
     } else {
-        out->normal = (NGVec2){FIX_DIV(delta.x, dist), FIX_DIV(delta.y, dist)};
+        out->normal = NGVec2NormalizeFast(delta);
         out->penetration = radii - dist;
     }
 
@@ -145,6 +282,100 @@ static u8 test_aabb_aabb(NGBody *a, NGBody *b, NGCollision *out) {
     return 1;
 }
 
+/* Half extents of a body's bounding box */
+static inline void body_half_extents(const NGBody *body, fixed *hw, fixed *hh) {
+    if (body->shape.type == NG_SHAPE_CIRCLE) {
+        *hw = *hh = body->shape.circle.radius;
+    } else {
+        *hw = body->shape.aabb.half_width;
+        *hh = body->shape.aabb.half_height;
+    }
+}
+
+/**
+ * Entry and exit times of one axis of a swept box test (slab test).
+ * p is A's start offset from B, d A's move relative to B, e the summed
+ * half extents. Times are fractions of the move; FIX_ONE + 1 = never.
+ * @return 0 if the axis never overlaps during the move
+ */
+static u8 sweep_axis(fixed p, fixed d, fixed e, fixed *enter, fixed *leave) {
+    if (d == 0) {
+        *enter = -1;
+        *leave = FIX_ONE + 1;
+        return FIX_ABS(p) < e;
+    }
+    /* Distances to travel before the faces meet and after they part */
+    fixed ad = FIX_ABS(d);
+    fixed near = d > 0 ? -e - p : p - e;
+    fixed far = near + e + e;
+    if (near > ad || far <= 0)
+        return 0;
+    fixed inv = NGRecip(ad);
+    *enter = near <= 0 ? -1 : FIX_MUL(near, inv);
+    *leave = far >= ad ? FIX_ONE + 1 : FIX_MUL(far, inv);
+    return 1;
+}
+
+u8 NGPhysSweepCollision(NGBodyHandle a, NGBodyHandle b, NGCollision *out, fixed *time) {
+    if (!a || !b || !a->active || !b->active)
+        return 0;
+    if (!(a->collision_mask & b->collision_layer) && !(b->collision_mask & a->collision_layer))
+        return 0;
+
+    fixed ahw, ahh, bhw, bhh;
+    body_half_extents(a, &ahw, &ahh);
+    body_half_extents(b, &bhw, &bhh);
+    fixed amx = a->pos.x - a->prev_pos.x, amy = a->pos.y - a->prev_pos.y;
+    fixed bmx = b->pos.x - b->prev_pos.x, bmy = b->pos.y - b->prev_pos.y;
+    fixed px = a->prev_pos.x - b->prev_pos.x;
+    fixed py = a->prev_pos.y - b->prev_pos.y;
+    fixed dx = amx - bmx;
+    fixed dy = amy - bmy;
+
+    fixed enter_x, leave_x, enter_y, leave_y;
+    if (!sweep_axis(px, dx, ahw + bhw, &enter_x, &leave_x) ||
+        !sweep_axis(py, dy, ahh + bhh, &enter_y, &leave_y))
+        return 0;
+    fixed enter = enter_x > enter_y ? enter_x : enter_y;
+    fixed leave = leave_x < leave_y ? leave_x : leave_y;
+    if (enter >= leave)
+        return 0;
+
+    if (enter < 0)
+        enter = 0; /* Overlapping from the start */
+    if (time)
+        *time = enter;
+    if (out) {
+        out->body_a = a;
+        out->body_b = b;
+        if (enter_x < 0 && enter_y < 0) {
+            /* Separate along the shallower axis, as NGPhysTestCollision() does */
+            fixed over_x = ahw + bhw - FIX_ABS(px);
+            fixed over_y = ahh + bhh - FIX_ABS(py);
+            if (over_x < over_y) {
+                out->normal = (NGVec2){px < 0 ? FIX_ONE : -FIX_ONE, 0};
+                out->penetration = over_x;
+            } else {
+                out->normal = (NGVec2){0, py < 0 ? FIX_ONE : -FIX_ONE};
+                out->penetration = over_y;
+            }
+        } else if (enter_x > enter_y) {
+            /* Penetration is the part of the move past first contact */
+            out->normal = (NGVec2){dx > 0 ? FIX_ONE : -FIX_ONE, 0};
+            out->penetration = FIX_MUL(FIX_ABS(dx), FIX_ONE - enter);
+        } else {
+            out->normal = (NGVec2){0, dy > 0 ? FIX_ONE : -FIX_ONE};
+            out->penetration = FIX_MUL(FIX_ABS(dy), FIX_ONE - enter);
+        }
+        fixed ax = a->prev_pos.x + FIX_MUL(amx, enter);
+        fixed ay = a->prev_pos.y + FIX_MUL(amy, enter);
+        fixed bx = b->prev_pos.x + FIX_MUL(bmx, enter);
+        fixed by = b->prev_pos.y + FIX_MUL(bmy, enter);
+        out->contact_point = (NGVec2){(ax + bx) / 2, (ay + by) / 2};
+    }
+    return 1;
+}
+
 u8 NGPhysTestCollision(NGBodyHandle a, NGBodyHandle b, NGCollision *out) {
     if (!a || !b)
         return 0;
@@ -169,13 +400,12 @@ static void resolve_collision(NGCollision *col) {
     NGBody *a = col->body_a;
     NGBody *b = col->body_b;
 
-    u8 a_movable = !(a->flags & (NG_BODY_STATIC | NG_BODY_TRIGGER));
-    u8 b_movable = !(b->flags & (NG_BODY_STATIC | NG_BODY_TRIGGER));
+    /* Trigger pairs never get here (see collide_pair()) */
+    u8 a_movable = !(a->flags & NG_BODY_STATIC);
+    u8 b_movable = !(b->flags & NG_BODY_STATIC);
 
     if (!a_movable && !b_movable)
         return;
-    if ((a->flags & NG_BODY_TRIGGER) || (b->flags & NG_BODY_TRIGGER))
-        return;
 
     // Fast path: equal mass, both movable (avoids FIX_DIV)
     if (a_movable && b_movable && a->mass == b->mass) {
@@ -215,8 +445,8 @@ static void resolve_collision(NGCollision *col) {
     if (total_mass == 0)
         total_mass = FIX_ONE;
 
-    fixed a_ratio = a_movable ? FIX_DIV(b->mass, total_mass) : 0;
-    fixed b_ratio = b_movable ? FIX_DIV(a->mass, total_mass) : 0;
+    fixed a_ratio = a_movable ? FIX_DIV_FAST(b->mass, total_mass) : 0;
+    fixed b_ratio = b_movable ? FIX_DIV_FAST(a->mass, total_mass) : 0;
 
     if (!a_movable)
         b_ratio = FIX_ONE;
@@ -256,7 +486,7 @@ static void resolve_collision(NGCollision *col) {
     fixed inv_mass_sum = inv_mass_a + inv_mass_b;
 
     if (inv_mass_sum > 0) {
-        j = FIX_DIV(j, inv_mass_sum);
+        j = FIX_DIV_FAST(j, inv_mass_sum);
     }
 
     if (a_movable) {
@@ -324,74 +554,488 @@ static void handle_bounds(NGPhysWorld *world, NGBody *body) {
     }
 }
 
-void NGPhysWorldUpdate(NGPhysWorldHandle world, NGCollisionCallback callback, void *callback_data) {
-    if (!world)
+/* ============================================================
+ * Broadphase
+ * ============================================================ */
+
+static inline u8 layers_can_collide(const NGBody *a, const NGBody *b) {
+    return (a->collision_mask & b->collision_layer) || (b->collision_mask & a->collision_layer);
+}
+
+/* Narrowphase for a pair already known to be active and layer-compatible */
+static inline u8 test_pair(NGBody *a, NGBody *b, NGCollision *out) {
+    if (a->shape.type != b->shape.type)
+        return 0;
+    if (a->shape.type == NG_SHAPE_CIRCLE)
+        return test_circle_circle(a, b, out);
+    return test_aabb_aabb(a, b, out);
+}
+
+/* Static and sleeping bodies cannot start a contact on their own */
+#define BODY_INERT (NG_BODY_STATIC | NG_BODY_SLEEPING)
+
+/* Destroyed by a callback and still on the live list: not reusable yet */
+#define BODY_REMOVED 0x80
+
+static inline u8 pair_is_asleep(const NGBody *a, const NGBody *b) {
+    return ((a->flags | b->flags) & NG_BODY_SLEEPING) && (a->flags & BODY_INERT) &&
+           (b->flags & BODY_INERT);
+}
+
+/* Trigger pairs only need a yes or no: no square root, normal or depth.
+ * Mixed shapes use the circle's bounding box. */
+static inline u8 overlap_pair(const NGBody *a, const NGBody *b) {
+    fixed dx = b->pos.x - a->pos.x;
+    fixed dy = b->pos.y - a->pos.y;
+    if (a->shape.type == NG_SHAPE_CIRCLE && b->shape.type == NG_SHAPE_CIRCLE) {
+        fixed radii = a->shape.circle.radius + b->shape.circle.radius;
+        if (FIX_ABS(dx) >= radii || FIX_ABS(dy) >= radii)
+            return 0;
+        return FIX_MUL(dx, dx) + FIX_MUL(dy, dy) < FIX_MUL(radii, radii);
+    }
+    fixed ahw, ahh, bhw, bhh;
+    body_half_extents(a, &ahw, &ahh);
+    body_half_extents(b, &bhw, &bhh);
+    return FIX_ABS(dx) < ahw + bhw && FIX_ABS(dy) < ahh + bhh;
+}
+
+static inline void collide_pair(NGPhysWorld *world, NGBody *a, NGBody *b,
+                                NGCollisionCallback callback, void *callback_data) {
+    u8 la = a->layer_index;
+    u8 lb = b->layer_index;
+    if (world->pair_ignore[la] & (1u << lb))
         return;
 
-    for (int i = 0; i < NG_PHYS_MAX_BODIES; i++) {
-        NGBody *body = &world->bodies[i];
-        if (!body->active)
+    NGCollision col;
+    if ((a->flags | b->flags) & NG_BODY_TRIGGER) {
+        if (!overlap_pair(a, b))
+            return;
+        col.body_a = a;
+        col.body_b = b;
+        col.normal = (NGVec2){0, 0};
+        col.penetration = 0;
+        col.contact_point = (NGVec2){(a->pos.x + b->pos.x) / 2, (a->pos.y + b->pos.y) / 2};
+    } else {
+        if (!test_pair(a, b, &col))
+            return;
+        resolve_collision(&col);
+    }
+
+    /* Contact with an awake body wakes a sleeper */
+    a->flags &= (u8)~NG_BODY_SLEEPING;
+    b->flags &= (u8)~NG_BODY_SLEEPING;
+
+    NGCollisionCallback handler = world->pair_callback[la][lb];
+    if (handler) {
+        if (world->pair_swap[la] & (1u << lb)) {
+            col.body_a = b;
+            col.body_b = a;
+            col.normal.x = -col.normal.x;
+            col.normal.y = -col.normal.y;
+        }
+        handler(&col, world->pair_data[la][lb]);
+    } else if (callback) {
+        callback(&col, callback_data);
+    }
+}
+
+/* Insert every body on the live list into the buckets its AABB covers.
+ * Bodies are numbered by live list position, which is what grid_body holds.
+ * Returns 0 if the entry pool ran out (caller falls back to all pairs). */
+static u8 grid_build(NGPhysWorld *world, u8 count) {
+    u8 shift = world->cell_shift;
+    u16 entries = (u16)(world->capacity * GRID_PER_BODY);
+    u16 used = 0;
+
+    for (u8 b = 0; b < GRID_BUCKETS; b++)
+        grid_head[b] = GRID_NONE;
+
+    for (u8 i = 0; i < count; i++) {
+        NGBody *body = &world->bodies[world->live[i]];
+        tested_with[i] = 0;
+
+        fixed half_w, half_h;
+        if (body->shape.type == NG_SHAPE_CIRCLE) {
+            half_w = half_h = body->shape.circle.radius;
+        } else {
+            half_w = body->shape.aabb.half_width;
+            half_h = body->shape.aabb.half_height;
+        }
+
+        s16 x0 = (s16)(FIX_INT(body->pos.x - half_w) >> shift);
+        s16 x1 = (s16)(FIX_INT(body->pos.x + half_w) >> shift);
+        s16 y0 = (s16)(FIX_INT(body->pos.y - half_h) >> shift);
+        s16 y1 = (s16)(FIX_INT(body->pos.y + half_h) >> shift);
+
+        /* Spans wider than the bucket grid would revisit the same buckets */
+        s16 w = (s16)(x1 - x0 + 1);
+        s16 h = (s16)(y1 - y0 + 1);
+        cell_x0[i] = x0;
+        cell_y0[i] = y0;
+        cell_w[i] = (u8)(w > GRID_DIM ? GRID_DIM : w);
+        cell_h[i] = (u8)(h > GRID_DIM ? GRID_DIM : h);
+
+        for (u8 cy = 0; cy < cell_h[i]; cy++) {
+            u8 row = (u8)(((y0 + cy) & GRID_MASK) * GRID_DIM);
+            for (u8 cx = 0; cx < cell_w[i]; cx++) {
+                if (used >= entries)
+                    return 0;
+                u8 bucket = (u8)(row + ((x0 + cx) & GRID_MASK));
+                grid_body[used] = i;
+                grid_next[used] = grid_head[bucket];
+                grid_head[bucket] = used;
+                used++;
+            }
+        }
+    }
+    return 1;
+}
+
+static void collide_grid(NGPhysWorld *world, u8 count, NGCollisionCallback callback,
+                         void *callback_data) {
+    for (u8 i = 0; i < count; i++) {
+        NGBody *a = &world->bodies[world->live[i]];
+
+        u8 stamp = (u8)(i + 1);
+        for (u8 cy = 0; cy < cell_h[i]; cy++) {
+            u8 row = (u8)(((cell_y0[i] + cy) & GRID_MASK) * GRID_DIM);
+            for (u8 cx = 0; cx < cell_w[i]; cx++) {
+                u8 bucket = (u8)(row + ((cell_x0[i] + cx) & GRID_MASK));
+
+                for (u16 e = grid_head[bucket]; e != GRID_NONE; e = grid_next[e]) {
+                    u8 j = grid_body[e];
+                    /* Lower indices already tested this pair from their side */
+                    if (j <= i || tested_with[j] == stamp)
+                        continue;
+                    tested_with[j] = stamp;
+
+                    /* A callback may have destroyed either body */
+                    NGBody *b = &world->bodies[world->live[j]];
+                    if (!a->active || !b->active || !layers_can_collide(a, b) ||
+                        pair_is_asleep(a, b))
+                        continue;
+                    collide_pair(world, a, b, callback, callback_data);
+                }
+            }
+        }
+    }
+}
+
+static void collide_all_pairs(NGPhysWorld *world, u8 count, NGCollisionCallback callback,
+                              void *callback_data) {
+    for (u8 i = 0; i < count; i++) {
+        NGBody *a = &world->bodies[world->live[i]];
+
+        for (u8 j = (u8)(i + 1); j < count && a->active; j++) {
+            NGBody *b = &world->bodies[world->live[j]];
+            if (!b->active || !layers_can_collide(a, b) || pair_is_asleep(a, b))
+                continue;
+            collide_pair(world, a, b, callback, callback_data);
+        }
+    }
+}
+
+/* ============================================================
+ * Live List
+ * ============================================================ */
+
+static void live_remove(NGPhysWorld *world, NGBody *body) {
+    u8 last = world->live[--world->live_count];
+    world->live[body->live_index] = last;
+    world->bodies[last].live_index = body->live_index;
+}
+
+/* Drop bodies destroyed by callbacks, once nothing is walking the list */
+static void live_compact(NGPhysWorld *world) {
+    u8 i = 0;
+    while (i < world->live_count) {
+        NGBody *body = &world->bodies[world->live[i]];
+        if (body->active) {
+            i++;
+        } else {
+            body->flags = 0;
+            live_remove(world, body); /* Brings the last entry to i */
+        }
+    }
+    world->removed = 0;
+}
+
+/* ============================================================
+ * Terrain
+ * ============================================================ */
+
+/* Velocities are per 60 Hz frame; a step covers world->step frames */
+static inline fixed step_scale(const NGPhysWorld *world, fixed v) {
+    return world->step == FIX_ONE ? v : FIX_MUL(v, world->step);
+}
+
+/* Gather the bodies moving against terrain into frame-arena arrays and
+ * resolve them as one batch. Without the arena space they go one by one. */
+static void move_against_terrain(NGPhysWorld *world, u8 count) {
+    NGArenaMark mark = NGArenaSave(&ng_arena_frame);
+    u8 *index = NG_ARENA_ALLOC_ARRAY(&ng_arena_frame, u8, count);
+    fixed *soa = NG_ARENA_ALLOC_ARRAY(&ng_arena_frame, fixed, (u16)count * 6);
+    u8 *result = NG_ARENA_ALLOC_ARRAY(&ng_arena_frame, u8, count);
+
+    NGTerrainBatch batch = {0};
+    fixed *half_w = 0, *half_h = 0;
+    if (index && soa && result) {
+        half_w = soa + count * 2;
+        half_h = soa + count * 3;
+        batch.x = soa;
+        batch.y = soa + count;
+        batch.half_w = half_w;
+        batch.half_h = half_h;
+        batch.vel_x = soa + count * 4;
+        batch.vel_y = soa + count * 5;
+        batch.result = result;
+    }
+
+    for (u8 i = 0; i < count; i++) {
+        NGBody *body = &world->bodies[world->live[i]];
+        if (body->flags & BODY_INERT)
             continue;
-        if (body->flags & NG_BODY_STATIC)
+        body->terrain_hit = NG_COLL_NONE;
+        fixed dx = step_scale(world, body->vel.x);
+        fixed dy = step_scale(world, body->vel.y);
+        if (body->flags & NG_BODY_TRIGGER) {
+            body->pos.x += dx;
+            body->pos.y += dy;
             continue;
+        }
 
-        if (!(body->flags & NG_BODY_NO_GRAVITY)) {
-            body->vel.x += world->gravity.x;
-            body->vel.y += world->gravity.y;
+        fixed hw, hh;
+        body_half_extents(body, &hw, &hh);
+        if (!batch.x) {
+            body->terrain_hit =
+                NGTerrainResolveAABB(world->terrain, &body->pos.x, &body->pos.y, hw, hh, &dx, &dy);
+            if (!dx)
+                body->vel.x = 0;
+            if (!dy)
+                body->vel.y = 0;
+            continue;
         }
+        u8 n = batch.count++;
+        index[n] = world->live[i];
+        batch.x[n] = body->pos.x;
+        batch.y[n] = body->pos.y;
+        half_w[n] = hw;
+        half_h[n] = hh;
+        batch.vel_x[n] = dx;
+        batch.vel_y[n] = dy;
+    }
 
-        body->vel.x += body->accel.x;
-        body->vel.y += body->accel.y;
+    if (batch.count) {
+        NGTerrainResolveBatch(world->terrain, &batch);
+        for (u8 n = 0; n < batch.count; n++) {
+            NGBody *body = &world->bodies[index[n]];
+            body->pos.x = batch.x[n];
+            body->pos.y = batch.y[n];
+            /* The resolver only zeroes the move on contact */
+            if (!batch.vel_x[n])
+                body->vel.x = 0;
+            if (!batch.vel_y[n])
+                body->vel.y = 0;
+            body->terrain_hit = result[n];
+        }
+    }
+    NGArenaRestore(&ng_arena_frame, mark);
+}
 
-        body->pos.x += body->vel.x;
-        body->pos.y += body->vel.y;
+/* Compare the watched flags under each moving body with its last pass.
+ * Without arena space nothing is recorded and changes show up next time. */
+static void emit_tile_events(NGPhysWorld *world, u8 count, u8 watchers) {
+    u8 kept = world->tile_event_count;
+    if (kept + watchers > 0xFF)
+        return;
+    NGTileEvent *events = NG_ARENA_ALLOC_ARRAY(&ng_arena_frame, NGTileEvent, kept + watchers);
+    if (!events)
+        return;
+    /* A frame running several steps keeps the earlier steps' events */
+    for (u8 i = 0; i < kept; i++)
+        events[i] = world->tile_events[i];
+    world->tile_events = events;
+
+    for (u8 i = 0; i < count; i++) {
+        NGBody *body = &world->bodies[world->live[i]];
+        if (!body->tile_watch || (body->flags & BODY_INERT))
+            continue;
+        fixed hw, hh;
+        u8 flags = 0;
+        body_half_extents(body, &hw, &hh);
+        /* Resolved boxes stop one unit short of a tile: grow by that to count contact */
+        NGTerrainTestAABB(world->terrain, body->pos.x, body->pos.y, hw + 1, hh + 1, &flags);
+        flags &= body->tile_watch;
+        if (flags == body->tile_touch)
+            continue;
+        NGTileEvent *ev = &events[world->tile_event_count++];
+        ev->body = body;
+        ev->entered = flags & ~body->tile_touch;
+        ev->exited = body->tile_touch & ~flags;
+        body->tile_touch = flags;
     }
+}
+
+/* ============================================================
+ * Sleeping
+ * ============================================================ */
+
+static void update_sleep(NGPhysWorld *world) {
+    fixed limit = world->sleep_velocity;
+
+    for (u8 i = 0; i < world->live_count; i++) {
+        NGBody *body = &world->bodies[world->live[i]];
+        if (body->flags & BODY_INERT)
+            continue;
 
+        if (FIX_ABS(body->vel.x) > limit || FIX_ABS(body->vel.y) > limit) {
+            body->rest_frames = 0;
+            continue;
+        }
+
+        if (++body->rest_frames >= world->sleep_frames) {
+            body->flags |= NG_BODY_SLEEPING;
+            body->vel = (NGVec2){0, 0};
+        }
+    }
+}
+
+static void world_step(NGPhysWorld *world, NGCollisionCallback callback, void *callback_data) {
+    u8 count = world->live_count;
     u8 any_can_collide = 0;
-    for (int i = 0; i < NG_PHYS_MAX_BODIES && !any_can_collide; i++) {
-        if (world->bodies[i].active && world->bodies[i].collision_mask) {
+    u8 watchers = 0;
+    u8 scaled = world->step != FIX_ONE;
+
+    for (u8 i = 0; i < count; i++) {
+        NGBody *body = &world->bodies[world->live[i]];
+        body->prev_pos = body->pos;
+        if (body->collision_mask)
             any_can_collide = 1;
+        if (body->flags & BODY_INERT)
+            continue;
+        if (body->tile_watch)
+            watchers++;
+
+        fixed ax = body->accel.x;
+        fixed ay = body->accel.y;
+        if (!(body->flags & NG_BODY_NO_GRAVITY)) {
+            ax += world->gravity.x;
+            ay += world->gravity.y;
         }
+        if (scaled) {
+            ax = FIX_MUL(ax, world->step);
+            ay = FIX_MUL(ay, world->step);
+        }
+        body->vel.x += ax;
+        body->vel.y += ay;
+
+        if (world->terrain == NG_TERRAIN_INVALID) {
+            body->pos.x += step_scale(world, body->vel.x);
+            body->pos.y += step_scale(world, body->vel.y);
+        }
+    }
+    if (world->terrain != NG_TERRAIN_INVALID) {
+        move_against_terrain(world, count);
+        if (watchers)
+            emit_tile_events(world, count, watchers);
     }
 
+    /* Bodies created by a callback join the live list past count and are
+     * handled from the next update on; destroyed ones stay on it until then */
     if (any_can_collide || callback) {
-        for (int i = 0; i < NG_PHYS_MAX_BODIES; i++) {
-            if (!world->bodies[i].active)
-                continue;
+        world->updating = 1;
+        if (grid_build(world, count)) {
+            collide_grid(world, count, callback, callback_data);
+        } else {
+            collide_all_pairs(world, count, callback, callback_data);
+        }
+        world->updating = 0;
+        if (world->removed)
+            live_compact(world);
+    }
 
-            for (int j = i + 1; j < NG_PHYS_MAX_BODIES; j++) {
-                if (!world->bodies[j].active)
-                    continue;
+    if (world->bounds_enabled) {
+        for (u8 i = 0; i < world->live_count; i++) {
+            handle_bounds(world, &world->bodies[world->live[i]]);
+        }
+    }
 
-                NGCollision col;
-                if (NGPhysTestCollision(&world->bodies[i], &world->bodies[j], &col)) {
-                    resolve_collision(&col);
+    if (world->sleep_velocity > 0)
+        update_sleep(world);
 
-                    if (callback) {
-                        callback(&col, callback_data);
-                    }
-                }
-            }
-        }
+    for (u8 i = 0; i < world->live_count; i++) {
+        NGBody *body = &world->bodies[world->live[i]];
+        body->moved = body->pos.x != body->prev_pos.x || body->pos.y != body->prev_pos.y;
     }
+}
 
-    for (int i = 0; i < NG_PHYS_MAX_BODIES; i++) {
-        if (!world->bodies[i].active)
-            continue;
-        handle_bounds(world, &world->bodies[i]);
+void NGPhysWorldAdvance(NGPhysWorldHandle world, u8 frames, NGCollisionCallback callback,
+                        void *callback_data) {
+    if (!world)
+        return;
+
+    world->tile_events = 0;
+    world->tile_event_count = 0;
+
+    /* Slowdown beyond NG_PHYS_MAX_STEPS is dropped rather than caught up */
+    world->accumulator += FIX(frames);
+    for (u8 steps = 0; world->accumulator >= world->step; steps++) {
+        if (steps == NG_PHYS_MAX_STEPS) {
+            world->accumulator = world->step - FIX_ONE;
+            break;
+        }
+        world_step(world, callback, callback_data);
+        world->accumulator -= world->step;
     }
+
+    /* Draw one frame behind the accumulator, so a 60 Hz step shows pos */
+    fixed alpha = FIX_MUL(world->accumulator + FIX_ONE, world->inv_step);
+    world->alpha = alpha < FIX_ONE ? alpha : FIX_ONE;
 }
 
-static NGBody *alloc_body(NGPhysWorldHandle world) {
+void NGPhysWorldUpdate(NGPhysWorldHandle world, NGCollisionCallback callback, void *callback_data) {
+    NGPhysWorldAdvance(world, 1, callback, callback_data);
+}
+
+void NGPhysWorldSetStepRate(NGPhysWorldHandle world, u8 hz) {
     if (!world)
+        return;
+    if (hz == 0 || hz > 60)
+        hz = 60;
+    world->step = (fixed)(((u32)60 << 16) / hz);
+    world->inv_step = (fixed)(((u32)hz << 16) / 60);
+    world->accumulator = 0;
+    world->alpha = FIX_ONE;
+}
+
+NGVec2 NGPhysBodyGetDrawPos(NGBodyHandle body) {
+    if (!body)
+        return (NGVec2){0, 0};
+    fixed alpha = g_world.alpha;
+    if (alpha == FIX_ONE)
+        return body->pos;
+    return (NGVec2){body->prev_pos.x + FIX_MUL(body->pos.x - body->prev_pos.x, alpha),
+                    body->prev_pos.y + FIX_MUL(body->pos.y - body->prev_pos.y, alpha)};
+}
+
+const NGTileEvent *NGPhysWorldGetTileEvents(NGPhysWorldHandle world, u8 *count_out) {
+    u8 count = world ? world->tile_event_count : 0;
+    if (count_out)
+        *count_out = count;
+    return count ? world->tile_events : 0;
+}
+
+static NGBody *alloc_body(NGPhysWorldHandle world) {
+    if (!world || world->live_count >= world->capacity)
         return 0;
 
-    for (int i = 0; i < NG_PHYS_MAX_BODIES; i++) {
-        if (!world->bodies[i].active) {
+    for (u8 i = 0; i < world->capacity; i++) {
+        if (!world->bodies[i].active && !(world->bodies[i].flags & BODY_REMOVED)) {
             NGBody *body = &world->bodies[i];
             body->active = 1;
             body->flags = 0;
             body->pos = (NGVec2){0, 0};
+            body->prev_pos = body->pos;
             body->vel = (NGVec2){0, 0};
             body->accel = (NGVec2){0, 0};
             body->mass = FIX_ONE;
@@ -399,7 +1043,14 @@ static NGBody *alloc_body(NGPhysWorldHandle world) {
             body->restitution = FIX_ONE;
             body->collision_layer = 0x01;
             body->collision_mask = 0xFF;
+            body->layer_index = 0;
+            body->rest_frames = 0;
+            body->terrain_hit = NG_COLL_NONE;
+            body->tile_watch = 0;
+            body->tile_touch = 0;
             body->user_data = 0;
+            body->live_index = world->live_count;
+            world->live[world->live_count++] = i;
             return body;
         }
     }
@@ -413,6 +1064,8 @@ NGBodyHandle NGPhysBodyCreateCircle(NGPhysWorldHandle world, fixed x, fixed y, f
 
     body->pos.x = x;
     body->pos.y = y;
+    body->prev_pos = body->pos;
+    body->moved = 1;
     body->shape.type = NG_SHAPE_CIRCLE;
     body->shape.circle.radius = radius;
 
@@ -427,6 +1080,8 @@ NGBodyHandle NGPhysBodyCreateAABB(NGPhysWorldHandle world, fixed x, fixed y, fix
 
     body->pos.x = x;
     body->pos.y = y;
+    body->prev_pos = body->pos;
+    body->moved = 1;
     body->shape.type = NG_SHAPE_AABB;
     body->shape.aabb.half_width = half_width;
     body->shape.aabb.half_height = half_height;
@@ -435,16 +1090,24 @@ NGBodyHandle NGPhysBodyCreateAABB(NGPhysWorldHandle world, fixed x, fixed y, fix
 }
 
 void NGPhysBodyDestroy(NGBodyHandle body) {
-    if (body) {
-        body->active = 0;
-    }
+    if (!body || !body->active)
+        return;
+    body->active = 0;
+    if (g_world.updating) {
+        body->flags = BODY_REMOVED;
+        g_world.removed = 1;
+    } else
+        live_remove(&g_world, body);
 }
 
 void NGPhysBodySetPos(NGBodyHandle body, fixed x, fixed y) {
     if (!body)
         return;
+    NGPhysBodyWake(body);
     body->pos.x = x;
     body->pos.y = y;
+    body->prev_pos = body->pos;
+    body->moved = 1;
 }
 
 NGVec2 NGPhysBodyGetPos(NGBodyHandle body) {
@@ -456,6 +1119,7 @@ NGVec2 NGPhysBodyGetPos(NGBodyHandle body) {
 void NGPhysBodySetVel(NGBodyHandle body, fixed vx, fixed vy) {
     if (!body)
         return;
+    NGPhysBodyWake(body);
     body->vel.x = vx;
     body->vel.y = vy;
 }
@@ -469,6 +1133,7 @@ NGVec2 NGPhysBodyGetVel(NGBodyHandle body) {
 void NGPhysBodySetAccel(NGBodyHandle body, fixed ax, fixed ay) {
     if (!body)
         return;
+    NGPhysBodyWake(body);
     body->accel.x = ax;
     body->accel.y = ay;
 }
@@ -477,7 +1142,7 @@ void NGPhysBodySetMass(NGBodyHandle body, fixed mass) {
     if (!body)
         return;
     body->mass = mass;
-    body->inv_mass = (mass > 0) ? FIX_DIV(FIX_ONE, mass) : 0;
+    body->inv_mass = (mass > 0) ? NGRecip(mass) : 0;
 }
 
 void NGPhysBodySetRestitution(NGBodyHandle body, fixed restitution) {
@@ -507,6 +1172,19 @@ void NGPhysBodySetLayer(NGBodyHandle body, u8 layer, u8 mask) {
         return;
     body->collision_layer = layer;
     body->collision_mask = mask;
+    u8 index = 0;
+    while (index < NG_PHYS_LAYERS - 1 && layer && !(layer & 1)) {
+        layer >>= 1;
+        index++;
+    }
+    body->layer_index = index;
+}
+
+void NGPhysBodyWatchTiles(NGBodyHandle body, u8 flags) {
+    if (!body)
+        return;
+    body->tile_watch = flags;
+    body->tile_touch &= flags;
 }
 
 void NGPhysBodySetUserData(NGBodyHandle body, void *data) {
@@ -527,6 +1205,20 @@ void NGPhysBodyApplyImpulse(NGBodyHandle body, fixed ix, fixed iy) {
     if (body->flags & NG_BODY_STATIC)
         return;
 
+    NGPhysBodyWake(body);
     body->vel.x += FIX_MUL(ix, body->inv_mass);
     body->vel.y += FIX_MUL(iy, body->inv_mass);
 }
+
+u8 NGPhysBodyIsSleeping(NGBodyHandle body) {
+    if (!body)
+        return 0;
+    return (body->flags & NG_BODY_SLEEPING) ? 1 : 0;
+}
+
+void NGPhysBodyWake(NGBodyHandle body) {
+    if (!body)
+        return;
+    body->flags &= (u8)~NG_BODY_SLEEPING;
+    body->rest_frames = 0;
+}
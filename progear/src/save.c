@@ -0,0 +1,267 @@
+/*
+ * This file is part of ProGearSDK.
+ * Copyright (c) 2024-2025 ProGearSDK contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <save.h>
+#include <ng_arena.h>
+#include <ng_memcard.h>
+#include <ng_sram.h>
+#include <ng_string.h>
+#include <ng_tables.h>
+
+#include "sdk_internal.h"
+
+/* Slot header: magic, then the fields the CRC covers, then the CRC */
+#define HEAD_MAGIC    0
+#define HEAD_SEQUENCE 2
+#define HEAD_VERSION  4
+#define HEAD_SIZE     6
+#define HEAD_CRC      8
+
+#define MAGIC_0 'P'
+#define MAGIC_1 'G'
+
+#define PAGES(bytes)       (((bytes) + NG_SAVE_PAGE - 1) / NG_SAVE_PAGE)
+#define BITMAP_BYTES(bits) (((bits) + 7) / 8)
+
+static u8 *data;
+static u8 *shadow; /* Contents of the newest slot */
+static u8 *stale;  /* Pages where the older slot differs from the shadow */
+static u8 *dirty;  /* Pages where the data differs from the shadow, during a commit */
+static u16 size;
+static u16 area;
+static u16 version;
+static u16 loaded_version;
+static u16 sequence; /* Sequence number of the newest slot */
+static u8 device;
+static u8 newest;
+static u8 unknown; /* Nothing was loaded, so neither slot matches the shadow */
+
+u8 _NGSaveSystemAlloc(NGArena *arena, u16 save_size) {
+    data = NULL;
+    size = save_size;
+    if (!size)
+        return 1;
+
+    u16 bitmap = (u16)BITMAP_BYTES(PAGES(size));
+    shadow = NG_ARENA_ALLOC_ARRAY(arena, u8, size);
+    stale = NG_ARENA_ALLOC_ARRAY(arena, u8, bitmap);
+    dirty = NG_ARENA_ALLOC_ARRAY(arena, u8, bitmap);
+    if (!shadow || !stale || !dirty) {
+        size = 0;
+        return 0;
+    }
+    return 1;
+}
+
+static u16 get16(const u8 *p) {
+    return (u16)(p[0] << 8 | p[1]);
+}
+
+static void put16(u8 *p, u16 value) {
+    p[0] = (u8)(value >> 8);
+    p[1] = (u8)value;
+}
+
+static u16 crc16(u16 crc, const u8 *p, u16 length) {
+    while (length--)
+        crc = (u16)(crc << 8) ^ ng_crc16_table[(u8)(crc >> 8) ^ *p++];
+    return crc;
+}
+
+static u8 bit_test(const u8 *bitmap, u16 i) {
+    return bitmap[i >> 3] & (1 << (i & 7));
+}
+
+static u16 page_length(u16 page) {
+    u16 left = (u16)(size - page * NG_SAVE_PAGE);
+    return left < NG_SAVE_PAGE ? left : NG_SAVE_PAGE;
+}
+
+static u16 slot_offset(u8 slot) {
+    return (u16)(area + slot * (NG_SAVE_HEADER + size));
+}
+
+static void read_bytes(u16 offset, void *buffer, u16 length) {
+    if (device == NG_SAVE_MEMCARD)
+        NGMemcardRead(offset, buffer, length);
+    else
+        NGSramReadBlock(offset, buffer, length);
+}
+
+static u8 write_bytes(u16 offset, const void *buffer, u16 length) {
+    if (device == NG_SAVE_MEMCARD)
+        return NGMemcardWrite(offset, buffer, length) == length;
+    NGSramWriteBlock(offset, buffer, length);
+    return 1;
+}
+
+/* Read a slot's header and check its magic, size and CRC, streaming the
+ * data through a page buffer */
+static u8 check_slot(u8 slot, u8 *head) {
+    u16 offset = slot_offset(slot);
+    read_bytes(offset, head, NG_SAVE_HEADER);
+    if (head[HEAD_MAGIC] != MAGIC_0 || head[HEAD_MAGIC + 1] != MAGIC_1 ||
+        get16(head + HEAD_SIZE) != size)
+        return 0;
+
+    u16 crc = crc16(0xFFFF, head + HEAD_SEQUENCE, HEAD_CRC - HEAD_SEQUENCE);
+    offset += NG_SAVE_HEADER;
+    for (u16 p = 0; p < PAGES(size); p++) {
+        u8 page[NG_SAVE_PAGE];
+        u16 length = page_length(p);
+        read_bytes((u16)(offset + p * NG_SAVE_PAGE), page, length);
+        crc = crc16(crc, page, length);
+    }
+    return crc == get16(head + HEAD_CRC);
+}
+
+/* Mark the pages where a valid older slot differs from the shadow */
+static void compare_slot(u8 slot) {
+    u16 offset = (u16)(slot_offset(slot) + NG_SAVE_HEADER);
+    memset(stale, 0, BITMAP_BYTES(PAGES(size)));
+    for (u16 p = 0; p < PAGES(size); p++) {
+        u8 page[NG_SAVE_PAGE];
+        u16 length = page_length(p);
+        const u8 *own = shadow + p * NG_SAVE_PAGE;
+        read_bytes((u16)(offset + p * NG_SAVE_PAGE), page, length);
+        for (u16 i = 0; i < length; i++) {
+            if (page[i] != own[i]) {
+                stale[p >> 3] |= (u8)(1 << (p & 7));
+                break;
+            }
+        }
+    }
+}
+
+NGSaveResult NGSaveOpen(NGSaveDevice save_device, u16 offset, void *save_data, u16 save_version) {
+    data = NULL;
+    device = (u8)save_device;
+    area = offset;
+    version = save_version;
+    loaded_version = 0;
+    if (!size || (device == NG_SAVE_MEMCARD && !NGMemcardIsPresent()))
+        return NG_SAVE_FAILED;
+    data = save_data;
+
+    /* Until a slot is known to match the shadow, every page is stale */
+    memset(stale, 0xFF, BITMAP_BYTES(PAGES(size)));
+
+    u8 head[2][NG_SAVE_HEADER];
+    u8 valid0 = check_slot(0, head[0]);
+    u8 valid1 = check_slot(1, head[1]);
+    if (!valid0 && !valid1) {
+        newest = 1; /* First commit goes to slot 0 */
+        sequence = 0;
+        unknown = 1;
+        return NG_SAVE_EMPTY;
+    }
+
+    if (valid0 && valid1)
+        newest = (s16)(get16(head[1] + HEAD_SEQUENCE) - get16(head[0] + HEAD_SEQUENCE)) > 0;
+    else
+        newest = valid1;
+    sequence = get16(head[newest] + HEAD_SEQUENCE);
+    loaded_version = get16(head[newest] + HEAD_VERSION);
+    unknown = 0;
+
+    read_bytes((u16)(slot_offset(newest) + NG_SAVE_HEADER), shadow, size);
+    memcpy(data, shadow, size);
+    if (valid0 && valid1)
+        compare_slot((u8)(newest ^ 1));
+
+    return loaded_version == version ? NG_SAVE_LOADED : NG_SAVE_OTHER_VERSION;
+}
+
+/* Mark the pages that differ from the shadow; return 1 if any do */
+static u8 find_dirty(void) {
+    u8 any = 0;
+    memset(dirty, 0, BITMAP_BYTES(PAGES(size)));
+    for (u16 p = 0; p < PAGES(size); p++) {
+        const u8 *own = data + p * NG_SAVE_PAGE;
+        const u8 *kept = shadow + p * NG_SAVE_PAGE;
+        u16 length = page_length(p);
+        u16 i = 0;
+        if (!unknown) {
+            while (i < length && own[i] == kept[i])
+                i++;
+            if (i == length)
+                continue;
+        }
+        dirty[p >> 3] |= (u8)(1 << (p & 7));
+        any = 1;
+    }
+    return any;
+}
+
+u8 NGSaveCommit(void) {
+    if (!data)
+        return 0;
+    if (device == NG_SAVE_MEMCARD && NGMemcardIsWriteProtected())
+        return 0; /* Also when the card was pulled */
+    if (!find_dirty())
+        return 1;
+
+    u8 slot = (u8)(newest ^ 1);
+    u16 offset = slot_offset(slot);
+    u8 head[NG_SAVE_HEADER];
+    put16(head + HEAD_MAGIC, (u16)(MAGIC_0 << 8 | MAGIC_1));
+    put16(head + HEAD_SEQUENCE, (u16)(sequence + 1));
+    put16(head + HEAD_VERSION, version);
+    put16(head + HEAD_SIZE, size);
+    u16 crc = crc16(0xFFFF, head + HEAD_SEQUENCE, HEAD_CRC - HEAD_SEQUENCE);
+    put16(head + HEAD_CRC, crc16(crc, data, size));
+
+    if (device == NG_SAVE_SRAM)
+        NGSramUnlock();
+
+    /* Invalidate the slot, write its pages, then its header with the magic last */
+    static const u8 cleared = 0;
+    u8 ok = write_bytes(offset, &cleared, 1);
+    for (u16 p = 0; ok && p < PAGES(size); p++) {
+        if (bit_test(dirty, p) || bit_test(stale, p)) {
+            u16 at = (u16)(p * NG_SAVE_PAGE);
+            ok = write_bytes((u16)(offset + NG_SAVE_HEADER + at), data + at, page_length(p));
+        }
+    }
+    ok = ok && write_bytes((u16)(offset + HEAD_SEQUENCE), head + HEAD_SEQUENCE,
+                           NG_SAVE_HEADER - HEAD_SEQUENCE);
+    ok = ok && write_bytes(offset, head, HEAD_SEQUENCE);
+
+    if (device == NG_SAVE_SRAM)
+        NGSramLock();
+
+    u16 bitmap = (u16)BITMAP_BYTES(PAGES(size));
+    if (!ok) {
+        /* The older slot may now hold some of the new pages */
+        for (u16 i = 0; i < bitmap; i++)
+            stale[i] |= dirty[i];
+        return 0;
+    }
+
+    for (u16 p = 0; p < PAGES(size); p++) {
+        if (bit_test(dirty, p)) {
+            u16 at = (u16)(p * NG_SAVE_PAGE);
+            memcpy(shadow + at, data + at, page_length(p));
+        }
+    }
+    /* The slot just replaced is now the older one and differs where this commit wrote */
+    if (unknown)
+        memset(stale, 0xFF, bitmap);
+    else
+        memcpy(stale, dirty, bitmap);
+    unknown = 0;
+    newest = slot;
+    sequence++;
+    return 1;
+}
+
+u8 NGSaveChanged(void) {
+    return data && find_dirty();
+}
+
+u16 NGSaveGetLoadedVersion(void) {
+    return loaded_version;
+}
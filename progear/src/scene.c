@@ -9,26 +9,46 @@
 #include <backdrop.h>
 #include <terrain.h>
 #include <camera.h>
+#include <particles.h>
 #include <graphic.h>
+#include <engine.h>
+#include <ng_profile.h>
+#include <ng_raster.h>
 
 #include "sdk_internal.h"
 
 static u8 scene_initialized;
 
+/* Set while the raster table on screen was submitted by the scene */
+static u8 raster_owned;
+
 // Scene terrain state
 static NGTerrainHandle scene_terrain = NG_TERRAIN_INVALID;
 static u8 terrain_z;
 static u8 terrain_in_scene;
 
+// Next scene while it is staged, and its terrain
+static u8 staging;
+static NGTerrainHandle staged_terrain = NG_TERRAIN_INVALID;
+
 void NGSceneInit(void) {
     NGGraphicSystemInit();
     _NGActorSystemInit();
     _NGBackdropSystemInit();
     _NGTerrainSystemInit();
+    _NGParticlesSystemInit();
+    _NGWidgetsReserveSprites();
+    _NGSpriteTextSystemInit();
+    if (raster_owned) {
+        NGRasterClear();
+        raster_owned = 0;
+    }
 
     scene_terrain = NG_TERRAIN_INVALID;
     terrain_z = 0;
     terrain_in_scene = 0;
+    staging = 0;
+    staged_terrain = NG_TERRAIN_INVALID;
 
     scene_initialized = 1;
 }
@@ -37,8 +57,15 @@ void NGSceneUpdate(void) {
     if (!scene_initialized)
         return;
 
+    NG_PROFILE_BEGIN(NG_PROF_CAMERA);
     NGCameraUpdate();
+    NG_PROFILE_END(NG_PROF_CAMERA);
+
+    NG_PROFILE_BEGIN(NG_PROF_ACTORS);
     _NGActorSystemUpdate();
+    NG_PROFILE_END(NG_PROF_ACTORS);
+
+    NGParticlesUpdate();
 }
 
 void NGSceneDraw(void) {
@@ -46,37 +73,121 @@ void NGSceneDraw(void) {
         return;
 
     /* Sync all scene objects to their graphics */
+    NG_PROFILE_BEGIN(NG_PROF_SYNC_BACKDROP);
     _NGBackdropSyncGraphics();
+    NG_PROFILE_END(NG_PROF_SYNC_BACKDROP);
+
+    NG_PROFILE_BEGIN(NG_PROF_SYNC_TERRAIN);
     _NGTerrainSyncGraphics();
+    NG_PROFILE_END(NG_PROF_SYNC_TERRAIN);
+
+    NG_PROFILE_BEGIN(NG_PROF_SYNC_ACTORS);
     _NGActorSyncGraphics();
+    NG_PROFILE_END(NG_PROF_SYNC_ACTORS);
 
     /* Graphics system handles all rendering */
+    NG_PROFILE_BEGIN(NG_PROF_GRAPHIC_DRAW);
     NGGraphicSystemDraw();
+    u8 raster = _NGParticlesDraw();
+    _NGSpriteTextDraw();
+    NG_PROFILE_END(NG_PROF_GRAPHIC_DRAW);
+
+    /* Band scroll needs this frame's sprite allocation */
+    raster |= _NGBackdropAddRaster();
+    if (raster || raster_owned) {
+        /* Once nothing needs it, one more submit keeps any entries game
+         * code added and stops replaying the last table */
+        NGRasterSubmit();
+        raster_owned = raster;
+    }
 }
 
 void NGSceneReset(void) {
-    for (s8 i = 0; i < NG_ACTOR_MAX; i++) {
-        NGActorDestroy(i);
-    }
-
-    for (s8 i = 0; i < NG_BACKDROP_MAX; i++) {
-        NGBackdropDestroy(i);
-    }
+    _NGActorDestroyAll(0);
+    _NGBackdropDestroyAll(0);
 
-    // Clear terrain
+    // Clear terrain, and the staged one
     if (scene_terrain != NG_TERRAIN_INVALID) {
         NGTerrainDestroy(scene_terrain);
         scene_terrain = NG_TERRAIN_INVALID;
         terrain_in_scene = 0;
     }
+    if (staged_terrain != NG_TERRAIN_INVALID) {
+        NGTerrainDestroy(staged_terrain);
+        staged_terrain = NG_TERRAIN_INVALID;
+    }
+    staging = 0;
 
     // Reset graphics system
     NGGraphicSystemReset();
+    _NGWidgetsReleaseGraphics();
+    _NGParticlesReset();
+    _NGSpriteTextReset();
+}
+
+/* === Staged Loading === */
+
+void NGSceneStageBegin(void) {
+    if (!scene_initialized || staging)
+        return;
+    staging = 1;
+    _NGGraphicStageBegin();
+}
+
+u8 NGSceneIsStaging(void) {
+    return staging;
+}
+
+u8 NGSceneStageIsReady(void) {
+    return staging && !_NGGraphicStagePending() && NGTerrainIsWarm(staged_terrain);
+}
+
+void NGSceneStageSwap(void) {
+    if (!staging)
+        return;
+
+    // Hiding the current scene's sprites and writing the next one's SCB3
+    // is all the swap costs; their tiles are already in VRAM
+    _NGActorDestroyAll(1);
+    _NGBackdropDestroyAll(1);
+    if (scene_terrain != NG_TERRAIN_INVALID)
+        NGTerrainDestroy(scene_terrain);
+    scene_terrain = staged_terrain;
+    staged_terrain = NG_TERRAIN_INVALID;
+    terrain_in_scene = (scene_terrain != NG_TERRAIN_INVALID);
+    terrain_z = 0;
+    NGParticlesClear();
+
+    _NGGraphicStageCommit();
+    staging = 0;
+}
+
+NGTerrainHandle NGSceneGetStagedTerrain(void) {
+    return staged_terrain;
 }
 
 /* === Terrain API Implementation === */
 
+/* Create a terrain at the origin, in the scene and visible */
+static NGTerrainHandle add_terrain(const struct NGTerrainAsset *asset) {
+    NGTerrainHandle handle = NGTerrainCreate(asset);
+    if (handle != NG_TERRAIN_INVALID) {
+        // Add to scene at origin - this sets tm->in_scene flag needed for rendering
+        NGTerrainAddToScene(handle, 0, 0, 0);
+        NGTerrainSetVisible(handle, 1);
+    }
+    return handle;
+}
+
 void NGSceneSetTerrain(const struct NGTerrainAsset *asset) {
+    // While staging, this is the next scene's terrain
+    if (staging) {
+        if (staged_terrain != NG_TERRAIN_INVALID)
+            NGTerrainDestroy(staged_terrain);
+        staged_terrain = asset ? add_terrain(asset) : NG_TERRAIN_INVALID;
+        return;
+    }
+
     // Clear existing terrain if any
     if (scene_terrain != NG_TERRAIN_INVALID) {
         NGTerrainDestroy(scene_terrain);
@@ -88,13 +199,10 @@ void NGSceneSetTerrain(const struct NGTerrainAsset *asset) {
         return;
     }
 
-    scene_terrain = NGTerrainCreate(asset);
+    scene_terrain = add_terrain(asset);
     if (scene_terrain != NG_TERRAIN_INVALID) {
         terrain_in_scene = 1;
         terrain_z = 0;
-        // Add to scene at origin - this sets tm->in_scene flag needed for rendering
-        NGTerrainAddToScene(scene_terrain, 0, 0, terrain_z);
-        NGTerrainSetVisible(scene_terrain, 1);
     }
 }
 
@@ -127,6 +235,16 @@ void NGSceneSetTerrainVisible(u8 visible) {
     }
 }
 
+void NGSceneWarmUpTerrain(fixed cam_x, fixed cam_y) {
+    if (scene_terrain != NG_TERRAIN_INVALID) {
+        NGTerrainWarmUp(scene_terrain, cam_x, cam_y);
+    }
+}
+
+u8 NGSceneIsTerrainWarm(void) {
+    return NGTerrainIsWarm(scene_terrain);
+}
+
 void NGSceneGetTerrainBounds(u16 *width, u16 *height) {
     if (scene_terrain != NG_TERRAIN_INVALID) {
         NGTerrainGetDimensions(scene_terrain, width, height);
@@ -160,22 +278,26 @@ u8 NGSceneResolveCollision(fixed *x, fixed *y, fixed half_w, fixed half_h, fixed
     return NGTerrainResolveAABB(scene_terrain, x, y, half_w, half_h, vel_x, vel_y);
 }
 
+u8 NGSceneResolveBatch(const NGTerrainBatch *batch) {
+    return NGTerrainResolveBatch(scene_terrain, batch);
+}
+
 u8 NGSceneGetTileAt(u16 tile_x, u16 tile_y) {
     if (scene_terrain == NG_TERRAIN_INVALID)
         return 0;
     return NGTerrainGetTileAt(scene_terrain, tile_x, tile_y);
 }
 
-void NGSceneSetTileAt(u16 tile_x, u16 tile_y, u8 tile_index) {
-    if (scene_terrain != NG_TERRAIN_INVALID) {
-        NGTerrainSetTile(scene_terrain, tile_x, tile_y, tile_index);
-    }
+u8 NGSceneSetTileAt(u16 tile_x, u16 tile_y, u8 tile_index) {
+    if (scene_terrain == NG_TERRAIN_INVALID)
+        return 0;
+    return NGTerrainSetTile(scene_terrain, tile_x, tile_y, tile_index);
 }
 
-void NGSceneSetCollisionAt(u16 tile_x, u16 tile_y, u8 collision) {
-    if (scene_terrain != NG_TERRAIN_INVALID) {
-        NGTerrainSetCollision(scene_terrain, tile_x, tile_y, collision);
-    }
+u8 NGSceneSetCollisionAt(u16 tile_x, u16 tile_y, u8 collision) {
+    if (scene_terrain == NG_TERRAIN_INVALID)
+        return 0;
+    return NGTerrainSetCollision(scene_terrain, tile_x, tile_y, collision);
 }
 
 NGTerrainHandle NGSceneGetTerrain(void) {
@@ -19,8 +19,10 @@
 #define NG_SDK_INTERNAL_H
 
 #include <ng_types.h>
+#include <ng_arena.h>
 #include "actor.h"
 #include "backdrop.h"
+#include "graphic.h"
 #include "terrain.h"
 
 /* ------------------------------------------------------------------------ */
@@ -49,6 +51,13 @@ fixed NGCameraGetRenderY(void);
 /* Graphic system internals                                                 */
 /* ------------------------------------------------------------------------ */
 
+/**
+ * Allocate the graphic table (called by engine init, before scene init).
+ * The _NG*SystemAlloc() functions below work the same way.
+ * @return 1 on success, 0 if the arena is too small (capacity becomes 0)
+ */
+u8 _NGGraphicSystemAlloc(NGArena *arena, u8 capacity);
+
 /** Initialize graphics system (called by scene init) */
 void NGGraphicSystemInit(void);
 
@@ -58,13 +67,101 @@ void NGGraphicSystemDraw(void);
 /** Reset graphics system, destroying all graphics (called on scene reset) */
 void NGGraphicSystemReset(void);
 
+/**
+ * Declare the palettes a per-tile-palette graphic can use (256-bit mask,
+ * must stay valid while set). Without one, such a graphic counts as using
+ * every palette.
+ */
+void _NGGraphicSetPaletteMask(NGGraphic *g, const u8 *palette_mask);
+
+/**
+ * Chunked tile source: returns tile (col, row), which is inside the map, as
+ * a pointer into its decompressed chunk. Rows of a chunk are
+ * NG_TERRAIN_CHUNK_SIZE bytes apart. The pointer is valid until the next call.
+ */
+typedef const u8 *(*NGTileFetch)(void *ctx, u16 col, u16 row);
+
+/**
+ * Read a tilemap8 graphic's tiles through a fetch function instead of a flat
+ * array. Call after NGGraphicSetSourceTilemap8(), which still provides the
+ * map size and palettes; its tilemap may be NULL.
+ */
+void _NGGraphicSetTileFetch(NGGraphic *g, NGTileFetch fetch, void *ctx);
+
+/**
+ * P-ROM bank holding a graphic's source arrays, mapped before the graphic
+ * reads them. Call after the NGGraphicSetSource*() function, which resets
+ * it to NG_BANK_FIXED.
+ */
+void _NGGraphicSetSourceBank(NGGraphic *g, u8 bank);
+
+/** Tile at (col, row) of a flat tilemap8 map after edits, given its unedited tile */
+typedef u8 (*NGTileOverlay)(void *ctx, u16 col, u16 row, u8 tile);
+
+/**
+ * Read a flat tilemap8 graphic's tiles through an overlay of edits, only in
+ * source columns whose bit (col & 7 of byte col >> 3) is set in columns.
+ * Tiles already on screen are redrawn with _NGGraphicPatchTile().
+ */
+void _NGGraphicSetTileOverlay(NGGraphic *g, NGTileOverlay overlay, void *ctx,
+                              const u8 *columns);
+
+/**
+ * Rewrite map tile (col, row) of a tilemap8 graphic at its next draw, if it
+ * is on screen then: one SCB1 tile/attr pair. Past a few per frame the
+ * graphic reloads all its tiles instead.
+ */
+void _NGGraphicPatchTile(NGGraphic *g, u16 col, u16 row);
+
+/** Check if any visible graphic uses a palette this frame */
+u8 _NGGraphicPaletteInUse(u8 palette);
+
+/**
+ * Switch an infinite-mode graphic to sticky-chain scrolling: columns are
+ * chained to the first sprite, so one SCB4 write moves the whole layer.
+ */
+void _NGGraphicSetScrollChain(NGGraphic *g, u8 enabled);
+
+/**
+ * Get the SCB4 write that shows source X offset_x on a chained graphic,
+ * and the screen line of source row `row`. Valid after NGGraphicSystemDraw().
+ * @return 1 if the graphic is chained and on screen, 0 otherwise
+ */
+u8 _NGGraphicScrollChainBand(const NGGraphic *g, s16 offset_x, u16 row, s16 *out_line,
+                             u16 *out_sprite, u16 *out_scb4);
+
+/**
+ * Stage graphics created from now on for the next scene: they get sprites
+ * after the live ones, upload their tiles a few columns per frame and stay
+ * hidden until _NGGraphicStageCommit().
+ */
+void _NGGraphicStageBegin(void);
+
+/** Check if a graphic was created for the next scene and not committed yet */
+u8 _NGGraphicIsStaged(const NGGraphic *g);
+
+/** Count the visible staged graphics still waiting for their tiles */
+u8 _NGGraphicStagePending(void);
+
+/** Make the staged graphics live; their SCB3 is written at the next draw */
+void _NGGraphicStageCommit(void);
+
 /* ------------------------------------------------------------------------ */
 /* Actor internals                                                          */
 /* ------------------------------------------------------------------------ */
 
+/** Allocate the actor table (called by engine init) */
+u8 _NGActorSystemAlloc(NGArena *arena, u8 capacity);
+
 /** Initialize the actor subsystem (called by scene init) */
 void _NGActorSystemInit(void);
 
+/**
+ * Destroy every actor (called on scene reset), or with keep_staged only
+ * those of the current scene (called on a staged scene swap)
+ */
+void _NGActorDestroyAll(u8 keep_staged);
+
 /** Update all actors (animation, etc.) */
 void _NGActorSystemUpdate(void);
 
@@ -87,12 +184,27 @@ u8 _NGActorIsScreenSpace(NGActorHandle handle);
 /* Backdrop internals                                                       */
 /* ------------------------------------------------------------------------ */
 
+/** Allocate the backdrop table (called by engine init) */
+u8 _NGBackdropSystemAlloc(NGArena *arena, u8 capacity);
+
 /** Initialize the backdrop subsystem (called by scene init) */
 void _NGBackdropSystemInit(void);
 
+/**
+ * Destroy every backdrop (called on scene reset), or with keep_staged only
+ * those of the current scene (called on a staged scene swap)
+ */
+void _NGBackdropDestroyAll(u8 keep_staged);
+
 /** Sync backdrop state to graphics hardware */
 void _NGBackdropSyncGraphics(void);
 
+/**
+ * Add raster entries for line-scroll bands (called after graphic draw).
+ * @return 1 if entries were added
+ */
+u8 _NGBackdropAddRaster(void);
+
 /** Collect palette indices used by backdrops into a bitmask */
 void _NGBackdropCollectPalettes(u8 *palette_mask);
 
@@ -100,13 +212,99 @@ void _NGBackdropCollectPalettes(u8 *palette_mask);
 /* Terrain internals                                                        */
 /* ------------------------------------------------------------------------ */
 
+/** Allocate the terrain table (called by engine init) */
+u8 _NGTerrainSystemAlloc(NGArena *arena, u8 capacity);
+
 /** Initialize the terrain subsystem (called by scene init) */
 void _NGTerrainSystemInit(void);
 
+/**
+ * Keep a block of sprites just below the UI pool, or below the blocks
+ * reserved before it, out of entity allocation (called by scene init,
+ * after NGGraphicSystemInit()).
+ * @return First sprite of the block, or 0 if count is 0 or too large
+ */
+u16 _NGGraphicReserveSprites(u16 count);
+
 /** Sync terrain state to graphics hardware */
 void _NGTerrainSyncGraphics(void);
 
 /** Collect palette indices used by terrain into a bitmask */
 void _NGTerrainCollectPalettes(u8 *palette_mask);
 
+/* ------------------------------------------------------------------------ */
+/* Physics internals                                                        */
+/* ------------------------------------------------------------------------ */
+
+/**
+ * Set the body table size and drop the old table (called by engine init,
+ * after the arenas are reset). NGPhysWorldCreate() allocates the table.
+ */
+void _NGPhysSystemInit(u8 capacity);
+
+/* ------------------------------------------------------------------------ */
+/* Particle internals                                                       */
+/* ------------------------------------------------------------------------ */
+
+/** Allocate the particle arrays (called by engine init; 0 capacity = no pool) */
+u8 _NGParticlesSystemAlloc(NGArena *arena, u16 capacity, u8 sprites);
+
+/** Reserve the particle sprites and clear the pool (called by scene init) */
+void _NGParticlesSystemInit(void);
+
+/** Remove all particles (called on scene reset) */
+void _NGParticlesReset(void);
+
+/**
+ * Write particles to their reserved sprites (called by scene draw).
+ * @return 1 if raster entries were added for multiplexed sprites
+ */
+u8 _NGParticlesDraw(void);
+
+/** Collect palette indices used by particles into a bitmask */
+void _NGParticlesCollectPalettes(u8 *palette_mask);
+
+/** @return 1 if a live or recent particle uses the palette */
+u8 _NGParticlesPaletteInUse(u8 palette);
+
+/* ------------------------------------------------------------------------ */
+/* Sprite text internals                                                    */
+/* ------------------------------------------------------------------------ */
+
+/** Allocate the character map (called by engine init; 0 sprites = no sprite text) */
+u8 _NGSpriteTextSystemAlloc(NGArena *arena, u8 sprites);
+
+/** Reserve the text sprites and drop every text (called by scene init) */
+void _NGSpriteTextSystemInit(void);
+
+/** Forget the sticky chains hidden by the graphic reset (called on scene reset) */
+void _NGSpriteTextReset(void);
+
+/** Write pending text changes to their sprites (called by scene draw) */
+void _NGSpriteTextDraw(void);
+
+/* ------------------------------------------------------------------------ */
+/* Widget internals                                                         */
+/* ------------------------------------------------------------------------ */
+
+/** Allocate the widget table (called by engine init; 0 capacity = no widgets) */
+u8 _NGWidgetSystemAlloc(NGArena *arena, u8 capacity, u8 gauge_sprites);
+
+/** Free every widget (called by engine init) */
+void _NGWidgetSystemInit(void);
+
+/** Reserve the gauge sprites (called by scene init) */
+void _NGWidgetsReserveSprites(void);
+
+/** Drop sprite widgets' graphics and redo gauges, after a graphic system reset
+ * hid them (called on scene reset) */
+void _NGWidgetsReleaseGraphics(void);
+
+/* ------------------------------------------------------------------------ */
+/* Save internals                                                           */
+/* ------------------------------------------------------------------------ */
+
+/** Allocate the image of the newest slot (called by engine init; 0 size = no save) */
+u8 _NGSaveSystemAlloc(NGArena *arena, u16 size);
+
 #endif /* NG_SDK_INTERNAL_H */
@@ -9,6 +9,62 @@
 #define SETTLE_VELOCITY_THRESHOLD FIX(0.1)
 #define SETTLE_POSITION_THRESHOLD FIX(0.5)
 
+#define SETTLE16_VELOCITY_THRESHOLD (FIX16_ONE / 10)
+#define SETTLE16_POSITION_THRESHOLD FIX16_HALF
+
+// System springs: bit i of a mask word covers spring (word * 32 + i)
+#define MASK_WORDS(count) (((count) + 31) / 32)
+
+static NGSpring sys_springs[NG_SPRING_SYSTEM_MAX];
+static u32 sys_used[MASK_WORDS(NG_SPRING_SYSTEM_MAX)];
+static u32 sys_settled[MASK_WORDS(NG_SPRING_SYSTEM_MAX)];
+
+static NGSpring16 sys_springs16[NG_SPRING16_SYSTEM_MAX];
+static u32 sys_used16[MASK_WORDS(NG_SPRING16_SYSTEM_MAX)];
+static u32 sys_settled16[MASK_WORDS(NG_SPRING16_SYSTEM_MAX)];
+
+static void mask_set(u32 *mask, u16 i) {
+    mask[i >> 5] |= 1UL << (i & 31);
+}
+
+static void mask_clear(u32 *mask, u16 i) {
+    mask[i >> 5] &= ~(1UL << (i & 31));
+}
+
+/* Reserve the first free slot, or pair of adjacent slots; -1 if none */
+static s16 take_slots(u32 *used, u16 count, u8 pair) {
+    for (u16 w = 0; w < MASK_WORDS(count); w++) {
+        u32 free = ~used[w];
+        if (pair)
+            free &= free >> 1;
+        if (!free)
+            continue;
+
+        u8 bit = 0;
+        while (!(free & 1)) {
+            free >>= 1;
+            bit++;
+        }
+        u16 i = (u16)(w * 32 + bit);
+        if (i + pair >= count)
+            return -1; /* Past the end of the last, partial word */
+        used[w] |= (pair ? 3UL : 1UL) << bit;
+        return (s16)i;
+    }
+    return -1;
+}
+
+/* Clear the settled bit of a system spring so the next update steps it */
+static void wake(const NGSpring *spring) {
+    if (spring >= sys_springs && spring < sys_springs + NG_SPRING_SYSTEM_MAX)
+        mask_clear(sys_settled, (u16)(spring - sys_springs));
+}
+
+static void wake16(const NGSpring16 *spring) {
+    if (spring >= sys_springs16 && spring < sys_springs16 + NG_SPRING16_SYSTEM_MAX)
+        mask_clear(sys_settled16, (u16)(spring - sys_springs16));
+}
+
 void NGSpringInit(NGSpring *spring, fixed initial, fixed stiffness, fixed damping) {
     spring->value = initial;
     spring->velocity = 0;
@@ -19,6 +75,7 @@ void NGSpringInit(NGSpring *spring, fixed initial, fixed stiffness, fixed dampin
 
 void NGSpringSetTarget(NGSpring *spring, fixed target) {
     spring->target = target;
+    wake(spring);
 }
 
 void NGSpringSnap(NGSpring *spring, fixed value) {
@@ -29,6 +86,7 @@ void NGSpringSnap(NGSpring *spring, fixed value) {
 
 void NGSpringImpulse(NGSpring *spring, fixed impulse) {
     spring->velocity += impulse;
+    wake(spring);
 }
 
 void NGSpringUpdate(NGSpring *spring) {
@@ -60,8 +118,8 @@ void NGSpring2DInit(NGSpring2D *spring, fixed x, fixed y, fixed stiffness, fixed
 }
 
 void NGSpring2DSetTarget(NGSpring2D *spring, fixed x, fixed y) {
-    spring->x.target = x;
-    spring->y.target = y;
+    NGSpringSetTarget(&spring->x, x);
+    NGSpringSetTarget(&spring->y, y);
 }
 
 void NGSpring2DSnap(NGSpring2D *spring, fixed x, fixed y) {
@@ -77,3 +135,145 @@ void NGSpring2DUpdate(NGSpring2D *spring) {
 u8 NGSpring2DSettled(NGSpring2D *spring) {
     return NGSpringSettled(&spring->x) && NGSpringSettled(&spring->y);
 }
+
+void NGSpring16Init(NGSpring16 *spring, fixed16 initial, fixed stiffness, fixed damping) {
+    spring->value = initial;
+    spring->velocity = 0;
+    spring->target = initial;
+    spring->stiffness = FIX_TO_FIX16(stiffness);
+    spring->damping = FIX_TO_FIX16(damping);
+}
+
+void NGSpring16SetTarget(NGSpring16 *spring, fixed16 target) {
+    spring->target = target;
+    wake16(spring);
+}
+
+void NGSpring16Snap(NGSpring16 *spring, fixed16 value) {
+    spring->value = value;
+    spring->target = value;
+    spring->velocity = 0;
+}
+
+void NGSpring16Impulse(NGSpring16 *spring, fixed16 impulse) {
+    spring->velocity = (fixed16)(spring->velocity + impulse);
+    wake16(spring);
+}
+
+void NGSpring16Update(NGSpring16 *spring) {
+    // Same model as NGSpringUpdate, one MULS per term
+    fixed16 displacement = (fixed16)(spring->value - spring->target);
+    fixed16 acceleration = (fixed16)(-FIX16_MUL(spring->stiffness, displacement) -
+                                     FIX16_MUL(spring->damping, spring->velocity));
+
+    spring->velocity = (fixed16)(spring->velocity + acceleration);
+    spring->value = (fixed16)(spring->value + spring->velocity);
+}
+
+u8 NGSpring16Settled(NGSpring16 *spring) {
+    s16 displacement = (s16)(spring->value - spring->target);
+    s16 vel = spring->velocity;
+    return (displacement > -SETTLE16_POSITION_THRESHOLD &&
+            displacement < SETTLE16_POSITION_THRESHOLD) &&
+           (vel > -SETTLE16_VELOCITY_THRESHOLD && vel < SETTLE16_VELOCITY_THRESHOLD);
+}
+
+NGSpring *NGSpringSystemAdd(fixed initial, fixed stiffness, fixed damping) {
+    s16 i = take_slots(sys_used, NG_SPRING_SYSTEM_MAX, 0);
+    if (i < 0)
+        return 0;
+    NGSpringInit(&sys_springs[i], initial, stiffness, damping);
+    mask_set(sys_settled, (u16)i);
+    return &sys_springs[i];
+}
+
+NGSpring2D *NGSpringSystemAdd2D(fixed x, fixed y, fixed stiffness, fixed damping) {
+    s16 i = take_slots(sys_used, NG_SPRING_SYSTEM_MAX, 1);
+    if (i < 0)
+        return 0;
+    // NGSpring2D is two NGSprings back to back, so a pair of slots holds one
+    NGSpring2D *spring = (NGSpring2D *)&sys_springs[i];
+    NGSpring2DInit(spring, x, y, stiffness, damping);
+    mask_set(sys_settled, (u16)i);
+    mask_set(sys_settled, (u16)(i + 1));
+    return spring;
+}
+
+NGSpring16 *NGSpringSystemAdd16(fixed16 initial, fixed stiffness, fixed damping) {
+    s16 i = take_slots(sys_used16, NG_SPRING16_SYSTEM_MAX, 0);
+    if (i < 0)
+        return 0;
+    NGSpring16Init(&sys_springs16[i], initial, stiffness, damping);
+    mask_set(sys_settled16, (u16)i);
+    return &sys_springs16[i];
+}
+
+void NGSpringSystemRemove(NGSpring *spring) {
+    if (spring >= sys_springs && spring < sys_springs + NG_SPRING_SYSTEM_MAX)
+        mask_clear(sys_used, (u16)(spring - sys_springs));
+}
+
+void NGSpringSystemRemove2D(NGSpring2D *spring) {
+    if (!spring)
+        return;
+    NGSpringSystemRemove(&spring->x);
+    NGSpringSystemRemove(&spring->y);
+}
+
+void NGSpringSystemRemove16(NGSpring16 *spring) {
+    if (spring >= sys_springs16 && spring < sys_springs16 + NG_SPRING16_SYSTEM_MAX)
+        mask_clear(sys_used16, (u16)(spring - sys_springs16));
+}
+
+void NGSpringSystemUpdate(void) {
+    for (u8 w = 0; w < MASK_WORDS(NG_SPRING_SYSTEM_MAX); w++) {
+        u32 moving = sys_used[w] & ~sys_settled[w];
+        NGSpring *spring = &sys_springs[w * 32];
+        for (u32 bit = 1; moving; bit <<= 1, spring++) {
+            if (!(moving & bit))
+                continue;
+            moving &= ~bit;
+            NGSpringUpdate(spring);
+            if (NGSpringSettled(spring)) {
+                spring->value = spring->target;
+                spring->velocity = 0;
+                sys_settled[w] |= bit;
+            }
+        }
+    }
+
+    for (u8 w = 0; w < MASK_WORDS(NG_SPRING16_SYSTEM_MAX); w++) {
+        u32 moving = sys_used16[w] & ~sys_settled16[w];
+        NGSpring16 *spring = &sys_springs16[w * 32];
+        for (u32 bit = 1; moving; bit <<= 1, spring++) {
+            if (!(moving & bit))
+                continue;
+            moving &= ~bit;
+            NGSpring16Update(spring);
+            if (NGSpring16Settled(spring)) {
+                spring->value = spring->target;
+                spring->velocity = 0;
+                sys_settled16[w] |= bit;
+            }
+        }
+    }
+}
+
+u8 NGSpringSystemBusy(void) {
+    for (u8 w = 0; w < MASK_WORDS(NG_SPRING_SYSTEM_MAX); w++) {
+        if (sys_used[w] & ~sys_settled[w])
+            return 1;
+    }
+    for (u8 w = 0; w < MASK_WORDS(NG_SPRING16_SYSTEM_MAX); w++) {
+        if (sys_used16[w] & ~sys_settled16[w])
+            return 1;
+    }
+    return 0;
+}
+
+void NGSpringSystemReset(void) {
+    for (u8 w = 0; w < MASK_WORDS(NG_SPRING_SYSTEM_MAX); w++)
+        sys_used[w] = 0;
+    for (u8 w = 0; w < MASK_WORDS(NG_SPRING16_SYSTEM_MAX); w++)
+        sys_used16[w] = 0;
+}
@@ -0,0 +1,452 @@
+/*
+ * This file is part of ProGearSDK.
+ * Copyright (c) 2024-2025 ProGearSDK contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <spritetext.h>
+#include <graphic.h>
+#include <ng_arena.h>
+#include <ng_hardware.h>
+#include <ng_sprite.h>
+#include <ng_display_list.h>
+#include <ng_tables.h>
+
+#include "sdk_internal.h"
+
+#define NO_RUN 0xFF
+
+/* Marks a sprite of the block whose SCB3 holds the sticky bit, in the
+ * character map next to the character it shows */
+#define CHAR_STICKY 0x80
+#define CHAR_MASK   0x7F
+
+/* Work for the next draw */
+#define RUN_TILES 0x01 /* Tile and attribute words */
+#define RUN_ATTR  0x02 /* Attribute words only */
+#define RUN_SHOW  0x04 /* Y and X of the first sprite */
+#define RUN_HIDE  0x08 /* SCB3 of the first sprite */
+
+/* State of the sprites */
+#define RUN_CHAINED 0x10 /* SCB3 of the other sprites is sticky */
+#define RUN_SCALED  0x20 /* SCB2 matches shrink */
+#define RUN_KEPT    (RUN_CHAINED | RUN_SCALED)
+
+/* A string in the sprite block, shown by a text or cached */
+typedef struct {
+    u16 hash;
+    u16 font;  /* Tile of the space character it was drawn with */
+    u16 stamp; /* Release order, for eviction */
+    u8 first;  /* Sprite offset in the block */
+    u8 length; /* 0 for an unused entry */
+    u8 owner;  /* Text index, or NO_RUN when cached */
+    u8 flags;
+    u8 palette;
+    u8 shrink; /* 8-bit hardware shrink of SCB2 */
+} Run;
+
+struct NGSpriteText {
+    u8 run; /* NO_RUN when the text shows nothing */
+    u8 in_use;
+    u8 visible;
+    u8 palette;
+    s16 x, y;
+    u16 scale;
+};
+
+static struct NGSpriteText texts[NG_SPRITE_TEXT_MAX];
+static Run runs[NG_SPRITE_TEXT_CACHE];
+
+/* Character of each sprite of the block, with CHAR_STICKY while its SCB3
+ * has the sticky bit */
+static u8 *chars;
+static u16 block_first;
+static u8 block_size;
+static u8 block_capacity;
+static u16 font_tile;
+static u16 release_clock;
+
+#define TEXT_SETUP(deferred, addr, mod)         \
+    do {                                        \
+        if (deferred)                           \
+            NGDisplayListRun((u16)(addr), mod); \
+        else                                    \
+            NG_VRAM_SETUP_FAST(addr, mod);      \
+    } while (0)
+
+#define TEXT_WRITE(deferred, data)         \
+    do {                                   \
+        if (deferred)                      \
+            NGDisplayListPut((u16)(data)); \
+        else                               \
+            NG_VRAM_WRITE_FAST(data);      \
+    } while (0)
+
+#define TEXT_FILL(deferred, value, n)                      \
+    do {                                                   \
+        if (deferred)                                      \
+            NGDisplayListFillNext((u16)(value), (u16)(n)); \
+        else                                               \
+            NG_VRAM_FILL_FAST(value, n);                   \
+    } while (0)
+
+u8 _NGSpriteTextSystemAlloc(NGArena *arena, u8 sprites) {
+    block_capacity = 0;
+    if (!sprites)
+        return 1;
+    chars = NG_ARENA_ALLOC_ARRAY(arena, u8, sprites);
+    if (!chars)
+        return 0;
+    block_capacity = sprites;
+    return 1;
+}
+
+void _NGSpriteTextSystemInit(void) {
+    block_first = _NGGraphicReserveSprites(block_capacity);
+    block_size = block_first ? block_capacity : 0;
+    font_tile = 0;
+    NGSpriteTextClearAll();
+}
+
+void _NGSpriteTextReset(void) {
+    /* The graphic system zeroed SCB3 of the whole sprite range; tiles and
+     * shrink are still there */
+    for (u8 i = 0; i < block_size; i++)
+        chars[i] &= CHAR_MASK;
+    for (u8 r = 0; r < NG_SPRITE_TEXT_CACHE; r++)
+        runs[r].flags &= (u8) ~(RUN_CHAINED | RUN_HIDE);
+}
+
+void NGSpriteTextClearAll(void) {
+    for (u8 i = 0; i < NG_SPRITE_TEXT_MAX; i++) {
+        texts[i].in_use = 0;
+        texts[i].run = NO_RUN;
+    }
+    for (u8 r = 0; r < NG_SPRITE_TEXT_CACHE; r++)
+        runs[r].length = 0;
+    if (block_size)
+        NGSpriteHideRange(block_first, block_size);
+    for (u8 i = 0; i < block_size; i++)
+        chars[i] = 0;
+    release_clock = 0;
+}
+
+void NGSpriteTextSetFont(u16 first_tile) {
+    font_tile = first_tile;
+}
+
+/* ============================================================
+ * String Cache
+ * ============================================================ */
+
+static u8 glyph(char c) {
+    u8 code = (u8)c;
+    if (code < NG_SPRITE_TEXT_FIRST_CHAR || code > NG_SPRITE_TEXT_LAST_CHAR)
+        return ' ';
+    return code;
+}
+
+/* CRC-16 of the characters as drawn; also gets the length */
+static u16 text_hash(const char *text, u16 *length) {
+    u16 crc = 0xFFFF;
+    u16 n = 0;
+    for (; text[n]; n++)
+        crc = (u16)(crc << 8) ^ ng_crc16_table[(u8)(crc >> 8) ^ glyph(text[n])];
+    *length = n;
+    return crc;
+}
+
+static u8 run_matches(const Run *run, const char *text) {
+    for (u8 i = 0; i < run->length; i++) {
+        if ((chars[run->first + i] & CHAR_MASK) != glyph(text[i]))
+            return 0;
+    }
+    return 1;
+}
+
+/* Cached run showing text in the current font, or NO_RUN */
+static u8 find_cached(const char *text, u16 hash, u8 length) {
+    for (u8 r = 0; r < NG_SPRITE_TEXT_CACHE; r++) {
+        const Run *run = &runs[r];
+        if (run->length == length && run->owner == NO_RUN && run->hash == hash &&
+            run->font == font_tile && run_matches(run, text))
+            return r;
+    }
+    return NO_RUN;
+}
+
+/* First free stretch of length sprites in the block, or NO_RUN */
+static u8 find_room(u8 length) {
+    u16 start = 0;
+    while (start + length <= block_size) {
+        u16 next = start;
+        for (u8 r = 0; r < NG_SPRITE_TEXT_CACHE; r++) {
+            const Run *run = &runs[r];
+            u16 end = (u16)(run->first + run->length);
+            if (run->length && run->first < start + length && end > start && end > next)
+                next = end;
+        }
+        if (next == start)
+            return (u8)start;
+        start = next;
+    }
+    return NO_RUN;
+}
+
+/* Drop the least recently released cached string; 0 if none can go.
+ * One still waiting to be hidden stays until it has been. */
+static u8 evict(void) {
+    u8 oldest = NO_RUN;
+    for (u8 r = 0; r < NG_SPRITE_TEXT_CACHE; r++) {
+        const Run *run = &runs[r];
+        if (!run->length || run->owner != NO_RUN || (run->flags & RUN_HIDE))
+            continue;
+        if (oldest == NO_RUN || (s16)(run->stamp - runs[oldest].stamp) < 0)
+            oldest = r;
+    }
+    if (oldest == NO_RUN)
+        return 0;
+    runs[oldest].length = 0;
+    return 1;
+}
+
+/* Place a new string in the block, evicting cached ones for room */
+static u8 new_run(const char *text, u16 hash, u8 length) {
+    u8 slot = NO_RUN;
+    u8 start;
+    for (;;) {
+        for (u8 r = 0; r < NG_SPRITE_TEXT_CACHE && slot == NO_RUN; r++) {
+            if (!runs[r].length)
+                slot = r;
+        }
+        start = find_room(length);
+        if (slot != NO_RUN && start != NO_RUN)
+            break;
+        if (!evict())
+            return NO_RUN;
+    }
+
+    Run *run = &runs[slot];
+    run->hash = hash;
+    run->font = font_tile;
+    run->first = start;
+    run->length = length;
+    run->flags = RUN_TILES;
+    /* Sprites keep their sticky mark until the run's SCB3 is written */
+    for (u8 i = 0; i < length; i++)
+        chars[start + i] = (u8)((chars[start + i] & CHAR_STICKY) | glyph(text[i]));
+    return slot;
+}
+
+static void release(NGSpriteTextHandle t) {
+    if (t->run == NO_RUN)
+        return;
+    Run *run = &runs[t->run];
+    run->owner = NO_RUN;
+    run->stamp = release_clock++;
+    if (run->flags & RUN_TILES)
+        run->length = 0; /* Never drawn: nothing to keep or hide */
+    else
+        run->flags = (u8)((run->flags & (RUN_KEPT | RUN_ATTR)) | RUN_HIDE);
+    t->run = NO_RUN;
+}
+
+static u8 acquire(NGSpriteTextHandle t, const char *text) {
+    u16 length;
+    u16 hash = text_hash(text, &length);
+    if (!length || length > block_size)
+        return 0;
+
+    u8 r = find_cached(text, hash, (u8)length);
+    if (r == NO_RUN)
+        r = new_run(text, hash, (u8)length);
+    if (r == NO_RUN)
+        return 0;
+
+    /* A hidden text still clears its first sprite, which may be left
+     * sticky by an evicted string and chain onto the sprite before */
+    Run *run = &runs[r];
+    run->owner = (u8)(t - texts);
+    run->flags &= (u8)~RUN_HIDE;
+    if (!(run->flags & RUN_TILES) && run->palette != t->palette)
+        run->flags |= RUN_ATTR;
+    run->palette = t->palette;
+    run->flags |= t->visible ? RUN_SHOW : RUN_HIDE;
+    t->run = r;
+    return 1;
+}
+
+/* ============================================================
+ * Texts
+ * ============================================================ */
+
+NGSpriteTextHandle NGSpriteTextCreate(const char *text, s16 x, s16 y, u8 palette) {
+    if (!block_size || !text)
+        return NULL;
+    NGSpriteTextHandle t = NULL;
+    for (u8 i = 0; i < NG_SPRITE_TEXT_MAX && !t; i++) {
+        if (!texts[i].in_use)
+            t = &texts[i];
+    }
+    if (!t)
+        return NULL;
+
+    t->x = x;
+    t->y = y;
+    t->palette = palette;
+    t->scale = NG_GRAPHIC_SCALE_ONE;
+    t->visible = 1;
+    t->run = NO_RUN;
+    if (!acquire(t, text))
+        return NULL;
+    t->in_use = 1;
+    return t;
+}
+
+u8 NGSpriteTextSet(NGSpriteTextHandle t, const char *text) {
+    if (!t || !text)
+        return 0;
+    release(t);
+    return acquire(t, text);
+}
+
+void NGSpriteTextSetPosition(NGSpriteTextHandle t, s16 x, s16 y) {
+    if (!t || (t->x == x && t->y == y))
+        return;
+    t->x = x;
+    t->y = y;
+    if (t->visible && t->run != NO_RUN)
+        runs[t->run].flags |= RUN_SHOW;
+}
+
+void NGSpriteTextSetScale(NGSpriteTextHandle t, u16 scale) {
+    if (t)
+        t->scale = scale > NG_GRAPHIC_SCALE_ONE ? NG_GRAPHIC_SCALE_ONE : scale;
+}
+
+void NGSpriteTextSetPalette(NGSpriteTextHandle t, u8 palette) {
+    if (!t || t->palette == palette)
+        return;
+    t->palette = palette;
+    if (t->run != NO_RUN) {
+        runs[t->run].palette = palette;
+        runs[t->run].flags |= RUN_ATTR;
+    }
+}
+
+void NGSpriteTextSetVisible(NGSpriteTextHandle t, u8 visible) {
+    visible = visible ? 1 : 0;
+    if (!t || t->visible == visible)
+        return;
+    t->visible = visible;
+    if (t->run == NO_RUN)
+        return;
+    Run *run = &runs[t->run];
+    run->flags &= (u8) ~(RUN_SHOW | RUN_HIDE);
+    run->flags |= visible ? RUN_SHOW : RUN_HIDE;
+}
+
+/* Columns narrow as NGSpriteShrinkWrite() spreads the shrink over them */
+u16 NGSpriteTextGetWidth(NGSpriteTextHandle t) {
+    if (!t || t->run == NO_RUN)
+        return 0;
+    u8 length = runs[t->run].length;
+    u8 shrink = ng_shrink_table[t->scale];
+    u8 base = (u8)(shrink >> 4);
+    u16 width = (u16)(length * (base + 1));
+    if (length > 1 && base < 15)
+        width = (u16)(width + (shrink & 0x0F));
+    return width;
+}
+
+void NGSpriteTextDestroy(NGSpriteTextHandle t) {
+    if (!t || !t->in_use)
+        return;
+    release(t);
+    t->in_use = 0;
+}
+
+/* ============================================================
+ * Drawing
+ * ============================================================ */
+
+/* Tiles in one run along the first row of each sprite (VRAMMOD 64),
+ * then the attributes, all the same, in a second */
+static void write_tiles(const Run *run) {
+    u8 deferred = NGDisplayListIsRecording();
+    NG_VRAM_DECLARE_BASE();
+    u16 addr = (u16)(NG_SCB1_BASE + (block_first + run->first) * 64);
+    if (run->flags & RUN_TILES) {
+        TEXT_SETUP(deferred, addr, 64);
+        for (u8 i = 0; i < run->length; i++) {
+            u8 c = chars[run->first + i] & CHAR_MASK;
+            TEXT_WRITE(deferred, run->font + (u16)(c - NG_SPRITE_TEXT_FIRST_CHAR));
+        }
+    }
+    TEXT_SETUP(deferred, addr + 1, 64);
+    TEXT_FILL(deferred, (u16)run->palette << 8, run->length);
+}
+
+/* Write the run's sticky chain, and end it: a sprite after it left
+ * sticky by an evicted string would chain onto it */
+static void chain(Run *run, const struct NGSpriteText *t) {
+    u16 sprite = (u16)(block_first + run->first);
+    u8 end = (u8)(run->first + run->length);
+    NGSpriteYSetChain(sprite, run->length, t->y, 1);
+    NGSpriteXSet(sprite, t->x);
+    chars[run->first] &= CHAR_MASK;
+    for (u8 i = (u8)(run->first + 1); i < end; i++)
+        chars[i] |= CHAR_STICKY;
+    if (end < block_size && (chars[end] & CHAR_STICKY)) {
+        NGSpriteHideRange((u16)(block_first + end), 1);
+        chars[end] &= CHAR_MASK;
+    }
+}
+
+static void draw_run(Run *run) {
+    u16 sprite = (u16)(block_first + run->first);
+    u8 flags = run->flags;
+
+    if (flags & (RUN_TILES | RUN_ATTR))
+        write_tiles(run);
+
+    const struct NGSpriteText *t = run->owner != NO_RUN ? &texts[run->owner] : NULL;
+    if (!t || !t->visible) {
+        if (flags & RUN_HIDE) {
+            NGSpriteHideRange(sprite, 1);
+            chars[run->first] &= CHAR_MASK;
+        }
+        run->flags = (u8)(flags & RUN_KEPT);
+        return;
+    }
+
+    u8 shrink = ng_shrink_table[t->scale];
+    if (!(flags & RUN_SCALED) || run->shrink != shrink) {
+        NGSpriteShrinkSet(sprite, run->length, (u16)((u16)shrink << 8 | shrink));
+        run->shrink = shrink;
+    }
+    if (!(flags & RUN_CHAINED)) {
+        chain(run, t);
+    } else if (flags & RUN_SHOW) {
+        NGSpriteYSet(sprite, t->y, 1);
+        NGSpriteXSet(sprite, t->x);
+    }
+    run->flags = RUN_KEPT;
+}
+
+static u8 needs_draw(const Run *run) {
+    if (run->flags & (RUN_TILES | RUN_ATTR | RUN_SHOW | RUN_HIDE))
+        return 1;
+    if (run->owner == NO_RUN || !texts[run->owner].visible)
+        return 0;
+    /* Scale is compared here so a text can zoom every frame */
+    return (run->flags & RUN_KEPT) != RUN_KEPT ||
+           run->shrink != ng_shrink_table[texts[run->owner].scale];
+}
+
+void _NGSpriteTextDraw(void) {
+    for (u8 r = 0; r < NG_SPRITE_TEXT_CACHE; r++) {
+        if (runs[r].length && needs_draw(&runs[r]))
+            draw_run(&runs[r]);
+    }
+}
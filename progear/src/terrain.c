@@ -7,9 +7,37 @@
 #include <terrain.h>
 #include <camera.h>
 #include <graphic.h>
+#include <ng_arena.h>
+#include <ng_bank.h>
 
 #include "sdk_internal.h"
 
+#define TILE_SHIFT  4 /* log2(NG_TILE_SIZE) */
+#define CHUNK_SHIFT 4 /* log2(NG_TERRAIN_CHUNK_SIZE) */
+#define CHUNK_MASK  (NG_TERRAIN_CHUNK_SIZE - 1)
+#define CHUNK_TILES (NG_TERRAIN_CHUNK_SIZE * NG_TERRAIN_CHUNK_SIZE)
+#define CHUNK_EMPTY 0xFFFF
+
+/* One decompressed chunk: CHUNK_TILES tile bytes, then the collision bytes */
+typedef struct {
+    u16 cx, cy; /* Chunk coordinates, cx = CHUNK_EMPTY when unused */
+    u16 used;   /* chunk_clock at last lookup, oldest goes first */
+    u8 *data;
+} TerrainChunk;
+
+#define EDIT_EMPTY 0xFFFF
+#define EDIT_TILE  0x01 /* tile overrides the asset */
+#define EDIT_COLL  0x02 /* coll overrides the asset */
+#define EDIT_SLOTS_MAX 0x4000 /* Largest table a terrain grows to */
+
+/* An edited map position, in an open-addressed hash of edit_slots slots */
+typedef struct {
+    u16 tx, ty; /* tx = EDIT_EMPTY when unused */
+    u8 tile;
+    u8 coll;
+    u8 set;
+} TerrainEdit;
+
 typedef struct {
     const NGTerrainAsset *asset;
     fixed world_x, world_y;
@@ -17,11 +45,47 @@ typedef struct {
     u8 visible;
     u8 in_scene;
     u8 active;
+    u8 camera; /* Camera it is drawn through */
 
     NGGraphic *graphic;
+
+    /* Edits over the asset, from ng_arena_state on the first one. Flat
+     * assets look them up on reads, only in columns with a bit set in
+     * edit_cols; chunked assets apply them as chunks decode. The table
+     * doubles once three quarters of its slots are used. */
+    TerrainEdit *edits;
+    u8 *edit_cols;
+    u16 edit_count;
+    u16 edit_slots; /* Power of two */
+
+    /* Packed collision index, NULL when not built (byte scan fallback).
+     * Each row holds coll_stride words of SOLID bits followed by
+     * coll_stride words of PLATFORM bits; tile x is bit (x & 15) of word x >> 4. */
+    u16 **coll_rows;
+    u16 coll_stride;
+
+    /* Palettes referenced by the asset, built once at create */
+    u8 palette_mask[32];
+
+    u8 has_collision;
+    u8 has_slopes; /* Collision data holds NG_TILE_SLOPE_L/R tiles */
+
+    /* Chunk cache (chunked assets), NULL for flat assets */
+    TerrainChunk *chunks;
+    u8 chunk_last;    /* Slot of the last lookup, checked first */
+    u8 chunk_missing; /* Window may hold chunks not yet decoded */
+    u16 chunk_clock;
+    u16 chunk_cols, chunk_rows;
+    /* Chunks under the camera plus lookahead, kept over others */
+    s16 win_cx0, win_cx1, win_cy0, win_cy1;
+    /* Chunks under a view set by NGTerrainWarmUp(), empty when cx1 < cx0 */
+    s16 warm_cx0, warm_cx1, warm_cy0, warm_cy1;
+    u8 warm_full; /* Cache cannot hold it next to the window */
 } Terrain;
 
-static Terrain terrains[NG_TERRAIN_MAX];
+/* Terrain table from ng_arena_persistent, sized at engine init */
+static Terrain *terrains;
+static u8 terrain_capacity;
 
 /** Clamp tile coordinate range to terrain asset bounds. */
 static inline void clamp_tile_bounds(const NGTerrainAsset *asset, s16 *left, s16 *right, s16 *top,
@@ -36,22 +100,532 @@ static inline void clamp_tile_bounds(const NGTerrainAsset *asset, s16 *left, s16
         *bottom = (s16)(asset->height_tiles - 1);
 }
 
+/**
+ * Build the per-row collision bitsets from the asset's collision bytes.
+ * Leaves coll_rows NULL if the state arena is too small.
+ */
+static void build_collision_index(Terrain *tm) {
+    const NGTerrainAsset *asset = tm->asset;
+    tm->coll_rows = NULL;
+    if (!NG_TERRAIN_COLLISION_INDEX || !asset->collision_data)
+        return;
+
+    u16 stride = (u16)((asset->width_tiles + 15) >> 4);
+    u16 row_words = (u16)(stride * 2);
+    u16 **rows = NG_ARENA_ALLOC_ARRAY(&ng_arena_state, u16 *, asset->height_tiles);
+    u16 *bits = NG_ARENA_ALLOC_ARRAY(&ng_arena_state, u16, (u32)row_words * asset->height_tiles);
+    if (!rows || !bits)
+        return;
+
+    const u8 *src = asset->collision_data;
+    u16 *row = bits;
+    for (u16 ty = 0; ty < asset->height_tiles; ty++) {
+        for (u16 i = 0; i < row_words; i++)
+            row[i] = 0;
+        for (u16 tx = 0; tx < asset->width_tiles; tx++) {
+            u8 coll = *src++;
+            u16 bit = (u16)(1 << (tx & 15));
+            if (coll & NG_TILE_SOLID)
+                row[tx >> 4] |= bit;
+            if (coll & NG_TILE_PLATFORM)
+                row[stride + (tx >> 4)] |= bit;
+        }
+        rows[ty] = row;
+        row += row_words;
+    }
+
+    tm->coll_stride = stride;
+    tm->coll_rows = rows;
+}
+
+/**
+ * Solid height in pixels of each pixel column of a slope tile, measured up
+ * from the tile's bottom edge. NG_TILE_SLOPE_L rises to the right.
+ */
+static const u8 slope_height[2][NG_TILE_SIZE] = {
+    {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16},
+    {16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1},
+};
+
+/** Whether an asset contains slope tiles (chunked ones say so themselves). */
+static u8 asset_has_slopes(const NGTerrainAsset *asset) {
+    if (asset->chunk_data)
+        return asset->chunk_collision && asset->chunk_slopes;
+    if (!asset->collision_data)
+        return 0;
+    u32 n = (u32)asset->width_tiles * asset->height_tiles;
+    for (u32 i = 0; i < n; i++) {
+        if (asset->collision_data[i] & (NG_TILE_SLOPE_L | NG_TILE_SLOPE_R))
+            return 1;
+    }
+    return 0;
+}
+
+/** Test whether any bit in columns [left, right] of a bitset row is set. */
+static inline u8 row_any(const u16 *row, s16 left, s16 right) {
+    if (left > right)
+        return 0;
+
+    u16 first = (u16)(left >> 4);
+    u16 last = (u16)(right >> 4);
+    u16 first_mask = (u16)(0xFFFF << (left & 15));
+    u16 last_mask = (u16)(0xFFFF >> (15 - (right & 15)));
+
+    if (first == last)
+        return (row[first] & first_mask & last_mask) != 0;
+    if (row[first] & first_mask)
+        return 1;
+    for (u16 w = (u16)(first + 1); w < last; w++) {
+        if (row[w])
+            return 1;
+    }
+    return (row[last] & last_mask) != 0;
+}
+
+/** Scan rows [top, bottom] of the collision index for SOLID tiles. */
+static u8 index_any_solid(const Terrain *tm, s16 left, s16 right, s16 top, s16 bottom) {
+    for (s16 ty = top; ty <= bottom; ty++) {
+        if (row_any(tm->coll_rows[ty], left, right))
+            return 1;
+    }
+    return 0;
+}
+
+/** Unpack one chunk's run stream (format in terrain.h) into len bytes. */
+static void decode_chunk(const u8 *src, u8 *out, u16 len) {
+    u8 *end = out + len;
+    while (out < end) {
+        u8 n = *src++;
+        u16 count = (n < 0x80) ? (u16)(n + 1) : (u16)(n - 0x7E);
+        if (count > (u16)(end - out))
+            count = (u16)(end - out);
+        if (n < 0x80) {
+            while (count--)
+                *out++ = *src++;
+        } else {
+            u8 value = *src++;
+            while (count--)
+                *out++ = value;
+        }
+    }
+}
+
+static inline u8 chunk_in_window(const Terrain *tm, const TerrainChunk *c) {
+    return c->cx != CHUNK_EMPTY && (s16)c->cx >= tm->win_cx0 && (s16)c->cx <= tm->win_cx1 &&
+           (s16)c->cy >= tm->win_cy0 && (s16)c->cy <= tm->win_cy1;
+}
+
+/**
+ * Pick the slot to decode a chunk into: an empty one, else the oldest outside
+ * the camera window, else (unless keep_window) the oldest inside it.
+ * @return Slot index, or NG_TERRAIN_CHUNK_SLOTS if every slot is in the window
+ */
+static u8 chunk_victim(const Terrain *tm, u8 keep_window) {
+    u8 best = NG_TERRAIN_CHUNK_SLOTS;
+    u8 best_outside = 0;
+    u16 best_age = 0;
+    for (u8 i = 0; i < NG_TERRAIN_CHUNK_SLOTS; i++) {
+        const TerrainChunk *c = &tm->chunks[i];
+        if (c->cx == CHUNK_EMPTY)
+            return i;
+        u8 outside = !chunk_in_window(tm, c);
+        if (!outside && keep_window)
+            continue;
+        u16 age = (u16)(tm->chunk_clock - c->used);
+        if (best == NG_TERRAIN_CHUNK_SLOTS || outside > best_outside ||
+            (outside == best_outside && age > best_age)) {
+            best = i;
+            best_outside = outside;
+            best_age = age;
+        }
+    }
+    return best;
+}
+
+static inline u16 edit_hash(u16 tx, u16 ty, u16 slots) {
+    return (u16)((tx ^ (ty << 5) ^ (ty >> 3)) & (slots - 1));
+}
+
+/** Edit at (tx, ty), or NULL. */
+static const TerrainEdit *edit_find(const Terrain *tm, u16 tx, u16 ty) {
+    u16 mask = (u16)(tm->edit_slots - 1);
+    u16 i = edit_hash(tx, ty, tm->edit_slots);
+    while (tm->edits[i].tx != tx || tm->edits[i].ty != ty) {
+        if (tm->edits[i].tx == EDIT_EMPTY)
+            return NULL;
+        i = (u16)((i + 1) & mask);
+    }
+    return &tm->edits[i];
+}
+
+/** May a flat terrain's column tx hold edits? */
+static inline u8 column_edited(const Terrain *tm, u16 tx) {
+    return tm->edit_cols && (tm->edit_cols[tx >> 3] & (1 << (tx & 7)));
+}
+
+/* NGTileOverlay for a flat terrain's graphic */
+static u8 overlay_tile(void *ctx, u16 col, u16 row, u8 tile) {
+    const TerrainEdit *e = edit_find((const Terrain *)ctx, col, row);
+    return (e && (e->set & EDIT_TILE)) ? e->tile : tile;
+}
+
+/** Slot for (tx, ty) in a table of slots: its edit, or the empty slot ending its probe. */
+static TerrainEdit *edit_slot(TerrainEdit *edits, u16 slots, u16 tx, u16 ty) {
+    u16 i = edit_hash(tx, ty, slots);
+    while (edits[i].tx != EDIT_EMPTY && (edits[i].tx != tx || edits[i].ty != ty))
+        i = (u16)((i + 1) & (slots - 1));
+    return &edits[i];
+}
+
+/**
+ * Move the edits into a new table of the given size from ng_arena_state.
+ * The old table stays allocated until the arena is reset.
+ * @return 1 on success, 0 if the arena is full
+ */
+static u8 edit_grow(Terrain *tm, u16 slots) {
+    TerrainEdit *edits = NG_ARENA_ALLOC_ARRAY(&ng_arena_state, TerrainEdit, slots);
+    if (!edits)
+        return 0;
+    for (u16 i = 0; i < slots; i++)
+        edits[i].tx = EDIT_EMPTY;
+    for (u16 i = 0; i < tm->edit_slots; i++) {
+        if (tm->edits[i].tx != EDIT_EMPTY)
+            *edit_slot(edits, slots, tm->edits[i].tx, tm->edits[i].ty) = tm->edits[i];
+    }
+    tm->edits = edits;
+    tm->edit_slots = slots;
+    return 1;
+}
+
+/**
+ * Edit at (tx, ty), added if new. The table and a flat terrain's column
+ * bits come from ng_arena_state on the first edit; the table doubles
+ * when it gets three quarters full.
+ * @return Edit, or NULL if ng_arena_state is full
+ */
+static TerrainEdit *edit_add(Terrain *tm, u16 tx, u16 ty) {
+    if (!tm->edits) {
+        u16 col_bytes = (u16)((tm->asset->width_tiles + 7) >> 3);
+        NGArenaMark mark = NGArenaSave(&ng_arena_state);
+        u8 *cols = NULL;
+        if (!tm->chunks) {
+            cols = NG_ARENA_ALLOC_ARRAY(&ng_arena_state, u8, col_bytes);
+            if (!cols)
+                return NULL;
+        }
+        tm->edit_slots = 0;
+        if (!edit_grow(tm, NG_TERRAIN_EDITS)) {
+            NGArenaRestore(&ng_arena_state, mark);
+            return NULL;
+        }
+        if (cols) {
+            for (u16 i = 0; i < col_bytes; i++)
+                cols[i] = 0;
+            _NGGraphicSetTileOverlay(tm->graphic, overlay_tile, tm, cols);
+        }
+        tm->edit_cols = cols;
+        tm->edit_count = 0;
+    }
+
+    TerrainEdit *e = edit_slot(tm->edits, tm->edit_slots, tx, ty);
+    if (e->tx != EDIT_EMPTY)
+        return e;
+    /* Three quarters full keeps probes short */
+    if (tm->edit_count >= tm->edit_slots - tm->edit_slots / 4) {
+        if (tm->edit_slots >= EDIT_SLOTS_MAX || !edit_grow(tm, (u16)(tm->edit_slots * 2)))
+            return NULL;
+        e = edit_slot(tm->edits, tm->edit_slots, tx, ty);
+    }
+    tm->edit_count++;
+    e->tx = tx;
+    e->ty = ty;
+    e->set = 0;
+    if (tm->edit_cols)
+        tm->edit_cols[tx >> 3] |= (u8)(1 << (tx & 7));
+    return e;
+}
+
+/** Write the edits inside a chunk over its freshly decoded data. */
+static void apply_edits(const Terrain *tm, TerrainChunk *c) {
+    for (u16 i = 0; i < tm->edit_slots; i++) {
+        const TerrainEdit *e = &tm->edits[i];
+        if (e->tx == EDIT_EMPTY || (e->tx >> CHUNK_SHIFT) != c->cx ||
+            (e->ty >> CHUNK_SHIFT) != c->cy)
+            continue;
+        u16 at = (u16)(((e->ty & CHUNK_MASK) << CHUNK_SHIFT) | (e->tx & CHUNK_MASK));
+        if (e->set & EDIT_TILE)
+            c->data[at] = e->tile;
+        if ((e->set & EDIT_COLL) && tm->has_collision)
+            c->data[CHUNK_TILES + at] = e->coll;
+    }
+}
+
+static void load_chunk(Terrain *tm, u8 slot, u16 cx, u16 cy) {
+    const NGTerrainAsset *asset = tm->asset;
+    TerrainChunk *c = &tm->chunks[slot];
+    u32 id = (u32)cy * tm->chunk_cols + cx;
+    NGBankSelect(asset->bank);
+    decode_chunk(asset->chunk_data + asset->chunk_offsets[id], c->data,
+                 tm->has_collision ? CHUNK_TILES * 2 : CHUNK_TILES);
+    c->cx = cx;
+    c->cy = cy;
+    c->used = ++tm->chunk_clock;
+    if (tm->edit_count)
+        apply_edits(tm, c);
+}
+
+/** Get the decompressed chunk holding tile (tx, ty), decoding it if needed. */
+static const u8 *chunk_lookup(Terrain *tm, u16 tx, u16 ty) {
+    u16 cx = tx >> CHUNK_SHIFT;
+    u16 cy = ty >> CHUNK_SHIFT;
+    TerrainChunk *c = &tm->chunks[tm->chunk_last];
+    if (c->cx == cx && c->cy == cy)
+        return c->data;
+
+    u8 slot = 0;
+    while (slot < NG_TERRAIN_CHUNK_SLOTS &&
+           (tm->chunks[slot].cx != cx || tm->chunks[slot].cy != cy))
+        slot++;
+    if (slot == NG_TERRAIN_CHUNK_SLOTS) {
+        /* The slot given up may have been a window chunk */
+        slot = chunk_victim(tm, 0);
+        load_chunk(tm, slot, cx, cy);
+        tm->chunk_missing = 1;
+    } else {
+        tm->chunks[slot].used = ++tm->chunk_clock;
+    }
+    tm->chunk_last = slot;
+    return tm->chunks[slot].data;
+}
+
+/** Tile index at (tx, ty), which must be inside the map. */
+static inline u8 tile_at(Terrain *tm, u16 tx, u16 ty) {
+    if (!tm->chunks) {
+        if (column_edited(tm, tx)) {
+            const TerrainEdit *e = edit_find(tm, tx, ty);
+            if (e && (e->set & EDIT_TILE))
+                return e->tile;
+        }
+        NGBankSelect(tm->asset->bank);
+        return tm->asset->tile_data[(u32)ty * tm->asset->width_tiles + tx];
+    }
+    return chunk_lookup(tm, tx, ty)[((ty & CHUNK_MASK) << CHUNK_SHIFT) | (tx & CHUNK_MASK)];
+}
+
+/** Collision flags at (tx, ty), which must be inside the map (has_collision set). */
+static inline u8 coll_at(Terrain *tm, u16 tx, u16 ty) {
+    if (!tm->chunks) {
+        if (column_edited(tm, tx)) {
+            const TerrainEdit *e = edit_find(tm, tx, ty);
+            if (e && (e->set & EDIT_COLL))
+                return e->coll;
+        }
+        NGBankSelect(tm->asset->bank);
+        return tm->asset->collision_data[(u32)ty * tm->asset->width_tiles + tx];
+    }
+    return chunk_lookup(tm, tx, ty)[CHUNK_TILES + (((ty & CHUNK_MASK) << CHUNK_SHIFT) |
+                                                    (tx & CHUNK_MASK))];
+}
+
+/* NGTileFetch for the terrain graphic */
+static const u8 *fetch_tile(void *ctx, u16 col, u16 row) {
+    return chunk_lookup((Terrain *)ctx, col, row) +
+           (((row & CHUNK_MASK) << CHUNK_SHIFT) | (col & CHUNK_MASK));
+}
+
+/**
+ * Allocate the chunk cache for a chunked asset from ng_arena_state.
+ * @return 1 on success, 0 if the arena is too small
+ */
+static u8 init_chunk_cache(Terrain *tm) {
+    const NGTerrainAsset *asset = tm->asset;
+    u16 bytes = tm->has_collision ? CHUNK_TILES * 2 : CHUNK_TILES;
+    TerrainChunk *chunks =
+        NG_ARENA_ALLOC_ARRAY(&ng_arena_state, TerrainChunk, NG_TERRAIN_CHUNK_SLOTS);
+    u8 *data = NG_ARENA_ALLOC_ARRAY(&ng_arena_state, u8, (u32)bytes * NG_TERRAIN_CHUNK_SLOTS);
+    if (!chunks || !data)
+        return 0;
+
+    for (u8 i = 0; i < NG_TERRAIN_CHUNK_SLOTS; i++) {
+        chunks[i].cx = CHUNK_EMPTY;
+        chunks[i].cy = CHUNK_EMPTY;
+        chunks[i].used = 0;
+        chunks[i].data = data + (u16)(i * bytes);
+    }
+
+    tm->chunks = chunks;
+    tm->chunk_last = 0;
+    tm->chunk_missing = 1;
+    tm->chunk_clock = 0;
+    tm->chunk_cols = (u16)((asset->width_tiles + CHUNK_MASK) >> CHUNK_SHIFT);
+    tm->chunk_rows = (u16)((asset->height_tiles + CHUNK_MASK) >> CHUNK_SHIFT);
+    tm->win_cx0 = 0;
+    tm->win_cx1 = -1;
+    tm->win_cy0 = 0;
+    tm->win_cy1 = -1;
+    tm->warm_cx0 = 0;
+    tm->warm_cx1 = -1;
+    tm->warm_full = 0;
+    return 1;
+}
+
+static inline u8 chunk_cached(const Terrain *tm, u16 cx, u16 cy) {
+    for (u8 i = 0; i < NG_TERRAIN_CHUNK_SLOTS; i++) {
+        if (tm->chunks[i].cx == cx && tm->chunks[i].cy == cy)
+            return 1;
+    }
+    return 0;
+}
+
+/**
+ * Decode one missing chunk of the warm-up view, once the window is complete.
+ * Gives up if the cache cannot hold the window and the warm-up view together.
+ */
+static void warm_chunks(Terrain *tm) {
+    for (s16 cy = tm->warm_cy0; cy <= tm->warm_cy1; cy++) {
+        for (s16 cx = tm->warm_cx0; cx <= tm->warm_cx1; cx++) {
+            if (chunk_cached(tm, (u16)cx, (u16)cy))
+                continue;
+
+            u8 slot = chunk_victim(tm, 1);
+            if (slot < NG_TERRAIN_CHUNK_SLOTS) {
+                const TerrainChunk *c = &tm->chunks[slot];
+                if (c->cx == CHUNK_EMPTY || (s16)c->cx < tm->warm_cx0 ||
+                    (s16)c->cx > tm->warm_cx1 || (s16)c->cy < tm->warm_cy0 ||
+                    (s16)c->cy > tm->warm_cy1) {
+                    load_chunk(tm, slot, (u16)cx, (u16)cy);
+                    return;
+                }
+            }
+            tm->warm_full = 1;
+            return;
+        }
+    }
+    /* Everything is cached; the view is warm until the camera gets there */
+    if (tm->warm_cx0 >= tm->win_cx0 && tm->warm_cx1 <= tm->win_cx1 &&
+        tm->warm_cy0 >= tm->win_cy0 && tm->warm_cy1 <= tm->win_cy1)
+        tm->warm_cx1 = (s16)(tm->warm_cx0 - 1);
+}
+
+/**
+ * Track the chunks under the terrain graphic, plus lookahead toward where
+ * the camera is heading, and decode at most one missing one per frame.
+ * A still camera keeps one chunk column of lookahead on each side; a moving
+ * one drops the trailing column and widens the window to cover the view
+ * NG_CAM_PREDICT_FRAMES ahead. Offsets are in pixels, as passed to
+ * NGGraphicSetSourceOffset(); ahead_x/ahead_y is the predicted movement.
+ * With the window complete, the frame's decode goes to a warm-up view.
+ */
+static void stream_chunks(Terrain *tm, s16 tile_offset_x, s16 tile_offset_y, s16 ahead_x,
+                          s16 ahead_y) {
+    s16 left = (s16)(tile_offset_x / NG_TILE_SIZE);
+    s16 top = (s16)(tile_offset_y / NG_TILE_SIZE);
+    s16 cx0 = (s16)((left >> CHUNK_SHIFT) - (ahead_x > 0 ? 0 : 1));
+    s16 cx1 = (s16)(((left + NG_TERRAIN_MAX_COLS - 1) >> CHUNK_SHIFT) + (ahead_x < 0 ? 0 : 1));
+    s16 cy0 = (s16)(top >> CHUNK_SHIFT);
+    s16 cy1 = (s16)((top + NG_TERRAIN_MAX_ROWS - 1) >> CHUNK_SHIFT);
+
+    s16 pred_left = (s16)((tile_offset_x + ahead_x) / NG_TILE_SIZE);
+    s16 pred_top = (s16)((tile_offset_y + ahead_y) / NG_TILE_SIZE);
+    s16 pcx0 = (s16)(pred_left >> CHUNK_SHIFT);
+    s16 pcx1 = (s16)((pred_left + NG_TERRAIN_MAX_COLS - 1) >> CHUNK_SHIFT);
+    s16 pcy0 = (s16)(pred_top >> CHUNK_SHIFT);
+    s16 pcy1 = (s16)((pred_top + NG_TERRAIN_MAX_ROWS - 1) >> CHUNK_SHIFT);
+    if (pcx0 < cx0)
+        cx0 = pcx0;
+    if (pcx1 > cx1)
+        cx1 = pcx1;
+    if (pcy0 < cy0)
+        cy0 = pcy0;
+    if (pcy1 > cy1)
+        cy1 = pcy1;
+
+    if (cx0 < 0)
+        cx0 = 0;
+    if (cx1 >= (s16)tm->chunk_cols)
+        cx1 = (s16)(tm->chunk_cols - 1);
+    if (cy0 < 0)
+        cy0 = 0;
+    if (cy1 >= (s16)tm->chunk_rows)
+        cy1 = (s16)(tm->chunk_rows - 1);
+
+    if (cx0 != tm->win_cx0 || cx1 != tm->win_cx1 || cy0 != tm->win_cy0 || cy1 != tm->win_cy1) {
+        tm->win_cx0 = cx0;
+        tm->win_cx1 = cx1;
+        tm->win_cy0 = cy0;
+        tm->win_cy1 = cy1;
+        tm->chunk_missing = 1;
+    }
+    if (!tm->chunk_missing) {
+        if (tm->warm_cx1 >= tm->warm_cx0 && !tm->warm_full)
+            warm_chunks(tm);
+        return;
+    }
+
+    /* Scan in the direction of travel: chunks in view decode before ones ahead */
+    s16 step = ahead_x < 0 ? -1 : 1;
+    for (s16 cy = cy0; cy <= cy1; cy++) {
+        for (s16 cx = step > 0 ? cx0 : cx1; cx >= cx0 && cx <= cx1; cx = (s16)(cx + step)) {
+            if (chunk_cached(tm, (u16)cx, (u16)cy))
+                continue;
+
+            /* Window larger than the cache: leave the rest to lookups */
+            u8 slot = chunk_victim(tm, 1);
+            if (slot < NG_TERRAIN_CHUNK_SLOTS)
+                load_chunk(tm, slot, (u16)cx, (u16)cy);
+            else
+                tm->chunk_missing = 0;
+            return;
+        }
+    }
+    tm->chunk_missing = 0;
+}
+
+u8 _NGTerrainSystemAlloc(NGArena *arena, u8 capacity) {
+    if (capacity > 127)
+        capacity = 127; /* Handles are s8 */
+    terrains = NG_ARENA_ALLOC_ARRAY(arena, Terrain, capacity);
+    terrain_capacity = terrains ? capacity : 0;
+    return terrain_capacity == capacity;
+}
+
 void _NGTerrainSystemInit(void) {
-    for (u8 i = 0; i < NG_TERRAIN_MAX; i++) {
+    for (u8 i = 0; i < terrain_capacity; i++) {
         terrains[i].active = 0;
         terrains[i].in_scene = 0;
         terrains[i].graphic = NULL;
+        terrains[i].coll_rows = NULL;
+        terrains[i].chunks = NULL;
+        terrains[i].edits = NULL;
+        terrains[i].edit_cols = NULL;
+        terrains[i].edit_slots = 0;
     }
 }
 
 /**
- * Sync terrain graphic with camera state.
+ * Sync terrain graphic with the selected camera.
  * Updates position and source offset based on camera viewport.
  */
-static void sync_terrain_graphic(Terrain *tm) {
-    if (!tm->graphic || !tm->asset || !tm->visible)
+static void sync_terrain_view(Terrain *tm) {
+
+    /* Terrain placed entirely outside the view gives up its sprites */
+    u32 w = (u32)tm->asset->width_tiles * NG_TILE_SIZE;
+    u32 h = (u32)tm->asset->height_tiles * NG_TILE_SIZE;
+    u8 on_screen = NGCameraIsRectVisible(tm->world_x, tm->world_y, w > 0xFFFF ? 0xFFFF : (u16)w,
+                                         h > 0xFFFF ? 0xFFFF : (u16)h);
+    NGGraphicSetVisible(tm->graphic, on_screen);
+    if (!on_screen)
         return;
 
+    /* A split view only gets the rows its band needs */
+    u16 rows = NG_TERRAIN_MAX_ROWS;
+    if (NGCameraGetViewportHeight() < SCREEN_HEIGHT) {
+        rows = (u16)(NGCameraGetVisibleHeight() / NG_TILE_SIZE + 2);
+        if (rows > NG_TERRAIN_MAX_ROWS)
+            rows = NG_TERRAIN_MAX_ROWS;
+    }
+    NGGraphicSetSize(tm->graphic, NG_TERRAIN_MAX_COLS * NG_TILE_SIZE, (u16)(rows * NG_TILE_SIZE));
+
     fixed cam_x = NGCameraGetRenderX();
     fixed cam_y = NGCameraGetRenderY();
     u8 zoom = NGCameraGetZoom();
@@ -70,17 +644,32 @@ static void sync_terrain_graphic(Terrain *tm) {
 
     NGGraphicSetPosition(tm->graphic, screen_x, screen_y);
     NGGraphicSetSourceOffset(tm->graphic, tile_offset_x, tile_offset_y);
+    if (tm->chunks) {
+        fixed pred_x, pred_y;
+        NGCameraPredict(NG_CAM_PREDICT_FRAMES, &pred_x, &pred_y);
+        stream_chunks(tm, tile_offset_x, tile_offset_y, FIX_INT(pred_x - NGCameraGetX()),
+                      FIX_INT(pred_y - NGCameraGetY()));
+    }
 
     /* Apply camera zoom as scale */
     NGGraphicSetScale(tm->graphic, NGCameraZoomToScale(zoom));
 }
 
+static void sync_terrain_graphic(Terrain *tm) {
+    if (!tm->graphic || !tm->asset || !tm->visible)
+        return;
+
+    NGCameraHandle prev = NGCameraSelect(tm->camera);
+    sync_terrain_view(tm);
+    NGCameraSelect(prev);
+}
+
 NGTerrainHandle NGTerrainCreate(const NGTerrainAsset *asset) {
     if (!asset)
         return NG_TERRAIN_INVALID;
 
     NGTerrainHandle handle = NG_TERRAIN_INVALID;
-    for (u8 i = 0; i < NG_TERRAIN_MAX; i++) {
+    for (u8 i = 0; i < terrain_capacity; i++) {
         if (!terrains[i].active) {
             handle = i;
             break;
@@ -106,26 +695,61 @@ NGTerrainHandle NGTerrainCreate(const NGTerrainAsset *asset) {
         return NG_TERRAIN_INVALID;
     }
 
+    tm->asset = asset;
+    tm->has_collision = asset->chunk_data ? asset->chunk_collision : asset->collision_data != NULL;
+    tm->chunks = NULL;
+    tm->edits = NULL;
+    tm->edit_cols = NULL;
+    tm->edit_count = 0;
+    tm->edit_slots = 0;
+    if (asset->chunk_data && !init_chunk_cache(tm)) {
+        NGGraphicDestroy(tm->graphic);
+        tm->graphic = NULL;
+        return NG_TERRAIN_INVALID;
+    }
+
     /* Configure graphic source from terrain asset */
     NGGraphicSetSourceTilemap8(tm->graphic, asset->base_tile, asset->tile_data, asset->width_tiles,
                                asset->height_tiles, asset->tile_to_palette, asset->default_palette);
+    if (tm->chunks)
+        _NGGraphicSetTileFetch(tm->graphic, fetch_tile, tm);
+    _NGGraphicSetSourceBank(tm->graphic, asset->bank);
 
     /* Initially hidden */
     NGGraphicSetVisible(tm->graphic, 0);
 
-    tm->asset = asset;
     tm->world_x = 0;
     tm->world_y = 0;
     tm->z = 0;
     tm->visible = 1;
     tm->in_scene = 0;
     tm->active = 1;
+    tm->camera = 0;
+
+    /* The index, slope scan and palette scan below read the asset's arrays */
+    NGBankSelect(asset->bank);
+    build_collision_index(tm);
+    tm->has_slopes = asset_has_slopes(asset);
+
+    /* Default palette plus every palette in the tile_to_palette lookup */
+    for (u8 i = 0; i < 32; i++)
+        tm->palette_mask[i] = 0;
+    _NGPaletteMaskSet(tm->palette_mask, asset->default_palette);
+    if (asset->tile_to_palette) {
+        for (u16 t = 0; t < 256; t++) {
+            u8 pal = asset->tile_to_palette[t];
+            if (pal > 0) {
+                _NGPaletteMaskSet(tm->palette_mask, pal);
+            }
+        }
+    }
+    _NGGraphicSetPaletteMask(tm->graphic, tm->palette_mask);
 
     return handle;
 }
 
 void NGTerrainAddToScene(NGTerrainHandle handle, fixed world_x, fixed world_y, u8 z) {
-    if (handle < 0 || handle >= NG_TERRAIN_MAX)
+    if (handle < 0 || handle >= terrain_capacity)
         return;
     Terrain *tm = &terrains[handle];
     if (!tm->active)
@@ -145,7 +769,7 @@ void NGTerrainAddToScene(NGTerrainHandle handle, fixed world_x, fixed world_y, u
 }
 
 void NGTerrainRemoveFromScene(NGTerrainHandle handle) {
-    if (handle < 0 || handle >= NG_TERRAIN_MAX)
+    if (handle < 0 || handle >= terrain_capacity)
         return;
     Terrain *tm = &terrains[handle];
     if (!tm->active)
@@ -160,7 +784,7 @@ void NGTerrainRemoveFromScene(NGTerrainHandle handle) {
 }
 
 void NGTerrainDestroy(NGTerrainHandle handle) {
-    if (handle < 0 || handle >= NG_TERRAIN_MAX)
+    if (handle < 0 || handle >= terrain_capacity)
         return;
 
     Terrain *tm = &terrains[handle];
@@ -173,10 +797,16 @@ void NGTerrainDestroy(NGTerrainHandle handle) {
 
     NGTerrainRemoveFromScene(handle);
     tm->active = 0;
+    tm->coll_rows = NULL;
+    tm->chunks = NULL;
+    tm->edits = NULL;
+    tm->edit_cols = NULL;
+    tm->edit_count = 0;
+    tm->edit_slots = 0;
 }
 
 void NGTerrainSetPos(NGTerrainHandle handle, fixed world_x, fixed world_y) {
-    if (handle < 0 || handle >= NG_TERRAIN_MAX)
+    if (handle < 0 || handle >= terrain_capacity)
         return;
     Terrain *tm = &terrains[handle];
     if (!tm->active)
@@ -187,7 +817,7 @@ void NGTerrainSetPos(NGTerrainHandle handle, fixed world_x, fixed world_y) {
 }
 
 void NGTerrainSetZ(NGTerrainHandle handle, u8 z) {
-    if (handle < 0 || handle >= NG_TERRAIN_MAX)
+    if (handle < 0 || handle >= terrain_capacity)
         return;
     Terrain *tm = &terrains[handle];
     if (!tm->active)
@@ -200,8 +830,61 @@ void NGTerrainSetZ(NGTerrainHandle handle, u8 z) {
     }
 }
 
+void NGTerrainSetCamera(NGTerrainHandle handle, u8 camera) {
+    if (handle < 0 || handle >= terrain_capacity)
+        return;
+    Terrain *tm = &terrains[handle];
+    if (!tm->active)
+        return;
+    tm->camera = camera;
+}
+
+void NGTerrainWarmUp(NGTerrainHandle handle, fixed cam_x, fixed cam_y) {
+    if (handle < 0 || handle >= terrain_capacity)
+        return;
+    Terrain *tm = &terrains[handle];
+    if (!tm->active || !tm->chunks)
+        return;
+
+    s16 left = (s16)(FIX_INT(cam_x - tm->world_x) / NG_TILE_SIZE);
+    s16 top = (s16)(FIX_INT(cam_y - tm->world_y) / NG_TILE_SIZE);
+    s16 cx0 = (s16)(left >> CHUNK_SHIFT);
+    s16 cx1 = (s16)((left + NG_TERRAIN_MAX_COLS - 1) >> CHUNK_SHIFT);
+    s16 cy0 = (s16)(top >> CHUNK_SHIFT);
+    s16 cy1 = (s16)((top + NG_TERRAIN_MAX_ROWS - 1) >> CHUNK_SHIFT);
+    if (cx0 < 0)
+        cx0 = 0;
+    if (cx1 >= (s16)tm->chunk_cols)
+        cx1 = (s16)(tm->chunk_cols - 1);
+    if (cy0 < 0)
+        cy0 = 0;
+    if (cy1 >= (s16)tm->chunk_rows)
+        cy1 = (s16)(tm->chunk_rows - 1);
+
+    tm->warm_cx0 = cx0;
+    tm->warm_cx1 = cx1;
+    tm->warm_cy0 = cy0;
+    tm->warm_cy1 = cy1;
+    tm->warm_full = 0;
+}
+
+u8 NGTerrainIsWarm(NGTerrainHandle handle) {
+    if (handle < 0 || handle >= terrain_capacity)
+        return 1;
+    Terrain *tm = &terrains[handle];
+    if (!tm->active || !tm->chunks || tm->warm_cx1 < tm->warm_cx0)
+        return 1;
+    for (s16 cy = tm->warm_cy0; cy <= tm->warm_cy1; cy++) {
+        for (s16 cx = tm->warm_cx0; cx <= tm->warm_cx1; cx++) {
+            if (!chunk_cached(tm, (u16)cx, (u16)cy))
+                return 0;
+        }
+    }
+    return 1;
+}
+
 void NGTerrainSetVisible(NGTerrainHandle handle, u8 visible) {
-    if (handle < 0 || handle >= NG_TERRAIN_MAX)
+    if (handle < 0 || handle >= terrain_capacity)
         return;
     Terrain *tm = &terrains[handle];
     if (!tm->active)
@@ -215,7 +898,7 @@ void NGTerrainSetVisible(NGTerrainHandle handle, u8 visible) {
 }
 
 void NGTerrainGetDimensions(NGTerrainHandle handle, u16 *width_out, u16 *height_out) {
-    if (handle < 0 || handle >= NG_TERRAIN_MAX) {
+    if (handle < 0 || handle >= terrain_capacity) {
         if (width_out)
             *width_out = 0;
         if (height_out)
@@ -237,10 +920,10 @@ void NGTerrainGetDimensions(NGTerrainHandle handle, u16 *width_out, u16 *height_
 }
 
 u8 NGTerrainGetCollision(NGTerrainHandle handle, fixed world_x, fixed world_y) {
-    if (handle < 0 || handle >= NG_TERRAIN_MAX)
+    if (handle < 0 || handle >= terrain_capacity)
         return 0;
     Terrain *tm = &terrains[handle];
-    if (!tm->active || !tm->asset || !tm->asset->collision_data)
+    if (!tm->active || !tm->asset || !tm->has_collision)
         return 0;
 
     s16 tile_x = FIX_INT(world_x - tm->world_x) / NG_TILE_SIZE;
@@ -251,12 +934,11 @@ u8 NGTerrainGetCollision(NGTerrainHandle handle, fixed world_x, fixed world_y) {
         return 0;
     }
 
-    u16 idx = (u16)(tile_y * tm->asset->width_tiles + tile_x);
-    return tm->asset->collision_data[idx];
+    return coll_at(tm, (u16)tile_x, (u16)tile_y);
 }
 
 u8 NGTerrainGetTileAt(NGTerrainHandle handle, u16 tile_x, u16 tile_y) {
-    if (handle < 0 || handle >= NG_TERRAIN_MAX)
+    if (handle < 0 || handle >= terrain_capacity)
         return 0;
     Terrain *tm = &terrains[handle];
     if (!tm->active || !tm->asset)
@@ -266,16 +948,15 @@ u8 NGTerrainGetTileAt(NGTerrainHandle handle, u16 tile_x, u16 tile_y) {
         return 0;
     }
 
-    u16 idx = (u16)(tile_y * tm->asset->width_tiles + tile_x);
-    return tm->asset->tile_data[idx];
+    return tile_at(tm, tile_x, tile_y);
 }
 
 u8 NGTerrainTestAABB(NGTerrainHandle handle, fixed x, fixed y, fixed half_w, fixed half_h,
                      u8 *flags_out) {
-    if (handle < 0 || handle >= NG_TERRAIN_MAX)
+    if (handle < 0 || handle >= terrain_capacity)
         return 0;
     Terrain *tm = &terrains[handle];
-    if (!tm->active || !tm->asset || !tm->asset->collision_data)
+    if (!tm->active || !tm->asset || !tm->has_collision)
         return 0;
 
     s16 left_tile = FIX_INT(x - half_w - tm->world_x) / NG_TILE_SIZE;
@@ -284,12 +965,23 @@ u8 NGTerrainTestAABB(NGTerrainHandle handle, fixed x, fixed y, fixed half_w, fix
     s16 bottom_tile = FIX_INT(y + half_h - tm->world_y) / NG_TILE_SIZE;
     clamp_tile_bounds(tm->asset, &left_tile, &right_tile, &top_tile, &bottom_tile);
 
+    /* Only the solid bit is needed: answer from the collision index */
+    if (!flags_out && tm->coll_rows)
+        return index_any_solid(tm, left_tile, right_tile, top_tile, bottom_tile);
+
     u8 result = 0;
-    for (s16 ty = top_tile; ty <= bottom_tile; ty++) {
-        for (s16 tx = left_tile; tx <= right_tile; tx++) {
-            u16 idx = (u16)(ty * tm->asset->width_tiles + tx);
-            u8 coll = tm->asset->collision_data[idx];
-            result |= coll;
+    if (tm->chunks || tm->edit_cols) {
+        for (s16 ty = top_tile; ty <= bottom_tile; ty++) {
+            for (s16 tx = left_tile; tx <= right_tile; tx++)
+                result |= coll_at(tm, (u16)tx, (u16)ty);
+        }
+    } else {
+        u16 width = tm->asset->width_tiles;
+        const u8 *row = tm->asset->collision_data + (u32)top_tile * width;
+        NGBankSelect(tm->asset->bank);
+        for (s16 ty = top_tile; ty <= bottom_tile; ty++, row += width) {
+            for (s16 tx = left_tile; tx <= right_tile; tx++)
+                result |= row[tx];
         }
     }
 
@@ -298,37 +990,115 @@ u8 NGTerrainTestAABB(NGTerrainHandle handle, fixed x, fixed y, fixed half_w, fix
     return (result & NG_TILE_SOLID) ? 1 : 0;
 }
 
-u8 NGTerrainResolveAABB(NGTerrainHandle handle, fixed *x, fixed *y, fixed half_w, fixed half_h,
-                        fixed *vel_x, fixed *vel_y) {
-    if (handle < 0 || handle >= NG_TERRAIN_MAX)
-        return NG_COLL_NONE;
-    Terrain *tm = &terrains[handle];
-    if (!tm->active || !tm->asset || !tm->asset->collision_data)
-        return NG_COLL_NONE;
+/* Terrain fields the resolver needs, read once per call or per batch */
+typedef struct {
+    Terrain *tm;
+    u16 *const *rows; /* Collision index, NULL for the byte scan */
+    u16 stride;
+    fixed ox, oy; /* Terrain world position */
+    s16 last_tx, last_ty;
+    u8 slopes;
+} ResolveCtx;
+
+static inline void resolve_ctx_init(ResolveCtx *c, Terrain *tm) {
+    c->tm = tm;
+    c->rows = tm->coll_rows;
+    c->stride = tm->coll_stride;
+    c->ox = tm->world_x;
+    c->oy = tm->world_y;
+    c->last_tx = (s16)(tm->asset->width_tiles - 1);
+    c->last_ty = (s16)(tm->asset->height_tiles - 1);
+    c->slopes = tm->has_slopes;
+}
+
+/**
+ * Stand a box on the slope under its bottom-center foot point.
+ * The foot is tested in its own tile, then, for a body moving down with
+ * the surface within reach, the tile below so it follows a slope downhill
+ * and lands flat at its foot.
+ * @return 1 if the box now stands on the slope or the ground below it
+ */
+static u8 resolve_slope(const ResolveCtx *c, fixed x, fixed *y, fixed half_h, fixed reach) {
+    s16 fx = FIX_INT(x - c->ox);
+    fixed foot = *y + half_h - c->oy;
+    s16 ty = FIX_INT(foot) >> TILE_SHIFT;
+    if (fx < 0 || (fx >> TILE_SHIFT) > c->last_tx || ty < 0 || ty > c->last_ty)
+        return 0;
+    u16 tx = (u16)(fx >> TILE_SHIFT);
+
+    for (u8 below = 0; below < 2; below++, ty++) {
+        if (ty > c->last_ty)
+            return 0;
+        u8 coll = coll_at(c->tm, tx, (u16)ty);
+        u8 h;
+        if (coll & (NG_TILE_SLOPE_L | NG_TILE_SLOPE_R)) {
+            h = slope_height[(coll & NG_TILE_SLOPE_L) ? 0 : 1][fx & (NG_TILE_SIZE - 1)];
+        } else if (below && (coll & (NG_TILE_SOLID | NG_TILE_PLATFORM))) {
+            h = NG_TILE_SIZE; /* Flat ground at the foot of a slope */
+        } else if (below || (coll & NG_TILE_SOLID)) {
+            return 0;
+        } else {
+            continue;
+        }
+        fixed surface = FIX(((ty + 1) << TILE_SHIFT) - h);
+        if (foot < surface && surface - foot > reach)
+            return 0;
+        *y = surface + c->oy - half_h - 1;
+        return 1;
+    }
+    return 0;
+}
 
+static inline void clamp_resolve_bounds(const ResolveCtx *c, s16 *left, s16 *right, s16 *top,
+                                        s16 *bottom) {
+    if (*left < 0)
+        *left = 0;
+    if (*right > c->last_tx)
+        *right = c->last_tx;
+    if (*top < 0)
+        *top = 0;
+    if (*bottom > c->last_ty)
+        *bottom = c->last_ty;
+}
+
+/** Move one AABB by its velocity, stopping at solid tiles (see NGTerrainResolveAABB()). */
+static u8 resolve_aabb(const ResolveCtx *c, fixed *x, fixed *y, fixed half_w, fixed half_h,
+                       fixed *vel_x, fixed *vel_y) {
     u8 result = NG_COLL_NONE;
+    /* Downhill the feet drop as far as the body moves sideways, plus up to
+     * half_w when leaving a ledge a corner was resting on: snap that far */
+    fixed reach = *vel_y >= 0 ? FIX_ABS(*vel_x) + half_w + FIX_ONE : -1;
     fixed new_x = *x;
     fixed new_y = *y + *vel_y;
 
     // Vertical resolution first: allows jumping to clear ground before horizontal check
     if (*vel_y != 0) {
-        s16 left_tile = FIX_INT(*x - half_w - tm->world_x) / NG_TILE_SIZE;
-        s16 right_tile = FIX_INT(*x + half_w - tm->world_x) / NG_TILE_SIZE;
-        s16 top_tile = FIX_INT(new_y - half_h - tm->world_y) / NG_TILE_SIZE;
-        s16 bottom_tile = FIX_INT(new_y + half_h - tm->world_y) / NG_TILE_SIZE;
-        clamp_tile_bounds(tm->asset, &left_tile, &right_tile, &top_tile, &bottom_tile);
+        s16 left_tile = FIX_INT(*x - half_w - c->ox) >> TILE_SHIFT;
+        s16 right_tile = FIX_INT(*x + half_w - c->ox) >> TILE_SHIFT;
+        s16 top_tile = FIX_INT(new_y - half_h - c->oy) >> TILE_SHIFT;
+        s16 bottom_tile = FIX_INT(new_y + half_h - c->oy) >> TILE_SHIFT;
+        clamp_resolve_bounds(c, &left_tile, &right_tile, &top_tile, &bottom_tile);
+
+        /* Platforms only catch a falling AABB whose bottom was above them */
+        s16 old_bottom = FIX_INT(*y + half_h - c->oy) >> TILE_SHIFT;
+        u8 falling = *vel_y > 0;
 
         u8 hit = 0;
-        for (s16 ty = top_tile; ty <= bottom_tile && !hit; ty++) {
-            for (s16 tx = left_tile; tx <= right_tile && !hit; tx++) {
-                u16 idx = (u16)(ty * tm->asset->width_tiles + tx);
-                u8 coll = tm->asset->collision_data[idx];
-
-                if (coll & NG_TILE_SOLID) {
-                    hit = 1;
-                } else if ((coll & NG_TILE_PLATFORM) && *vel_y > 0) {
-                    s16 old_bottom = FIX_INT(*y + half_h - tm->world_y) / NG_TILE_SIZE;
-                    if (old_bottom < ty) {
+        if (c->rows) {
+            u16 stride = c->stride;
+            for (s16 ty = top_tile; ty <= bottom_tile && !hit; ty++) {
+                const u16 *row = c->rows[ty];
+                hit = row_any(row, left_tile, right_tile) ||
+                      (falling && old_bottom < ty && row_any(row + stride, left_tile, right_tile));
+            }
+        } else {
+            for (s16 ty = top_tile; ty <= bottom_tile && !hit; ty++) {
+                for (s16 tx = left_tile; tx <= right_tile && !hit; tx++) {
+                    u8 coll = coll_at(c->tm, (u16)tx, (u16)ty);
+
+                    if (coll & NG_TILE_SOLID) {
+                        hit = 1;
+                    } else if ((coll & NG_TILE_PLATFORM) && falling && old_bottom < ty) {
                         hit = 1;
                     }
                 }
@@ -338,11 +1108,11 @@ u8 NGTerrainResolveAABB(NGTerrainHandle handle, fixed *x, fixed *y, fixed half_w
         if (hit) {
             if (*vel_y > 0) {
                 result |= NG_COLL_BOTTOM;
-                s16 tile_top = (s16)((bottom_tile * NG_TILE_SIZE) + FIX_INT(tm->world_y));
+                s16 tile_top = (s16)((bottom_tile << TILE_SHIFT) + FIX_INT(c->oy));
                 new_y = FIX(tile_top) - half_h - 1;
             } else {
                 result |= NG_COLL_TOP;
-                s16 tile_bottom = (s16)(((top_tile + 1) * NG_TILE_SIZE) + FIX_INT(tm->world_y));
+                s16 tile_bottom = (s16)(((top_tile + 1) << TILE_SHIFT) + FIX_INT(c->oy));
                 new_y = FIX(tile_bottom) + half_h + 1;
             }
             *vel_y = 0;
@@ -353,19 +1123,24 @@ u8 NGTerrainResolveAABB(NGTerrainHandle handle, fixed *x, fixed *y, fixed half_w
     if (*vel_x != 0) {
         new_x = *x + *vel_x;
 
-        // 2px skin avoids catching on edges
-        s16 left_tile = FIX_INT(new_x - half_w - tm->world_x) / NG_TILE_SIZE;
-        s16 right_tile = FIX_INT(new_x + half_w - tm->world_x) / NG_TILE_SIZE;
-        s16 top_tile = FIX_INT(new_y - half_h + FIX(2) - tm->world_y) / NG_TILE_SIZE;
-        s16 bottom_tile = FIX_INT(new_y + half_h - FIX(2) - tm->world_y) / NG_TILE_SIZE;
-        clamp_tile_bounds(tm->asset, &left_tile, &right_tile, &top_tile, &bottom_tile);
+        // 2px skin avoids catching on edges; on slopes the box's sides sit up
+        // to half_w below the surface under them, so the feet skip that much
+        fixed feet = (c->slopes && reach >= 0) ? FIX(2) + half_w : FIX(2);
+        s16 left_tile = FIX_INT(new_x - half_w - c->ox) >> TILE_SHIFT;
+        s16 right_tile = FIX_INT(new_x + half_w - c->ox) >> TILE_SHIFT;
+        s16 top_tile = FIX_INT(new_y - half_h + FIX(2) - c->oy) >> TILE_SHIFT;
+        s16 bottom_tile = FIX_INT(new_y + half_h - feet - c->oy) >> TILE_SHIFT;
+        clamp_resolve_bounds(c, &left_tile, &right_tile, &top_tile, &bottom_tile);
 
         u8 hit = 0;
-        for (s16 ty = top_tile; ty <= bottom_tile && !hit; ty++) {
-            for (s16 tx = left_tile; tx <= right_tile && !hit; tx++) {
-                u16 idx = (u16)(ty * tm->asset->width_tiles + tx);
-                if (tm->asset->collision_data[idx] & NG_TILE_SOLID) {
-                    hit = 1;
+        if (c->rows) {
+            hit = index_any_solid(c->tm, left_tile, right_tile, top_tile, bottom_tile);
+        } else {
+            for (s16 ty = top_tile; ty <= bottom_tile && !hit; ty++) {
+                for (s16 tx = left_tile; tx <= right_tile && !hit; tx++) {
+                    if (coll_at(c->tm, (u16)tx, (u16)ty) & NG_TILE_SOLID) {
+                        hit = 1;
+                    }
                 }
             }
         }
@@ -373,36 +1148,267 @@ u8 NGTerrainResolveAABB(NGTerrainHandle handle, fixed *x, fixed *y, fixed half_w
         if (hit) {
             if (*vel_x > 0) {
                 result |= NG_COLL_RIGHT;
-                s16 tile_left = (s16)((right_tile * NG_TILE_SIZE) + FIX_INT(tm->world_x));
+                s16 tile_left = (s16)((right_tile << TILE_SHIFT) + FIX_INT(c->ox));
                 new_x = FIX(tile_left) - half_w - 1;
             } else {
                 result |= NG_COLL_LEFT;
-                s16 tile_right = (s16)(((left_tile + 1) * NG_TILE_SIZE) + FIX_INT(tm->world_x));
+                s16 tile_right = (s16)(((left_tile + 1) << TILE_SHIFT) + FIX_INT(c->ox));
                 new_x = FIX(tile_right) + half_w + 1;
             }
             *vel_x = 0;
         }
     }
 
+    /* Slopes are passable to the tests above; one foot probe stands on them */
+    if (c->slopes && reach >= 0 && resolve_slope(c, new_x, &new_y, half_h, reach)) {
+        result |= NG_COLL_BOTTOM;
+        if (*vel_y > 0)
+            *vel_y = 0;
+    }
+
     *x = new_x;
     *y = new_y;
     return result;
 }
 
-// TODO: Implement runtime tile modification (requires RAM copy support)
-void NGTerrainSetTile(NGTerrainHandle handle, u16 tile_x, u16 tile_y, u8 tile_index) {
-    (void)handle;
-    (void)tile_x;
-    (void)tile_y;
-    (void)tile_index;
+u8 NGTerrainResolveAABB(NGTerrainHandle handle, fixed *x, fixed *y, fixed half_w, fixed half_h,
+                        fixed *vel_x, fixed *vel_y) {
+    if (handle < 0 || handle >= terrain_capacity)
+        return NG_COLL_NONE;
+    Terrain *tm = &terrains[handle];
+    if (!tm->active || !tm->asset || !tm->has_collision)
+        return NG_COLL_NONE;
+
+    ResolveCtx c;
+    resolve_ctx_init(&c, tm);
+    return resolve_aabb(&c, x, y, half_w, half_h, vel_x, vel_y);
+}
+
+u8 NGTerrainResolveBatch(NGTerrainHandle handle, const NGTerrainBatch *batch) {
+    if (!batch)
+        return 0;
+    Terrain *tm = (handle >= 0 && handle < terrain_capacity) ? &terrains[handle] : NULL;
+    if (!tm || !tm->active || !tm->asset || !tm->has_collision) {
+        if (batch->result) {
+            for (u8 i = 0; i < batch->count; i++)
+                batch->result[i] = NG_COLL_NONE;
+        }
+        return 0;
+    }
+
+    ResolveCtx c;
+    resolve_ctx_init(&c, tm);
+    fixed *x = batch->x, *y = batch->y;
+    fixed *vel_x = batch->vel_x, *vel_y = batch->vel_y;
+    const fixed *half_w = batch->half_w, *half_h = batch->half_h;
+    u8 *result = batch->result;
+    u8 hits = 0;
+    for (u8 i = 0; i < batch->count; i++) {
+        u8 r = resolve_aabb(&c, &x[i], &y[i], half_w[i], half_h[i], &vel_x[i], &vel_y[i]);
+        if (result)
+            result[i] = r;
+        if (r)
+            hits++;
+    }
+    return hits;
+}
+
+/** Test bit tx of a collision index row. */
+static inline u8 row_bit(const u16 *row, s16 tx) {
+    return (row[tx >> 4] >> (tx & 15)) & 1;
+}
+
+/**
+ * Find a blocking tile in [left, right] x [top, bottom], clamped to the map.
+ * Platforms block too when platforms is set.
+ * @return 1 with the tile in *tx_out, *ty_out, or 0 if the area is clear
+ */
+static u8 sweep_blocked(const ResolveCtx *c, s16 left, s16 right, s16 top, s16 bottom,
+                        u8 platforms, s16 *tx_out, s16 *ty_out) {
+    clamp_resolve_bounds(c, &left, &right, &top, &bottom);
+    u8 mask = platforms ? (NG_TILE_SOLID | NG_TILE_PLATFORM) : NG_TILE_SOLID;
+    for (s16 ty = top; ty <= bottom; ty++) {
+        if (c->rows) {
+            const u16 *row = c->rows[ty];
+            const u16 *plat = row + c->stride;
+            if (!row_any(row, left, right) && !(platforms && row_any(plat, left, right)))
+                continue;
+            for (s16 tx = left; tx <= right; tx++) {
+                if (row_bit(row, tx) || (platforms && row_bit(plat, tx))) {
+                    *tx_out = tx;
+                    *ty_out = ty;
+                    return 1;
+                }
+            }
+        } else {
+            for (s16 tx = left; tx <= right; tx++) {
+                if (coll_at(c->tm, (u16)tx, (u16)ty) & mask) {
+                    *tx_out = tx;
+                    *ty_out = ty;
+                    return 1;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+/**
+ * Walk the leading edges of a moving AABB across tile boundaries in the
+ * order it reaches them (a DDA over the collision grid) and stop at the
+ * first blocking tile. Fills *hit only on contact.
+ */
+static u8 sweep_aabb(const ResolveCtx *c, fixed x, fixed y, fixed half_w, fixed half_h, fixed dx,
+                     fixed dy, NGTerrainSweep *hit) {
+    fixed px = x - c->ox;
+    fixed py = y - c->oy;
+    fixed adx = FIX_ABS(dx), ady = FIX_ABS(dy);
+    s8 sx = dx > 0 ? 1 : -1;
+    s8 sy = dy > 0 ? 1 : -1;
+
+    /* Distance from each leading edge to the next tile boundary it crosses;
+     * an axis is done once that distance exceeds the move */
+    s16 col = 0, row = 0;
+    fixed dist_x = adx + 1, dist_y = ady + 1;
+    fixed inv_x = 0, inv_y = 0;
+    if (dx != 0) {
+        fixed lead = sx > 0 ? px + half_w : px - half_w;
+        col = FIX_INT(lead) >> TILE_SHIFT;
+        dist_x = sx > 0 ? FIX((col + 1) << TILE_SHIFT) - lead : lead - FIX(col << TILE_SHIFT);
+        inv_x = NGRecip(adx);
+    }
+    if (dy != 0) {
+        fixed lead = sy > 0 ? py + half_h : py - half_h;
+        row = FIX_INT(lead) >> TILE_SHIFT;
+        dist_y = sy > 0 ? FIX((row + 1) << TILE_SHIFT) - lead : lead - FIX(row << TILE_SHIFT);
+        inv_y = NGRecip(ady);
+    }
+
+    for (;;) {
+        u8 step_x = dist_x <= adx;
+        u8 step_y = dist_y <= ady;
+        if (!step_x && !step_y)
+            break;
+        fixed tx = step_x ? FIX_MUL(dist_x, inv_x) : FIX_ONE + 1;
+        fixed ty = step_y ? FIX_MUL(dist_y, inv_y) : FIX_ONE + 1;
+        s16 hit_tx, hit_ty;
+
+        if (step_x && tx <= ty) {
+            /* Leading edge enters the next column: test it over the box's rows */
+            col = (s16)(col + sx);
+            if (sx > 0 ? col > c->last_tx : col < 0) {
+                dist_x = adx + 1; /* Past the map edge: no more columns */
+                continue;
+            }
+            fixed cy = py + FIX_MUL(dy, tx);
+            if (sweep_blocked(c, col, col, FIX_INT(cy - half_h) >> TILE_SHIFT,
+                              FIX_INT(cy + half_h) >> TILE_SHIFT, 0, &hit_tx, &hit_ty)) {
+                hit->time = tx;
+                hit->normal_x = (s8)-sx;
+                hit->tile_x = (u16)hit_tx;
+                hit->tile_y = (u16)hit_ty;
+                hit->x = sx > 0 ? FIX(col << TILE_SHIFT) + c->ox - half_w - 1
+                                : FIX((col + 1) << TILE_SHIFT) + c->ox + half_w + 1;
+                hit->y = cy + c->oy;
+                return sx > 0 ? NG_COLL_RIGHT : NG_COLL_LEFT;
+            }
+            dist_x += FIX(NG_TILE_SIZE);
+        } else {
+            /* Leading edge enters the next row; platforms only stop a fall */
+            row = (s16)(row + sy);
+            if (sy > 0 ? row > c->last_ty : row < 0) {
+                dist_y = ady + 1;
+                continue;
+            }
+            fixed cx = px + FIX_MUL(dx, ty);
+            if (sweep_blocked(c, FIX_INT(cx - half_w) >> TILE_SHIFT,
+                              FIX_INT(cx + half_w) >> TILE_SHIFT, row, row, sy > 0, &hit_tx,
+                              &hit_ty)) {
+                hit->time = ty;
+                hit->normal_y = (s8)-sy;
+                hit->tile_x = (u16)hit_tx;
+                hit->tile_y = (u16)hit_ty;
+                hit->x = cx + c->ox;
+                hit->y = sy > 0 ? FIX(row << TILE_SHIFT) + c->oy - half_h - 1
+                                : FIX((row + 1) << TILE_SHIFT) + c->oy + half_h + 1;
+                return sy > 0 ? NG_COLL_BOTTOM : NG_COLL_TOP;
+            }
+            dist_y += FIX(NG_TILE_SIZE);
+        }
+    }
+    return NG_COLL_NONE;
+}
+
+u8 NGTerrainSweepAABB(NGTerrainHandle handle, fixed x, fixed y, fixed half_w, fixed half_h,
+                      fixed dx, fixed dy, NGTerrainSweep *out) {
+    NGTerrainSweep hit = {FIX_ONE, 0, 0, 0, 0, x + dx, y + dy};
+    u8 result = NG_COLL_NONE;
+    Terrain *tm = (handle >= 0 && handle < terrain_capacity) ? &terrains[handle] : NULL;
+    if (tm && tm->active && tm->asset && tm->has_collision && (dx != 0 || dy != 0)) {
+        ResolveCtx c;
+        resolve_ctx_init(&c, tm);
+        result = sweep_aabb(&c, x, y, half_w, half_h, dx, dy, &hit);
+    }
+    if (out)
+        *out = hit;
+    return result;
+}
+
+u8 NGTerrainSetTile(NGTerrainHandle handle, u16 tile_x, u16 tile_y, u8 tile_index) {
+    if (handle < 0 || handle >= terrain_capacity)
+        return 0;
+    Terrain *tm = &terrains[handle];
+    if (!tm->active || !tm->asset || tile_x >= tm->asset->width_tiles ||
+        tile_y >= tm->asset->height_tiles)
+        return 0;
+    if (tile_at(tm, tile_x, tile_y) == tile_index)
+        return 1;
+
+    TerrainEdit *e = edit_add(tm, tile_x, tile_y);
+    if (!e)
+        return 0;
+    e->tile = tile_index;
+    e->set |= EDIT_TILE;
+    if (tm->chunks) {
+        u8 *chunk = (u8 *)chunk_lookup(tm, tile_x, tile_y);
+        chunk[((tile_y & CHUNK_MASK) << CHUNK_SHIFT) | (tile_x & CHUNK_MASK)] = tile_index;
+    }
+    _NGGraphicPatchTile(tm->graphic, tile_x, tile_y);
+    return 1;
 }
 
-// TODO: Implement runtime collision modification (requires RAM copy support)
-void NGTerrainSetCollision(NGTerrainHandle handle, u16 tile_x, u16 tile_y, u8 collision) {
-    (void)handle;
-    (void)tile_x;
-    (void)tile_y;
-    (void)collision;
+u8 NGTerrainSetCollision(NGTerrainHandle handle, u16 tile_x, u16 tile_y, u8 collision) {
+    if (handle < 0 || handle >= terrain_capacity)
+        return 0;
+    Terrain *tm = &terrains[handle];
+    if (!tm->active || !tm->asset || !tm->has_collision || tile_x >= tm->asset->width_tiles ||
+        tile_y >= tm->asset->height_tiles)
+        return 0;
+    if (coll_at(tm, tile_x, tile_y) == collision)
+        return 1;
+
+    TerrainEdit *e = edit_add(tm, tile_x, tile_y);
+    if (!e)
+        return 0;
+    e->coll = collision;
+    e->set |= EDIT_COLL;
+    if (tm->chunks) {
+        u8 *chunk = (u8 *)chunk_lookup(tm, tile_x, tile_y);
+        chunk[CHUNK_TILES + (((tile_y & CHUNK_MASK) << CHUNK_SHIFT) | (tile_x & CHUNK_MASK))] =
+            collision;
+    }
+
+    if (tm->coll_rows) {
+        u16 *row = tm->coll_rows[tile_y];
+        u16 bit = (u16)(1 << (tile_x & 15));
+        u16 w = tile_x >> 4;
+        row[w] = (collision & NG_TILE_SOLID) ? (u16)(row[w] | bit) : (u16)(row[w] & ~bit);
+        w = (u16)(w + tm->coll_stride);
+        row[w] = (collision & NG_TILE_PLATFORM) ? (u16)(row[w] | bit) : (u16)(row[w] & ~bit);
+    }
+    if (collision & (NG_TILE_SLOPE_L | NG_TILE_SLOPE_R))
+        tm->has_slopes = 1;
+    return 1;
 }
 
 /**
@@ -410,7 +1416,7 @@ void NGTerrainSetCollision(NGTerrainHandle handle, u16 tile_x, u16 tile_y, u8 co
  * Called by scene before graphic system draw.
  */
 void _NGTerrainSyncGraphics(void) {
-    for (u8 i = 0; i < NG_TERRAIN_MAX; i++) {
+    for (u8 i = 0; i < terrain_capacity; i++) {
         Terrain *tm = &terrains[i];
         if (tm->active && tm->in_scene) {
             sync_terrain_graphic(tm);
@@ -420,22 +1426,12 @@ void _NGTerrainSyncGraphics(void) {
 
 /* Internal: collect palettes from all terrains in scene into bitmask */
 void _NGTerrainCollectPalettes(u8 *palette_mask) {
-    for (u8 i = 0; i < NG_TERRAIN_MAX; i++) {
+    for (u8 i = 0; i < terrain_capacity; i++) {
         Terrain *tm = &terrains[i];
         if (!tm->active || !tm->in_scene || !tm->asset)
             continue;
 
-        /* Add default palette */
-        _NGPaletteMaskSet(palette_mask, tm->asset->default_palette);
-
-        /* Add all palettes from tile_to_palette lookup */
-        if (tm->asset->tile_to_palette) {
-            for (u16 t = 0; t < 256; t++) {
-                u8 pal = tm->asset->tile_to_palette[t];
-                if (pal > 0) {
-                    _NGPaletteMaskSet(palette_mask, pal);
-                }
-            }
-        }
+        for (u8 b = 0; b < 32; b++)
+            palette_mask[b] |= tm->palette_mask[b];
     }
 }
@@ -0,0 +1,678 @@
+/*
+ * This file is part of ProGearSDK.
+ * Copyright (c) 2024-2025 ProGearSDK contributors
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <widget.h>
+#include <graphic.h>
+#include <ng_arena.h>
+#include <ng_fix.h>
+#include <ng_hardware.h>
+#include <ng_sprite.h>
+
+#include "sdk_internal.h"
+
+#define CELL_SIZE  8
+#define NO_PARENT  0xFF
+#define MAX_DIGITS 10
+
+/* SCB1 column plus the SCB2-4 words of one sprite */
+#define SPRITE_WORDS 67
+
+/* Gauge segments: a one-tile sprite each, narrowed by shrink. Empty ones
+ * wait just past the right edge of the screen. */
+#define SEGMENT_SIZE   16
+#define GAUGE_WORDS    5 /* Tile pair plus the SCB2-4 words */
+#define GAUGE_HIDDEN_X SCREEN_WIDTH
+
+enum { WIDGET_FREE, WIDGET_GROUP, WIDGET_LABEL, WIDGET_COUNTER, WIDGET_BAR, WIDGET_LIST,
+       WIDGET_SPRITE, WIDGET_GAUGE };
+
+#define FLAG_VISIBLE 0x01
+#define FLAG_DIRTY   0x02
+
+typedef struct NGWidget NGWidget;
+
+struct NGWidget {
+    u8 type;
+    u8 flags;
+    u8 parent; /* Table index, or NO_PARENT */
+    s8 x, y;   /* Cells from the parent */
+    u8 width;  /* Cells; digits of a counter, 0 for a label's text length */
+    u8 palette;
+    u8 alt_palette; /* Selected list item; zero_pad of a counter */
+    u8 count;       /* List items; sprite columns; gauge segments */
+    u16 max;        /* Bar, gauge */
+    u16 tile_full, tile_empty;
+    u32 value; /* Counter number, bar or gauge fill, list selection */
+    const char *text;
+    const char *const *items;
+    NGGraphic *graphic;
+
+    /* Cells drawn last, cleared where the next draw doesn't cover them;
+     * shown_w is 1 for a sprite or gauge on screen */
+    u8 shown_x, shown_y, shown_w, shown_h;
+
+    u16 sprite;     /* Gauge: first hardware sprite */
+    u16 shown_fill; /* Gauge: pixels filled last draw */
+};
+
+static NGWidget *widgets;
+static u8 capacity;
+static u8 draw_cursor;
+static u16 budget;
+static u8 pending;
+
+/* Sprite block gauges take their segments from */
+static u16 gauge_first;
+static u8 gauge_sprites;
+static u8 gauge_capacity;
+
+static const u32 powers_of_ten[MAX_DIGITS] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000,
+};
+
+u8 _NGWidgetSystemAlloc(NGArena *arena, u8 cap, u8 sprites) {
+    capacity = 0;
+    gauge_capacity = sprites;
+    if (!cap)
+        return 1;
+    widgets = NG_ARENA_ALLOC_ARRAY(arena, NGWidget, cap);
+    if (!widgets)
+        return 0;
+    capacity = cap;
+    return 1;
+}
+
+void _NGWidgetSystemInit(void) {
+    for (u8 i = 0; i < capacity; i++)
+        widgets[i].type = WIDGET_FREE;
+    draw_cursor = 0;
+    budget = 0;
+    pending = 0;
+}
+
+void _NGWidgetsReserveSprites(void) {
+    gauge_first = _NGGraphicReserveSprites(gauge_capacity);
+    gauge_sprites = gauge_first ? gauge_capacity : 0;
+}
+
+void _NGWidgetsReleaseGraphics(void) {
+    for (u8 i = 0; i < capacity; i++) {
+        NGWidget *w = &widgets[i];
+        w->graphic = NULL;
+        if (w->type == WIDGET_GAUGE) {
+            w->shown_w = 0;
+            w->flags |= FLAG_DIRTY;
+        }
+    }
+}
+
+static u8 index_of(NGWidgetHandle w) {
+    return (u8)(w - widgets);
+}
+
+/* Is widget i inside root (or root itself)? */
+static u8 inside(u8 i, u8 root) {
+    while (i != NO_PARENT) {
+        if (i == root)
+            return 1;
+        i = widgets[i].parent;
+    }
+    return 0;
+}
+
+/* Mark a widget and everything in it for redraw */
+static void mark_tree(NGWidgetHandle w) {
+    u8 root = index_of(w);
+    if (w->type != WIDGET_GROUP) {
+        w->flags |= FLAG_DIRTY;
+        return;
+    }
+    for (u8 i = 0; i < capacity; i++) {
+        if (widgets[i].type != WIDGET_FREE && inside(i, root))
+            widgets[i].flags |= FLAG_DIRTY;
+    }
+}
+
+static NGWidgetHandle create(u8 type, NGWidgetHandle parent, s8 x, s8 y) {
+    for (u8 i = 0; i < capacity; i++) {
+        NGWidget *w = &widgets[i];
+        if (w->type != WIDGET_FREE)
+            continue;
+        w->type = type;
+        w->flags = FLAG_VISIBLE | FLAG_DIRTY;
+        w->parent = parent ? index_of(parent) : NO_PARENT;
+        w->x = x;
+        w->y = y;
+        w->width = 0;
+        w->palette = 0;
+        w->alt_palette = 0;
+        w->count = 0;
+        w->max = 0;
+        w->value = 0;
+        w->text = NULL;
+        w->items = NULL;
+        w->graphic = NULL;
+        w->shown_w = 0;
+        w->shown_h = 0;
+        return w;
+    }
+    return NULL;
+}
+
+NGWidgetHandle NGWidgetCreateGroup(NGWidgetHandle parent, s8 x, s8 y) {
+    return create(WIDGET_GROUP, parent, x, y);
+}
+
+NGWidgetHandle NGWidgetCreateLabel(NGWidgetHandle parent, s8 x, s8 y, u8 width, u8 palette,
+                                   const char *text) {
+    NGWidgetHandle w = create(WIDGET_LABEL, parent, x, y);
+    if (w) {
+        w->width = width;
+        w->palette = palette;
+        w->text = text;
+    }
+    return w;
+}
+
+NGWidgetHandle NGWidgetCreateCounter(NGWidgetHandle parent, s8 x, s8 y, u8 digits, u8 palette,
+                                     u8 zero_pad) {
+    NGWidgetHandle w = create(WIDGET_COUNTER, parent, x, y);
+    if (w) {
+        w->width = (digits < 1) ? 1 : (digits > MAX_DIGITS) ? MAX_DIGITS : digits;
+        w->palette = palette;
+        w->alt_palette = zero_pad;
+    }
+    return w;
+}
+
+NGWidgetHandle NGWidgetCreateBar(NGWidgetHandle parent, s8 x, s8 y, u8 width, u16 max,
+                                 u16 full_tile, u16 empty_tile, u8 palette) {
+    NGWidgetHandle w = create(WIDGET_BAR, parent, x, y);
+    if (w) {
+        w->width = width;
+        w->max = max ? max : 1;
+        w->tile_full = full_tile;
+        w->tile_empty = empty_tile;
+        w->palette = palette;
+    }
+    return w;
+}
+
+NGWidgetHandle NGWidgetCreateList(NGWidgetHandle parent, s8 x, s8 y, u8 width,
+                                  const char *const *items, u8 count, u8 palette,
+                                  u8 selected_palette) {
+    NGWidgetHandle w = create(WIDGET_LIST, parent, x, y);
+    if (w) {
+        w->width = width;
+        w->items = items;
+        w->count = count;
+        w->palette = palette;
+        w->alt_palette = selected_palette;
+    }
+    return w;
+}
+
+static NGWidgetHandle create_sprite(NGWidgetHandle parent, s8 x, s8 y, const NGGraphicConfig *cfg,
+                                    const NGVisualAsset *asset, u8 palette) {
+    NGWidgetHandle w = create(WIDGET_SPRITE, parent, x, y);
+    if (!w)
+        return NULL;
+    w->graphic = NGGraphicCreate(cfg);
+    if (!w->graphic) {
+        w->type = WIDGET_FREE;
+        return NULL;
+    }
+    NGGraphicSetSource(w->graphic, asset, palette);
+    w->count = (u8)((cfg->width + 15) >> 4);
+    return w;
+}
+
+NGWidgetHandle NGWidgetCreateSprite(NGWidgetHandle parent, s8 x, s8 y,
+                                    const NGVisualAsset *asset, u8 palette) {
+    if (!asset)
+        return NULL;
+    NGGraphicConfig cfg = {.width = asset->width_pixels,
+                           .height = asset->height_pixels,
+                           .tile_mode = NG_GRAPHIC_TILE_CLIP,
+                           .layer = NG_GRAPHIC_LAYER_UI,
+                           .z_order = NG_WIDGET_Z_INDEX};
+    return create_sprite(parent, x, y, &cfg, asset, palette);
+}
+
+NGWidgetHandle NGWidgetCreatePanel(NGWidgetHandle parent, s8 x, s8 y, u8 width, u8 height,
+                                   const NGVisualAsset *asset) {
+    if (!asset)
+        return NULL;
+    NGGraphicConfig cfg = {.width = (u16)(width * CELL_SIZE),
+                           .height = (u16)(height * CELL_SIZE),
+                           .tile_mode = NG_GRAPHIC_TILE_9SLICE,
+                           .layer = NG_GRAPHIC_LAYER_UI,
+                           .z_order = NG_WIDGET_Z_INDEX - 1};
+    return create_sprite(parent, x, y, &cfg, asset, asset->palette);
+}
+
+/* First free run of count sprites in the gauge block, or 0 */
+static u16 take_sprites(u8 count) {
+    u16 start = 0;
+    while (count && start + count <= gauge_sprites) {
+        u16 next = start;
+        for (u8 i = 0; i < capacity; i++) {
+            NGWidget *g = &widgets[i];
+            if (g->type != WIDGET_GAUGE)
+                continue;
+            u16 from = (u16)(g->sprite - gauge_first);
+            if (from < start + count && from + g->count > start && from + g->count > next)
+                next = (u16)(from + g->count);
+        }
+        if (next == start)
+            return (u16)(gauge_first + start);
+        start = next;
+    }
+    return 0;
+}
+
+NGWidgetHandle NGWidgetCreateGauge(NGWidgetHandle parent, s8 x, s8 y, u8 segments, u16 max,
+                                   u16 tile, u8 palette) {
+    u16 sprite = take_sprites(segments);
+    if (!sprite)
+        return NULL;
+    NGWidgetHandle w = create(WIDGET_GAUGE, parent, x, y);
+    if (w) {
+        w->count = segments;
+        w->max = max ? max : 1;
+        w->tile_full = tile;
+        w->palette = palette;
+        w->sprite = sprite;
+        w->shown_fill = 0;
+    }
+    return w;
+}
+
+/* ============================================================
+ * Drawing
+ * ============================================================ */
+
+/* Put one fix cell, counting it if it changes */
+static u8 put(u8 x, u8 y, u16 tile, u8 palette) {
+    if (x >= NG_FIX_WIDTH || y >= NG_FIX_HEIGHT)
+        return 0;
+    if (NGFixGet(x, y) == (u16)(((u16)palette << 12) | (tile & 0x0FFF)))
+        return 0;
+    NGFixPut(x, y, tile, palette);
+    return 1;
+}
+
+/* Text padded with blank cells to width */
+static u8 put_text(u8 x, u8 y, u8 width, const char *text, u8 palette) {
+    u16 font = NGTextGetFont();
+    u8 changed = 0;
+    for (u8 i = 0; i < width; i++) {
+        u16 tile = 0;
+        if (text && *text)
+            tile = (u16)(font + (u8)*text++);
+        changed += put((u8)(x + i), y, tile, palette);
+    }
+    return changed;
+}
+
+static u8 text_len(const char *text) {
+    u8 len = 0;
+    while (text && text[len])
+        len++;
+    return len;
+}
+
+static u8 draw_counter(NGWidget *w, u8 x, u8 y) {
+    u16 font = NGTextGetFont();
+    u32 value = w->value;
+    if (w->width < MAX_DIGITS && value >= powers_of_ten[w->width])
+        value = powers_of_ten[w->width] - 1;
+
+    /* Digits by subtracting powers of ten: no division */
+    u8 changed = 0;
+    u8 leading = !w->alt_palette;
+    for (u8 i = 0; i < w->width; i++) {
+        u32 unit = powers_of_ten[w->width - 1 - i];
+        u8 digit = 0;
+        while (value >= unit) {
+            value -= unit;
+            digit++;
+        }
+        if (digit || i == w->width - 1)
+            leading = 0;
+        u16 tile = leading ? 0 : (u16)(font + '0' + digit);
+        changed += put((u8)(x + i), y, tile, w->palette);
+    }
+    return changed;
+}
+
+static u8 draw_bar(NGWidget *w, u8 x, u8 y) {
+    u8 filled = (w->value >= w->max) ? w->width : (u8)((w->value * w->width) / w->max);
+    u8 changed = 0;
+    for (u8 i = 0; i < w->width; i++)
+        changed += put((u8)(x + i), y, i < filled ? w->tile_full : w->tile_empty, w->palette);
+    return changed;
+}
+
+static u16 draw_list(NGWidget *w, u8 x, u8 y) {
+    u16 changed = 0;
+    for (u8 i = 0; i < w->count; i++) {
+        u8 pal = (i == w->value) ? w->alt_palette : w->palette;
+        changed += put_text(x, (u8)(y + i), w->width, w->items[i], pal);
+    }
+    return changed;
+}
+
+/* Clear the cells last drawn that the new rectangle doesn't cover */
+static u16 clear_uncovered(NGWidget *w, u8 x, u8 y, u8 width, u8 height) {
+    u16 changed = 0;
+    for (u8 row = 0; row < w->shown_h; row++) {
+        u8 cy = (u8)(w->shown_y + row);
+        u8 row_inside = cy >= y && cy < y + height;
+        for (u8 col = 0; col < w->shown_w; col++) {
+            u8 cx = (u8)(w->shown_x + col);
+            if (!row_inside || cx < x || cx >= x + width)
+                changed += put(cx, cy, 0, 0);
+        }
+    }
+    return changed;
+}
+
+/* Where a widget goes this draw: position from the whole parent chain,
+ * and the cells it covers, none when hidden or off the fix layer */
+typedef struct {
+    s16 x, y;
+    u8 width, height;
+    u8 visible;
+} Layout;
+
+static void layout(NGWidget *w, Layout *out) {
+    s16 x = 0, y = 0;
+    u8 visible = 1;
+    for (u8 i = index_of(w); i != NO_PARENT; i = widgets[i].parent) {
+        x += widgets[i].x;
+        y += widgets[i].y;
+        if (!(widgets[i].flags & FLAG_VISIBLE))
+            visible = 0;
+    }
+
+    u8 width = w->width;
+    u8 height = 1;
+    if (w->type == WIDGET_LABEL && !width)
+        width = text_len(w->text);
+    else if (w->type == WIDGET_LIST)
+        height = w->count;
+    if (w->type == WIDGET_GROUP || w->type == WIDGET_SPRITE || w->type == WIDGET_GAUGE ||
+        !visible || x < 0 || y < 0 || x >= NG_FIX_WIDTH || y >= NG_FIX_HEIGHT)
+        width = height = 0;
+
+    out->x = x;
+    out->y = y;
+    out->width = width;
+    out->height = height;
+    out->visible = visible;
+}
+
+/* Most VRAM words a draw can take: every cell drawn and cleared, a
+ * sprite's full columns when it appears and its position words after, or
+ * a gauge's segments set up and then two words each at most */
+static u16 draw_bound(const NGWidget *w, const Layout *l) {
+    if (w->type == WIDGET_SPRITE) {
+        if (l->visible && !w->shown_w)
+            return (u16)(w->count * SPRITE_WORDS);
+        return (u16)(w->count * 2);
+    }
+    if (w->type == WIDGET_GAUGE) {
+        if (l->visible && !w->shown_w)
+            return (u16)(w->count * GAUGE_WORDS + 1);
+        return (u16)(w->count * 2);
+    }
+    return (u16)(l->width * l->height + w->shown_w * w->shown_h);
+}
+
+/* Pixels of a gauge's segments to show */
+static u16 gauge_fill(const NGWidget *w) {
+    u16 total = (u16)(w->count * SEGMENT_SIZE);
+    if (w->value >= w->max)
+        return total;
+    return (u16)((w->value * total) / w->max);
+}
+
+/* Width of segment i at a fill, 0 when empty */
+static u8 segment_width(u16 fill, u8 i) {
+    u16 from = (u16)(i * SEGMENT_SIZE);
+    if (fill <= from)
+        return 0;
+    return (fill - from >= SEGMENT_SIZE) ? SEGMENT_SIZE : (u8)(fill - from);
+}
+
+/* Full-height shrink of a segment px pixels wide */
+static u16 segment_shrink(u8 px) {
+    return (u16)(((u16)(px - 1) << 12) | 0x0FFF);
+}
+
+/* Tiles and shrink of every segment, written when the gauge appears */
+static u16 load_gauge(NGWidget *w, u16 fill) {
+    for (u8 i = 0; i < w->count; i++) {
+        NGSpriteTileBegin((u16)(w->sprite + i));
+        NGSpriteTileWrite(w->tile_full, w->palette, 0, 0);
+    }
+    NGSpriteShrinkSet(w->sprite, w->count, NG_SPRITE_SHRINK_NONE);
+    u16 words = (u16)(w->count * 3);
+    u8 partial = (u8)(fill / SEGMENT_SIZE);
+    if (partial < w->count && (fill & (SEGMENT_SIZE - 1))) {
+        NGSpriteShrinkSet((u16)(w->sprite + partial), 1,
+                          segment_shrink(segment_width(fill, partial)));
+        words++;
+    }
+    return words;
+}
+
+/* Y and X of every segment, written when the gauge appears or moves */
+static u16 place_gauge(NGWidget *w, s16 x, s16 y, u16 fill) {
+    NGSpriteYSetUniform(w->sprite, w->count, y, 1);
+    NGSpriteXBegin(w->sprite);
+    for (u8 i = 0; i < w->count; i++)
+        NGSpriteXWriteNext(segment_width(fill, i) ? (s16)(x + i * SEGMENT_SIZE) : GAUGE_HIDDEN_X);
+    return (u16)(w->count * 2);
+}
+
+/* Rewrite only segments whose width changed: the shrink word of one that
+ * stays on, the X word of one that empties, both for one that fills.
+ * A hidden segment's shrink is stale, so it is always written again. */
+static u16 fill_gauge(NGWidget *w, s16 x, u16 fill) {
+    u16 old = w->shown_fill;
+    u8 lo = (u8)(((old < fill) ? old : fill) / SEGMENT_SIZE);
+    u8 hi = (u8)((((old > fill) ? old : fill) + SEGMENT_SIZE - 1) / SEGMENT_SIZE);
+    u16 words = 0;
+    for (u8 i = lo; i < hi; i++) {
+        u8 was = segment_width(old, i);
+        u8 now = segment_width(fill, i);
+        if (was == now)
+            continue;
+        if (!now || !was) {
+            NGSpriteXSet((u16)(w->sprite + i), now ? (s16)(x + i * SEGMENT_SIZE) : GAUGE_HIDDEN_X);
+            words++;
+        }
+        if (now) {
+            NGSpriteShrinkSet((u16)(w->sprite + i), 1, segment_shrink(now));
+            words++;
+        }
+    }
+    return words;
+}
+
+static u16 draw_gauge(NGWidget *w, const Layout *l) {
+    if (!l->visible) {
+        u16 words = 0;
+        if (w->shown_w) {
+            NGSpriteHideRange(w->sprite, w->count);
+            words = w->count;
+        }
+        w->shown_w = 0;
+        return words;
+    }
+
+    s16 x = (s16)(l->x * CELL_SIZE);
+    s16 y = (s16)(l->y * CELL_SIZE);
+    u16 fill = gauge_fill(w);
+    u16 words = 0;
+    if (!w->shown_w)
+        words = load_gauge(w, fill);
+    if (!w->shown_w || w->shown_x != (u8)l->x || w->shown_y != (u8)l->y)
+        words += place_gauge(w, x, y, fill);
+    else
+        words = fill_gauge(w, x, fill);
+    w->shown_x = (u8)l->x;
+    w->shown_y = (u8)l->y;
+    w->shown_w = 1;
+    w->shown_fill = fill;
+    return words;
+}
+
+/* Draw one widget, returning the fix cells or gauge words it changed */
+static u16 draw_widget(NGWidget *w, const Layout *l) {
+    if (w->type == WIDGET_SPRITE) {
+        if (w->graphic) {
+            NGGraphicSetPosition(w->graphic, (s16)(l->x * CELL_SIZE), (s16)(l->y * CELL_SIZE));
+            NGGraphicSetVisible(w->graphic, l->visible);
+        }
+        w->shown_w = l->visible;
+        return 0;
+    }
+    if (w->type == WIDGET_GAUGE)
+        return draw_gauge(w, l);
+
+    u8 x = (u8)l->x;
+    u8 y = (u8)l->y;
+    u16 changed = 0;
+    if (l->width) {
+        switch (w->type) {
+            case WIDGET_LABEL:
+                changed = put_text(x, y, l->width, w->text, w->palette);
+                break;
+            case WIDGET_COUNTER:
+                changed = draw_counter(w, x, y);
+                break;
+            case WIDGET_BAR:
+                changed = draw_bar(w, x, y);
+                break;
+            case WIDGET_LIST:
+                changed = draw_list(w, x, y);
+                break;
+        }
+    }
+    changed += clear_uncovered(w, x, y, l->width, l->height);
+    w->shown_x = x;
+    w->shown_y = y;
+    w->shown_w = l->width;
+    w->shown_h = l->height;
+    return changed;
+}
+
+void NGWidgetsDraw(void) {
+    u16 spent = 0;
+    pending = 0;
+    for (u8 n = 0; n < capacity; n++) {
+        u8 i = (u8)(draw_cursor + n);
+        if (i >= capacity)
+            i = (u8)(i - capacity);
+        NGWidget *w = &widgets[i];
+        if (w->type == WIDGET_FREE || !(w->flags & FLAG_DIRTY))
+            continue;
+
+        /* Past the budget: this and the rest go first next frame */
+        Layout l;
+        layout(w, &l);
+        u16 bound = draw_bound(w, &l);
+        if (budget && spent && spent + bound > budget) {
+            draw_cursor = i;
+            pending = 1;
+            return;
+        }
+        w->flags &= (u8)~FLAG_DIRTY;
+        u16 changed = draw_widget(w, &l);
+        spent = (u16)(spent + ((w->type == WIDGET_SPRITE) ? bound : changed));
+    }
+}
+
+void NGWidgetsSetBudget(u16 words) {
+    budget = words;
+}
+
+u8 NGWidgetsPending(void) {
+    return pending;
+}
+
+/* ============================================================
+ * Changes
+ * ============================================================ */
+
+void NGWidgetDestroy(NGWidgetHandle w) {
+    if (!w || w->type == WIDGET_FREE)
+        return;
+
+    u8 root = index_of(w);
+    for (u8 i = 0; i < capacity; i++) {
+        if (i != root && widgets[i].type != WIDGET_FREE && inside(i, root))
+            NGWidgetDestroy(&widgets[i]);
+    }
+
+    /* Cells go right away; the widget may not get another draw */
+    clear_uncovered(w, 0, 0, 0, 0);
+    if (w->type == WIDGET_GAUGE && w->shown_w)
+        NGSpriteHideRange(w->sprite, w->count);
+    if (w->graphic)
+        NGGraphicDestroy(w->graphic);
+    w->type = WIDGET_FREE;
+}
+
+void NGWidgetSetPosition(NGWidgetHandle w, s8 x, s8 y) {
+    if (!w || (w->x == x && w->y == y))
+        return;
+    w->x = x;
+    w->y = y;
+    mark_tree(w);
+}
+
+void NGWidgetSetVisible(NGWidgetHandle w, u8 visible) {
+    if (!w)
+        return;
+    u8 flags = visible ? (u8)(w->flags | FLAG_VISIBLE) : (u8)(w->flags & ~FLAG_VISIBLE);
+    if (flags == w->flags)
+        return;
+    w->flags = flags;
+    mark_tree(w);
+}
+
+void NGWidgetSetText(NGWidgetHandle w, const char *text) {
+    if (!w || w->type != WIDGET_LABEL)
+        return;
+    w->text = text;
+    w->flags |= FLAG_DIRTY;
+}
+
+void NGWidgetSetValue(NGWidgetHandle w, u32 value) {
+    if (!w || (w->type != WIDGET_COUNTER && w->type != WIDGET_BAR && w->type != WIDGET_GAUGE))
+        return;
+    if (w->type != WIDGET_COUNTER && value > w->max)
+        value = w->max;
+    if (w->value == value)
+        return;
+    w->value = value;
+    w->flags |= FLAG_DIRTY;
+}
+
+void NGWidgetSetSelection(NGWidgetHandle w, u8 index) {
+    if (!w || w->type != WIDGET_LIST || index >= w->count || w->value == index)
+        return;
+    w->value = index;
+    w->flags |= FLAG_DIRTY;
+}
+
+u32 NGWidgetGetValue(NGWidgetHandle w) {
+    return w ? w->value : 0;
+}
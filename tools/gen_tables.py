@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+# This file is part of ProGearSDK.
+# Copyright (c) 2024-2025 ProGearSDK contributors
+# SPDX-License-Identifier: MIT
+
+"""
+Generate the constant lookup tables declared in core/include/ng_tables.h.
+
+The core Makefile runs this into build/ng_tables.c, which is compiled into
+libneogeo_core.a like any other source. The tables end up in ROM, and the
+functions that read them (NGSin, scale_to_shrink, NGSpriteAdjustedHeight,
+...) become single indexed loads.
+
+Tables:
+  ng_sin_table           sin(i * 2pi / 2^bits) in 16.16, 2^bits entries
+  ng_recip_table         2^30 / m for 16-bit mantissas, interpolated
+  ng_rsqrt_table         32768 / sqrt(m) over [1, 4], interpolated
+  ng_atan_table          atan(i / 64) in angle units (256 per circle)
+  ng_shrink_table        graphic scale (0-256) -> 8-bit hardware shrink
+  ng_shrink_val_table    graphic scale (0-256) -> SCB2 word (h << 8 | v)
+  ng_sprite_height_table [rows][v_shrink] -> shrunk sprite height in tiles
+  ng_zoom_shrink_table   [zoom level] -> SCB2 words of 1-16 column groups
+
+Usage:
+  python3 tools/gen_tables.py -o core/build/ng_tables.c --sin-bits 10
+"""
+
+import argparse
+import math
+import sys
+
+COLUMN_LIMIT = 100
+SPRITE_MAX_HEIGHT = 32
+ZOOM_LEVELS = 9
+ZOOM_SHRINK_COLS = 16
+
+
+def format_array(decl, values):
+    """Format a 1-D C array the way clang-format lays out the SDK's tables."""
+    width = max(len(str(v)) for v in values) + 2
+    per_line = (COLUMN_LIMIT - 4 + 1) // width
+    lines = [decl + ' = {']
+    for i in range(0, len(values), per_line):
+        row = values[i:i + per_line]
+        lines.append('    ' + ''.join((str(v) + ',').ljust(width) for v in row).rstrip())
+    lines.append('};')
+    return '\n'.join(lines)
+
+
+def format_array_2d(decl, rows):
+    width = max(len(str(v)) for row in rows for v in row) + 2
+    per_line = (COLUMN_LIMIT - 8 + 1) // width
+    lines = [decl + ' = {']
+    for row in rows:
+        lines.append('    {')
+        for i in range(0, len(row), per_line):
+            chunk = row[i:i + per_line]
+            lines.append('        ' + ''.join((str(v) + ',').ljust(width) for v in chunk).rstrip())
+        lines.append('    },')
+    lines.append('};')
+    return '\n'.join(lines)
+
+
+def shrink(scale):
+    # NeoGeo shrink: 255 = full size, 0 = invisible; scale 256 = 1.0x
+    return 0 if scale == 0 else min(scale - 1, 255)
+
+
+def adjusted_height(rows, v_shrink):
+    # Ceiling of rows * v_shrink / 255, clamped to 1-32
+    return max(1, min(SPRITE_MAX_HEIGHT, (rows * v_shrink + 254) // 255))
+
+
+def shrink_group(count, shrink_val):
+    # SCB2 words of a sprite group, as NGSpriteShrinkSet() spreads them
+    h8, v = shrink_val >> 8, shrink_val & 0xFF
+    if count == 1:
+        return [((h8 >> 4) << 8) | v]
+    base, frac, error = h8 >> 4, h8 & 0x0F, count >> 1
+    words = []
+    for _ in range(count):
+        h = base
+        error += frac
+        if error >= count:
+            error -= count
+            h = min(h + 1, 15)
+        words.append((h << 8) | v)
+    return words
+
+
+def crc16(byte):
+    """CRC-16/CCITT (polynomial 0x1021) of one byte shifted into the top of a zero CRC."""
+    crc = byte << 8
+    for _ in range(8):
+        crc = ((crc << 1) ^ 0x1021 if crc & 0x8000 else crc << 1) & 0xFFFF
+    return crc
+
+
+def generate(sin_bits):
+    steps = 1 << sin_bits
+    sin = [round(math.sin(i * 2 * math.pi / steps) * 65536) for i in range(steps)]
+    recip = [round(2 ** 30 / (32768 + 128 * i)) for i in range(257)]
+    rsqrt = [round(32768 / math.sqrt(1 + i / 64)) for i in range(193)]
+    atan = [round(math.atan(i / 64) * 128 / math.pi) for i in range(65)]
+    shrinks = [shrink(s) for s in range(257)]
+    shrink_vals = [(s << 8) | s for s in shrinks]
+    heights = [[adjusted_height(r, v) for v in range(256)]
+               for r in range(SPRITE_MAX_HEIGHT + 1)]
+    zoom_shrinks = [[w for cols in range(1, ZOOM_SHRINK_COLS + 1)
+                     for w in shrink_group(cols, shrink_vals[128 + 16 * level])]
+                    for level in range(ZOOM_LEVELS)]
+    crc = [crc16(b) for b in range(256)]
+
+    parts = [
+        '/*\n'
+        ' * This file is part of ProGearSDK.\n'
+        ' * Copyright (c) 2024-2025 ProGearSDK contributors\n'
+        ' * SPDX-License-Identifier: MIT\n'
+        ' */\n'
+        '\n'
+        f'/* Generated by tools/gen_tables.py --sin-bits {sin_bits}. Do not edit. */\n'
+        '\n'
+        '#include <ng_tables.h>\n'
+        '\n'
+        f'#if NG_SIN_BITS != {sin_bits}\n'
+        '#error "ng_tables.c was generated for another NG_SIN_BITS: make clean and rebuild"\n'
+        '#endif',
+        format_array('const fixed ng_sin_table[NG_SIN_STEPS]', sin),
+        format_array('const u16 ng_recip_table[257]', recip),
+        format_array('const u16 ng_rsqrt_table[193]', rsqrt),
+        format_array('const u8 ng_atan_table[65]', atan),
+        format_array('const u8 ng_shrink_table[257]', shrinks),
+        format_array('const u16 ng_shrink_val_table[257]', shrink_vals),
+        format_array_2d('const u8 ng_sprite_height_table[33][256]', heights),
+        format_array_2d('const u16 ng_zoom_shrink_table[NG_ZOOM_SHRINK_LEVELS]'
+                        '[NG_ZOOM_SHRINK_INDEX(17)]', zoom_shrinks),
+        format_array('const u16 ng_crc16_table[256]', crc),
+    ]
+    return '\n\n'.join(parts) + '\n'
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate ProGearSDK lookup tables')
+    parser.add_argument('-o', '--output', required=True, help='C file to write')
+    parser.add_argument('--sin-bits', type=int, default=10,
+                        help='log2 of sine table entries per circle (8-12, default 10)')
+    args = parser.parse_args()
+
+    if not 8 <= args.sin_bits <= 12:
+        parser.error('--sin-bits must be between 8 and 12')
+
+    source = generate(args.sin_bits)
+    with open(args.output, 'w') as f:
+        f.write(source)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -6,6 +6,10 @@
 """
 Generate NeoGeo S-ROM (fix layer) font from simple ASCII art definitions.
 
+The same glyphs, doubled to 16x16, make the C-ROM font of sprite text
+(progear/include/spritetext.h); progear_assets.py stores them from the
+`fonts` section of assets.yaml with sprite_font_tiles().
+
 S-ROM tile format:
 - 8x8 pixels, 4bpp (16 colors)
 - 32 bytes per tile
@@ -1002,6 +1006,23 @@ def char_to_pixels(char):
     return pixels
 
 
+def sprite_glyph_pixels(char, color=1):
+    """Character doubled to a 16x16 sprite tile: 256 indexed bytes, row-major"""
+    pixels = bytearray(256)
+    for y, row in enumerate(char_to_pixels(char)):
+        for x, on in enumerate(row):
+            if on:
+                for dy in (0, 16):
+                    pixels[(y * 2) * 16 + dy + x * 2] = color
+                    pixels[(y * 2) * 16 + dy + x * 2 + 1] = color
+    return bytes(pixels)
+
+
+def sprite_font_tiles(color=1):
+    """Sprite tiles for ASCII 32-127, in order (tile 0 = space)"""
+    return [sprite_glyph_pixels(chr(i), color) for i in range(32, 128)]
+
+
 def generate_srom(output_file, size_kb=128, bios_sfix=None):
     """Generate a complete S-ROM with font tiles
 
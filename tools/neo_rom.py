@@ -40,6 +40,9 @@ STD_M_SIZE = 131072    # 128KB
 STD_V_SIZE = 2097152   # 2MB
 STD_C_SIZE = 2097152   # 2MB (interleaved C1+C2, 1MB each)
 
+# P-ROMs past the first megabyte hold whole P2 banks (see ng_bank.h)
+P_BANK_SIZE = 1048576  # 1MB
+
 
 def pad_to_size(data, target_size):
     """Pad data with zeros to reach target size."""
@@ -143,6 +146,8 @@ def build_neo_file(output_path, p1_path, s1_path, m1_path, v1_path, c1_path, c2_
 
     # Pad ROMs to standard NeoGeo sizes
     p_data = pad_to_size(p_data, STD_P_SIZE)
+    if len(p_data) > P_BANK_SIZE:
+        p_data = pad_to_size(p_data, -(-len(p_data) // P_BANK_SIZE) * P_BANK_SIZE)
     s_data = pad_to_size(s_data, STD_S_SIZE)
     m_data = pad_to_size(m_data, STD_M_SIZE)
     v1_data = pad_to_size(v1_data, STD_V_SIZE)
@@ -35,6 +35,13 @@ YAML format:
         animations:
           spin: { frames: [0-15], speed: 1, loop: true }
 
+      # Tiles identical to (or mirrors of) tiles already stored are shared
+      # across all assets. Tilesets named by a tilemap are always stored
+      # as-is; dedupe: false does the same for any other asset.
+      - name: title_card
+        source: assets/title.png
+        dedupe: false
+
     # Sound effects (ADPCM-A: 18.5kHz, 6 channels, short samples)
     sound_effects:
       - name: jump
@@ -47,17 +54,37 @@ YAML format:
       - name: theme
         source: assets/audio/theme.wav
         sample_rate: 22050   # optional, default 22050
+
+    # Sprite text fonts: genfont.py glyphs as 16x16 tiles for ASCII 32-127,
+    # stored in order; NGFONT_<NAME> is the tile of the space character
+    fonts:
+      - name: big
+        color: 1             # optional palette color of the ink, default 1
+
+    # Binary files packed with LZ4 for ng_decomp.h: NGData_<name>[] and
+    # NGDATA_<NAME>_SIZE, the unpacked size
+    data:
+      - name: chapter2
+        source: assets/chapter2.bin
+        bank: 1              # optional P-ROM bank, see ng_bank.h
 """
 
 import argparse
+import hashlib
+import itertools
 import os
+import pickle
 import sys
 import re
 import struct
 import wave
 import xml.etree.ElementTree as ET
+from array import array
+from concurrent.futures import ProcessPoolExecutor
 from pathlib import Path
 
+import genfont
+
 try:
     import yaml
 except ImportError:
@@ -160,15 +187,66 @@ class ADPCM_A:
         return self.encode(samples12)
 
     def encode(self, samples12):
-        """Encode 12-bit samples to ADPCM-A."""
+        """
+        Encode 12-bit samples to ADPCM-A.
+        Same output as _encode_sample() per sample, with the state kept in
+        locals and the decode step read from tables.
+        """
         self.reset()
         # Pad to 512-sample boundary (256 bytes)
         pad_len = ((len(samples12) + 511) // 512) * 512
-        padding = [0] * (pad_len - len(samples12))
-        adpcms = [self._encode_sample(s) for s in samples12 + padding]
+        samples = itertools.chain(samples12, itertools.repeat(0, pad_len - len(samples12)))
+
+        step_size = self.STEP_SIZE
+        quant_diff = self.QUANT_DIFF
+        next_index = self.NEXT_INDEX
+        predicted = self.sample12
+        index = self.step_index
+        adpcms = [0] * pad_len
+
+        for i, sample in enumerate(samples):
+            diff = sample - predicted
+            threshold = step_size[index]
+            if diff < 0:
+                sign = 8
+                diff = -diff
+            else:
+                sign = 0
+
+            if diff >= threshold:
+                magnitude = 4
+                diff -= threshold
+            else:
+                magnitude = 0
+            if diff >= threshold >> 1:
+                magnitude |= 2
+                diff -= threshold >> 1
+            if diff >= threshold >> 2:
+                magnitude |= 1
+
+            k = index * 8 + magnitude
+            if sign:
+                predicted -= quant_diff[k]
+                if predicted < -2048:
+                    predicted = -2048
+            else:
+                predicted += quant_diff[k]
+                if predicted > 2047:
+                    predicted = 2047
+            index = next_index[k]
+            adpcms[i] = sign | magnitude
+
+        self.sample12 = predicted
+        self.step_index = index
         return adpcms
 
 
+# Per (step_index * 8 + magnitude): decoded difference and next step index
+ADPCM_A.QUANT_DIFF = [((2 * m + 1) * step) >> 3 for step in ADPCM_A.STEP_SIZE for m in range(8)]
+ADPCM_A.NEXT_INDEX = [max(0, min(i + ADPCM_A.STEP_ADJ[m], 48))
+                      for i in range(len(ADPCM_A.STEP_SIZE)) for m in range(8)]
+
+
 class ADPCM_B:
     """
     YM2610 ADPCM-B encoder for music.
@@ -219,12 +297,48 @@ class ADPCM_B:
         return self.encode(samples)
 
     def encode(self, samples16):
-        """Encode 16-bit samples to ADPCM-B."""
+        """
+        Encode 16-bit samples to ADPCM-B.
+        Same output as _encode_sample() per sample, with the state kept in
+        locals. (|diff| << 16) // (step << 14) is computed as (|diff| << 2) // step.
+        """
         self.reset()
         # Pad to 512-sample boundary (256 bytes)
         pad_len = ((len(samples16) + 511) // 512) * 512
-        padding = [0] * (pad_len - len(samples16))
-        adpcms = [self._encode_sample(s) for s in list(samples16) + padding]
+        samples = itertools.chain(samples16, itertools.repeat(0, pad_len - len(samples16)))
+
+        step_table = self.STEP_TABLE
+        predicted = self.sample16
+        step = self.step_size
+        adpcms = [0] * pad_len
+
+        for i, sample in enumerate(samples):
+            diff = sample - predicted
+            if diff < 0:
+                magnitude = (-diff << 2) // step
+                if magnitude > 7:
+                    magnitude = 7
+                predicted -= ((2 * magnitude + 1) * step) >> 3
+                if predicted < -32768:
+                    predicted = -32768
+                adpcms[i] = 8 | magnitude
+            else:
+                magnitude = (diff << 2) // step
+                if magnitude > 7:
+                    magnitude = 7
+                predicted += ((2 * magnitude + 1) * step) >> 3
+                if predicted > 32767:
+                    predicted = 32767
+                adpcms[i] = magnitude
+
+            step = (step * step_table[magnitude]) >> 6
+            if step < 127:
+                step = 127
+            elif step > 24576:
+                step = 24576
+
+        self.sample16 = predicted
+        self.step_size = step
         return adpcms
 
 
@@ -256,8 +370,11 @@ def load_wav_file(source_path, yaml_dir, target_rate=None):
         samples = [(s - 128) << 8 for s in samples]  # Convert to 16-bit signed
     elif sample_width == 2:
         # 16-bit signed
-        samples = struct.unpack(f'<{len(raw_data)//2}h', raw_data)
-        samples = list(samples)
+        samples = array('h')
+        samples.frombytes(raw_data[:len(raw_data) & ~1])
+        if sys.byteorder == 'big':
+            samples.byteswap()
+        samples = samples.tolist()
     elif sample_width == 3:
         # 24-bit signed - extract high 16 bits
         if len(raw_data) % 3 != 0:
@@ -284,10 +401,7 @@ def load_wav_file(source_path, yaml_dir, target_rate=None):
 
     # Convert stereo to mono
     if channels == 2:
-        mono_samples = []
-        for i in range(0, len(samples), 2):
-            mono_samples.append((samples[i] + samples[i + 1]) // 2)
-        samples = mono_samples
+        samples = [(l + r) // 2 for l, r in zip(samples[0::2], samples[1::2])]
 
     # Resample if needed
     if target_rate and sample_rate != target_rate:
@@ -303,31 +417,32 @@ def resample_audio(samples, src_rate, dst_rate):
         return samples
 
     ratio = src_rate / dst_rate
-    out_len = int(len(samples) / ratio)
-    result = []
+    n_samples = len(samples)
+    out_len = int(n_samples / ratio)
+    result = [0] * out_len
 
     for i in range(out_len):
         src_pos = i * ratio
         src_idx = int(src_pos)
         frac = src_pos - src_idx
 
-        if src_idx + 1 < len(samples):
+        if src_idx + 1 < n_samples:
             sample = int(samples[src_idx] * (1 - frac) + samples[src_idx + 1] * frac)
         else:
-            sample = samples[src_idx] if src_idx < len(samples) else 0
+            sample = samples[src_idx] if src_idx < n_samples else 0
 
-        result.append(max(-32768, min(32767, sample)))
+        if sample < -32768:
+            sample = -32768
+        elif sample > 32767:
+            sample = 32767
+        result[i] = sample
 
     return result
 
 
 def pack_adpcm(adpcm_nibbles):
     """Pack 4-bit ADPCM nibbles into bytes (2 nibbles per byte)."""
-    packed = []
-    for i in range(0, len(adpcm_nibbles), 2):
-        byte = (adpcm_nibbles[i] << 4) | adpcm_nibbles[i + 1]
-        packed.append(byte)
-    return bytes(packed)
+    return bytes([(hi << 4) | lo for hi, lo in zip(adpcm_nibbles[0::2], adpcm_nibbles[1::2])])
 
 
 def calculate_delta_n(sample_rate):
@@ -615,6 +730,90 @@ def tile_to_crom(tile):
     return bytes(c1_data), bytes(c2_data)
 
 
+def flip_tile(pixels, hflip, vflip):
+    """Flip a 16x16 tile given as 256 indexed pixel bytes (row-major)."""
+    rows = [pixels[y * 16:(y + 1) * 16] for y in range(16)]
+    if vflip:
+        rows.reverse()
+    if hflip:
+        rows = [row[::-1] for row in rows]
+    return b''.join(rows)
+
+
+# Tilemap entry offsets are 12 bits (NG_TILE_MASK)
+TILEMAP_MAX_OFFSET = 0x0FFF
+
+
+class TilePool:
+    """
+    C-ROM tiles shared by every visual asset.
+
+    Each distinct tile is stored once. A tile that is an H, V or HV flipped
+    copy of a stored tile is drawn from it with the hardware flip bits.
+    """
+
+    def __init__(self, first_tile, c1_data, c2_data):
+        self.next_tile = first_tile
+        self.c1_data = c1_data
+        self.c2_data = c2_data
+        self.lookup = {}  # pixels -> (tile, hflip, vflip) that draws them
+        self.group_lookup = {}  # auto-animation frames -> first tile of the group
+        self.reused = 0
+
+    def add(self, pixels, dedupe=True, min_tile=0):
+        """
+        Get a tile that draws pixels (256 indexed bytes), storing it if needed.
+
+        dedupe: reuse a stored tile (False appends unconditionally)
+        min_tile: lowest reusable tile, keeps an asset's offsets in 12 bits
+
+        Returns: (tile, hflip, vflip)
+        """
+        if dedupe:
+            hit = self.lookup.get(pixels)
+            if hit is not None and hit[0] >= min_tile:
+                self.reused += 1
+                return hit
+
+        tile = self.next_tile
+        self.next_tile += 1
+        rows = [pixels[y * 16:(y + 1) * 16] for y in range(16)]
+        c1, c2 = tile_to_crom(rows)
+        self.c1_data.extend(c1)
+        self.c2_data.extend(c2)
+
+        # Newest copy wins so later assets reuse nearby tiles; unflipped last
+        # so symmetric tiles are drawn without flip bits
+        for hflip, vflip in ((True, True), (False, True), (True, False), (False, False)):
+            self.lookup[flip_tile(pixels, hflip, vflip)] = (tile, hflip, vflip)
+        return (tile, False, False)
+
+    def add_group(self, frames, dedupe=True):
+        """
+        Store one tile per auto-animation frame, consecutively from a tile
+        number aligned to len(frames) (4 or 8), as the LSPC replaces the low
+        bits of the tile number with its frame counter. The gap before the
+        group is padded with blank tiles.
+
+        frames: pixels (256 indexed bytes) of the tile in each frame
+        dedupe: reuse an identical group stored earlier
+
+        Returns: first tile of the group
+        """
+        key = tuple(frames)
+        if dedupe and key in self.group_lookup:
+            self.reused += len(frames)
+            return self.group_lookup[key]
+
+        while self.next_tile % len(frames):
+            self.add(bytes(256), dedupe=False)
+        first = self.next_tile
+        for pixels in frames:
+            self.add(pixels, dedupe=False)
+        self.group_lookup[key] = first
+        return first
+
+
 def rgb5_to_neogeo_color(r, g, b):
     """Convert 5-bit RGB to NeoGeo 16-bit color format."""
     r_lsb = r & 1
@@ -685,27 +884,88 @@ def process_palette_def(pal_name, pal_def, yaml_dir):
         )
 
 
-def process_visual_asset(asset_def, yaml_dir, base_tile, palette_registry):
+def visual_palette_colors(asset_def, palette_registry):
     """
-    Process a visual asset definition.
-    Returns: (tiles_c1, tiles_c2, palette, asset_info, tile_count)
+    Get the named palette a visual asset is indexed with, or None if its
+    palette is built from its own pixels.
+    """
+    palette_ref = asset_def.get('palette')
+    if isinstance(palette_ref, str) and palette_ref in palette_registry:
+        return palette_registry[palette_ref]['colors']
+    return None
 
-    palette_registry: dict of {name: {'index': int, 'colors': [(r,g,b)...]}}
+
+# Palettes from here up are lent out at run time (NG_PAL_SLOT_FIRST in
+# ng_palette.h); asset palettes must stay below
+PALETTE_SLOT_FIRST = 256 - 1 - 32
+
+
+def merge_auto_palettes(visual_assets, decoded_list, palette_registry):
     """
-    name = asset_def.get('name')
-    if not name:
-        raise ProgearAssetsError("Visual asset missing 'name' field")
+    Pick a palette for each asset whose palette is built from its pixels:
+    an explicit palette or a larger auto palette holding every color it
+    uses, else its own. Identical palettes are the simplest case. Assets
+    with palette_merge: false keep their own palette, and nothing else
+    shares it.
 
-    source = asset_def.get('source')
-    if not source:
-        raise ProgearAssetsError(f"Visual asset '{name}' missing 'source' field")
+    decoded_list: decode_visual_asset() results in visual_assets order
+    (None or an error for assets that failed)
 
-    # Palette can be:
-    # - omitted: auto-generate from image, auto-assign index
-    # - string: reference to explicit palette in registry
-    # - int: legacy support for manual index (will auto-generate palette data)
-    palette_ref = asset_def.get('palette')
+    Returns: {asset_name: (palette_name, colors)}
+    """
+    targets = [(name, info['colors'], set(info['colors'][1:]))
+               for name, info in palette_registry.items() if not name.startswith('_')]
+    own = []
+    for asset_def, decoded in zip(visual_assets, decoded_list):
+        if asset_def.get('palette') is None and isinstance(decoded, dict) and asset_def.get('name'):
+            own.append((asset_def['name'], decoded['palette'], asset_def.get('palette_merge', True)))
+
+    merged = {}
+    for name, colors, share in sorted(own, key=lambda o: -len(o[1])):
+        wanted = set(colors[1:])
+        target = None
+        if share:
+            target = next(((t_name, t_colors) for t_name, t_colors, t_set in targets
+                           if wanted <= t_set), None)
+        if target is None:
+            target = (name, colors)
+            if share:
+                targets.append((name, colors, wanted))
+        merged[name] = target
+    return merged
+
+
+def remap_to_palette(decoded, shared_colors):
+    """Re-index a decoded asset's frames for a palette holding all its colors"""
+    lookup = {color: i for i, color in reversed(list(enumerate(shared_colors)))}
+    table = bytearray(256)
+    for i, color in enumerate(decoded['palette'][1:], 1):
+        table[i] = lookup[color]
+    return dict(decoded, palette=shared_colors,
+                frames=[bytes(frame).translate(table) for frame in decoded['frames']])
+
+
+def palette_index(palette_registry, ref, owner):
+    """Palette index for a palette name (asset palettes included) or number"""
+    if isinstance(ref, int):
+        return ref
+    ref = palette_registry.get('_aliases', {}).get(ref, ref)
+    if ref not in palette_registry or ref.startswith('_'):
+        raise ProgearAssetsError(f"{owner} references unknown palette '{ref}'")
+    return palette_registry[ref]['index']
+
+
+def decode_visual_asset(name, source, yaml_dir, frame_size, palette_colors):
+    """
+    Load a visual asset's image and convert it to palette indices.
+    This is the slow part of visual processing; it depends only on its
+    arguments, so it can run in a worker process and be cached.
 
+    palette_colors: palette to index with, or None to build one from the image
+
+    Returns: dict with frame_width, frame_height, frame_count, palette and
+    frames (one bytes of row-major palette indices per frame)
+    """
     # Load image
     img, source_path = load_and_validate_image(source, yaml_dir)
     img_width, img_height = img.size
@@ -717,7 +977,6 @@ def process_visual_asset(asset_def, yaml_dir, base_tile, palette_registry):
         )
 
     # Determine if this is animated
-    frame_size = asset_def.get('frame_size')
     if frame_size:
         # Animated asset with frame_size
         if len(frame_size) != 2:
@@ -744,6 +1003,63 @@ def process_visual_asset(asset_def, yaml_dir, base_tile, palette_registry):
     # Extract frames
     frames, frame_count = extract_frames(img, frame_width, frame_height, source_path)
 
+    # Index all frames with the same palette
+    palette = palette_colors
+    if palette is None:
+        palette = build_palette_from_frames(frames, max_colors=16, asset_name=name)
+
+    return {
+        'frame_width': frame_width,
+        'frame_height': frame_height,
+        'frame_count': frame_count,
+        'palette': palette,
+        'frames': [bytes(index_frame_with_palette(frame, palette)) for frame in frames],
+    }
+
+
+def process_visual_asset(asset_def, yaml_dir, tile_pool, palette_registry, dedupe=True,
+                         decoded=None):
+    """
+    Process a visual asset definition.
+    Returns: (palette, asset_info, tile_count) where tile_count is the number
+    of tiles added to tile_pool
+
+    palette_registry: dict of {name: {'index': int, 'colors': [(r,g,b)...]}}
+    dedupe: share tiles through tile_pool (False keeps the asset's tiles
+    consecutive and column-major per frame, as terrain tilesets need)
+    decoded: result of decode_visual_asset() if already computed
+    """
+    name = asset_def.get('name')
+    if not name:
+        raise ProgearAssetsError("Visual asset missing 'name' field")
+
+    source = asset_def.get('source')
+    if not source:
+        raise ProgearAssetsError(f"Visual asset '{name}' missing 'source' field")
+
+    # Palette can be:
+    # - omitted: auto-generate from image, auto-assign index
+    # - string: reference to explicit palette in registry
+    # - int: legacy support for manual index (will auto-generate palette data)
+    palette_ref = asset_def.get('palette')
+
+    if isinstance(palette_ref, str) and palette_ref not in palette_registry:
+        raise ProgearAssetsError(
+            f"Visual asset '{name}' references unknown palette '{palette_ref}'"
+        )
+    if palette_ref is not None and not isinstance(palette_ref, (str, int)):
+        raise ProgearAssetsError(
+            f"Visual asset '{name}': palette must be string (palette name) or int (index)"
+        )
+
+    if decoded is None:
+        decoded = decode_visual_asset(name, source, yaml_dir, asset_def.get('frame_size'),
+                                      visual_palette_colors(asset_def, palette_registry))
+    frame_width = decoded['frame_width']
+    frame_height = decoded['frame_height']
+    frame_count = decoded['frame_count']
+    palette = decoded['palette']
+
     # Process animations
     animations = asset_def.get('animations', {})
     anim_defs = []
@@ -760,10 +1076,25 @@ def process_visual_asset(asset_def, yaml_dir, base_tile, palette_registry):
                 )
             speed = anim_spec.get('speed', 4)
             loop = anim_spec.get('loop', True)
+            durations = anim_spec.get('durations')
         else:
             frame_list = [anim_spec]
             speed = 4
             loop = True
+            durations = None
+
+        if durations is not None:
+            if not isinstance(durations, list) or len(durations) != len(frame_list):
+                raise ProgearAssetsError(
+                    f"Visual asset '{name}' animation '{anim_name}': "
+                    f"'durations' needs one entry per frame ({len(frame_list)})"
+                )
+            for d in durations:
+                if not isinstance(d, int) or d < 1 or d > 255:
+                    raise ProgearAssetsError(
+                        f"Visual asset '{name}' animation '{anim_name}': "
+                        f"duration {d} out of range (1-255)"
+                    )
 
         # Validate frame indices
         for f in frame_list:
@@ -779,36 +1110,33 @@ def process_visual_asset(asset_def, yaml_dir, base_tile, palette_registry):
             'frame_count': len(frame_list),
             'speed': speed,
             'loop': 1 if loop else 0,
+            'durations': durations,
         })
 
-    # Determine palette to use
-    palette_name = None  # Will be set if using a named palette
-
+    # Register the palette
     if palette_ref is None:
-        # Auto-generate palette from image, register with asset name
-        palette = build_palette_from_frames(frames, max_colors=16, asset_name=name)
-        palette_name = name  # Use asset name as palette name
+        # Auto-generated palette, registered with asset name unless
+        # merge_auto_palettes() found one to share
+        palette_name, shared = palette_registry.get('_merged', {}).get(name, (name, palette))
         if palette_name not in palette_registry:
             palette_registry[palette_name] = {
                 'index': palette_registry['_next_index'],
-                'colors': palette,
+                'colors': shared,
             }
             palette_registry['_next_index'] += 1
+        if palette_name != name:
+            palette_registry.setdefault('_aliases', {})[name] = palette_name
+            decoded = remap_to_palette(decoded, shared)
+            palette = shared
         palette_idx = palette_registry[palette_name]['index']
 
     elif isinstance(palette_ref, str):
         # Reference to explicit palette
-        if palette_ref not in palette_registry:
-            raise ProgearAssetsError(
-                f"Visual asset '{name}' references unknown palette '{palette_ref}'"
-            )
         palette_name = palette_ref
-        palette = palette_registry[palette_ref]['colors']
         palette_idx = palette_registry[palette_ref]['index']
 
-    elif isinstance(palette_ref, int):
+    else:
         # Legacy: manual index, but still generate palette data
-        palette = build_palette_from_frames(frames, max_colors=16, asset_name=name)
         palette_name = name
         # Register with specified index (may conflict - user's responsibility)
         if palette_name not in palette_registry:
@@ -818,55 +1146,71 @@ def process_visual_asset(asset_def, yaml_dir, base_tile, palette_registry):
             }
         palette_idx = palette_ref
 
-    else:
-        raise ProgearAssetsError(
-            f"Visual asset '{name}': palette must be string (palette name) or int (index)"
-        )
-
-    # Convert all frames to tiles using the same palette
-    # Tiles are organized in column-major order within each frame
-    all_c1_data = bytearray()
-    all_c2_data = bytearray()
-
+    # Convert all frames to tiles
+    # New tiles are added in column-major order within each frame
     tiles_x = frame_width // 16
     tiles_y = frame_height // 16
     tiles_per_frame = tiles_x * tiles_y
 
-    # Generate tilemap (row-major order for SDK)
-    # For each frame, map[ty * width + tx] = tile_offset
-    # C-ROM tiles are organized column-major within frame
-    tilemap = []
+    auto_anim = asset_def.get('auto_anim', 0)
+    if auto_anim:
+        if auto_anim not in (4, 8):
+            raise ProgearAssetsError(f"Visual asset '{name}': auto_anim must be 4 or 8")
+        if frame_count != auto_anim:
+            raise ProgearAssetsError(
+                f"Visual asset '{name}': auto_anim {auto_anim} needs exactly "
+                f"{auto_anim} frames (has {frame_count})"
+            )
+        if anim_defs:
+            raise ProgearAssetsError(
+                f"Visual asset '{name}': auto_anim assets are animated by the "
+                f"hardware and cannot have 'animations'"
+            )
+        first_new = tile_pool.next_tile
+        asset_info = auto_anim_asset_info(name, decoded, tile_pool, dedupe, auto_anim,
+                                          palette_name, palette_idx)
+        return palette, asset_info, tile_pool.next_tile - first_new
 
-    for frame_idx, frame in enumerate(frames):
-        indexed = index_frame_with_palette(frame, palette)
+    metasprite = asset_def.get('metasprite', False)
+    if metasprite and not dedupe:
+        raise ProgearAssetsError(
+            f"Visual asset '{name}': metasprite assets need tile dedupe"
+        )
 
-        # Generate tiles in column-major order (for C-ROM)
+    # Reused tiles must stay within 12-bit offsets of every tile this asset adds
+    first_new = tile_pool.next_tile
+    min_tile = first_new + frame_count * tiles_per_frame - 1 - TILEMAP_MAX_OFFSET
+
+    # frame_tiles[f][ty][tx] = (tile, hflip, vflip), None for a blank
+    # metasprite tile
+    frame_tiles = []
+    for indexed in decoded['frames']:
+        placed = [[None] * tiles_x for _ in range(tiles_y)]
         for tx in range(tiles_x):
             for ty in range(tiles_y):
-                tile = []
+                rows = []
                 for py in range(16):
-                    row = []
-                    for px in range(16):
-                        x = tx * 16 + px
-                        y = ty * 16 + py
-                        idx = y * frame_width + x
-                        row.append(indexed[idx])
-                    tile.append(row)
-
-                c1, c2 = tile_to_crom(tile)
-                all_c1_data.extend(c1)
-                all_c2_data.extend(c2)
-
-        # Generate tilemap entries for this frame (row-major)
-        frame_base = frame_idx * tiles_per_frame
-        for ty in range(tiles_y):
-            for tx in range(tiles_x):
-                # C-ROM tile offset = column-major within frame
-                tile_offset = tx * tiles_y + ty
-                # Add HFLIP flag for NeoGeo convention
-                tilemap.append((frame_base + tile_offset) | 0x8000)
+                    start = (ty * 16 + py) * frame_width + tx * 16
+                    rows.append(indexed[start:start + 16])
+                pixels = b''.join(rows)
+                if metasprite and not any(pixels):
+                    continue
+                placed[ty][tx] = tile_pool.add(pixels, dedupe, min_tile)
+        frame_tiles.append(placed)
+
+    parts = None
+    if metasprite:
+        tilemap, parts, frame_parts = build_metasprite(frame_tiles, tile_pool, min_tile)
+        base_tile = tilemap.pop()
+    else:
+        base_tile = min(t[0] for placed in frame_tiles for row in placed for t in row)
+
+        # Generate tilemap (row-major order for SDK), every frame in turn
+        tilemap = [tilemap_entry(placed[ty][tx], base_tile)
+                   for placed in frame_tiles
+                   for ty in range(tiles_y) for tx in range(tiles_x)]
 
-    total_tiles = frame_count * tiles_per_frame
+    total_tiles = tile_pool.next_tile - first_new
 
     asset_info = {
         'name': name,
@@ -882,8 +1226,127 @@ def process_visual_asset(asset_def, yaml_dir, base_tile, palette_registry):
         'palette_idx': palette_idx,
         'tilemap': tilemap,
     }
+    if parts is not None:
+        asset_info['tiles_per_frame'] = 0
+        asset_info['parts'] = parts
+        asset_info['frame_parts'] = frame_parts
+
+    return palette, asset_info, total_tiles
+
+
+def tilemap_entry(placed, base_tile):
+    """
+    Tilemap entry for a (tile, hflip, vflip) from TilePool.add(): offset
+    from base_tile | flip flags. HFLIP set is the NeoGeo convention for an
+    unmirrored tile, so a mirrored copy clears it.
+    """
+    tile, hflip, vflip = placed
+    entry = tile - base_tile
+    if not hflip:
+        entry |= 0x8000
+    if vflip:
+        entry |= 0x4000
+    return entry
+
+
+def build_metasprite(frame_tiles, tile_pool, min_tile):
+    """
+    Turn each frame's tile grid into column parts for NGMetaPart: one part
+    per column with any pixels, trimmed to its first and last non-blank
+    rows. Blank tiles between those share one transparent tile. Parts
+    showing the same tiles share one run in the tilemap.
+
+    Returns: (runs + [base_tile], parts, frame_parts) where parts holds
+    (x, y, tile, height) tuples and frame_parts frame_count + 1 offsets
+    """
+    blank = None
+    spans = []
+    for placed in frame_tiles:
+        frame_spans = []
+        for tx in range(len(placed[0])):
+            rows = [ty for ty in range(len(placed)) if placed[ty][tx] is not None]
+            if not rows:
+                continue
+            top, bottom = rows[0], rows[-1] + 1
+            for start in range(top, bottom, 32):
+                column = [placed[ty][tx] for ty in range(start, min(start + 32, bottom))]
+                if None in column and blank is None:
+                    blank = tile_pool.add(bytes(256), True, min_tile)
+                frame_spans.append((tx, start, [c or blank for c in column]))
+        spans.append(frame_spans)
+
+    used = [t[0] for frame_spans in spans for _, _, column in frame_spans for t in column]
+    base_tile = min(used) if used else tile_pool.next_tile
+
+    runs = []
+    run_at = {}
+    parts = []
+    frame_parts = []
+    for frame_spans in spans:
+        frame_parts.append(len(parts))
+        for tx, ty, column in frame_spans:
+            entries = tuple(tilemap_entry(t, base_tile) for t in column)
+            if entries not in run_at:
+                run_at[entries] = len(runs)
+                runs.extend(entries)
+            parts.append((tx * 16, ty * 16, run_at[entries], len(entries)))
+    frame_parts.append(len(parts))
+    if len(parts) > 0xFFFF or len(runs) > 0xFFFF:
+        raise ProgearAssetsError("Metasprite has more than 65535 parts or tiles")
+    return runs + [base_tile], parts, frame_parts
+
+
+def auto_anim_asset_info(name, decoded, tile_pool, dedupe, auto_anim, palette_name,
+                         palette_idx):
+    """
+    Lay out a hardware auto-animated asset: each tile position gets an
+    aligned group holding its tile from every frame. The tilemap has one
+    frame, pointing at the groups; the LSPC steps through the frames.
+    """
+    frame_width = decoded['frame_width']
+    frame_height = decoded['frame_height']
+    tiles_x = frame_width // 16
+    tiles_y = frame_height // 16
+
+    groups = [[None] * tiles_x for _ in range(tiles_y)]
+    for tx in range(tiles_x):
+        for ty in range(tiles_y):
+            frames = []
+            for indexed in decoded['frames']:
+                rows = []
+                for py in range(16):
+                    start = (ty * 16 + py) * frame_width + tx * 16
+                    rows.append(indexed[start:start + 16])
+                frames.append(b''.join(rows))
+            groups[ty][tx] = tile_pool.add_group(frames, dedupe)
+
+    base_tile = min(t for row in groups for t in row)
+    tilemap = []
+    for ty in range(tiles_y):
+        for tx in range(tiles_x):
+            offset = groups[ty][tx] - base_tile
+            if offset + auto_anim - 1 > TILEMAP_MAX_OFFSET:
+                raise ProgearAssetsError(
+                    f"Visual asset '{name}': auto-animation tiles span more than "
+                    f"{TILEMAP_MAX_OFFSET + 1} tiles (try dedupe: false)"
+                )
+            tilemap.append(offset | 0x8000)
 
-    return bytes(all_c1_data), bytes(all_c2_data), palette, asset_info, total_tiles
+    return {
+        'name': name,
+        'base_tile': base_tile,
+        'width_pixels': frame_width,
+        'height_pixels': frame_height,
+        'width_tiles': tiles_x,
+        'height_tiles': tiles_y,
+        'tiles_per_frame': tiles_x * tiles_y,
+        'frame_count': 1,
+        'auto_anim': auto_anim,
+        'animations': [],
+        'palette_name': palette_name,
+        'palette_idx': palette_idx,
+        'tilemap': tilemap,
+    }
 
 
 # ============================================================================
@@ -939,12 +1402,15 @@ def apply_lighting_transform(colors, brightness=1.0, tint=(0, 0, 0), saturation=
     return result
 
 
-def interpolate_palettes(start_colors, end_colors, step, total_steps):
+def interpolate_palettes(start_colors, end_colors, step, total_steps, easing=None):
     """
     Interpolate between two palettes at a given step.
     step: 0 = start, total_steps = end
+    easing: name from EASING_CURVES applied to the step fraction (default linear)
     """
     t = step / total_steps if total_steps > 0 else 1.0
+    if easing:
+        t = EASING_CURVES[easing](t)
     result = []
 
     for i, (start, end) in enumerate(zip(start_colors, end_colors)):
@@ -966,33 +1432,100 @@ def interpolate_palettes(start_colors, end_colors, step, total_steps):
     return result
 
 
+# Easing curves for preset fades: map t in [0, 1] to [0, 1]
+EASING_CURVES = {
+    'linear': lambda t: t,
+    'ease_in': lambda t: t * t,
+    'ease_out': lambda t: 1.0 - (1.0 - t) * (1.0 - t),
+    'ease_in_out': lambda t: t * t * (3.0 - 2.0 * t),
+}
+
+
+def parse_lighting_keyframes(preset_name, preset_def, fade_steps):
+    """
+    Build the keyframe list for a preset.
+
+    A preset either has top-level brightness/tint/saturation (one keyframe at
+    the end of the fade) or a 'keyframes' list, e.g. day -> dusk -> night.
+    Each keyframe may set 'at' (0.0-1.0 along the fade, default evenly
+    spaced) and 'easing' for the segment leading into it.
+
+    Returns: list of dicts {step, brightness, tint, saturation, easing},
+    starting with the implicit neutral keyframe at step 0.
+    """
+    default_easing = preset_def.get('easing', 'linear')
+    defs = preset_def.get('keyframes')
+    if defs is None:
+        defs = [{
+            'at': 1.0,
+            'brightness': preset_def.get('brightness', 1.0),
+            'tint': preset_def.get('tint', [0, 0, 0]),
+            'saturation': preset_def.get('saturation', 1.0),
+        }]
+    if not defs:
+        raise ProgearAssetsError(f"Lighting preset '{preset_name}': keyframes is empty")
+
+    keyframes = [{'step': 0, 'brightness': 1.0, 'tint': (0, 0, 0), 'saturation': 1.0,
+                  'easing': default_easing}]
+    for k, kf in enumerate(defs):
+        at = kf.get('at', (k + 1) / len(defs))
+        tint = kf.get('tint', [0, 0, 0])
+        easing = kf.get('easing', default_easing)
+        if len(tint) != 3:
+            raise ProgearAssetsError(
+                f"Lighting preset '{preset_name}': tint must be [r, g, b]"
+            )
+        if easing not in EASING_CURVES:
+            raise ProgearAssetsError(
+                f"Lighting preset '{preset_name}': unknown easing '{easing}' "
+                f"(expected one of {', '.join(EASING_CURVES)})"
+            )
+        step = int(round(at * fade_steps))
+        if not 0.0 < at <= 1.0 or step <= keyframes[-1]['step']:
+            raise ProgearAssetsError(
+                f"Lighting preset '{preset_name}': keyframe {k} 'at' must increase "
+                f"within (0, 1] by at least one fade step"
+            )
+        keyframes.append({
+            'step': step,
+            'brightness': kf.get('brightness', 1.0),
+            'tint': tuple(tint),
+            'saturation': kf.get('saturation', 1.0),
+            'easing': easing,
+        })
+
+    return keyframes
+
+
 def process_lighting_presets(presets_config, palette_registry):
     """
     Process lighting presets and generate pre-baked palette variants.
 
-    For each preset, generates fade_steps intermediate palettes between
-    the original and the fully-applied preset.
+    For each preset, generates fade_steps + 1 palettes per registered
+    palette: step 0 is the original, each keyframe is the fully applied
+    transform at its step, and steps in between are eased interpolations
+    of the neighbouring keyframe palettes.
 
     Returns: dict of {preset_name: {palette_name: [step0_colors, step1_colors, ...]}}
     """
     presets = {}
 
     for preset_name, preset_def in presets_config.items():
-        brightness = preset_def.get('brightness', 1.0)
-        tint = preset_def.get('tint', [0, 0, 0])
-        saturation = preset_def.get('saturation', 1.0)
         fade_steps = preset_def.get('fade_steps', 1)
-
-        if len(tint) != 3:
+        if not 1 <= fade_steps <= 255:
             raise ProgearAssetsError(
-                f"Lighting preset '{preset_name}': tint must be [r, g, b]"
+                f"Lighting preset '{preset_name}': fade_steps must be 1-255"
             )
+        keyframes = parse_lighting_keyframes(preset_name, preset_def, fade_steps)
+        final = keyframes[-1]
 
         presets[preset_name] = {
-            'brightness': brightness,
-            'tint': tuple(tint),
-            'saturation': saturation,
+            'brightness': final['brightness'],
+            'tint': final['tint'],
+            'saturation': final['saturation'],
             'fade_steps': fade_steps,
+            'format': preset_def.get('format', 'auto'),
+            'keyframes': keyframes,
             'palettes': {},  # {palette_name: [[step0], [step1], ...]}
         }
 
@@ -1003,25 +1536,30 @@ def process_lighting_presets(presets_config, palette_registry):
 
             original_colors = pal_info['colors']
 
-            # Apply full transform to get end state
-            end_colors = apply_lighting_transform(
-                original_colors,
-                brightness=brightness,
-                tint=tuple(tint),
-                saturation=saturation
-            )
-
-            # Generate fade steps (step 0 = original, step N = full effect)
-            # We include step 0 and all intermediate steps up to and including full effect
-            steps = []
-            for step in range(fade_steps + 1):
-                if step == 0:
-                    steps.append(original_colors)
-                elif step == fade_steps:
-                    steps.append(end_colors)
+            # Fully applied palette at each keyframe
+            key_colors = [original_colors] + [
+                apply_lighting_transform(
+                    original_colors,
+                    brightness=kf['brightness'],
+                    tint=kf['tint'],
+                    saturation=kf['saturation']
+                )
+                for kf in keyframes[1:]
+            ]
+
+            # Steps after the last keyframe hold its colors
+            steps = [original_colors]
+            seg = 1
+            for step in range(1, fade_steps + 1):
+                while seg < len(keyframes) - 1 and step > keyframes[seg]['step']:
+                    seg += 1
+                lo, hi = keyframes[seg - 1], keyframes[seg]
+                if step >= hi['step']:
+                    steps.append(key_colors[seg])
                 else:
                     steps.append(interpolate_palettes(
-                        original_colors, end_colors, step, fade_steps
+                        key_colors[seg - 1], key_colors[seg], step - lo['step'],
+                        hi['step'] - lo['step'], hi['easing']
                     ))
 
             presets[preset_name]['palettes'][pal_name] = steps
@@ -1029,14 +1567,219 @@ def process_lighting_presets(presets_config, palette_registry):
     return presets
 
 
+def lighting_step_words(step_colors):
+    """Convert one step palette to its 16 NeoGeo color words."""
+    words = []
+    for i in range(16):
+        if i == 0:
+            color = 0x8000  # Reference/transparent
+        elif i < len(step_colors):
+            r, g, b = step_colors[i]
+            if r < 0:  # Sentinel for transparent
+                color = 0x8000
+            else:
+                color = rgb5_to_neogeo_color(r, g, b)
+        else:
+            color = 0x0000
+        words.append(color)
+    return words
+
+
+def dedupe_lighting_steps(steps):
+    """
+    Collapse step palettes that encode to the same color words.
+
+    Colors are quantized, so a long or eased fade repeats many steps. ROM
+    holds each distinct palette once plus a one-byte index per step.
+
+    Returns: (variants, step_index) where variants are lists of 16 color
+    words and steps[i] encodes to variants[step_index[i]]
+    """
+    variants = []
+    lookup = {}
+    step_index = []
+    for colors in steps:
+        words = tuple(lighting_step_words(colors))
+        if words not in lookup:
+            lookup[words] = len(variants)
+            variants.append(list(words))
+        step_index.append(lookup[words])
+    return variants, step_index
+
+
+# Steps between full palette checkpoints in delta-encoded presets
+LIGHTING_CHECKPOINT_STEPS = 8
+
+
+def build_lighting_deltas(preset_name, fade_steps, step_words):
+    """
+    Build the step delta table for a preset.
+
+    step_words: [(palette index, [16 color words per step, fade_steps + 1 steps])]
+
+    Returns: (deltas, delta_start) where deltas is a list of
+    (palette << 4 | color index, color at step k + 1, color at step k) and
+    delta_start[k] is the first delta between step k and k + 1
+    (fade_steps + 1 entries, the last one is the total).
+    """
+    deltas = []
+    delta_start = []
+    for k in range(fade_steps):
+        delta_start.append(len(deltas))
+        for pal_idx, words in step_words:
+            before, after = words[k], words[k + 1]
+            for i in range(1, 16):
+                if before[i] != after[i]:
+                    deltas.append(((pal_idx << 4) | i, after[i], before[i]))
+    delta_start.append(len(deltas))
+    if len(deltas) > 0xFFFF:
+        raise ProgearAssetsError(
+            f"Lighting preset '{preset_name}': {len(deltas)} step deltas exceed 65535"
+        )
+    return deltas, delta_start
+
+
+def encode_lighting_preset(preset_name, preset_data, palette_items):
+    """
+    Choose the ROM encoding for one preset.
+
+    'full':  distinct step palettes plus a step -> variant index per palette.
+             Every step is a full palette copy.
+    'delta': a full palette every LIGHTING_CHECKPOINT_STEPS steps plus the
+             (palette, color) changes between adjacent steps. Fades write
+             only the changed colors; any step is reachable from its
+             checkpoint.
+    'auto':  whichever is smaller (the default).
+
+    Returns: dict with 'format', 'palettes' [(palette name, palette index,
+    variants, step_index, checkpoints)], 'deltas', 'delta_start', 'rom_bytes'
+    """
+    fade_steps = preset_data['fade_steps']
+    requested = preset_data.get('format', 'auto')
+    if requested not in ('auto', 'full', 'delta'):
+        raise ProgearAssetsError(
+            f"Lighting preset '{preset_name}': format must be auto, full or delta"
+        )
+
+    palettes = []
+    step_words = []
+    for pal_name, pal_info in palette_items:
+        if pal_name not in preset_data['palettes']:
+            continue
+        variants, step_index = dedupe_lighting_steps(preset_data['palettes'][pal_name])
+        words = [variants[v] for v in step_index]
+        checkpoints = words[::LIGHTING_CHECKPOINT_STEPS]
+        palettes.append((pal_name, pal_info['index'], variants, step_index, checkpoints))
+        step_words.append((pal_info['index'], words))
+
+    deltas, delta_start = build_lighting_deltas(preset_name, fade_steps, step_words)
+
+    # ROM size in words
+    full_words = sum(len(v) * 16 + (len(idx) + 1) // 2 for _, _, v, idx, _ in palettes)
+    delta_words = (sum(len(cp) * 16 for _, _, _, _, cp in palettes) + len(deltas) * 3 +
+                   len(delta_start))
+    fmt = requested
+    if fmt == 'auto':
+        fmt = 'delta' if delta_words < full_words else 'full'
+
+    return {
+        'format': fmt,
+        'palettes': palettes,
+        'deltas': deltas,
+        'delta_start': delta_start,
+        'rom_bytes': 2 * (delta_words if fmt == 'delta' else full_words),
+    }
+
+
 # ============================================================================
 # Audio Asset Processing
 # ============================================================================
 
-def process_sound_effect(sfx_def, yaml_dir, index, current_offset):
+# ADPCM-A uses fixed 18500 Hz sample rate
+ADPCM_A_RATE = 18500
+
+
+def encode_sound_effect(source, yaml_dir):
+    """
+    Load and encode a sound effect to ADPCM-A.
+    Returns: (adpcm_data, orig_rate)
+    """
+    samples, orig_rate, source_path = load_wav_file(source, yaml_dir, ADPCM_A_RATE)
+
+    encoder = ADPCM_A()
+    return pack_adpcm(encoder.encode_s16(samples)), orig_rate
+
+
+# ADPCM-B addresses are in 256-byte units, 512 samples at 4 bits each
+MUSIC_BLOCK_BYTES = 256
+MUSIC_BLOCK_SAMPLES = 512
+
+# Pads segments to whole blocks: nibbles 0 and 8 step up and back down
+MUSIC_PAD_BYTE = 0x08
+
+
+def music_loop_points(music_def, name):
+    """
+    Read a music definition's loop settings.
+    Returns: (loop_start, loop_end) in seconds, or None for a track that does
+    not loop; loop_end is None to loop to the end of the sample
+    """
+    loop_start = music_def.get('loop_start')
+    loop_end = music_def.get('loop_end')
+    if loop_start is None and loop_end is None and not music_def.get('loop', False):
+        return None
+    for key, value in (('loop_start', loop_start), ('loop_end', loop_end)):
+        if value is not None and (not isinstance(value, (int, float)) or value < 0):
+            raise ProgearAssetsError(f"Music '{name}' {key} must be a time in seconds")
+    loop_start = loop_start or 0
+    if loop_end is not None and loop_end <= loop_start:
+        raise ProgearAssetsError(f"Music '{name}' loop_end must be after loop_start")
+    return loop_start, loop_end
+
+
+def encode_music(source, yaml_dir, target_rate, loop=None):
+    """
+    Load and encode a music track to ADPCM-B at target_rate.
+
+    loop: (loop_start, loop_end) from music_loop_points(), or None
+
+    The track is split at the loop start into an intro and a loop body.
+    Loop points are rounded to whole 512-sample blocks, since segments
+    start and end on V-ROM address units. Every segment is encoded from a
+    reset decoder state, as the YM2610 resets it whenever it jumps to a
+    segment's start.
+
+    Returns: list of segments' ADPCM data, each a whole number of blocks
+    """
+    samples, _, source_path = load_wav_file(source, yaml_dir, target_rate)
+
+    def blocks(seconds):
+        return int(round(seconds * target_rate / MUSIC_BLOCK_SAMPLES)) * MUSIC_BLOCK_SAMPLES
+
+    bounds = [0, len(samples)]
+    if loop is not None:
+        loop_start, loop_end = loop
+        start = min(blocks(loop_start), len(samples) // MUSIC_BLOCK_SAMPLES * MUSIC_BLOCK_SAMPLES)
+        end = len(samples) if loop_end is None else max(blocks(loop_end),
+                                                        start + MUSIC_BLOCK_SAMPLES)
+        bounds = [0, start, end] if start > 0 else [0, end]
+        if end > len(samples):
+            samples = list(samples) + [0] * (end - len(samples))
+
+    segments = []
+    for begin, end in zip(bounds, bounds[1:]):
+        data = pack_adpcm(ADPCM_B().encode_s16(samples[begin:end]))
+        pad = -len(data) % MUSIC_BLOCK_BYTES
+        segments.append(data + bytes([MUSIC_PAD_BYTE]) * pad)
+    return segments
+
+
+def process_sound_effect(sfx_def, yaml_dir, index, current_offset, encoded=None):
     """
     Process a sound effect definition.
     Returns: (adpcm_data, sfx_info)
+
+    encoded: result of encode_sound_effect() if already computed
     """
     name = sfx_def.get('name')
     if not name:
@@ -1046,15 +1789,13 @@ def process_sound_effect(sfx_def, yaml_dir, index, current_offset):
     if not source:
         raise ProgearAssetsError(f"Sound effect '{name}' missing 'source' field")
 
-    # ADPCM-A uses fixed 18500 Hz sample rate
-    ADPCM_A_RATE = 18500
-
-    samples, orig_rate, source_path = load_wav_file(source, yaml_dir, ADPCM_A_RATE)
+    priority = sfx_def.get('priority', 0)
+    if not isinstance(priority, int) or not 0 <= priority <= 255:
+        raise ProgearAssetsError(f"Sound effect '{name}' priority must be 0-255")
 
-    # Encode to ADPCM-A
-    encoder = ADPCM_A()
-    adpcm_nibbles = encoder.encode_s16(samples)
-    adpcm_data = pack_adpcm(adpcm_nibbles)
+    if encoded is None:
+        encoded = encode_sound_effect(source, yaml_dir)
+    adpcm_data, orig_rate = encoded
 
     # Addresses are in 256-byte units (16-bit max = 16MB)
     start_addr = current_offset // 256
@@ -1071,6 +1812,7 @@ def process_sound_effect(sfx_def, yaml_dir, index, current_offset):
         'start_addr_h': (start_addr >> 8) & 0xFF,
         'stop_addr_l': stop_addr & 0xFF,
         'stop_addr_h': (stop_addr >> 8) & 0xFF,
+        'priority': priority,
         'size': len(adpcm_data),
         'orig_rate': orig_rate,
     }
@@ -1078,10 +1820,17 @@ def process_sound_effect(sfx_def, yaml_dir, index, current_offset):
     return adpcm_data, sfx_info
 
 
-def process_music(music_def, yaml_dir, index, current_offset):
+def process_music(music_def, yaml_dir, index, current_offset, first_segment, encoded=None):
     """
     Process a music definition.
     Returns: (adpcm_data, music_info)
+
+    current_offset: V-ROM offset of the track, a multiple of MUSIC_BLOCK_BYTES
+    first_segment: index of the track's first entry in the segment table
+    encoded: result of encode_music() if already computed
+
+    music_info['next'] is the name of the track to chain to; the caller
+    resolves it once every track has an index.
     """
     name = music_def.get('name')
     if not name:
@@ -1094,59 +1843,409 @@ def process_music(music_def, yaml_dir, index, current_offset):
     # ADPCM-B supports variable rate, default to 22050 Hz
     target_rate = music_def.get('sample_rate', 22050)
 
-    samples, _, source_path = load_wav_file(source, yaml_dir, target_rate)
+    loop = music_loop_points(music_def, name)
+    next_track = music_def.get('next')
+    if next_track is not None and loop is not None:
+        raise ProgearAssetsError(f"Music '{name}' cannot both loop and chain to '{next_track}'")
 
-    # Encode to ADPCM-B
-    encoder = ADPCM_B()
-    adpcm_nibbles = encoder.encode_s16(samples)
-    adpcm_data = pack_adpcm(adpcm_nibbles)
+    segments = encoded if encoded is not None else encode_music(source, yaml_dir, target_rate,
+                                                                loop)
 
     # Calculate Delta-N for playback rate
     delta_n = calculate_delta_n(target_rate)
 
     # Addresses are in 256-byte units (16-bit max = 16MB)
-    start_addr = current_offset // 256
-    stop_addr = (current_offset + len(adpcm_data) - 1) // 256
-
-    if stop_addr > 0xFFFF:
-        raise ProgearAssetsError(f"Music '{name}' exceeds V-ROM address limit. "
-                        f"Total audio data ({stop_addr * 256} bytes) exceeds 16MB.")
+    addresses = []
+    offset = current_offset
+    for data in segments:
+        start_addr = offset // MUSIC_BLOCK_BYTES
+        stop_addr = (offset + len(data) - 1) // MUSIC_BLOCK_BYTES
+        if stop_addr > 0xFFFF:
+            raise ProgearAssetsError(f"Music '{name}' exceeds V-ROM address limit. "
+                            f"Total audio data ({stop_addr * 256} bytes) exceeds 16MB.")
+        addresses.append((start_addr, stop_addr))
+        offset += len(data)
 
     music_info = {
         'name': name,
         'index': index,
-        'start_addr_l': start_addr & 0xFF,
-        'start_addr_h': (start_addr >> 8) & 0xFF,
-        'stop_addr_l': stop_addr & 0xFF,
-        'stop_addr_h': (stop_addr >> 8) & 0xFF,
+        'first_segment': first_segment,
+        'segments': addresses,
+        # The loop body is the last segment
+        'loop_segment': first_segment + len(segments) - 1 if loop is not None else None,
+        'next': next_track,
         'delta_n_l': delta_n & 0xFF,
         'delta_n_h': (delta_n >> 8) & 0xFF,
-        'size': len(adpcm_data),
+        'size': offset - current_offset,
         'sample_rate': target_rate,
     }
 
-    return adpcm_data, music_info
+    return b''.join(segments), music_info
 
 
 # ============================================================================
-# Tilemap Asset Processing (TMX format from Tiled editor)
+# FM/SSG Song Processing (MML text for the Z80 driver's sequencer)
 # ============================================================================
 
-def parse_tmx_file(tmx_path, layer_name=None):
+# Layout of the FM data blob, patched into M-ROM at Z80 address FM_DATA_BASE
+# (fm_song_table, fm_patches and fm_data in hal/z80/driver.s)
+FM_DATA_BASE = 0x2000
+FM_DATA_END = 0x8000
+MAX_FM_SONGS = 32
+MAX_FM_PATCHES = 32
+FM_SONG_ENTRY = 16
+FM_PATCH_SIZE = 32
+
+# Sequence commands
+SEQ_REST = 0x80
+SEQ_WAIT = 0x81
+SEQ_PATCH = 0x82
+SEQ_VOLUME = 0x83
+SEQ_JUMP = 0x84
+SEQ_CALL = 0x85
+SEQ_RET = 0x86
+SEQ_END = 0x87
+
+# MML channel letters: FM 1-4, then SSG A-C
+MML_CHANNELS = 'ABCDEFG'
+FM_CHANNEL_COUNT = 4
+MML_WHOLE_TICKS = 192     # 48 ticks per quarter note
+MML_NOTES = {'c': 0, 'd': 2, 'e': 4, 'f': 5, 'g': 7, 'a': 9, 'b': 11}
+
+# Timer B ticks every 1152 * (256 - N) master clocks (8 MHz)
+FM_TIMER_CLOCK = 8000000 / 1152
+
+# Operator fields: (name, maximum)
+FM_OPERATOR_FIELDS = (('ar', 31), ('dr', 31), ('sr', 31), ('rr', 15), ('sl', 15),
+                      ('tl', 127), ('ks', 3), ('mul', 15), ('dt', 7), ('am', 1),
+                      ('ssg', 15))
+
+
+def process_fm_instrument(inst_def):
     """
-    Parse a TMX file from Tiled editor.
-    Returns: (width, height, tile_data, collision_data, tileset_firstgid)
-
-    TMX format is XML with structure:
-    <map>
-      <tileset firstgid="1" source="tileset.tsx"/>
-      <layer name="Ground" width="100" height="14">
-        <data encoding="csv">1,2,3,...</data>
-      </layer>
-    </map>
+    Convert an fm_instruments entry to the driver's patch format.
+    Returns: FM_PATCH_SIZE bytes: registers $30-$90 for each operator in
+    register order (operators 1, 3, 2, 4), then $B0 and $B4
     """
-    try:
-        tree = ET.parse(tmx_path)
+    name = inst_def.get('name')
+    if not name:
+        raise ProgearAssetsError("FM instrument missing 'name' field")
+
+    def field(d, key, maximum, default=0):
+        value = d.get(key, default)
+        if not isinstance(value, int) or not 0 <= value <= maximum:
+            raise ProgearAssetsError(f"FM instrument '{name}' {key} must be 0-{maximum}")
+        return value
+
+    ops = inst_def.get('operators')
+    if not isinstance(ops, list) or len(ops) != 4:
+        raise ProgearAssetsError(f"FM instrument '{name}' needs 4 operators")
+    ops = [{key: field(op, key, maximum) for key, maximum in FM_OPERATOR_FIELDS} for op in ops]
+
+    registers = (
+        lambda op: op['dt'] << 4 | op['mul'],
+        lambda op: op['tl'],
+        lambda op: op['ks'] << 6 | op['ar'],
+        lambda op: op['am'] << 7 | op['dr'],
+        lambda op: op['sr'],
+        lambda op: op['sl'] << 4 | op['rr'],
+        lambda op: op['ssg'],
+    )
+    patch = bytearray()
+    for reg in registers:
+        for op in (ops[0], ops[2], ops[1], ops[3]):
+            patch.append(reg(op))
+    patch.append(field(inst_def, 'feedback', 7) << 3 | field(inst_def, 'algorithm', 7))
+    patch.append(0xC0 | field(inst_def, 'ams', 3) << 4 | field(inst_def, 'fms', 7))
+    return bytes(patch + bytes(FM_PATCH_SIZE - len(patch)))
+
+
+class MMLChannel:
+    """Compiles one channel's MML text to driver sequence items."""
+
+    def __init__(self, song, letter, text, instruments):
+        self.song = song
+        self.letter = letter
+        self.text = text
+        self.pos = 0
+        self.instruments = instruments
+        self.fm = MML_CHANNELS.index(letter) < FM_CHANNEL_COUNT
+        self.octave = 4
+        self.length = MML_WHOLE_TICKS // 4
+        self.tempo = None
+        self.loop = None
+
+    def error(self, message):
+        raise ProgearAssetsError(f"FM song '{self.song}' channel {self.letter}: {message}")
+
+    def number(self, default=None):
+        start = self.pos
+        while self.pos < len(self.text) and self.text[self.pos].isdigit():
+            self.pos += 1
+        if start == self.pos:
+            if default is None:
+                self.error(f"number expected at '{self.text[start:start + 8]}'")
+            return default
+        return int(self.text[start:self.pos])
+
+    def duration(self):
+        """Length after a note or rest, with dots and ^ ties, in ticks."""
+        ticks = 0
+        while True:
+            n = self.number(0)
+            if n:
+                if MML_WHOLE_TICKS % n:
+                    self.error(f"length {n} is not a whole number of ticks")
+                base = MML_WHOLE_TICKS // n
+            else:
+                base = self.length
+            ticks += base
+            while self.peek() == '.':
+                self.pos += 1
+                base //= 2
+                ticks += base
+            if self.peek() != '^':
+                return ticks
+            self.pos += 1
+
+    def peek(self):
+        return self.text[self.pos] if self.pos < len(self.text) else ''
+
+    @staticmethod
+    def timed(command, ticks, items):
+        """Emit command with ticks, continued by waits past 255."""
+        first = True
+        while ticks > 0 or first:
+            chunk = min(ticks, 255)
+            items += [command if first else SEQ_WAIT, chunk]
+            ticks -= chunk
+            first = False
+
+    def compile(self, depth=0):
+        """
+        Compile up to the end of text, or the ']' closing a repeat.
+        Returns: list of items, a byte or ('call', pattern bytes)
+        """
+        items = []
+        while self.pos < len(self.text):
+            c = self.text[self.pos]
+            self.pos += 1
+            if c.isspace() or c == '|':
+                continue
+            if c in MML_NOTES:
+                semitone = MML_NOTES[c]
+                while self.peek() in ('+', '#', '-'):
+                    semitone += -1 if self.text[self.pos] == '-' else 1
+                    self.pos += 1
+                octave = self.octave + semitone // 12
+                if not 0 <= octave <= 7:
+                    self.error(f"note outside octaves 0-7")
+                self.timed(octave << 4 | semitone % 12, self.duration(), items)
+            elif c == 'r':
+                self.timed(SEQ_REST, self.duration(), items)
+            elif c == 'o':
+                self.octave = self.number()
+            elif c == '>':
+                self.octave += 1
+            elif c == '<':
+                self.octave -= 1
+            elif c == 'l':
+                n = self.number()
+                if not n or MML_WHOLE_TICKS % n:
+                    self.error(f"length {n} is not a whole number of ticks")
+                self.length = MML_WHOLE_TICKS // n
+            elif c == 't':
+                self.tempo = self.number()
+            elif c == 'v':
+                if self.fm:
+                    self.error("v (volume) is for SSG channels; FM loudness is the patch's TL")
+                volume = self.number()
+                if volume > 15:
+                    self.error("SSG volume must be 0-15")
+                items += [SEQ_VOLUME, volume]
+            elif c == '@':
+                start = self.pos
+                while self.pos < len(self.text) and (self.text[self.pos].isalnum() or
+                                                     self.text[self.pos] == '_'):
+                    self.pos += 1
+                inst = self.text[start:self.pos]
+                if not self.fm:
+                    self.error("@ (instrument) is for FM channels")
+                if inst not in self.instruments:
+                    self.error(f"unknown FM instrument '{inst}'")
+                items += [SEQ_PATCH, self.instruments[inst]]
+            elif c == 'L':
+                if depth:
+                    self.error("L (loop point) inside a repeat")
+                self.loop = len(items)
+            elif c == '[':
+                body = self.compile(depth + 1)
+                count = self.number(2)
+                if depth == 0:
+                    # One call stack entry: outer repeats become patterns ...
+                    items += [('call', tuple(body) + (SEQ_RET,))] * count
+                else:
+                    # ... and inner ones play inline
+                    items += body * count
+            elif c == ']':
+                if not depth:
+                    self.error("']' without '['")
+                return items
+            else:
+                self.error(f"unexpected '{c}'")
+        if depth:
+            self.error("'[' without ']'")
+        return items
+
+
+def process_fm_song(song_def, yaml_dir, index, instruments):
+    """
+    Compile an fm_music entry from its MML source.
+    Returns: fm_info with 'channels' (7 item lists or None), 'loops' (item
+    index of each channel's L, or None) and 'timer_b'
+
+    MML lines start with channel letters (A-D FM, E-G SSG): "AB o4 l8 cdef".
+    The tempo (quarter notes per minute) comes from the YAML entry, a
+    "#tempo N" line or the first channel's t command, in that order.
+    """
+    name = song_def.get('name')
+    if not name:
+        raise ProgearAssetsError("FM song missing 'name' field")
+    source = song_def.get('source')
+    if not source:
+        raise ProgearAssetsError(f"FM song '{name}' missing 'source' field")
+
+    path = source if os.path.isabs(source) else os.path.join(yaml_dir, source)
+    try:
+        with open(path) as f:
+            lines = f.read().splitlines()
+    except OSError as e:
+        raise ProgearAssetsError(f"FM song '{name}': cannot read {source}: {e}")
+
+    tempo = song_def.get('tempo')
+    texts = {letter: [] for letter in MML_CHANNELS}
+    for line in lines:
+        line = line.split(';', 1)[0].strip()
+        if not line:
+            continue
+        letters, _, text = line.partition(' ')
+        if letters == '#tempo':
+            if tempo is None:
+                try:
+                    tempo = int(text)
+                except ValueError:
+                    raise ProgearAssetsError(f"FM song '{name}': bad #tempo '{text}'")
+            continue
+        if not letters or any(letter not in MML_CHANNELS for letter in letters):
+            raise ProgearAssetsError(f"FM song '{name}': line must start with channel "
+                                     f"letters A-G: '{line}'")
+        for letter in letters:
+            texts[letter].append(text)
+
+    channels, loops = [], []
+    for letter in MML_CHANNELS:
+        if not texts[letter]:
+            channels.append(None)
+            loops.append(None)
+            continue
+        ch = MMLChannel(name, letter, ' '.join(texts[letter]), instruments)
+        channels.append(ch.compile())
+        loops.append(ch.loop)
+        if tempo is None:
+            tempo = ch.tempo
+    tempo = tempo or 120
+
+    rate = tempo * (MML_WHOLE_TICKS // 4) / 60.0
+    timer_b = 256 - int(round(FM_TIMER_CLOCK / rate))
+    if not 1 <= timer_b <= 255:
+        raise ProgearAssetsError(f"FM song '{name}': tempo {tempo} is out of Timer B range (34 and up)")
+
+    return {
+        'name': name,
+        'index': index,
+        'channels': channels,
+        'loops': loops,
+        'timer_b': timer_b,
+        'tempo': tempo,
+    }
+
+
+def generate_fm_data(fm_info_list, patches):
+    """
+    Lay out the FM song table, patches and sequences.
+    Returns: bytes to be written at FM_DATA_BASE in M-ROM
+
+    Repeat patterns are stored once however many songs use them.
+    """
+    table = bytearray(MAX_FM_SONGS * FM_SONG_ENTRY)
+    patch_table = bytearray(MAX_FM_PATCHES * FM_PATCH_SIZE)
+    for i, patch in enumerate(patches):
+        patch_table[i * FM_PATCH_SIZE:(i + 1) * FM_PATCH_SIZE] = patch
+
+    data = bytearray()
+    data_base = FM_DATA_BASE + len(table) + len(patch_table)
+    pattern_addr = {}
+
+    def address():
+        return data_base + len(data)
+
+    # Patterns first, so calls resolve in one pass
+    for fm in fm_info_list:
+        for items in fm['channels']:
+            for item in items or ():
+                if isinstance(item, tuple) and item[1] not in pattern_addr:
+                    pattern_addr[item[1]] = address()
+                    data.extend(item[1])
+
+    for fm in fm_info_list:
+        entry = fm['index'] * FM_SONG_ENTRY
+        table[entry] = fm['timer_b']
+        for ch, items in enumerate(fm['channels']):
+            if items is None:
+                continue
+            start = address()
+            loop = None
+            for i, item in enumerate(items):
+                if i == fm['loops'][ch]:
+                    loop = address()
+                if isinstance(item, tuple):
+                    target = pattern_addr[item[1]]
+                    data.extend((SEQ_CALL, target & 0xFF, target >> 8))
+                else:
+                    data.append(item)
+            if fm['loops'][ch] is not None:
+                loop = address() if loop is None else loop
+                data.extend((SEQ_JUMP, loop & 0xFF, loop >> 8))
+            else:
+                data.append(SEQ_END)
+            table[entry + 2 + ch * 2] = start & 0xFF
+            table[entry + 3 + ch * 2] = start >> 8
+
+    if address() > FM_DATA_END:
+        raise ProgearAssetsError(f"FM songs need {address() - data_base} bytes of sequence data, "
+                                 f"{FM_DATA_END - data_base} fit in M-ROM")
+    return bytes(table + patch_table + data)
+
+
+# ============================================================================
+# Tilemap Asset Processing (TMX format from Tiled editor)
+# ============================================================================
+
+def parse_tmx_file(tmx_path, layer_name=None):
+    """
+    Parse a TMX file from Tiled editor.
+    Returns: (width, height, tile_data, collision_data, tileset_firstgid)
+
+    TMX format is XML with structure:
+    <map>
+      <tileset firstgid="1" source="tileset.tsx"/>
+      <layer name="Ground" width="100" height="14">
+        <data encoding="csv">1,2,3,...</data>
+      </layer>
+    </map>
+    """
+    try:
+        tree = ET.parse(tmx_path)
         root = tree.getroot()
     except ET.ParseError as e:
         raise ProgearAssetsError(f"Failed to parse TMX file {tmx_path}: {e}")
@@ -1256,7 +2355,7 @@ def parse_tmx_file(tmx_path, layer_name=None):
     return layer_width, layer_height, tile_data, collision_data, tileset_firstgid
 
 
-def process_tilemap_asset(tilemap_def, yaml_dir, visual_assets_info):
+def process_tilemap_asset(tilemap_def, yaml_dir, visual_assets_info, palette_registry=None):
     """
     Process a tilemap asset definition.
     Returns: tilemap_info dict
@@ -1269,9 +2368,11 @@ def process_tilemap_asset(tilemap_def, yaml_dir, visual_assets_info):
         tileset_palettes:
           - tiles: [0, 31]
             palette: 5
-        default_palette: 5
+        default_palette: level_tileset  # palette index, or palette or asset name
         collision:  # optional, override TMX tile properties
           solid: [1, 2, 3]
+        chunked: true  # optional, RLE-packed 16x16 chunks for large stages
+        bank: 1  # optional, P-ROM bank (1-8) for the map arrays, see ng_bank.h
     """
     name = tilemap_def.get('name')
     if not name:
@@ -1305,13 +2406,16 @@ def process_tilemap_asset(tilemap_def, yaml_dir, visual_assets_info):
 
     # Process tileset_palettes to build lookup table
     tileset_palettes = tilemap_def.get('tileset_palettes', [])
-    default_palette = tilemap_def.get('default_palette', 0)
+    registry = palette_registry or {}
+    default_palette = palette_index(registry, tilemap_def.get('default_palette', 0),
+                                    f"Tilemap '{name}'")
 
     # Build tile_to_palette lookup table (256 entries)
     tile_to_palette = [default_palette] * 256
     for pal_range in tileset_palettes:
         tiles_range = pal_range.get('tiles', [0, 0])
-        palette = pal_range.get('palette', default_palette)
+        palette = palette_index(registry, pal_range.get('palette', default_palette),
+                                f"Tilemap '{name}'")
         if len(tiles_range) == 2:
             start, end = tiles_range
             for i in range(start, min(end + 1, 256)):
@@ -1349,6 +2453,10 @@ def process_tilemap_asset(tilemap_def, yaml_dir, visual_assets_info):
                 collision_bytes.append(collision_map.get(tile_id, 0))
             collision_data = bytes(collision_bytes)
 
+    bank = tilemap_def.get('bank', 0)
+    if not isinstance(bank, int) or not 0 <= bank <= P_ROM_BANKS:
+        raise ProgearAssetsError(f"Tilemap '{name}' bank must be 1-{P_ROM_BANKS}, got {bank!r}")
+
     tilemap_info = {
         'name': name,
         'width_tiles': width,
@@ -1358,51 +2466,299 @@ def process_tilemap_asset(tilemap_def, yaml_dir, visual_assets_info):
         'collision_data': collision_data,
         'tile_to_palette': bytes(tile_to_palette),
         'default_palette': default_palette,
+        'chunks': None,
+        'bank': bank,
     }
 
+    if tilemap_def.get('chunked', False):
+        tilemap_info['chunks'] = build_terrain_chunks(width, height, tile_data, collision_data)
+
     return tilemap_info
 
 
+# Chunk width and height in tiles, must match NG_TERRAIN_CHUNK_SIZE
+TERRAIN_CHUNK_SIZE = 16
+
+# P-ROM banks the linker script provides, must match NG_BANK_COUNT
+P_ROM_BANKS = 8
+
+
+def rle_pack(data):
+    """
+    Pack bytes into the terrain chunk run stream.
+
+    A control byte n < 0x80 is followed by n + 1 literal bytes; n >= 0x80
+    repeats the next byte n - 0x7E times (2 to 129).
+    """
+    out = bytearray()
+    literals = bytearray()
+
+    def flush_literals():
+        for i in range(0, len(literals), 128):
+            part = literals[i:i + 128]
+            out.append(len(part) - 1)
+            out.extend(part)
+        literals.clear()
+
+    i = 0
+    while i < len(data):
+        run = 1
+        while i + run < len(data) and run < 129 and data[i + run] == data[i]:
+            run += 1
+        if run >= 2:
+            flush_literals()
+            out.append(0x7E + run)
+            out.append(data[i])
+        else:
+            literals.append(data[i])
+        i += run
+    flush_literals()
+    return bytes(out)
+
+
+# LZ4 block rules the reference decoder relies on: the last 5 bytes are
+# literals, and no match starts in the last 12
+LZ4_MIN_MATCH = 4
+LZ4_LAST_LITERALS = 5
+LZ4_MATCH_LIMIT = 12
+LZ4_MAX_OFFSET = 0xFFFF
+
+
+def lz4_length(out, length):
+    """Append the 255-summed extension bytes of a length past 15."""
+    while length >= 255:
+        out.append(255)
+        length -= 255
+    out.append(length)
+
+
+def lz4_pack(data):
+    """
+    Pack bytes for ng_decomp.h: the unpacked size as a big-endian u32, then
+    an LZ4 block. Greedy matching against the last position of each 4-byte
+    string, which is what the 68000 decoder is fast for: long copies.
+    """
+    data = bytes(data)
+    out = bytearray(struct.pack('>I', len(data)))
+    last_seen = {}
+    anchor = 0
+    i = 0
+    match_end = len(data) - LZ4_LAST_LITERALS
+    while i + LZ4_MATCH_LIMIT <= len(data):
+        key = data[i:i + LZ4_MIN_MATCH]
+        candidate = last_seen.get(key)
+        last_seen[key] = i
+        if candidate is None or i - candidate > LZ4_MAX_OFFSET:
+            i += 1
+            continue
+        length = LZ4_MIN_MATCH
+        while i + length < match_end and data[candidate + length] == data[i + length]:
+            length += 1
+
+        literals = i - anchor
+        match_code = length - LZ4_MIN_MATCH
+        out.append((min(literals, 15) << 4) | min(match_code, 15))
+        if literals >= 15:
+            lz4_length(out, literals - 15)
+        out.extend(data[anchor:i])
+        out.extend(struct.pack('<H', i - candidate))
+        if match_code >= 15:
+            lz4_length(out, match_code - 15)
+
+        for j in range(i + 1, min(i + length, len(data) - LZ4_MIN_MATCH)):
+            last_seen[data[j:j + LZ4_MIN_MATCH]] = j
+        i += length
+        anchor = i
+
+    literals = len(data) - anchor
+    out.append(min(literals, 15) << 4)
+    if literals >= 15:
+        lz4_length(out, literals - 15)
+    out.extend(data[anchor:])
+    return bytes(out)
+
+
+def process_data_asset(data_def, yaml_dir):
+    """
+    Pack a binary file for NGDecompress() or NGDecompQueue().
+
+    data_def: {name, source, bank (optional P-ROM bank 1-8)}
+    Returns: {'name', 'packed', 'size', 'bank'}
+    """
+    name = data_def.get('name')
+    source = data_def.get('source')
+    if not name or not source:
+        raise ProgearAssetsError(f"Data entry needs a name and a source: {data_def}")
+    bank = data_def.get('bank', 0)
+    if not isinstance(bank, int) or not 0 <= bank <= P_ROM_BANKS:
+        raise ProgearAssetsError(f"Data '{name}' bank must be 1-{P_ROM_BANKS}, got {bank!r}")
+    path = Path(yaml_dir) / source
+    try:
+        raw = path.read_bytes()
+    except OSError as e:
+        raise ProgearAssetsError(f"Data '{name}': cannot read {path}: {e}")
+    return {'name': name, 'packed': lz4_pack(raw), 'size': len(raw), 'bank': bank}
+
+
+def build_terrain_chunks(width, height, tile_data, collision_data):
+    """
+    Split a map into TERRAIN_CHUNK_SIZE square chunks and RLE-pack each.
+
+    Each chunk holds its tiles row-major, then its collision bytes when the
+    map has collision. Chunks past the map edge are padded with zeros.
+    Identical chunks are stored once.
+
+    Returns: dict with 'data' (packed bytes), 'offsets' (start of each chunk,
+    row-major by chunk), 'collision' (chunks carry collision) and 'slopes'
+    (some collision byte has a slope flag)
+    """
+    size = TERRAIN_CHUNK_SIZE
+    chunk_cols = (width + size - 1) // size
+    chunk_rows = (height + size - 1) // size
+    data = bytearray()
+    offsets = []
+    lookup = {}
+
+    def chunk_layer(layer, cx, cy):
+        out = bytearray(size * size)
+        for y in range(size):
+            ty = cy * size + y
+            if ty >= height:
+                break
+            start = ty * width + cx * size
+            row = layer[start:start + min(size, width - cx * size)]
+            out[y * size:y * size + len(row)] = row
+        return out
+
+    for cy in range(chunk_rows):
+        for cx in range(chunk_cols):
+            raw = chunk_layer(tile_data, cx, cy)
+            if collision_data:
+                raw += chunk_layer(collision_data, cx, cy)
+            packed = rle_pack(bytes(raw))
+            if packed not in lookup:
+                lookup[packed] = len(data)
+                data.extend(packed)
+            offsets.append(lookup[packed])
+
+    return {
+        'data': bytes(data),
+        'offsets': offsets,
+        'collision': bool(collision_data),
+        'slopes': bool(collision_data) and any(b & 0x0C for b in collision_data),
+    }
+
+
+# Sound effects the Z80 driver's sfx_table holds (NG_AUDIO_MAX_SFX)
+MAX_SFX = 128
+
+# Tracks in the driver's music_table (NG_AUDIO_MAX_MUSIC) and entries in its
+# music_segments table, shared by all tracks
+MAX_MUSIC = 32
+MAX_MUSIC_SEGMENTS = 64
+
+# No loop segment / no next track in a music_table entry
+MUSIC_NONE = 0xFF
+
+
 def generate_z80_sample_tables(sfx_info_list, music_info_list):
     """
     Generate binary sample tables for Z80 driver.
     Returns: bytes to be written at a known offset in M-ROM
 
-    SFX table format (32 entries, 4 bytes each):
+    SFX table format (MAX_SFX entries, 4 bytes each):
         start_addr_l, start_addr_h, stop_addr_l, stop_addr_h
 
-    Music table format (32 entries, 6 bytes each):
-        start_addr_l, start_addr_h, stop_addr_l, stop_addr_h, delta_n_l, delta_n_h
+    Music table format (MAX_MUSIC entries, 6 bytes each):
+        first_segment, segment_count, loop_segment, next_track, delta_n_l, delta_n_h
+        (loop_segment and next_track are MUSIC_NONE when unused)
+
+    SFX priority table format (MAX_SFX entries, 1 byte each):
+        default voice priority, used when a play command names none
+
+    Music segment table format (MAX_MUSIC_SEGMENTS entries, 4 bytes each):
+        start_addr_l, start_addr_h, stop_addr_l, stop_addr_h
     """
-    # SFX table: 32 entries * 4 bytes = 128 bytes
-    sfx_table = bytearray(128)
+    # SFX table: MAX_SFX entries * 4 bytes (sfx_table in hal/z80/driver.s)
+    sfx_table = bytearray(MAX_SFX * 4)
     for sfx in sfx_info_list:
         idx = sfx['index']
-        if idx < 32:
+        if idx < MAX_SFX:
             offset = idx * 4
             sfx_table[offset] = sfx['start_addr_l']
             sfx_table[offset + 1] = sfx['start_addr_h']
             sfx_table[offset + 2] = sfx['stop_addr_l']
             sfx_table[offset + 3] = sfx['stop_addr_h']
 
-    # Music table: 32 entries * 6 bytes = 192 bytes
-    music_table = bytearray(192)
+    # Music table: MAX_MUSIC entries * 6 bytes = 192 bytes
+    music_table = bytearray(MAX_MUSIC * 6)
+    segment_table = bytearray(MAX_MUSIC_SEGMENTS * 4)
     for music in music_info_list:
         idx = music['index']
-        if idx < 32:
+        if idx < MAX_MUSIC:
             offset = idx * 6
-            music_table[offset] = music['start_addr_l']
-            music_table[offset + 1] = music['start_addr_h']
-            music_table[offset + 2] = music['stop_addr_l']
-            music_table[offset + 3] = music['stop_addr_h']
+            loop = music['loop_segment']
+            music_table[offset] = music['first_segment']
+            music_table[offset + 1] = len(music['segments'])
+            music_table[offset + 2] = MUSIC_NONE if loop is None else loop
+            music_table[offset + 3] = music['next_index']
             music_table[offset + 4] = music['delta_n_l']
             music_table[offset + 5] = music['delta_n_h']
+            for i, (start_addr, stop_addr) in enumerate(music['segments']):
+                seg = (music['first_segment'] + i) * 4
+                segment_table[seg] = start_addr & 0xFF
+                segment_table[seg + 1] = (start_addr >> 8) & 0xFF
+                segment_table[seg + 2] = stop_addr & 0xFF
+                segment_table[seg + 3] = (stop_addr >> 8) & 0xFF
+
+    sfx_priority = bytearray(MAX_SFX)
+    for sfx in sfx_info_list:
+        if sfx['index'] < MAX_SFX:
+            sfx_priority[sfx['index']] = sfx['priority']
 
-    return bytes(sfx_table + music_table)
+    return bytes(sfx_table + music_table + sfx_priority + segment_table)
+
+
+def frame_deltas(asset):
+    """
+    Build NGVisualAsset.frame_deltas: frame_count + 1 offsets into the
+    array, then for each frame the (column << 5) | row of every tilemap
+    entry that differs from the previous frame, column-major so runs of
+    changed rows share a VRAM address setup. Frame 0 lists none.
+
+    Returns: list of u16 values, or None for single-frame assets
+    """
+    frame_count = asset['frame_count']
+    tiles_w = asset['width_tiles']
+    tiles_h = asset['height_tiles']
+    per_frame = asset['tiles_per_frame']
+    tilemap = asset['tilemap']
+    if frame_count < 2 or asset.get('parts') is not None:
+        return None
+
+    slots = [[]]
+    for f in range(1, frame_count):
+        prev = tilemap[(f - 1) * per_frame:f * per_frame]
+        cur = tilemap[f * per_frame:(f + 1) * per_frame]
+        slots.append([(col << 5) | row
+                      for col in range(tiles_w) for row in range(tiles_h)
+                      if cur[row * tiles_w + col] != prev[row * tiles_w + col]])
+
+    deltas = []
+    offset = frame_count + 1
+    for frame_slots in slots:
+        deltas.append(offset)
+        offset += len(frame_slots)
+    deltas.append(offset)
+    if offset > 0xFFFF:
+        return None
+    for frame_slots in slots:
+        deltas.extend(frame_slots)
+    return deltas
 
 
 def generate_header(assets_info, palette_registry, sfx_info, music_info, tilemap_info,
-                    lighting_presets, output_path):
+                    lighting_presets, output_path, fm_info=(), fonts_info=(), data_info=()):
     """Generate C header file with asset definitions."""
     # Check if SDK UI assets are present (needed to decide on includes)
     asset_names = {asset['name'] for asset in assets_info}
@@ -1433,6 +2789,10 @@ def generate_header(assets_info, palette_registry, sfx_info, music_info, tilemap
     if lighting_presets:
         lines.append("#include <lighting.h>")
 
+    # Include ng_bank.h if any tilemap or data is placed in a P-ROM bank
+    if any(tm['bank'] for tm in tilemap_info or []) or any(d['bank'] for d in data_info):
+        lines.append("#include <ng_bank.h>")
+
     lines.append("")
 
     # === Palette Index Constants ===
@@ -1450,6 +2810,15 @@ def generate_header(assets_info, palette_registry, sfx_info, music_info, tilemap
             lines.append(f"#define {const_name} {pal_info['index']}")
         lines.append("")
 
+    # Assets whose palette was merged into another keep their names
+    aliases = palette_registry.get('_aliases', {})
+    if aliases:
+        lines.append("// === Shared Palettes ===")
+        for alias, pal_name in aliases.items():
+            lines.append(f"#define NGPAL_{alias.upper()} NGPAL_{pal_name.upper()}")
+            lines.append(f"#define NGPal_{alias} NGPal_{pal_name}")
+        lines.append("")
+
     # === Palette Data Arrays ===
     if palette_items:
         lines.append("// === Palette Data ===")
@@ -1489,28 +2858,62 @@ def generate_header(assets_info, palette_registry, sfx_info, music_info, tilemap
             lines.append("};")
             lines.append("")
 
+        # Per-frame durations, for animations that give them
+        for anim in asset['animations']:
+            if anim.get('durations'):
+                values = ", ".join(str(d) for d in anim['durations'])
+                lines.append(f"static const u8 _{name}_{anim['name']}_durations[] = {{ {values} }};")
+        if any(anim.get('durations') for anim in asset['animations']):
+            lines.append("")
+
         # Animation definitions array
         if asset['animations']:
             lines.append(f"static const NGAnimDef _{name}_anims[] = {{")
             for anim in asset['animations']:
+                durations = (f"_{name}_{anim['name']}_durations" if anim.get('durations')
+                             else "NULL")
                 lines.append(
                     f"    {{ \"{anim['name']}\", {anim['first_frame']}, "
-                    f"{anim['frame_count']}, {anim['speed']}, {anim['loop']} }},"
+                    f"{anim['frame_count']}, {anim['speed']}, {anim['loop']}, {durations} }},"
                 )
             lines.append("};")
             lines.append("")
 
         # Tilemap array
         tilemap = asset['tilemap']
-        first_frame_tiles = asset['tiles_per_frame']
         lines.append(f"static const u16 _{name}_tilemap[] = {{")
-        for i in range(0, min(len(tilemap), first_frame_tiles), 16):
-            chunk = tilemap[i:min(i+16, first_frame_tiles)]
+        for i in range(0, len(tilemap), 16):
+            chunk = tilemap[i:i+16]
             line = "    " + ", ".join(f"0x{t:04X}" for t in chunk) + ","
             lines.append(line)
         lines.append("};")
         lines.append("")
 
+        # Entries each frame changes, so animation steps rewrite only those
+        deltas = frame_deltas(asset)
+        if deltas:
+            lines.append(f"static const u16 _{name}_frame_deltas[] = {{")
+            for i in range(0, len(deltas), 16):
+                chunk = deltas[i:i+16]
+                lines.append("    " + ", ".join(str(d) for d in chunk) + ",")
+            lines.append("};")
+            lines.append("")
+
+        # Metasprite column parts, frame after frame
+        parts = asset.get('parts')
+        if parts is not None:
+            lines.append(f"static const NGMetaPart _{name}_parts[] = {{")
+            for x, y, tile, height in parts:
+                lines.append(f"    {{ {x}, {y}, {tile}, {height} }},")
+            lines.append("};")
+            frame_parts = asset['frame_parts']
+            lines.append(f"static const u16 _{name}_frame_parts[] = {{")
+            for i in range(0, len(frame_parts), 16):
+                chunk = frame_parts[i:i+16]
+                lines.append("    " + ", ".join(str(n) for n in chunk) + ",")
+            lines.append("};")
+            lines.append("")
+
         # NGVisualAsset struct - now with palette_data
         lines.append(f"static const NGVisualAsset NGVisualAsset_{name} = {{")
         lines.append(f"    .name = \"{name}\",")
@@ -1530,9 +2933,44 @@ def generate_header(assets_info, palette_registry, sfx_info, music_info, tilemap
             lines.append("    .anim_count = 0,")
         lines.append(f"    .frame_count = {asset['frame_count']},")
         lines.append(f"    .tiles_per_frame = {asset['tiles_per_frame']},")
+        if asset.get('auto_anim'):
+            lines.append(f"    .auto_anim = {asset['auto_anim']},")
+        if deltas:
+            lines.append(f"    .frame_deltas = _{name}_frame_deltas,")
+        if parts is not None:
+            frame_parts = asset['frame_parts']
+            max_parts = max(b - a for a, b in zip(frame_parts, frame_parts[1:]))
+            lines.append(f"    .parts = _{name}_parts,")
+            lines.append(f"    .frame_parts = _{name}_frame_parts,")
+            lines.append(f"    .max_parts = {max_parts},")
         lines.append("};")
         lines.append("")
 
+    # === Sprite Fonts ===
+    if fonts_info:
+        lines.append("// === Sprite Fonts ===")
+        lines.append("// Tile of the space character, for NGSpriteTextSetFont()")
+        for font in fonts_info:
+            lines.append(f"#define NGFONT_{font['name'].upper()} {font['tile']}")
+        lines.append("")
+
+    # === Packed Data ===
+    if data_info:
+        lines.append("// === Packed Data ===")
+        lines.append("// LZ4 with a size header, for NGDecompress() and NGDecompQueue()")
+        lines.append("")
+        for data in data_info:
+            name = data['name']
+            in_bank = f"NG_BANK({data['bank']}) " if data['bank'] else ""
+            lines.append(f"#define NGDATA_{name.upper()}_SIZE {data['size']}")
+            lines.append(f"{in_bank}static const u8 NGData_{name}[] = {{")
+            packed = data['packed']
+            for i in range(0, len(packed), 32):
+                line = "    " + ", ".join(f"0x{b:02X}" for b in packed[i:i+32]) + ","
+                lines.append(line)
+            lines.append("};")
+            lines.append("")
+
     # === NGPalInitAssets Function ===
     # Generated with __attribute__((weak)) so multiple inclusions don't cause
     # linker errors, but it still overrides the empty weak default in engine.c
@@ -1582,6 +3020,22 @@ def generate_header(assets_info, palette_registry, sfx_info, music_info, tilemap
             lines.append("};")
             lines.append("")
 
+    # === FM Songs ===
+    if fm_info:
+        lines.append("// === FM Songs ===")
+        lines.append("")
+
+        for fm in fm_info:
+            lines.append(f"#define NGFM_{fm['name'].upper()} {fm['index']}")
+        lines.append("")
+
+        for fm in fm_info:
+            lines.append(f"static const NGFMAsset NGFMAsset_{fm['name']} = {{")
+            lines.append(f"    .name = \"{fm['name']}\",")
+            lines.append(f"    .index = {fm['index']},")
+            lines.append("};")
+            lines.append("")
+
     # === Terrain Assets (from tilemaps section in YAML) ===
     if tilemap_info:
         lines.append("// === Terrain Assets ===")
@@ -1590,21 +3044,43 @@ def generate_header(assets_info, palette_registry, sfx_info, music_info, tilemap
 
         for tm in tilemap_info:
             name = tm['name']
+            chunks = tm['chunks']
+            # Arrays go in the bank; the struct stays in the first megabyte
+            in_bank = f"NG_BANK({tm['bank']}) " if tm['bank'] else ""
+
+            if chunks:
+                # RLE-packed chunks and their start offsets
+                chunk_data = chunks['data']
+                lines.append(f"{in_bank}static const u8 _{name}_chunk_data[] = {{")
+                for i in range(0, len(chunk_data), 32):
+                    chunk = chunk_data[i:i+32]
+                    line = "    " + ", ".join(f"0x{b:02X}" for b in chunk) + ","
+                    lines.append(line)
+                lines.append("};")
+                lines.append("")
 
-            # Tile data array
-            tile_data = tm['tile_data']
-            lines.append(f"static const u8 _{name}_tile_data[] = {{")
-            for i in range(0, len(tile_data), 32):
-                chunk = tile_data[i:i+32]
-                line = "    " + ", ".join(f"0x{b:02X}" for b in chunk) + ","
-                lines.append(line)
-            lines.append("};")
-            lines.append("")
+                offsets = chunks['offsets']
+                lines.append(f"{in_bank}static const u32 _{name}_chunk_offsets[] = {{")
+                for i in range(0, len(offsets), 8):
+                    line = "    " + ", ".join(f"{o}" for o in offsets[i:i+8]) + ","
+                    lines.append(line)
+                lines.append("};")
+                lines.append("")
+            else:
+                # Tile data array
+                tile_data = tm['tile_data']
+                lines.append(f"{in_bank}static const u8 _{name}_tile_data[] = {{")
+                for i in range(0, len(tile_data), 32):
+                    chunk = tile_data[i:i+32]
+                    line = "    " + ", ".join(f"0x{b:02X}" for b in chunk) + ","
+                    lines.append(line)
+                lines.append("};")
+                lines.append("")
 
             # Collision data array (if present)
             collision_data = tm['collision_data']
-            if collision_data:
-                lines.append(f"static const u8 _{name}_collision_data[] = {{")
+            if collision_data and not chunks:
+                lines.append(f"{in_bank}static const u8 _{name}_collision_data[] = {{")
                 for i in range(0, len(collision_data), 32):
                     chunk = collision_data[i:i+32]
                     line = "    " + ", ".join(f"0x{b:02X}" for b in chunk) + ","
@@ -1614,7 +3090,7 @@ def generate_header(assets_info, palette_registry, sfx_info, music_info, tilemap
 
             # Tile to palette lookup table
             tile_to_palette = tm['tile_to_palette']
-            lines.append(f"static const u8 _{name}_tile_to_palette[] = {{")
+            lines.append(f"{in_bank}static const u8 _{name}_tile_to_palette[] = {{")
             for i in range(0, len(tile_to_palette), 32):
                 chunk = tile_to_palette[i:i+32]
                 line = "    " + ", ".join(f"{b}" for b in chunk) + ","
@@ -1628,16 +3104,36 @@ def generate_header(assets_info, palette_registry, sfx_info, music_info, tilemap
             lines.append(f"    .width_tiles = {tm['width_tiles']},")
             lines.append(f"    .height_tiles = {tm['height_tiles']},")
             lines.append(f"    .base_tile = {tm['base_tile']},")
-            lines.append(f"    .tile_data = _{name}_tile_data,")
-            if collision_data:
-                lines.append(f"    .collision_data = _{name}_collision_data,")
-            else:
+            if chunks:
+                lines.append("    .tile_data = 0,")
                 lines.append("    .collision_data = 0,")
+            else:
+                lines.append(f"    .tile_data = _{name}_tile_data,")
+                if collision_data:
+                    lines.append(f"    .collision_data = _{name}_collision_data,")
+                else:
+                    lines.append("    .collision_data = 0,")
             lines.append(f"    .tile_to_palette = _{name}_tile_to_palette,")
             lines.append(f"    .default_palette = {tm['default_palette']},")
+            if chunks:
+                lines.append(f"    .chunk_data = _{name}_chunk_data,")
+                lines.append(f"    .chunk_offsets = _{name}_chunk_offsets,")
+                lines.append(f"    .chunk_collision = {1 if chunks['collision'] else 0},")
+                lines.append(f"    .chunk_slopes = {1 if chunks['slopes'] else 0},")
+            if tm['bank']:
+                lines.append(f"    .bank = {tm['bank']},")
             lines.append("};")
             lines.append("")
 
+            if tm['bank']:
+                # Accessor for game code reading the arrays directly; the
+                # terrain system maps the bank by itself
+                lines.append(f"static inline const NGTerrainAsset *NGTerrainAssetMap_{name}(void) {{")
+                lines.append(f"    NGBankSelect({tm['bank']});")
+                lines.append(f"    return &NGTerrainAsset_{name};")
+                lines.append("}")
+                lines.append("")
+
     # === Lighting Presets ===
     if lighting_presets:
         lines.append("// === Lighting Presets ===")
@@ -1654,7 +3150,7 @@ def generate_header(assets_info, palette_registry, sfx_info, music_info, tilemap
         lines.append("/** Pre-baked lighting preset info */")
         lines.append("typedef struct {")
         lines.append("    const char *name;")
-        lines.append("    u8 fade_steps;      /**< Number of fade steps (0 = final only) */")
+        lines.append("    u8 fade_steps;      /**< Number of fade steps (1-255) */")
         lines.append("    u8 palette_count;   /**< Number of palettes with variants */")
         lines.append("} NGLightingPresetInfo;")
         lines.append("")
@@ -1667,74 +3163,110 @@ def generate_header(assets_info, palette_registry, sfx_info, music_info, tilemap
         ]
         palette_items.sort(key=lambda x: x[1]['index'])
 
+        encoded = {
+            name: encode_lighting_preset(name, data, palette_items)
+            for name, data in lighting_presets.items()
+        }
+        has_delta = any(enc['format'] == 'delta' for enc in encoded.values())
+
         for preset_name, preset_data in sorted(lighting_presets.items()):
             fade_steps = preset_data['fade_steps']
-            lines.append(f"// Preset: {preset_name} ({fade_steps} fade steps)")
-
-            # For each palette, generate all fade step variants
-            for pal_name, pal_info in palette_items:
-                if pal_name not in preset_data['palettes']:
-                    continue
+            enc = encoded[preset_name]
+            lines.append(f"// Preset: {preset_name} ({fade_steps} fade steps, {enc['format']} "
+                         f"encoding, {enc['rom_bytes']} bytes)")
 
-                steps = preset_data['palettes'][pal_name]
-
-                # Generate array of palette variants for this preset/palette combo
-                # Format: [step0][16], [step1][16], ... [stepN][16]
+            for pal_name, _, variants, step_index, checkpoints in enc['palettes']:
                 array_name = f"_lighting_{preset_name}_{pal_name}"
-                lines.append(f"static const u16 {array_name}[{len(steps)}][16] = {{")
-
-                for step_idx, step_colors in enumerate(steps):
-                    step_line = "    {"
-                    for i in range(16):
-                        if i < len(step_colors):
-                            r, g, b = step_colors[i]
-                            if r < 0:  # Sentinel for transparent
-                                color = 0x8000
-                            else:
-                                color = rgb5_to_neogeo_color(r, g, b)
-                        else:
-                            color = 0x0000
-                        if i == 0:
-                            color = 0x8000  # Reference/transparent
-                        step_line += f"0x{color:04X}, "
-                    step_line += "},"
-                    lines.append(step_line)
-
+                if enc['format'] == 'delta':
+                    # Format: [checkpoint0][16], ... (steps 0, 8, 16, ...)
+                    rows = checkpoints
+                else:
+                    # Format: [variant0][16], [variant1][16], ...
+                    rows = variants
+                lines.append(f"static const u16 {array_name}[{len(rows)}][16] = {{")
+                for words in rows:
+                    lines.append("    {" + "".join(f"0x{c:04X}, " for c in words) + "},")
                 lines.append("};")
                 lines.append("")
 
+                if enc['format'] == 'full':
+                    # Step -> variant index (fade_steps + 1 entries)
+                    lines.append(f"static const u8 {array_name}_steps[{len(step_index)}] = {{")
+                    for row in range(0, len(step_index), 16):
+                        chunk = step_index[row:row + 16]
+                        lines.append("    " + " ".join(f"{v}," for v in chunk))
+                    lines.append("};")
+                    lines.append("")
+
             # Generate lookup struct for this preset
             lines.append(f"/** Palette lookup for {preset_name} preset */")
             lines.append("typedef struct {")
             lines.append("    u8 palette_index;")
-            lines.append(f"    const u16 (*steps)[16];")
+            if enc['format'] == 'delta':
+                lines.append("    const u16 (*checkpoints)[16]; /**< Every "
+                             f"{LIGHTING_CHECKPOINT_STEPS}th step */")
+            else:
+                lines.append("    const u16 (*variants)[16];")
+                lines.append("    const u8 *steps;")
             lines.append(f"}} _NGLightingPreset_{preset_name}_Entry;")
             lines.append("")
 
-            # Entry array
-            entries = []
-            for pal_name, pal_info in palette_items:
-                if pal_name in preset_data['palettes']:
-                    entries.append((pal_name, pal_info['index']))
-
             lines.append(f"static const _NGLightingPreset_{preset_name}_Entry "
                          f"_lighting_preset_{preset_name}_palettes[] = {{")
-            for pal_name, pal_idx in entries:
+            for pal_name, pal_idx, _, _, _ in enc['palettes']:
                 array_name = f"_lighting_{preset_name}_{pal_name}"
-                lines.append(f"    {{ {pal_idx}, {array_name} }},")
+                if enc['format'] == 'delta':
+                    lines.append(f"    {{ {pal_idx}, {array_name} }},")
+                else:
+                    lines.append(f"    {{ {pal_idx}, {array_name}, {array_name}_steps }},")
             lines.append("};")
             lines.append("")
 
+            if enc['format'] == 'delta':
+                deltas = enc['deltas']
+                lines.append(f"/** {preset_name} step deltas: "
+                             "{palette << 4 | color, color at k + 1, color at k} */")
+                lines.append(f"static const u16 _lighting_{preset_name}_deltas"
+                             f"[{max(len(deltas), 1)}][3] = {{")
+                for key, to_color, from_color in deltas:
+                    lines.append(f"    {{0x{key:04X}, 0x{to_color:04X}, 0x{from_color:04X}}},")
+                if not deltas:
+                    lines.append("    {0, 0, 0},")
+                lines.append("};")
+                lines.append("")
+
+                delta_start = enc['delta_start']
+                lines.append("/** First delta between step k and k + 1 */")
+                lines.append(f"static const u16 _lighting_{preset_name}_delta_start"
+                             f"[{len(delta_start)}] = {{")
+                for row in range(0, len(delta_start), 12):
+                    chunk = delta_start[row:row + 12]
+                    lines.append("    " + " ".join(f"{v}," for v in chunk))
+                lines.append("};")
+                lines.append("")
+
         # Generate preset info array
         lines.append("/** Pre-baked lighting preset metadata */")
         lines.append("static const NGLightingPresetInfo _lighting_presets[] = {")
         for preset_name in sorted(lighting_presets.keys()):
             preset_data = lighting_presets[preset_name]
-            pal_count = len([p for p in palette_items if p[0] in preset_data['palettes']])
+            pal_count = len(encoded[preset_name]['palettes'])
             lines.append(f"    {{ \"{preset_name}\", {preset_data['fade_steps']}, {pal_count} }},")
         lines.append("};")
         lines.append("")
 
+        if has_delta:
+            lines.append("/** Write the deltas of steps [first, last): forward (col 1) or back (col 2) */")
+            lines.append("static void _NGLightingApplyDeltas(const u16 (*deltas)[3], const u16 *start, "
+                         "u8 first, u8 last,")
+            lines.append("                                   u8 col) {")
+            lines.append("    for (u16 i = start[first]; i < start[last]; i++) {")
+            lines.append("        NGPalSetColor((u8)(deltas[i][0] >> 4), (u8)(deltas[i][0] & 0xF), "
+                         "deltas[i][col]);")
+            lines.append("    }")
+            lines.append("}")
+            lines.append("")
+
         # Generate static function to apply a preset at a specific fade step
         lines.append("/**")
         lines.append(" * Apply a pre-baked lighting preset at a specific fade step.")
@@ -1743,25 +3275,64 @@ def generate_header(assets_info, palette_registry, sfx_info, music_info, tilemap
         lines.append("static void _NGLightingApplyPrebakedStepImpl(u8 preset_id, u8 step) {")
         lines.append("    switch (preset_id) {")
 
-        for i, preset_name in enumerate(sorted(lighting_presets.keys())):
+        for preset_name in sorted(lighting_presets.keys()):
             preset_data = lighting_presets[preset_name]
+            enc = encoded[preset_name]
             const_name = f"NG_LIGHTING_PREBAKED_{preset_name.upper()}"
             entries_name = f"_lighting_preset_{preset_name}_palettes"
-            entry_count = len([p for p in palette_items if p[0] in preset_data['palettes']])
+            entry_count = len(enc['palettes'])
             fade_steps = preset_data['fade_steps']
 
             lines.append(f"    case {const_name}:")
             lines.append(f"        if (step > {fade_steps}) step = {fade_steps};")
             lines.append(f"        for (u8 i = 0; i < {entry_count}; i++) {{")
-            lines.append(f"            NGPalSet({entries_name}[i].palette_index,")
-            lines.append(f"                     {entries_name}[i].steps[step]);")
-            lines.append("        }")
+            lines.append(f"            const _NGLightingPreset_{preset_name}_Entry *e = "
+                         f"&{entries_name}[i];")
+            if enc['format'] == 'delta':
+                shift = LIGHTING_CHECKPOINT_STEPS.bit_length() - 1
+                lines.append(f"            NGPalSet(e->palette_index, e->checkpoints[step >> {shift}]);")
+                lines.append("        }")
+                lines.append(f"        _NGLightingApplyDeltas(_lighting_{preset_name}_deltas, "
+                             f"_lighting_{preset_name}_delta_start,")
+                lines.append(f"                               (u8)(step & ~{LIGHTING_CHECKPOINT_STEPS - 1}), "
+                             "step, 1);")
+            else:
+                lines.append("            NGPalSet(e->palette_index, e->variants[e->steps[step]]);")
+                lines.append("        }")
             lines.append("        break;")
 
         lines.append("    }")
         lines.append("}")
         lines.append("")
 
+        if has_delta:
+            lines.append("/**")
+            lines.append(" * Move a pre-baked preset between adjacent fade steps.")
+            lines.append(" * Delta-encoded presets write only the colors that change.")
+            lines.append(" */")
+            lines.append("static void _NGLightingApplyPrebakedDeltaImpl(u8 preset_id, u8 from_step, "
+                         "u8 to_step) {")
+            lines.append("    u8 seg = (to_step > from_step) ? from_step : to_step;")
+            lines.append("    u8 col = (to_step > from_step) ? 1 : 2;")
+            lines.append("    switch (preset_id) {")
+            for preset_name in sorted(lighting_presets.keys()):
+                if encoded[preset_name]['format'] != 'delta':
+                    continue
+                const_name = f"NG_LIGHTING_PREBAKED_{preset_name.upper()}"
+                fade_steps = lighting_presets[preset_name]['fade_steps']
+                lines.append(f"    case {const_name}:")
+                lines.append(f"        if (seg < {fade_steps})")
+                lines.append(f"            _NGLightingApplyDeltas(_lighting_{preset_name}_deltas,")
+                lines.append(f"                                   _lighting_{preset_name}_delta_start, "
+                             "seg, (u8)(seg + 1), col);")
+                lines.append("        break;")
+            lines.append("    default: /* Full-copy presets */")
+            lines.append("        _NGLightingApplyPrebakedStepImpl(preset_id, to_step);")
+            lines.append("        break;")
+            lines.append("    }")
+            lines.append("}")
+            lines.append("")
+
         # Generate static function to get preset info
         lines.append("static const void* _NGLightingGetPrebakedInfoImpl(u8 preset_id) {")
         lines.append(f"    if (preset_id >= {len(lighting_presets)}) return 0;")
@@ -1778,6 +3349,8 @@ def generate_header(assets_info, palette_registry, sfx_info, music_info, tilemap
         lines.append("__attribute__((weak)) void NGLightingInitPresets(void) {")
         lines.append("    NGLightingRegisterPrebaked(_NGLightingApplyPrebakedStepImpl,")
         lines.append("                               _NGLightingGetPrebakedInfoImpl);")
+        if has_delta:
+            lines.append("    NGLightingRegisterPrebakedDelta(_NGLightingApplyPrebakedDeltaImpl);")
         lines.append("}")
         lines.append("")
 
@@ -1871,6 +3444,11 @@ def load_yaml_config(yaml_path):
         if 'source' in music and not os.path.isabs(music['source']):
             music['source'] = str((yaml_dir / music['source']).resolve())
 
+    # Resolve FM song sources
+    for song in config.get('fm_music', []):
+        if 'source' in song and not os.path.isabs(song['source']):
+            song['source'] = str((yaml_dir / song['source']).resolve())
+
     # Resolve tilemap sources
     for tilemap in config.get('tilemaps', []):
         if 'source' in tilemap and not os.path.isabs(tilemap['source']):
@@ -1889,6 +3467,8 @@ def merge_configs(base_config, additional_config):
         'visual_assets': [],
         'sound_effects': [],
         'music': [],
+        'fm_instruments': [],
+        'fm_music': [],
         'tilemaps': [],
         'lighting_presets': {},
     }
@@ -1914,6 +3494,8 @@ def merge_configs(base_config, additional_config):
         base_config.get('music', []) +
         additional_config.get('music', [])
     )
+    for key in ('fm_instruments', 'fm_music', 'scenes', 'fonts', 'data'):
+        merged[key] = base_config.get(key, []) + additional_config.get(key, [])
     merged['tilemaps'] = (
         base_config.get('tilemaps', []) +
         additional_config.get('tilemaps', [])
@@ -1922,6 +3504,308 @@ def merge_configs(base_config, additional_config):
     return merged
 
 
+# ============================================================================
+# Sprite Budget Report
+# ============================================================================
+
+# Hardware sprite pools in progear/src/graphic.c: sprite 0 is unused, the
+# world and entity layers allocate from 1 up, the UI layer from the last
+# UI_SPRITE_POOL of the 380
+HW_SPRITES = 380
+UI_SPRITE_POOL = 64
+MAIN_SPRITE_POOL = HW_SPRITES - 1 - UI_SPRITE_POOL
+
+# NG_GRAPHIC_LINE_LIMIT and NG_GRAPHIC_SCREEN_LINES
+LINE_LIMIT = 96
+SCREEN_LINES = 224
+SCREEN_WIDTH = 320
+
+# Tallest hardware sprite in tiles; graphic columns stop there
+SPRITE_MAX_ROWS = 32
+
+# Graphic scale at the camera's minimum zoom (NG_CAM_ZOOM_50)
+MIN_ZOOM_SCALE = 128
+
+# Sprite columns and rows of a terrain graphic (NG_TERRAIN_MAX_COLS/ROWS)
+TERRAIN_COLS = 22
+TERRAIN_ROWS = 32
+
+
+def fill_columns(width_tiles, scale):
+    """
+    Sprite columns a repeating (infinite tile mode) graphic of the asset
+    needs to cover the screen at a scale, as graphic.c's calc_visible_cols():
+    the screen plus two, rounded up to whole copies of the asset.
+    """
+    shrink = 0 if scale == 0 else min(scale - 1, 255)
+    column_width = (shrink >> 4) + 1
+    screen_cols = (SCREEN_WIDTH + column_width - 1) // column_width + 2
+    return -(-screen_cols // width_tiles) * width_tiles
+
+
+def frame_changes(asset, a, b):
+    """Tilemap entries that differ between frames a and b of a grid asset"""
+    per_frame = asset['tiles_per_frame']
+    tilemap = asset['tilemap']
+    first = tilemap[a * per_frame:(a + 1) * per_frame]
+    second = tilemap[b * per_frame:(b + 1) * per_frame]
+    return sum(1 for x, y in zip(first, second) if x != y)
+
+
+def animation_steps(asset):
+    """
+    (from, to) frame pairs the asset's animations step through, with the
+    wrap of looping ones. Without animations, every frame to the next.
+    """
+    anims = asset['animations'] or [{'first_frame': 0, 'frame_count': asset['frame_count'],
+                                     'loop': 1}]
+    steps = set()
+    for anim in anims:
+        first, count = anim['first_frame'], anim['frame_count']
+        for f in range(first, first + count - 1):
+            steps.add((f, f + 1))
+        if anim['loop'] and count > 1:
+            steps.add((first + count - 1, first))
+    return steps
+
+
+def asset_budget(asset, colors, new_tiles):
+    """
+    Runtime cost of a visual asset.
+
+    cols: hardware sprites for one graphic drawing it once, at any scale
+    (zooming narrows the columns, it does not remove them); fill_1x and
+    fill_min: sprites of a repeating graphic covering the screen at 1x and
+    at the minimum camera zoom; step_words: most SCB1 words one animation
+    step writes (two per changed tile, a metasprite's whole new frame)
+    """
+    parts = asset.get('parts')
+    if parts is not None:
+        frame_parts = asset['frame_parts']
+        frames = [parts[frame_parts[f]:frame_parts[f + 1]] for f in range(asset['frame_count'])]
+        cols = max(len(p) for p in frames)
+        tiles = max(sum(part[3] for part in p) for p in frames)
+        step_words = 2 * tiles if asset['frame_count'] > 1 else 0
+    else:
+        cols = asset['width_tiles']
+        tiles = asset['tiles_per_frame']
+        step_words = 2 * max((frame_changes(asset, a, b) for a, b in animation_steps(asset)),
+                             default=0)
+    return {
+        'name': asset['name'],
+        'cols': cols,
+        'rows': min(asset['height_tiles'], SPRITE_MAX_ROWS),
+        'fill_1x': fill_columns(asset['width_tiles'], 256),
+        'fill_min': fill_columns(asset['width_tiles'], MIN_ZOOM_SCALE),
+        'tiles': tiles,
+        'step_words': step_words,
+        'palette': asset['palette_name'],
+        'palette_idx': asset['palette_idx'],
+        'colors': len(colors),
+        'crom_bytes': new_tiles * 128,
+    }
+
+
+def print_budget_report(budgets):
+    """Table of asset_budget() results, one line per asset"""
+    print("Sprite budget (cols: drawn once; fill: repeating layer at 1x / min zoom)")
+    print(f"  {'asset':<20} {'cols':>4} {'fill':>7} {'tiles':>5} {'words':>5}  "
+          f"{'palette':<20} {'colors':>6} {'C-ROM':>7}")
+    for b in budgets:
+        fill = f"{b['fill_1x']}/{b['fill_min']}"
+        palette = f"{b['palette']} ({b['palette_idx']})"
+        print(f"  {b['name']:<20} {b['cols']:>4} {fill:>7} {b['tiles']:>5} {b['step_words']:>5}  "
+              f"{palette:<20} {b['colors']:>6} {b['crom_bytes']:>7}")
+    print(f"  {'total':<20} {'':>4} {'':>7} {'':>5} {'':>5}  {'':<20} {'':>6} "
+          f"{sum(b['crom_bytes'] for b in budgets):>7}")
+
+
+def scene_sprites(scene_name, entry, budgets, tilemap_names):
+    """
+    Sprites one scene entry takes: (pool, columns per line, top line, lines)
+    with top None when it may sit on any line
+    """
+    count = entry.get('count', 1)
+    if not isinstance(count, int) or count < 0:
+        raise ProgearAssetsError(f"Scene '{scene_name}': count must be an integer of 0 or more")
+    top = entry.get('y')
+    if top is not None and not isinstance(top, int):
+        raise ProgearAssetsError(f"Scene '{scene_name}': y must be a screen line")
+    if 'tilemap' in entry:
+        if entry['tilemap'] not in tilemap_names:
+            raise ProgearAssetsError(
+                f"Scene '{scene_name}' references unknown tilemap '{entry['tilemap']}'")
+        cols, rows = TERRAIN_COLS, TERRAIN_ROWS
+    elif 'asset' in entry:
+        b = budgets.get(entry['asset'])
+        if b is None:
+            raise ProgearAssetsError(
+                f"Scene '{scene_name}' references unknown visual asset '{entry['asset']}'")
+        cols = b['fill_min'] if entry.get('repeat') else b['cols']
+        rows = b['rows']
+    else:
+        raise ProgearAssetsError(f"Scene '{scene_name}': entry needs 'asset' or 'tilemap'")
+    pool = 'ui' if entry.get('layer') == 'ui' else 'main'
+    return pool, cols * count, top, rows * 16
+
+
+def check_scene(scene, budgets, tilemap_names):
+    """
+    Add up a scene composition from assets.yaml against the sprite pools
+    and the 96 sprites per line. Entries without a 'y' are counted on every
+    line, as if they could all line up.
+    Returns: (warnings, {pool: sprites}, most sprites on one line)
+    """
+    name = scene.get('name')
+    if not name:
+        raise ProgearAssetsError("Scene missing 'name' field")
+    used = {'main': 0, 'ui': 0}
+    lines = [0] * SCREEN_LINES
+    for entry in scene.get('sprites', []):
+        pool, sprites, top, height = scene_sprites(name, entry, budgets, tilemap_names)
+        used[pool] += sprites
+        first, end = (0, SCREEN_LINES) if top is None else (max(top, 0), top + height)
+        for line in range(first, min(end, SCREEN_LINES)):
+            lines[line] += sprites
+
+    warnings = []
+    for pool, size in (('main', MAIN_SPRITE_POOL), ('ui', UI_SPRITE_POOL)):
+        if used[pool] > size:
+            warnings.append(f"scene '{name}' needs {used[pool]} {pool} sprites, "
+                            f"the pool has {size} ({HW_SPRITES} in all)")
+    peak = max(lines)
+    if peak > LINE_LIMIT:
+        over = sum(1 for n in lines if n > LINE_LIMIT)
+        warnings.append(f"scene '{name}' puts up to {peak} sprites on line {lines.index(peak)} "
+                        f"({over} lines over the {LINE_LIMIT} per line limit)")
+    return warnings, used, peak
+
+
+# ============================================================================
+# Build Cache and Parallel Processing
+# ============================================================================
+
+# Bump to drop every cached entry; edits to this script do the same
+CACHE_VERSION = 1
+
+
+class AssetCache:
+    """
+    Content-addressed store for decoded images and encoded audio.
+
+    A key hashes this script, the job kind, its arguments and the bytes of
+    its source file, so changing any of them is a miss. Each entry is one
+    pickled result file named after its key.
+    """
+
+    def __init__(self, cache_dir):
+        self.cache_dir = Path(cache_dir) if cache_dir else None
+        self.hits = 0
+        self.misses = 0
+        self.salt = b''
+        if self.cache_dir is not None:
+            self.cache_dir.mkdir(parents=True, exist_ok=True)
+            with open(os.path.abspath(__file__), 'rb') as f:
+                self.salt = hashlib.sha256(
+                    f"progear-assets-{CACHE_VERSION}".encode() + f.read()).digest()
+
+    def key(self, kind, source, args):
+        """Get the key for a job, or None if it cannot be cached."""
+        if self.cache_dir is None:
+            return None
+        try:
+            with open(source, 'rb') as f:
+                data = f.read()
+        except OSError:
+            return None  # Reported when the asset is processed
+        h = hashlib.sha256(self.salt)
+        h.update(repr((kind, args)).encode())
+        h.update(data)
+        return h.hexdigest()
+
+    def get(self, key):
+        if key is None:
+            return None
+        try:
+            with open(self.cache_dir / f"{key}.pkl", 'rb') as f:
+                return pickle.load(f)
+        except Exception:
+            return None  # Missing or unreadable entries are rebuilt
+
+    def put(self, key, result):
+        if key is None:
+            return
+        path = self.cache_dir / f"{key}.pkl"
+        tmp = path.with_suffix(f".tmp{os.getpid()}")
+        with open(tmp, 'wb') as f:
+            pickle.dump(result, f, protocol=pickle.HIGHEST_PROTOCOL)
+        os.replace(tmp, path)
+
+
+def run_asset_job(func, args):
+    """Run one job; a ProgearAssetsError is returned rather than raised."""
+    try:
+        return func(*args)
+    except ProgearAssetsError as e:
+        return e
+
+
+def run_asset_jobs(jobs, cache, workers):
+    """
+    Run the slow, independent part of each asset's processing.
+
+    jobs: list of (kind, func, args, source_path), or None for no job
+    workers: processes to spread cache misses over (1 runs them inline)
+
+    Results are returned in job order however the workers finish, so the
+    tiles, palettes and audio offsets assigned from them stay stable. A
+    failed job's result is its ProgearAssetsError.
+    """
+    results = [None] * len(jobs)
+    keys = [None] * len(jobs)
+    pending = []
+
+    for i, job in enumerate(jobs):
+        if job is None:
+            continue
+        kind, func, args, source = job
+        keys[i] = cache.key(kind, source, args)
+        hit = cache.get(keys[i])
+        if hit is not None:
+            results[i] = hit
+            cache.hits += 1
+        else:
+            pending.append(i)
+    cache.misses += len(pending)
+
+    ran = False
+    if workers > 1 and len(pending) > 1:
+        try:
+            with ProcessPoolExecutor(max_workers=min(workers, len(pending))) as pool:
+                futures = [pool.submit(run_asset_job, jobs[i][1], jobs[i][2]) for i in pending]
+                for i, future in zip(pending, futures):
+                    results[i] = future.result()
+            ran = True
+        except (OSError, NotImplementedError):
+            pass  # No process support here, fall back to running inline
+    if not ran:
+        for i in pending:
+            results[i] = run_asset_job(jobs[i][1], jobs[i][2])
+
+    for i in pending:
+        if not isinstance(results[i], ProgearAssetsError):
+            cache.put(keys[i], results[i])
+
+    return results
+
+
+def take_job_result(result):
+    """Unwrap a run_asset_jobs() result, raising a failed job's error."""
+    if isinstance(result, ProgearAssetsError):
+        raise result
+    return result
+
+
 def main():
     parser = argparse.ArgumentParser(
         description='NeoGeo Resource Compiler - Process visual and audio assets from YAML',
@@ -1935,7 +3819,20 @@ def main():
     parser.add_argument('--c2', default='sprites-c2.bin', help='C2 ROM output filename')
     parser.add_argument('--v1', default='audio-v1.bin', help='V1 ROM output filename (audio)')
     parser.add_argument('--m1-tables', default='audio-tables.bin', help='Z80 sample tables output')
+    parser.add_argument('--m1-fm', default='audio-fm.bin',
+                        help=f'Z80 FM song data output (at M-ROM 0x{FM_DATA_BASE:04X})')
     parser.add_argument('--header', default='progear_assets.h', help='Header output filename')
+    parser.add_argument('--no-dedupe', action='store_true',
+                        help='Store every tile, even duplicates and flipped copies')
+    parser.add_argument('--no-palette-merge', action='store_true',
+                        help='Give every auto-generated palette its own slot')
+    parser.add_argument('--cache-dir',
+                        help='Build cache directory (default: .asset-cache in the output directory)')
+    parser.add_argument('--no-cache', action='store_true', help='Process every asset from scratch')
+    parser.add_argument('-j', '--jobs', type=int, default=os.cpu_count() or 1,
+                        help='Worker processes for image decoding and audio encoding')
+    parser.add_argument('--report', action='store_true',
+                        help='Print each visual asset\'s sprite, VRAM and C-ROM budget')
     parser.add_argument('-v', '--verbose', action='store_true', help='Verbose output')
 
     args = parser.parse_args()
@@ -1977,12 +3874,18 @@ def main():
     sound_effects_config = config.get('sound_effects', [])
     music_config = config.get('music', [])
     tilemaps_config = config.get('tilemaps', [])
+    fm_instruments_config = config.get('fm_instruments', [])
+    fm_music_config = config.get('fm_music', [])
     lighting_presets_config = config.get('lighting_presets', {})
+    scenes_config = config.get('scenes', [])
+    fonts_config = config.get('fonts', [])
+    data_config = config.get('data', [])
 
     # Initialize palette registry
     # Indices 0-1 reserved for system, start auto-assignment at 2
     palette_registry = {
         '_next_index': 2,  # Internal: next auto-assigned index
+        '_aliases': {},    # Internal: asset name -> palette it shares
     }
 
     # Process explicit palette definitions first
@@ -2000,6 +3903,61 @@ def main():
             print(f"Error: {e}", file=sys.stderr)
             sys.exit(1)
 
+    # =========================================================================
+    # Decode images and encode audio (cached, in parallel)
+    # =========================================================================
+    # Only these steps are slow. They depend on nothing but their inputs, so
+    # they run up front; everything order-dependent happens afterwards.
+    if args.no_cache:
+        cache = AssetCache(None)
+    else:
+        cache = AssetCache(args.cache_dir or os.path.join(args.output, '.asset-cache'))
+
+    visual_jobs = []
+    for asset_def in visual_assets:
+        name = asset_def.get('name')
+        source = asset_def.get('source')
+        palette_ref = asset_def.get('palette')
+        job = None
+        if name and source and (not isinstance(palette_ref, str) or palette_ref in palette_registry):
+            job = ('visual', decode_visual_asset,
+                   (name, source, yaml_dir, asset_def.get('frame_size'),
+                    visual_palette_colors(asset_def, palette_registry)), source)
+        visual_jobs.append(job)
+
+    sfx_jobs = []
+    for sfx_def in sound_effects_config[:MAX_SFX]:
+        source = sfx_def.get('source')
+        job = None
+        if sfx_def.get('name') and source:
+            job = ('sfx', encode_sound_effect, (source, yaml_dir), source)
+        sfx_jobs.append(job)
+
+    music_jobs = []
+    for music_def in music_config[:MAX_MUSIC]:
+        source = music_def.get('source')
+        job = None
+        if music_def.get('name') and source:
+            try:
+                loop = music_loop_points(music_def, music_def['name'])
+            except ProgearAssetsError:
+                loop = None  # Reported by process_music()
+            job = ('music', encode_music,
+                   (source, yaml_dir, music_def.get('sample_rate', 22050), loop), source)
+        music_jobs.append(job)
+
+    job_results = run_asset_jobs(visual_jobs + sfx_jobs + music_jobs, cache, max(1, args.jobs))
+    visual_results = job_results[:len(visual_jobs)]
+    sfx_results = job_results[len(visual_jobs):len(visual_jobs) + len(sfx_jobs)]
+    music_results = job_results[len(visual_jobs) + len(sfx_jobs):]
+
+    if args.verbose and cache.cache_dir is not None:
+        print(f"Asset cache: {cache.hits} reused, {cache.misses} rebuilt ({cache.cache_dir})")
+
+    if not args.no_palette_merge:
+        palette_registry['_merged'] = merge_auto_palettes(visual_assets, visual_results,
+                                                          palette_registry)
+
     # Process all assets
     # Eyecatcher uses entire bank 1 (tiles 256-511), user tiles start at bank 2 (tile 512)
     TILE_START = 512
@@ -2031,28 +3989,88 @@ def main():
             print(f"Loaded eyecatcher tiles at bank 1: {len(eyecatcher_c1)} bytes")
 
     assets_info = []
-    base_tile = TILE_START
+    budgets = []
+    tile_pool = TilePool(TILE_START, all_c1_data, all_c2_data)
+
+    # Terrain tile indices address their tileset's tiles directly
+    tileset_names = {tm.get('tileset') for tm in tilemaps_config}
 
     # Process visual assets
-    for asset_def in visual_assets:
+    for asset_def, decoded in zip(visual_assets, visual_results):
         try:
-            c1, c2, palette, info, tile_count = process_visual_asset(
-                asset_def, yaml_dir, base_tile, palette_registry
+            dedupe = (asset_def.get('dedupe', True) and not args.no_dedupe and
+                      asset_def.get('name') not in tileset_names)
+            palette, info, tile_count = process_visual_asset(
+                asset_def, yaml_dir, tile_pool, palette_registry, dedupe,
+                take_job_result(decoded)
             )
-            all_c1_data.extend(c1)
-            all_c2_data.extend(c2)
             assets_info.append(info)
+            budgets.append(asset_budget(info, palette, tile_count))
 
             if args.verbose:
+                total = (info['frame_count'] * info['tiles_per_frame'] or
+                         sum(p[3] for p in info.get('parts', ())))
                 print(f"Processed '{info['name']}': "
                       f"{info['width_pixels']}x{info['height_pixels']}, "
-                      f"{info['frame_count']} frames, {tile_count} tiles")
+                      f"{info['frame_count']} frames, {total} tiles ({tile_count} new)")
 
-            base_tile += tile_count
+        except ProgearAssetsError as e:
+            print(f"Error: {e}", file=sys.stderr)
+            sys.exit(1)
+
+    # Sprite text fonts: the glyphs are never shared, so a character's tile
+    # is the font's first tile plus its code minus 32
+    fonts_info = []
+    for font_def in fonts_config:
+        name = font_def.get('name')
+        color = font_def.get('color', 1)
+        if not name or not 1 <= color <= 15:
+            print(f"Error: font needs a name and a color of 1-15: {font_def}", file=sys.stderr)
+            sys.exit(1)
+        first = tile_pool.next_tile
+        for pixels in genfont.sprite_font_tiles(color):
+            tile_pool.add(pixels, dedupe=False)
+        if tile_pool.next_tile > 0x10000:
+            print(f"Error: font '{name}' ends past tile 65535; list fonts before large "
+                  f"visual assets", file=sys.stderr)
+            sys.exit(1)
+        fonts_info.append({'name': name, 'tile': first})
+        if args.verbose:
+            print(f"Font '{name}': tiles {first}-{tile_pool.next_tile - 1}")
 
+    for pal_name, pal_info in palette_registry.items():
+        if not pal_name.startswith('_') and pal_info['index'] >= PALETTE_SLOT_FIRST:
+            print(f"Error: palette '{pal_name}' gets index {pal_info['index']}, in the "
+                  f"run-time palette slots ({PALETTE_SLOT_FIRST}-254)", file=sys.stderr)
+            sys.exit(1)
+
+    if args.verbose and palette_registry['_aliases']:
+        for alias, pal_name in palette_registry['_aliases'].items():
+            print(f"Palette of '{alias}' merged into '{pal_name}'")
+
+    if args.verbose and tile_pool.reused:
+        print(f"Tile dedupe: {tile_pool.reused} tiles shared "
+              f"({tile_pool.reused * TILE_SIZE * 2} bytes of C-ROM saved)")
+
+    if args.report and budgets:
+        print_budget_report(budgets)
+
+    # =========================================================================
+    # Check Scene Compositions against the sprite limits
+    # =========================================================================
+    budget_by_name = {b['name']: b for b in budgets}
+    tilemap_names = {tm.get('name') for tm in tilemaps_config}
+    for scene in scenes_config:
+        try:
+            warnings, used, peak = check_scene(scene, budget_by_name, tilemap_names)
         except ProgearAssetsError as e:
             print(f"Error: {e}", file=sys.stderr)
             sys.exit(1)
+        for warning in warnings:
+            print(f"Warning: {warning}", file=sys.stderr)
+        if args.verbose or args.report:
+            print(f"Scene '{scene['name']}': {used['main']}/{MAIN_SPRITE_POOL} sprites, "
+                  f"{used['ui']}/{UI_SPRITE_POOL} UI sprites, up to {peak} per line")
 
     # =========================================================================
     # Process Lighting Presets (after all palettes are registered)
@@ -2083,11 +4101,13 @@ def main():
 
     # Process sound effects
     for i, sfx_def in enumerate(sound_effects_config):
-        if i >= 32:
-            print(f"Warning: Maximum 32 sound effects supported, ignoring extras", file=sys.stderr)
+        if i >= MAX_SFX:
+            print(f"Warning: Maximum {MAX_SFX} sound effects supported, ignoring extras",
+                  file=sys.stderr)
             break
         try:
-            adpcm_data, sfx_info = process_sound_effect(sfx_def, yaml_dir, i, audio_offset)
+            adpcm_data, sfx_info = process_sound_effect(sfx_def, yaml_dir, i, audio_offset,
+                                                        take_job_result(sfx_results[i]))
             all_v1_data.extend(adpcm_data)
             sfx_info_list.append(sfx_info)
             audio_offset += len(adpcm_data)
@@ -2100,12 +4120,25 @@ def main():
             sys.exit(1)
 
     # Process music
+    music_segments = 0
     for i, music_def in enumerate(music_config):
-        if i >= 32:
-            print(f"Warning: Maximum 32 music tracks supported, ignoring extras", file=sys.stderr)
+        if i >= MAX_MUSIC:
+            print(f"Warning: Maximum {MAX_MUSIC} music tracks supported, ignoring extras",
+                  file=sys.stderr)
             break
         try:
-            adpcm_data, music_info = process_music(music_def, yaml_dir, i, audio_offset)
+            # Segments start on ADPCM-B address units
+            pad = -audio_offset % MUSIC_BLOCK_BYTES
+            all_v1_data.extend(bytes(pad))
+            audio_offset += pad
+
+            adpcm_data, music_info = process_music(music_def, yaml_dir, i, audio_offset,
+                                                   music_segments,
+                                                   take_job_result(music_results[i]))
+            music_segments += len(music_info['segments'])
+            if music_segments > MAX_MUSIC_SEGMENTS:
+                raise ProgearAssetsError(f"Music '{music_info['name']}': more than "
+                                         f"{MAX_MUSIC_SEGMENTS} music segments in total")
             all_v1_data.extend(adpcm_data)
             music_info_list.append(music_info)
             audio_offset += len(adpcm_data)
@@ -2117,6 +4150,62 @@ def main():
             print(f"Error: {e}", file=sys.stderr)
             sys.exit(1)
 
+    music_indices = {music['name']: music['index'] for music in music_info_list}
+    for music in music_info_list:
+        if music['next'] is None:
+            music['next_index'] = MUSIC_NONE
+        elif music['next'] in music_indices:
+            music['next_index'] = music_indices[music['next']]
+        else:
+            print(f"Error: Music '{music['name']}' chains to unknown track '{music['next']}'",
+                  file=sys.stderr)
+            sys.exit(1)
+
+    # =========================================================================
+    # Process FM Songs
+    # =========================================================================
+    fm_info_list = []
+    fm_data = b''
+
+    if len(fm_instruments_config) > MAX_FM_PATCHES:
+        print(f"Error: more than {MAX_FM_PATCHES} FM instruments", file=sys.stderr)
+        sys.exit(1)
+    if len(fm_music_config) > MAX_FM_SONGS:
+        print(f"Error: more than {MAX_FM_SONGS} FM songs", file=sys.stderr)
+        sys.exit(1)
+
+    try:
+        fm_patches = [process_fm_instrument(inst) for inst in fm_instruments_config]
+        fm_instruments = {inst['name']: i for i, inst in enumerate(fm_instruments_config)}
+        fm_instruments.update({str(i): i for i in range(len(fm_patches))})
+        for idx, song_def in enumerate(fm_music_config):
+            fm_info = process_fm_song(song_def, yaml_dir, idx, fm_instruments)
+            fm_info_list.append(fm_info)
+            if args.verbose:
+                used = sum(1 for ch in fm_info['channels'] if ch is not None)
+                print(f"Processed FM song '{fm_info['name']}': {used} channels, "
+                      f"tempo {fm_info['tempo']}")
+        if fm_info_list:
+            fm_data = generate_fm_data(fm_info_list, fm_patches)
+    except ProgearAssetsError as e:
+        print(f"Error: {e}", file=sys.stderr)
+        sys.exit(1)
+
+    # =========================================================================
+    # Process Data Assets (LZ4 packed, see ng_decomp.h)
+    # =========================================================================
+    data_info_list = []
+    for data_def in data_config:
+        try:
+            data_info = process_data_asset(data_def, yaml_dir)
+        except ProgearAssetsError as e:
+            print(f"Error: {e}", file=sys.stderr)
+            sys.exit(1)
+        data_info_list.append(data_info)
+        if args.verbose:
+            print(f"Packed data '{data_info['name']}': {data_info['size']} -> "
+                  f"{len(data_info['packed'])} bytes")
+
     # =========================================================================
     # Process Tilemap Assets
     # =========================================================================
@@ -2124,12 +4213,21 @@ def main():
 
     for tilemap_def in tilemaps_config:
         try:
-            tilemap_info = process_tilemap_asset(tilemap_def, yaml_dir, assets_info)
+            tilemap_info = process_tilemap_asset(tilemap_def, yaml_dir, assets_info,
+                                                 palette_registry)
             tilemap_info_list.append(tilemap_info)
 
             if args.verbose:
                 print(f"Processed Tilemap '{tilemap_info['name']}': "
                       f"{tilemap_info['width_tiles']}x{tilemap_info['height_tiles']} tiles")
+                chunks = tilemap_info['chunks']
+                if chunks:
+                    flat = len(tilemap_info['tile_data'])
+                    if tilemap_info['collision_data']:
+                        flat *= 2
+                    packed = len(chunks['data']) + len(chunks['offsets']) * 4
+                    print(f"  {len(chunks['offsets'])} chunks, {packed} bytes "
+                          f"(flat: {flat} bytes)")
 
         except ProgearAssetsError as e:
             print(f"Error: {e}", file=sys.stderr)
@@ -2173,10 +4271,17 @@ def main():
         with open(m1_tables_path, 'wb') as f:
             f.write(sample_tables)
 
+    # Write Z80 FM song data (if any FM songs)
+    m1_fm_path = output_dir / args.m1_fm
+    if fm_data:
+        with open(m1_fm_path, 'wb') as f:
+            f.write(fm_data)
+
     # Generate header
     header_path = output_dir / args.header
     generate_header(assets_info, palette_registry, sfx_info_list, music_info_list,
-                    tilemap_info_list, lighting_presets, header_path)
+                    tilemap_info_list, lighting_presets, header_path, fm_info_list, fonts_info,
+                    data_info_list)
 
     # Count palettes (excluding internal keys)
     palette_count = len([k for k in palette_registry.keys() if not k.startswith('_')])
@@ -2186,12 +4291,16 @@ def main():
     print(f"  {c2_path} ({len(all_c2_data)} bytes)")
     if sfx_info_list or music_info_list:
         print(f"  {v1_path} ({len(all_v1_data)} bytes)")
+    if fm_data:
+        print(f"  {m1_fm_path} ({len(fm_data)} bytes)")
     print(f"  {header_path}")
-    print(f"Total: {base_tile} tiles, {palette_count} palettes, {len(assets_info)} visual assets")
+    print(f"Total: {tile_pool.next_tile} tiles, {palette_count} palettes, {len(assets_info)} visual assets")
     if sfx_info_list:
         print(f"       {len(sfx_info_list)} sound effects")
     if music_info_list:
         print(f"       {len(music_info_list)} music tracks")
+    if fm_info_list:
+        print(f"       {len(fm_info_list)} FM songs")
     if tilemap_info_list:
         print(f"       {len(tilemap_info_list)} tilemaps")
     if lighting_presets:
@@ -0,0 +1,153 @@
+#!/usr/bin/env python3
+# This file is part of ProGearSDK.
+# Copyright (c) 2024-2025 ProGearSDK contributors
+# SPDX-License-Identifier: MIT
+
+"""
+List the ROM a linked program spends, per module and per function.
+
+Symbol sizes come from nm. The linker map (the demo Makefiles write one
+next to the ELF) tells which object each input section came from, so
+every symbol is charged to its module: `graphic.o`, `ng_sprite.o`,
+`main.o`, ... Functions LTO merged into a link-time unit are listed as
+`(lto)`. Without a map only the function list is printed.
+
+Build with `make PROFILE=speed` to see what the -O2 modules cost against
+a default build, and trade ROM for cycles on purpose.
+
+Usage:
+  python3 tools/size_report.py build/mygame.elf --map build/mygame.map
+  python3 tools/size_report.py build/mygame.elf --nm m68k-elf-nm --top 20
+"""
+
+import argparse
+import bisect
+import os
+import re
+import subprocess
+import sys
+
+# Output sections stored in the first megabyte of P-ROM
+ROM_SECTIONS = ('.text', '.data')
+
+# nm types that occupy ROM: code, read-only data, initialized data
+CODE_TYPES = 'tTwW'
+DATA_TYPES = 'rRdD'
+
+SECTION_LINE = re.compile(r'^ (\.\S+|COMMON)(?:\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(.+))?$')
+PLACEMENT_LINE = re.compile(r'^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(.+)$')
+OUTPUT_LINE = re.compile(r'^(\.\S+)\s')
+
+
+def module_name(path):
+    """Object file of an input section: `lib.a(graphic.o)` -> `graphic.o`."""
+    path = path.strip()
+    member = re.search(r'\(([^)]+)\)$', path)
+    if member:
+        path = member.group(1)
+    name = os.path.basename(path)
+    if 'ltrans' in name:
+        return '(lto)'
+    return name
+
+
+def read_map(path):
+    """Input sections placed in ROM: sorted (address, size, module) tuples."""
+    placed = []
+    output = None
+    pending = None
+    in_map = False
+    with open(path) as f:
+        for line in f:
+            line = line.rstrip('\n')
+            if not in_map:
+                in_map = line.startswith('Linker script and memory map')
+                continue
+            out = OUTPUT_LINE.match(line)
+            if out:
+                output = out.group(1)
+                pending = None
+                continue
+            if output not in ROM_SECTIONS:
+                continue
+            m = SECTION_LINE.match(line)
+            if m:
+                if m.group(2) is None:
+                    pending = m.group(1)  # Long names put the placement on the next line
+                    continue
+                address, size, source = int(m.group(2), 16), int(m.group(3), 16), m.group(4)
+            elif pending:
+                m = PLACEMENT_LINE.match(line)
+                pending = None
+                if not m:
+                    continue
+                address, size, source = int(m.group(1), 16), int(m.group(2), 16), m.group(3)
+            else:
+                continue
+            if size:
+                placed.append((address, size, module_name(source)))
+    placed.sort()
+    return placed
+
+
+def read_symbols(elf, nm):
+    """Sized ROM symbols: (name, size, address, is_code)."""
+    try:
+        text = subprocess.run([nm, '-S', '--size-sort', elf], check=True, capture_output=True,
+                              text=True).stdout
+    except (OSError, subprocess.CalledProcessError) as e:
+        sys.exit(f'size_report: cannot run {nm}: {e}')
+    symbols = []
+    for line in text.splitlines():
+        parts = line.split()
+        if len(parts) != 4:
+            continue
+        address, size, kind, name = parts
+        if kind in CODE_TYPES or kind in DATA_TYPES:
+            symbols.append((name, int(size, 16), int(address, 16), kind in CODE_TYPES))
+    return symbols
+
+
+def module_at(placed, starts, address):
+    i = bisect.bisect_right(starts, address) - 1
+    if i >= 0 and address < placed[i][0] + placed[i][1]:
+        return placed[i][2]
+    return '?'
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Per-module and per-function ROM size report')
+    parser.add_argument('elf', help='Linked program')
+    parser.add_argument('--map', help='Linker map of the same link')
+    parser.add_argument('--nm', default='m68k-elf-nm', help='nm to run (default m68k-elf-nm)')
+    parser.add_argument('--top', type=int, default=40, help='Functions and data listed (default 40)')
+    args = parser.parse_args()
+
+    symbols = read_symbols(args.elf, args.nm)
+    placed = read_map(args.map) if args.map else []
+    starts = [p[0] for p in placed]
+
+    if placed:
+        modules = {}
+        for _, size, module in placed:
+            modules[module] = modules.get(module, 0) + size
+        total = sum(modules.values())
+        print(f'{"module":<32} {"bytes":>8} {"share":>6}')
+        for module, size in sorted(modules.items(), key=lambda m: -m[1]):
+            print(f'{module:<32} {size:>8} {100.0 * size / total:>5.1f}%')
+        print(f'{"total":<32} {total:>8}')
+        print()
+
+    for title, code in (('function', True), ('data', False)):
+        listed = sorted((s for s in symbols if s[3] == code), key=lambda s: -s[1])[:args.top]
+        if not listed:
+            continue
+        print(f'{title:<44} {"bytes":>8}  module')
+        for name, size, address, _ in listed:
+            module = module_at(placed, starts, address) if placed else ''
+            print(f'{name:<44} {size:>8}  {module}')
+        print()
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+# This file is part of ProGearSDK.
+# Copyright (c) 2024-2025 ProGearSDK contributors
+# SPDX-License-Identifier: MIT
+
+"""
+Check the asset tool's audio path against the reference implementation.
+
+ADPCM_A.encode() and ADPCM_B.encode() must give the same nibbles as
+running _encode_sample() on every sample, which is how the encoders used
+to work. resample_audio() and the 16-bit WAV loader are compared with
+copies of their earlier per-sample versions below. Exits non-zero on the
+first mismatch.
+
+Usage: python3 test_audio_codec.py
+"""
+
+import os
+import random
+import struct
+import sys
+import tempfile
+import types
+import wave
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+
+# The codecs need neither Pillow nor PyYAML; let the tool import without them
+for name in ('PIL', 'yaml'):
+    try:
+        __import__(name)
+    except ImportError:
+        stub = types.ModuleType(name)
+        stub.Image = None
+        sys.modules[name] = stub
+
+import progear_assets as pa  # noqa: E402
+
+
+# ============================================================================
+# Reference implementations
+# ============================================================================
+
+def reference_encode(codec, samples):
+    """One _encode_sample() call per sample, padded to 512 samples."""
+    codec.reset()
+    pad_len = ((len(samples) + 511) // 512) * 512
+    return [codec._encode_sample(s) for s in list(samples) + [0] * (pad_len - len(samples))]
+
+
+def reference_resample(samples, src_rate, dst_rate):
+    if src_rate == dst_rate:
+        return samples
+
+    ratio = src_rate / dst_rate
+    out_len = int(len(samples) / ratio)
+    result = []
+
+    for i in range(out_len):
+        src_pos = i * ratio
+        src_idx = int(src_pos)
+        frac = src_pos - src_idx
+
+        if src_idx + 1 < len(samples):
+            sample = int(samples[src_idx] * (1 - frac) + samples[src_idx + 1] * frac)
+        else:
+            sample = samples[src_idx] if src_idx < len(samples) else 0
+
+        result.append(max(-32768, min(32767, sample)))
+
+    return result
+
+
+def reference_load_s16(raw_data, channels):
+    samples = list(struct.unpack(f'<{len(raw_data) // 2}h', raw_data))
+    if channels == 2:
+        samples = [(samples[i] + samples[i + 1]) // 2 for i in range(0, len(samples), 2)]
+    return samples
+
+
+# ============================================================================
+# Test signals
+# ============================================================================
+
+def signals():
+    rng = random.Random(1234)
+    yield 'silence', [0] * 700
+    yield 'noise', [rng.randint(-32768, 32767) for _ in range(20000)]
+    yield 'clipped', ([32767] * 3000 + [-32768] * 3000) * 2
+    yield 'steps', [((i // 37) % 2) * 60000 - 30000 for i in range(9001)]
+    yield 'ramp', [(i * 97) % 65536 - 32768 for i in range(12345)]
+    tone, phase = [], 0
+    for _ in range(15000):
+        phase = (phase + 1103) & 0xFFFF
+        tone.append(int(30000 * ((phase / 32768.0) - 1.0)))
+    yield 'saw', tone
+
+
+failures = 0
+
+
+def check(name, got, want):
+    global failures
+    if got == want:
+        return
+    failures += 1
+    first = next((i for i, (a, b) in enumerate(zip(got, want)) if a != b), min(len(got), len(want)))
+    print(f"FAIL {name}: lengths {len(got)}/{len(want)}, first difference at {first}")
+
+
+def main():
+    for name, samples in signals():
+        check(f"adpcm-b {name}", pa.ADPCM_B().encode(samples),
+              reference_encode(pa.ADPCM_B(), samples))
+        samples12 = [s >> 4 for s in samples]
+        check(f"adpcm-a {name}", pa.ADPCM_A().encode(samples12),
+              reference_encode(pa.ADPCM_A(), samples12))
+        for src_rate, dst_rate in ((44100, 18500), (48000, 22050), (22050, 44100), (32000, 31999)):
+            check(f"resample {name} {src_rate}->{dst_rate}",
+                  pa.resample_audio(samples, src_rate, dst_rate),
+                  reference_resample(samples, src_rate, dst_rate))
+
+    rng = random.Random(99)
+    frames = [rng.randint(-32768, 32767) for _ in range(8000)]
+    raw = struct.pack(f'<{len(frames)}h', *frames)
+    with tempfile.TemporaryDirectory() as tmp:
+        for channels in (1, 2):
+            path = os.path.join(tmp, f'test{channels}.wav')
+            with wave.open(path, 'wb') as w:
+                w.setnchannels(channels)
+                w.setsampwidth(2)
+                w.setframerate(22050)
+                w.writeframes(raw)
+            samples, _, _ = pa.load_wav_file(path, tmp)
+            check(f"wav s16 {channels}ch", samples, reference_load_s16(raw, channels))
+
+    if failures:
+        print(f"{failures} audio check(s) failed")
+        return 1
+    print("Audio codec matches the reference")
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())